@@ -2,12 +2,15 @@
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 
 #include "binance-common-api.hpp"
 #include "cache-file-updator-interface.hpp"
 #include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
+#include "curl-multi-engine.hpp"
 #include "curlhandle.hpp"
 #include "currencycode.hpp"
 #include "currencycodeset.hpp"
@@ -47,6 +50,9 @@ class CommonAPI : public CacheFileUpdatorInterface {
 
   BinanceGlobalInfos &getBinanceGlobalInfos() { return _binanceGlobalInfos; }
 
+  /// Get the asynchronous HTTP requests engine shared by all exchanges. Its event loop thread is started at first call.
+  CurlMultiEngine &curlMultiEngine();
+
   void updateCacheFile() const override;
 
  private:
@@ -66,11 +72,11 @@ class CommonAPI : public CacheFileUpdatorInterface {
 
   CachedResultVault _cachedResultVault;
   const CoincenterInfo &_coincenterInfo;
-  // A single mutex is needed as the cached result vault is shared
-  std::recursive_mutex _globalMutex;
-  CachedResult<FiatsFunc> _fiatsCache;
+  ConcurrentCachedResult<FiatsFunc> _fiatsCache;
   BinanceGlobalInfos _binanceGlobalInfos;
   WithdrawalFeesCrawler _withdrawalFeesCrawler;
+  std::once_flag _curlMultiEngineOnceFlag;
+  std::unique_ptr<CurlMultiEngine> _curlMultiEnginePtr;
 };
 }  // namespace api
 }  // namespace cct
\ No newline at end of file
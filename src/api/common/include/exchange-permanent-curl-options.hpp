@@ -5,11 +5,17 @@
 #include "exchange-query-config.hpp"
 #include "permanentcurloptions.hpp"
 
-namespace cct::api {
+namespace cct {
+
+class WeightedRateLimiter;
+
+namespace api {
 
 class ExchangePermanentCurlOptions {
  public:
-  explicit ExchangePermanentCurlOptions(const schema::ExchangeQueryConfig &queryConfig);
+  /// @param pWeightedRateLimiter optional rate limiter of the exchange, shared by its public and private requests
+  explicit ExchangePermanentCurlOptions(const schema::ExchangeQueryConfig &queryConfig,
+                                        WeightedRateLimiter *pWeightedRateLimiter = nullptr);
 
   enum class Api : int8_t { Public, Private };
 
@@ -17,6 +23,8 @@ class ExchangePermanentCurlOptions {
 
  private:
   const schema::ExchangeQueryConfig &_queryConfig;
+  WeightedRateLimiter *_pWeightedRateLimiter;
 };
 
-}  // namespace cct::api
\ No newline at end of file
+}  // namespace api
+}  // namespace cct
\ No newline at end of file
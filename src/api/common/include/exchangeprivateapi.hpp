@@ -5,9 +5,11 @@
 #include <utility>
 
 #include "apikey.hpp"
+#include "apiquerytypeenum.hpp"
 #include "balanceoptions.hpp"
 #include "balanceportfolio.hpp"
 #include "cache-file-updator-interface.hpp"
+#include "cachedresult.hpp"
 #include "cachedresultvault.hpp"
 #include "currencycode.hpp"
 #include "currencyexchangeflatset.hpp"
@@ -165,6 +167,11 @@ class ExchangePrivate : public CacheFileUpdatorInterface {
 
   PermanentCurlOptions::Builder permanentCurlOptionsBuilder() const;
 
+  /// Options for a cached result of given query type, registered in the cached result vault of the public exchange.
+  CachedResultOptions cachedResultOptions(QueryType queryType) {
+    return _exchangePublic.cachedResultOptions(queryType);
+  }
+
   ExchangePublic &_exchangePublic;
   CachedResultVault &_cachedResultVault{_exchangePublic._cachedResultVault};
   const CoincenterInfo &_coincenterInfo;
@@ -188,6 +195,7 @@ class ExchangePrivate : public CacheFileUpdatorInterface {
   /// Check if withdraw has been confirmed and successful from 'this' exchange
   SentWithdrawInfo isWithdrawSuccessfullySent(const InitiatedWithdrawInfo &initiatedWithdrawInfo);
 
+  /// Computes the equivalent amounts in 'equiCurrency' of all the amounts of given portfolio.
   void computeEquiCurrencyAmounts(BalancePortfolio &balancePortfolio, CurrencyCode equiCurrency);
 };
 }  // namespace api
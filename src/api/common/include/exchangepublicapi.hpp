@@ -1,13 +1,24 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <utility>
 
+#include "apiquerytypeenum.hpp"
 #include "cache-file-updator-interface.hpp"
+#include "cachedresult.hpp"
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
 #include "commonapi.hpp"
+#include "curl-multi-engine.hpp"
+#include "curlhandle.hpp"
 #include "currencycode.hpp"
 #include "currencycodeset.hpp"
 #include "currencyexchangeflatset.hpp"
@@ -16,14 +27,18 @@
 #include "exchangepublicapitypes.hpp"
 #include "market-order-book-vector.hpp"
 #include "market-timestamp-set.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "markets-conversion-graph.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
 #include "permanentcurloptions.hpp"
 #include "priceoptions.hpp"
 #include "public-trade-vector.hpp"
 #include "time-window.hpp"
+#include "timedef.hpp"
 
 namespace cct {
 
@@ -31,6 +46,7 @@ class AbstractMarketDataDeserializer;
 class AbstractMarketDataSerializer;
 class CoincenterInfo;
 class FiatConverter;
+class WeightedRateLimiter;
 
 namespace schema {
 struct ExchangeConfig;
@@ -76,6 +92,9 @@ class ExchangePublic : public CacheFileUpdatorInterface {
   /// Conversion is made according to given price options, which uses the 'Maker' prices by default.
   std::optional<MonetaryAmount> estimatedConvert(MonetaryAmount from, CurrencyCode toCurrency,
                                                  const PriceOptions &priceOptions = PriceOptions()) {
+    if (from.currencyCode() == toCurrency) {
+      return from;
+    }
     MarketOrderBookMap marketOrderBookMap;
     CurrencyCodeSet fiats = queryFiats();
     MarketSet markets;
@@ -112,6 +131,10 @@ class ExchangePublic : public CacheFileUpdatorInterface {
   /// It should be more precise that previous version with possibility to go deeper.
   MarketOrderBook getOrderBook(Market mk, int depth = kDefaultDepth);
 
+  /// Retrieve the order books of given markets, in the same order.
+  /// Exchanges supporting it retrieve them with as few requests as possible, instead of one request per market.
+  MarketOrderBookVector getOrderBooks(std::span<const Market> markets, int depth = kDefaultDepth);
+
   /// Retrieve an ordered vector of recent last trades
   PublicTradeVector getLastTrades(Market mk, int nbTrades = kNbLastTradesDefault);
 
@@ -144,6 +167,14 @@ class ExchangePublic : public CacheFileUpdatorInterface {
     return findMarketsPath(fromCurrencyCode, toCurrencyCode, markets, queryFiats(), marketsPathMode);
   }
 
+  /// Variation of 'findMarketsPath' retrieving at once the paths from several currencies to the same target currency,
+  /// which is cheaper than calling 'findMarketsPath' for each of them, as they are computed from a single search from
+  /// the target currency. Only the currencies without any direct path may need their own search for fiat conversions.
+  /// @return the markets paths in the same order as 'fromCurrencyCodes'
+  vector<MarketsPath> findMarketsPaths(std::span<const CurrencyCode> fromCurrencyCodes, CurrencyCode toCurrencyCode,
+                                       MarketSet &markets, const CurrencyCodeSet &fiats,
+                                       MarketPathMode marketsPathMode = MarketPathMode::kStrict);
+
   using CurrenciesPath = SmallVector<CurrencyCode, 4>;
 
   /// Retrieve the shortest path allowing to convert 'fromCurrencyCode' to 'toCurrencyCode', as an array of currencies.
@@ -199,6 +230,16 @@ class ExchangePublic : public CacheFileUpdatorInterface {
 
   MarketOrderBookVector pullMarketOrderBooksForReplay(Market market, TimeWindow timeWindow);
 
+  /// Compacts serialized market data of given market (or all markets if undefined) to speed up future replays.
+  /// Returns the number of compacted files written.
+  int compactMarketDataForReplay(Market market);
+
+  /// Refreshes ahead of their expiry the cached values (public and private ones) of this exchange configured with a
+  /// refresh ahead frequency, so that they are still up to date at next query expected in 'horizon' from now.
+  /// It is meant to be called during idle times, when no other query is made on this exchange.
+  /// Returns the number of refreshed values.
+  int refreshCachesAhead(Duration horizon);
+
  protected:
   ExchangePublic(ExchangeNameEnum exchangeNameEnum, FiatConverter &fiatConverter, CommonAPI &commonApi,
                  const CoincenterInfo &coincenterInfo);
@@ -207,11 +248,126 @@ class ExchangePublic : public CacheFileUpdatorInterface {
   /// It should be more precise that previous version with possibility to go deeper.
   virtual MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) = 0;
 
+  /// Retrieve the order books of given markets, in the same order.
+  /// Default implementation queries them one by one - exchanges able to return several order books per request
+  /// should override it.
+  virtual MarketOrderBookVector queryOrderBooks(std::span<const Market> markets, int depth = kDefaultDepth);
+
+  /// Helper for the implementations of 'queryOrderBooks' coalescing the requests of several markets.
+  /// Order books still up to date in 'orderBookCache' (keyed by market and depth) are taken from it.
+  /// The other ones are retrieved at once by 'queryOrderBooksFunc', taking the span of the missing markets and
+  /// returning a MarketOrderBookMap, and are stored in the cache.
+  /// Missing markets not returned by 'queryOrderBooksFunc' are queried one by one through the cache.
+  template <class OrderBookCache, class QueryOrderBooksFunc>
+  static MarketOrderBookVector QueryOrderBooksWithCache(OrderBookCache &orderBookCache, std::span<const Market> markets,
+                                                        int depth, QueryOrderBooksFunc queryOrderBooksFunc) {
+    MarketOrderBookVector marketOrderBooks(markets.size());
+    MarketVector missingMarkets;
+    vector<decltype(markets.size())> missingMarketPositions;
+    for (decltype(markets.size()) marketPos = 0; marketPos < markets.size(); ++marketPos) {
+      const auto pMarketOrderBook = orderBookCache.retrieveIfUpToDate(markets[marketPos], depth);
+      if (!pMarketOrderBook) {
+        missingMarkets.push_back(markets[marketPos]);
+        missingMarketPositions.push_back(marketPos);
+      } else {
+        marketOrderBooks[marketPos] = *pMarketOrderBook;
+      }
+    }
+    if (missingMarkets.empty()) {
+      return marketOrderBooks;
+    }
+
+    MarketOrderBookMap missingMarketOrderBooks = queryOrderBooksFunc(std::span<const Market>(missingMarkets));
+    for (const auto &[market, marketOrderBook] : missingMarketOrderBooks) {
+      orderBookCache.set(marketOrderBook, marketOrderBook.time(), market, depth);
+    }
+
+    for (auto marketPos : missingMarketPositions) {
+      const Market market = markets[marketPos];
+      const auto it = missingMarketOrderBooks.find(market);
+      if (it != missingMarketOrderBooks.end()) {
+        marketOrderBooks[marketPos] = std::move(it->second);
+      } else {
+        marketOrderBooks[marketPos] = *orderBookCache.get(market, depth);
+      }
+    }
+    return marketOrderBooks;
+  }
+
+  /// Helper for the implementations of 'queryOrderBooks' of exchanges returning a single order book per request.
+  /// The requests of all given markets are submitted at once to the CurlMultiEngine shared by all exchanges, so that
+  /// they are in flight at the same time instead of being sent one after the other.
+  /// 'curlOptionsFunc' returns the CurlOptions of the request on 'endpoint' for a market, and 'orderBookFunc' creates
+  /// the MarketOrderBook of a market from its response.
+  /// Markets whose order book could not be retrieved this way are not returned. Nothing is returned when asynchronous
+  /// requests are not supported in current run mode, or if there is only one market.
+  template <class CurlOptionsFunc, class OrderBookFunc>
+  MarketOrderBookMap queryOrderBooksConcurrently(const CurlHandle &curlHandle, std::span<const Market> markets,
+                                                 std::string_view endpoint, CurlOptionsFunc curlOptionsFunc,
+                                                 OrderBookFunc orderBookFunc) {
+    MarketOrderBookMap marketOrderBookMap;
+    if (markets.size() < 2U || !isCurlMultiEngineEnabled()) {
+      return marketOrderBookMap;
+    }
+
+    const CurlMultiEngine::QueueId queueId = curlMultiEngineQueueId(curlHandle);
+
+    vector<CurlMultiEngine::Request> requests;
+    requests.reserve(markets.size());
+    for (Market market : markets) {
+      requests.push_back(CurlMultiEngine::Request{queueId, endpoint, curlOptionsFunc(market)});
+    }
+
+    auto responses = _commonApi.curlMultiEngine().submit(requests);
+
+    marketOrderBookMap.reserve(markets.size());
+    for (decltype(markets.size()) marketPos = 0; marketPos < markets.size(); ++marketPos) {
+      const Market market = markets[marketPos];
+      try {
+        const string response = responses[marketPos].get();
+        if (response.empty()) {
+          throw exception("empty response");
+        }
+        marketOrderBookMap.insert_or_assign(market, orderBookFunc(market, response));
+      } catch (const std::exception &ex) {
+        log::warn("Unable to retrieve {} order book of {} asynchronously: {}", name(), market, ex.what());
+      }
+    }
+    return marketOrderBookMap;
+  }
+
   /// Retrieve an ordered vector of recent last trades
   virtual PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) = 0;
 
   PermanentCurlOptions::Builder permanentCurlOptionsBuilder() const;
 
+  /// Options for a cached result of given query type, registered in the cached result vault of this exchange.
+  /// The functors of all the public cached results of this exchange are serialized by '_publicRequestsMutex', as they
+  /// share the same CurlHandle.
+  CachedResultOptions cachedResultOptions(QueryType queryType);
+
+  /// Loads the metadata of this exchange (markets, currencies, precisions, trading filters...) from its metadata cache
+  /// file, to avoid querying them at start up. 'loadFunc' is called with the MetadataCacheFile, and should load each
+  /// metadata CachedResult from it. Nothing is loaded in unit tests with overriden query responses.
+  template <class LoadFunc>
+  void loadMetadataCache(LoadFunc loadFunc) const {
+    if (isMetadataCacheEnabled()) {
+      const MetadataCacheFile metadataCacheFile = createMetadataCacheFile();
+      loadFunc(metadataCacheFile);
+    }
+  }
+
+  /// Writes the metadata cache file of this exchange. 'storeFunc' is called with the MetadataCacheFile, and should
+  /// store in it the metadata CachedResults loaded by 'loadMetadataCache'.
+  template <class StoreFunc>
+  void storeMetadataCache(StoreFunc storeFunc) const {
+    if (isMetadataCacheEnabled()) {
+      MetadataCacheFile metadataCacheFile = createMetadataCacheFile();
+      storeFunc(metadataCacheFile);
+      metadataCacheFile.write();
+    }
+  }
+
   ExchangeNameEnum _exchangeNameEnum;
   CachedResultVault _cachedResultVault;
   FiatConverter &_fiatConverter;
@@ -220,12 +376,48 @@ class ExchangePublic : public CacheFileUpdatorInterface {
   const schema::ExchangeConfig &_exchangeConfig;
   std::unique_ptr<AbstractMarketDataDeserializer> _marketDataDeserializerPtr;
   std::unique_ptr<AbstractMarketDataSerializer> _marketDataSerializerPtr;
+  // Protects the public CurlHandle of the exchange. Public cached results hold it only while computing a value, so
+  // direct queries outside of them (not cached) should lock it as well.
   std::recursive_mutex _publicRequestsMutex;
 
  private:
   friend class ExchangePrivate;
 
+  bool isMetadataCacheEnabled() const;
+
+  /// Tells whether requests can be sent by the CurlMultiEngine - overriden query responses and proxy are only
+  /// supported by CurlHandle.
+  bool isCurlMultiEngineEnabled() const;
+
+  /// Get the queue of this exchange in the shared CurlMultiEngine, registering it at first call.
+  CurlMultiEngine::QueueId curlMultiEngineQueueId(const CurlHandle &curlHandle);
+
+  bool isFiatConvertible(CurrencyCode currencyCode, const CurrencyCodeSet &fiats) const;
+
+  /// Get the conversion graph of given markets, (re)building it if needed.
+  /// Returns nullptr if there are no markets. Caller should hold '_marketsConversionGraphMutex'.
+  MarketsConversionGraph *getMarketsConversionGraph(const MarketSet &markets, const CurrencyCodeSet &fiats);
+
+  MarketsPath findMarketsPath(MarketsConversionGraph &marketsConversionGraph, CurrencyCode fromCurrency,
+                              CurrencyCode toCurrency, const CurrencyCodeSet &fiats, MarketPathMode marketsPathMode);
+
+  MetadataCacheFile createMetadataCacheFile() const;
+
+  /// Get the market data serializer, creating it at first call. Caller should hold '_marketDataSerializerMutex'.
   AbstractMarketDataSerializer &getMarketDataSerializer();
+
+  // Rebuilt only when markets or fiats change, protected by _marketsConversionGraphMutex
+  MarketsConversionGraph _marketsConversionGraph;
+  std::mutex _marketsConversionGraphMutex;
+
+  // Protects the lazily created market data serializer, shared by all the threads querying market data
+  std::mutex _marketDataSerializerMutex;
+
+  // Shared by all the requests (public and private) of this exchange, null if the weight of requests is not limited
+  std::unique_ptr<WeightedRateLimiter> _weightedRateLimiterPtr;
+
+  std::once_flag _curlMultiEngineQueueOnceFlag;
+  CurlMultiEngine::QueueId _curlMultiEngineQueueId{};
 };
 }  // namespace api
 }  // namespace cct
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "cct_string.hpp"
+#include "ssl_sha.hpp"
+
+namespace cct::ssl {
+
+/// Lightweight builder of JSON Web Tokens signed with HMAC (HS256 or HS512), with string claims only.
+/// Encoded header and the claims common to all tokens are computed once at construction, so that building a new token
+/// only serializes its own claims before encoding and signing it with a pre-keyed context.
+/// Claims keys and values are not escaped, they should not contain any character needing to be escaped in JSON.
+template <ShaType shaType>
+class JsonWebTokenBuilder {
+ public:
+  using Claim = std::pair<std::string_view, std::string_view>;
+
+  /// @param secret the HMAC secret used to sign the tokens
+  /// @param fixedClaims claims present in all built tokens, before the specific ones
+  JsonWebTokenBuilder(std::string_view secret, std::span<const Claim> fixedClaims);
+
+  /// Builds a new signed token (in compact serialization) with the fixed claims followed by given claims.
+  string build(std::span<const Claim> claims) const;
+
+ private:
+  HmacSigner<shaType> _signer;
+  string _encodedHeaderWithDot;
+  string _payloadPrefix;
+};
+
+using JsonWebTokenHs256Builder = JsonWebTokenBuilder<ShaType::kSha256>;
+using JsonWebTokenHs512Builder = JsonWebTokenBuilder<ShaType::kSha512>;
+
+}  // namespace cct::ssl
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "cct_vector.hpp"
+#include "currencycode.hpp"
+#include "currencycodeset.hpp"
+#include "exchangepublicapitypes.hpp"
+#include "market.hpp"
+
+namespace cct::api {
+
+/// Conversion graph of the markets of an exchange, built once for a given set of markets.
+/// Currencies are interned into dense integer ids (in the order of their codes), and the markets are stored as a
+/// compressed sparse row adjacency. Shortest conversion paths from a given source currency are computed at once for
+/// all target currencies, and memoized, so that successive queries from the same source are simple table lookups.
+///
+/// Paths are ordered by:
+///  - number of conversions
+///  - number of fiat currencies in the path (to avoid taxable events and favor the most liquid markets)
+///  - lexicographical order of the currencies of the path, for determinism
+/// Methods are not thread-safe (memoization is done lazily), caller should protect the graph if needed.
+class MarketsConversionGraph {
+ public:
+  using CurrencyId = int32_t;
+
+  MarketsConversionGraph() noexcept = default;
+
+  /// Builds the conversion graph of given markets, with fiat currencies given by 'fiats'.
+  /// Currencies for which 'isFiatConvertible' returns true (typically fiats and stable coins) can be converted to a
+  /// fiat outside of the exchange, at the extremities of a path.
+  template <class IsFiatConvertibleFunc>
+  MarketsConversionGraph(const MarketSet &markets, const CurrencyCodeSet &fiats,
+                         IsFiatConvertibleFunc isFiatConvertible)
+      : MarketsConversionGraph(markets, fiats) {
+    for (CurrencyId curId = 0; curId < nbCurrencies(); ++curId) {
+      if (isFiatConvertible(_currencies[curId])) {
+        _currencyFlags[curId] |= kFiatConvertible;
+      }
+    }
+  }
+
+  /// Tells whether this graph has been built from given markets and fiats.
+  bool isBuiltFrom(const MarketSet &markets, const CurrencyCodeSet &fiats) const;
+
+  CurrencyId nbCurrencies() const { return static_cast<CurrencyId>(_currencies.size()); }
+
+  /// Get the shortest path of markets, in the order in which they are defined on the exchange, to convert
+  /// 'fromCurrency' into 'toCurrency', or an empty path if conversion is not possible.
+  MarketsPath findMarketsPath(CurrencyCode fromCurrency, CurrencyCode toCurrency);
+
+  /// Variation of 'findMarketsPath' allowing a conversion of a fiat convertible currency to another one outside of the
+  /// exchange (market of type kFiatConversionMarket) at the extremities of the path, if there is no path without it.
+  /// As 'fromCurrency' and 'toCurrency' may be unknown from the exchange, caller tells if they are fiat convertible.
+  MarketsPath findMarketsPathWithFiatConversionAtExtremity(CurrencyCode fromCurrency,
+                                                           bool isFromCurrencyFiatConvertible, CurrencyCode toCurrency,
+                                                           bool isToCurrencyFiatConvertible);
+
+  /// Get the shortest paths of markets from each of 'fromCurrencies' to 'toCurrency', in the same order (empty paths
+  /// for the currencies which cannot be converted).
+  /// As markets can be traded in both directions, they are all read from the single shortest path tree of
+  /// 'toCurrency', instead of computing a tree per source currency. Paths of same length and same number of fiats may
+  /// thus differ from the ones returned by 'findMarketsPath'.
+  vector<MarketsPath> findMarketsPathsTo(std::span<const CurrencyCode> fromCurrencies, CurrencyCode toCurrency);
+
+  /// Get the shortest paths of markets from 'fromCurrency' to all currencies reachable from it, ordered by currency.
+  vector<std::pair<CurrencyCode, MarketsPath>> findAllMarketsPaths(CurrencyCode fromCurrency);
+
+ private:
+  enum class Dir : int8_t { kExchangeOrder, kReversed };
+
+  enum CurrencyFlag : uint8_t {
+    kFiat = 1U << 0,
+    kFiatConvertible = 1U << 1,
+  };
+
+  struct Edge {
+    CurrencyId targetId;
+    Dir dir;
+  };
+
+  /// Node of a shortest path tree from a given source currency.
+  struct PathNode {
+    bool isReached() const { return predecessorId != kUnreachedId; }
+
+    static constexpr CurrencyId kUnreachedId = -1;
+
+    CurrencyId predecessorId = kUnreachedId;
+    // Rank of the path to this currency in lexicographical order among paths of the same length
+    CurrencyId lexicographicalRank{};
+    int16_t nbConversions{};
+    int16_t nbFiats{};
+    Dir dir = Dir::kExchangeOrder;
+  };
+
+  using ShortestPathTree = vector<PathNode>;
+
+  MarketsConversionGraph(const MarketSet &markets, const CurrencyCodeSet &fiats);
+
+  /// Returns the id of given currency, or PathNode::kUnreachedId if it is not traded in any market.
+  CurrencyId currencyId(CurrencyCode currencyCode) const;
+
+  bool hasFlag(CurrencyId curId, CurrencyFlag flag) const { return (_currencyFlags[curId] & flag) != 0; }
+
+  const ShortestPathTree &shortestPathTree(CurrencyId sourceId);
+
+  /// Market converting the predecessor of given currency in a path tree to it.
+  Market predecessorMarket(const ShortestPathTree &pathTree, CurrencyId curId) const;
+
+  void appendMarketsPath(const ShortestPathTree &pathTree, CurrencyId targetId, MarketsPath &marketsPath) const;
+
+  /// Appends the path from 'sourceId' to the root of given path tree.
+  void appendPathToRoot(const ShortestPathTree &pathTree, CurrencyId sourceId, MarketsPath &marketsPath) const;
+
+  MarketSet _markets;
+  CurrencyCodeSet _fiats;
+  vector<CurrencyCode> _currencies;
+  vector<uint8_t> _currencyFlags;
+  vector<CurrencyId> _edgesOffsets;
+  vector<Edge> _edges;
+  // Lazily computed shortest path trees, indexed by source currency id (empty if not computed yet)
+  vector<ShortestPathTree> _shortestPathTrees;
+};
+
+}  // namespace cct::api
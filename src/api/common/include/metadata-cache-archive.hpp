@@ -0,0 +1,163 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "cct_exception.hpp"
+#include "cct_string.hpp"
+#include "currencycode.hpp"
+#include "currencyexchange.hpp"
+#include "market.hpp"
+#include "monetaryamount.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct::api {
+
+/// Compact binary archives of the exchange metadata (markets, currencies, precisions, trading filters...), used to
+/// persist them between two runs.
+/// Supported types are arithmetic types, enums, strings, main coincenter objects (CurrencyCode, Market,
+/// MonetaryAmount...), pairs, containers of supported types, and classes exposing their fields with either a member
+/// function 'template <class Archive> void serialize(Archive &ar)' or a free function 'serialize(Archive &ar, T &obj)'
+/// found by ADL, calling 'ar(field1, field2, ...)'. The same function is used for writing and reading.
+/// Integers are written in native byte order, the resulting data is not meant to be shared between machines.
+class MetadataCacheWriter {
+ public:
+  template <class... T>
+  void operator()(const T &...values) {
+    (write(values), ...);
+  }
+
+  std::string_view data() const noexcept { return _data; }
+
+ private:
+  template <class T>
+  void write(const T &value) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      _data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    } else if constexpr (std::is_same_v<T, CurrencyCode>) {
+      write(static_cast<uint8_t>(value.size()));
+      for (char ch : value) {
+        _data.push_back(ch);
+      }
+    } else if constexpr (std::is_same_v<T, Market>) {
+      (*this)(value.base(), value.quote(), value.type());
+    } else if constexpr (std::is_same_v<T, MonetaryAmount>) {
+      (*this)(value.amount(), value.currencyCode(), value.nbDecimals());
+    } else if constexpr (std::is_same_v<T, CurrencyExchange>) {
+      (*this)(value.standardCode(), value.exchangeCode(), value.altCode(), value.canDeposit(), value.canWithdraw(),
+              value.isFiat());
+    } else if constexpr (std::is_same_v<T, VolAndPriNbDecimals>) {
+      (*this)(value.volNbDecimals, value.priNbDecimals);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+      std::string_view str(value);
+      write(static_cast<uint32_t>(str.size()));
+      _data.append(str.data(), str.size());
+    } else if constexpr (requires { value.first; value.second; }) {
+      (*this)(value.first, value.second);
+    } else if constexpr (std::ranges::sized_range<const T>) {
+      write(static_cast<uint32_t>(std::ranges::size(value)));
+      for (const auto &elem : value) {
+        write(elem);
+      }
+    } else if constexpr (requires(T &obj) { obj.serialize(*this); }) {
+      const_cast<T &>(value).serialize(*this);
+    } else {
+      serialize(*this, const_cast<T &>(value));
+    }
+  }
+
+  string _data;
+};
+
+/// Reads data written by MetadataCacheWriter, in the same order.
+/// Throws an exception if data is truncated.
+class MetadataCacheReader {
+ public:
+  explicit MetadataCacheReader(std::string_view data) noexcept : _data(data) {}
+
+  template <class... T>
+  void operator()(T &...values) {
+    (read(values), ...);
+  }
+
+  template <class T>
+  T read() {
+    T value{};
+    read(value);
+    return value;
+  }
+
+  bool empty() const noexcept { return _data.empty(); }
+
+ private:
+  std::string_view consume(std::size_t nbBytes) {
+    if (_data.size() < nbBytes) {
+      throw exception("Truncated metadata cache data");
+    }
+    std::string_view ret = _data.substr(0, nbBytes);
+    _data.remove_prefix(nbBytes);
+    return ret;
+  }
+
+  template <class T>
+  void read(T &value) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      std::memcpy(&value, consume(sizeof(T)).data(), sizeof(T));
+    } else if constexpr (std::is_same_v<T, CurrencyCode>) {
+      value = CurrencyCode(consume(read<uint8_t>()));
+    } else if constexpr (std::is_same_v<T, Market>) {
+      const auto base = read<CurrencyCode>();
+      const auto quote = read<CurrencyCode>();
+      value = Market(base, quote, read<Market::Type>());
+    } else if constexpr (std::is_same_v<T, MonetaryAmount>) {
+      const auto amount = read<MonetaryAmount::AmountType>();
+      const auto currencyCode = read<CurrencyCode>();
+      value = MonetaryAmount(amount, currencyCode, read<int8_t>());
+    } else if constexpr (std::is_same_v<T, CurrencyExchange>) {
+      const auto standardCode = read<CurrencyCode>();
+      const auto exchangeCode = read<CurrencyCode>();
+      const auto altCode = read<CurrencyCode>();
+      const auto deposit =
+          read<bool>() ? CurrencyExchange::Deposit::kAvailable : CurrencyExchange::Deposit::kUnavailable;
+      const auto withdraw =
+          read<bool>() ? CurrencyExchange::Withdraw::kAvailable : CurrencyExchange::Withdraw::kUnavailable;
+      const auto type = read<bool>() ? CurrencyExchange::Type::kFiat : CurrencyExchange::Type::kCrypto;
+      value = CurrencyExchange(standardCode, exchangeCode, altCode, deposit, withdraw, type);
+    } else if constexpr (std::is_same_v<T, VolAndPriNbDecimals>) {
+      (*this)(value.volNbDecimals, value.priNbDecimals);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+      const auto str = consume(read<uint32_t>());
+      value = T(str.data(), str.size());
+    } else if constexpr (requires { value.first; value.second; }) {
+      (*this)(value.first, value.second);
+    } else if constexpr (std::ranges::sized_range<T>) {
+      const auto nbElems = read<uint32_t>();
+      if constexpr (requires { value.reserve(nbElems); }) {
+        value.reserve(nbElems);
+      }
+      for (uint32_t elemPos = 0; elemPos < nbElems; ++elemPos) {
+        if constexpr (requires { typename T::mapped_type; }) {
+          auto key = read<typename T::key_type>();
+          value.emplace(std::move(key), read<typename T::mapped_type>());
+        } else if constexpr (requires { value.push_back(read<typename T::value_type>()); }) {
+          value.push_back(read<typename T::value_type>());
+        } else {
+          value.insert(value.end(), read<typename T::value_type>());
+        }
+      }
+    } else if constexpr (requires(T &obj) { obj.serialize(*this); }) {
+      value.serialize(*this);
+    } else {
+      serialize(*this, value);
+    }
+  }
+
+  std::string_view _data;
+};
+
+}  // namespace cct::api
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "exchange-name-enum.hpp"
+#include "file.hpp"
+#include "metadata-cache-archive.hpp"
+#include "timedef.hpp"
+
+namespace cct::api {
+
+/// Binary cache file of the metadata of an exchange (markets, currencies, precisions, trading filters...), allowing
+/// warm starts without any metadata query.
+/// It is made of named sections, each one holding the value of a CachedResult without arguments and its last update
+/// time. Values are loaded with their original update time, so that they are refreshed according to the refresh
+/// period of the CachedResult, as if they had been queried by the current process.
+class MetadataCacheFile {
+ public:
+  /// Reads the metadata cache file of given exchange, if it exists.
+  MetadataCacheFile(std::string_view dataDir, ExchangeNameEnum exchangeNameEnum);
+
+  /// Sets the value of given section, if present, to given CachedResult.
+  template <class CachedResultT>
+  void load(std::string_view sectionName, CachedResultT &cachedResult) const {
+    const Section *pSection = findSection(sectionName);
+    if (pSection == nullptr) {
+      return;
+    }
+    try {
+      MetadataCacheReader reader(pSection->data);
+      cachedResult.set(reader.read<typename CachedResultT::ResultType>(),
+                       TimePoint(TimePoint::duration(pSection->lastUpdatedTs)));
+    } catch (const exception &ex) {
+      log::warn("Unable to load {} from metadata cache: {}", sectionName, ex.what());
+    }
+  }
+
+  /// Stores the latest value of given CachedResult, if any, in given section.
+  template <class CachedResultT>
+  void store(std::string_view sectionName, const CachedResultT &cachedResult) {
+    const auto [pValue, lastUpdatedTime] = cachedResult.retrieve();
+    if (pValue != nullptr) {
+      MetadataCacheWriter writer;
+      writer(*pValue);
+      storeSection(sectionName, lastUpdatedTime, writer.data());
+    }
+  }
+
+  /// Writes all sections to the metadata cache file.
+  void write() const;
+
+ private:
+  struct Section {
+    template <class Archive>
+    void serialize(Archive &ar) {
+      ar(name, lastUpdatedTs, data);
+    }
+
+    string name;
+    int64_t lastUpdatedTs{};
+    string data;
+  };
+
+  const Section *findSection(std::string_view sectionName) const;
+
+  void storeSection(std::string_view sectionName, TimePoint lastUpdatedTime, std::string_view data);
+
+  File _file;
+  vector<Section> _sections;
+};
+
+}  // namespace cct::api
@@ -4,9 +4,12 @@
 #include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <span>
 #include <string_view>
 
+struct evp_mac_ctx_st;
+
 namespace cct::ssl {
 
 /// @brief Helper type containing the number of bytes of the SHA
@@ -37,4 +40,36 @@ Sha512DigestArray Sha512Digest(std::string_view data);
 Sha256DigestArray Sha256Digest(std::span<const std::string_view> data);
 Sha512DigestArray Sha512Digest(std::span<const std::string_view> data);
 
+/// HMAC signer holding a context initialized once with its secret.
+/// Each signature is computed from a copy of this pre-keyed context, which avoids hashing the secret again and the
+/// lookup of the digest algorithm at each call, contrary to the one-shot Sha*Bin and Sha*Hex functions.
+/// Signing is thread safe.
+template <ShaType shaType>
+class HmacSigner {
+ public:
+  using BinArray = std::array<char, static_cast<std::size_t>(shaType)>;
+  using HexArray = std::array<char, 2UL * static_cast<std::size_t>(shaType)>;
+
+  explicit HmacSigner(std::string_view secret);
+
+  BinArray sign(std::string_view data) const;
+
+  /// Signs the concatenation of given data, without building it.
+  BinArray sign(std::span<const std::string_view> data) const;
+
+  HexArray signHex(std::string_view data) const;
+
+ private:
+  struct EVP_MAC_CTX_Deleter {
+    void operator()(evp_mac_ctx_st* ptr) const noexcept;
+  };
+
+  using EVP_MAC_CTX_UniquePtr = std::unique_ptr<evp_mac_ctx_st, EVP_MAC_CTX_Deleter>;
+
+  EVP_MAC_CTX_UniquePtr _pKeyedMacCtx;
+};
+
+using HmacSha256Signer = HmacSigner<ShaType::kSha256>;
+using HmacSha512Signer = HmacSigner<ShaType::kSha512>;
+
 }  // namespace cct::ssl
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 
 #include "cache-file-updator-interface.hpp"
 #include "cachedresult.hpp"
 #include "cachedresultvault.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "curlhandle.hpp"
 #include "currencycode.hpp"
 #include "exchange-name-enum.hpp"
@@ -18,7 +20,8 @@ namespace cct {
 class CoincenterInfo;
 
 /// This class is able to crawl some public withdrawal fees web pages in order to retrieve them from unofficial sources,
-/// which is better than nothing. This class is non thread-safe.
+/// which is better than nothing. This class is thread-safe, queries of the same exchange are made only once even if
+/// requested concurrently.
 class WithdrawalFeesCrawler : public CacheFileUpdatorInterface {
  public:
   WithdrawalFeesCrawler(const CoincenterInfo& coincenterInfo, Duration minDurationBetweenQueries,
@@ -27,7 +30,7 @@ class WithdrawalFeesCrawler : public CacheFileUpdatorInterface {
   using WithdrawalMinMap = std::unordered_map<CurrencyCode, MonetaryAmount>;
   using WithdrawalInfoMaps = std::pair<MonetaryAmountByCurrencySet, WithdrawalMinMap>;
 
-  const WithdrawalInfoMaps& get(ExchangeNameEnum exchangeNameEnum) {
+  std::shared_ptr<const WithdrawalInfoMaps> get(ExchangeNameEnum exchangeNameEnum) {
     return _withdrawalFeesCache.get(exchangeNameEnum);
   }
 
@@ -49,7 +52,7 @@ class WithdrawalFeesCrawler : public CacheFileUpdatorInterface {
   };
 
   const CoincenterInfo& _coincenterInfo;
-  CachedResult<WithdrawalFeesFunc, ExchangeNameEnum> _withdrawalFeesCache;
+  ConcurrentCachedResult<WithdrawalFeesFunc, ExchangeNameEnum> _withdrawalFeesCache;
 };
 
 }  // namespace cct
\ No newline at end of file
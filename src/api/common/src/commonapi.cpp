@@ -1,6 +1,7 @@
 #include "commonapi.hpp"
 
 #include <glaze/glaze.hpp>  // IWYU pragma: export
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string_view>
@@ -12,6 +13,7 @@
 #include "cct_string.hpp"
 #include "cct_vector.hpp"
 #include "coincenterinfo.hpp"
+#include "curl-multi-engine.hpp"
 #include "curloptions.hpp"
 #include "currencycode.hpp"
 #include "currencycodeset.hpp"
@@ -67,18 +69,18 @@ CommonAPI::CommonAPI(const CoincenterInfo& coincenterInfo, Duration fiatsUpdateF
 }
 
 CurrencyCodeSet CommonAPI::queryFiats() {
-  std::lock_guard<std::recursive_mutex> guard(_globalMutex);
-  return _fiatsCache.get();
+  return *_fiatsCache.get();
 }
 
 bool CommonAPI::queryIsCurrencyCodeFiat(CurrencyCode currencyCode) { return queryFiats().contains(currencyCode); }
 
+CurlMultiEngine& CommonAPI::curlMultiEngine() {
+  std::call_once(_curlMultiEngineOnceFlag, [this] { _curlMultiEnginePtr = std::make_unique<CurlMultiEngine>(); });
+  return *_curlMultiEnginePtr;
+}
+
 MonetaryAmountByCurrencySet CommonAPI::tryQueryWithdrawalFees(ExchangeNameEnum exchangeNameEnum) {
-  MonetaryAmountByCurrencySet ret;
-  {
-    std::lock_guard<std::recursive_mutex> guard(_globalMutex);
-    ret = _withdrawalFeesCrawler.get(exchangeNameEnum).first;
-  }
+  MonetaryAmountByCurrencySet ret = _withdrawalFeesCrawler.get(exchangeNameEnum)->first;
 
   if (ret.empty()) {
     log::warn("Taking binance withdrawal fees for {} as crawler failed to retrieve data",
@@ -90,13 +92,11 @@ MonetaryAmountByCurrencySet CommonAPI::tryQueryWithdrawalFees(ExchangeNameEnum e
 
 std::optional<MonetaryAmount> CommonAPI::tryQueryWithdrawalFee(ExchangeNameEnum exchangeNameEnum,
                                                                CurrencyCode currencyCode) {
-  {
-    std::lock_guard<std::recursive_mutex> guard(_globalMutex);
-    const auto& withdrawalFees = _withdrawalFeesCrawler.get(exchangeNameEnum).first;
-    auto it = withdrawalFees.find(currencyCode);
-    if (it != withdrawalFees.end()) {
-      return *it;
-    }
+  const auto pWithdrawalInfoMaps = _withdrawalFeesCrawler.get(exchangeNameEnum);
+  const auto& withdrawalFees = pWithdrawalInfoMaps->first;
+  auto it = withdrawalFees.find(currencyCode);
+  if (it != withdrawalFees.end()) {
+    return *it;
   }
   log::warn("Taking binance withdrawal fee for {} and currency {} as crawler failed to retrieve data",
             EnumToString(exchangeNameEnum), currencyCode);
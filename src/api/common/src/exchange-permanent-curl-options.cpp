@@ -5,8 +5,9 @@
 
 namespace cct::api {
 
-ExchangePermanentCurlOptions::ExchangePermanentCurlOptions(const schema::ExchangeQueryConfig &queryConfig)
-    : _queryConfig(queryConfig) {}
+ExchangePermanentCurlOptions::ExchangePermanentCurlOptions(const schema::ExchangeQueryConfig &queryConfig,
+                                                           WeightedRateLimiter *pWeightedRateLimiter)
+    : _queryConfig(queryConfig), _pWeightedRateLimiter(pWeightedRateLimiter) {}
 
 PermanentCurlOptions::Builder ExchangePermanentCurlOptions::builderBase(Api api) const {
   PermanentCurlOptions::Builder builder;
@@ -14,7 +15,8 @@ PermanentCurlOptions::Builder ExchangePermanentCurlOptions::builderBase(Api api)
   builder.setAcceptedEncoding(_queryConfig.acceptEncoding)
       .setRequestCallLogLevel(_queryConfig.logLevels.requestsCall)
       .setRequestAnswerLogLevel(_queryConfig.logLevels.requestsAnswer)
-      .setTimeout(_queryConfig.http.timeout.duration);
+      .setTimeout(_queryConfig.http.timeout.duration)
+      .setWeightedRateLimiter(_pWeightedRateLimiter);
 
   switch (api) {
     case Api::Private:
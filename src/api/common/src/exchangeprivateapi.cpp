@@ -17,6 +17,7 @@
 #include "balanceportfolio.hpp"
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
+#include "cct_vector.hpp"
 #include "coincenterinfo.hpp"
 #include "currencycode.hpp"
 #include "deposit.hpp"
@@ -73,17 +74,26 @@ BalancePortfolio ExchangePrivate::getAccountBalance(const BalanceOptions &balanc
 }
 
 void ExchangePrivate::computeEquiCurrencyAmounts(BalancePortfolio &balancePortfolio, CurrencyCode equiCurrency) {
-  MarketOrderBookMap marketOrderBookMap;
-  auto fiats = _exchangePublic.queryFiats();
+  const auto fiats = _exchangePublic.queryFiats();
   MarketSet markets;
+
+  vector<CurrencyCode> currencies(balancePortfolio.size());
+  std::ranges::transform(balancePortfolio, currencies.begin(),
+                         [](const auto &amountWithEqui) { return amountWithEqui.amount.currencyCode(); });
+
+  // All conversion paths are resolved at once, with a single check of the markets conversion graph
+  const auto conversionPaths = _exchangePublic.findMarketsPaths(
+      currencies, equiCurrency, markets, fiats, ExchangePublic::MarketPathMode::kWithPossibleFiatConversionAtExtremity);
+
+  // Order books of all markets are retrieved with a single query, at the first conversion needing them
+  MarketOrderBookMap marketOrderBookMap;
   ExchangeName exchangeName = this->exchangeName();
 
+  auto conversionPathIt = conversionPaths.begin();
   for (auto &[amount, equi] : balancePortfolio) {
-    MarketsPath conversionPath =
-        _exchangePublic.findMarketsPath(amount.currencyCode(), equiCurrency, markets, fiats,
-                                        ExchangePublic::MarketPathMode::kWithPossibleFiatConversionAtExtremity);
-    equi = _exchangePublic.convert(amount, equiCurrency, conversionPath, fiats, marketOrderBookMap)
+    equi = _exchangePublic.convert(amount, equiCurrency, *conversionPathIt, fiats, marketOrderBookMap)
                .value_or(MonetaryAmount(0, equiCurrency));
+    ++conversionPathIt;
     log::trace("{} Balance {} (eq. {})", exchangeName, amount, equi);
   }
 }
@@ -643,6 +653,7 @@ SentWithdrawInfo ExchangePrivate::isWithdrawSuccessfullySent(const InitiatedWith
 }
 
 PermanentCurlOptions::Builder ExchangePrivate::permanentCurlOptionsBuilder() const {
-  return ExchangePermanentCurlOptions(exchangeConfig().query).builderBase(ExchangePermanentCurlOptions::Api::Private);
+  return ExchangePermanentCurlOptions(exchangeConfig().query, _exchangePublic._weightedRateLimiterPtr.get())
+      .builderBase(ExchangePermanentCurlOptions::Api::Private);
 }
 }  // namespace cct::api
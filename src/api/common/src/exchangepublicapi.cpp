@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -10,20 +9,22 @@
 #include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <utility>
 
-#include "cct_allocator.hpp"
+#include "apiquerytypeenum.hpp"
+#include "cachedresult.hpp"
 #include "cct_exception.hpp"
-#include "cct_flatset.hpp"
 #include "cct_log.hpp"
-#include "cct_smallset.hpp"
-#include "cct_smallvector.hpp"
 #include "cct_vector.hpp"
 #include "coincenterinfo.hpp"
 #include "commonapi.hpp"
+#include "curl-multi-engine.hpp"
+#include "curlhandle.hpp"
 #include "currencycode.hpp"
 #include "currencycodeset.hpp"
+#include "exchange-config.hpp"
 #include "exchange-name-enum.hpp"
 #include "exchange-permanent-curl-options.hpp"
 #include "exchange-tradefees-config.hpp"
@@ -33,15 +34,19 @@
 #include "market-timestamp-set.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "markets-conversion-graph.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetaryamount.hpp"
 #include "permanentcurloptions.hpp"
 #include "priceoptions.hpp"
 #include "priceoptionsdef.hpp"
 #include "public-trade-vector.hpp"
+#include "runmodes.hpp"
 #include "time-window.hpp"
 #include "timedef.hpp"
 #include "toupperlower.hpp"
 #include "unreachable.hpp"
+#include "weighted-rate-limiter.hpp"
 
 #ifdef CCT_ENABLE_PROTO
 #include "proto-market-data-deserializer.hpp"
@@ -68,7 +73,13 @@ ExchangePublic::ExchangePublic(ExchangeNameEnum exchangeNameEnum, FiatConverter
       _commonApi(commonApi),
       _coincenterInfo(coincenterInfo),
       _exchangeConfig(coincenterInfo.exchangeConfig(_exchangeNameEnum)),
-      _marketDataDeserializerPtr(new MarketDataDeserializer(coincenterInfo.dataDir(), name())) {}
+      _marketDataDeserializerPtr(new MarketDataDeserializer(coincenterInfo.dataDir(), name())) {
+  const schema::ExchangeQueryHttpConfig &httpConfig = _exchangeConfig.query.http;
+  if (httpConfig.weightLimit > 0) {
+    _weightedRateLimiterPtr = std::make_unique<WeightedRateLimiter>(
+        httpConfig.weightLimit, httpConfig.weightWindow.duration, httpConfig.usedWeightHeader);
+  }
+}
 
 ExchangePublic::~ExchangePublic() = default;
 
@@ -86,7 +97,6 @@ std::optional<MonetaryAmount> ExchangePublic::convert(MonetaryAmount from, Curre
                                                       : schema::ExchangeTradeFeesConfig::FeeType::Maker;
 
   if (marketOrderBookMap.empty()) {
-    std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
     marketOrderBookMap = queryAllApproximatedOrderBooks(1);
   }
 
@@ -137,155 +147,87 @@ std::optional<MonetaryAmount> ExchangePublic::convert(MonetaryAmount from, Curre
   return from;
 }
 
-namespace {
-
-// Struct containing a currency and additional information to create markets with detailed information (order, market
-// type)
-struct CurrencyDir {
-  enum class Dir : int8_t { kExchangeOrder, kReversed };
-
-  constexpr std::strong_ordering operator<=>(const CurrencyDir &) const noexcept = default;
-
-  CurrencyCode cur;
-  Dir dir = Dir::kExchangeOrder;
-  Market::Type marketType = Market::Type::kRegularExchangeMarket;
-};
-
-using CurrencyDirPath = SmallVector<CurrencyDir, 3>;
-
-class CurrencyDirFastestPathComparator {
- public:
-  explicit CurrencyDirFastestPathComparator(CommonAPI &commonApi) : _commonApi(commonApi) {}
+bool ExchangePublic::isFiatConvertible(CurrencyCode currencyCode, const CurrencyCodeSet &fiats) const {
+  return _coincenterInfo.tryConvertStableCoinToFiat(currencyCode).isDefined() || fiats.contains(currencyCode);
+}
 
-  bool operator()(const CurrencyDirPath &lhs, const CurrencyDirPath &rhs) {
-    // First, favor paths with the least number of non regular markets
-    const auto hasNonRegularMarket = [](CurrencyDir curDir) {
-      return curDir.marketType != Market::Type::kRegularExchangeMarket;
-    };
-    const auto lhsNbNonRegularMarkets = std::ranges::count_if(lhs, hasNonRegularMarket);
-    const auto rhsNbNonRegularMarkets = std::ranges::count_if(rhs, hasNonRegularMarket);
-    if (lhsNbNonRegularMarkets != rhsNbNonRegularMarkets) {
-      return lhsNbNonRegularMarkets > rhsNbNonRegularMarkets;
-    }
+MarketsConversionGraph *ExchangePublic::getMarketsConversionGraph(const MarketSet &markets,
+                                                                  const CurrencyCodeSet &fiats) {
+  if (markets.empty()) {
+    log::error("No markets retrieved for {}", name());
+    return nullptr;
+  }
 
-    // First, favor the shortest path
-    if (lhs.size() != rhs.size()) {
-      return lhs.size() > rhs.size();
-    }
-    // For equal path sizes, favor non-fiat currencies. Two reasons for this:
-    // - In some countries, tax are automatically collected when any conversion to a fiat on an exchange is made
-    // - It may have the highest volume, as fiats are only present on some regions
-    const auto isFiat = [this](CurrencyDir curDir) { return _commonApi.queryIsCurrencyCodeFiat(curDir.cur); };
-    const auto lhsNbFiats = std::ranges::count_if(lhs, isFiat);
-    const auto rhsNbFiats = std::ranges::count_if(rhs, isFiat);
-    if (lhsNbFiats != rhsNbFiats) {
-      return lhsNbFiats > rhsNbFiats;
-    }
-    // Equal path length, equal number of fiats. Compare lexicographically the two to ensure deterministic behavior
-    return !std::ranges::lexicographical_compare(lhs, rhs);
+  if (!_marketsConversionGraph.isBuiltFrom(markets, fiats)) {
+    log::debug("Building markets conversion graph of {} from {} markets", name(), markets.size());
+    _marketsConversionGraph = MarketsConversionGraph(
+        markets, fiats, [this, &fiats](CurrencyCode cur) { return isFiatConvertible(cur, fiats); });
   }
+  return &_marketsConversionGraph;
+}
 
- private:
-  CommonAPI &_commonApi;
-};
-}  // namespace
+MarketsPath ExchangePublic::findMarketsPath(MarketsConversionGraph &marketsConversionGraph, CurrencyCode fromCurrency,
+                                            CurrencyCode toCurrency, const CurrencyCodeSet &fiats,
+                                            MarketPathMode marketsPathMode) {
+  if (marketsPathMode == MarketPathMode::kWithPossibleFiatConversionAtExtremity) {
+    return marketsConversionGraph.findMarketsPathWithFiatConversionAtExtremity(
+        fromCurrency, isFiatConvertible(fromCurrency, fiats), toCurrency, isFiatConvertible(toCurrency, fiats));
+  }
+  return marketsConversionGraph.findMarketsPath(fromCurrency, toCurrency);
+}
 
 MarketsPath ExchangePublic::findMarketsPath(CurrencyCode fromCurrency, CurrencyCode toCurrency, MarketSet &markets,
                                             const CurrencyCodeSet &fiats, MarketPathMode marketsPathMode) {
-  MarketsPath ret;
   if (fromCurrency == toCurrency) {
-    return ret;
+    return {};
   }
 
-  const auto isFiatConvertible = [this, marketsPathMode, &fiats](CurrencyCode cur) {
-    return marketsPathMode == MarketPathMode::kWithPossibleFiatConversionAtExtremity &&
-           (_coincenterInfo.tryConvertStableCoinToFiat(cur).isDefined() || fiats.contains(cur));
-  };
-
-  const auto isToCurrencyFiatConvertible = isFiatConvertible(toCurrency);
-
-  CurrencyDirFastestPathComparator comp(_commonApi);
+  // Retrieve markets if not already done, before locking the graph as it may trigger a query
+  if (markets.empty()) {
+    markets = queryTradableMarkets();
+  }
 
-  vector<CurrencyDirPath> searchPaths(1, CurrencyDirPath(1, CurrencyDir(fromCurrency)));
-  using VisitedCurrencyCodesSet =
-      SmallSet<CurrencyCode, 10U, std::less<>, allocator<CurrencyCode>, FlatSet<CurrencyCode, std::less<>>>;
-  VisitedCurrencyCodesSet visitedCurrencies;
-  while (!searchPaths.empty()) {
-    std::ranges::pop_heap(searchPaths, comp);
-    CurrencyDirPath path = std::move(searchPaths.back());
-    searchPaths.pop_back();
+  std::lock_guard<std::mutex> guard(_marketsConversionGraphMutex);
 
-    CurrencyCode cur = path.back().cur;
-    if (visitedCurrencies.contains(cur)) {
-      continue;
-    }
+  MarketsConversionGraph *pMarketsConversionGraph = getMarketsConversionGraph(markets, fiats);
+  if (pMarketsConversionGraph == nullptr) {
+    return {};
+  }
+  return findMarketsPath(*pMarketsConversionGraph, fromCurrency, toCurrency, fiats, marketsPathMode);
+}
 
-    if (cur == toCurrency) {
-      // stop criteria
-      const int nbCurDir = path.size();
-      ret.reserve(nbCurDir - 1);
-      for (int curDirPos = 1; curDirPos < nbCurDir; ++curDirPos) {
-        const auto curDir = path[curDirPos];
-        switch (curDir.dir) {
-          case CurrencyDir::Dir::kExchangeOrder:
-            ret.emplace_back(path[curDirPos - 1].cur, curDir.cur, curDir.marketType);
-            break;
-          case CurrencyDir::Dir::kReversed:
-            ret.emplace_back(curDir.cur, path[curDirPos - 1].cur, curDir.marketType);
-            break;
-          default:
-            unreachable();
-        }
-      }
-      return ret;
-    }
+vector<MarketsPath> ExchangePublic::findMarketsPaths(std::span<const CurrencyCode> fromCurrencyCodes,
+                                                     CurrencyCode toCurrencyCode, MarketSet &markets,
+                                                     const CurrencyCodeSet &fiats, MarketPathMode marketsPathMode) {
+  vector<MarketsPath> ret(fromCurrencyCodes.size());
+  if (std::ranges::all_of(fromCurrencyCodes, [toCurrencyCode](CurrencyCode cur) { return cur == toCurrencyCode; })) {
+    return ret;
+  }
 
-    // Retrieve markets if not already done
-    if (markets.empty()) {
-      std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
-      markets = queryTradableMarkets();
-      if (markets.empty()) {
-        log::error("No markets retrieved for {}", name());
-        return ret;
-      }
-    }
+  if (markets.empty()) {
+    markets = queryTradableMarkets();
+  }
 
-    bool reachedTargetCurrency = false;
-    for (Market mk : markets | std::views::filter([cur](Market mk) { return mk.canTrade(cur); })) {
-      const auto dir = cur == mk.quote() ? CurrencyDir::Dir::kReversed : CurrencyDir::Dir::kExchangeOrder;
-      const CurrencyCode newCur = mk.opposite(cur);
+  std::lock_guard<std::mutex> guard(_marketsConversionGraphMutex);
 
-      reachedTargetCurrency = reachedTargetCurrency || (newCur == toCurrency);
+  // Graph is checked against the markets only once for all paths
+  MarketsConversionGraph *pMarketsConversionGraph = getMarketsConversionGraph(markets, fiats);
+  if (pMarketsConversionGraph == nullptr) {
+    return ret;
+  }
 
-      CurrencyDirPath &newPath = searchPaths.emplace_back(path);
-      newPath.emplace_back(newCur, dir, Market::Type::kRegularExchangeMarket);
-      std::ranges::push_heap(searchPaths, comp);
-    }
+  // All paths without fiat conversion are read from the single shortest path tree of the target currency
+  ret = pMarketsConversionGraph->findMarketsPathsTo(fromCurrencyCodes, toCurrencyCode);
 
-    if (isFiatConvertible(cur)) {
-      if (isToCurrencyFiatConvertible && !reachedTargetCurrency) {
-        CurrencyDirPath &newPath = searchPaths.emplace_back(path);
-        newPath.emplace_back(toCurrency, CurrencyDir::Dir::kExchangeOrder, Market::Type::kFiatConversionMarket);
-        std::ranges::push_heap(searchPaths, comp);
-      } else if (path.size() == 1 && searchPaths.empty()) {
-        // A conversion is possible from starting fiat currency
-        for (Market mk : markets) {
-          if (fiats.contains(mk.base())) {
-            CurrencyDirPath &newPath = searchPaths.emplace_back(path);
-            newPath.emplace_back(mk.base(), CurrencyDir::Dir::kExchangeOrder, Market::Type::kFiatConversionMarket);
-            std::ranges::push_heap(searchPaths, comp);
-          } else if (fiats.contains(mk.quote())) {
-            CurrencyDirPath &newPath = searchPaths.emplace_back(path);
-            newPath.emplace_back(mk.quote(), CurrencyDir::Dir::kExchangeOrder, Market::Type::kFiatConversionMarket);
-            std::ranges::push_heap(searchPaths, comp);
-          }
-        }
+  if (marketsPathMode == MarketPathMode::kWithPossibleFiatConversionAtExtremity) {
+    for (decltype(ret.size()) pathPos = 0; pathPos < ret.size(); ++pathPos) {
+      const CurrencyCode fromCurrencyCode = fromCurrencyCodes[pathPos];
+      if (ret[pathPos].empty() && fromCurrencyCode != toCurrencyCode) {
+        ret[pathPos] =
+            findMarketsPath(*pMarketsConversionGraph, fromCurrencyCode, toCurrencyCode, fiats, marketsPathMode);
       }
     }
-
-    visitedCurrencies.insert(std::move(cur));
   }
-
   return ret;
 }
 
@@ -339,7 +281,6 @@ std::optional<Market> ExchangePublic::RetrieveMarket(CurrencyCode c1, CurrencyCo
 }
 
 std::optional<Market> ExchangePublic::retrieveMarket(CurrencyCode c1, CurrencyCode c2) {
-  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   return RetrieveMarket(c1, c2, queryTradableMarkets());
 }
 
@@ -391,7 +332,6 @@ std::optional<Market> ExchangePublic::determineMarketFromMarketStr(std::string_v
   if (markets.empty()) {
     // Without any currency, and because "marketStr" is returned without hyphen, there is no easy way to guess the
     // currencies so we need to compare with the markets that exist
-    std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
     markets = queryTradableMarkets();
   }
 
@@ -421,7 +361,6 @@ std::optional<Market> ExchangePublic::determineMarketFromMarketStr(std::string_v
 Market ExchangePublic::determineMarketFromFilterCurrencies(MarketSet &markets, CurrencyCode filterCur1,
                                                            CurrencyCode filterCur2) {
   if (markets.empty()) {
-    std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
     markets = queryTradableMarkets();
   }
 
@@ -473,21 +412,43 @@ MonetaryAmount ExchangePublic::queryWithdrawalFeeOrZero(CurrencyCode currencyCod
 }
 
 MarketOrderBook ExchangePublic::getOrderBook(Market mk, int depth) {
-  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   const auto marketOrderBook = queryOrderBook(mk, depth);
 
   if (_exchangeConfig.query.marketDataSerialization) {
+    std::lock_guard<std::mutex> guard(_marketDataSerializerMutex);
     getMarketDataSerializer().push(marketOrderBook);
   }
   return marketOrderBook;
 }
 
+MarketOrderBookVector ExchangePublic::getOrderBooks(std::span<const Market> markets, int depth) {
+  auto marketOrderBooks = queryOrderBooks(markets, depth);
+
+  if (_exchangeConfig.query.marketDataSerialization) {
+    std::lock_guard<std::mutex> guard(_marketDataSerializerMutex);
+    auto &marketDataSerializer = getMarketDataSerializer();
+    for (const auto &marketOrderBook : marketOrderBooks) {
+      marketDataSerializer.push(marketOrderBook);
+    }
+  }
+  return marketOrderBooks;
+}
+
+MarketOrderBookVector ExchangePublic::queryOrderBooks(std::span<const Market> markets, int depth) {
+  MarketOrderBookVector marketOrderBooks;
+  marketOrderBooks.reserve(markets.size());
+  for (Market market : markets) {
+    marketOrderBooks.push_back(queryOrderBook(market, depth));
+  }
+  return marketOrderBooks;
+}
+
 /// Retrieve an ordered vector of recent last trades
 PublicTradeVector ExchangePublic::getLastTrades(Market mk, int nbTrades) {
-  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   const auto lastTrades = queryLastTrades(mk, nbTrades);
 
   if (_exchangeConfig.query.marketDataSerialization) {
+    std::lock_guard<std::mutex> guard(_marketDataSerializerMutex);
     getMarketDataSerializer().push(mk, lastTrades);
   }
   return lastTrades;
@@ -509,6 +470,45 @@ MarketOrderBookVector ExchangePublic::pullMarketOrderBooksForReplay(Market marke
   return _marketDataDeserializerPtr->pullMarketOrderBooks(market, timeWindow);
 }
 
+int ExchangePublic::compactMarketDataForReplay(Market market) {
+  return _marketDataDeserializerPtr->compactMarketData(market);
+}
+
+int ExchangePublic::refreshCachesAhead(Duration horizon) {
+  return _cachedResultVault.refreshAhead(horizon);
+}
+
+CachedResultOptions ExchangePublic::cachedResultOptions(QueryType queryType) {
+  const auto &queryConfig = exchangeConfig().query;
+  return {queryConfig.getUpdateFrequency(queryType), queryConfig.getRefreshAheadFrequency(queryType),
+          _cachedResultVault, _publicRequestsMutex};
+}
+
+bool ExchangePublic::isMetadataCacheEnabled() const {
+  return !settings::AreQueryResponsesOverriden(_coincenterInfo.getRunMode());
+}
+
+bool ExchangePublic::isCurlMultiEngineEnabled() const {
+  const auto runMode = _coincenterInfo.getRunMode();
+  return !settings::AreQueryResponsesOverriden(runMode) && !settings::IsProxyRequested(runMode);
+}
+
+CurlMultiEngine::QueueId ExchangePublic::curlMultiEngineQueueId(const CurlHandle &curlHandle) {
+  std::call_once(_curlMultiEngineQueueOnceFlag, [this, &curlHandle] {
+    // Same URLs and permanent options as the CurlHandle, including the shared weighted rate limiter.
+    // Queries are spaced together with the ones of the CurlHandle, as they target the same exchange API.
+    _curlMultiEngineQueueId = _commonApi.curlMultiEngine().addQueue(
+        curlHandle.bestURLPicker(),
+        permanentCurlOptionsBuilder().setQueryIntervalLimiter(curlHandle.queryIntervalLimiter()).build(),
+        _coincenterInfo.metricGatewayPtr());
+  });
+  return _curlMultiEngineQueueId;
+}
+
+MetadataCacheFile ExchangePublic::createMetadataCacheFile() const {
+  return {_coincenterInfo.dataDir(), _exchangeNameEnum};
+}
+
 AbstractMarketDataSerializer &ExchangePublic::getMarketDataSerializer() {
   if (_marketDataSerializerPtr) {
     return *_marketDataSerializerPtr;
@@ -524,14 +524,18 @@ AbstractMarketDataSerializer &ExchangePublic::getMarketDataSerializer() {
   const MarketTimestampSets marketTimestampSets{pullMarketOrderBooksMarkets(largeTimeWindow),
                                                 pullTradeMarkets(largeTimeWindow)};
 
-  _marketDataSerializerPtr =
-      std::make_unique<MarketDataSerializer>(_coincenterInfo.dataDir(), marketTimestampSets, name());
+  const auto &queryConfig = _exchangeConfig.query;
+
+  _marketDataSerializerPtr = std::make_unique<MarketDataSerializer>(
+      _coincenterInfo.dataDir(), marketTimestampSets, name(), queryConfig.marketDataSerializationQueueSize,
+      queryConfig.marketDataSerializationMemoryBudget.sizeInBytes, _coincenterInfo.metricGatewayPtr());
 
   return *_marketDataSerializerPtr;
 }
 
 PermanentCurlOptions::Builder ExchangePublic::permanentCurlOptionsBuilder() const {
-  return ExchangePermanentCurlOptions(exchangeConfig().query).builderBase(ExchangePermanentCurlOptions::Api::Public);
+  return ExchangePermanentCurlOptions(exchangeConfig().query, _weightedRateLimiterPtr.get())
+      .builderBase(ExchangePermanentCurlOptions::Api::Public);
 }
 
 }  // namespace cct::api
@@ -0,0 +1,80 @@
+#include "json-web-token-builder.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "base64.hpp"
+#include "cct_string.hpp"
+#include "ssl_sha.hpp"
+
+namespace cct::ssl {
+
+namespace {
+
+/// Appends the base64url encoding (without padding) of given data to 'out'.
+void AppendB64UrlEncoded(std::span<const char> data, string& out) {
+  const auto startPos = out.size();
+  out.resize(startPos + details::B64EncodedLen(data.size()));
+
+  details::B64EncodeImpl(data, out.data() + startPos, out.data() + out.size());
+
+  const auto encodedBegin = out.begin() + static_cast<string::difference_type>(startPos);
+
+  std::replace(encodedBegin, out.end(), '+', '-');
+  std::replace(encodedBegin, out.end(), '/', '_');
+
+  while (out.back() == '=') {
+    out.pop_back();
+  }
+}
+
+void AppendClaims(std::span<const std::pair<std::string_view, std::string_view>> claims, string& out) {
+  for (const auto& [key, value] : claims) {
+    if (out.back() != '{') {
+      out.push_back(',');
+    }
+    out.push_back('"');
+    out.append(key);
+    out.append(R"(":")");
+    out.append(value);
+    out.push_back('"');
+  }
+}
+
+}  // namespace
+
+template <ShaType shaType>
+JsonWebTokenBuilder<shaType>::JsonWebTokenBuilder(std::string_view secret, std::span<const Claim> fixedClaims)
+    : _signer(secret), _payloadPrefix(1, '{') {
+  static constexpr std::string_view kHeader =
+      shaType == ShaType::kSha256 ? R"({"alg":"HS256","typ":"JWT"})" : R"({"alg":"HS512","typ":"JWT"})";
+
+  AppendB64UrlEncoded(kHeader, _encodedHeaderWithDot);
+  _encodedHeaderWithDot.push_back('.');
+
+  AppendClaims(fixedClaims, _payloadPrefix);
+}
+
+template <ShaType shaType>
+string JsonWebTokenBuilder<shaType>::build(std::span<const Claim> claims) const {
+  string payload = _payloadPrefix;
+  AppendClaims(claims, payload);
+  payload.push_back('}');
+
+  string token = _encodedHeaderWithDot;
+  AppendB64UrlEncoded(payload, token);
+
+  const auto signature = _signer.sign(token);
+
+  token.push_back('.');
+  AppendB64UrlEncoded(signature, token);
+
+  return token;
+}
+
+template class JsonWebTokenBuilder<ShaType::kSha256>;
+template class JsonWebTokenBuilder<ShaType::kSha512>;
+
+}  // namespace cct::ssl
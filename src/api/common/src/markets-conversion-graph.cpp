@@ -0,0 +1,272 @@
+#include "markets-conversion-graph.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include "cct_vector.hpp"
+#include "currencycode.hpp"
+#include "currencycodeset.hpp"
+#include "exchangepublicapitypes.hpp"
+#include "market.hpp"
+
+namespace cct::api {
+
+MarketsConversionGraph::MarketsConversionGraph(const MarketSet &markets, const CurrencyCodeSet &fiats)
+    : _markets(markets), _fiats(fiats) {
+  _currencies.reserve(2U * markets.size());
+  for (Market market : markets) {
+    if (market.base() != market.quote()) {
+      _currencies.push_back(market.base());
+      _currencies.push_back(market.quote());
+    }
+  }
+  std::ranges::sort(_currencies);
+  const auto [eraseIt, endIt] = std::ranges::unique(_currencies);
+  _currencies.erase(eraseIt, endIt);
+
+  const auto nbCurrencies = _currencies.size();
+
+  _currencyFlags.resize(nbCurrencies);
+  for (CurrencyCode fiat : fiats) {
+    const CurrencyId fiatId = currencyId(fiat);
+    if (fiatId != PathNode::kUnreachedId) {
+      _currencyFlags[fiatId] |= kFiat;
+    }
+  }
+
+  // Compressed sparse row adjacency: edges of currency 'id' are in [_edgesOffsets[id], _edgesOffsets[id + 1])
+  _edgesOffsets.resize(nbCurrencies + 1U);
+  for (Market market : markets) {
+    if (market.base() != market.quote()) {
+      ++_edgesOffsets[currencyId(market.base()) + 1];
+      ++_edgesOffsets[currencyId(market.quote()) + 1];
+    }
+  }
+  std::partial_sum(_edgesOffsets.begin(), _edgesOffsets.end(), _edgesOffsets.begin());
+
+  _edges.resize(_edgesOffsets.back());
+  vector<CurrencyId> insertPositions(_edgesOffsets.begin(), _edgesOffsets.end() - 1);
+  for (Market market : markets) {
+    if (market.base() != market.quote()) {
+      const CurrencyId baseId = currencyId(market.base());
+      const CurrencyId quoteId = currencyId(market.quote());
+      _edges[insertPositions[baseId]++] = Edge{quoteId, Dir::kExchangeOrder};
+      _edges[insertPositions[quoteId]++] = Edge{baseId, Dir::kReversed};
+    }
+  }
+
+  _shortestPathTrees.resize(nbCurrencies);
+}
+
+bool MarketsConversionGraph::isBuiltFrom(const MarketSet &markets, const CurrencyCodeSet &fiats) const {
+  return std::ranges::equal(_markets, markets) && std::ranges::equal(_fiats, fiats);
+}
+
+MarketsConversionGraph::CurrencyId MarketsConversionGraph::currencyId(CurrencyCode currencyCode) const {
+  const auto it = std::ranges::lower_bound(_currencies, currencyCode);
+  if (it == _currencies.end() || *it != currencyCode) {
+    return PathNode::kUnreachedId;
+  }
+  return static_cast<CurrencyId>(it - _currencies.begin());
+}
+
+const MarketsConversionGraph::ShortestPathTree &MarketsConversionGraph::shortestPathTree(CurrencyId sourceId) {
+  ShortestPathTree &pathTree = _shortestPathTrees[sourceId];
+  if (!pathTree.empty()) {
+    return pathTree;
+  }
+
+  pathTree.resize(_currencies.size());
+  pathTree[sourceId] = PathNode{sourceId, 0, 0, static_cast<int16_t>(hasFlag(sourceId, kFiat)), Dir::kExchangeOrder};
+
+  // Breadth first search, one layer of currencies at a time. For each currency, the best predecessor is chosen among
+  // the currencies of the previous layer according to the path ordering, so that all paths are optimal.
+  vector<CurrencyId> layer(1, sourceId);
+  vector<CurrencyId> nextLayer;
+  for (int16_t nbConversions = 1; !layer.empty(); ++nbConversions) {
+    nextLayer.clear();
+    for (CurrencyId curId : layer) {
+      const PathNode &node = pathTree[curId];
+      for (auto edgePos = _edgesOffsets[curId]; edgePos < _edgesOffsets[curId + 1]; ++edgePos) {
+        const Edge edge = _edges[edgePos];
+        PathNode &targetNode = pathTree[edge.targetId];
+        const auto targetNbFiats = static_cast<int16_t>(node.nbFiats + hasFlag(edge.targetId, kFiat));
+        if (!targetNode.isReached()) {
+          targetNode = PathNode{curId, 0, nbConversions, targetNbFiats, edge.dir};
+          nextLayer.push_back(edge.targetId);
+        } else if (targetNode.nbConversions == nbConversions) {
+          const PathNode &predecessorNode = pathTree[targetNode.predecessorId];
+          if (std::tie(node.nbFiats, node.lexicographicalRank, edge.dir) <
+              std::tie(predecessorNode.nbFiats, predecessorNode.lexicographicalRank, targetNode.dir)) {
+            targetNode.predecessorId = curId;
+            targetNode.nbFiats = targetNbFiats;
+            targetNode.dir = edge.dir;
+          }
+        }
+      }
+    }
+
+    // Currency ids are in the order of the currency codes, so paths of the new layer are ordered by their prefix first
+    std::ranges::sort(nextLayer, [&pathTree](CurrencyId lhs, CurrencyId rhs) {
+      const CurrencyId lhsPredecessorRank = pathTree[pathTree[lhs].predecessorId].lexicographicalRank;
+      const CurrencyId rhsPredecessorRank = pathTree[pathTree[rhs].predecessorId].lexicographicalRank;
+      return std::tie(lhsPredecessorRank, lhs) < std::tie(rhsPredecessorRank, rhs);
+    });
+    for (CurrencyId rank = 0; rank < static_cast<CurrencyId>(nextLayer.size()); ++rank) {
+      pathTree[nextLayer[rank]].lexicographicalRank = rank;
+    }
+
+    std::swap(layer, nextLayer);
+  }
+
+  return pathTree;
+}
+
+Market MarketsConversionGraph::predecessorMarket(const ShortestPathTree &pathTree, CurrencyId curId) const {
+  const PathNode &node = pathTree[curId];
+  const CurrencyCode cur = _currencies[curId];
+  const CurrencyCode predecessorCur = _currencies[node.predecessorId];
+  return node.dir == Dir::kExchangeOrder ? Market(predecessorCur, cur) : Market(cur, predecessorCur);
+}
+
+void MarketsConversionGraph::appendMarketsPath(const ShortestPathTree &pathTree, CurrencyId targetId,
+                                               MarketsPath &marketsPath) const {
+  const auto startPos = marketsPath.size();
+  appendPathToRoot(pathTree, targetId, marketsPath);
+  std::reverse(marketsPath.begin() + startPos, marketsPath.end());
+}
+
+void MarketsConversionGraph::appendPathToRoot(const ShortestPathTree &pathTree, CurrencyId sourceId,
+                                              MarketsPath &marketsPath) const {
+  // Markets do not depend on the conversion direction, so walking up the tree gives the path in conversion order
+  for (CurrencyId curId = sourceId; pathTree[curId].predecessorId != curId; curId = pathTree[curId].predecessorId) {
+    marketsPath.push_back(predecessorMarket(pathTree, curId));
+  }
+}
+
+MarketsPath MarketsConversionGraph::findMarketsPath(CurrencyCode fromCurrency, CurrencyCode toCurrency) {
+  MarketsPath ret;
+  const CurrencyId fromId = currencyId(fromCurrency);
+  const CurrencyId toId = currencyId(toCurrency);
+  if (fromId == PathNode::kUnreachedId || toId == PathNode::kUnreachedId || fromId == toId) {
+    return ret;
+  }
+  const ShortestPathTree &pathTree = shortestPathTree(fromId);
+  if (pathTree[toId].isReached()) {
+    appendMarketsPath(pathTree, toId, ret);
+  }
+  return ret;
+}
+
+MarketsPath MarketsConversionGraph::findMarketsPathWithFiatConversionAtExtremity(CurrencyCode fromCurrency,
+                                                                                 bool isFromCurrencyFiatConvertible,
+                                                                                 CurrencyCode toCurrency,
+                                                                                 bool isToCurrencyFiatConvertible) {
+  // A path without any fiat conversion is always preferred
+  MarketsPath ret = findMarketsPath(fromCurrency, toCurrency);
+  if (!ret.empty() || fromCurrency == toCurrency) {
+    return ret;
+  }
+
+  if (isFromCurrencyFiatConvertible && isToCurrencyFiatConvertible) {
+    ret.emplace_back(fromCurrency, toCurrency, Market::Type::kFiatConversionMarket);
+    return ret;
+  }
+
+  const CurrencyId fromId = currencyId(fromCurrency);
+  if (isToCurrencyFiatConvertible) {
+    // Convert to the closest fiat convertible currency, and then convert it to 'toCurrency' outside of the exchange
+    if (fromId == PathNode::kUnreachedId) {
+      return ret;
+    }
+    const ShortestPathTree &pathTree = shortestPathTree(fromId);
+    CurrencyId bestId = PathNode::kUnreachedId;
+    for (CurrencyId curId = 0; curId < nbCurrencies(); ++curId) {
+      const PathNode &node = pathTree[curId];
+      if (!hasFlag(curId, kFiatConvertible) || !node.isReached()) {
+        continue;
+      }
+      if (bestId == PathNode::kUnreachedId) {
+        bestId = curId;
+      } else {
+        const PathNode &bestNode = pathTree[bestId];
+        if (std::tie(node.nbConversions, node.nbFiats, node.lexicographicalRank) <
+            std::tie(bestNode.nbConversions, bestNode.nbFiats, bestNode.lexicographicalRank)) {
+          bestId = curId;
+        }
+      }
+    }
+    if (bestId != PathNode::kUnreachedId) {
+      appendMarketsPath(pathTree, bestId, ret);
+      ret.emplace_back(_currencies[bestId], toCurrency, Market::Type::kFiatConversionMarket);
+    }
+  } else if (isFromCurrencyFiatConvertible && fromId == PathNode::kUnreachedId) {
+    // 'fromCurrency' is not traded on the exchange - convert it first to the fiat from which 'toCurrency' is closest
+    const CurrencyId toId = currencyId(toCurrency);
+    if (toId == PathNode::kUnreachedId) {
+      return ret;
+    }
+    CurrencyId bestFiatId = PathNode::kUnreachedId;
+    for (CurrencyId fiatId = 0; fiatId < nbCurrencies(); ++fiatId) {
+      if (!hasFlag(fiatId, kFiat)) {
+        continue;
+      }
+      const PathNode &node = shortestPathTree(fiatId)[toId];
+      if (!node.isReached()) {
+        continue;
+      }
+      // Fiats are iterated in the order of their codes, only a strictly better path can replace the best one
+      if (bestFiatId == PathNode::kUnreachedId) {
+        bestFiatId = fiatId;
+      } else {
+        const PathNode &bestNode = _shortestPathTrees[bestFiatId][toId];
+        if (std::tie(node.nbConversions, node.nbFiats) < std::tie(bestNode.nbConversions, bestNode.nbFiats)) {
+          bestFiatId = fiatId;
+        }
+      }
+    }
+    if (bestFiatId != PathNode::kUnreachedId) {
+      ret.emplace_back(fromCurrency, _currencies[bestFiatId], Market::Type::kFiatConversionMarket);
+      appendMarketsPath(_shortestPathTrees[bestFiatId], toId, ret);
+    }
+  }
+  return ret;
+}
+
+vector<MarketsPath> MarketsConversionGraph::findMarketsPathsTo(std::span<const CurrencyCode> fromCurrencies,
+                                                               CurrencyCode toCurrency) {
+  vector<MarketsPath> ret(fromCurrencies.size());
+  const CurrencyId toId = currencyId(toCurrency);
+  if (toId == PathNode::kUnreachedId) {
+    return ret;
+  }
+  const ShortestPathTree &pathTree = shortestPathTree(toId);
+  for (decltype(fromCurrencies.size()) fromPos = 0; fromPos < fromCurrencies.size(); ++fromPos) {
+    const CurrencyId fromId = currencyId(fromCurrencies[fromPos]);
+    if (fromId != PathNode::kUnreachedId && fromId != toId && pathTree[fromId].isReached()) {
+      appendPathToRoot(pathTree, fromId, ret[fromPos]);
+    }
+  }
+  return ret;
+}
+
+vector<std::pair<CurrencyCode, MarketsPath>> MarketsConversionGraph::findAllMarketsPaths(CurrencyCode fromCurrency) {
+  vector<std::pair<CurrencyCode, MarketsPath>> ret;
+  const CurrencyId fromId = currencyId(fromCurrency);
+  if (fromId == PathNode::kUnreachedId) {
+    return ret;
+  }
+  const ShortestPathTree &pathTree = shortestPathTree(fromId);
+  for (CurrencyId curId = 0; curId < nbCurrencies(); ++curId) {
+    if (curId != fromId && pathTree[curId].isReached()) {
+      auto &[currencyCode, marketsPath] = ret.emplace_back(_currencies[curId], MarketsPath());
+      appendMarketsPath(pathTree, curId, marketsPath);
+    }
+  }
+  return ret;
+}
+
+}  // namespace cct::api
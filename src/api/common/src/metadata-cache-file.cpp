@@ -0,0 +1,77 @@
+#include "metadata-cache-file.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "enum-string.hpp"
+#include "exchange-name-enum.hpp"
+#include "file.hpp"
+#include "metadata-cache-archive.hpp"
+#include "timedef.hpp"
+
+namespace cct::api {
+
+namespace {
+// To be incremented at each change of the binary format of the metadata cache file, or of the format of any
+// persisted metadata. Files with a different version are ignored.
+constexpr uint32_t kMetadataCacheVersion = 2;
+
+File GetMetadataCacheFile(std::string_view dataDir, ExchangeNameEnum exchangeNameEnum) {
+  string fileName(EnumToString(exchangeNameEnum));
+  fileName.append("-metadata.bin");
+  return {dataDir, File::Type::kCache, fileName, File::IfError::kNoThrow};
+}
+}  // namespace
+
+MetadataCacheFile::MetadataCacheFile(std::string_view dataDir, ExchangeNameEnum exchangeNameEnum)
+    : _file(GetMetadataCacheFile(dataDir, exchangeNameEnum)) {
+  const auto data = _file.readAll();
+  if (data.empty()) {
+    return;
+  }
+  try {
+    MetadataCacheReader reader(data);
+    const auto version = reader.read<uint32_t>();
+    if (version != kMetadataCacheVersion) {
+      log::info("Ignoring {} metadata cache of version {} (current is {})", EnumToString(exchangeNameEnum), version,
+                kMetadataCacheVersion);
+      return;
+    }
+    reader(_sections);
+    log::debug("Loaded {} sections from {} metadata cache", _sections.size(), EnumToString(exchangeNameEnum));
+  } catch (const exception &ex) {
+    log::warn("Ignoring corrupted {} metadata cache: {}", EnumToString(exchangeNameEnum), ex.what());
+    _sections.clear();
+  }
+}
+
+void MetadataCacheFile::write() const {
+  if (_sections.empty()) {
+    return;
+  }
+  MetadataCacheWriter writer;
+  writer(kMetadataCacheVersion, _sections);
+  _file.write(writer.data());
+}
+
+const MetadataCacheFile::Section *MetadataCacheFile::findSection(std::string_view sectionName) const {
+  const auto it = std::ranges::find(_sections, sectionName, [](const Section &section) {
+    return std::string_view(section.name);
+  });
+  return it == _sections.end() ? nullptr : std::addressof(*it);
+}
+
+void MetadataCacheFile::storeSection(std::string_view sectionName, TimePoint lastUpdatedTime, std::string_view data) {
+  const Section *pSection = findSection(sectionName);
+  Section &section = pSection == nullptr ? _sections.emplace_back() : _sections[pSection - _sections.data()];
+  section.name = string(sectionName);
+  section.lastUpdatedTs = lastUpdatedTime.time_since_epoch().count();
+  section.data = string(data);
+}
+
+}  // namespace cct::api
@@ -1,8 +1,10 @@
 ﻿#include "ssl_sha.hpp"
 
+#include <openssl/core_names.h>
 #include <openssl/evp.h>
 #include <openssl/hmac.h>
 #include <openssl/opensslv.h>
+#include <openssl/params.h>
 #include <openssl/sha.h>
 #include <openssl/types.h>
 
@@ -94,22 +96,25 @@ Sha512HexArray Sha512Hex(std::string_view data, std::string_view secret) {
 namespace {
 using EVP_MD_CTX_UniquePtr = std::unique_ptr<EVP_MD_CTX, decltype([](EVP_MD_CTX* ptr) { EVP_MD_CTX_free(ptr); })>;
 
-EVP_MD_CTX_UniquePtr CreateEVP_MD_CTX_UniquePtr(ShaType shaType) {
-  EVP_MD_CTX_UniquePtr mdCtx(EVP_MD_CTX_new());
+/// Returns a digest context initialized for given sha type, reused by all digests of the calling thread.
+EVP_MD_CTX* GetEVP_MD_CTX(ShaType shaType) {
+  thread_local EVP_MD_CTX_UniquePtr mdCtx(EVP_MD_CTX_new());
 
-  EVP_DigestInit_ex(mdCtx.get(), GetEVP_MD(shaType), nullptr);
+  if (mdCtx == nullptr || EVP_DigestInit_ex(mdCtx.get(), GetEVP_MD(shaType), nullptr) != 1) {
+    throw exception("Unable to initialize digest context");
+  }
 
-  return mdCtx;
+  return mdCtx.get();
 }
 
 template <ShaType shaType>
-auto EVPBinToHex(const EVP_MD_CTX_UniquePtr& mdCtx) {
+auto EVPBinToHex(EVP_MD_CTX* mdCtx) {
   static constexpr unsigned int kExpectedLen = ShaDigestLen(shaType);
 
   unsigned int len = kExpectedLen;
   std::array<char, kExpectedLen> binData;
 
-  EVP_DigestFinal_ex(mdCtx.get(), reinterpret_cast<unsigned char*>(binData.data()), &len);
+  EVP_DigestFinal_ex(mdCtx, reinterpret_cast<unsigned char*>(binData.data()), &len);
 
   if (len != kExpectedLen) {
     throw exception("Unexpected result from EVP_DigestFinal_ex: expected len {}, got {}", kExpectedLen, len);
@@ -120,18 +125,18 @@ auto EVPBinToHex(const EVP_MD_CTX_UniquePtr& mdCtx) {
 
 template <ShaType shaType>
 auto ShaDigest(std::string_view data) {
-  auto mdCtx = CreateEVP_MD_CTX_UniquePtr(shaType);
+  auto* mdCtx = GetEVP_MD_CTX(shaType);
 
-  EVP_DigestUpdate(mdCtx.get(), data.data(), data.size());
+  EVP_DigestUpdate(mdCtx, data.data(), data.size());
 
   return EVPBinToHex<shaType>(mdCtx);
 }
 
 template <ShaType shaType>
 auto ShaDigest(std::span<const std::string_view> data) {
-  auto mdCtx = CreateEVP_MD_CTX_UniquePtr(shaType);
+  auto* mdCtx = GetEVP_MD_CTX(shaType);
 
-  std::ranges::for_each(data, [&](std::string_view str) { EVP_DigestUpdate(mdCtx.get(), str.data(), str.size()); });
+  std::ranges::for_each(data, [mdCtx](std::string_view str) { EVP_DigestUpdate(mdCtx, str.data(), str.size()); });
 
   return EVPBinToHex<shaType>(mdCtx);
 }
@@ -145,4 +150,73 @@ Sha256DigestArray Sha256Digest(std::span<const std::string_view> data) { return
 
 Sha512DigestArray Sha512Digest(std::span<const std::string_view> data) { return ShaDigest<ShaType::kSha512>(data); }
 
+template <ShaType shaType>
+void HmacSigner<shaType>::EVP_MAC_CTX_Deleter::operator()(EVP_MAC_CTX* ptr) const noexcept {
+  EVP_MAC_CTX_free(ptr);
+}
+
+template <ShaType shaType>
+HmacSigner<shaType>::HmacSigner(std::string_view secret) {
+  using EVP_MAC_UniquePtr = std::unique_ptr<EVP_MAC, decltype([](EVP_MAC* ptr) { EVP_MAC_free(ptr); })>;
+
+  // context keeps its own reference on the MAC algorithm
+  EVP_MAC_UniquePtr mac(EVP_MAC_fetch(nullptr, OSSL_MAC_NAME_HMAC, nullptr));
+  if (mac == nullptr) {
+    throw exception("Unable to fetch HMAC algorithm");
+  }
+
+  _pKeyedMacCtx.reset(EVP_MAC_CTX_new(mac.get()));
+  if (_pKeyedMacCtx == nullptr) {
+    throw exception("Unable to create HMAC context");
+  }
+
+  // OSSL_PARAM takes a non const string, but it is only read by EVP_MAC_init
+  auto* digestName = const_cast<char*>(EVP_MD_get0_name(GetEVP_MD(shaType)));
+  const OSSL_PARAM params[] = {OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digestName, 0),
+                               OSSL_PARAM_construct_end()};
+
+  // key pointer should not be null, even for an empty secret, otherwise no key is set
+  static constexpr unsigned char kEmptyKey[1]{};
+  const auto* key = secret.empty() ? kEmptyKey : reinterpret_cast<const unsigned char*>(secret.data());
+
+  if (EVP_MAC_init(_pKeyedMacCtx.get(), key, secret.size(), params) != 1) {
+    throw exception("Unable to initialize HMAC context");
+  }
+}
+
+template <ShaType shaType>
+typename HmacSigner<shaType>::BinArray HmacSigner<shaType>::sign(std::string_view data) const {
+  return sign(std::span<const std::string_view>(&data, 1));
+}
+
+template <ShaType shaType>
+typename HmacSigner<shaType>::BinArray HmacSigner<shaType>::sign(std::span<const std::string_view> data) const {
+  EVP_MAC_CTX_UniquePtr macCtx(EVP_MAC_CTX_dup(_pKeyedMacCtx.get()));
+  if (macCtx == nullptr) {
+    throw exception("Unable to duplicate HMAC context");
+  }
+
+  for (std::string_view str : data) {
+    EVP_MAC_update(macCtx.get(), reinterpret_cast<const unsigned char*>(str.data()), str.size());
+  }
+
+  BinArray binData;
+  std::size_t len{};
+
+  if (EVP_MAC_final(macCtx.get(), reinterpret_cast<unsigned char*>(binData.data()), &len, binData.size()) != 1 ||
+      len != binData.size()) {
+    throw exception("Unexpected result from EVP_MAC_final: expected len {}, got {}", binData.size(), len);
+  }
+
+  return binData;
+}
+
+template <ShaType shaType>
+typename HmacSigner<shaType>::HexArray HmacSigner<shaType>::signHex(std::string_view data) const {
+  return BinToLowerHex(sign(data));
+}
+
+template class HmacSigner<ShaType::kSha256>;
+template class HmacSigner<ShaType::kSha512>;
+
 }  // namespace cct::ssl
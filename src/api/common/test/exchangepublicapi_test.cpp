@@ -6,6 +6,7 @@
 #include <optional>
 
 #include "cct_string.hpp"
+#include "cct_vector.hpp"
 #include "coincenterinfo.hpp"
 #include "commonapi.hpp"
 #include "currencycode.hpp"
@@ -94,6 +95,24 @@ TEST_F(ExchangePublicTest, FindConversionPath) {
             }));
 }
 
+TEST_F(ExchangePublicTest, FindConversionPaths) {
+  EXPECT_CALL(exchangePublic, queryTradableMarkets()).WillOnce(::testing::Return(markets));
+
+  const CurrencyCode fromCurrencies[] = {"BTC", "KRW", "SHIB", "GBP", "EUR"};
+  MarketSet queriedMarkets;
+  EXPECT_EQ(exchangePublic.findMarketsPaths(fromCurrencies, "EUR", queriedMarkets, exchangePublic.queryFiats(),
+                                            ExchangePublic::MarketPathMode::kWithPossibleFiatConversionAtExtremity),
+            vector<MarketsPath>({
+                MarketsPath({Market{"BTC", "EUR"}}),
+                MarketsPath({Market{"BTC", "KRW"}, Market{"BTC", "EUR"}}),
+                MarketsPath({Market{"SHIB", "ICP"}, Market{"AVAX", "ICP"}, Market{"AVAX", "USDT"},
+                             Market{"USDT", "EUR", Market::Type::kFiatConversionMarket}}),
+                MarketsPath({Market{"GBP", "EUR", Market::Type::kFiatConversionMarket}}),
+                MarketsPath(),
+            }));
+  EXPECT_EQ(queriedMarkets, markets);
+}
+
 TEST_F(ExchangePublicTest, FindCurrenciesPath) {
   EXPECT_CALL(exchangePublic, queryTradableMarkets()).WillRepeatedly(::testing::Return(markets));
 
@@ -178,6 +197,21 @@ class ExchangePublicConvertTest : public ExchangePublicTest {
   PriceOptions priceOptions;
 };
 
+TEST_F(ExchangePublicConvertTest, GetOrderBooksQueriesEachMarketByDefault) {
+  const Market orderBookMarkets[] = {Market("XRP", "BTC"), Market("XLM", "BTC")};
+
+  EXPECT_CALL(exchangePublic, queryOrderBook(orderBookMarkets[0], depth))
+      .WillOnce(::testing::Return(marketOrderBook2));
+  EXPECT_CALL(exchangePublic, queryOrderBook(orderBookMarkets[1], depth))
+      .WillOnce(::testing::Return(marketOrderBook1));
+
+  const auto marketOrderBooks = exchangePublic.getOrderBooks(orderBookMarkets, depth);
+
+  ASSERT_EQ(marketOrderBooks.size(), 2U);
+  EXPECT_EQ(marketOrderBooks[0], marketOrderBook2);
+  EXPECT_EQ(marketOrderBooks[1], marketOrderBook1);
+}
+
 TEST_F(ExchangePublicConvertTest, ConvertImpossible) {
   MonetaryAmount from{50000, "XLM"};
   CurrencyCode toCurrency{"BTC"};
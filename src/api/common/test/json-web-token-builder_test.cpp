@@ -0,0 +1,42 @@
+#include "json-web-token-builder.hpp"
+
+#include <gtest/gtest.h>
+
+namespace cct::ssl {
+
+class JsonWebTokenBuilderTest : public ::testing::Test {
+ protected:
+  static constexpr JsonWebTokenHs256Builder::Claim kFixedClaims[] = {{"access_key", "myAccessKey"}};
+  static constexpr JsonWebTokenHs256Builder::Claim kClaims[] = {
+      {"nonce", "1700000000000"}, {"query_hash", "abc"}, {"query_hash_alg", "SHA512"}};
+};
+
+TEST_F(JsonWebTokenBuilderTest, Hs256) {
+  const JsonWebTokenHs256Builder builder("mySecretKey", kFixedClaims);
+
+  EXPECT_EQ(builder.build(kClaims),
+            "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+            "eyJhY2Nlc3Nfa2V5IjoibXlBY2Nlc3NLZXkiLCJub25jZSI6IjE3MDAwMDAwMDAwMDAiLCJxdWVyeV9oYXNoIjoiYWJjIiwicXVlcnlf"
+            "aGFzaF9hbGciOiJTSEE1MTIifQ.T5zSoZpmD4vN-36tgSgXI8fUwINr3cv-PWY-gy53Z00");
+}
+
+TEST_F(JsonWebTokenBuilderTest, Hs512) {
+  const JsonWebTokenHs512Builder builder("mySecretKey", kFixedClaims);
+
+  EXPECT_EQ(builder.build(kClaims),
+            "eyJhbGciOiJIUzUxMiIsInR5cCI6IkpXVCJ9."
+            "eyJhY2Nlc3Nfa2V5IjoibXlBY2Nlc3NLZXkiLCJub25jZSI6IjE3MDAwMDAwMDAwMDAiLCJxdWVyeV9oYXNoIjoiYWJjIiwicXVlcnlf"
+            "aGFzaF9hbGciOiJTSEE1MTIifQ.5k92G213jdWaUkOulDbN8wD1AMI7SBdYWgwMhpgp1_mkXgr7Z0B6GH1Pv5TFqFjLcrromZX_"
+            "SIQundLWICAflQ");
+}
+
+TEST_F(JsonWebTokenBuilderTest, NoClaims) {
+  const JsonWebTokenHs256Builder builder("mySecretKey", {});
+
+  const auto token = builder.build({});
+
+  // '{}' payload
+  EXPECT_TRUE(token.starts_with("eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9.e30."));
+}
+
+}  // namespace cct::ssl
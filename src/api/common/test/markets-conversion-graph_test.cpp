@@ -0,0 +1,107 @@
+#include "markets-conversion-graph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <utility>
+
+#include "cct_vector.hpp"
+#include "currencycode.hpp"
+#include "currencycodeset.hpp"
+#include "exchangepublicapitypes.hpp"
+#include "market.hpp"
+
+namespace cct::api {
+
+class MarketsConversionGraphTest : public ::testing::Test {
+ protected:
+  MarketSet markets{{"BTC", "EUR"}, {"XLM", "EUR"},  {"ETH", "EUR"},  {"ETH", "BTC"},  {"BTC", "KRW"},
+                    {"USD", "EOS"}, {"SHIB", "ICP"}, {"AVAX", "ICP"}, {"AVAX", "USDT"}};
+  CurrencyCodeSet fiats{"EUR", "GBP", "KRW", "USD"};
+  MarketsConversionGraph graph{markets, fiats, [this](CurrencyCode cur) {
+                                 return fiats.contains(cur) || cur == CurrencyCode("USDT");
+                               }};
+};
+
+TEST_F(MarketsConversionGraphTest, Build) {
+  EXPECT_EQ(graph.nbCurrencies(), 11);
+  EXPECT_TRUE(graph.isBuiltFrom(markets, fiats));
+  EXPECT_FALSE(graph.isBuiltFrom(MarketSet{{"BTC", "EUR"}}, fiats));
+  EXPECT_FALSE(graph.isBuiltFrom(markets, CurrencyCodeSet{"EUR"}));
+}
+
+TEST_F(MarketsConversionGraphTest, FindMarketsPath) {
+  EXPECT_EQ(graph.findMarketsPath("BTC", "XLM"), MarketsPath({Market{"BTC", "EUR"}, Market{"XLM", "EUR"}}));
+  EXPECT_EQ(graph.findMarketsPath("XLM", "ETH"), MarketsPath({Market{"XLM", "EUR"}, Market{"ETH", "EUR"}}));
+  EXPECT_EQ(graph.findMarketsPath("ETH", "KRW"), MarketsPath({Market{"ETH", "BTC"}, Market{"BTC", "KRW"}}));
+  EXPECT_EQ(graph.findMarketsPath("EUR", "BTC"), MarketsPath({Market{"BTC", "EUR"}}));
+  EXPECT_EQ(graph.findMarketsPath("SHIB", "USDT"),
+            MarketsPath({Market{"SHIB", "ICP"}, Market{"AVAX", "ICP"}, Market{"AVAX", "USDT"}}));
+  EXPECT_EQ(graph.findMarketsPath("SHIB", "KRW"), MarketsPath());
+  EXPECT_EQ(graph.findMarketsPath("EUR", "GBP"), MarketsPath());
+  EXPECT_EQ(graph.findMarketsPath("BTC", "BTC"), MarketsPath());
+
+  // Memoized paths should be the same
+  EXPECT_EQ(graph.findMarketsPath("BTC", "XLM"), MarketsPath({Market{"BTC", "EUR"}, Market{"XLM", "EUR"}}));
+}
+
+TEST_F(MarketsConversionGraphTest, FavorNonFiatAndLexicographicalPaths) {
+  // ETH -> XRP can go through BTC, EUR or USDT. Non fiat currencies are preferred, and then lexicographical order.
+  MarketSet marketsWithAlternatives{{"ETH", "BTC"}, {"XRP", "BTC"},  {"ETH", "EUR"},
+                                    {"XRP", "EUR"}, {"ETH", "USDT"}, {"XRP", "USDT"}};
+  MarketsConversionGraph graphWithAlternatives(marketsWithAlternatives, fiats, [](CurrencyCode) { return false; });
+
+  EXPECT_EQ(graphWithAlternatives.findMarketsPath("ETH", "XRP"),
+            MarketsPath({Market{"ETH", "BTC"}, Market{"XRP", "BTC"}}));
+  EXPECT_EQ(graphWithAlternatives.findMarketsPath("EUR", "USDT"),
+            MarketsPath({Market{"ETH", "EUR"}, Market{"ETH", "USDT"}}));
+}
+
+TEST_F(MarketsConversionGraphTest, FindMarketsPathWithFiatConversionAtExtremity) {
+  EXPECT_EQ(graph.findMarketsPathWithFiatConversionAtExtremity("SHIB", false, "KRW", true),
+            MarketsPath({Market{"SHIB", "ICP"}, Market{"AVAX", "ICP"}, Market{"AVAX", "USDT"},
+                         Market{"USDT", "KRW", Market::Type::kFiatConversionMarket}}));
+  EXPECT_EQ(graph.findMarketsPathWithFiatConversionAtExtremity("GBP", true, "EOS", false),
+            MarketsPath({Market{"GBP", "USD", Market::Type::kFiatConversionMarket}, Market{"USD", "EOS"}}));
+  EXPECT_EQ(graph.findMarketsPathWithFiatConversionAtExtremity("EUR", true, "GBP", true),
+            MarketsPath({Market{"EUR", "GBP", Market::Type::kFiatConversionMarket}}));
+  EXPECT_EQ(graph.findMarketsPathWithFiatConversionAtExtremity("BTC", false, "XLM", false),
+            MarketsPath({Market{"BTC", "EUR"}, Market{"XLM", "EUR"}}));
+  EXPECT_EQ(graph.findMarketsPathWithFiatConversionAtExtremity("SHIB", false, "BTC", false), MarketsPath());
+}
+
+TEST_F(MarketsConversionGraphTest, FindMarketsPathsTo) {
+  const CurrencyCode fromCurrencies[] = {"XLM", "KRW", "EUR", "SHIB", "GBP", "ETH"};
+  EXPECT_EQ(graph.findMarketsPathsTo(fromCurrencies, "EUR"),
+            vector<MarketsPath>({
+                MarketsPath({Market{"XLM", "EUR"}}),
+                MarketsPath({Market{"BTC", "KRW"}, Market{"BTC", "EUR"}}),
+                MarketsPath(),
+                MarketsPath(),
+                MarketsPath(),
+                MarketsPath({Market{"ETH", "EUR"}}),
+            }));
+  EXPECT_EQ(graph.findMarketsPathsTo(fromCurrencies, "GBP"), vector<MarketsPath>(std::size(fromCurrencies)));
+
+  // Same paths as the ones computed one by one from each source currency, except for the ordering of the equivalent
+  // paths
+  for (CurrencyCode fromCurrency : fromCurrencies) {
+    const CurrencyCode oneFromCurrency[] = {fromCurrency};
+    EXPECT_EQ(graph.findMarketsPathsTo(oneFromCurrency, "BTC").front(), graph.findMarketsPath(fromCurrency, "BTC"));
+  }
+}
+
+TEST_F(MarketsConversionGraphTest, FindAllMarketsPaths) {
+  using CurrencyMarketsPath = std::pair<CurrencyCode, MarketsPath>;
+
+  EXPECT_EQ(graph.findAllMarketsPaths("SHIB"),
+            vector<CurrencyMarketsPath>({
+                CurrencyMarketsPath{"AVAX", MarketsPath({Market{"SHIB", "ICP"}, Market{"AVAX", "ICP"}})},
+                CurrencyMarketsPath{"ICP", MarketsPath({Market{"SHIB", "ICP"}})},
+                CurrencyMarketsPath{"USDT", MarketsPath({Market{"SHIB", "ICP"}, Market{"AVAX", "ICP"},
+                                                         Market{"AVAX", "USDT"}})},
+            }));
+  EXPECT_TRUE(graph.findAllMarketsPaths("GBP").empty());
+}
+
+}  // namespace cct::api
@@ -0,0 +1,116 @@
+#include "metadata-cache-file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#include <utility>
+
+#include "cachedresult.hpp"
+#include "cachedresultvault.hpp"
+#include "cct_exception.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "currencycode.hpp"
+#include "currencyexchange.hpp"
+#include "currencyexchangeflatset.hpp"
+#include "exchange-name-enum.hpp"
+#include "market.hpp"
+#include "metadata-cache-archive.hpp"
+#include "monetaryamount.hpp"
+#include "timedef.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct::api {
+
+namespace {
+struct MarketInfo {
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(volAndPriNbDecimals, minVolume, permissions);
+  }
+
+  bool operator==(const MarketInfo &) const = default;
+
+  VolAndPriNbDecimals volAndPriNbDecimals;
+  MonetaryAmount minVolume;
+  vector<string> permissions;
+};
+
+using MarketInfoMap = std::unordered_map<Market, MarketInfo>;
+
+struct MarketsFunc {
+  std::pair<MarketSet, MarketInfoMap> operator()() {
+    ++nbCalls;
+    MarketInfoMap marketInfoMap;
+    marketInfoMap[Market("BTC", "EUR")] = MarketInfo{{8, 2}, MonetaryAmount("0.0001", "BTC"), {"SPOT"}};
+    marketInfoMap[Market("ETH", "BTC")] = MarketInfo{{4, 6}, MonetaryAmount("0.01", "ETH"), {"SPOT", "MARGIN"}};
+    return {MarketSet{Market("BTC", "EUR"), Market("ETH", "BTC")}, std::move(marketInfoMap)};
+  }
+
+  int nbCalls{};
+};
+}  // namespace
+
+class MetadataCacheFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::filesystem::create_directories(dataDir / "cache"); }
+
+  void TearDown() override { std::filesystem::remove_all(dataDir); }
+
+  std::filesystem::path dataDir = std::filesystem::temp_directory_path() / "coincenter-metadata-cache-test";
+  string dataDirStr{dataDir.string()};
+  CachedResultVault cachedResultVault;
+};
+
+TEST_F(MetadataCacheFileTest, ArchiveRoundTrip) {
+  CurrencyExchangeVector currencyExchangeVector;
+  currencyExchangeVector.emplace_back("BTC", "XBT", "XXBT", CurrencyExchange::Deposit::kAvailable,
+                                      CurrencyExchange::Withdraw::kUnavailable, CurrencyExchange::Type::kCrypto);
+  currencyExchangeVector.emplace_back("EUR", "EUR", "ZEUR", CurrencyExchange::Deposit::kUnavailable,
+                                      CurrencyExchange::Withdraw::kAvailable, CurrencyExchange::Type::kFiat);
+  const CurrencyExchangeFlatSet currencies(std::move(currencyExchangeVector));
+  const auto markets = MarketsFunc{}();
+
+  MetadataCacheWriter writer;
+  writer(currencies, markets, MonetaryAmount("-3.1416", "USDT"));
+
+  MetadataCacheReader reader(writer.data());
+  EXPECT_TRUE(std::ranges::equal(reader.read<CurrencyExchangeFlatSet>(), currencies));
+  EXPECT_EQ((reader.read<std::pair<MarketSet, MarketInfoMap>>()), markets);
+  EXPECT_EQ(reader.read<MonetaryAmount>(), MonetaryAmount("-3.1416", "USDT"));
+  EXPECT_TRUE(reader.empty());
+
+  EXPECT_THROW(reader.read<int>(), exception);
+}
+
+TEST_F(MetadataCacheFileTest, FileRoundTrip) {
+  CachedResult<MarketsFunc> marketsCache(CachedResultOptions(std::chrono::hours(1), cachedResultVault));
+
+  const auto markets = marketsCache.get();
+  const auto lastUpdatedTime = marketsCache.retrieve().second;
+
+  {
+    MetadataCacheFile metadataCacheFile(dataDirStr, ExchangeNameEnum::kraken);
+    metadataCacheFile.store("markets", marketsCache);
+    metadataCacheFile.write();
+  }
+
+  CachedResult<MarketsFunc> newMarketsCache(CachedResultOptions(std::chrono::hours(1), cachedResultVault));
+
+  const MetadataCacheFile metadataCacheFile(dataDirStr, ExchangeNameEnum::kraken);
+  metadataCacheFile.load("markets", newMarketsCache);
+  metadataCacheFile.load("unknown", newMarketsCache);
+
+  EXPECT_EQ(newMarketsCache.retrieve().second, lastUpdatedTime);
+  EXPECT_EQ(newMarketsCache.get(), markets);
+
+  // Other exchanges have their own file
+  CachedResult<MarketsFunc> otherMarketsCache(CachedResultOptions(std::chrono::hours(1), cachedResultVault));
+  MetadataCacheFile(dataDirStr, ExchangeNameEnum::binance).load("markets", otherMarketsCache);
+  EXPECT_EQ(otherMarketsCache.retrieve().first, nullptr);
+}
+
+}  // namespace cct::api
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <string_view>
 
 namespace cct::ssl {
 TEST(SSLTest, Version) { EXPECT_NE(GetOpenSSLVersion(), ""); }
@@ -101,4 +102,24 @@ TEST(SSLTest, ShaDigest512Multiple) {
       51,  102, 57,  54,  98,  53,  50,  51, 52, 99, 98,  48, 51, 56,  100, 53,  55, 56};
   EXPECT_TRUE(std::ranges::equal(actual, kExpectedData));
 }
+
+TEST(SSLTest, HmacSigner) {
+  const HmacSha256Signer signer256("secret1234");
+  const HmacSha512Signer signer512("secret1234");
+
+  // Signer can be reused, and should give the same results as the one shot functions
+  for (int signPos = 0; signPos < 2; ++signPos) {
+    EXPECT_EQ(signer256.sign("data1234"), Sha256Bin("data1234", "secret1234"));
+    EXPECT_EQ(signer512.sign("data1234"), Sha512Bin("data1234", "secret1234"));
+    EXPECT_EQ(signer256.signHex("data1234"), Sha256Hex("data1234", "secret1234"));
+    EXPECT_EQ(signer512.signHex("data1234"), Sha512Hex("data1234", "secret1234"));
+  }
+
+  static constexpr std::string_view kSplitData[] = {"data", "", "1234"};
+
+  EXPECT_EQ(signer256.sign(kSplitData), Sha256Bin("data1234", "secret1234"));
+  EXPECT_EQ(signer512.sign(kSplitData), Sha512Bin("data1234", "secret1234"));
+
+  EXPECT_EQ(HmacSha256Signer("").sign("data1234"), Sha256Bin("data1234", ""));
+}
 }  // namespace cct::ssl
\ No newline at end of file
@@ -23,7 +23,7 @@ class WithdrawalFeesCrawlerTest : public ::testing::Test {
 TEST_F(WithdrawalFeesCrawlerTest, WithdrawalFeesCrawlerService) {
   for (int exchangeNamePos = 0; exchangeNamePos < kNbSupportedExchanges; ++exchangeNamePos) {
     const auto [amountByCurrencySet, withdrawalMinMap] =
-        withdrawalFeesCrawler.get(static_cast<ExchangeNameEnum>(exchangeNamePos));
+        *withdrawalFeesCrawler.get(static_cast<ExchangeNameEnum>(exchangeNamePos));
 
     if (!withdrawalMinMap.empty()) {
       return;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "binance-schema.hpp"
+#include "cct_vector.hpp"
+#include "market.hpp"
+#include "monetaryamount.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct::api {
+
+/// Trading filters of a Binance market, compiled once from its exchange information.
+/// Filters are looked up by their type name and their limits are converted to the market currencies only once, so that
+/// order sanitization boils down to a few comparisons and roundings.
+/// Sanitization only depends on this object (and on the price for notional), so it can be done offline as well.
+class BinanceMarketFilters {
+ public:
+  BinanceMarketFilters() noexcept = default;
+
+  BinanceMarketFilters(Market market, const schema::binance::V3ExchangeInfo::Symbol& symbol);
+
+  Market market() const { return _market; }
+
+  VolAndPriNbDecimals volAndPriNbDecimals() const { return _volAndPriNbDecimals; }
+
+  /// Get the closest price to given one accepted by the price filter, truncated to the price precision.
+  MonetaryAmount sanitizePrice(MonetaryAmount pri) const;
+
+  /// If a taker order notional should be computed from the average price instead of the order price, returns the
+  /// number of minutes of the average price (0 meaning last traded price).
+  std::optional<int32_t> takerNotionalAvgPriceMins() const;
+
+  /// Get the closest volume to given one accepted by the lot size and notional filters, truncated to the volume
+  /// precision.
+  MonetaryAmount sanitizeVolume(MonetaryAmount vol, MonetaryAmount priceForNotional, bool isTakerOrder) const;
+
+  template <class Archive>
+  void serialize(Archive& ar) {
+    ar(_market, _minPrice, _maxPrice, _tickSize, _minQty, _maxQty, _stepSize, _marketMinQty, _marketMaxQty,
+       _marketStepSize, _minNotional, _notionalMin, _notionalMax, _minNotionalAvgPriceMins, _notionalAvgPriceMins,
+       _volAndPriNbDecimals, _flags);
+  }
+
+  bool operator==(const BinanceMarketFilters&) const noexcept = default;
+
+ private:
+  enum Flag : uint8_t {
+    kPriceFilter = 1U << 0,
+    kLotSize = 1U << 1,
+    kMarketLotSize = 1U << 2,
+    kMinNotional = 1U << 3,
+    kMinNotionalApplyToMarket = 1U << 4,
+    kNotional = 1U << 5,
+    kNotionalApplyMinToMarket = 1U << 6,
+    kNotionalApplyMaxToMarket = 1U << 7,
+  };
+
+  bool isSet(Flag flag) const { return (_flags & flag) != 0; }
+
+  Market _market;
+  MonetaryAmount _minPrice;
+  MonetaryAmount _maxPrice;
+  MonetaryAmount _tickSize;
+  MonetaryAmount _minQty;
+  MonetaryAmount _maxQty;
+  MonetaryAmount _stepSize;
+  MonetaryAmount _marketMinQty;
+  MonetaryAmount _marketMaxQty;
+  MonetaryAmount _marketStepSize;
+  MonetaryAmount _minNotional;
+  MonetaryAmount _notionalMin;
+  MonetaryAmount _notionalMax;
+  int32_t _minNotionalAvgPriceMins{};
+  int32_t _notionalAvgPriceMins{};
+  VolAndPriNbDecimals _volAndPriNbDecimals;
+  uint8_t _flags{};
+};
+
+/// Flat map of the trading filters of all Binance markets, sorted by market.
+class BinanceMarketFiltersMap {
+ public:
+  BinanceMarketFiltersMap() noexcept = default;
+
+  explicit BinanceMarketFiltersMap(vector<BinanceMarketFilters> marketFilters);
+
+  /// Get the filters of given market, or nullptr if market is unknown.
+  const BinanceMarketFilters* find(Market market) const;
+
+  /// Get the filters of given market, throws an exception if market is unknown.
+  const BinanceMarketFilters& get(Market market) const;
+
+  std::span<const BinanceMarketFilters> marketFilters() const { return _marketFilters; }
+
+  template <class Archive>
+  void serialize(Archive& ar) {
+    ar(_marketFilters);
+  }
+
+  bool operator==(const BinanceMarketFiltersMap&) const noexcept = default;
+
+ private:
+  vector<BinanceMarketFilters> _marketFilters;
+};
+
+}  // namespace cct::api
@@ -16,6 +16,7 @@
 #include "httprequesttype.hpp"
 #include "monetaryamount.hpp"
 #include "ordersconstraints.hpp"
+#include "ssl_sha.hpp"
 #include "timedef.hpp"
 #include "tradeinfo.hpp"
 #include "wallet.hpp"
@@ -89,6 +90,7 @@ class BinancePrivate : public ExchangePrivate {
   struct BinanceContext {
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha256Signer& _signer;
     BinancePublic& _exchangePublic;
     Duration& _queryDelay;
   };
@@ -96,36 +98,39 @@ class BinancePrivate : public ExchangePrivate {
   static_assert(std::is_trivially_destructible_v<BinanceContext>, "BinanceContext destructor should be trivial");
 
   struct TradableCurrenciesCache : public BinanceContext {
-    TradableCurrenciesCache(CurlHandle& curlHandle, const APIKey& apiKey, BinancePublic& exchangePublic,
-                            Duration& queryDelay)
-        : BinanceContext(curlHandle, apiKey, exchangePublic, queryDelay) {}
+    TradableCurrenciesCache(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                            BinancePublic& exchangePublic, Duration& queryDelay)
+        : BinanceContext(curlHandle, apiKey, signer, exchangePublic, queryDelay) {}
 
     CurrencyExchangeFlatSet operator()();
   };
 
   struct DepositWalletFunc : public BinanceContext {
-    DepositWalletFunc(CurlHandle& curlHandle, const APIKey& apiKey, BinancePublic& exchangePublic, Duration& queryDelay)
-        : BinanceContext(curlHandle, apiKey, exchangePublic, queryDelay) {}
+    DepositWalletFunc(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                      BinancePublic& exchangePublic, Duration& queryDelay)
+        : BinanceContext(curlHandle, apiKey, signer, exchangePublic, queryDelay) {}
 
     Wallet operator()(CurrencyCode currencyCode);
   };
 
   struct AllWithdrawFeesFunc : public BinanceContext {
-    AllWithdrawFeesFunc(CurlHandle& curlHandle, const APIKey& apiKey, BinancePublic& exchangePublic,
-                        Duration& queryDelay)
-        : BinanceContext(curlHandle, apiKey, exchangePublic, queryDelay) {}
+    AllWithdrawFeesFunc(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                        BinancePublic& exchangePublic, Duration& queryDelay)
+        : BinanceContext(curlHandle, apiKey, signer, exchangePublic, queryDelay) {}
 
     MonetaryAmountByCurrencySet operator()();
   };
 
   struct WithdrawFeesFunc : public BinanceContext {
-    WithdrawFeesFunc(CurlHandle& curlHandle, const APIKey& apiKey, BinancePublic& exchangePublic, Duration& queryDelay)
-        : BinanceContext(curlHandle, apiKey, exchangePublic, queryDelay) {}
+    WithdrawFeesFunc(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                     BinancePublic& exchangePublic, Duration& queryDelay)
+        : BinanceContext(curlHandle, apiKey, signer, exchangePublic, queryDelay) {}
 
     std::optional<MonetaryAmount> operator()(CurrencyCode currencyCode);
   };
 
   CurlHandle _curlHandle;
+  ssl::HmacSha256Signer _signer;
   CachedResult<TradableCurrenciesCache> _tradableCurrenciesCache;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
   CachedResult<AllWithdrawFeesFunc> _allWithdrawFeesCache;
@@ -1,18 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string_view>
-#include <unordered_map>
 
-#include "binance-schema.hpp"
-#include "cachedresult.hpp"
+#include "binance-market-filters.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "curlhandle.hpp"
+#include "curlpostdata.hpp"
 #include "currencycode.hpp"
 #include "currencyexchange.hpp"
 #include "currencyexchangeflatset.hpp"
 #include "exchange-asset-config.hpp"
 #include "exchangepublicapi.hpp"
 #include "exchangepublicapitypes.hpp"
+#include "httprequesttype.hpp"
+#include "market-order-book-vector.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
 #include "permanentcurloptions.hpp"
@@ -36,15 +40,17 @@ class BinancePublic : public ExchangePublic {
 
   bool healthCheck() override;
 
+  void updateCacheFile() const override;
+
   CurrencyExchangeFlatSet queryTradableCurrencies() override;
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode standardCode) override {
     return queryTradableCurrencies().getOrThrow(standardCode);
   }
 
-  MarketSet queryTradableMarkets() override { return _marketsCache.get(); }
+  MarketSet queryTradableMarkets() override { return *_marketsCache.get(); }
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get(1)); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get(1)); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() override;
 
@@ -53,23 +59,29 @@ class BinancePublic : public ExchangePublic {
   bool isWithdrawalFeesSourceReliable() const override { return true; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks(int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get(depth);
+    return *_allOrderBooksCache.get(depth);
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderbookCache.get(mk, depth);
+    return *_orderbookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tradedVolumeCache.get(mk); }
+  MarketOrderBookVector queryOrderBooks(std::span<const Market> markets, int depth = kDefaultDepth) override;
+
+  MonetaryAmount queryLast24hVolume(Market mk) override { return *_tradedVolumeCache.get(mk); }
 
   PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) override;
 
-  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk); }
+  MonetaryAmount queryLastPrice(Market mk) override { return *_tickerCache.get(mk); }
 
   MonetaryAmount sanitizePrice(Market mk, MonetaryAmount pri);
 
   MonetaryAmount sanitizeVolume(Market mk, MonetaryAmount vol, MonetaryAmount priceForNotional, bool isTakerOrder);
 
+  /// Get the weight of given request, as accounted by Binance in its request weight limit.
+  static int32_t RequestWeight(HttpRequestType requestType, std::string_view endpoint,
+                               const CurlPostData& curlPostData);
+
  private:
   friend class BinancePrivate;
 
@@ -81,9 +93,7 @@ class BinancePublic : public ExchangePublic {
   };
 
   struct ExchangeInfoFunc {
-    using ExchangeInfoDataByMarket = std::unordered_map<Market, schema::binance::V3ExchangeInfo::Symbol>;
-
-    ExchangeInfoDataByMarket operator()();
+    BinanceMarketFiltersMap operator()();
 
     CommonInfo& _commonInfo;
   };
@@ -91,7 +101,7 @@ class BinancePublic : public ExchangePublic {
   struct MarketsFunc {
     MarketSet operator()();
 
-    CachedResult<ExchangeInfoFunc>& _exchangeConfigCache;
+    ConcurrentCachedResult<ExchangeInfoFunc>& _exchangeConfigCache;
     CurlHandle& _curlHandle;
     const schema::ExchangeAssetConfig& _assetConfig;
   };
@@ -99,8 +109,8 @@ class BinancePublic : public ExchangePublic {
   struct AllOrderBooksFunc {
     MarketOrderBookMap operator()(int depth);
 
-    CachedResult<ExchangeInfoFunc>& _exchangeConfigCache;
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<ExchangeInfoFunc>& _exchangeConfigCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
     CommonInfo& _commonInfo;
   };
 
@@ -124,12 +134,12 @@ class BinancePublic : public ExchangePublic {
 
   CurlHandle _curlHandle;
   CommonInfo _commonInfo;
-  CachedResult<ExchangeInfoFunc> _exchangeConfigCache;
-  CachedResult<MarketsFunc> _marketsCache;
-  CachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderbookCache;
-  CachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
-  CachedResult<TickerFunc, Market> _tickerCache;
+  ConcurrentCachedResult<ExchangeInfoFunc> _exchangeConfigCache;
+  ConcurrentCachedResult<MarketsFunc> _marketsCache;
+  ConcurrentCachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderbookCache;
+  ConcurrentCachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
+  ConcurrentCachedResult<TickerFunc, Market> _tickerCache;
 };
 
 }  // namespace api
@@ -6,6 +6,7 @@
 #include "curlhandle.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangeprivateapitypes.hpp"
+#include "ssl_sha.hpp"
 #include "timepoint-schema.hpp"
 #include "tradeinfo.hpp"
 
@@ -63,6 +64,7 @@ class BithumbPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha512Signer& _signer;
     BithumbPublic& _exchangePublic;
   };
 
@@ -87,6 +89,7 @@ class BithumbPrivate : public ExchangePrivate {
   using CurrencyOrderInfoMap = std::unordered_map<CurrencyCode, CurrencyOrderInfo>;
 
   CurlHandle _curlHandle;
+  ssl::HmacSha512Signer _signer;
   CurrencyOrderInfoMap _currencyOrderInfoMap;
   Duration _currencyOrderInfoRefreshTime;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
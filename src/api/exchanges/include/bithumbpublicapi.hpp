@@ -3,7 +3,7 @@
 #include <optional>
 #include <string_view>
 
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "curlhandle.hpp"
 #include "currencyexchange.hpp"
 #include "exchange-asset-config.hpp"
@@ -33,15 +33,17 @@ class BithumbPublic : public ExchangePublic {
 
   bool healthCheck() override;
 
-  CurrencyExchangeFlatSet queryTradableCurrencies() override { return _tradableCurrenciesCache.get(); }
+  void updateCacheFile() const override;
+
+  CurrencyExchangeFlatSet queryTradableCurrencies() override { return *_tradableCurrenciesCache.get(); }
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode currencyCode) override {
-    return _tradableCurrenciesCache.get().getOrThrow(currencyCode);
+    return _tradableCurrenciesCache.get()->getOrThrow(currencyCode);
   }
 
   MarketSet queryTradableMarkets() override;
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get()); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get()); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() override {
     return _commonApi.tryQueryWithdrawalFees(exchangeNameEnum());
@@ -52,14 +54,14 @@ class BithumbPublic : public ExchangePublic {
   bool isWithdrawalFeesSourceReliable() const override { return false; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks([[maybe_unused]] int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get();
+    return *_allOrderBooksCache.get();
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderbookCache.get(mk, depth);
+    return *_orderbookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tradedVolumeCache.get(mk); }
+  MonetaryAmount queryLast24hVolume(Market mk) override { return *_tradedVolumeCache.get(mk); }
 
   PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) override;
 
@@ -101,10 +103,10 @@ class BithumbPublic : public ExchangePublic {
   };
 
   CurlHandle _curlHandle;
-  CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
-  CachedResult<AllOrderBooksFunc> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderbookCache;
-  CachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
+  ConcurrentCachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
+  ConcurrentCachedResult<AllOrderBooksFunc> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderbookCache;
+  ConcurrentCachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
 };
 
 }  // namespace api
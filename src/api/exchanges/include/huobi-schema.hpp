@@ -69,6 +69,23 @@ struct V2ReferenceCurrency {
   vector<V2ReferenceCurrencyDetails> data;
 };
 
+/// Reference currencies are persisted in the metadata cache file
+template <class Archive>
+void serialize(Archive& ar, V2ReferenceCurrencyDetails::Chain& chain) {
+  ar(chain.chain, chain.displayName, chain.depositStatus, chain.withdrawStatus, chain.withdrawFeeType,
+     chain.transactFeeWithdraw, chain.minWithdrawAmt, chain.maxWithdrawAmt, chain.withdrawPrecision);
+}
+
+template <class Archive>
+void serialize(Archive& ar, V2ReferenceCurrencyDetails& currencyDetails) {
+  ar(currencyDetails.currency, currencyDetails.instStatus, currencyDetails.chains);
+}
+
+template <class Archive>
+void serialize(Archive& ar, V2ReferenceCurrency& referenceCurrency) {
+  ar(referenceCurrency.code, referenceCurrency.data);
+}
+
 // https://huobiapi.github.io/docs/spot/v1/en/#get-all-supported-trading-symbol-v2
 
 struct V1SettingsCommonMarketSymbol {
@@ -6,6 +6,7 @@
 #include "curlhandle.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangeprivateapitypes.hpp"
+#include "ssl_sha.hpp"
 #include "tradeinfo.hpp"
 
 namespace cct {
@@ -63,6 +64,7 @@ class HuobiPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha256Signer& _signer;
   };
 
   struct DepositWalletFunc {
@@ -70,10 +72,12 @@ class HuobiPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha256Signer& _signer;
     const HuobiPublic& _huobiPublic;
   };
 
   CurlHandle _curlHandle;
+  ssl::HmacSha256Signer _signer;
   CachedResult<AccountIdFunc> _accountIdCache;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
 };
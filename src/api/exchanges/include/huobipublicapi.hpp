@@ -5,7 +5,7 @@
 #include <string_view>
 #include <unordered_map>
 
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "curlhandle.hpp"
 #include "currencycode.hpp"
 #include "exchange-asset-config.hpp"
@@ -33,15 +33,17 @@ class HuobiPublic : public ExchangePublic {
 
   bool healthCheck() override;
 
+  void updateCacheFile() const override;
+
   CurrencyExchangeFlatSet queryTradableCurrencies() override;
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode standardCode) override {
     return queryTradableCurrencies().getOrThrow(standardCode);
   }
 
-  MarketSet queryTradableMarkets() override { return _marketsCache.get().first; }
+  MarketSet queryTradableMarkets() override { return _marketsCache.get()->first; }
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get(1)); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get(1)); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() override;
 
@@ -50,18 +52,18 @@ class HuobiPublic : public ExchangePublic {
   bool isWithdrawalFeesSourceReliable() const override { return true; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks(int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get(depth);
+    return *_allOrderBooksCache.get(depth);
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderbookCache.get(mk, depth);
+    return *_orderbookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tradedVolumeCache.get(mk); }
+  MonetaryAmount queryLast24hVolume(Market mk) override { return *_tradedVolumeCache.get(mk); }
 
   PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) override;
 
-  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk); }
+  MonetaryAmount queryLastPrice(Market mk) override { return *_tickerCache.get(mk); }
 
   VolAndPriNbDecimals queryVolAndPriNbDecimals(Market mk);
 
@@ -81,6 +83,12 @@ class HuobiPublic : public ExchangePublic {
 
   struct MarketsFunc {
     struct MarketInfo {
+      template <class Archive>
+      void serialize(Archive& ar) {
+        ar(volAndPriNbDecimals, minOrderValue, maxOrderValueUSDT, limitMinOrderAmount, limitMaxOrderAmount,
+           sellMarketMinOrderAmount, sellMarketMaxOrderAmount, buyMarketMaxOrderValue);
+      }
+
       VolAndPriNbDecimals volAndPriNbDecimals;
 
       MonetaryAmount minOrderValue;
@@ -106,7 +114,7 @@ class HuobiPublic : public ExchangePublic {
   struct AllOrderBooksFunc {
     MarketOrderBookMap operator()(int depth);
 
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
     CurlHandle& _curlHandle;
   };
 
@@ -138,12 +146,12 @@ class HuobiPublic : public ExchangePublic {
 
   CurlHandle _curlHandle;
   CurlHandle _healthCheckCurlHandle;
-  CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
-  CachedResult<MarketsFunc> _marketsCache;
-  CachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderbookCache;
-  CachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
-  CachedResult<TickerFunc, Market> _tickerCache;
+  ConcurrentCachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
+  ConcurrentCachedResult<MarketsFunc> _marketsCache;
+  ConcurrentCachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderbookCache;
+  ConcurrentCachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
+  ConcurrentCachedResult<TickerFunc, Market> _tickerCache;
 };
 
 }  // namespace api
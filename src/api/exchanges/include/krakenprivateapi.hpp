@@ -6,6 +6,7 @@
 #include "exchangeprivateapi.hpp"
 #include "exchangeprivateapitypes.hpp"
 #include "kraken-schema.hpp"
+#include "ssl_sha.hpp"
 #include "tradeinfo.hpp"
 
 namespace cct {
@@ -61,6 +62,7 @@ class KrakenPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha512Signer& _signer;
     KrakenPublic& _exchangePublic;
   };
 
@@ -71,6 +73,7 @@ class KrakenPrivate : public ExchangePrivate {
   void cancelOrderProcess(OrderIdView orderId);
 
   CurlHandle _curlHandle;
+  ssl::HmacSha512Signer _signer;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
 };
 }  // namespace api
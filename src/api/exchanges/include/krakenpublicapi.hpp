@@ -1,12 +1,14 @@
 #pragma once
 
 #include <optional>
+#include <span>
 
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "curlhandle.hpp"
 #include "exchange-asset-config.hpp"
 #include "exchangepublicapi.hpp"
 #include "exchangepublicapitypes.hpp"
+#include "market-order-book-vector.hpp"
 #include "static_string_view_helpers.hpp"
 #include "volumeandpricenbdecimals.hpp"
 
@@ -23,17 +25,19 @@ class KrakenPublic : public ExchangePublic {
 
   bool healthCheck() override;
 
-  CurrencyExchangeFlatSet queryTradableCurrencies() override { return _tradableCurrenciesCache.get(); }
+  void updateCacheFile() const override;
+
+  CurrencyExchangeFlatSet queryTradableCurrencies() override { return *_tradableCurrenciesCache.get(); }
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode currencyCode) override {
-    return _tradableCurrenciesCache.get().getOrThrow(currencyCode);
+    return _tradableCurrenciesCache.get()->getOrThrow(currencyCode);
   }
 
-  MarketSet queryTradableMarkets() override { return _marketsCache.get().first; }
+  MarketSet queryTradableMarkets() override { return _marketsCache.get()->first; }
 
-  MonetaryAmount queryVolumeOrderMin(Market mk) { return _marketsCache.get().second.find(mk)->second.minVolumeOrder; }
+  MonetaryAmount queryVolumeOrderMin(Market mk) { return _marketsCache.get()->second.find(mk)->second.minVolumeOrder; }
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get(1)); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get(1)); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() override {
     return _commonApi.tryQueryWithdrawalFees(exchangeNameEnum());
@@ -44,18 +48,20 @@ class KrakenPublic : public ExchangePublic {
   bool isWithdrawalFeesSourceReliable() const override { return false; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks(int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get(depth);
+    return *_allOrderBooksCache.get(depth);
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderBookCache.get(mk, depth);
+    return *_orderBookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tickerCache.get(mk).first; }
+  MarketOrderBookVector queryOrderBooks(std::span<const Market> markets, int depth = kDefaultDepth) override;
+
+  MonetaryAmount queryLast24hVolume(Market mk) override { return _tickerCache.get(mk)->first; }
 
   PublicTradeVector queryLastTrades(Market mk, int nbLastTrades = kNbLastTradesDefault) override;
 
-  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk).second; }
+  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk)->second; }
 
   static constexpr std::string_view kUrlPrefix = "https://api.kraken.com";
   static constexpr std::string_view kVersion = "/0";
@@ -75,6 +81,11 @@ class KrakenPublic : public ExchangePublic {
 
   struct MarketsFunc {
     struct MarketInfo {
+      template <class Archive>
+      void serialize(Archive& ar) {
+        ar(volAndPriNbDecimals, minVolumeOrder);
+      }
+
       VolAndPriNbDecimals volAndPriNbDecimals;
       MonetaryAmount minVolumeOrder;
     };
@@ -83,7 +94,7 @@ class KrakenPublic : public ExchangePublic {
 
     std::pair<MarketSet, MarketInfoMap> operator()();
 
-    CachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
+    ConcurrentCachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
     const CoincenterInfo& _coincenterInfo;
     CurlHandle& _curlHandle;
     const schema::ExchangeAssetConfig& _assetConfig;
@@ -92,8 +103,8 @@ class KrakenPublic : public ExchangePublic {
   struct AllOrderBooksFunc {
     MarketOrderBookMap operator()(int depth);
 
-    CachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
     const CoincenterInfo& _coincenterInfo;
     CurlHandle& _curlHandle;
   };
@@ -101,8 +112,8 @@ class KrakenPublic : public ExchangePublic {
   struct OrderBookFunc {
     MarketOrderBook operator()(Market mk, int count);
 
-    CachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
     CurlHandle& _curlHandle;
   };
 
@@ -111,16 +122,16 @@ class KrakenPublic : public ExchangePublic {
 
     Last24hTradedVolumeAndLatestPricePair operator()(Market mk);
 
-    CachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
+    ConcurrentCachedResult<TradableCurrenciesFunc>& _tradableCurrenciesCache;
     CurlHandle& _curlHandle;
   };
 
   CurlHandle _curlHandle;
-  CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
-  CachedResult<MarketsFunc> _marketsCache;
-  CachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderBookCache;
-  CachedResult<TickerFunc, Market> _tickerCache;
+  ConcurrentCachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
+  ConcurrentCachedResult<MarketsFunc> _marketsCache;
+  ConcurrentCachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderBookCache;
+  ConcurrentCachedResult<TickerFunc, Market> _tickerCache;
 };
 }  // namespace api
 }  // namespace cct
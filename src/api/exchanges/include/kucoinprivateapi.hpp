@@ -4,6 +4,7 @@
 #include "curlhandle.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangeprivateapitypes.hpp"
+#include "ssl_sha.hpp"
 #include "tradeinfo.hpp"
 
 namespace cct {
@@ -57,12 +58,14 @@ class KucoinPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::HmacSha256Signer& _signer;
     const KucoinPublic& _kucoinPublic;
   };
 
   void cancelOrderProcess(OrderIdView orderId);
 
   CurlHandle _curlHandle;
+  ssl::HmacSha256Signer _signer;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
 };
 }  // namespace api
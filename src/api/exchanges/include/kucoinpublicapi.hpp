@@ -4,7 +4,7 @@
 #include <string_view>
 #include <unordered_map>
 
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_flatset.hpp"
 #include "curlhandle.hpp"
 #include "curlpostdata.hpp"
@@ -36,15 +36,17 @@ class KucoinPublic : public ExchangePublic {
 
   bool healthCheck() override;
 
+  void updateCacheFile() const override;
+
   CurrencyExchangeFlatSet queryTradableCurrencies() override;
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode standardCode) override {
     return queryTradableCurrencies().getOrThrow(standardCode);
   }
 
-  MarketSet queryTradableMarkets() override { return _marketsCache.get().first; }
+  MarketSet queryTradableMarkets() override { return _marketsCache.get()->first; }
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get(1)); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get(1)); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() override;
 
@@ -53,18 +55,18 @@ class KucoinPublic : public ExchangePublic {
   bool isWithdrawalFeesSourceReliable() const override { return true; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks(int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get(depth);
+    return *_allOrderBooksCache.get(depth);
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderbookCache.get(mk, depth);
+    return *_orderbookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tradedVolumeCache.get(mk); }
+  MonetaryAmount queryLast24hVolume(Market mk) override { return *_tradedVolumeCache.get(mk); }
 
   PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) override;
 
-  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk); }
+  MonetaryAmount queryLastPrice(Market mk) override { return *_tickerCache.get(mk); }
 
   VolAndPriNbDecimals queryVolAndPriNbDecimals(Market mk);
 
@@ -79,6 +81,11 @@ class KucoinPublic : public ExchangePublic {
     struct CurrencyInfo {
       auto operator<=>(const CurrencyInfo& o) const { return currencyExchange <=> o.currencyExchange; }
 
+      template <class Archive>
+      void serialize(Archive& ar) {
+        ar(currencyExchange, withdrawalMinSize, withdrawalMinFee);
+      }
+
       CurrencyExchange currencyExchange;
       MonetaryAmount withdrawalMinSize{};
       MonetaryAmount withdrawalMinFee{};
@@ -95,6 +102,11 @@ class KucoinPublic : public ExchangePublic {
 
   struct MarketsFunc {
     struct MarketInfo {
+      template <class Archive>
+      void serialize(Archive& ar) {
+        ar(baseMinSize, quoteMinSize, baseMaxSize, quoteMaxSize, baseIncrement, priceIncrement, feeCurrency);
+      }
+
       MonetaryAmount baseMinSize;
       MonetaryAmount quoteMinSize;  // quote is synonym of price
       MonetaryAmount baseMaxSize;
@@ -116,7 +128,7 @@ class KucoinPublic : public ExchangePublic {
   struct AllOrderBooksFunc {
     MarketOrderBookMap operator()(int depth);
 
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
     CurlHandle& _curlHandle;
   };
 
@@ -141,12 +153,12 @@ class KucoinPublic : public ExchangePublic {
   static CurlPostData GetSymbolPostData(Market mk) { return CurlPostData{{"symbol", mk.assetsPairStrUpper('-')}}; }
 
   CurlHandle _curlHandle;
-  CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
-  CachedResult<MarketsFunc> _marketsCache;
-  CachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderbookCache;
-  CachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
-  CachedResult<TickerFunc, Market> _tickerCache;
+  ConcurrentCachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
+  ConcurrentCachedResult<MarketsFunc> _marketsCache;
+  ConcurrentCachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderbookCache;
+  ConcurrentCachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
+  ConcurrentCachedResult<TickerFunc, Market> _tickerCache;
 };
 
 }  // namespace api
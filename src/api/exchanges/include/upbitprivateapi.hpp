@@ -12,6 +12,7 @@
 #include "exchange-asset-config.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangeprivateapitypes.hpp"
+#include "json-web-token-builder.hpp"
 #include "monetaryamount.hpp"
 #include "orderid.hpp"
 #include "ordersconstraints.hpp"
@@ -75,7 +76,7 @@ class UpbitPrivate : public ExchangePrivate {
     CurrencyExchangeFlatSet operator()();
 
     CurlHandle& _curlHandle;
-    const APIKey& _apiKey;
+    const ssl::JsonWebTokenHs256Builder& _jwtBuilder;
     const schema::ExchangeAssetConfig& _assetConfig;
     CommonAPI& _commonApi;
   };
@@ -85,6 +86,7 @@ class UpbitPrivate : public ExchangePrivate {
 
     CurlHandle& _curlHandle;
     const APIKey& _apiKey;
+    const ssl::JsonWebTokenHs256Builder& _jwtBuilder;
     UpbitPublic& _exchangePublic;
   };
 
@@ -92,7 +94,7 @@ class UpbitPrivate : public ExchangePrivate {
     std::optional<MonetaryAmount> operator()(CurrencyCode currencyCode);
 
     CurlHandle& _curlHandle;
-    const APIKey& _apiKey;
+    const ssl::JsonWebTokenHs256Builder& _jwtBuilder;
     UpbitPublic& _exchangePublic;
   };
 
@@ -100,6 +102,7 @@ class UpbitPrivate : public ExchangePrivate {
                 MonetaryAmount& volume);
 
   CurlHandle _curlHandle;
+  ssl::JsonWebTokenHs256Builder _jwtBuilder;
   CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
   CachedResult<DepositWalletFunc, CurrencyCode> _depositWalletsCache;
   CachedResult<WithdrawFeesFunc, CurrencyCode> _withdrawalFeesCache;
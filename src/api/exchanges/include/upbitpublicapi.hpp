@@ -1,15 +1,17 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <string_view>
 
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_string.hpp"
 #include "curlhandle.hpp"
 #include "currencycodeset.hpp"
 #include "exchange-asset-config.hpp"
 #include "exchangepublicapi.hpp"
 #include "exchangepublicapitypes.hpp"
+#include "market-order-book-vector.hpp"
 #include "public-trade-vector.hpp"
 
 namespace cct {
@@ -28,35 +30,39 @@ class UpbitPublic : public ExchangePublic {
 
   bool healthCheck() override;
 
-  CurrencyExchangeFlatSet queryTradableCurrencies() override { return _tradableCurrenciesCache.get(); }
+  void updateCacheFile() const override;
+
+  CurrencyExchangeFlatSet queryTradableCurrencies() override { return *_tradableCurrenciesCache.get(); }
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode currencyCode) override {
-    return _tradableCurrenciesCache.get().getOrThrow(currencyCode);
+    return _tradableCurrenciesCache.get()->getOrThrow(currencyCode);
   }
 
-  MarketSet queryTradableMarkets() override { return _marketsCache.get(); }
+  MarketSet queryTradableMarkets() override { return *_marketsCache.get(); }
 
-  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(_allOrderBooksCache.get(1)); }
+  MarketPriceMap queryAllPrices() override { return MarketPriceMapFromMarketOrderBookMap(*_allOrderBooksCache.get(1)); }
 
-  MonetaryAmountByCurrencySet queryWithdrawalFees() override { return _withdrawalFeesCache.get(); }
+  MonetaryAmountByCurrencySet queryWithdrawalFees() override { return *_withdrawalFeesCache.get(); }
 
   std::optional<MonetaryAmount> queryWithdrawalFee(CurrencyCode currencyCode) override;
 
   bool isWithdrawalFeesSourceReliable() const override { return true; }
 
   MarketOrderBookMap queryAllApproximatedOrderBooks(int depth = kDefaultDepth) override {
-    return _allOrderBooksCache.get(depth);
+    return *_allOrderBooksCache.get(depth);
   }
 
   MarketOrderBook queryOrderBook(Market mk, int depth = kDefaultDepth) override {
-    return _orderbookCache.get(mk, depth);
+    return *_orderbookCache.get(mk, depth);
   }
 
-  MonetaryAmount queryLast24hVolume(Market mk) override { return _tradedVolumeCache.get(mk); }
+  MarketOrderBookVector queryOrderBooks(std::span<const Market> markets, int depth = kDefaultDepth) override;
+
+  MonetaryAmount queryLast24hVolume(Market mk) override { return *_tradedVolumeCache.get(mk); }
 
   PublicTradeVector queryLastTrades(Market mk, int nbTrades = kNbLastTradesDefault) override;
 
-  MonetaryAmount queryLastPrice(Market mk) override { return _tickerCache.get(mk); }
+  MonetaryAmount queryLastPrice(Market mk) override { return *_tickerCache.get(mk); }
 
   static constexpr std::string_view kUrlBase = "https://api.upbit.com";
 
@@ -78,7 +84,7 @@ class UpbitPublic : public ExchangePublic {
     CurrencyExchangeFlatSet operator()();
 
     CurlHandle& _curlHandle;
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
   };
 
   struct WithdrawalFeesFunc {
@@ -92,7 +98,7 @@ class UpbitPublic : public ExchangePublic {
     MarketOrderBookMap operator()(int depth);
 
     CurlHandle& _curlHandle;
-    CachedResult<MarketsFunc>& _marketsCache;
+    ConcurrentCachedResult<MarketsFunc>& _marketsCache;
   };
 
   struct OrderBookFunc {
@@ -114,13 +120,13 @@ class UpbitPublic : public ExchangePublic {
   };
 
   CurlHandle _curlHandle;
-  CachedResult<MarketsFunc> _marketsCache;
-  CachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
-  CachedResult<WithdrawalFeesFunc> _withdrawalFeesCache;
-  CachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
-  CachedResult<OrderBookFunc, Market, int> _orderbookCache;
-  CachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
-  CachedResult<TickerFunc, Market> _tickerCache;
+  ConcurrentCachedResult<MarketsFunc> _marketsCache;
+  ConcurrentCachedResult<TradableCurrenciesFunc> _tradableCurrenciesCache;
+  ConcurrentCachedResult<WithdrawalFeesFunc> _withdrawalFeesCache;
+  ConcurrentCachedResult<AllOrderBooksFunc, int> _allOrderBooksCache;
+  ConcurrentCachedResult<OrderBookFunc, Market, int> _orderbookCache;
+  ConcurrentCachedResult<TradedVolumeFunc, Market> _tradedVolumeCache;
+  ConcurrentCachedResult<TickerFunc, Market> _tickerCache;
 };
 
 }  // namespace api
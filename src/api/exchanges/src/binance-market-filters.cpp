@@ -0,0 +1,198 @@
+#include "binance-market-filters.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "binance-schema.hpp"
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_vector.hpp"
+#include "market.hpp"
+#include "monetaryamount.hpp"
+
+namespace cct::api {
+
+BinanceMarketFilters::BinanceMarketFilters(Market market, const schema::binance::V3ExchangeInfo::Symbol& symbol)
+    : _market(market), _volAndPriNbDecimals{symbol.baseAssetPrecision, symbol.quoteAssetPrecision} {
+  bool hasPriceFilter = false;
+  for (const auto& filter : symbol.filters) {
+    const std::string_view filterType = filter.filterType;
+    if (filterType == "PRICE_FILTER") {
+      // Only first price filter is considered
+      if (!hasPriceFilter) {
+        hasPriceFilter = true;
+        _flags |= kPriceFilter;
+        _minPrice = MonetaryAmount(filter.minPrice, market.quote());
+        _maxPrice = MonetaryAmount(filter.maxPrice, market.quote());
+        _tickSize = MonetaryAmount(filter.tickSize, market.quote());
+      }
+    } else if (filterType == "LOT_SIZE") {
+      _flags |= kLotSize;
+      _minQty = MonetaryAmount(filter.minQty, market.base());
+      _maxQty = MonetaryAmount(filter.maxQty, market.base());
+      _stepSize = MonetaryAmount(filter.stepSize, market.base());
+    } else if (filterType == "MARKET_LOT_SIZE") {
+      _flags |= kMarketLotSize;
+      _marketMinQty = MonetaryAmount(filter.minQty, market.base());
+      _marketMaxQty = MonetaryAmount(filter.maxQty, market.base());
+      _marketStepSize = MonetaryAmount(filter.stepSize, market.base());
+    } else if (filterType == "MIN_NOTIONAL") {
+      _flags |= kMinNotional;
+      if (filter.applyToMarket) {
+        _flags |= kMinNotionalApplyToMarket;
+      }
+      _minNotional = filter.minNotional;
+      _minNotionalAvgPriceMins = filter.avgPriceMins;
+    } else if (filterType == "NOTIONAL") {
+      _flags |= kNotional;
+      if (filter.applyMinToMarket) {
+        _flags |= kNotionalApplyMinToMarket;
+      }
+      if (filter.applyMaxToMarket) {
+        _flags |= kNotionalApplyMaxToMarket;
+      }
+      _notionalMin = filter.minNotional;
+      _notionalMax = filter.maxNotional;
+      _notionalAvgPriceMins = filter.avgPriceMins;
+    }
+  }
+}
+
+MonetaryAmount BinanceMarketFilters::sanitizePrice(MonetaryAmount pri) const {
+  MonetaryAmount ret(pri);
+  if (isSet(kPriceFilter)) {
+    if (ret > _maxPrice) {
+      log::debug("Too big price {} capped to {} for {}", ret, _maxPrice, _market);
+      ret = _maxPrice;
+    } else if (ret < _minPrice) {
+      log::debug("Too small price {} increased to {} for {}", ret, _minPrice, _market);
+      ret = _minPrice;
+    } else {
+      ret.round(_tickSize, MonetaryAmount::RoundType::kDown);
+      if (ret != pri) {
+        log::debug("Rounded {} into {} according to {}", pri, ret, _market);
+      }
+    }
+  }
+
+  ret.truncate(_volAndPriNbDecimals.priNbDecimals);
+  if (pri != ret) {
+    log::warn("Sanitize price {} -> {}", pri, ret);
+  }
+  return ret;
+}
+
+std::optional<int32_t> BinanceMarketFilters::takerNotionalAvgPriceMins() const {
+  // When both filters are present, notional filter is the one applied last
+  if (isSet(kNotional) && (isSet(kNotionalApplyMinToMarket) || isSet(kNotionalApplyMaxToMarket))) {
+    return _notionalAvgPriceMins;
+  }
+  if (isSet(kMinNotionalApplyToMarket)) {
+    return _minNotionalAvgPriceMins;
+  }
+  return std::nullopt;
+}
+
+MonetaryAmount BinanceMarketFilters::sanitizeVolume(MonetaryAmount vol, MonetaryAmount priceForNotional,
+                                                    bool isTakerOrder) const {
+  MonetaryAmount ret(vol);
+
+  const bool hasMinNotional = isSet(kMinNotional) && (!isTakerOrder || isSet(kMinNotionalApplyToMarket));
+  const bool hasNotional = isSet(kNotional) && (!isTakerOrder || isSet(kNotionalApplyMinToMarket) ||
+                                                isSet(kNotionalApplyMaxToMarket));
+
+  MonetaryAmount minVolumeAfterMinNotional(0, ret.currencyCode());
+  if (hasMinNotional) {
+    MonetaryAmount priceTimesQuantity = ret.toNeutral() * priceForNotional.toNeutral();
+
+    minVolumeAfterMinNotional = MonetaryAmount(_minNotional / priceForNotional, ret.currencyCode());
+    if (priceTimesQuantity < _minNotional) {
+      log::debug("Too small min price * quantity. {} increased to {} for {}", ret, minVolumeAfterMinNotional,
+                 _market);
+      ret = minVolumeAfterMinNotional;
+    }
+  }
+
+  if (hasNotional) {
+    MonetaryAmount priceTimesQuantity = ret.toNeutral() * priceForNotional.toNeutral();
+
+    if (!isTakerOrder || isSet(kNotionalApplyMinToMarket)) {
+      // min notional applies
+      minVolumeAfterMinNotional =
+          std::max(minVolumeAfterMinNotional, MonetaryAmount(_notionalMin / priceForNotional, ret.currencyCode()));
+
+      if (priceTimesQuantity < _notionalMin) {
+        log::debug("Too small (price * quantity). {} increased to {} for {}", ret, minVolumeAfterMinNotional,
+                   _market);
+        ret = minVolumeAfterMinNotional;
+      }
+    } else {
+      // max notional applies
+      MonetaryAmount maxVolumeAfterMaxNotional = MonetaryAmount(_notionalMax / priceForNotional, ret.currencyCode());
+
+      if (priceTimesQuantity > _notionalMax) {
+        log::debug("Too large (price * quantity). {} decreased to {} for {}", ret, maxVolumeAfterMaxNotional,
+                   _market);
+        ret = maxVolumeAfterMaxNotional;
+      }
+    }
+  }
+
+  const auto applyLotSize = [&](MonetaryAmount minQty, MonetaryAmount maxQty, MonetaryAmount stepSize) {
+    if (ret > maxQty) {
+      log::debug("Too big volume {} capped to {} for {}", ret, maxQty, _market);
+      ret = maxQty;
+    } else if (ret < minQty) {
+      log::debug("Too small volume {} increased to {} for {}", ret, minQty, _market);
+      ret = minQty;
+    } else if (stepSize != 0) {
+      if (ret == minVolumeAfterMinNotional) {
+        ret.round(stepSize, MonetaryAmount::RoundType::kUp);
+        log::debug("{} rounded up to {} because {} min notional applied", minVolumeAfterMinNotional, ret, _market);
+      } else {
+        ret.round(stepSize, MonetaryAmount::RoundType::kDown);
+        log::debug("{} rounded down to {} according to {}", vol, ret, _market);
+      }
+    }
+  };
+
+  if (isTakerOrder && isSet(kMarketLotSize)) {
+    applyLotSize(_marketMinQty, _marketMaxQty, _marketStepSize);
+  }
+  if (isSet(kLotSize)) {
+    applyLotSize(_minQty, _maxQty, _stepSize);
+  }
+
+  ret.truncate(_volAndPriNbDecimals.volNbDecimals);
+  if (ret != vol) {
+    log::warn("Sanitize volume {} -> {}", vol, ret);
+  }
+  return ret;
+}
+
+BinanceMarketFiltersMap::BinanceMarketFiltersMap(vector<BinanceMarketFilters> marketFilters)
+    : _marketFilters(std::move(marketFilters)) {
+  std::ranges::sort(_marketFilters, {}, &BinanceMarketFilters::market);
+}
+
+const BinanceMarketFilters* BinanceMarketFiltersMap::find(Market market) const {
+  const auto it = std::ranges::lower_bound(_marketFilters, market, {}, &BinanceMarketFilters::market);
+  if (it == _marketFilters.end() || it->market() != market) {
+    return nullptr;
+  }
+  return std::addressof(*it);
+}
+
+const BinanceMarketFilters& BinanceMarketFiltersMap::get(Market market) const {
+  const BinanceMarketFilters* pMarketFilters = find(market);
+  if (pMarketFilters == nullptr) {
+    throw exception("Unable to retrieve {} data", market);
+  }
+  return *pMarketFilters;
+}
+
+}  // namespace cct::api
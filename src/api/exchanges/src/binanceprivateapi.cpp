@@ -76,6 +76,10 @@ namespace {
 /// It can happen to retry 10 times
 constexpr int kNbOrderRequestsRetries = 20;
 
+/// Minimum delay before the first retry of a private query, whatever the configured private API rate.
+/// Some errors (order not found yet for instance) come from querying too fast, an immediate retry would not help.
+constexpr Duration kMinRetryDelay = milliseconds(100);
+
 constexpr int kInvalidTimestamp = -1021;
 constexpr int kCancelRejectedStatusCode = -2011;
 constexpr int kNoSuchOrderStatusCode = -2013;
@@ -105,7 +109,7 @@ enum class QueryDelayDir : int8_t {
   kBehind,
 };
 
-void SetNonceAndSignature(const APIKey& apiKey, CurlPostData& postData, Duration queryDelay) {
+void SetNonceAndSignature(const ssl::HmacSha256Signer& signer, CurlPostData& postData, Duration queryDelay) {
   Nonce nonce = Nonce_TimeSinceEpochInMs(queryDelay);
   postData.set("timestamp", nonce);
 
@@ -114,7 +118,7 @@ void SetNonceAndSignature(const APIKey& apiKey, CurlPostData& postData, Duration
   if (postData.back().key() == kSignatureKey) {
     postData.pop_back();
   }
-  auto sha256Hex = ssl::Sha256Hex(postData.str(), apiKey.privateKey());
+  auto sha256Hex = signer.signHex(postData.str());
   postData.emplace_back(kSignatureKey, std::string_view(sha256Hex));
 }
 
@@ -186,12 +190,14 @@ bool CheckErrorDoRetry(int statusCode, const T& ret, QueryDelayDir& queryDelayDi
 }
 
 template <class T, class CurlPostDataT = CurlPostData>
-T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType requestType, std::string_view endpoint,
-               Duration& queryDelay, CurlPostDataT&& curlPostData = CurlPostData(), bool throwIfError = true) {
+T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+               HttpRequestType requestType, std::string_view endpoint, Duration& queryDelay,
+               CurlPostDataT&& curlPostData = CurlPostData(), bool throwIfError = true) {
   CurlOptions opts(requestType, std::forward<CurlPostDataT>(curlPostData));
   opts.mutableHttpHeaders().emplace_back("X-MBX-APIKEY", apiKey.key());
+  opts.setWeight(BinancePublic::RequestWeight(requestType, endpoint, opts.postData()));
 
-  Duration sleepingTime = curlHandle.minDurationBetweenQueries();
+  Duration sleepingTime = std::max(curlHandle.minDurationBetweenQueries(), kMinRetryDelay);
   int statusCode{};
   QueryDelayDir queryDelayDir = QueryDelayDir::kNoDir;
   T ret;
@@ -202,7 +208,7 @@ T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType req
       sleepingTime = (3 * sleepingTime) / 2;
     }
 
-    SetNonceAndSignature(apiKey, opts.mutablePostData(), queryDelay);
+    SetNonceAndSignature(signer, opts.mutablePostData(), queryDelay);
 
     auto resStr = curlHandle.query(endpoint, opts);
     // NOLINTNEXTLINE(readability-implicit-bool-conversion)
@@ -260,28 +266,25 @@ BinancePrivate::BinancePrivate(const CoincenterInfo& coincenterInfo, BinancePubl
     : ExchangePrivate(coincenterInfo, binancePublic, apiKey),
       _curlHandle(BinancePublic::kURLBases, coincenterInfo.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   coincenterInfo.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _curlHandle, _apiKey, binancePublic, _queryDelay),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, binancePublic, _queryDelay),
-      _allWithdrawFeesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::withdrawalFees), _cachedResultVault),
-          _curlHandle, _apiKey, binancePublic, _queryDelay),
-      _withdrawFeesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::withdrawalFees), _cachedResultVault),
-          _curlHandle, _apiKey, binancePublic, _queryDelay) {}
+      _signer(apiKey.privateKey()),
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), _curlHandle, _apiKey, _signer,
+                               binancePublic, _queryDelay),
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _signer,
+                           binancePublic, _queryDelay),
+      _allWithdrawFeesCache(cachedResultOptions(QueryType::withdrawalFees), _curlHandle, _apiKey, _signer,
+                            binancePublic, _queryDelay),
+      _withdrawFeesCache(cachedResultOptions(QueryType::withdrawalFees), _curlHandle, _apiKey, _signer,
+                         binancePublic, _queryDelay) {}
 
 CurrencyExchangeFlatSet BinancePrivate::TradableCurrenciesCache::operator()() {
-  auto allCoins = PrivateQuery<schema::binance::NetworkCoinDataVector>(_curlHandle, _apiKey, HttpRequestType::kGet,
-                                                                       "/sapi/v1/capital/config/getall", _queryDelay);
+  auto allCoins = PrivateQuery<schema::binance::NetworkCoinDataVector>(
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/sapi/v1/capital/config/getall", _queryDelay);
   return BinanceGlobalInfos::ExtractTradableCurrencies(allCoins, _exchangePublic.exchangeConfig().asset.allExclude);
 }
 
 bool BinancePrivate::validateApiKey() {
   static constexpr bool throwIfError = false;
-  auto result = PrivateQuery<schema::binance::V1AccountStatus>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  auto result = PrivateQuery<schema::binance::V1AccountStatus>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                                "/sapi/v1/account/status", _queryDelay, CurlPostData(),
                                                                throwIfError);
   static constexpr std::string_view kNormalStatus = "Normal";
@@ -290,8 +293,9 @@ bool BinancePrivate::validateApiKey() {
 
 BalancePortfolio BinancePrivate::queryAccountBalance(const BalanceOptions& balanceOptions) {
   const auto v3AccountBalance =
-      PrivateQuery<schema::binance::V3AccountBalance>(_curlHandle, _apiKey, HttpRequestType::kGet, "/api/v3/account",
-                                                      _queryDelay, CurlPostData{{"omitZeroBalances", "true"}});
+      PrivateQuery<schema::binance::V3AccountBalance>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
+                                                      "/api/v3/account", _queryDelay,
+                                                      CurlPostData{{"omitZeroBalances", "true"}});
   const bool withBalanceInUse =
       balanceOptions.amountIncludePolicy() == BalanceOptions::AmountIncludePolicy::kWithBalanceInUse;
 
@@ -319,7 +323,7 @@ BalancePortfolio BinancePrivate::queryAccountBalance(const BalanceOptions& balan
 Wallet BinancePrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   // Limitation : we do not provide network here, we use default in accordance of getTradableCurrenciesService
   auto result = PrivateQuery<schema::binance::V1CapitalDepositAddressListElement>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/sapi/v1/capital/deposit/address", _queryDelay,
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/sapi/v1/capital/deposit/address", _queryDelay,
       {{"coin", currencyCode.str()}});
   const CoincenterInfo& coincenterInfo = _exchangePublic.coincenterInfo();
   const bool doCheckWallet =
@@ -418,7 +422,7 @@ ClosedOrderVector BinancePrivate::queryClosedOrders(const OrdersConstraints& clo
       params.emplace_back("endTime", TimestampToMillisecondsSinceEpoch(closedOrdersConstraints.placedBefore()));
     }
     const auto result = PrivateQuery<schema::binance::V3GetAllOrders>(
-        _curlHandle, _apiKey, HttpRequestType::kGet, "/api/v3/allOrders", _queryDelay, std::move(params));
+        _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/api/v3/allOrders", _queryDelay, std::move(params));
 
     FillOrders(closedOrdersConstraints, result, _exchangePublic, closedOrders);
     log::info("Retrieved {} closed orders from {}", closedOrders.size(), _exchangePublic.name());
@@ -440,7 +444,7 @@ OpenedOrderVector BinancePrivate::queryOpenedOrders(const OrdersConstraints& ope
     }
   }
   const auto result = PrivateQuery<schema::binance::V3GetAllOrders>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/api/v3/openOrders", _queryDelay, std::move(params));
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/api/v3/openOrders", _queryDelay, std::move(params));
 
   FillOrders(openedOrdersConstraints, result, _exchangePublic, openedOrders);
 
@@ -457,8 +461,9 @@ int BinancePrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersCons
       return 0;
     }
     if (canUseCancelAllEndpoint) {
-      const auto cancelledOrders = PrivateQuery<schema::binance::V3CancelAllOrders>(
-          _curlHandle, _apiKey, HttpRequestType::kDelete, "/api/v3/openOrders", _queryDelay, std::move(params));
+      const auto cancelledOrders =
+          PrivateQuery<schema::binance::V3CancelAllOrders>(_curlHandle, _apiKey, _signer, HttpRequestType::kDelete,
+                                                           "/api/v3/openOrders", _queryDelay, std::move(params));
       return static_cast<int>(cancelledOrders.size());
     }
   }
@@ -480,13 +485,13 @@ int BinancePrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersCons
     if (orders.size() > 1 && canUseCancelAllEndpoint) {
       params.erase("orderId");
       const auto cancelledOrders = PrivateQuery<schema::binance::V3CancelAllOrders>(
-          _curlHandle, _apiKey, HttpRequestType::kDelete, "/api/v3/openOrders", _queryDelay, params);
+          _curlHandle, _apiKey, _signer, HttpRequestType::kDelete, "/api/v3/openOrders", _queryDelay, params);
       nbOrdersCancelled += static_cast<int>(cancelledOrders.size());
     } else {
       for (const OpenedOrder& order : orders) {
         params.set("orderId", order.id());
         auto cancelledOrder = PrivateQuery<schema::binance::V3CancelOrder>(
-            _curlHandle, _apiKey, HttpRequestType::kDelete, "/api/v3/order", _queryDelay, params);
+            _curlHandle, _apiKey, _signer, HttpRequestType::kDelete, "/api/v3/order", _queryDelay, params);
 
         if (cancelledOrder.orderId != 0) {
           ++nbOrdersCancelled;
@@ -534,7 +539,8 @@ DepositsSet BinancePrivate::queryRecentDeposits(const DepositsConstraints& depos
   }
 
   auto depositStatus = PrivateQuery<schema::binance::V1CapitalDepositHisRec>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/sapi/v1/capital/deposit/hisrec", _queryDelay, std::move(options));
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/sapi/v1/capital/deposit/hisrec", _queryDelay,
+      std::move(options));
 
   Deposits deposits;
   deposits.reserve(static_cast<Deposits::size_type>(depositStatus.size()));
@@ -634,7 +640,7 @@ WithdrawsSet BinancePrivate::queryRecentWithdraws(const WithdrawsConstraints& wi
   // so we use Binance generated 'id' instead.
   // What is important is that the same field is considered in both queries 'launchWithdraw' and 'queryRecentWithdraws'
   auto data = PrivateQuery<schema::binance::V1CapitalWithdrawHistory>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/sapi/v1/capital/withdraw/history", _queryDelay,
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/sapi/v1/capital/withdraw/history", _queryDelay,
       CreateOptionsFromWithdrawConstraints(withdrawsConstraints));
   for (auto& withdrawJson : data) {
     if (withdrawJson.coin.size() > CurrencyCode::kMaxLen) {
@@ -658,7 +664,7 @@ WithdrawsSet BinancePrivate::queryRecentWithdraws(const WithdrawsConstraints& wi
 }
 
 MonetaryAmountByCurrencySet BinancePrivate::AllWithdrawFeesFunc::operator()() {
-  auto result = PrivateQuery<schema::binance::V1AssetDetailMap>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  auto result = PrivateQuery<schema::binance::V1AssetDetailMap>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                                 "/sapi/v1/asset/assetDetail", _queryDelay);
   MonetaryAmountVector fees;
   for (const auto& [curCodeStr, withdrawFeeDetails] : result) {
@@ -676,7 +682,7 @@ MonetaryAmountByCurrencySet BinancePrivate::AllWithdrawFeesFunc::operator()() {
 }
 
 std::optional<MonetaryAmount> BinancePrivate::WithdrawFeesFunc::operator()(CurrencyCode currencyCode) {
-  auto result = PrivateQuery<schema::binance::V1AssetDetailMap>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  auto result = PrivateQuery<schema::binance::V1AssetDetailMap>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                                 "/sapi/v1/asset/assetDetail", _queryDelay,
                                                                 {{"asset", currencyCode.str()}});
   const auto it = result.find(currencyCode.str());
@@ -744,7 +750,7 @@ PlaceOrderInfo BinancePrivate::placeOrder(MonetaryAmount from, MonetaryAmount vo
     if (!isSimulation && toCurrencyCode == kBinanceCoinCur) {
       // Use special Binance Dust transfer
       log::info("Volume too low for standard trade, but we can use Dust transfer to trade to {}", kBinanceCoinCur);
-      auto result = PrivateQuery<schema::binance::V1AssetDust>(_curlHandle, _apiKey, HttpRequestType::kPost,
+      auto result = PrivateQuery<schema::binance::V1AssetDust>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                                "/sapi/v1/asset/dust", _queryDelay,
                                                                {{"asset", from.currencyStr()}});
       if (result.transferResult.empty()) {
@@ -778,8 +784,8 @@ PlaceOrderInfo BinancePrivate::placeOrder(MonetaryAmount from, MonetaryAmount vo
 
   const std::string_view methodName = isSimulation ? "/api/v3/order/test" : "/api/v3/order";
 
-  auto result = PrivateQuery<schema::binance::V3NewOrder>(_curlHandle, _apiKey, HttpRequestType::kPost, methodName,
-                                                          _queryDelay, placePostData);
+  auto result = PrivateQuery<schema::binance::V3NewOrder>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
+                                                          methodName, _queryDelay, placePostData);
   if (isSimulation) {
     placeOrderInfo.setClosed();
     return placeOrderInfo;
@@ -806,7 +812,8 @@ OrderInfo BinancePrivate::queryOrder(OrderIdView orderId, const TradeContext& tr
   const string assetsStr = mk.assetsPairStrUpper();
   const std::string_view assets(assetsStr);
   const auto result = PrivateQuery<schema::binance::V3GetOrder>(
-      _curlHandle, _apiKey, requestType, "/api/v3/order", _queryDelay, {{"symbol", assets}, {"orderId", orderId}});
+      _curlHandle, _apiKey, _signer, requestType, "/api/v3/order", _queryDelay,
+      {{"symbol", assets}, {"orderId", orderId}});
 
   bool isClosed = false;
   bool queryClosedOrder = false;
@@ -826,7 +833,7 @@ OrderInfo BinancePrivate::queryOrder(OrderIdView orderId, const TradeContext& tr
       myTradesOpts.emplace_back("startTime", result.time - 100L);  // -100 just to be sure
     }
     const auto myTradesResult = PrivateQuery<schema::binance::V3MyTrades>(
-        _curlHandle, _apiKey, HttpRequestType::kGet, "/api/v3/myTrades", _queryDelay, myTradesOpts);
+        _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/api/v3/myTrades", _queryDelay, myTradesOpts);
     const auto integralOrderId =
         StringToIntegral<decltype(std::declval<decltype(myTradesResult)>()[0].orderId)>(orderId);
     for (const auto& tradeDetails : myTradesResult) {
@@ -846,9 +853,9 @@ InitiatedWithdrawInfo BinancePrivate::launchWithdraw(MonetaryAmount grossAmount,
   if (destinationWallet.hasTag()) {
     withdrawPostData.emplace_back("addressTag", destinationWallet.tag());
   }
-  auto result = PrivateQuery<schema::binance::V1CapitalWithdrawApply>(_curlHandle, _apiKey, HttpRequestType::kPost,
-                                                                      "/sapi/v1/capital/withdraw/apply", _queryDelay,
-                                                                      std::move(withdrawPostData));
+  auto result = PrivateQuery<schema::binance::V1CapitalWithdrawApply>(
+      _curlHandle, _apiKey, _signer, HttpRequestType::kPost, "/sapi/v1/capital/withdraw/apply", _queryDelay,
+      std::move(withdrawPostData));
   return {std::move(destinationWallet), std::move(result.id), grossAmount};
 }
 
@@ -858,7 +865,7 @@ ReceivedWithdrawInfo BinancePrivate::queryWithdrawDelivery(const InitiatedWithdr
   const Wallet& wallet = initiatedWithdrawInfo.receivingWallet();
 
   auto depositStatus = PrivateQuery<schema::binance::V1CapitalDepositHisRec>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/sapi/v1/capital/deposit/hisrec", _queryDelay,
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/sapi/v1/capital/deposit/hisrec", _queryDelay,
       {{"coin", currencyCode.str()}});
 
   auto newEndIt = std::ranges::remove_if(depositStatus, [&wallet](const auto& el) {
@@ -7,8 +7,10 @@
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
@@ -16,7 +18,7 @@
 #include "apiquerytypeenum.hpp"
 #include "binance-common-api.hpp"
 #include "binance-schema.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_exception.hpp"
 #include "cct_json.hpp"
 #include "cct_log.hpp"
@@ -34,15 +36,19 @@
 #include "exchangepublicapitypes.hpp"
 #include "fiatconverter.hpp"
 #include "httprequesttype.hpp"
+#include "market-order-book-vector.hpp"
 #include "market-vector.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
 #include "order-book-line.hpp"
 #include "permanentcurloptions.hpp"
 #include "public-trade-vector.hpp"
+#include "read-json.hpp"
 #include "request-retry.hpp"
+#include "stringconv.hpp"
 #include "timedef.hpp"
 #include "tradeside.hpp"
 #include "volumeandpricenbdecimals.hpp"
@@ -50,6 +56,8 @@
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kExchangeInfoSection = "exchangeInfo";
+
 template <class T>
 T PublicQuery(CurlHandle& curlHandle, std::string_view method, const CurlPostData& curlPostData = CurlPostData()) {
   string endpoint(method);
@@ -57,7 +65,9 @@ T PublicQuery(CurlHandle& curlHandle, std::string_view method, const CurlPostDat
     endpoint.push_back('?');
     endpoint.append(curlPostData.str());
   }
-  RequestRetry requestRetry(curlHandle, CurlOptions(HttpRequestType::kGet));
+  CurlOptions opts(HttpRequestType::kGet);
+  opts.setWeight(BinancePublic::RequestWeight(HttpRequestType::kGet, method, curlPostData));
+  RequestRetry requestRetry(curlHandle, std::move(opts));
   return requestRetry.query<T>(endpoint, [](const T& response) {
     if constexpr (amc::is_detected<schema::binance::has_code_t, T>::value &&
                   amc::is_detected<schema::binance::has_msg_t, T>::value) {
@@ -72,18 +82,6 @@ T PublicQuery(CurlHandle& curlHandle, std::string_view method, const CurlPostDat
   });
 }
 
-const auto& RetrieveMarketData(const auto& exchangeInfoData, Market mk) {
-  auto it = exchangeInfoData.find(mk);
-  if (it == exchangeInfoData.end()) {
-    throw exception("Unable to retrieve {} data", mk);
-  }
-  return it->second;
-}
-
-VolAndPriNbDecimals QueryVolAndPriNbDecimals(const auto& exchangeInfoData, Market mk) {
-  const auto& marketData = RetrieveMarketData(exchangeInfoData, mk);
-  return {marketData.baseAssetPrecision, marketData.quoteAssetPrecision};
-}
 }  // namespace
 
 BinancePublic::BinancePublic(const CoincenterInfo& coincenterInfo, FiatConverter& fiatConverter,
@@ -92,26 +90,28 @@ BinancePublic::BinancePublic(const CoincenterInfo& coincenterInfo, FiatConverter
       _curlHandle(kURLBases, coincenterInfo.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   coincenterInfo.getRunMode()),
       _commonInfo(exchangeConfig().asset, _curlHandle),
-      _exchangeConfigCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _commonInfo),
-      _marketsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::markets), _cachedResultVault),
-          _exchangeConfigCache, _commonInfo._curlHandle, _commonInfo._assetConfig),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          _exchangeConfigCache, _marketsCache, _commonInfo),
-      _orderbookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          _commonInfo),
-      _tradedVolumeCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume), _cachedResultVault),
-          _commonInfo),
-      _tickerCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::lastPrice), _cachedResultVault),
-          _commonInfo) {}
+      _exchangeConfigCache(cachedResultOptions(QueryType::currencies), _commonInfo),
+      _marketsCache(cachedResultOptions(QueryType::markets), _exchangeConfigCache, _commonInfo._curlHandle,
+                    _commonInfo._assetConfig),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), _exchangeConfigCache, _marketsCache,
+                          _commonInfo),
+      _orderbookCache(cachedResultOptions(QueryType::orderBook), _commonInfo),
+      _tradedVolumeCache(cachedResultOptions(QueryType::tradedVolume), _commonInfo),
+      _tickerCache(cachedResultOptions(QueryType::lastPrice), _commonInfo) {
+  // Markets are computed from exchange info without any additional query
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kExchangeInfoSection, _exchangeConfigCache);
+  });
+}
+
+void BinancePublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kExchangeInfoSection, _exchangeConfigCache);
+  });
+}
 
 bool BinancePublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = _commonInfo._curlHandle.query("/api/v3/ping", CurlOptions(HttpRequestType::kGet));
   return result == "{}";
 }
@@ -133,13 +133,15 @@ std::optional<MonetaryAmount> BinancePublic::queryWithdrawalFee(CurrencyCode cur
 }
 
 MarketSet BinancePublic::MarketsFunc::operator()() {
-  const auto& exchangeInfoData = _exchangeConfigCache.get();
+  const auto pExchangeInfoData = _exchangeConfigCache.get();
+  const auto& exchangeInfoData = *pExchangeInfoData;
   const CurrencyCodeSet& excludedCurrencies = _assetConfig.allExclude;
 
   MarketVector markets;
-  markets.reserve(static_cast<MarketSet::size_type>(exchangeInfoData.size()));
+  markets.reserve(static_cast<MarketSet::size_type>(exchangeInfoData.marketFilters().size()));
 
-  for (const auto& [mk, symbol] : exchangeInfoData) {
+  for (const auto& marketFilters : exchangeInfoData.marketFilters()) {
+    const Market mk = marketFilters.market();
     if (excludedCurrencies.contains(mk.base()) || excludedCurrencies.contains(mk.quote())) {
       continue;
     }
@@ -150,8 +152,8 @@ MarketSet BinancePublic::MarketsFunc::operator()() {
   return ret;
 }
 
-BinancePublic::ExchangeInfoFunc::ExchangeInfoDataByMarket BinancePublic::ExchangeInfoFunc::operator()() {
-  ExchangeInfoDataByMarket ret;
+BinanceMarketFiltersMap BinancePublic::ExchangeInfoFunc::operator()() {
+  vector<BinanceMarketFilters> marketFilters;
   auto data = PublicQuery<schema::binance::V3ExchangeInfo>(_commonInfo._curlHandle, "/api/v3/exchangeInfo");
   for (auto& symbol : data.symbols) {
     if (symbol.status != "TRADING") {
@@ -168,50 +170,14 @@ BinancePublic::ExchangeInfoFunc::ExchangeInfoDataByMarket BinancePublic::Exchang
       continue;
     }
     log::trace("Accept {}-{} Binance asset pair", symbol.baseAsset, symbol.quoteAsset);
-    Market market(CurrencyCode{symbol.baseAsset}, CurrencyCode{symbol.quoteAsset});
-    ret.insert_or_assign(std::move(market), std::move(symbol));
+    marketFilters.emplace_back(Market(CurrencyCode{symbol.baseAsset}, CurrencyCode{symbol.quoteAsset}), symbol);
   }
-  return ret;
+  // Filters are compiled once here, instead of being looked up at each order
+  return BinanceMarketFiltersMap(std::move(marketFilters));
 }
 
 MonetaryAmount BinancePublic::sanitizePrice(Market mk, MonetaryAmount pri) {
-  const auto& exchangeConfigCache = _exchangeConfigCache.get();
-  const auto& marketData = RetrieveMarketData(exchangeConfigCache, mk);
-
-  const schema::binance::V3ExchangeInfo::Symbol::Filter* pPriceFilter = nullptr;
-  MonetaryAmount ret(pri);
-  for (const auto& filter : marketData.filters) {
-    if (filter.filterType == "PRICE_FILTER") {
-      pPriceFilter = std::addressof(filter);
-      break;
-    }
-  }
-
-  if (pPriceFilter != nullptr) {
-    MonetaryAmount maxPrice(pPriceFilter->maxPrice, ret.currencyCode());
-    MonetaryAmount minPrice(pPriceFilter->minPrice, ret.currencyCode());
-    MonetaryAmount tickSize(pPriceFilter->tickSize, ret.currencyCode());
-
-    if (ret > maxPrice) {
-      log::debug("Too big price {} capped to {} for {}", ret, maxPrice, mk);
-      ret = maxPrice;
-    } else if (ret < minPrice) {
-      log::debug("Too small price {} increased to {} for {}", ret, minPrice, mk);
-      ret = minPrice;
-    } else {
-      ret.round(tickSize, MonetaryAmount::RoundType::kDown);
-      if (ret != pri) {
-        log::debug("Rounded {} into {} according to {}", pri, ret, mk);
-      }
-    }
-  }
-
-  VolAndPriNbDecimals volAndPriNbDecimals = QueryVolAndPriNbDecimals(exchangeConfigCache, mk);
-  ret.truncate(volAndPriNbDecimals.priNbDecimals);
-  if (pri != ret) {
-    log::warn("Sanitize price {} -> {}", pri, ret);
-  }
-  return ret;
+  return _exchangeConfigCache.get()->get(mk).sanitizePrice(pri);
 }
 
 MonetaryAmount BinancePublic::computePriceForNotional(Market mk, int avgPriceMins) {
@@ -224,126 +190,74 @@ MonetaryAmount BinancePublic::computePriceForNotional(Market mk, int avgPriceMin
     log::error("Unable to retrieve last trades from {}, use average price instead for notional", mk);
   }
 
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   const auto result = PublicQuery<schema::binance::V3AvgPrice>(_commonInfo._curlHandle, "/api/v3/avgPrice",
                                                                {{"symbol", mk.assetsPairStrUpper()}});
 
   return {result.price, mk.quote()};
 }
 
-MonetaryAmount BinancePublic::sanitizeVolume(Market mk, MonetaryAmount vol, MonetaryAmount priceForNotional,
-                                             bool isTakerOrder) {
-  const auto& marketData = RetrieveMarketData(_exchangeConfigCache.get(), mk);
-  MonetaryAmount ret(vol);
-
-  const schema::binance::V3ExchangeInfo::Symbol::Filter* pMinNotionalFilter = nullptr;
-  const schema::binance::V3ExchangeInfo::Symbol::Filter* pNotionalFilter = nullptr;
-  const schema::binance::V3ExchangeInfo::Symbol::Filter* pLotSizeFilter = nullptr;
-  const schema::binance::V3ExchangeInfo::Symbol::Filter* pMarketLotSizeFilter = nullptr;
-
-  for (const auto& filter : marketData.filters) {
-    if (filter.filterType == "LOT_SIZE") {
-      pLotSizeFilter = std::addressof(filter);
-    } else if (filter.filterType == "MARKET_LOT_SIZE") {
-      if (isTakerOrder) {
-        pMarketLotSizeFilter = std::addressof(filter);
-      }
-    } else if (filter.filterType == "MIN_NOTIONAL") {
-      if (isTakerOrder) {
-        if (filter.applyToMarket) {
-          priceForNotional = computePriceForNotional(mk, filter.avgPriceMins);
-          pMinNotionalFilter = std::addressof(filter);
-        }
-      } else {
-        pMinNotionalFilter = std::addressof(filter);
-      }
-    } else if (filter.filterType == "NOTIONAL") {
-      if (isTakerOrder) {
-        if (filter.applyMinToMarket || filter.applyMaxToMarket) {
-          priceForNotional = computePriceForNotional(mk, filter.avgPriceMins);
-          pNotionalFilter = std::addressof(filter);
-        }
-      } else {
-        pNotionalFilter = std::addressof(filter);
-      }
-    }
+int32_t BinancePublic::RequestWeight(HttpRequestType requestType, std::string_view endpoint,
+                                     const CurlPostData& curlPostData) {
+  // Only the requests with a weight different from 1 are listed here
+  if (requestType != HttpRequestType::kGet) {
+    return 1;
   }
-
-  MonetaryAmount minVolumeAfterMinNotional(0, ret.currencyCode());
-  if (pMinNotionalFilter != nullptr) {
-    MonetaryAmount minNotional(pMinNotionalFilter->minNotional);
-    MonetaryAmount priceTimesQuantity = ret.toNeutral() * priceForNotional.toNeutral();
-
-    minVolumeAfterMinNotional = MonetaryAmount(minNotional / priceForNotional, ret.currencyCode());
-    if (priceTimesQuantity < minNotional) {
-      log::debug("Too small min price * quantity. {} increased to {} for {}", ret, minVolumeAfterMinNotional, mk);
-      ret = minVolumeAfterMinNotional;
+  const bool hasSymbol = curlPostData.contains("symbol");
+  if (endpoint == "/api/v3/depth") {
+    const std::string_view limitStr = curlPostData.get("limit");
+    const auto limit = limitStr.empty() ? 100 : StringToIntegral<int32_t>(limitStr);
+    if (limit <= 100) {
+      return 5;
     }
-  }
-
-  if (pNotionalFilter != nullptr) {
-    MonetaryAmount priceTimesQuantity = ret.toNeutral() * priceForNotional.toNeutral();
-
-    if (!isTakerOrder || pNotionalFilter->applyMinToMarket) {
-      // min notional applies
-      MonetaryAmount minNotional(pNotionalFilter->minNotional);
-
-      minVolumeAfterMinNotional =
-          std::max(minVolumeAfterMinNotional, MonetaryAmount(minNotional / priceForNotional, ret.currencyCode()));
-
-      if (priceTimesQuantity < minNotional) {
-        log::debug("Too small (price * quantity). {} increased to {} for {}", ret, minVolumeAfterMinNotional, mk);
-        ret = minVolumeAfterMinNotional;
-      }
-    } else if (!isTakerOrder || pNotionalFilter->applyMaxToMarket) {
-      // max notional applies
-      MonetaryAmount maxNotional(pNotionalFilter->maxNotional);
-      MonetaryAmount maxVolumeAfterMaxNotional = MonetaryAmount(maxNotional / priceForNotional, ret.currencyCode());
-
-      if (priceTimesQuantity > maxNotional) {
-        log::debug("Too large (price * quantity). {} decreased to {} for {}", ret, maxVolumeAfterMaxNotional, mk);
-        ret = maxVolumeAfterMaxNotional;
-      }
+    if (limit <= 500) {
+      return 25;
     }
+    return limit <= 1000 ? 50 : 250;
   }
-
-  for (const auto* pLotFilterPtr : {pMarketLotSizeFilter, pLotSizeFilter}) {
-    if (pLotFilterPtr != nullptr) {
-      // "maxQty": "9000000.00000000",
-      // "minQty": "1.00000000",
-      // "stepSize": "1.00000000"
-      MonetaryAmount maxQty(pLotFilterPtr->maxQty, ret.currencyCode());
-      MonetaryAmount minQty(pLotFilterPtr->minQty, ret.currencyCode());
-      MonetaryAmount stepSize(pLotFilterPtr->stepSize, ret.currencyCode());
-
-      if (ret > maxQty) {
-        log::debug("Too big volume {} capped to {} for {}", ret, maxQty, mk);
-        ret = maxQty;
-      } else if (ret < minQty) {
-        log::debug("Too small volume {} increased to {} for {}", ret, minQty, mk);
-        ret = minQty;
-      } else if (stepSize != 0) {
-        if (ret == minVolumeAfterMinNotional) {
-          ret.round(stepSize, MonetaryAmount::RoundType::kUp);
-          log::debug("{} rounded up to {} because {} min notional applied", minVolumeAfterMinNotional, ret, mk);
-        } else {
-          ret.round(stepSize, MonetaryAmount::RoundType::kDown);
-          log::debug("{} rounded down to {} according to {}", vol, ret, mk);
-        }
-      }
-    }
+  if (endpoint == "/api/v3/exchangeInfo" || endpoint == "/api/v3/account" || endpoint == "/api/v3/allOrders" ||
+      endpoint == "/api/v3/myTrades") {
+    return 20;
+  }
+  if (endpoint == "/api/v3/trades") {
+    return 25;
+  }
+  if (endpoint == "/api/v3/ticker/24hr") {
+    return hasSymbol ? 2 : 80;
+  }
+  if (endpoint == "/api/v3/openOrders") {
+    return hasSymbol ? 6 : 80;
   }
+  if (endpoint == "/api/v3/ticker/bookTicker" || endpoint == "/api/v3/ticker/price") {
+    return hasSymbol ? 2 : 4;
+  }
+  if (endpoint == "/api/v3/avgPrice") {
+    return 2;
+  }
+  if (endpoint == "/api/v3/order") {
+    return 4;
+  }
+  return 1;
+}
 
-  VolAndPriNbDecimals volAndPriNbDecimals = QueryVolAndPriNbDecimals(_exchangeConfigCache.get(), mk);
-  ret.truncate(volAndPriNbDecimals.volNbDecimals);
-  if (ret != vol) {
-    log::warn("Sanitize volume {} -> {}", vol, ret);
+MonetaryAmount BinancePublic::sanitizeVolume(Market mk, MonetaryAmount vol, MonetaryAmount priceForNotional,
+                                             bool isTakerOrder) {
+  const auto pExchangeInfoData = _exchangeConfigCache.get();
+  const auto& marketFilters = pExchangeInfoData->get(mk);
+  if (isTakerOrder) {
+    const auto optAvgPriceMins = marketFilters.takerNotionalAvgPriceMins();
+    if (optAvgPriceMins) {
+      priceForNotional = computePriceForNotional(mk, *optAvgPriceMins);
+    }
   }
-  return ret;
+  return marketFilters.sanitizeVolume(vol, priceForNotional, isTakerOrder);
 }
 
 MarketOrderBookMap BinancePublic::AllOrderBooksFunc::operator()(int depth) {
   MarketOrderBookMap ret;
-  const MarketSet& markets = _marketsCache.get();
+  const auto pMarkets = _marketsCache.get();
+  const auto pExchangeInfoData = _exchangeConfigCache.get();
+  const MarketSet& markets = *pMarkets;
   auto result = PublicQuery<schema::binance::V3TickerBookTicker>(_commonInfo._curlHandle, "/api/v3/ticker/bookTicker");
   using BinanceAssetPairToStdMarketMap = std::unordered_map<string, Market>;
   BinanceAssetPairToStdMarketMap binanceAssetPairToStdMarketMap;
@@ -364,14 +278,18 @@ MarketOrderBookMap BinancePublic::AllOrderBooksFunc::operator()(int depth) {
     MonetaryAmount bidVol(elem.bidQty, mk.base());
 
     ret.insert_or_assign(mk, MarketOrderBook(time, askPri, askVol, bidPri, bidVol,
-                                             QueryVolAndPriNbDecimals(_exchangeConfigCache.get(), mk), depth));
+                                             pExchangeInfoData->get(mk).volAndPriNbDecimals(), depth));
   }
 
   log::info("Retrieved ticker information from {} markets", ret.size());
   return ret;
 }
 
-MarketOrderBook BinancePublic::OrderBookFunc::operator()(Market mk, int depth) {
+namespace {
+
+constexpr std::string_view kOrderBookEndpoint = "/api/v3/depth";
+
+CurlPostData OrderBookPostData(Market mk, int depth) {
   // Binance has a fixed range of authorized values for depth
   static constexpr std::array kAuthorizedDepths = {5, 10, 20, 50, 100, 500, 1000, 5000};
   auto lb = std::ranges::lower_bound(kAuthorizedDepths, depth);
@@ -380,13 +298,14 @@ MarketOrderBook BinancePublic::OrderBookFunc::operator()(Market mk, int depth) {
     log::error("Invalid depth {}, default to {}", depth, *lb);
   }
 
-  MarketOrderBookLines orderBookLines;
+  return {{"symbol", mk.assetsPairStrUpper()}, {"limit", *lb}};
+}
 
-  const CurlPostData postData{{"symbol", mk.assetsPairStrUpper()}, {"limit", *lb}};
-  const auto asksAndBids =
-      PublicQuery<schema::binance::V3OrderBook>(_commonInfo._curlHandle, "/api/v3/depth", postData);
+MarketOrderBook CreateOrderBook(Market mk, int depth, const schema::binance::V3OrderBook& asksAndBids) {
   const auto nowTime = Clock::now();
 
+  MarketOrderBookLines orderBookLines;
+
   orderBookLines.reserve(std::min(static_cast<decltype(depth)>(asksAndBids.asks.size()), depth) +
                          std::min(static_cast<decltype(depth)>(asksAndBids.bids.size()), depth));
 
@@ -403,6 +322,34 @@ MarketOrderBook BinancePublic::OrderBookFunc::operator()(Market mk, int depth) {
   return MarketOrderBook(nowTime, mk, orderBookLines);
 }
 
+}  // namespace
+
+MarketOrderBookVector BinancePublic::queryOrderBooks(std::span<const Market> markets, int depth) {
+  // Full order books can only be retrieved one market at a time - but their requests can be in flight at the same time
+  return QueryOrderBooksWithCache(_orderbookCache, markets, depth, [this, depth](std::span<const Market> mks) {
+    return queryOrderBooksConcurrently(
+        _curlHandle, mks, kOrderBookEndpoint,
+        [depth](Market mk) {
+          CurlOptions opts(HttpRequestType::kGet, OrderBookPostData(mk, depth));
+          opts.setWeight(RequestWeight(HttpRequestType::kGet, kOrderBookEndpoint, opts.postData()));
+          return opts;
+        },
+        [depth](Market mk, std::string_view response) {
+          const auto asksAndBids = ReadJsonOrThrow<schema::binance::V3OrderBook, kPartialJsonOptions>(response);
+          if (asksAndBids.code && asksAndBids.msg) {
+            throw exception("Binance error ({}), msg: '{}'", *asksAndBids.code, *asksAndBids.msg);
+          }
+          return CreateOrderBook(mk, depth, asksAndBids);
+        });
+  });
+}
+
+MarketOrderBook BinancePublic::OrderBookFunc::operator()(Market mk, int depth) {
+  const auto asksAndBids = PublicQuery<schema::binance::V3OrderBook>(_commonInfo._curlHandle, kOrderBookEndpoint,
+                                                                     OrderBookPostData(mk, depth));
+  return CreateOrderBook(mk, depth, asksAndBids);
+}
+
 MonetaryAmount BinancePublic::TradedVolumeFunc::operator()(Market mk) {
   const auto result = PublicQuery<schema::binance::V3Ticker24hr>(_commonInfo._curlHandle, "/api/v3/ticker/24hr",
                                                                  {{"symbol", mk.assetsPairStrUpper()}});
@@ -418,6 +365,7 @@ PublicTradeVector BinancePublic::queryLastTrades(Market mk, int nbTrades) {
     nbTrades = kMaxNbLastTrades;
   }
 
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   const auto result = PublicQuery<schema::binance::V3Trades>(
       _commonInfo._curlHandle, "/api/v3/trades", {{"symbol", mk.assetsPairStrUpper()}, {"limit", nbTrades}});
 
@@ -240,8 +240,8 @@ bool CheckOrderErrors(std::string_view endpoint, std::string_view msg, T& data)
 }
 
 template <class T>
-T PrivateQueryProcessWithRetries(CurlHandle& curlHandle, const APIKey& apiKey, std::string_view endpoint,
-                                 CurlOptions&& opts) {
+T PrivateQueryProcessWithRetries(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha512Signer& signer,
+                                 std::string_view endpoint, CurlOptions&& opts) {
   RequestRetry requestRetry(curlHandle, std::move(opts));
   return requestRetry.query<T>(
       endpoint,
@@ -269,23 +269,23 @@ T PrivateQueryProcessWithRetries(CurlHandle& curlHandle, const APIKey& apiKey, s
 
         return RequestRetry::Status::kResponseError;
       },
-      [endpoint, &apiKey](CurlOptions& curlOptions) {
+      [endpoint, &apiKey, &signer](CurlOptions& curlOptions) {
         auto [strData, nonce] = GetStrData(endpoint, curlOptions.postData().str());
-        auto signature = B64Encode(ssl::Sha512Hex(strData, apiKey.privateKey()));
+        auto signature = B64Encode(signer.signHex(strData));
 
         SetHttpHeaders(curlOptions, apiKey, signature, nonce);
       });
 }
 
 template <class T, class CurlPostDataT = CurlPostData>
-T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, std::string_view endpoint,
-               CurlPostDataT&& curlPostData = CurlPostData()) {
+T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha512Signer& signer,
+               std::string_view endpoint, CurlPostDataT&& curlPostData = CurlPostData()) {
   CurlPostData postData(std::forward<CurlPostDataT>(curlPostData));
   postData.emplace_front("endpoint", endpoint);
 
   CurlOptions opts(HttpRequestType::kPost, postData.urlEncodeExceptDelimiters());
 
-  return PrivateQueryProcessWithRetries<T>(curlHandle, apiKey, endpoint, std::move(opts));
+  return PrivateQueryProcessWithRetries<T>(curlHandle, apiKey, signer, endpoint, std::move(opts));
 }
 
 File GetBithumbCurrencyInfoMapCache(std::string_view dataDir) {
@@ -298,17 +298,18 @@ BithumbPrivate::BithumbPrivate(const CoincenterInfo& config, BithumbPublic& bith
     : ExchangePrivate(config, bithumbPublic, apiKey),
       _curlHandle(BithumbPublic::kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   config.getRunMode()),
+      _signer(apiKey.privateKey()),
       _currencyOrderInfoRefreshTime(exchangeConfig().query.getUpdateFrequency(QueryType::currencyInfo)),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, bithumbPublic) {
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _signer,
+                           bithumbPublic) {
   if (config.getRunMode() != settings::RunMode::kQueryResponseOverriden) {
     ReadExactJsonOrThrow(GetBithumbCurrencyInfoMapCache(_coincenterInfo.dataDir()).readAll(), _currencyOrderInfoMap);
   }
 }
 
 bool BithumbPrivate::validateApiKey() {
-  const auto data = PrivateQuery<schema::bithumb::InfoBalance>(_curlHandle, _apiKey, "/info/balance", CurlPostData());
+  const auto data =
+      PrivateQuery<schema::bithumb::InfoBalance>(_curlHandle, _apiKey, _signer, "/info/balance", CurlPostData());
   if (data.status.empty()) {
     log::error("Unexpected Bithumb reply from balance");
     return false;
@@ -320,7 +321,7 @@ bool BithumbPrivate::validateApiKey() {
 
 BalancePortfolio BithumbPrivate::queryAccountBalance(const BalanceOptions& balanceOptions) {
   const auto result =
-      PrivateQuery<schema::bithumb::InfoBalance>(_curlHandle, _apiKey, "/info/balance", {{"currency", "all"}});
+      PrivateQuery<schema::bithumb::InfoBalance>(_curlHandle, _apiKey, _signer, "/info/balance", {{"currency", "all"}});
 
   BalancePortfolio balancePortfolio;
 
@@ -345,8 +346,8 @@ BalancePortfolio BithumbPrivate::queryAccountBalance(const BalanceOptions& balan
 }
 
 Wallet BithumbPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
-  const auto ret = PrivateQuery<schema::bithumb::InfoWalletAddress>(_curlHandle, _apiKey, kWalletAddressEndpointStr,
-                                                                    {{"currency", currencyCode.str()}});
+  const auto ret = PrivateQuery<schema::bithumb::InfoWalletAddress>(
+      _curlHandle, _apiKey, _signer, kWalletAddressEndpointStr, {{"currency", currencyCode.str()}});
   std::string_view addressAndTag = ret.data.wallet_address;
   if (addressAndTag.empty()) {
     throw exception(
@@ -397,8 +398,8 @@ TimePoint RetrieveTimePointFromTrxJson(const std::variant<string, int64_t>& date
 }
 
 auto FillOrderCurrencies(const OrdersConstraints& ordersConstraints, ExchangePublic& exchangePublic,
-                         CurlHandle& curlHandle, const APIKey& apiKey, std::string_view prefixKeyBalance,
-                         CurlPostData& params) {
+                         CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha512Signer& signer,
+                         std::string_view prefixKeyBalance, CurlPostData& params) {
   SmallVector<CurrencyCode, 1> orderCurrencies;
 
   if (ordersConstraints.isCurDefined()) {
@@ -417,7 +418,7 @@ auto FillOrderCurrencies(const OrdersConstraints& ordersConstraints, ExchangePub
     // by looking at "is_use" amounts to retrieve opened orders or "available" amounts to retrieve closed orders.
     // The only drawback is that we need to make one query for each currency, but it's better than nothing.
     const auto balance =
-        PrivateQuery<schema::bithumb::InfoBalance>(curlHandle, apiKey, "/info/balance", {{"currency", "all"}});
+        PrivateQuery<schema::bithumb::InfoBalance>(curlHandle, apiKey, signer, "/info/balance", {{"currency", "all"}});
     for (const auto& [key, value] : balance.data) {
       if (key.starts_with(prefixKeyBalance)) {
         CurrencyCode cur(std::string_view(key.begin() + prefixKeyBalance.size(), key.end()));
@@ -432,7 +433,7 @@ auto FillOrderCurrencies(const OrdersConstraints& ordersConstraints, ExchangePub
 
 template <class OrderVectorType>
 OrderVectorType QueryOrders(const OrdersConstraints& ordersConstraints, ExchangePublic& exchangePublic,
-                            CurlHandle& curlHandle, const APIKey& apiKey) {
+                            CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha512Signer& signer) {
   static constexpr int kNbOrdersMaxPerQuery = 1000;
 
   CurlPostData params{{"count", kNbOrdersMaxPerQuery}};
@@ -442,7 +443,7 @@ OrderVectorType QueryOrders(const OrdersConstraints& ordersConstraints, Exchange
   static constexpr std::string_view kPrefixKey = std::is_same_v<OrderType, ClosedOrder> ? "available_" : "in_use_";
 
   const auto orderCurrencies =
-      FillOrderCurrencies(ordersConstraints, exchangePublic, curlHandle, apiKey, kPrefixKey, params);
+      FillOrderCurrencies(ordersConstraints, exchangePublic, curlHandle, apiKey, signer, kPrefixKey, params);
 
   OrderVectorType orders;
   if (ordersConstraints.isPlacedTimeAfterDefined()) {
@@ -459,7 +460,7 @@ OrderVectorType QueryOrders(const OrdersConstraints& ordersConstraints, Exchange
   for (CurrencyCode volumeCur : orderCurrencies) {
     params.set(kOrderCurrencyParamStr, volumeCur.str());
 
-    auto ordersReply = PrivateQuery<schema::bithumb::InfoOrders>(curlHandle, apiKey, "/info/orders", params);
+    auto ordersReply = PrivateQuery<schema::bithumb::InfoOrders>(curlHandle, apiKey, signer, "/info/orders", params);
 
     for (auto& orderDetails : ordersReply.data) {
       TimePoint placedTime = RetrieveTimePointFromTrxJson(orderDetails.order_date);
@@ -574,7 +575,8 @@ enum class UserTransactionEnum : int8_t {
 
 template <class ConstraintsType>
 auto QueryUserTransactions(BithumbPrivate& exchangePrivate, CurlHandle& curlHandle, const APIKey& apiKey,
-                           const ConstraintsType& constraints, UserTransactionEnum userTransactionEnum) {
+                           const ssl::HmacSha512Signer& signer, const ConstraintsType& constraints,
+                           UserTransactionEnum userTransactionEnum) {
   SmallVector<CurrencyCode, 1> orderCurrencies;
 
   if (constraints.isCurDefined()) {
@@ -648,8 +650,8 @@ auto QueryUserTransactions(BithumbPrivate& exchangePrivate, CurlHandle& curlHand
 
     for (int searchGb : searchGbsVector) {
       options.set("searchGb", searchGb);
-      auto userTransactionsReply =
-          PrivateQuery<schema::bithumb::UserTransactions>(curlHandle, apiKey, "/info/user_transactions", options);
+      auto userTransactionsReply = PrivateQuery<schema::bithumb::UserTransactions>(curlHandle, apiKey, signer,
+                                                                                   "/info/user_transactions", options);
 
       for (auto& trx : userTransactionsReply.data) {
         if (!constraints.validateCur(trx.order_currency)) {
@@ -687,10 +689,11 @@ auto QueryUserTransactions(BithumbPrivate& exchangePrivate, CurlHandle& curlHand
 }  // namespace
 
 ClosedOrderVector BithumbPrivate::queryClosedOrders(const OrdersConstraints& closedOrdersConstraints) {
-  auto closedOrders = QueryOrders<ClosedOrderVector>(closedOrdersConstraints, _exchangePublic, _curlHandle, _apiKey);
+  auto closedOrders =
+      QueryOrders<ClosedOrderVector>(closedOrdersConstraints, _exchangePublic, _curlHandle, _apiKey, _signer);
 
-  const auto orderTransactionsJson =
-      QueryUserTransactions(*this, _curlHandle, _apiKey, closedOrdersConstraints, UserTransactionEnum::kClosedOrders);
+  const auto orderTransactionsJson = QueryUserTransactions(
+      *this, _curlHandle, _apiKey, _signer, closedOrdersConstraints, UserTransactionEnum::kClosedOrders);
 
   closedOrders.reserve(closedOrders.size() + orderTransactionsJson.size());
   for (const schema::bithumb::UserTransactions::UserTransaction& trx : orderTransactionsJson) {
@@ -712,7 +715,7 @@ ClosedOrderVector BithumbPrivate::queryClosedOrders(const OrdersConstraints& clo
 }
 
 OpenedOrderVector BithumbPrivate::queryOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
-  return QueryOrders<OpenedOrderVector>(openedOrdersConstraints, _exchangePublic, _curlHandle, _apiKey);
+  return QueryOrders<OpenedOrderVector>(openedOrdersConstraints, _exchangePublic, _curlHandle, _apiKey, _signer);
 }
 
 int BithumbPrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
@@ -728,7 +731,8 @@ int BithumbPrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersCons
 DepositsSet BithumbPrivate::queryRecentDeposits(const DepositsConstraints& depositsConstraints) {
   Deposits deposits;
 
-  auto txrList = QueryUserTransactions(*this, _curlHandle, _apiKey, depositsConstraints, UserTransactionEnum::kDeposit);
+  auto txrList =
+      QueryUserTransactions(*this, _curlHandle, _apiKey, _signer, depositsConstraints, UserTransactionEnum::kDeposit);
   deposits.reserve(txrList.size());
   for (const schema::bithumb::UserTransactions::UserTransaction& trx : txrList) {
     const TimePoint timestamp = RetrieveTimePointFromTrxJson(trx.transfer_date);
@@ -746,8 +750,8 @@ DepositsSet BithumbPrivate::queryRecentDeposits(const DepositsConstraints& depos
 WithdrawsSet BithumbPrivate::queryRecentWithdraws(const WithdrawsConstraints& withdrawsConstraints) {
   Withdraws withdraws;
 
-  auto txrList =
-      QueryUserTransactions(*this, _curlHandle, _apiKey, withdrawsConstraints, UserTransactionEnum::kAllWithdraws);
+  auto txrList = QueryUserTransactions(*this, _curlHandle, _apiKey, _signer, withdrawsConstraints,
+                                       UserTransactionEnum::kAllWithdraws);
   withdraws.reserve(txrList.size());
   for (const schema::bithumb::UserTransactions::UserTransaction& trx : txrList) {
     const TimePoint timestamp = RetrieveTimePointFromTrxJson(trx.transfer_date);
@@ -865,7 +869,7 @@ PlaceOrderInfo BithumbPrivate::placeOrder(MonetaryAmount /*from*/, MonetaryAmoun
   static constexpr int kNbMaxRetries = 3;
   bool currencyInfoUpdated = false;
   for (int nbRetries = 0; nbRetries < kNbMaxRetries; ++nbRetries) {
-    auto tradeReply = PrivateQuery<schema::bithumb::Trade>(_curlHandle, _apiKey, endpoint, placePostData);
+    auto tradeReply = PrivateQuery<schema::bithumb::Trade>(_curlHandle, _apiKey, _signer, endpoint, placePostData);
     if (!tradeReply.order_id.empty()) {
       placeOrderInfo.orderId = std::move(tradeReply.order_id);
       placeOrderInfo.orderInfo = queryOrderInfo(placeOrderInfo.orderId, tradeInfo.tradeContext);
@@ -949,7 +953,7 @@ CurlPostData OrderInfoPostData(Market mk, TradeSide side, OrderIdView orderId) {
 }  // namespace
 
 void BithumbPrivate::cancelOrderProcess(OrderIdView orderId, const TradeContext& tradeContext) {
-  PrivateQuery<schema::bithumb::TradeCancel>(_curlHandle, _apiKey, "/trade/cancel",
+  PrivateQuery<schema::bithumb::TradeCancel>(_curlHandle, _apiKey, _signer, "/trade/cancel",
                                              OrderInfoPostData(tradeContext.market, tradeContext.side, orderId));
 }
 
@@ -959,7 +963,7 @@ OrderInfo BithumbPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext
   const CurrencyCode toCurrencyCode = tradeContext.toCur();
 
   CurlPostData postData = OrderInfoPostData(mk, tradeContext.side, orderId);
-  auto ordersReply = PrivateQuery<schema::bithumb::InfoOrders>(_curlHandle, _apiKey, "/info/orders", postData);
+  auto ordersReply = PrivateQuery<schema::bithumb::InfoOrders>(_curlHandle, _apiKey, _signer, "/info/orders", postData);
 
   const bool isClosed = ordersReply.data.empty() || ordersReply.data.front().order_id != orderId;
   OrderInfo orderInfo{TradedAmounts(fromCurrencyCode, toCurrencyCode), isClosed};
@@ -968,8 +972,8 @@ OrderInfo BithumbPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext
   }
 
   postData.erase(kTypeParamStr);
-  auto infoOrderDetailReply =
-      PrivateQuery<schema::bithumb::InfoOrderDetail>(_curlHandle, _apiKey, "/info/order_detail", std::move(postData));
+  auto infoOrderDetailReply = PrivateQuery<schema::bithumb::InfoOrderDetail>(_curlHandle, _apiKey, _signer,
+                                                                             "/info/order_detail", std::move(postData));
 
   for (const auto& contractDetail : infoOrderDetailReply.data.contract) {
     // always in base currency
@@ -1042,12 +1046,12 @@ InitiatedWithdrawInfo BithumbPrivate::launchWithdraw(MonetaryAmount grossAmount,
     return RetrieveTimePointFromTrxJson(lhs.transfer_date) < RetrieveTimePointFromTrxJson(rhs.transfer_date);
   };
 
-  auto oldWithdraws =
-      QueryUserTransactions(*this, _curlHandle, _apiKey, withdrawConstraints, UserTransactionEnum::kOngoingWithdraws);
+  auto oldWithdraws = QueryUserTransactions(*this, _curlHandle, _apiKey, _signer, withdrawConstraints,
+                                            UserTransactionEnum::kOngoingWithdraws);
   std::ranges::sort(oldWithdraws, compareTrxByDate);
 
   // Actually launch the withdraw
-  PrivateQuery<schema::bithumb::BtcWithdrawal>(_curlHandle, _apiKey, "/trade/btc_withdrawal",
+  PrivateQuery<schema::bithumb::BtcWithdrawal>(_curlHandle, _apiKey, _signer, "/trade/btc_withdrawal",
                                                ComputeLaunchWithdrawCurlPostData(netEmittedAmount, destinationWallet));
 
   // Query the withdraws, hopefully we will be able to find our withdraw
@@ -1061,8 +1065,8 @@ InitiatedWithdrawInfo BithumbPrivate::launchWithdraw(MonetaryAmount grossAmount,
       std::this_thread::sleep_for(sleepingTime);
       sleepingTime = (3 * sleepingTime) / 2;
     }
-    auto currentWithdraws =
-        QueryUserTransactions(*this, _curlHandle, _apiKey, withdrawConstraints, UserTransactionEnum::kOngoingWithdraws);
+    auto currentWithdraws = QueryUserTransactions(*this, _curlHandle, _apiKey, _signer, withdrawConstraints,
+                                                  UserTransactionEnum::kOngoingWithdraws);
     std::ranges::sort(currentWithdraws, compareTrxByDate);
 
     // Isolate the new withdraws since the launch of our new withdraw
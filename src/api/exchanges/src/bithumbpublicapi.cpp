@@ -8,6 +8,7 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <sstream>
@@ -19,7 +20,7 @@
 
 #include "apiquerytypeenum.hpp"
 #include "bithumb-schema.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
 #include "coincenterinfo.hpp"
@@ -38,6 +39,7 @@
 #include "httprequesttype.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetaryamount.hpp"
 #include "order-book-line.hpp"
 #include "permanentcurloptions.hpp"
@@ -52,6 +54,8 @@
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kTradableCurrenciesSection = "tradableCurrencies";
+
 auto ComputeMethodUrl(std::string_view endpoint, CurrencyCode base, CurrencyCode quote, std::string_view urlOpts) {
   string methodUrl;
 
@@ -100,20 +104,23 @@ T PublicQuery(CurlHandle& curlHandle, std::string_view method, CurrencyCode base
 BithumbPublic::BithumbPublic(const CoincenterInfo& config, FiatConverter& fiatConverter, CommonAPI& commonAPI)
     : ExchangePublic(ExchangeNameEnum::bithumb, fiatConverter, commonAPI, config),
       _curlHandle(kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(), config.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          config, commonAPI, _curlHandle),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          config, _curlHandle, exchangeConfig().asset),
-      _orderbookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          config, _curlHandle, exchangeConfig().asset),
-      _tradedVolumeCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume), _cachedResultVault),
-          _curlHandle) {}
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), config, commonAPI, _curlHandle),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), config, _curlHandle, exchangeConfig().asset),
+      _orderbookCache(cachedResultOptions(QueryType::orderBook), config, _curlHandle, exchangeConfig().asset),
+      _tradedVolumeCache(cachedResultOptions(QueryType::tradedVolume), _curlHandle) {
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kTradableCurrenciesSection, _tradableCurrenciesCache);
+  });
+}
+
+void BithumbPublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kTradableCurrenciesSection, _tradableCurrenciesCache);
+  });
+}
 
 bool BithumbPublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto networkInfoStr = _curlHandle.query("/public/network-info", CurlOptions(HttpRequestType::kGet));
   schema::bithumb::V1NetworkInfo networkInfo;
   // NOLINTNEXTLINE(readability-implicit-bool-conversion)
@@ -130,9 +137,9 @@ bool BithumbPublic::healthCheck() {
 
 MarketSet BithumbPublic::queryTradableMarkets() {
   auto [pMarketOrderbookMap, lastUpdatedTime] = _allOrderBooksCache.retrieve();
-  if (pMarketOrderbookMap == nullptr ||
+  if (!pMarketOrderbookMap ||
       lastUpdatedTime + exchangeConfig().query.getUpdateFrequency(QueryType::markets) < Clock::now()) {
-    pMarketOrderbookMap = std::addressof(_allOrderBooksCache.get());
+    pMarketOrderbookMap = _allOrderBooksCache.get();
   }
   MarketSet markets;
   markets.reserve(static_cast<MarketSet::size_type>(pMarketOrderbookMap->size()));
@@ -334,6 +341,7 @@ PublicTradeVector BithumbPublic::queryLastTrades(Market mk, int nbTrades) {
   string urlOpts("count=");
   AppendIntegralToString(urlOpts, nbTrades);
 
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = PublicQuery<schema::bithumb::TransactionHistory>(_curlHandle, "/public/transaction_history/", mk.base(),
                                                                  mk.quote(), urlOpts);
 
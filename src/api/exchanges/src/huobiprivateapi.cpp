@@ -86,7 +86,7 @@ auto ComputePostDataFormat(HttpRequestType requestType, const CurlPostData& post
   return postDataFormat;
 }
 
-void SetNonceAndSignature(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType requestType,
+void SetNonceAndSignature(CurlHandle& curlHandle, const ssl::HmacSha256Signer& signer, HttpRequestType requestType,
                           std::string_view endpoint, CurlPostData& postData, CurlPostData& signaturePostData) {
   auto isNotEncoded = [](char ch) { return isalnum(ch) || ch == '-' || ch == '.' || ch == '_' || ch == '~'; };
 
@@ -106,15 +106,15 @@ void SetNonceAndSignature(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequ
   }
 
   signaturePostData.emplace_back(
-      kSignatureKey, URLEncode(B64Encode(ssl::Sha256Bin(BuildParamStr(requestType, curlHandle.getNextBaseUrl(),
-                                                                      endpoint, signaturePostData.str()),
-                                                        apiKey.privateKey())),
-                               isNotEncoded));
+      kSignatureKey,
+      URLEncode(B64Encode(signer.sign(BuildParamStr(requestType, curlHandle.getNextBaseUrl(), endpoint,
+                                                    signaturePostData.str()))),
+                isNotEncoded));
 }
 
 template <class T>
-T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType requestType, std::string_view endpoint,
-               CurlPostData&& postData = CurlPostData()) {
+T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+               HttpRequestType requestType, std::string_view endpoint, CurlPostData&& postData = CurlPostData()) {
   CurlPostData signaturePostData{
       {"AccessKeyId", apiKey.key()}, {"SignatureMethod", "HmacSHA256"}, {"SignatureVersion", 2}};
 
@@ -151,8 +151,8 @@ T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType req
         }
         return RequestRetry::Status::kResponseOK;
       },
-      [&signaturePostData, &curlHandle, &apiKey, requestType, endpoint, &method](CurlOptions& opts) {
-        SetNonceAndSignature(curlHandle, apiKey, requestType, endpoint, opts.mutablePostData(), signaturePostData);
+      [&signaturePostData, &curlHandle, &signer, requestType, endpoint, &method](CurlOptions& opts) {
+        SetNonceAndSignature(curlHandle, signer, requestType, endpoint, opts.mutablePostData(), signaturePostData);
 
         method.replace(method.begin() + endpoint.size() + 1U, method.end(), signaturePostData.str());
       });
@@ -166,22 +166,22 @@ HuobiPrivate::HuobiPrivate(const CoincenterInfo& coincenterInfo, HuobiPublic& hu
     : ExchangePrivate(coincenterInfo, huobiPublic, apiKey),
       _curlHandle(HuobiPublic::kURLBases, coincenterInfo.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   coincenterInfo.getRunMode()),
-      _accountIdCache(CachedResultOptions(std::chrono::hours(48), _cachedResultVault), _curlHandle, apiKey),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, huobiPublic) {}
+      _signer(apiKey.privateKey()),
+      _accountIdCache(CachedResultOptions(std::chrono::hours(48), _cachedResultVault), _curlHandle, apiKey, _signer),
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _signer,
+                           huobiPublic) {}
 
 bool HuobiPrivate::validateApiKey() {
-  const auto result = PrivateQuery<schema::huobi::V1AccountAccounts>(_curlHandle, _apiKey, HttpRequestType::kGet,
-                                                                     "/v1/account/accounts", CurlPostData());
+  const auto result = PrivateQuery<schema::huobi::V1AccountAccounts>(
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/v1/account/accounts", CurlPostData());
 
   return result.status == "ok" && !result.data.empty();
 }
 
 BalancePortfolio HuobiPrivate::queryAccountBalance(const BalanceOptions& balanceOptions) {
   const auto method = cct::format("/v1/account/accounts/{}/balance", _accountIdCache.get());
-  const auto result =
-      PrivateQuery<schema::huobi::V1AccountAccountsBalance>(_curlHandle, _apiKey, HttpRequestType::kGet, method);
+  const auto result = PrivateQuery<schema::huobi::V1AccountAccountsBalance>(_curlHandle, _apiKey, _signer,
+                                                                            HttpRequestType::kGet, method);
   const bool withBalanceInUse =
       balanceOptions.amountIncludePolicy() == BalanceOptions::AmountIncludePolicy::kWithBalanceInUse;
 
@@ -206,7 +206,8 @@ BalancePortfolio HuobiPrivate::queryAccountBalance(const BalanceOptions& balance
 Wallet HuobiPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   string lowerCaseCur = ToLower(currencyCode.str());
   auto result = PrivateQuery<schema::huobi::V2AccountDepositAddress>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/v2/account/deposit/address", {{"currency", lowerCaseCur}});
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/v2/account/deposit/address",
+      {{"currency", lowerCaseCur}});
 
   string address;
   std::string_view tag;
@@ -270,7 +271,7 @@ ClosedOrderVector HuobiPrivate::queryClosedOrders(const OrdersConstraints& close
   const std::string_view closedOrdersEndpoint =
       closedOrdersConstraints.isMarketDefined() ? "/v1/order/orders" : "/v1/order/history";
 
-  const auto result = PrivateQuery<schema::huobi::V1Orders>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  const auto result = PrivateQuery<schema::huobi::V1Orders>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                             closedOrdersEndpoint, std::move(params));
 
   MarketSet markets;
@@ -326,7 +327,7 @@ OpenedOrderVector HuobiPrivate::queryOpenedOrders(const OrdersConstraints& opene
     }
   }
 
-  auto result = PrivateQuery<schema::huobi::V1OrderOpenOrders>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  auto result = PrivateQuery<schema::huobi::V1OrderOpenOrders>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                                "/v1/order/openOrders", std::move(params));
   OpenedOrderVector openedOrders;
 
@@ -412,7 +413,7 @@ DepositsSet HuobiPrivate::queryRecentDeposits(const DepositsConstraints& deposit
   options.emplace_back("type", "deposit");
 
   const auto result = PrivateQuery<schema::huobi::V1QueryDepositWithdraw>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/v1/query/deposit-withdraw", std::move(options));
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/v1/query/deposit-withdraw", std::move(options));
   for (const auto& depositDetail : result.data) {
     Deposit::Status status = DepositStatusFromStatusStr(depositDetail.state);
 
@@ -539,7 +540,7 @@ CurlPostData CreateOptionsFromWithdrawConstraints(const WithdrawsConstraints& wi
 WithdrawsSet HuobiPrivate::queryRecentWithdraws(const WithdrawsConstraints& withdrawsConstraints) {
   Withdraws withdraws;
   const auto result = PrivateQuery<schema::huobi::V1QueryDepositWithdraw>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/v1/query/deposit-withdraw",
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/v1/query/deposit-withdraw",
       CreateOptionsFromWithdrawConstraints(withdrawsConstraints));
   for (const auto& withdrawDetail : result.data) {
     if (withdrawDetail.currency.size() > CurrencyCode::kMaxLen) {
@@ -578,7 +579,7 @@ int HuobiPrivate::batchCancel(const OrdersConstraints::OrderIdSet& orderIdSet) {
     csvOrderIdValues.push_back(CurlPostData::kArrayElemSepChar);
     static constexpr int kMaxNbOrdersPerRequest = 50;
     if (++nbOrderIdPerRequest == kMaxNbOrdersPerRequest) {
-      PrivateQuery<schema::huobi::V1OrderOrdersBatchCancel>(_curlHandle, _apiKey, HttpRequestType::kPost,
+      PrivateQuery<schema::huobi::V1OrderOrdersBatchCancel>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                             kBatchCancelEndpoint, {{"order-ids", csvOrderIdValues}});
       csvOrderIdValues.clear();
       nbOrderIdPerRequest = 0;
@@ -586,7 +587,7 @@ int HuobiPrivate::batchCancel(const OrdersConstraints::OrderIdSet& orderIdSet) {
   }
 
   if (nbOrderIdPerRequest > 0) {
-    PrivateQuery<schema::huobi::V1OrderOrdersBatchCancel>(_curlHandle, _apiKey, HttpRequestType::kPost,
+    PrivateQuery<schema::huobi::V1OrderOrdersBatchCancel>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                           kBatchCancelEndpoint, {{"order-ids", csvOrderIdValues}});
   }
   return orderIdSet.size();
@@ -639,7 +640,7 @@ PlaceOrderInfo HuobiPrivate::placeOrder(MonetaryAmount from, MonetaryAmount volu
   placePostData.emplace_back("symbol", lowerCaseMarket);
   placePostData.emplace_back("type", type);
 
-  auto result = PrivateQuery<schema::huobi::V1OrderOrdersPlace>(_curlHandle, _apiKey, HttpRequestType::kPost,
+  auto result = PrivateQuery<schema::huobi::V1OrderOrdersPlace>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                                 "/v1/order/orders/place", std::move(placePostData));
 
   if (result.data.empty()) {
@@ -660,7 +661,8 @@ void HuobiPrivate::cancelOrderProcess(OrderIdView id) {
   it = std::ranges::copy(id, it).out;
   it = std::ranges::copy(kSubmitCancelSuffix, it).out;
 
-  PrivateQuery<schema::huobi::V1OrderOrdersSubmitCancel>(_curlHandle, _apiKey, HttpRequestType::kPost, endpoint);
+  PrivateQuery<schema::huobi::V1OrderOrdersSubmitCancel>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
+                                                         endpoint);
 }
 
 OrderInfo HuobiPrivate::cancelOrder(OrderIdView orderId, const TradeContext& tradeContext) {
@@ -677,7 +679,7 @@ OrderInfo HuobiPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext&
   endpoint.append(orderId);
 
   const auto result =
-      PrivateQuery<schema::huobi::V1OrderOrdersDetail>(_curlHandle, _apiKey, HttpRequestType::kGet, endpoint);
+      PrivateQuery<schema::huobi::V1OrderOrdersDetail>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet, endpoint);
 
   // Warning: I think Huobi's API has a typo with the 'filled' transformed into 'field' (even documentation is
   // ambiguous on this point). Let's handle both just to be sure.
@@ -716,7 +718,8 @@ InitiatedWithdrawInfo HuobiPrivate::launchWithdraw(MonetaryAmount grossAmount, W
   HuobiPublic& huobiPublic = dynamic_cast<HuobiPublic&>(_exchangePublic);
 
   const auto resultWithdrawAddress = PrivateQuery<schema::huobi::V1QueryWithdrawAddress>(
-      _curlHandle, _apiKey, HttpRequestType::kGet, "/v2/account/withdraw/address", {{"currency", lowerCaseCur}});
+      _curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/v2/account/withdraw/address",
+      {{"currency", lowerCaseCur}});
   std::string_view huobiWithdrawAddressName;
   for (const auto& withdrawAddress : resultWithdrawAddress.data) {
     if (withdrawAddress.address == destinationWallet.address() &&
@@ -761,7 +764,7 @@ InitiatedWithdrawInfo HuobiPrivate::launchWithdraw(MonetaryAmount grossAmount, W
   withdrawPostData.emplace_back("fee", withdrawFee.amountStr());
 
   const auto result = PrivateQuery<schema::huobi::V1DwWithdrawApiCreate>(
-      _curlHandle, _apiKey, HttpRequestType::kPost, "/v1/dw/withdraw/api/create", std::move(withdrawPostData));
+      _curlHandle, _apiKey, _signer, HttpRequestType::kPost, "/v1/dw/withdraw/api/create", std::move(withdrawPostData));
   if (result.data == 0) {
     throw exception("Unexpected response from withdraw create for {}", huobiPublic.name());
   }
@@ -769,8 +772,8 @@ InitiatedWithdrawInfo HuobiPrivate::launchWithdraw(MonetaryAmount grossAmount, W
 }
 
 int64_t HuobiPrivate::AccountIdFunc::operator()() {
-  const auto result = PrivateQuery<schema::huobi::V1AccountAccounts>(_curlHandle, _apiKey, HttpRequestType::kGet,
-                                                                     "/v1/account/accounts");
+  const auto result = PrivateQuery<schema::huobi::V1AccountAccounts>(_curlHandle, _apiKey, _signer,
+                                                                     HttpRequestType::kGet, "/v1/account/accounts");
   const auto it =
       std::ranges::find_if(result.data, [](const auto& accDetails) { return accDetails.state == "working"; });
   if (it != result.data.end()) {
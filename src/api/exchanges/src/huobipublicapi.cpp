@@ -5,6 +5,7 @@
 #include <amc/isdetected.hpp>
 #include <array>
 #include <cstdint>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <string_view>
@@ -12,7 +13,7 @@
 #include <utility>
 
 #include "apiquerytypeenum.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_json.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
@@ -35,6 +36,7 @@
 #include "huobi-schema.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetary-amount-vector.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
@@ -51,6 +53,9 @@
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kTradableCurrenciesSection = "tradableCurrencies";
+constexpr std::string_view kMarketsSection = "markets";
+
 constexpr std::string_view kHealthCheckBaseUrl[] = {"https://status.huobigroup.com"};
 
 template <class T>
@@ -94,26 +99,27 @@ HuobiPublic::HuobiPublic(const CoincenterInfo& config, FiatConverter& fiatConver
                                  .setMinDurationBetweenQueries(exchangeConfig().query.publicAPIRate.duration)
                                  .build(),
                              config.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _curlHandle),
-      _marketsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::markets), _cachedResultVault),
-          _curlHandle, exchangeConfig().asset),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          _marketsCache, _curlHandle),
-      _orderbookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          _curlHandle),
-      _tradedVolumeCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume), _cachedResultVault),
-          _curlHandle),
-      _tickerCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::lastPrice), _cachedResultVault),
-          _curlHandle) {}
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), _curlHandle),
+      _marketsCache(cachedResultOptions(QueryType::markets), _curlHandle, exchangeConfig().asset),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), _marketsCache, _curlHandle),
+      _orderbookCache(cachedResultOptions(QueryType::orderBook), _curlHandle),
+      _tradedVolumeCache(cachedResultOptions(QueryType::tradedVolume), _curlHandle),
+      _tickerCache(cachedResultOptions(QueryType::lastPrice), _curlHandle) {
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.load(kMarketsSection, _marketsCache);
+  });
+}
+
+void HuobiPublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.store(kMarketsSection, _marketsCache);
+  });
+}
 
 bool HuobiPublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto strData = _healthCheckCurlHandle.query("/api/v2/summary.json", CurlOptions(HttpRequestType::kGet));
   schema::huobi::V2SystemStatus networkInfo;
   // NOLINTNEXTLINE(readability-implicit-bool-conversion)
@@ -145,7 +151,8 @@ HuobiPublic::WithdrawParams HuobiPublic::getWithdrawParams(CurrencyCode cur) {
   WithdrawParams withdrawParams;
   const auto& assetConfig = _coincenterInfo.exchangeConfig(exchangeNameEnum()).asset;
   const auto currencyChainPicker = CreateCurrencyChainPicker(assetConfig);
-  for (const auto& curDetail : _tradableCurrenciesCache.get().data) {
+  const auto pTradableCurrencies = _tradableCurrenciesCache.get();
+  for (const auto& curDetail : pTradableCurrencies->data) {
     if (cur == CurrencyCode(_coincenterInfo.standardizeCurrencyCode(curDetail.currency))) {
       for (const auto& chainDetail : curDetail.chains) {
         if (currencyChainPicker.shouldDiscardChain(curDetail.chains, cur, chainDetail)) {
@@ -169,7 +176,8 @@ CurrencyExchangeFlatSet HuobiPublic::queryTradableCurrencies() {
   CurrencyExchangeVector currencies;
   const auto& assetConfig = _coincenterInfo.exchangeConfig(exchangeNameEnum()).asset;
   const auto currencyChainPicker = CreateCurrencyChainPicker(assetConfig);
-  for (const auto& curDetail : _tradableCurrenciesCache.get().data) {
+  const auto pTradableCurrencies = _tradableCurrenciesCache.get();
+  for (const auto& curDetail : pTradableCurrencies->data) {
     std::string_view statusStr = curDetail.instStatus;
     std::string_view curStr = curDetail.currency;
     if (statusStr != "normal") {
@@ -271,7 +279,8 @@ MonetaryAmountByCurrencySet HuobiPublic::queryWithdrawalFees() {
   MonetaryAmountVector fees;
   const auto& assetConfig = _coincenterInfo.exchangeConfig(exchangeNameEnum()).asset;
   const auto currencyChainPicker = CreateCurrencyChainPicker(assetConfig);
-  for (const auto& curDetail : _tradableCurrenciesCache.get().data) {
+  const auto pTradableCurrencies = _tradableCurrenciesCache.get();
+  for (const auto& curDetail : pTradableCurrencies->data) {
     std::string_view curStr = curDetail.currency;
     CurrencyCode cur(_coincenterInfo.standardizeCurrencyCode(curStr));
     bool foundChainWithSameName = false;
@@ -306,7 +315,8 @@ MonetaryAmountByCurrencySet HuobiPublic::queryWithdrawalFees() {
 }
 
 std::optional<MonetaryAmount> HuobiPublic::queryWithdrawalFee(CurrencyCode currencyCode) {
-  for (const auto& curDetail : _tradableCurrenciesCache.get().data) {
+  const auto pTradableCurrencies = _tradableCurrenciesCache.get();
+  for (const auto& curDetail : pTradableCurrencies->data) {
     std::string_view curStr = curDetail.currency;
     CurrencyCode cur(_coincenterInfo.standardizeCurrencyCode(curStr));
     if (cur != currencyCode) {
@@ -324,7 +334,8 @@ std::optional<MonetaryAmount> HuobiPublic::queryWithdrawalFee(CurrencyCode curre
 
 MarketOrderBookMap HuobiPublic::AllOrderBooksFunc::operator()(int depth) {
   MarketOrderBookMap ret;
-  const auto& [markets, marketInfoMap] = _marketsCache.get();
+  const auto pMarkets = _marketsCache.get();
+  const auto& [markets, marketInfoMap] = *pMarkets;
   using HuobiAssetPairToStdMarketMap = std::unordered_map<string, Market>;
   HuobiAssetPairToStdMarketMap huobiAssetPairToStdMarketMap;
   huobiAssetPairToStdMarketMap.reserve(markets.size());
@@ -396,7 +407,8 @@ MarketOrderBook HuobiPublic::OrderBookFunc::operator()(Market mk, int depth) {
 }
 
 MonetaryAmount HuobiPublic::sanitizePrice(Market mk, MonetaryAmount pri) {
-  const MarketsFunc::MarketInfoMap& marketInfoMap = _marketsCache.get().second;
+  const auto pMarkets = _marketsCache.get();
+  const MarketsFunc::MarketInfoMap& marketInfoMap = pMarkets->second;
   MonetaryAmount sanitizedPri = pri;
   auto marketIt = marketInfoMap.find(mk);
   if (marketIt == marketInfoMap.end()) {
@@ -418,7 +430,8 @@ MonetaryAmount HuobiPublic::sanitizePrice(Market mk, MonetaryAmount pri) {
 
 MonetaryAmount HuobiPublic::sanitizeVolume(Market mk, CurrencyCode fromCurrencyCode, MonetaryAmount vol,
                                            MonetaryAmount sanitizedPrice, bool isTakerOrder) {
-  const MarketsFunc::MarketInfoMap& marketInfoMap = _marketsCache.get().second;
+  const auto pMarkets = _marketsCache.get();
+  const MarketsFunc::MarketInfoMap& marketInfoMap = pMarkets->second;
   auto marketIt = marketInfoMap.find(mk);
   if (marketIt == marketInfoMap.end()) {
     log::error("Unable to find market info for {} in sanitize volume", mk);
@@ -466,6 +479,7 @@ PublicTradeVector HuobiPublic::queryLastTrades(Market mk, int nbTrades) {
     nbTrades = kNbMaxLastTrades;
   }
 
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = PublicQuery<schema::huobi::MarketHistoryTrade>(
       _curlHandle, "/market/history/trade", {{"symbol", mk.assetsPairStrLower()}, {"size", nbTrades}});
 
@@ -1,6 +1,7 @@
 #include "krakenprivateapi.hpp"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <optional>
@@ -65,8 +66,8 @@ namespace {
 enum class KrakenErrorEnum : int8_t { kExpiredOrder, kUnknownWithdrawKey, kUnknownError, kNoError };
 
 template <class T, class CurlPostDataT = CurlPostData>
-auto PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, std::string_view method,
-                  CurlPostDataT&& curlPostData = CurlPostData()) {
+auto PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha512Signer& signer,
+                  std::string_view method, CurlPostDataT&& curlPostData = CurlPostData()) {
   CurlOptions opts(HttpRequestType::kPost, std::forward<CurlPostDataT>(curlPostData));
   opts.mutableHttpHeaders().emplace_back("API-Key", apiKey.key());
 
@@ -99,7 +100,7 @@ auto PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, std::string_view
             }
             return RequestRetry::Status::kResponseError;
           },
-          [&apiKey, method](CurlOptions& curlOptions) {
+          [&signer, method](CurlOptions& curlOptions) {
             Nonce noncePostData = Nonce_TimeSinceEpochInMs();
             curlOptions.mutablePostData().set("nonce", noncePostData);
 
@@ -109,15 +110,13 @@ auto PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, std::string_view
             // concatenate path and nonce_postdata (path + ComputeSha256(nonce + postdata))
             auto sha256 = ssl::Sha256(noncePostData);
 
-            string path;
-            path.reserve(KrakenPublic::kVersion.size() + method.size() + sha256.size());
-            path.append(KrakenPublic::kVersion).append(method).append(sha256.data(), sha256.data() + sha256.size());
+            const std::array<std::string_view, 3> path{KrakenPublic::kVersion, method,
+                                                       std::string_view(sha256.data(), sha256.size())};
 
             static constexpr std::string_view kSignatureKey = "API-Sign";
 
-            // and compute HMAC
-            curlOptions.mutableHttpHeaders().set_back(kSignatureKey,
-                                                      B64Encode(ssl::Sha512Bin(path, B64Decode(apiKey.privateKey()))));
+            // and compute HMAC, without building the path
+            curlOptions.mutableHttpHeaders().set_back(kSignatureKey, B64Encode(signer.sign(path)));
           }),
       err);
 }
@@ -127,12 +126,12 @@ KrakenPrivate::KrakenPrivate(const CoincenterInfo& config, KrakenPublic& krakenP
     : ExchangePrivate(config, krakenPublic, apiKey),
       _curlHandle(KrakenPublic::kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   config.getRunMode()),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, krakenPublic) {}
+      _signer(B64Decode(apiKey.privateKey())),
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _signer,
+                           krakenPublic) {}
 
 bool KrakenPrivate::validateApiKey() {
-  return PrivateQuery<schema::kraken::PrivateBalance>(_curlHandle, _apiKey, "/private/Balance").second ==
+  return PrivateQuery<schema::kraken::PrivateBalance>(_curlHandle, _apiKey, _signer, "/private/Balance").second ==
          KrakenErrorEnum::kNoError;
 }
 
@@ -140,7 +139,7 @@ CurrencyExchangeFlatSet KrakenPrivate::queryTradableCurrencies() { return _excha
 
 BalancePortfolio KrakenPrivate::queryAccountBalance(const BalanceOptions& balanceOptions) {
   BalancePortfolio balancePortfolio;
-  auto [res, err] = PrivateQuery<schema::kraken::PrivateBalance>(_curlHandle, _apiKey, "/private/Balance");
+  auto [res, err] = PrivateQuery<schema::kraken::PrivateBalance>(_curlHandle, _apiKey, _signer, "/private/Balance");
   // Kraken returns an empty array in case of account with no balance at all
   MonetaryAmountVector balanceAmounts;
   balanceAmounts.reserve(static_cast<MonetaryAmountVector::size_type>(res.result.size()));
@@ -199,7 +198,7 @@ BalancePortfolio KrakenPrivate::queryAccountBalance(const BalanceOptions& balanc
 Wallet KrakenPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   CurrencyExchange krakenCurrency = _exchangePublic.convertStdCurrencyToCurrencyExchange(currencyCode);
   auto [depositMethods, errDepositMethods] = PrivateQuery<schema::kraken::DepositMethods>(
-      _curlHandle, _apiKey, "/private/DepositMethods", {{"asset", krakenCurrency.altStr()}});
+      _curlHandle, _apiKey, _signer, "/private/DepositMethods", {{"asset", krakenCurrency.altStr()}});
   const CoincenterInfo& coincenterInfo = _exchangePublic.coincenterInfo();
   const bool doCheckWallet =
       coincenterInfo.exchangeConfig(_exchangePublic.exchangeNameEnum()).withdraw.validateDepositAddressesInFile;
@@ -211,13 +210,13 @@ Wallet KrakenPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
 
   for (const auto& depositMethod : depositMethods.result) {
     auto [res, err] = PrivateQuery<schema::kraken::DepositAddresses>(
-        _curlHandle, _apiKey, "/private/DepositAddresses",
+        _curlHandle, _apiKey, _signer, "/private/DepositAddresses",
         {{"asset", krakenCurrency.altStr()}, {"method", depositMethod.method}});
     if (res.result.empty()) {
       // This means user has not created a wallet yet, but it's possible to do it via DepositMethods query above.
       log::warn("No deposit address found on {} for {}, creating a new one", eName, currencyCode);
       std::tie(res, err) = PrivateQuery<schema::kraken::DepositAddresses>(
-          _curlHandle, _apiKey, "/private/DepositAddresses",
+          _curlHandle, _apiKey, _signer, "/private/DepositAddresses",
           {{"asset", krakenCurrency.altStr()}, {"method", depositMethod.method}, {"new", "true"}});
       if (res.result.empty()) {
         log::error("Cannot create a new deposit address on {} for {}", eName, currencyCode);
@@ -305,8 +304,8 @@ ClosedOrderVector KrakenPrivate::queryClosedOrders(const OrdersConstraints& clos
        nbOrdersRetrieved == kLimitNbOrdersPerPage && page < kNbMaxPagesToRetrieve; ++page) {
     params.set("ofs", page);
 
-    auto [data, err] =
-        PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, "/private/ClosedOrders", params);
+    auto [data, err] = PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, _signer,
+                                                                          "/private/ClosedOrders", params);
 
     nbOrdersRetrieved = 0;
 
@@ -361,8 +360,8 @@ ClosedOrderVector KrakenPrivate::queryClosedOrders(const OrdersConstraints& clos
 }
 
 OpenedOrderVector KrakenPrivate::queryOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
-  auto [res, err] = PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, "/private/OpenOrders",
-                                                                       {{"trades", "true"}});
+  auto [res, err] = PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, _signer,
+                                                                       "/private/OpenOrders", {{"trades", "true"}});
   OpenedOrderVector openedOrders;
   MarketSet markets;
 
@@ -408,7 +407,8 @@ OpenedOrderVector KrakenPrivate::queryOpenedOrders(const OrdersConstraints& open
 
 int KrakenPrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
   if (openedOrdersConstraints.noConstraints()) {
-    auto [res, err] = PrivateQuery<schema::kraken::CancelAllOrders>(_curlHandle, _apiKey, "/private/CancelAll");
+    auto [res, err] =
+        PrivateQuery<schema::kraken::CancelAllOrders>(_curlHandle, _apiKey, _signer, "/private/CancelAll");
     return res.result.count;
   }
   OpenedOrderVector openedOrders = queryOpenedOrders(openedOrdersConstraints);
@@ -437,7 +437,7 @@ DepositsSet KrakenPrivate::queryRecentDeposits(const DepositsConstraints& deposi
     options.emplace_back("asset", depositsConstraints.currencyCode().str());
   }
   auto [res, err] =
-      PrivateQuery<schema::kraken::DepositStatus>(_curlHandle, _apiKey, "/private/DepositStatus", options);
+      PrivateQuery<schema::kraken::DepositStatus>(_curlHandle, _apiKey, _signer, "/private/DepositStatus", options);
   for (auto& trx : res.result) {
     Deposit::Status status = DepositStatusFromStatus(trx.status);
 
@@ -493,8 +493,9 @@ CurlPostData CreateOptionsFromWithdrawConstraints(const WithdrawsConstraints& wi
 
 WithdrawsSet KrakenPrivate::queryRecentWithdraws(const WithdrawsConstraints& withdrawsConstraints) {
   Withdraws withdraws;
-  auto [res, err] = PrivateQuery<schema::kraken::WithdrawStatus>(
-      _curlHandle, _apiKey, "/private/WithdrawStatus", CreateOptionsFromWithdrawConstraints(withdrawsConstraints));
+  auto [res, err] =
+      PrivateQuery<schema::kraken::WithdrawStatus>(_curlHandle, _apiKey, _signer, "/private/WithdrawStatus",
+                                                   CreateOptionsFromWithdrawConstraints(withdrawsConstraints));
   for (auto& trx : res.result) {
     if (trx.asset.size() > CurrencyCode::kMaxLen) {
       log::warn("Currency code {} is too long, skipping", trx.asset);
@@ -539,7 +540,7 @@ PlaceOrderInfo KrakenPrivate::placeOrder([[maybe_unused]] MonetaryAmount from, M
   Market krakenMarket(krakenCurrencyBase.altCode(), krakenCurrencyQuote.altCode());
   const std::string_view orderType = fromCurrencyCode == mk.base() ? "sell" : "buy";
 
-  auto volAndPriNbDecimals = krakenPublic._marketsCache.get().second.find(mk)->second.volAndPriNbDecimals;
+  auto volAndPriNbDecimals = krakenPublic._marketsCache.get()->second.find(mk)->second.volAndPriNbDecimals;
 
   price.truncate(volAndPriNbDecimals.priNbDecimals);
 
@@ -578,8 +579,8 @@ PlaceOrderInfo KrakenPrivate::placeOrder([[maybe_unused]] MonetaryAmount from, M
     placePostData.emplace_back("validate", "true");  // validate inputs only. do not submit order (optional)
   }
 
-  auto [placeOrderRes, err] =
-      PrivateQuery<schema::kraken::AddOrder>(_curlHandle, _apiKey, "/private/AddOrder", std::move(placePostData));
+  auto [placeOrderRes, err] = PrivateQuery<schema::kraken::AddOrder>(_curlHandle, _apiKey, _signer, "/private/AddOrder",
+                                                                     std::move(placePostData));
   // {"error":[],"result":{"descr":{"order":"buy 24.69898116 XRPETH @ limit 0.0003239"},"txid":["OWBA44-TQZQ7-EEYSXA"]}}
   if (isSimulation) {
     // In simulation mode, there is no txid returned. If we arrived here (after CollectResults) we assume that the call
@@ -618,8 +619,8 @@ OrderInfo KrakenPrivate::cancelOrder(OrderIdView orderId, const TradeContext& tr
 }
 
 void KrakenPrivate::cancelOrderProcess(OrderIdView orderId) {
-  auto [response, err] =
-      PrivateQuery<schema::kraken::CancelOrder>(_curlHandle, _apiKey, "/private/CancelOrder", {{"txid", orderId}});
+  auto [response, err] = PrivateQuery<schema::kraken::CancelOrder>(_curlHandle, _apiKey, _signer,
+                                                                   "/private/CancelOrder", {{"txid", orderId}});
   if (err == KrakenErrorEnum::kExpiredOrder) {
     log::warn("{} is unable to find order {} - it has probably expired or been matched", exchangeName(), orderId);
   }
@@ -672,16 +673,16 @@ schema::kraken::OpenedOrClosedOrders KrakenPrivate::queryOrdersData(int64_t user
   const bool isOpenedFirst = queryOrder == QueryOrder::kOpenedThenClosed;
   const std::string_view firstQueryFullName = isOpenedFirst ? "/private/OpenOrders" : "/private/ClosedOrders";
   do {
-    auto data =
-        PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, firstQueryFullName, ordersPostData)
-            .first;
+    auto data = PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, _signer, firstQueryFullName,
+                                                                   ordersPostData)
+                    .first;
     const auto& firstOrders = isOpenedFirst ? data.result.open : data.result.closed;
     bool foundOrder = firstOrders.contains(orderId);
     if (!foundOrder) {
       const std::string_view secondQueryFullName = isOpenedFirst ? "/private/ClosedOrders" : "/private/OpenOrders";
-      auto secondData =
-          PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, secondQueryFullName, ordersPostData)
-              .first;
+      auto secondData = PrivateQuery<schema::kraken::OpenedOrClosedOrders>(_curlHandle, _apiKey, _signer,
+                                                                           secondQueryFullName, ordersPostData)
+                            .first;
       if (isOpenedFirst) {
         data.result.closed = std::move(secondData.result.closed);
       } else {
@@ -720,7 +721,7 @@ InitiatedWithdrawInfo KrakenPrivate::launchWithdraw(MonetaryAmount grossAmount,
   CurrencyExchange krakenCurrency = _exchangePublic.convertStdCurrencyToCurrencyExchange(currencyCode);
   string krakenWalletKey = KrakenWalletKeyName(destinationWallet);
 
-  auto [withdrawData, err] = PrivateQuery<schema::kraken::Withdraw>(_curlHandle, _apiKey, "/private/Withdraw",
+  auto [withdrawData, err] = PrivateQuery<schema::kraken::Withdraw>(_curlHandle, _apiKey, _signer, "/private/Withdraw",
                                                                     {{"amount", grossAmount.amountStr()},
                                                                      {"asset", krakenCurrency.altStr()},
                                                                      {"key", krakenWalletKey},
@@ -3,13 +3,15 @@
 #include <algorithm>
 #include <amc/isdetected.hpp>
 #include <cstdint>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
 
 #include "apiquerytypeenum.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
@@ -28,19 +30,26 @@
 #include "fiatconverter.hpp"
 #include "httprequesttype.hpp"
 #include "kraken-schema.hpp"
+#include "market-order-book-vector.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetaryamount.hpp"
 #include "order-book-line.hpp"
 #include "permanentcurloptions.hpp"
 #include "public-trade-vector.hpp"
+#include "read-json.hpp"
 #include "request-retry.hpp"
 #include "timedef.hpp"
 #include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
 
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kTradableCurrenciesSection = "tradableCurrencies";
+constexpr std::string_view kMarketsSection = "markets";
+
 template <class T>
 T PublicQuery(CurlHandle& curlHandle, std::string_view method, CurlPostData&& postData = CurlPostData()) {
   RequestRetry requestRetry(curlHandle, CurlOptions(HttpRequestType::kGet, std::move(postData)));
@@ -97,24 +106,32 @@ bool CheckCurrencyExchange(std::string_view krakenEntryCurrencyCode, std::string
 KrakenPublic::KrakenPublic(const CoincenterInfo& config, FiatConverter& fiatConverter, CommonAPI& commonAPI)
     : ExchangePublic(ExchangeNameEnum::kraken, fiatConverter, commonAPI, config),
       _curlHandle(kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(), config.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          config, commonAPI, _curlHandle, exchangeConfig().asset),
-      _marketsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::markets), _cachedResultVault),
-          _tradableCurrenciesCache, config, _curlHandle, exchangeConfig().asset),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          _tradableCurrenciesCache, _marketsCache, config, _curlHandle),
-      _orderBookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          _tradableCurrenciesCache, _marketsCache, _curlHandle),
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), config, commonAPI, _curlHandle,
+                               exchangeConfig().asset),
+      _marketsCache(cachedResultOptions(QueryType::markets), _tradableCurrenciesCache, config, _curlHandle,
+                    exchangeConfig().asset),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), _tradableCurrenciesCache, _marketsCache,
+                          config, _curlHandle),
+      _orderBookCache(cachedResultOptions(QueryType::orderBook), _tradableCurrenciesCache, _marketsCache, _curlHandle),
       _tickerCache(CachedResultOptions(std::min(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume),
                                                 exchangeConfig().query.getUpdateFrequency(QueryType::lastPrice)),
-                                       _cachedResultVault),
-                   _tradableCurrenciesCache, _curlHandle) {}
+                                       Duration{}, _cachedResultVault, _publicRequestsMutex),
+                   _tradableCurrenciesCache, _curlHandle) {
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.load(kMarketsSection, _marketsCache);
+  });
+}
+
+void KrakenPublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.store(kMarketsSection, _marketsCache);
+  });
+}
 
 bool KrakenPublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   const auto result = PublicQuery<schema::kraken::SystemStatus>(_curlHandle, "/public/SystemStatus");
   log::info("{} status: {}", name(), result.result.status);
   return result.result.status == "online";
@@ -154,7 +171,8 @@ std::pair<MarketSet, KrakenPublic::MarketsFunc::MarketInfoMap> KrakenPublic::Mar
   ret.first.reserve(static_cast<MarketSet::size_type>(result.result.size()));
   ret.second.reserve(result.result.size());
   const CurrencyCodeSet& excludedCurrencies = _assetConfig.allExclude;
-  const CurrencyExchangeFlatSet& currencies = _tradableCurrenciesCache.get();
+  const auto pCurrencies = _tradableCurrenciesCache.get();
+  const CurrencyExchangeFlatSet& currencies = *pCurrencies;
   for (const auto& [key, value] : result.result) {
     if (value.ordermin.isDefault()) {
       log::debug("Discard market {} as it does not contain min order information", key);
@@ -191,8 +209,10 @@ std::pair<MarketSet, KrakenPublic::MarketsFunc::MarketInfoMap> KrakenPublic::Mar
 }
 
 MarketOrderBookMap KrakenPublic::AllOrderBooksFunc::operator()(int depth) {
-  const CurrencyExchangeFlatSet& krakenCurrencies = _tradableCurrenciesCache.get();
-  const auto& [markets, marketInfoMap] = _marketsCache.get();
+  const auto pKrakenCurrencies = _tradableCurrenciesCache.get();
+  const auto pMarkets = _marketsCache.get();
+  const CurrencyExchangeFlatSet& krakenCurrencies = *pKrakenCurrencies;
+  const auto& [markets, marketInfoMap] = *pMarkets;
 
   using KrakenAssetPairToStdMarketMap = std::unordered_map<string, Market>;
   KrakenAssetPairToStdMarketMap krakenAssetPairToStdMarketMap;
@@ -253,8 +273,11 @@ MarketOrderBookMap KrakenPublic::AllOrderBooksFunc::operator()(int depth) {
   return ret;
 }
 
-MarketOrderBook KrakenPublic::OrderBookFunc::operator()(Market mk, int count) {
-  CurrencyExchangeFlatSet krakenCurrencies = _tradableCurrenciesCache.get();
+namespace {
+
+constexpr std::string_view kDepthEndpoint = "/public/Depth";
+
+string KrakenAssetPair(const CurrencyExchangeFlatSet& krakenCurrencies, Market mk) {
   auto lb = krakenCurrencies.find(mk.base());
   if (lb == krakenCurrencies.end()) {
     throw exception("Cannot find {} in Kraken currencies", mk.base());
@@ -267,11 +290,13 @@ MarketOrderBook KrakenPublic::OrderBookFunc::operator()(Market mk, int count) {
   CurrencyExchange krakenCurrencyExchangeQuote = *lb;
   string krakenAssetPair = krakenCurrencyExchangeBase.altStr();
   krakenAssetPair.append(krakenCurrencyExchangeQuote.altStr());
+  return krakenAssetPair;
+}
 
+MarketOrderBook CreateOrderBook(Market mk, const schema::kraken::Depth& result, const string& krakenAssetPair,
+                                VolAndPriNbDecimals volAndPriNbDecimals) {
   MarketOrderBookLines orderBookLines;
 
-  const auto result =
-      PublicQuery<schema::kraken::Depth>(_curlHandle, "/public/Depth", {{"pair", krakenAssetPair}, {"count", count}});
   const auto dataIt = result.result.find(krakenAssetPair);
   const auto nowTime = Clock::now();
   if (dataIt != result.result.end()) {
@@ -289,10 +314,44 @@ MarketOrderBook KrakenPublic::OrderBookFunc::operator()(Market mk, int count) {
     }
   }
 
-  const auto volAndPriNbDecimals = _marketsCache.get().second.find(mk)->second.volAndPriNbDecimals;
   return MarketOrderBook(nowTime, mk, orderBookLines, volAndPriNbDecimals);
 }
 
+}  // namespace
+
+MarketOrderBookVector KrakenPublic::queryOrderBooks(std::span<const Market> markets, int depth) {
+  // Full order books can only be retrieved one market at a time - but their requests can be in flight at the same time
+  return QueryOrderBooksWithCache(_orderBookCache, markets, depth, [this, depth](std::span<const Market> mks) {
+    const auto pKrakenCurrencies = _tradableCurrenciesCache.get();
+    const auto pMarkets = _marketsCache.get();
+    const CurrencyExchangeFlatSet& krakenCurrencies = *pKrakenCurrencies;
+    const auto& marketInfoMap = pMarkets->second;
+    return queryOrderBooksConcurrently(
+        _curlHandle, mks, kDepthEndpoint,
+        [&krakenCurrencies, depth](Market mk) {
+          return CurlOptions(HttpRequestType::kGet,
+                             CurlPostData{{"pair", KrakenAssetPair(krakenCurrencies, mk)}, {"count", depth}});
+        },
+        [&krakenCurrencies, &marketInfoMap](Market mk, std::string_view response) {
+          const auto result = ReadJsonOrThrow<schema::kraken::Depth, kPartialJsonOptions>(response);
+          if (!result.error.empty()) {
+            throw exception("Kraken error(s): {}", result.error.front());
+          }
+          return CreateOrderBook(mk, result, KrakenAssetPair(krakenCurrencies, mk),
+                                 marketInfoMap.find(mk)->second.volAndPriNbDecimals);
+        });
+  });
+}
+
+MarketOrderBook KrakenPublic::OrderBookFunc::operator()(Market mk, int count) {
+  const string krakenAssetPair = KrakenAssetPair(*_tradableCurrenciesCache.get(), mk);
+
+  const auto result =
+      PublicQuery<schema::kraken::Depth>(_curlHandle, kDepthEndpoint, {{"pair", krakenAssetPair}, {"count", count}});
+
+  return CreateOrderBook(mk, result, krakenAssetPair, _marketsCache.get()->second.find(mk)->second.volAndPriNbDecimals);
+}
+
 namespace {
 Market GetKrakenMarketOrDefault(const CurrencyExchangeFlatSet& currencies, Market mk) {
   const auto krakenBaseIt = currencies.find(mk.base());
@@ -305,7 +364,7 @@ Market GetKrakenMarketOrDefault(const CurrencyExchangeFlatSet& currencies, Marke
 }  // namespace
 
 KrakenPublic::TickerFunc::Last24hTradedVolumeAndLatestPricePair KrakenPublic::TickerFunc::operator()(Market mk) {
-  const Market krakenMarket = GetKrakenMarketOrDefault(_tradableCurrenciesCache.get(), mk);
+  const Market krakenMarket = GetKrakenMarketOrDefault(*_tradableCurrenciesCache.get(), mk);
 
   if (krakenMarket.isDefined()) {
     const auto krakenPair = krakenMarket.assetsPairStrUpper();
@@ -322,9 +381,10 @@ KrakenPublic::TickerFunc::Last24hTradedVolumeAndLatestPricePair KrakenPublic::Ti
 PublicTradeVector KrakenPublic::queryLastTrades(Market mk, int nbLastTrades) {
   PublicTradeVector ret;
 
-  const Market krakenMarket = GetKrakenMarketOrDefault(_tradableCurrenciesCache.get(), mk);
+  const Market krakenMarket = GetKrakenMarketOrDefault(*_tradableCurrenciesCache.get(), mk);
   if (krakenMarket.isDefined()) {
     const auto krakenPair = krakenMarket.assetsPairStrUpper();
+    std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
     const auto result = PublicQuery<schema::kraken::Trades>(_curlHandle, "/public/Trades",
                                                             {{"pair", krakenPair}, {"count", nbLastTrades}});
 
@@ -71,8 +71,8 @@ auto ComputeBaseStrToSign(HttpRequestType requestType, std::string_view method,
   return std::ranges::copy(method, it).out;
 }
 
-CurlOptions CreateCurlOptions(const APIKey& apiKey, HttpRequestType requestType, std::string_view method,
-                              string& strToSign, std::string_view nonceTimeStr,
+CurlOptions CreateCurlOptions(const APIKey& apiKey, const ssl::HmacSha256Signer& signer, HttpRequestType requestType,
+                              std::string_view method, string& strToSign, std::string_view nonceTimeStr,
                               CurlPostData&& postData = CurlPostData()) {
   CurlOptions::PostDataFormat postDataFormat = CurlOptions::PostDataFormat::kString;
   if (postData.empty()) {
@@ -95,21 +95,21 @@ CurlOptions CreateCurlOptions(const APIKey& apiKey, HttpRequestType requestType,
   auto& httpHeaders = opts.mutableHttpHeaders();
 
   httpHeaders.emplace_back("KC-API-KEY", apiKey.key());
-  httpHeaders.emplace_back("KC-API-SIGN", B64Encode(ssl::Sha256Bin(strToSign, apiKey.privateKey())));
+  httpHeaders.emplace_back("KC-API-SIGN", B64Encode(signer.sign(strToSign)));
   httpHeaders.emplace_back("KC-API-TIMESTAMP", nonceTimeStr);
-  httpHeaders.emplace_back("KC-API-PASSPHRASE", B64Encode(ssl::Sha256Bin(apiKey.passphrase(), apiKey.privateKey())));
+  httpHeaders.emplace_back("KC-API-PASSPHRASE", B64Encode(signer.sign(apiKey.passphrase())));
   httpHeaders.emplace_back("KC-API-KEY-VERSION", 2);
 
   return opts;
 }
 
 template <class T>
-T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType requestType, std::string_view method,
-               CurlPostData&& postData = CurlPostData()) {
+T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+               HttpRequestType requestType, std::string_view method, CurlPostData&& postData = CurlPostData()) {
   auto nonceTimeStr = Nonce_TimeSinceEpochInMs();
   string strToSign;
   RequestRetry requestRetry(
-      curlHandle, CreateCurlOptions(apiKey, requestType, method, strToSign, nonceTimeStr, std::move(postData)),
+      curlHandle, CreateCurlOptions(apiKey, signer, requestType, method, strToSign, nonceTimeStr, std::move(postData)),
       QueryRetryPolicy{.initialRetryDelay = seconds{1}, .nbMaxRetries = 3});
 
   return requestRetry.query<T>(
@@ -132,25 +132,25 @@ T PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey, HttpRequestType req
         }
         return RequestRetry::Status::kResponseOK;
       },
-      [&strToSign, &apiKey, &nonceTimeStr](CurlOptions& opts) {
+      [&strToSign, &signer, &nonceTimeStr](CurlOptions& opts) {
         auto newNonceTimeStr = Nonce_TimeSinceEpochInMs();
 
         strToSign.replace(0UL, nonceTimeStr.size(), newNonceTimeStr);
 
         auto& httpHeaders = opts.mutableHttpHeaders();
-        httpHeaders.set("KC-API-SIGN", B64Encode(ssl::Sha256Bin(strToSign, apiKey.privateKey())));
+        httpHeaders.set("KC-API-SIGN", B64Encode(signer.sign(strToSign)));
         httpHeaders.set("KC-API-TIMESTAMP", newNonceTimeStr);
 
         nonceTimeStr = std::move(newNonceTimeStr);
       });
 }
 
-void InnerTransfer(CurlHandle& curlHandle, const APIKey& apiKey, MonetaryAmount amount, std::string_view fromStr,
-                   std::string_view toStr) {
+void InnerTransfer(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                   MonetaryAmount amount, std::string_view fromStr, std::string_view toStr) {
   log::info("Perform inner transfer of {} to {} account", amount, toStr);
 
   PrivateQuery<schema::kucoin::V1AccountsInnerTransfer>(
-      curlHandle, apiKey, HttpRequestType::kPost, "/api/v2/accounts/inner-transfer",
+      curlHandle, apiKey, signer, HttpRequestType::kPost, "/api/v2/accounts/inner-transfer",
       {{"clientOid", Nonce_TimeSinceEpochInMs()},  // Seems useless, but it's mandatory apparently
        {"currency", amount.currencyStr()},
        {"amount", amount.amountStr()},
@@ -158,12 +158,12 @@ void InnerTransfer(CurlHandle& curlHandle, const APIKey& apiKey, MonetaryAmount
        {"to", toStr}});
 }
 
-bool EnsureEnoughAmountIn(CurlHandle& curlHandle, const APIKey& apiKey, MonetaryAmount expectedAmount,
-                          std::string_view accountName) {
+bool EnsureEnoughAmountIn(CurlHandle& curlHandle, const APIKey& apiKey, const ssl::HmacSha256Signer& signer,
+                          MonetaryAmount expectedAmount, std::string_view accountName) {
   // Check if enough balance in the 'accountName' account of Kucoin
   CurrencyCode cur = expectedAmount.currencyCode();
-  auto res = PrivateQuery<schema::kucoin::V1Accounts>(curlHandle, apiKey, HttpRequestType::kGet, "/api/v1/accounts",
-                                                      {{"currency", cur.str()}})
+  auto res = PrivateQuery<schema::kucoin::V1Accounts>(curlHandle, apiKey, signer, HttpRequestType::kGet,
+                                                      "/api/v1/accounts", {{"currency", cur.str()}})
                  .data;
   MonetaryAmount totalAvailableAmount(0, cur);
   MonetaryAmount amountInTargetAccount = totalAvailableAmount;
@@ -186,10 +186,10 @@ bool EnsureEnoughAmountIn(CurlHandle& curlHandle, const APIKey& apiKey, Monetary
       if (typeStr != accountName && av != 0) {
         MonetaryAmount remainingAmountToInnerTransfer = expectedAmount - amountInTargetAccount;
         if (av < remainingAmountToInnerTransfer) {
-          InnerTransfer(curlHandle, apiKey, av, typeStr, accountName);
+          InnerTransfer(curlHandle, apiKey, signer, av, typeStr, accountName);
           amountInTargetAccount += av;
         } else {
-          InnerTransfer(curlHandle, apiKey, remainingAmountToInnerTransfer, typeStr, accountName);
+          InnerTransfer(curlHandle, apiKey, signer, remainingAmountToInnerTransfer, typeStr, accountName);
           break;
         }
       }
@@ -204,18 +204,20 @@ KucoinPrivate::KucoinPrivate(const CoincenterInfo& coincenterInfo, KucoinPublic&
     : ExchangePrivate(coincenterInfo, kucoinPublic, apiKey),
       _curlHandle(KucoinPublic::kUrlBase, coincenterInfo.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   coincenterInfo.getRunMode()),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, kucoinPublic) {}
+      _signer(apiKey.privateKey()),
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _signer,
+                           kucoinPublic) {}
 
 bool KucoinPrivate::validateApiKey() {
-  auto ret = PrivateQuery<schema::kucoin::V1Accounts>(_curlHandle, _apiKey, HttpRequestType::kGet, "/api/v1/accounts");
+  auto ret = PrivateQuery<schema::kucoin::V1Accounts>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
+                                                      "/api/v1/accounts");
   return ret.code == KucoinPublic::kStatusCodeOK;
 }
 
 BalancePortfolio KucoinPrivate::queryAccountBalance(const BalanceOptions& balanceOptions) {
   auto result =
-      PrivateQuery<schema::kucoin::V1Accounts>(_curlHandle, _apiKey, HttpRequestType::kGet, "/api/v1/accounts").data;
+      PrivateQuery<schema::kucoin::V1Accounts>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet, "/api/v1/accounts")
+          .data;
   BalancePortfolio balancePortfolio;
   bool withBalanceInUse =
       balanceOptions.amountIncludePolicy() == BalanceOptions::AmountIncludePolicy::kWithBalanceInUse;
@@ -240,14 +242,15 @@ BalancePortfolio KucoinPrivate::queryAccountBalance(const BalanceOptions& balanc
 
 Wallet KucoinPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   auto depositAddresses =
-      PrivateQuery<schema::kucoin::V3DepositAddresses>(_curlHandle, _apiKey, HttpRequestType::kGet,
+      PrivateQuery<schema::kucoin::V3DepositAddresses>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                        "/api/v3/deposit-addresses", {{"currency", currencyCode.str()}})
           .data;
   ExchangeName exchangeName(_kucoinPublic.exchangeNameEnum(), _apiKey.name());
   schema::kucoin::V3DepositAddress depositAddress;
   if (depositAddresses.empty()) {
     log::info("No deposit address for {} in {}, creating one", currencyCode, exchangeName);
-    depositAddress = PrivateQuery<schema::kucoin::V3DepositAddressCreate>(_curlHandle, _apiKey, HttpRequestType::kPost,
+    depositAddress = PrivateQuery<schema::kucoin::V3DepositAddressCreate>(_curlHandle, _apiKey, _signer,
+                                                                          HttpRequestType::kPost,
                                                                           "/api/v3/deposit-address/create",
                                                                           {{"currency", currencyCode.str()}})
                          .data;
@@ -269,7 +272,7 @@ Wallet KucoinPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
 namespace {
 template <class OrderVectorType>
 void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHandle, const APIKey& apiKey,
-                ExchangePublic& exchangePublic, OrderVectorType& orderVector) {
+                const ssl::HmacSha256Signer& signer, ExchangePublic& exchangePublic, OrderVectorType& orderVector) {
   using OrderType = std::remove_cvref_t<decltype(*std::declval<OrderVectorType>().begin())>;
 
   CurlPostData params{{"status", std::is_same_v<OrderType, OpenedOrder> ? "active" : "done"}, {"tradeType", "TRADE"}};
@@ -289,8 +292,8 @@ void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHand
   if (ordersConstraints.isPlacedTimeBeforeDefined()) {
     params.emplace_back("endAt", TimestampToMillisecondsSinceEpoch(ordersConstraints.placedBefore()));
   }
-  auto data = PrivateQuery<schema::kucoin::V1Orders>(curlHandle, apiKey, HttpRequestType::kGet, "/api/v1/orders",
-                                                     std::move(params))
+  auto data = PrivateQuery<schema::kucoin::V1Orders>(curlHandle, apiKey, signer, HttpRequestType::kGet,
+                                                     "/api/v1/orders", std::move(params))
                   .data;
 
   for (auto& orderDetails : data.items) {
@@ -353,14 +356,14 @@ void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHand
 
 ClosedOrderVector KucoinPrivate::queryClosedOrders(const OrdersConstraints& closedOrdersConstraints) {
   ClosedOrderVector closedOrders;
-  FillOrders(closedOrdersConstraints, _curlHandle, _apiKey, _exchangePublic, closedOrders);
+  FillOrders(closedOrdersConstraints, _curlHandle, _apiKey, _signer, _exchangePublic, closedOrders);
   log::info("Retrieved {} closed orders from {}", closedOrders.size(), _exchangePublic.name());
   return closedOrders;
 }
 
 OpenedOrderVector KucoinPrivate::queryOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
   OpenedOrderVector openedOrders;
-  FillOrders(openedOrdersConstraints, _curlHandle, _apiKey, _exchangePublic, openedOrders);
+  FillOrders(openedOrdersConstraints, _curlHandle, _apiKey, _signer, _exchangePublic, openedOrders);
   log::info("Retrieved {} opened orders from {}", openedOrders.size(), _exchangePublic.name());
   return openedOrders;
 }
@@ -371,7 +374,7 @@ int KucoinPrivate::cancelOpenedOrders(const OrdersConstraints& openedOrdersConst
     if (openedOrdersConstraints.isMarketDefined()) {
       params.emplace_back("symbol", openedOrdersConstraints.market().assetsPairStrUpper('-'));
     }
-    auto res = PrivateQuery<schema::kucoin::V1DeleteOrders>(_curlHandle, _apiKey, HttpRequestType::kDelete,
+    auto res = PrivateQuery<schema::kucoin::V1DeleteOrders>(_curlHandle, _apiKey, _signer, HttpRequestType::kDelete,
                                                             "/api/v1/orders", std::move(params));
     return res.data.cancelledOrderIds.size();
   }
@@ -413,7 +416,7 @@ DepositsSet KucoinPrivate::queryRecentDeposits(const DepositsConstraints& deposi
       options.emplace_back("txId", depositsConstraints.idSet().front());
     }
   }
-  auto depositJson = PrivateQuery<schema::kucoin::V1Deposits>(_curlHandle, _apiKey, HttpRequestType::kGet,
+  auto depositJson = PrivateQuery<schema::kucoin::V1Deposits>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
                                                               "/api/v1/deposits", std::move(options))
                          .data;
 
@@ -493,7 +496,8 @@ CurlPostData CreateOptionsFromWithdrawConstraints(const WithdrawsConstraints& wi
 
 WithdrawsSet KucoinPrivate::queryRecentWithdraws(const WithdrawsConstraints& withdrawsConstraints) {
   auto withdrawJson =
-      PrivateQuery<schema::kucoin::V1Withdrawals>(_curlHandle, _apiKey, HttpRequestType::kGet, "/api/v1/withdrawals",
+      PrivateQuery<schema::kucoin::V1Withdrawals>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet,
+                                                  "/api/v1/withdrawals",
                                                   CreateOptionsFromWithdrawConstraints(withdrawsConstraints))
           .data;
 
@@ -528,7 +532,7 @@ PlaceOrderInfo KucoinPrivate::placeOrder(MonetaryAmount from, MonetaryAmount vol
 
   PlaceOrderInfo placeOrderInfo(OrderInfo(TradedAmounts(fromCurrencyCode, toCurrencyCode)), OrderId("UndefinedId"));
 
-  if (!EnsureEnoughAmountIn(_curlHandle, _apiKey, from, "trade")) {
+  if (!EnsureEnoughAmountIn(_curlHandle, _apiKey, _signer, from, "trade")) {
     placeOrderInfo.setClosed();
     return placeOrderInfo;
   }
@@ -570,7 +574,7 @@ PlaceOrderInfo KucoinPrivate::placeOrder(MonetaryAmount from, MonetaryAmount vol
   params.emplace_back("timeInForce", "GTT");  // Good until cancelled or time expires
   params.emplace_back("cancelAfter", std::chrono::duration_cast<seconds>(tradeInfo.options.maxTradeTime()).count() + 1);
 
-  auto result = PrivateQuery<schema::kucoin::V1OrdersPlace>(_curlHandle, _apiKey, HttpRequestType::kPost,
+  auto result = PrivateQuery<schema::kucoin::V1OrdersPlace>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                             "/api/v1/orders", std::move(params))
                     .data;
   placeOrderInfo.orderId = std::move(result.orderId);
@@ -584,7 +588,7 @@ OrderInfo KucoinPrivate::cancelOrder(OrderIdView orderId, const TradeContext& tr
 
 void KucoinPrivate::cancelOrderProcess(OrderIdView orderId) {
   const auto endpoint = cct::format("/api/v1/orders/{}", orderId);
-  PrivateQuery<schema::kucoin::V1OrderCancel>(_curlHandle, _apiKey, HttpRequestType::kDelete, endpoint);
+  PrivateQuery<schema::kucoin::V1OrderCancel>(_curlHandle, _apiKey, _signer, HttpRequestType::kDelete, endpoint);
 }
 
 OrderInfo KucoinPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext& tradeContext) {
@@ -592,7 +596,8 @@ OrderInfo KucoinPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext&
   const Market mk = tradeContext.market;
   const auto endpoint = cct::format("/api/v1/orders/{}", orderId);
 
-  auto data = PrivateQuery<schema::kucoin::V1OrderInfo>(_curlHandle, _apiKey, HttpRequestType::kGet, endpoint).data;
+  auto data =
+      PrivateQuery<schema::kucoin::V1OrderInfo>(_curlHandle, _apiKey, _signer, HttpRequestType::kGet, endpoint).data;
 
   MonetaryAmount size(data.size, mk.base());
   MonetaryAmount matchedSize(data.dealSize, mk.base());
@@ -614,7 +619,7 @@ OrderInfo KucoinPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext&
 }
 
 InitiatedWithdrawInfo KucoinPrivate::launchWithdraw(MonetaryAmount grossAmount, Wallet&& destinationWallet) {
-  if (!EnsureEnoughAmountIn(_curlHandle, _apiKey, grossAmount, "main")) {
+  if (!EnsureEnoughAmountIn(_curlHandle, _apiKey, _signer, grossAmount, "main")) {
     throw exception("Insufficient funds for withdraw");
   }
   const CurrencyCode currencyCode = grossAmount.currencyCode();
@@ -630,7 +635,7 @@ InitiatedWithdrawInfo KucoinPrivate::launchWithdraw(MonetaryAmount grossAmount,
     opts.emplace_back("memo", destinationWallet.tag());
   }
 
-  auto result = PrivateQuery<schema::kucoin::V3ApplyWithdrawal>(_curlHandle, _apiKey, HttpRequestType::kPost,
+  auto result = PrivateQuery<schema::kucoin::V3ApplyWithdrawal>(_curlHandle, _apiKey, _signer, HttpRequestType::kPost,
                                                                 "/api/v3/withdrawals", std::move(opts))
                     .data;
   return {std::move(destinationWallet), std::move(result.withdrawalId), grossAmount};
@@ -5,13 +5,14 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <string_view>
 #include <utility>
 
 #include "apiquerytypeenum.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
 #include "cct_vector.hpp"
@@ -32,6 +33,7 @@
 #include "kucoin-schema.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetary-amount-vector.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
@@ -47,6 +49,9 @@
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kTradableCurrenciesSection = "tradableCurrencies";
+constexpr std::string_view kMarketsSection = "markets";
+
 template <class T>
 T PublicQuery(CurlHandle& curlHandle, std::string_view endpoint, const CurlPostData& curlPostData = CurlPostData()) {
   RequestRetry requestRetry(curlHandle, CurlOptions(HttpRequestType::kGet, curlPostData));
@@ -67,26 +72,27 @@ T PublicQuery(CurlHandle& curlHandle, std::string_view endpoint, const CurlPostD
 KucoinPublic::KucoinPublic(const CoincenterInfo& config, FiatConverter& fiatConverter, api::CommonAPI& commonAPI)
     : ExchangePublic(ExchangeNameEnum::kucoin, fiatConverter, commonAPI, config),
       _curlHandle(kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(), config.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _curlHandle, _coincenterInfo, commonAPI),
-      _marketsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::markets), _cachedResultVault),
-          _curlHandle, exchangeConfig().asset),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          _marketsCache, _curlHandle),
-      _orderbookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          _curlHandle),
-      _tradedVolumeCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume), _cachedResultVault),
-          _curlHandle),
-      _tickerCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::lastPrice), _cachedResultVault),
-          _curlHandle) {}
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), _curlHandle, _coincenterInfo, commonAPI),
+      _marketsCache(cachedResultOptions(QueryType::markets), _curlHandle, exchangeConfig().asset),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), _marketsCache, _curlHandle),
+      _orderbookCache(cachedResultOptions(QueryType::orderBook), _curlHandle),
+      _tradedVolumeCache(cachedResultOptions(QueryType::tradedVolume), _curlHandle),
+      _tickerCache(cachedResultOptions(QueryType::lastPrice), _curlHandle) {
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.load(kMarketsSection, _marketsCache);
+  });
+}
+
+void KucoinPublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.store(kMarketsSection, _marketsCache);
+  });
+}
 
 bool KucoinPublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = PublicQuery<schema::kucoin::V1Status>(_curlHandle, "/api/v1/status");
   log::info("{} status: {}, msg: {}", name(), result.data.status, result.data.msg);
   return result.data.status == "open";
@@ -151,7 +157,8 @@ KucoinPublic::TradableCurrenciesFunc::CurrencyInfoSet KucoinPublic::TradableCurr
 }
 
 CurrencyExchangeFlatSet KucoinPublic::queryTradableCurrencies() {
-  const TradableCurrenciesFunc::CurrencyInfoSet& currencyInfoSet = _tradableCurrenciesCache.get();
+  const auto pCurrencyInfoSet = _tradableCurrenciesCache.get();
+  const TradableCurrenciesFunc::CurrencyInfoSet& currencyInfoSet = *pCurrencyInfoSet;
   CurrencyExchangeVector currencies(currencyInfoSet.size());
   std::ranges::transform(currencyInfoSet, currencies.begin(),
                          [](const auto& currencyInfo) { return currencyInfo.currencyExchange; });
@@ -208,7 +215,8 @@ std::pair<MarketSet, KucoinPublic::MarketsFunc::MarketInfoMap> KucoinPublic::Mar
 
 MonetaryAmountByCurrencySet KucoinPublic::queryWithdrawalFees() {
   MonetaryAmountVector fees;
-  const auto& tradableCurrencies = _tradableCurrenciesCache.get();
+  const auto pTradableCurrencies = _tradableCurrenciesCache.get();
+  const auto& tradableCurrencies = *pTradableCurrencies;
   fees.reserve(tradableCurrencies.size());
   for (const TradableCurrenciesFunc::CurrencyInfo& curDetail : tradableCurrencies) {
     fees.push_back(curDetail.withdrawalMinFee);
@@ -220,7 +228,8 @@ MonetaryAmountByCurrencySet KucoinPublic::queryWithdrawalFees() {
 }
 
 std::optional<MonetaryAmount> KucoinPublic::queryWithdrawalFee(CurrencyCode currencyCode) {
-  const auto& currencyInfoSet = _tradableCurrenciesCache.get();
+  const auto pCurrencyInfoSet = _tradableCurrenciesCache.get();
+  const auto& currencyInfoSet = *pCurrencyInfoSet;
   auto it = currencyInfoSet.lower_bound(TradableCurrenciesFunc::CurrencyInfo(currencyCode));
   if (it == currencyInfoSet.end()) {
     return {};
@@ -230,7 +239,8 @@ std::optional<MonetaryAmount> KucoinPublic::queryWithdrawalFee(CurrencyCode curr
 
 MarketOrderBookMap KucoinPublic::AllOrderBooksFunc::operator()(int depth) {
   MarketOrderBookMap ret;
-  const auto& [markets, marketInfoMap] = _marketsCache.get();
+  const auto pMarkets = _marketsCache.get();
+  const auto& [markets, marketInfoMap] = *pMarkets;
   const auto data = PublicQuery<schema::kucoin::V1AllTickers>(_curlHandle, "/api/v1/market/allTickers");
   const auto time = Clock::now();
   for (const auto& ticker : data.data.ticker) {
@@ -325,7 +335,8 @@ MarketOrderBook KucoinPublic::OrderBookFunc::operator()(Market mk, int depth) {
 }
 
 MonetaryAmount KucoinPublic::sanitizePrice(Market mk, MonetaryAmount pri) {
-  const MarketsFunc::MarketInfoMap& marketInfoMap = _marketsCache.get().second;
+  const auto pMarkets = _marketsCache.get();
+  const MarketsFunc::MarketInfoMap& marketInfoMap = pMarkets->second;
   const MarketsFunc::MarketInfo& marketInfo = marketInfoMap.find(mk)->second;
   MonetaryAmount sanitizedPri = pri;
   if (pri < marketInfo.priceIncrement) {
@@ -340,7 +351,8 @@ MonetaryAmount KucoinPublic::sanitizePrice(Market mk, MonetaryAmount pri) {
 }
 
 MonetaryAmount KucoinPublic::sanitizeVolume(Market mk, MonetaryAmount vol) {
-  const MarketsFunc::MarketInfoMap& marketInfoMap = _marketsCache.get().second;
+  const auto pMarkets = _marketsCache.get();
+  const MarketsFunc::MarketInfoMap& marketInfoMap = pMarkets->second;
   const MarketsFunc::MarketInfo& marketInfo = marketInfoMap.find(mk)->second;
   MonetaryAmount sanitizedVol = vol;
   // TODO: Kucoin documentation is not clear about this, this would probably need to be adjusted
@@ -369,6 +381,7 @@ PublicTradeVector KucoinPublic::queryLastTrades(Market mk, int nbTrades) {
     log::warn("Maximum number of last trades to query from {} is {}", name(), kMaxNbLastTrades);
   }
 
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result =
       PublicQuery<schema::kucoin::V1MarketHistories>(_curlHandle, "/api/v1/market/histories", GetSymbolPostData(mk));
 
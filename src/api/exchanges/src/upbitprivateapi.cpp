@@ -1,11 +1,11 @@
 #include "upbitprivateapi.hpp"
 
-#include <jwt-cpp/jwt.h>
-
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
-#include <string>
+#include <span>
 #include <string_view>
 #include <type_traits>
 #include <utility>
@@ -38,6 +38,7 @@
 #include "exchangepublicapi.hpp"
 #include "exchangepublicapitypes.hpp"
 #include "httprequesttype.hpp"
+#include "json-web-token-builder.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
 #include "opened-order.hpp"
@@ -66,21 +67,22 @@ namespace {
 
 enum class IfError : int8_t { kThrow, kNoThrow };
 
-string ComputeAuthToken(const APIKey& apiKey, const CurlPostData& postData) {
-  auto jsonWebToken = jwt::create()
-                          .set_type("JWT")
-                          .set_payload_claim("access_key", jwt::claim(std::string(apiKey.key())))
-                          .set_payload_claim("nonce", jwt::claim(std::string(Nonce_TimeSinceEpochInMs())));
+string ComputeAuthToken(const ssl::JsonWebTokenHs256Builder& jwtBuilder, const CurlPostData& postData) {
+  const Nonce nonce = Nonce_TimeSinceEpochInMs();
+
+  // 'access_key' claim is already part of the builder
+  std::array<ssl::JsonWebTokenHs256Builder::Claim, 3> claims{{{"nonce", nonce}}};
+  std::size_t nbClaims = 1;
 
+  ssl::Sha512DigestArray queryHash;
   if (!postData.empty()) {
-    const auto queryHash = ssl::Sha512Digest(postData.str());
+    queryHash = ssl::Sha512Digest(postData.str());
 
-    jsonWebToken.set_payload_claim("query_hash", jwt::claim(std::string(queryHash.data(), queryHash.size())))
-        .set_payload_claim("query_hash_alg", jwt::claim(std::string("SHA512")));
+    claims[nbClaims++] = {"query_hash", std::string_view(queryHash.data(), queryHash.size())};
+    claims[nbClaims++] = {"query_hash_alg", "SHA512"};
   }
 
-  // hs256 does not accept std::string_view, we need a copy...
-  const auto token = jsonWebToken.sign(jwt::algorithm::hs256{std::string(apiKey.privateKey())});
+  const auto token = jwtBuilder.build(std::span(claims.data(), nbClaims));
 
   static constexpr std::string_view kBearerPrefix = "Bearer";
   string authStr(kBearerPrefix.size() + 1U + token.size(), ' ');
@@ -90,20 +92,20 @@ string ComputeAuthToken(const APIKey& apiKey, const CurlPostData& postData) {
 }
 
 template <class T, class CurlPostDataT = CurlPostData>
-std::pair<T, schema::upbit::Error> PrivateQuery(CurlHandle& curlHandle, const APIKey& apiKey,
+std::pair<T, schema::upbit::Error> PrivateQuery(CurlHandle& curlHandle, const ssl::JsonWebTokenHs256Builder& jwtBuilder,
                                                 HttpRequestType requestType, std::string_view endpoint,
                                                 CurlPostDataT&& curlPostData = CurlPostData(),
                                                 int16_t nbMaxRetries = 3) {
   CurlOptions opts(requestType, std::forward<CurlPostDataT>(curlPostData));
 
-  opts.mutableHttpHeaders().emplace_back("Authorization", ComputeAuthToken(apiKey, opts.postData()));
+  opts.mutableHttpHeaders().emplace_back("Authorization", ComputeAuthToken(jwtBuilder, opts.postData()));
 
   RequestRetry requestRetry(
       curlHandle, std::move(opts),
       QueryRetryPolicy{.initialRetryDelay = seconds{1}, .exponentialBackoff = 1.5, .nbMaxRetries = nbMaxRetries});
 
-  return schema::upbit::GetOrValueInitialized<T>(requestRetry, endpoint, [&apiKey](CurlOptions& curlOptions) {
-    curlOptions.mutableHttpHeaders().set_back("Authorization", ComputeAuthToken(apiKey, curlOptions.postData()));
+  return schema::upbit::GetOrValueInitialized<T>(requestRetry, endpoint, [&jwtBuilder](CurlOptions& curlOptions) {
+    curlOptions.mutableHttpHeaders().set_back("Authorization", ComputeAuthToken(jwtBuilder, curlOptions.postData()));
   });
 }
 }  // namespace
@@ -112,18 +114,16 @@ UpbitPrivate::UpbitPrivate(const CoincenterInfo& config, UpbitPublic& upbitPubli
     : ExchangePrivate(config, upbitPublic, apiKey),
       _curlHandle(UpbitPublic::kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(),
                   config.getRunMode()),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _curlHandle, _apiKey, exchangeConfig().asset, upbitPublic._commonApi),
-      _depositWalletsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::depositWallet), _cachedResultVault),
-          _curlHandle, _apiKey, upbitPublic),
-      _withdrawalFeesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::withdrawalFees), _cachedResultVault),
-          _curlHandle, _apiKey, upbitPublic) {}
+      _jwtBuilder(apiKey.privateKey(), std::array{ssl::JsonWebTokenHs256Builder::Claim{"access_key", apiKey.key()}}),
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), _curlHandle, _jwtBuilder,
+                               exchangeConfig().asset, upbitPublic._commonApi),
+      _depositWalletsCache(cachedResultOptions(QueryType::depositWallet), _curlHandle, _apiKey, _jwtBuilder,
+                           upbitPublic),
+      _withdrawalFeesCache(cachedResultOptions(QueryType::withdrawalFees), _curlHandle, _jwtBuilder, upbitPublic) {}
 
 bool UpbitPrivate::validateApiKey() {
-  auto ret = PrivateQuery<schema::upbit::V1ApiKeys>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/api_keys").first;
+  auto ret =
+      PrivateQuery<schema::upbit::V1ApiKeys>(_curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/api_keys").first;
   return !ret.empty();
 }
 
@@ -131,7 +131,7 @@ CurrencyExchangeFlatSet UpbitPrivate::TradableCurrenciesFunc::operator()() {
   const CurrencyCodeSet& excludedCurrencies = _assetConfig.allExclude;
   CurrencyExchangeVector currencies;
   auto result =
-      PrivateQuery<schema::upbit::V1StatusWallets>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/status/wallet")
+      PrivateQuery<schema::upbit::V1StatusWallets>(_curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/status/wallet")
           .first;
   for (const auto& curDetails : result) {
     if (curDetails.currency.size() > CurrencyCode::kMaxLen) {
@@ -185,7 +185,8 @@ BalancePortfolio UpbitPrivate::queryAccountBalance(const BalanceOptions& balance
 
   BalancePortfolio balancePortfolio;
 
-  auto ret = PrivateQuery<schema::upbit::V1Accounts>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/accounts").first;
+  auto ret =
+      PrivateQuery<schema::upbit::V1Accounts>(_curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/accounts").first;
 
   balancePortfolio.reserve(static_cast<BalancePortfolio::size_type>(ret.size()));
 
@@ -208,8 +209,8 @@ BalancePortfolio UpbitPrivate::queryAccountBalance(const BalanceOptions& balance
 
 Wallet UpbitPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   CurlPostData postData{{"currency", currencyCode.str()}, {"net_type", currencyCode.str()}};
-  auto [result, error] = PrivateQuery<schema::upbit::V1DepositCoinAddress>(_curlHandle, _apiKey, HttpRequestType::kGet,
-                                                                           "/v1/deposits/coin_address", postData, 1);
+  auto [result, error] = PrivateQuery<schema::upbit::V1DepositCoinAddress>(
+      _curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/deposits/coin_address", postData, 1);
   bool generateDepositAddressNeeded = false;
   if (std::holds_alternative<string>(error.error.name)) {
     std::string_view msg = error.error.message;
@@ -222,7 +223,7 @@ Wallet UpbitPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
   }
   if (generateDepositAddressNeeded) {
     auto genCoinAddressResult =
-        PrivateQuery<schema::upbit::V1DepositsGenerateCoinAddress>(_curlHandle, _apiKey, HttpRequestType::kPost,
+        PrivateQuery<schema::upbit::V1DepositsGenerateCoinAddress>(_curlHandle, _jwtBuilder, HttpRequestType::kPost,
                                                                    "/v1/deposits/generate_coin_address", postData)
             .first;
     if (genCoinAddressResult.success) {
@@ -231,7 +232,7 @@ Wallet UpbitPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
       log::error("Failed to generate address (or unexpected answer), message: {}", genCoinAddressResult.message);
     }
     log::info("Waiting for address to be generated...");
-    result = PrivateQuery<schema::upbit::V1DepositCoinAddress>(_curlHandle, _apiKey, HttpRequestType::kGet,
+    result = PrivateQuery<schema::upbit::V1DepositCoinAddress>(_curlHandle, _jwtBuilder, HttpRequestType::kGet,
                                                                "/v1/deposits/coin_address", postData, 10)
                  .first;
   }
@@ -253,8 +254,9 @@ Wallet UpbitPrivate::DepositWalletFunc::operator()(CurrencyCode currencyCode) {
 
 namespace {
 template <class OrderVectorType>
-void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHandle, const APIKey& apiKey,
-                ExchangePublic& exchangePublic, OrderVectorType& orderVector) {
+void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHandle,
+                const ssl::JsonWebTokenHs256Builder& jwtBuilder, ExchangePublic& exchangePublic,
+                OrderVectorType& orderVector) {
   using OrderType = std::remove_cvref_t<decltype(*std::declval<OrderVectorType>().begin())>;
 
   int page = 0;
@@ -295,7 +297,7 @@ void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHand
     std::string_view endpoint = kIsOpenedOrder ? kOpenedOrdersEndpoint : kClosedOrdersEndpoint;
 
     auto data =
-        PrivateQuery<schema::upbit::V1Orders>(curlHandle, apiKey, HttpRequestType::kGet, endpoint, params).first;
+        PrivateQuery<schema::upbit::V1Orders>(curlHandle, jwtBuilder, HttpRequestType::kGet, endpoint, params).first;
 
     nbOrdersRetrieved = static_cast<decltype(nbOrdersRetrieved)>(data.size());
 
@@ -376,14 +378,14 @@ void FillOrders(const OrdersConstraints& ordersConstraints, CurlHandle& curlHand
 
 ClosedOrderVector UpbitPrivate::queryClosedOrders(const OrdersConstraints& closedOrdersConstraints) {
   ClosedOrderVector closedOrders;
-  FillOrders(closedOrdersConstraints, _curlHandle, _apiKey, _exchangePublic, closedOrders);
+  FillOrders(closedOrdersConstraints, _curlHandle, _jwtBuilder, _exchangePublic, closedOrders);
   log::info("Retrieved {} closed orders from {}", closedOrders.size(), _exchangePublic.name());
   return closedOrders;
 }
 
 OpenedOrderVector UpbitPrivate::queryOpenedOrders(const OrdersConstraints& openedOrdersConstraints) {
   OpenedOrderVector openedOrders;
-  FillOrders(openedOrdersConstraints, _curlHandle, _apiKey, _exchangePublic, openedOrders);
+  FillOrders(openedOrdersConstraints, _curlHandle, _jwtBuilder, _exchangePublic, openedOrders);
   log::info("Retrieved {} opened orders from {}", openedOrders.size(), _exchangePublic.name());
   return openedOrders;
 }
@@ -440,9 +442,9 @@ DepositsSet UpbitPrivate::queryRecentDeposits(const DepositsConstraints& deposit
   // To make sure we retrieve all results, ask for next page when maximum results per page is returned
   for (int nbResults = kNbResultsPerPage, page = 1; nbResults == kNbResultsPerPage; ++page) {
     options.set("page", page);
-    auto result =
-        PrivateQuery<schema::upbit::V1Deposits>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/deposits", options)
-            .first;
+    auto result = PrivateQuery<schema::upbit::V1Deposits>(_curlHandle, _jwtBuilder, HttpRequestType::kGet,
+                                                          "/v1/deposits", options)
+                      .first;
     if (deposits.empty()) {
       deposits.reserve(static_cast<Deposits::size_type>(result.size()));
     }
@@ -516,9 +518,9 @@ WithdrawsSet UpbitPrivate::queryRecentWithdraws(const WithdrawsConstraints& with
   // To make sure we retrieve all results, ask for next page when maximum results per page is returned
   for (int nbResults = kNbResultsPerPage, page = 1; nbResults == kNbResultsPerPage; ++page) {
     options.set("page", page);
-    auto result =
-        PrivateQuery<schema::upbit::V1Withdraws>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/withdraws", options)
-            .first;
+    auto result = PrivateQuery<schema::upbit::V1Withdraws>(_curlHandle, _jwtBuilder, HttpRequestType::kGet,
+                                                           "/v1/withdraws", options)
+                      .first;
     if (withdraws.empty()) {
       withdraws.reserve(static_cast<Withdraws::size_type>(result.size()));
     }
@@ -652,7 +654,7 @@ PlaceOrderInfo UpbitPrivate::placeOrder(MonetaryAmount from, MonetaryAmount volu
     placePostData.emplace_back("price", price.amountStr());
   }
 
-  auto placeOrderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _apiKey, HttpRequestType::kPost,
+  auto placeOrderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _jwtBuilder, HttpRequestType::kPost,
                                                                   "/v1/orders", placePostData)
                            .first;
 
@@ -662,8 +664,8 @@ PlaceOrderInfo UpbitPrivate::placeOrder(MonetaryAmount from, MonetaryAmount volu
   // Upbit takes some time to match the market order - We should wait that it has been matched
   bool takerOrderNotClosed = isTakerStrategy && !placeOrderInfo.orderInfo.isClosed;
   while (takerOrderNotClosed) {
-    auto orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/order",
-                                                               {{"uuid", placeOrderInfo.orderId}})
+    auto orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _jwtBuilder, HttpRequestType::kGet,
+                                                               "/v1/order", {{"uuid", placeOrderInfo.orderId}})
                         .first;
 
     placeOrderInfo.orderInfo = ParseOrderJson(orderRes, fromCurrencyCode, mk);
@@ -675,22 +677,22 @@ PlaceOrderInfo UpbitPrivate::placeOrder(MonetaryAmount from, MonetaryAmount volu
 
 OrderInfo UpbitPrivate::cancelOrder(OrderIdView orderId, const TradeContext& tradeContext) {
   CurlPostData postData{{"uuid", orderId}};
-  auto orderRes =
-      PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _apiKey, HttpRequestType::kDelete, "/v1/order", postData)
-          .first;
+  auto orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _jwtBuilder, HttpRequestType::kDelete,
+                                                             "/v1/order", postData)
+                      .first;
   bool cancelledOrderClosed = IsOrderClosed(orderRes.state);
   while (!cancelledOrderClosed) {
-    orderRes =
-        PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/order", postData)
-            .first;
+    orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/order",
+                                                          postData)
+                   .first;
     cancelledOrderClosed = IsOrderClosed(orderRes.state);
   }
   return ParseOrderJson(orderRes, tradeContext.fromCur(), tradeContext.market);
 }
 
 OrderInfo UpbitPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext& tradeContext) {
-  auto orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _apiKey, HttpRequestType::kGet, "/v1/order",
-                                                             {{"uuid", orderId}})
+  auto orderRes = PrivateQuery<schema::upbit::V1SingleOrder>(_curlHandle, _jwtBuilder, HttpRequestType::kGet,
+                                                             "/v1/order", {{"uuid", orderId}})
                       .first;
   const CurrencyCode fromCurrencyCode(tradeContext.fromCur());
   return ParseOrderJson(orderRes, fromCurrencyCode, tradeContext.market);
@@ -699,7 +701,7 @@ OrderInfo UpbitPrivate::queryOrderInfo(OrderIdView orderId, const TradeContext&
 std::optional<MonetaryAmount> UpbitPrivate::WithdrawFeesFunc::operator()(CurrencyCode currencyCode) {
   auto curStr = currencyCode.str();
   auto result = PrivateQuery<schema::upbit::V1WithdrawChance>(
-                    _curlHandle, _apiKey, HttpRequestType::kGet, "/v1/withdraws/chance",
+                    _curlHandle, _jwtBuilder, HttpRequestType::kGet, "/v1/withdraws/chance",
                     {{"currency", std::string_view{curStr}}, {"net_type", std::string_view{curStr}}})
                     .first;
   return MonetaryAmount(result.currency.withdraw_fee, currencyCode);
@@ -717,7 +719,7 @@ InitiatedWithdrawInfo UpbitPrivate::launchWithdraw(MonetaryAmount grossAmount, W
     withdrawPostData.emplace_back("secondary_address", destinationWallet.tag());
   }
 
-  auto result = PrivateQuery<schema::upbit::V1WithdrawsCoin>(_curlHandle, _apiKey, HttpRequestType::kPost,
+  auto result = PrivateQuery<schema::upbit::V1WithdrawsCoin>(_curlHandle, _jwtBuilder, HttpRequestType::kPost,
                                                              "/v1/withdraws/coin", std::move(withdrawPostData))
                     .first;
   return {std::move(destinationWallet), std::move(result.uuid), grossAmount};
@@ -4,13 +4,15 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <utility>
 
 #include "apiquerytypeenum.hpp"
-#include "cachedresult.hpp"
+#include "concurrent-cachedresult.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
 #include "coincenterinfo.hpp"
@@ -26,8 +28,10 @@
 #include "fiatconverter.hpp"
 #include "file.hpp"
 #include "httprequesttype.hpp"
+#include "market-order-book-vector.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metadata-cache-file.hpp"
 #include "monetary-amount-vector.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
@@ -44,6 +48,10 @@
 namespace cct::api {
 namespace {
 
+constexpr std::string_view kMarketsSection = "markets";
+constexpr std::string_view kTradableCurrenciesSection = "tradableCurrencies";
+constexpr std::string_view kWithdrawalFeesSection = "withdrawalFees";
+
 template <class T>
 T PublicQuery(CurlHandle& curlHandle, std::string_view endpoint, CurlPostData&& postData = CurlPostData()) {
   RequestRetry requestRetry(curlHandle, CurlOptions(HttpRequestType::kGet, std::move(postData)));
@@ -55,35 +63,37 @@ T PublicQuery(CurlHandle& curlHandle, std::string_view endpoint, CurlPostData&&
 UpbitPublic::UpbitPublic(const CoincenterInfo& config, FiatConverter& fiatConverter, CommonAPI& commonAPI)
     : ExchangePublic(ExchangeNameEnum::upbit, fiatConverter, commonAPI, config),
       _curlHandle(kUrlBase, config.metricGatewayPtr(), permanentCurlOptionsBuilder().build(), config.getRunMode()),
-      _marketsCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::markets), _cachedResultVault),
-          _curlHandle, exchangeConfig().asset),
-      _tradableCurrenciesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::currencies), _cachedResultVault),
-          _curlHandle, _marketsCache),
-      _withdrawalFeesCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::withdrawalFees), _cachedResultVault),
-          name(), config.dataDir()),
-      _allOrderBooksCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::allOrderBooks), _cachedResultVault),
-          _curlHandle, _marketsCache),
-      _orderbookCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::orderBook), _cachedResultVault),
-          _curlHandle),
-      _tradedVolumeCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::tradedVolume), _cachedResultVault),
-          _curlHandle),
-      _tickerCache(
-          CachedResultOptions(exchangeConfig().query.getUpdateFrequency(QueryType::lastPrice), _cachedResultVault),
-          _curlHandle) {}
+      _marketsCache(cachedResultOptions(QueryType::markets), _curlHandle, exchangeConfig().asset),
+      _tradableCurrenciesCache(cachedResultOptions(QueryType::currencies), _curlHandle, _marketsCache),
+      _withdrawalFeesCache(cachedResultOptions(QueryType::withdrawalFees), name(), config.dataDir()),
+      _allOrderBooksCache(cachedResultOptions(QueryType::allOrderBooks), _curlHandle, _marketsCache),
+      _orderbookCache(cachedResultOptions(QueryType::orderBook), _curlHandle),
+      _tradedVolumeCache(cachedResultOptions(QueryType::tradedVolume), _curlHandle),
+      _tickerCache(cachedResultOptions(QueryType::lastPrice), _curlHandle) {
+  loadMetadataCache([this](const MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.load(kMarketsSection, _marketsCache);
+    metadataCacheFile.load(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.load(kWithdrawalFeesSection, _withdrawalFeesCache);
+  });
+}
+
+void UpbitPublic::updateCacheFile() const {
+  storeMetadataCache([this](MetadataCacheFile& metadataCacheFile) {
+    metadataCacheFile.store(kMarketsSection, _marketsCache);
+    metadataCacheFile.store(kTradableCurrenciesSection, _tradableCurrenciesCache);
+    metadataCacheFile.store(kWithdrawalFeesSection, _withdrawalFeesCache);
+  });
+}
 
 bool UpbitPublic::healthCheck() {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = PublicQuery<schema::upbit::V1Tickers>(_curlHandle, "/v1/ticker", {{"markets", "KRW-BTC"}});
   return !result.empty() && result.front().timestamp != 0;
 }
 
 std::optional<MonetaryAmount> UpbitPublic::queryWithdrawalFee(CurrencyCode currencyCode) {
-  const auto& map = _withdrawalFeesCache.get();
+  const auto pWithdrawalFees = _withdrawalFeesCache.get();
+  const auto& map = *pWithdrawalFees;
   auto it = map.find(currencyCode);
   if (it == map.end()) {
     return {};
@@ -92,9 +102,9 @@ std::optional<MonetaryAmount> UpbitPublic::queryWithdrawalFee(CurrencyCode curre
 }
 
 CurrencyExchangeFlatSet UpbitPublic::TradableCurrenciesFunc::operator()() {
-  const MarketSet& markets = _marketsCache.get();
+  const auto pMarkets = _marketsCache.get();
   CurrencyExchangeFlatSet currencies;
-  for (Market mk : markets) {
+  for (Market mk : *pMarkets) {
     currencies.emplace(mk.base(), mk.base(), mk.base());
     currencies.emplace(mk.quote(), mk.quote(), mk.quote());
   }
@@ -173,6 +183,19 @@ MonetaryAmountByCurrencySet UpbitPublic::WithdrawalFeesFunc::operator()() const
 
 namespace {
 
+template <class MarketRange>
+string ReverseMarketsStr(const MarketRange& markets) {
+  string marketsStr;
+  marketsStr.reserve(static_cast<string::size_type>(std::ranges::size(markets)) * 8);
+  for (Market mk : markets) {
+    if (!marketsStr.empty()) {
+      marketsStr.push_back(',');
+    }
+    marketsStr.append(UpbitPublic::ReverseMarketStr(mk));
+  }
+  return marketsStr;
+}
+
 template <class OutputType>
 OutputType ParseOrderBooks(const schema::upbit::V1Orderbooks& result, int depth) {
   OutputType ret;
@@ -228,17 +251,10 @@ OutputType ParseOrderBooks(const schema::upbit::V1Orderbooks& result, int depth)
 }  // namespace
 
 MarketOrderBookMap UpbitPublic::AllOrderBooksFunc::operator()(int depth) {
-  const MarketSet& markets = _marketsCache.get();
-  string marketsStr;
-  marketsStr.reserve(static_cast<string::size_type>(markets.size()) * 8);
-  for (Market mk : markets) {
-    if (!marketsStr.empty()) {
-      marketsStr.push_back(',');
-    }
-    marketsStr.append(ReverseMarketStr(mk));
-  }
   return ParseOrderBooks<MarketOrderBookMap>(
-      PublicQuery<schema::upbit::V1Orderbooks>(_curlHandle, "/v1/orderbook", {{"markets", marketsStr}}), depth);
+      PublicQuery<schema::upbit::V1Orderbooks>(_curlHandle, "/v1/orderbook",
+                                               {{"markets", ReverseMarketsStr(*_marketsCache.get())}}),
+      depth);
 }
 
 MarketOrderBook UpbitPublic::OrderBookFunc::operator()(Market mk, int depth) {
@@ -247,6 +263,16 @@ MarketOrderBook UpbitPublic::OrderBookFunc::operator()(Market mk, int depth) {
       depth);
 }
 
+MarketOrderBookVector UpbitPublic::queryOrderBooks(std::span<const Market> markets, int depth) {
+  // Upbit returns the order books of all the markets given in a single request
+  return QueryOrderBooksWithCache(_orderbookCache, markets, depth, [this, depth](std::span<const Market> mks) {
+    std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
+    return ParseOrderBooks<MarketOrderBookMap>(
+        PublicQuery<schema::upbit::V1Orderbooks>(_curlHandle, "/v1/orderbook", {{"markets", ReverseMarketsStr(mks)}}),
+        depth);
+  });
+}
+
 MonetaryAmount UpbitPublic::TradedVolumeFunc::operator()(Market mk) {
   auto result = PublicQuery<schema::upbit::V1CandlesDay>(_curlHandle, "/v1/candles/days",
                                                          {{"count", 1}, {"market", ReverseMarketStr(mk)}});
@@ -255,6 +281,7 @@ MonetaryAmount UpbitPublic::TradedVolumeFunc::operator()(Market mk) {
 }
 
 PublicTradeVector UpbitPublic::queryLastTrades(Market mk, int nbTrades) {
+  std::lock_guard<std::recursive_mutex> guard(_publicRequestsMutex);
   auto result = PublicQuery<schema::upbit::V1TradesTicks>(_curlHandle, "/v1/trades/ticks",
                                                           {{"count", nbTrades}, {"market", ReverseMarketStr(mk)}});
 
@@ -0,0 +1,104 @@
+#include "binance-market-filters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "binance-schema.hpp"
+#include "cct_exception.hpp"
+#include "cct_vector.hpp"
+#include "market.hpp"
+#include "metadata-cache-archive.hpp"
+#include "monetaryamount.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct::api {
+
+class BinanceMarketFiltersTest : public ::testing::Test {
+ protected:
+  using Symbol = schema::binance::V3ExchangeInfo::Symbol;
+  using Filter = Symbol::Filter;
+
+  static Symbol CreateSymbol() {
+    Symbol symbol{};
+    symbol.baseAssetPrecision = 8;
+    symbol.quoteAssetPrecision = 8;
+
+    Filter& priceFilter = symbol.filters.emplace_back();
+    priceFilter.filterType = "PRICE_FILTER";
+    priceFilter.minPrice = MonetaryAmount("0.01");
+    priceFilter.maxPrice = MonetaryAmount("1000000");
+    priceFilter.tickSize = MonetaryAmount("0.01");
+
+    Filter& lotSizeFilter = symbol.filters.emplace_back();
+    lotSizeFilter.filterType = "LOT_SIZE";
+    lotSizeFilter.minQty = MonetaryAmount("0.00001");
+    lotSizeFilter.maxQty = MonetaryAmount("9000");
+    lotSizeFilter.stepSize = MonetaryAmount("0.00001");
+
+    Filter& marketLotSizeFilter = symbol.filters.emplace_back();
+    marketLotSizeFilter.filterType = "MARKET_LOT_SIZE";
+    marketLotSizeFilter.minQty = MonetaryAmount(0);
+    marketLotSizeFilter.maxQty = MonetaryAmount("100");
+    marketLotSizeFilter.stepSize = MonetaryAmount(0);
+
+    Filter& notionalFilter = symbol.filters.emplace_back();
+    notionalFilter.filterType = "NOTIONAL";
+    notionalFilter.minNotional = MonetaryAmount("5");
+    notionalFilter.maxNotional = MonetaryAmount("9000000");
+    notionalFilter.applyMinToMarket = true;
+    notionalFilter.avgPriceMins = 5;
+
+    return symbol;
+  }
+
+  Market market{"BTC", "USDT"};
+  BinanceMarketFilters marketFilters{market, CreateSymbol()};
+};
+
+TEST_F(BinanceMarketFiltersTest, SanitizePrice) {
+  EXPECT_EQ(marketFilters.sanitizePrice(MonetaryAmount("30000.1289", "USDT")), MonetaryAmount("30000.12", "USDT"));
+  EXPECT_EQ(marketFilters.sanitizePrice(MonetaryAmount("2000000", "USDT")), MonetaryAmount("1000000", "USDT"));
+  EXPECT_EQ(marketFilters.sanitizePrice(MonetaryAmount("0.001", "USDT")), MonetaryAmount("0.01", "USDT"));
+}
+
+TEST_F(BinanceMarketFiltersTest, SanitizeVolume) {
+  const MonetaryAmount price("30000", "USDT");
+
+  EXPECT_EQ(marketFilters.sanitizeVolume(MonetaryAmount("0.0123456", "BTC"), price, false),
+            MonetaryAmount("0.01234", "BTC"));
+
+  // Min notional of 5 USDT
+  EXPECT_EQ(marketFilters.sanitizeVolume(MonetaryAmount("0.0001", "BTC"), price, false),
+            MonetaryAmount("0.00017", "BTC"));
+
+  // Market lot size only applies to taker orders
+  EXPECT_EQ(marketFilters.sanitizeVolume(MonetaryAmount("150", "BTC"), price, false), MonetaryAmount("150", "BTC"));
+  EXPECT_EQ(marketFilters.sanitizeVolume(MonetaryAmount("150", "BTC"), price, true), MonetaryAmount("100", "BTC"));
+}
+
+TEST_F(BinanceMarketFiltersTest, TakerNotionalAvgPriceMins) {
+  EXPECT_EQ(marketFilters.takerNotionalAvgPriceMins(), std::optional<int32_t>(5));
+  EXPECT_EQ(BinanceMarketFilters(market, Symbol{}).takerNotionalAvgPriceMins(), std::nullopt);
+}
+
+TEST_F(BinanceMarketFiltersTest, MapFindAndArchive) {
+  const Market otherMarket("ETH", "BTC");
+  vector<BinanceMarketFilters> marketFiltersVector;
+  marketFiltersVector.push_back(marketFilters);
+  marketFiltersVector.emplace_back(otherMarket, Symbol{});
+  const BinanceMarketFiltersMap marketFiltersMap(std::move(marketFiltersVector));
+
+  ASSERT_NE(marketFiltersMap.find(market), nullptr);
+  EXPECT_EQ(marketFiltersMap.get(market), marketFilters);
+  EXPECT_EQ(marketFiltersMap.get(otherMarket).market(), otherMarket);
+  EXPECT_EQ(marketFiltersMap.find(Market("XRP", "BTC")), nullptr);
+  EXPECT_THROW(marketFiltersMap.get(Market("XRP", "BTC")), exception);
+
+  MetadataCacheWriter writer;
+  writer(marketFiltersMap);
+  MetadataCacheReader reader(writer.data());
+  EXPECT_EQ(reader.read<BinanceMarketFiltersMap>(), marketFiltersMap);
+}
+
+}  // namespace cct::api
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <type_traits>
 
@@ -10,12 +11,14 @@
 #include "currencycode.hpp"
 #include "currencyexchange.hpp"
 #include "currencyexchangeflatset.hpp"
+#include "enum-string.hpp"
 #include "exchange-config.hpp"
 #include "exchange-name-enum.hpp"
 #include "exchangename.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangepublicapi.hpp"
 #include "exchangepublicapitypes.hpp"
+#include "market-order-book-vector.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
 #include "monetaryamount.hpp"
@@ -24,6 +27,12 @@
 
 namespace cct {
 
+namespace api {
+class APIKey;
+}  // namespace api
+
+class ExchangePool;
+
 class Exchange final : public CacheFileUpdatorInterface {
  public:
   using ExchangePublic = api::ExchangePublic;
@@ -36,9 +45,19 @@ class Exchange final : public CacheFileUpdatorInterface {
   Exchange(const schema::ExchangeConfig &exchangeConfig, ExchangePublic &exchangePublic,
            std::unique_ptr<ExchangePrivate> exchangePrivate);
 
-  std::string_view name() const { return apiPublic().name(); }
-  ExchangeNameEnum exchangeNameEnum() const { return apiPublic().exchangeNameEnum(); }
-  std::string_view keyName() const { return apiPrivate().keyName(); }
+  /// Builds a Exchange whose public and private (if 'pApiKey' is not null) exchanges are created by 'exchangePool' at
+  /// first use. The public exchange is shared between all the accounts of the same exchange.
+  Exchange(const schema::ExchangeConfig &exchangeConfig, ExchangeNameEnum exchangeNameEnum, ExchangePool &exchangePool,
+           const api::APIKey *pApiKey = nullptr);
+
+  std::string_view name() const { return EnumToString(_exchangeNameEnum); }
+  ExchangeNameEnum exchangeNameEnum() const { return _exchangeNameEnum; }
+  std::string_view keyName() const {
+    if (hasPrivateAPI()) {
+      return _keyName;
+    }
+    throw exception("No private key associated to exchange {}", name());
+  }
 
   std::size_t publicExchangePos() const;
 
@@ -46,31 +65,27 @@ class Exchange final : public CacheFileUpdatorInterface {
     return ExchangeName(exchangeNameEnum(), hasPrivateAPI() ? keyName() : std::string_view());
   }
 
-  ExchangePublic &apiPublic() { return *_pExchangePublic; }
-  const ExchangePublic &apiPublic() const { return *_pExchangePublic; }
-
-  ExchangePrivate &apiPrivate() {
-    if (hasPrivateAPI()) {
-      return *_exchangePrivate;
-    }
-    throw exception("No private key associated to exchange {}", name());
+  ExchangePublic &apiPublic() { return _pExchangePublic == nullptr ? lazyApiPublic() : *_pExchangePublic; }
+  const ExchangePublic &apiPublic() const {
+    return _pExchangePublic == nullptr ? lazyApiPublic() : *_pExchangePublic;
   }
 
-  const ExchangePrivate &apiPrivate() const {
-    if (hasPrivateAPI()) {
-      return *_exchangePrivate;
-    }
-    throw exception("No private key associated to exchange {}", name());
-  }
+  /// Tells whether the public exchange has already been created (it always is for exchanges not created lazily).
+  bool isApiPublicCreated() const;
+
+  /// Creates the private exchange at first call for exchanges created lazily.
+  /// Like all private queries, it should not be called concurrently for the same Exchange.
+  ExchangePrivate &apiPrivate() { return *getOrCreateApiPrivate(); }
+  const ExchangePrivate &apiPrivate() const { return *getOrCreateApiPrivate(); }
 
   const schema::ExchangeConfig &exchangeConfig() const { return *_pExchangeConfig; }
 
-  bool hasPrivateAPI() const { return static_cast<bool>(_exchangePrivate); }
+  bool hasPrivateAPI() const { return _exchangePrivate || _pApiKey != nullptr; }
 
   bool healthCheck() { return apiPublic().healthCheck(); }
 
   CurrencyExchangeFlatSet queryTradableCurrencies() {
-    return hasPrivateAPI() ? _exchangePrivate->queryTradableCurrencies() : apiPublic().queryTradableCurrencies();
+    return hasPrivateAPI() ? apiPrivate().queryTradableCurrencies() : apiPublic().queryTradableCurrencies();
   }
 
   CurrencyExchange convertStdCurrencyToCurrencyExchange(CurrencyCode currencyCode) {
@@ -82,11 +97,11 @@ class Exchange final : public CacheFileUpdatorInterface {
   MarketPriceMap queryAllPrices() { return apiPublic().queryAllPrices(); }
 
   MonetaryAmountByCurrencySet queryWithdrawalFees() {
-    return hasPrivateAPI() ? _exchangePrivate->queryWithdrawalFees() : apiPublic().queryWithdrawalFees();
+    return hasPrivateAPI() ? apiPrivate().queryWithdrawalFees() : apiPublic().queryWithdrawalFees();
   }
 
   std::optional<MonetaryAmount> queryWithdrawalFee(CurrencyCode currencyCode) {
-    return hasPrivateAPI() ? _exchangePrivate->queryWithdrawalFee(currencyCode)
+    return hasPrivateAPI() ? apiPrivate().queryWithdrawalFee(currencyCode)
                            : apiPublic().queryWithdrawalFee(currencyCode);
   }
 
@@ -96,6 +111,11 @@ class Exchange final : public CacheFileUpdatorInterface {
 
   MarketOrderBook getOrderBook(Market mk, int depth = ExchangePublic::kDefaultDepth);
 
+  /// Retrieve the order books of given markets, in the same order, with as few requests as possible.
+  MarketOrderBookVector getOrderBooks(std::span<const Market> markets, int depth = ExchangePublic::kDefaultDepth) {
+    return apiPublic().getOrderBooks(markets, depth);
+  }
+
   MonetaryAmount queryLast24hVolume(Market mk) { return apiPublic().queryLast24hVolume(mk); }
 
   /// Retrieve an ordered vector of recent last trades
@@ -115,9 +135,17 @@ class Exchange final : public CacheFileUpdatorInterface {
   void updateCacheFile() const override;
 
  private:
+  ExchangePublic &lazyApiPublic() const;
+
+  ExchangePrivate *getOrCreateApiPrivate() const;
+
   ExchangePublic *_pExchangePublic;
-  std::unique_ptr<ExchangePrivate> _exchangePrivate;
+  mutable std::unique_ptr<ExchangePrivate> _exchangePrivate;
   const schema::ExchangeConfig *_pExchangeConfig;
+  ExchangePool *_pExchangePool = nullptr;  // only set for exchanges created lazily
+  const api::APIKey *_pApiKey = nullptr;   // only set for exchanges created lazily with a private key
+  std::string_view _keyName;
+  ExchangeNameEnum _exchangeNameEnum;
 };
 
 }  // namespace cct
@@ -1,17 +1,16 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <span>
 
-#include "binancepublicapi.hpp"
-#include "bithumbpublicapi.hpp"
 #include "cct_vector.hpp"
+#include "exchange-name-enum.hpp"
 #include "exchange.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangepublicapi.hpp"
-#include "huobipublicapi.hpp"
-#include "krakenpublicapi.hpp"
-#include "kucoinpublicapi.hpp"
-#include "upbitpublicapi.hpp"
 
 namespace cct {
 
@@ -19,35 +18,82 @@ class CoincenterInfo;
 class FiatConverter;
 
 namespace api {
+class APIKey;
 class CommonAPI;
 class APIKeysProvider;
 }  // namespace api
 
+/// Creates the public and private exchanges of an ExchangePool.
+class ExchangeFactory {
+ public:
+  virtual ~ExchangeFactory() = default;
+
+  virtual std::unique_ptr<api::ExchangePublic> createExchangePublic(ExchangeNameEnum exchangeNameEnum) = 0;
+
+  virtual std::unique_ptr<api::ExchangePrivate> createExchangePrivate(api::ExchangePublic& exchangePublic,
+                                                                      const api::APIKey& apiKey) = 0;
+};
+
+/// Owns all the exchanges enabled in the configuration, one per account (or a public only one for exchanges without
+/// any key).
+/// Public and private exchanges (and their HTTP handles) are only created at first use, so that a command touching a
+/// single exchange does not pay for the construction of all the others.
+/// Exceptions are private exchanges whose api key should be validated, as it needs to be done before selection.
 class ExchangePool {
  public:
+  /// Creates a pool of the real exchanges.
   ExchangePool(const CoincenterInfo& coincenterInfo, FiatConverter& fiatConverter, api::CommonAPI& commonAPI,
                const api::APIKeysProvider& apiKeyProvider);
 
+  /// Creates a pool whose exchanges are created by given factory, which should outlive the pool.
+  ExchangePool(const CoincenterInfo& coincenterInfo, const api::APIKeysProvider& apiKeyProvider,
+               ExchangeFactory& exchangeFactory);
+
+  ExchangePool(const ExchangePool&) = delete;
+  ExchangePool(ExchangePool&&) = delete;
+  ExchangePool& operator=(const ExchangePool&) = delete;
+  ExchangePool& operator=(ExchangePool&&) = delete;
+
+  ~ExchangePool();
+
   std::span<Exchange> exchanges() { return _exchanges; }
   std::span<const Exchange> exchanges() const { return _exchanges; }
 
+  /// Get the public exchange of given exchange, creating it at first call.
+  /// Thread safe.
+  api::ExchangePublic& exchangePublic(ExchangeNameEnum exchangeNameEnum);
+
+  /// Tells whether the public exchange of given exchange has already been created.
+  /// Thread safe.
+  bool isExchangePublicCreated(ExchangeNameEnum exchangeNameEnum) const {
+    return _exchangePublicPtrs[static_cast<int>(exchangeNameEnum)].load(std::memory_order_acquire) != nullptr;
+  }
+
+  /// Creates a new private exchange for given api key (and its public exchange if not already created).
+  /// Thread safe. Private exchanges register their cached results in the vault of their public exchange, which is not
+  /// thread safe, so private exchanges creations are serialized.
+  std::unique_ptr<api::ExchangePrivate> createExchangePrivate(ExchangeNameEnum exchangeNameEnum,
+                                                              const api::APIKey& apiKey);
+
  private:
   using ExchangeVector = vector<Exchange>;
 
+  ExchangePool(const CoincenterInfo& coincenterInfo, const api::APIKeysProvider& apiKeyProvider,
+               std::unique_ptr<ExchangeFactory> pOwnedExchangeFactory, ExchangeFactory* pExchangeFactory);
+
   const CoincenterInfo& _coincenterInfo;
-  FiatConverter& _fiatConverter;
-  api::CommonAPI& _commonAPI;
   const api::APIKeysProvider& _apiKeyProvider;
+  std::unique_ptr<ExchangeFactory> _pOwnedExchangeFactory;  // only set for the pool of the real exchanges
+  ExchangeFactory& _exchangeFactory;
 
-  // Public exchanges
-  api::BinancePublic _binancePublic;
-  api::BithumbPublic _bithumbPublic;
-  api::HuobiPublic _huobiPublic;
-  api::KrakenPublic _krakenPublic;
-  api::KucoinPublic _kucoinPublic;
-  api::UpbitPublic _upbitPublic;
+  // Public exchanges, created at first use. Pointers are published atomically so that the fast path does not lock.
+  std::array<std::unique_ptr<api::ExchangePublic>, kNbSupportedExchanges> _exchangePublics;
+  std::array<std::atomic<api::ExchangePublic*>, kNbSupportedExchanges> _exchangePublicPtrs{};
+  std::mutex _exchangePublicsMutex;
+  std::mutex _exchangePrivatesMutex;
 
+  // Declared last as private exchanges refer to public ones
   ExchangeVector _exchanges;
 };
 
-}  // namespace cct
\ No newline at end of file
+}  // namespace cct
@@ -4,9 +4,12 @@
 #include <memory>
 #include <utility>
 
+#include "apikey.hpp"
+#include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "currencycode.hpp"
 #include "currencyexchangeflatset.hpp"
+#include "exchangepool.hpp"
 #include "exchangeprivateapi.hpp"
 #include "exchangepublicapi.hpp"
 #include "marketorderbook.hpp"
@@ -21,7 +24,34 @@ Exchange::Exchange(const schema::ExchangeConfig &exchangeConfig, ExchangePublic
                    std::unique_ptr<ExchangePrivate> exchangePrivate)
     : _pExchangePublic(std::addressof(exchangePublic)),
       _exchangePrivate(std::move(exchangePrivate)),
-      _pExchangeConfig(std::addressof(exchangeConfig)) {}
+      _pExchangeConfig(std::addressof(exchangeConfig)),
+      _keyName(_exchangePrivate ? _exchangePrivate->keyName() : std::string_view()),
+      _exchangeNameEnum(exchangePublic.exchangeNameEnum()) {}
+
+Exchange::Exchange(const schema::ExchangeConfig &exchangeConfig, ExchangeNameEnum exchangeNameEnum,
+                   ExchangePool &exchangePool, const api::APIKey *pApiKey)
+    : _pExchangePublic(nullptr),
+      _pExchangeConfig(std::addressof(exchangeConfig)),
+      _pExchangePool(std::addressof(exchangePool)),
+      _pApiKey(pApiKey),
+      _keyName(pApiKey == nullptr ? std::string_view() : pApiKey->name()),
+      _exchangeNameEnum(exchangeNameEnum) {}
+
+bool Exchange::isApiPublicCreated() const {
+  return _pExchangePublic != nullptr || _pExchangePool->isExchangePublicCreated(_exchangeNameEnum);
+}
+
+Exchange::ExchangePublic &Exchange::lazyApiPublic() const { return _pExchangePool->exchangePublic(_exchangeNameEnum); }
+
+Exchange::ExchangePrivate *Exchange::getOrCreateApiPrivate() const {
+  if (!_exchangePrivate) {
+    if (_pApiKey == nullptr) {
+      throw exception("No private key associated to exchange {}", name());
+    }
+    _exchangePrivate = _pExchangePool->createExchangePrivate(_exchangeNameEnum, *_pApiKey);
+  }
+  return _exchangePrivate.get();
+}
 
 std::size_t Exchange::publicExchangePos() const { return static_cast<std::size_t>(exchangeNameEnum()); }
 
@@ -52,7 +82,10 @@ MarketOrderBook Exchange::getOrderBook(Market mk, int depth) { return apiPublic(
 PublicTradeVector Exchange::getLastTrades(Market mk, int nbTrades) { return apiPublic().getLastTrades(mk, nbTrades); }
 
 void Exchange::updateCacheFile() const {
-  apiPublic().updateCacheFile();
+  // Exchanges which have not been used do not have anything to write
+  if (isApiPublicCreated()) {
+    apiPublic().updateCacheFile();
+  }
   if (_exchangePrivate) {
     _exchangePrivate->updateCacheFile();
   }
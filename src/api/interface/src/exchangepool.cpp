@@ -1,12 +1,15 @@
 #include "exchangepool.hpp"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string_view>
 #include <utility>
 
 #include "apikey.hpp"
 #include "apikeysprovider.hpp"
 #include "binanceprivateapi.hpp"
+#include "binancepublicapi.hpp"
 #include "bithumbprivateapi.hpp"
 #include "bithumbpublicapi.hpp"
 #include "cct_exception.hpp"
@@ -17,41 +20,94 @@
 #include "exchangeprivateapi.hpp"
 #include "exchangepublicapi.hpp"
 #include "huobiprivateapi.hpp"
+#include "huobipublicapi.hpp"
 #include "krakenprivateapi.hpp"
+#include "krakenpublicapi.hpp"
 #include "kucoinprivateapi.hpp"
+#include "kucoinpublicapi.hpp"
 #include "upbitprivateapi.hpp"
+#include "upbitpublicapi.hpp"
 
 namespace cct {
+
+namespace {
+
+class RealExchangeFactory : public ExchangeFactory {
+ public:
+  RealExchangeFactory(const CoincenterInfo& coincenterInfo, FiatConverter& fiatConverter, api::CommonAPI& commonAPI)
+      : _coincenterInfo(coincenterInfo), _fiatConverter(fiatConverter), _commonAPI(commonAPI) {}
+
+  std::unique_ptr<api::ExchangePublic> createExchangePublic(ExchangeNameEnum exchangeNameEnum) override {
+    switch (exchangeNameEnum) {
+      case ExchangeNameEnum::binance:
+        return std::make_unique<api::BinancePublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      case ExchangeNameEnum::bithumb:
+        return std::make_unique<api::BithumbPublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      case ExchangeNameEnum::huobi:
+        return std::make_unique<api::HuobiPublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      case ExchangeNameEnum::kraken:
+        return std::make_unique<api::KrakenPublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      case ExchangeNameEnum::kucoin:
+        return std::make_unique<api::KucoinPublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      case ExchangeNameEnum::upbit:
+        return std::make_unique<api::UpbitPublic>(_coincenterInfo, _fiatConverter, _commonAPI);
+      default:
+        throw exception("Should not happen, unsupported exchange {}", static_cast<int>(exchangeNameEnum));
+    }
+  }
+
+  std::unique_ptr<api::ExchangePrivate> createExchangePrivate(api::ExchangePublic& exchangePublic,
+                                                              const api::APIKey& apiKey) override {
+    switch (exchangePublic.exchangeNameEnum()) {
+      case ExchangeNameEnum::binance:
+        return std::make_unique<api::BinancePrivate>(_coincenterInfo, static_cast<api::BinancePublic&>(exchangePublic),
+                                                     apiKey);
+      case ExchangeNameEnum::bithumb:
+        return std::make_unique<api::BithumbPrivate>(_coincenterInfo, static_cast<api::BithumbPublic&>(exchangePublic),
+                                                     apiKey);
+      case ExchangeNameEnum::huobi:
+        return std::make_unique<api::HuobiPrivate>(_coincenterInfo, static_cast<api::HuobiPublic&>(exchangePublic),
+                                                   apiKey);
+      case ExchangeNameEnum::kraken:
+        return std::make_unique<api::KrakenPrivate>(_coincenterInfo, static_cast<api::KrakenPublic&>(exchangePublic),
+                                                    apiKey);
+      case ExchangeNameEnum::kucoin:
+        return std::make_unique<api::KucoinPrivate>(_coincenterInfo, static_cast<api::KucoinPublic&>(exchangePublic),
+                                                    apiKey);
+      case ExchangeNameEnum::upbit:
+        return std::make_unique<api::UpbitPrivate>(_coincenterInfo, static_cast<api::UpbitPublic&>(exchangePublic),
+                                                   apiKey);
+      default:
+        throw exception("Should not happen, unsupported exchange {}",
+                        static_cast<int>(exchangePublic.exchangeNameEnum()));
+    }
+  }
+
+ private:
+  const CoincenterInfo& _coincenterInfo;
+  FiatConverter& _fiatConverter;
+  api::CommonAPI& _commonAPI;
+};
+
+}  // namespace
+
 ExchangePool::ExchangePool(const CoincenterInfo& coincenterInfo, FiatConverter& fiatConverter,
                            api::CommonAPI& commonAPI, const api::APIKeysProvider& apiKeyProvider)
+    : ExchangePool(coincenterInfo, apiKeyProvider,
+                   std::make_unique<RealExchangeFactory>(coincenterInfo, fiatConverter, commonAPI), nullptr) {}
+
+ExchangePool::ExchangePool(const CoincenterInfo& coincenterInfo, const api::APIKeysProvider& apiKeyProvider,
+                           ExchangeFactory& exchangeFactory)
+    : ExchangePool(coincenterInfo, apiKeyProvider, nullptr, &exchangeFactory) {}
+
+ExchangePool::ExchangePool(const CoincenterInfo& coincenterInfo, const api::APIKeysProvider& apiKeyProvider,
+                           std::unique_ptr<ExchangeFactory> pOwnedExchangeFactory, ExchangeFactory* pExchangeFactory)
     : _coincenterInfo(coincenterInfo),
-      _fiatConverter(fiatConverter),
-      _commonAPI(commonAPI),
       _apiKeyProvider(apiKeyProvider),
-      _binancePublic(_coincenterInfo, _fiatConverter, _commonAPI),
-      _bithumbPublic(_coincenterInfo, _fiatConverter, _commonAPI),
-      _huobiPublic(_coincenterInfo, _fiatConverter, _commonAPI),
-      _krakenPublic(_coincenterInfo, _fiatConverter, _commonAPI),
-      _kucoinPublic(_coincenterInfo, _fiatConverter, _commonAPI),
-      _upbitPublic(_coincenterInfo, _fiatConverter, _commonAPI) {
+      _pOwnedExchangeFactory(std::move(pOwnedExchangeFactory)),
+      _exchangeFactory(pExchangeFactory == nullptr ? *_pOwnedExchangeFactory : *pExchangeFactory) {
   for (int exchangePos = 0; exchangePos < kNbSupportedExchanges; ++exchangePos) {
     ExchangeNameEnum exchangeNameEnum = static_cast<ExchangeNameEnum>(exchangePos);
-    api::ExchangePublic* exchangePublic;
-    if (exchangeNameEnum == ExchangeNameEnum::binance) {
-      exchangePublic = &_binancePublic;
-    } else if (exchangeNameEnum == ExchangeNameEnum::bithumb) {
-      exchangePublic = &_bithumbPublic;
-    } else if (exchangeNameEnum == ExchangeNameEnum::huobi) {
-      exchangePublic = &_huobiPublic;
-    } else if (exchangeNameEnum == ExchangeNameEnum::kraken) {
-      exchangePublic = &_krakenPublic;
-    } else if (exchangeNameEnum == ExchangeNameEnum::kucoin) {
-      exchangePublic = &_kucoinPublic;
-    } else if (exchangeNameEnum == ExchangeNameEnum::upbit) {
-      exchangePublic = &_upbitPublic;
-    } else {
-      throw exception("Should not happen, unsupported exchange pos {}", exchangePos);
-    }
 
     const auto& exchangeConfig = _coincenterInfo.exchangeConfig(exchangeNameEnum);
 
@@ -62,38 +118,25 @@ ExchangePool::ExchangePool(const CoincenterInfo& coincenterInfo, FiatConverter&
     const bool canUsePrivateExchange = _apiKeyProvider.hasAtLeastOneKey(exchangeNameEnum);
     if (canUsePrivateExchange) {
       for (std::string_view keyName : _apiKeyProvider.getKeyNames(exchangeNameEnum)) {
-        std::unique_ptr<api::ExchangePrivate> exchangePrivate;
         ExchangeName exchangeName(exchangeNameEnum, keyName);
         const api::APIKey& apiKey = _apiKeyProvider.get(exchangeName);
-        if (exchangePublic == &_binancePublic) {
-          exchangePrivate = std::make_unique<api::BinancePrivate>(_coincenterInfo, _binancePublic, apiKey);
-        } else if (exchangePublic == &_bithumbPublic) {
-          exchangePrivate = std::make_unique<api::BithumbPrivate>(_coincenterInfo, _bithumbPublic, apiKey);
-        } else if (exchangePublic == &_huobiPublic) {
-          exchangePrivate = std::make_unique<api::HuobiPrivate>(_coincenterInfo, _huobiPublic, apiKey);
-        } else if (exchangePublic == &_krakenPublic) {
-          exchangePrivate = std::make_unique<api::KrakenPrivate>(_coincenterInfo, _krakenPublic, apiKey);
-        } else if (exchangePublic == &_kucoinPublic) {
-          exchangePrivate = std::make_unique<api::KucoinPrivate>(_coincenterInfo, _kucoinPublic, apiKey);
-        } else if (exchangePublic == &_upbitPublic) {
-          exchangePrivate = std::make_unique<api::UpbitPrivate>(_coincenterInfo, _upbitPublic, apiKey);
-        } else {
-          throw exception("Should not happen");
-        }
 
         if (exchangeConfig.query.validateApiKey) {
+          // Validity of the key changes the set of selectable exchanges, it cannot be deferred
+          auto exchangePrivate = createExchangePrivate(exchangeNameEnum, apiKey);
           if (exchangePrivate->validateApiKey()) {
             log::info("{} api key is valid", exchangeName);
           } else {
             log::error("{} api key is invalid, do not consider it", exchangeName);
             continue;
           }
+          _exchanges.emplace_back(exchangeConfig, exchangePublic(exchangeNameEnum), std::move(exchangePrivate));
+        } else {
+          _exchanges.emplace_back(exchangeConfig, exchangeNameEnum, *this, &apiKey);
         }
-
-        _exchanges.emplace_back(exchangeConfig, *exchangePublic, std::move(exchangePrivate));
       }
     } else {
-      _exchanges.emplace_back(exchangeConfig, *exchangePublic);
+      _exchanges.emplace_back(exchangeConfig, exchangeNameEnum, *this);
     }
   }
   if (_exchanges.empty()) {
@@ -103,4 +146,35 @@ ExchangePool::ExchangePool(const CoincenterInfo& coincenterInfo, FiatConverter&
   }
 }
 
+api::ExchangePublic& ExchangePool::exchangePublic(ExchangeNameEnum exchangeNameEnum) {
+  const auto exchangePos = static_cast<int>(exchangeNameEnum);
+  auto& exchangePublicPtr = _exchangePublicPtrs[exchangePos];
+  api::ExchangePublic* pExchangePublic = exchangePublicPtr.load(std::memory_order_acquire);
+  if (pExchangePublic != nullptr) {
+    return *pExchangePublic;
+  }
+
+  std::lock_guard<std::mutex> guard(_exchangePublicsMutex);
+  pExchangePublic = exchangePublicPtr.load(std::memory_order_relaxed);
+  if (pExchangePublic == nullptr) {
+    log::debug("Creating {} public exchange", EnumToString(exchangeNameEnum));
+    auto& newExchangePublic = _exchangePublics[exchangePos];
+    newExchangePublic = _exchangeFactory.createExchangePublic(exchangeNameEnum);
+    pExchangePublic = newExchangePublic.get();
+    exchangePublicPtr.store(pExchangePublic, std::memory_order_release);
+  }
+  return *pExchangePublic;
+}
+
+ExchangePool::~ExchangePool() = default;
+
+std::unique_ptr<api::ExchangePrivate> ExchangePool::createExchangePrivate(ExchangeNameEnum exchangeNameEnum,
+                                                                          const api::APIKey& apiKey) {
+  api::ExchangePublic& publicExchange = exchangePublic(exchangeNameEnum);
+
+  std::lock_guard<std::mutex> guard(_exchangePrivatesMutex);
+  log::debug("Creating {} private exchange for key {}", EnumToString(exchangeNameEnum), apiKey.name());
+  return _exchangeFactory.createExchangePrivate(publicExchange, apiKey);
+}
+
 }  // namespace cct
@@ -0,0 +1,197 @@
+#include "exchangepool.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include "apikey.hpp"
+#include "apikeysprovider.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "coincenterinfo.hpp"
+#include "commonapi.hpp"
+#include "default-data-dir.hpp"
+#include "exchange-name-enum.hpp"
+#include "exchange-names.hpp"
+#include "exchange.hpp"
+#include "exchangename.hpp"
+#include "exchangeprivateapi_mock.hpp"
+#include "exchangepublicapi_mock.hpp"
+#include "exchangeretriever.hpp"
+#include "fiatconverter.hpp"
+#include "loadconfiguration.hpp"
+#include "reader.hpp"
+#include "runmodes.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+namespace {
+
+class MockExchangeFactory : public ExchangeFactory {
+ public:
+  MockExchangeFactory(const CoincenterInfo &coincenterInfo, FiatConverter &fiatConverter, api::CommonAPI &commonAPI)
+      : _coincenterInfo(coincenterInfo), _fiatConverter(fiatConverter), _commonAPI(commonAPI) {}
+
+  std::unique_ptr<api::ExchangePublic> createExchangePublic(ExchangeNameEnum exchangeNameEnum) override {
+    ++nbCreatedPublics;
+    return std::make_unique<api::MockExchangePublic>(exchangeNameEnum, _fiatConverter, _commonAPI, _coincenterInfo);
+  }
+
+  std::unique_ptr<api::ExchangePrivate> createExchangePrivate(api::ExchangePublic &exchangePublic,
+                                                              const api::APIKey &apiKey) override {
+    const int nbCurrentCreations = ++_nbCurrentPrivateCreations;
+    int maxNb = maxNbConcurrentPrivateCreations.load();
+    while (maxNb < nbCurrentCreations &&
+           !maxNbConcurrentPrivateCreations.compare_exchange_weak(maxNb, nbCurrentCreations)) {
+    }
+
+    // Leaves time to other threads to create their private exchange concurrently, if they can
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    auto exchangePrivate =
+        std::make_unique<::testing::NiceMock<api::MockExchangePrivate>>(exchangePublic, _coincenterInfo, apiKey);
+    ON_CALL(*exchangePrivate, validateApiKey()).WillByDefault(::testing::Return(isApiKeyValid));
+
+    --_nbCurrentPrivateCreations;
+    ++nbCreatedPrivates;
+    return exchangePrivate;
+  }
+
+  std::atomic<int> nbCreatedPublics{};
+  std::atomic<int> nbCreatedPrivates{};
+  std::atomic<int> maxNbConcurrentPrivateCreations{};
+  bool isApiKeyValid = true;
+
+ private:
+  const CoincenterInfo &_coincenterInfo;
+  FiatConverter &_fiatConverter;
+  api::CommonAPI &_commonAPI;
+  std::atomic<int> _nbCurrentPrivateCreations{};
+};
+
+}  // namespace
+
+class ExchangePoolTest : public ::testing::Test {
+ protected:
+  explicit ExchangePoolTest(const LoadConfiguration &loadConfiguration = LoadConfiguration(
+                                kDefaultDataDir, LoadConfiguration::ExchangeConfigFileType::kTest))
+      : coincenterInfo(settings::RunMode::kTestKeys, loadConfiguration) {}
+
+  CoincenterInfo coincenterInfo;
+  api::CommonAPI commonAPI{coincenterInfo, Duration::max()};
+  // max to avoid real Fiat converter queries
+  FiatConverter fiatConverter{coincenterInfo, Duration::max(), Reader(), Reader()};
+  api::APIKeysProvider apiKeysProvider{kDefaultDataDir, settings::RunMode::kTestKeys};
+  MockExchangeFactory exchangeFactory{coincenterInfo, fiatConverter, commonAPI};
+};
+
+TEST_F(ExchangePoolTest, ExchangesCreatedAtFirstUse) {
+  ExchangePool exchangePool(coincenterInfo, apiKeysProvider, exchangeFactory);
+
+  // Selection only needs the exchange names and keys
+  vector<string> exchangeNames;
+  std::ranges::transform(exchangePool.exchanges(), std::back_inserter(exchangeNames),
+                         [](const Exchange &exchange) { return string(exchange.createExchangeName().str()); });
+  EXPECT_EQ(exchangeNames,
+            vector<string>({"binance", "bithumb_cha", "huobi", "kraken_jack", "kucoin_jack", "upbit_cha"}));
+
+  ExchangeRetriever exchangeRetriever(exchangePool.exchanges());
+  auto selectedExchanges =
+      exchangeRetriever.select(ExchangeRetriever::Order::kInitial, ExchangeNames{ExchangeName("kraken")});
+  ASSERT_EQ(selectedExchanges.size(), 1U);
+  EXPECT_EQ(selectedExchanges.front()->keyName(), "jack");
+  EXPECT_EQ(exchangeRetriever
+                .select(ExchangeRetriever::Order::kInitial, ExchangeNames{},
+                        ExchangeRetriever::Filter::kWithAccountWhenEmpty)
+                .size(),
+            4U);
+
+  EXPECT_EQ(exchangeFactory.nbCreatedPublics, 0);
+  EXPECT_EQ(exchangeFactory.nbCreatedPrivates, 0);
+  EXPECT_TRUE(std::ranges::none_of(exchangePool.exchanges(), &Exchange::isApiPublicCreated));
+
+  Exchange &kraken = *selectedExchanges.front();
+  kraken.apiPublic();
+  EXPECT_EQ(exchangeFactory.nbCreatedPublics, 1);
+  EXPECT_EQ(std::ranges::count_if(exchangePool.exchanges(), &Exchange::isApiPublicCreated), 1);
+  EXPECT_TRUE(kraken.isApiPublicCreated());
+
+  // Private exchange reuses the public exchange already created
+  kraken.apiPrivate();
+  kraken.apiPrivate();
+  EXPECT_EQ(exchangeFactory.nbCreatedPublics, 1);
+  EXPECT_EQ(exchangeFactory.nbCreatedPrivates, 1);
+  EXPECT_EQ(&kraken.apiPublic(), &exchangePool.exchangePublic(ExchangeNameEnum::kraken));
+}
+
+TEST_F(ExchangePoolTest, ConcurrentPrivateCreationsAreSerialized) {
+  ExchangePool exchangePool(coincenterInfo, apiKeysProvider, exchangeFactory);
+
+  // Several accounts of the same exchange queried in parallel share the same public exchange
+  const api::APIKey &apiKey = apiKeysProvider.get(ExchangeName(ExchangeNameEnum::kraken, "jack"));
+  static constexpr int kNbThreads = 8;
+  vector<std::thread> threads;
+  for (int threadPos = 0; threadPos < kNbThreads; ++threadPos) {
+    threads.emplace_back([&exchangePool, &apiKey] {
+      EXPECT_NE(exchangePool.createExchangePrivate(ExchangeNameEnum::kraken, apiKey), nullptr);
+    });
+  }
+  std::ranges::for_each(threads, [](std::thread &thread) { thread.join(); });
+
+  EXPECT_EQ(exchangeFactory.nbCreatedPublics, 1);
+  EXPECT_EQ(exchangeFactory.nbCreatedPrivates, kNbThreads);
+  EXPECT_EQ(exchangeFactory.maxNbConcurrentPrivateCreations, 1);
+}
+
+namespace {
+std::string_view CreateDataDirWithValidateApiKey() {
+  // Only kraken has its api key validated
+  static const auto kDataDir = std::filesystem::temp_directory_path() / "coincenter-exchangepool-test";
+  static const string kDataDirStr = kDataDir.string();
+  std::filesystem::create_directories(kDataDir / "static");
+  std::ofstream(kDataDir / "static" / LoadConfiguration::kProdDefaultExchangeConfigFile)
+      << R"({"general": {"default": {"enabled": true}}, "query": {"exchange": {"kraken": {"validateApiKey": true}}}})";
+  return kDataDirStr;
+}
+}  // namespace
+
+class ExchangePoolValidateApiKeyTest : public ExchangePoolTest {
+ protected:
+  ExchangePoolValidateApiKeyTest()
+      : ExchangePoolTest(
+            LoadConfiguration(CreateDataDirWithValidateApiKey(), LoadConfiguration::ExchangeConfigFileType::kProd)) {}
+};
+
+TEST_F(ExchangePoolValidateApiKeyTest, ValidApiKey) {
+  ExchangePool exchangePool(coincenterInfo, apiKeysProvider, exchangeFactory);
+
+  // Private exchange is created and its key validated at construction
+  EXPECT_EQ(exchangeFactory.nbCreatedPublics, 1);
+  EXPECT_EQ(exchangeFactory.nbCreatedPrivates, 1);
+  EXPECT_TRUE(exchangePool.isExchangePublicCreated(ExchangeNameEnum::kraken));
+  EXPECT_EQ(exchangePool.exchanges().size(), 6U);
+}
+
+TEST_F(ExchangePoolValidateApiKeyTest, InvalidApiKey) {
+  exchangeFactory.isApiKeyValid = false;
+
+  ExchangePool exchangePool(coincenterInfo, apiKeysProvider, exchangeFactory);
+
+  EXPECT_EQ(exchangeFactory.nbCreatedPrivates, 1);
+  EXPECT_EQ(exchangePool.exchanges().size(), 5U);
+  EXPECT_TRUE(std::ranges::none_of(exchangePool.exchanges(), [](const Exchange &exchange) {
+    return exchange.exchangeNameEnum() == ExchangeNameEnum::kraken;
+  }));
+}
+
+}  // namespace cct
@@ -44,7 +44,8 @@ string File::readAll() const {
   log::debug("Opening file {} for reading", _filePath);
   string data;
   if (_ifError == IfError::kThrow || std::filesystem::exists(_filePath.c_str())) {
-    std::ifstream file(_filePath.c_str());
+    // Binary mode so that binary files are read as is on all platforms
+    std::ifstream file(_filePath.c_str(), std::ios_base::in | std::ios_base::binary);
     if (!file) {
       throw exception("Unable to open {} for reading", _filePath);
     }
@@ -65,7 +66,7 @@ int File::write(std::string_view data, Writer::Mode mode) const {
     return 0;
   }
   log::debug("Opening file {} for writing", _filePath);
-  auto openMode = mode == Writer::Mode::FromStart ? std::ios_base::out : std::ios_base::app;
+  auto openMode = (mode == Writer::Mode::FromStart ? std::ios_base::out : std::ios_base::app) | std::ios_base::binary;
   std::ofstream fileOfStream(_filePath.c_str(), openMode);
   if (!fileOfStream) {
     if (_ifError == IfError::kThrow) {
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "curlpostdata.hpp"
+
+namespace cct {
+namespace {
+
+// Typical parameters of a signed order placement request
+constexpr std::array<std::pair<std::string_view, std::string_view>, 8> kKeyValues{{{"symbol", "BTCUSDT"},
+                                                                                    {"side", "BUY"},
+                                                                                    {"type", "LIMIT"},
+                                                                                    {"timeInForce", "GTC"},
+                                                                                    {"quantity", "0.00123"},
+                                                                                    {"price", "30124.51"},
+                                                                                    {"recvWindow", "5000"},
+                                                                                    {"timestamp", "1699999999999"}}};
+
+void FlatKeyValueStringSetNewKeys(benchmark::State &state) {
+  for (auto _ : state) {
+    CurlPostData postData;
+    for (const auto &[key, value] : kKeyValues) {
+      postData.set(key, value);
+    }
+    benchmark::DoNotOptimize(postData);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kKeyValues.size()));
+}
+BENCHMARK(FlatKeyValueStringSetNewKeys);
+
+void FlatKeyValueStringSetExistingKey(benchmark::State &state) {
+  CurlPostData postData;
+  for (const auto &[key, value] : kKeyValues) {
+    postData.set(key, value);
+  }
+  static constexpr std::array<std::string_view, 2> kPrices{"30124.5", "30124.51234"};
+  int pos = 0;
+  for (auto _ : state) {
+    // Changes size of the value to force a move of the rest of the data
+    postData.set("price", kPrices[pos]);
+    pos = 1 - pos;
+    benchmark::DoNotOptimize(postData);
+  }
+}
+BENCHMARK(FlatKeyValueStringSetExistingKey);
+
+void FlatKeyValueStringGet(benchmark::State &state) {
+  CurlPostData postData;
+  for (const auto &[key, value] : kKeyValues) {
+    postData.set(key, value);
+  }
+  for (auto _ : state) {
+    for (const auto &[key, value] : kKeyValues) {
+      benchmark::DoNotOptimize(postData.get(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kKeyValues.size()));
+}
+BENCHMARK(FlatKeyValueStringGet);
+
+}  // namespace
+}  // namespace cct
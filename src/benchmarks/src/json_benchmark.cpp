@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+
+#include "binance-schema.hpp"
+#include "cct_format.hpp"
+#include "cct_string.hpp"
+#include "read-json.hpp"
+
+namespace cct {
+namespace {
+
+/// Builds a payload in the same format as Binance /api/v3/depth responses, with given number of lines per side.
+string CreateBinanceOrderBookPayload(int depth) {
+  string payload(R"({"lastUpdateId":48812736171,"bids":[)");
+  for (int pos = 0; pos < depth; ++pos) {
+    format_to(std::back_inserter(payload), R"({}["{}.{:02}000000","{}.{:05}000"])", pos == 0 ? "" : ",", 30124 - pos,
+              (pos * 37) % 100, pos % 10, (pos * 7919) % 100000);
+  }
+  payload.append(R"(],"asks":[)");
+  for (int pos = 0; pos < depth; ++pos) {
+    format_to(std::back_inserter(payload), R"({}["{}.{:02}000000","{}.{:05}000"])", pos == 0 ? "" : ",", 30125 + pos,
+              (pos * 37) % 100, pos % 10, (pos * 7919) % 100000);
+  }
+  payload.append("]}");
+  return payload;
+}
+
+/// Builds a payload in the same format as Binance /api/v3/ticker/bookTicker responses, with given number of symbols.
+string CreateBinanceBookTickerPayload(int nbSymbols) {
+  string payload("[");
+  for (int pos = 0; pos < nbSymbols; ++pos) {
+    format_to(std::back_inserter(payload),
+              R"({}{{"symbol":"CUR{}USDT","bidPrice":"{}.{:04}0000","bidQty":"{}.{:03}00000",)"
+              R"("askPrice":"{}.{:04}0000","askQty":"{}.{:03}00000"}})",
+              pos == 0 ? "" : ",", pos, pos, (pos * 31) % 10000, pos * 3, (pos * 17) % 1000, pos + 1,
+              (pos * 31) % 10000, pos * 2, (pos * 13) % 1000);
+  }
+  payload.push_back(']');
+  return payload;
+}
+
+void JsonParseBinanceOrderBook(benchmark::State &state) {
+  const string payload = CreateBinanceOrderBookPayload(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ReadJsonOrThrow<schema::binance::V3OrderBook, kPartialJsonOptions>(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+BENCHMARK(JsonParseBinanceOrderBook)->RangeMultiplier(10)->Range(10, 5000);
+
+void JsonParseBinanceBookTicker(benchmark::State &state) {
+  const string payload = CreateBinanceBookTickerPayload(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ReadJsonOrThrow<schema::binance::V3TickerBookTicker, kPartialJsonOptions>(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+}
+BENCHMARK(JsonParseBinanceBookTicker)->RangeMultiplier(10)->Range(10, 2000);
+
+}  // namespace
+}  // namespace cct
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "market.hpp"
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "order-book-line.hpp"
+#include "priceoptions.hpp"
+#include "priceoptionsdef.hpp"
+#include "timedef.hpp"
+#include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct {
+namespace {
+
+const Market kMarket("ETH", "EUR");
+
+/// Creates order book lines with given number of asks and bids around a 1302 EUR price, each one separated by
+/// 0.5 EUR, with amounts of variable sizes.
+MarketOrderBookLines CreateOrderBookLines(int depth) {
+  MarketOrderBookLines orderBookLines;
+  orderBookLines.reserve(2 * depth);
+
+  const MonetaryAmount priceStep("0.5", kMarket.quote());
+  MonetaryAmount askPrice(1302, kMarket.quote());
+  MonetaryAmount bidPrice = askPrice - priceStep;
+  for (int pos = 0; pos < depth; ++pos) {
+    const MonetaryAmount amount(static_cast<int64_t>(1 + ((pos * 7919) % 100000)), kMarket.base(), int8_t{4});
+    orderBookLines.pushAsk(amount, askPrice);
+    orderBookLines.pushBid(amount, bidPrice);
+    askPrice += priceStep;
+    bidPrice -= priceStep;
+  }
+  return orderBookLines;
+}
+
+/// Order book depths from 8 to 512, for both internal layouts of the order book.
+void DepthsAndLayouts(benchmark::internal::Benchmark *bench) {
+  bench->ArgsProduct({benchmark::CreateRange(8, 512, 4),
+                      {static_cast<int64_t>(MarketOrderBook::Layout::kLevels),
+                       static_cast<int64_t>(MarketOrderBook::Layout::kSideColumns)}});
+}
+
+class MarketOrderBookFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) override {
+    orderBookLines = CreateOrderBookLines(static_cast<int>(state.range(0)));
+    layout = static_cast<MarketOrderBook::Layout>(state.range(1));
+    marketOrderBook = MarketOrderBook(Clock::now(), kMarket, orderBookLines, VolAndPriNbDecimals(), layout);
+  }
+
+  void TearDown(const benchmark::State &) override {
+    orderBookLines.clear();
+    marketOrderBook = MarketOrderBook();
+  }
+
+ protected:
+  MarketOrderBookLines orderBookLines;
+  MarketOrderBook marketOrderBook;
+  MarketOrderBook::Layout layout{};
+};
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, Construct)(benchmark::State &state) {
+  const auto nowTime = Clock::now();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MarketOrderBook(nowTime, kMarket, orderBookLines, VolAndPriNbDecimals(), layout));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(orderBookLines.size()));
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, Construct)->Apply(DepthsAndLayouts);
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, ConvertBaseToQuote)(benchmark::State &state) {
+  const MonetaryAmount from("3.5", kMarket.base());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(marketOrderBook.convert(from));
+  }
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, ConvertBaseToQuote)->Apply(DepthsAndLayouts);
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, ConvertQuoteToBase)(benchmark::State &state) {
+  const MonetaryAmount from(5000, kMarket.quote());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(marketOrderBook.convert(from));
+  }
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, ConvertQuoteToBase)->Apply(DepthsAndLayouts);
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, ConvertWithPriceOptions)(benchmark::State &state) {
+  const MonetaryAmount from("3.5", kMarket.base());
+  const PriceOptions priceOptions(PriceStrategy::maker);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(marketOrderBook.convert(from, priceOptions));
+  }
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, ConvertWithPriceOptions)->Apply(DepthsAndLayouts);
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, ComputeMatchedParts)(benchmark::State &state) {
+  // Price far enough to match several lines of the order book
+  const MonetaryAmount amount(50, kMarket.base());
+  const MonetaryAmount buyPrice(1350, kMarket.quote());
+  const MonetaryAmount sellPrice(1250, kMarket.quote());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(marketOrderBook.computeMatchedParts(TradeSide::buy, amount, buyPrice));
+    benchmark::DoNotOptimize(marketOrderBook.computeMatchedParts(TradeSide::sell, amount, sellPrice));
+  }
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, ComputeMatchedParts)->Apply(DepthsAndLayouts);
+
+BENCHMARK_DEFINE_F(MarketOrderBookFixture, AvgPriceAndMatchedAmountTaker)(benchmark::State &state) {
+  const MonetaryAmount baseAmount(50, kMarket.base());
+  const MonetaryAmount quoteAmount(65000, kMarket.quote());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(marketOrderBook.avgPriceAndMatchedAmountTaker(baseAmount));
+    benchmark::DoNotOptimize(marketOrderBook.avgPriceAndMatchedAmountTaker(quoteAmount));
+  }
+}
+BENCHMARK_REGISTER_F(MarketOrderBookFixture, AvgPriceAndMatchedAmountTaker)->Apply(DepthsAndLayouts);
+
+}  // namespace
+}  // namespace cct
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "currencycode.hpp"
+#include "monetaryamount.hpp"
+
+namespace cct {
+namespace {
+
+constexpr std::array<std::string_view, 8> kAmountCurrencyStrs{
+    "0.00045 BTC", "1300.50EUR", "-56.10001267 ETH", "37", "0.000000000000001 SHIB", "1234567890.1234 USDT",
+    "-0.5 XRP",    "9999.99 KRW"};
+
+constexpr std::array<std::string_view, 8> kCurrencyStrs{"BTC", "eur", "ETH", "usdt", "SHIB", "XRP", "KRW", "MATIC"};
+
+void MonetaryAmountParseAmountAndCurrency(benchmark::State &state) {
+  for (auto _ : state) {
+    for (std::string_view str : kAmountCurrencyStrs) {
+      benchmark::DoNotOptimize(MonetaryAmount(str, MonetaryAmount::ParsingMode::kAmountOptional));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kAmountCurrencyStrs.size()));
+}
+BENCHMARK(MonetaryAmountParseAmountAndCurrency);
+
+void MonetaryAmountParseAmountWithCurrencyCode(benchmark::State &state) {
+  static constexpr std::array<std::string_view, 4> kAmountStrs{"0.00045", "1300.50", "-56.10001267",
+                                                               "1234567890.1234"};
+  const CurrencyCode cur("EUR");
+  for (auto _ : state) {
+    for (std::string_view str : kAmountStrs) {
+      benchmark::DoNotOptimize(MonetaryAmount(str, cur));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kAmountStrs.size()));
+}
+BENCHMARK(MonetaryAmountParseAmountWithCurrencyCode);
+
+void MonetaryAmountMultiply(benchmark::State &state) {
+  MonetaryAmount lhs("1300.50", "EUR");
+  MonetaryAmount rhs("0.00457812");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(lhs * rhs);
+  }
+}
+BENCHMARK(MonetaryAmountMultiply);
+
+void MonetaryAmountDivide(benchmark::State &state) {
+  MonetaryAmount lhs("1300.50", "EUR");
+  MonetaryAmount rhs("0.00457812", "ETH");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(lhs / rhs);
+  }
+}
+BENCHMARK(MonetaryAmountDivide);
+
+void MonetaryAmountRoundDecimals(benchmark::State &state) {
+  const MonetaryAmount initAmount("56.10001267", "ETH");
+  const auto roundType = static_cast<MonetaryAmount::RoundType>(state.range(0));
+  for (auto _ : state) {
+    MonetaryAmount ma = initAmount;
+    benchmark::DoNotOptimize(ma);
+    ma.round(int8_t{3}, roundType);
+    benchmark::DoNotOptimize(ma);
+  }
+}
+BENCHMARK(MonetaryAmountRoundDecimals)
+    ->Arg(static_cast<int64_t>(MonetaryAmount::RoundType::kDown))
+    ->Arg(static_cast<int64_t>(MonetaryAmount::RoundType::kUp))
+    ->Arg(static_cast<int64_t>(MonetaryAmount::RoundType::kNearest));
+
+void MonetaryAmountRoundStep(benchmark::State &state) {
+  const MonetaryAmount initAmount("56.10001267", "ETH");
+  const MonetaryAmount step("0.025");
+  for (auto _ : state) {
+    MonetaryAmount ma = initAmount;
+    benchmark::DoNotOptimize(ma);
+    ma.round(step, MonetaryAmount::RoundType::kNearest);
+    benchmark::DoNotOptimize(ma);
+  }
+}
+BENCHMARK(MonetaryAmountRoundStep);
+
+void MonetaryAmountToString(benchmark::State &state) {
+  const MonetaryAmount ma("-56.10001267", "ETH");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ma.str());
+  }
+}
+BENCHMARK(MonetaryAmountToString);
+
+void CurrencyCodeConstruct(benchmark::State &state) {
+  for (auto _ : state) {
+    for (std::string_view str : kCurrencyStrs) {
+      benchmark::DoNotOptimize(CurrencyCode(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kCurrencyStrs.size()));
+}
+BENCHMARK(CurrencyCodeConstruct);
+
+}  // namespace
+}  // namespace cct
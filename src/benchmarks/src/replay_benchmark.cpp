@@ -0,0 +1,147 @@
+#ifdef CCT_ENABLE_PROTO
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "coincenter.hpp"
+#include "coincenterinfo.hpp"
+#include "exchange-name-enum.hpp"
+#include "exchangename.hpp"
+#include "exchangesecretsinfo.hpp"
+#include "general-config.hpp"
+#include "loadconfiguration.hpp"
+#include "logginginfo.hpp"
+#include "market-trader-factory.hpp"
+#include "market.hpp"
+#include "monetaryamount.hpp"
+#include "replay-options.hpp"
+#include "replay-scheduler.hpp"
+#include "runmodes.hpp"
+#include "synthetic-market-data-generator.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+namespace {
+
+const Market kMarket("BTC", "USDT");
+
+/// Synthetic market data generated once for all replay benchmarks, and removed at program exit.
+struct SyntheticMarketData {
+  SyntheticMarketData() {
+    SyntheticMarketDataGenerator::Config config;
+    config.market = kMarket;
+    config.timeWindow = timeWindow;
+    stats = SyntheticMarketDataGenerator(config).generate(dataDir, exchangeName.name());
+  }
+
+  SyntheticMarketData(const SyntheticMarketData &) = delete;
+  SyntheticMarketData &operator=(const SyntheticMarketData &) = delete;
+
+  ~SyntheticMarketData() { std::filesystem::remove_all(dataDir); }
+
+  std::string dataDir = (std::filesystem::temp_directory_path() / "cct-replay-benchmark-data").string();
+  ExchangeName exchangeName{ExchangeNameEnum::binance};
+  TimeWindow timeWindow{TimePoint{std::chrono::sys_days{std::chrono::year{2024} / 1 / 1}}, std::chrono::hours(6)};
+  SyntheticMarketDataGenerator::Stats stats;
+};
+
+const SyntheticMarketData &GetSyntheticMarketData() {
+  static const SyntheticMarketData kSyntheticMarketData;
+  return kSyntheticMarketData;
+}
+
+int64_t PeakResidentSetSizeInBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    return static_cast<int64_t>(usage.ru_maxrss);
+#else
+    // Linux reports it in kilobytes
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+double ToSeconds(Duration duration) { return std::chrono::duration<double>(duration).count(); }
+
+void BM_Replay(benchmark::State &state, std::string_view algorithmName, ReplayOptions::ReplayMode replayMode) {
+  const SyntheticMarketData &syntheticMarketData = GetSyntheticMarketData();
+
+  const LoadConfiguration loadConfiguration(syntheticMarketData.dataDir,
+                                            LoadConfiguration::ExchangeConfigFileType::kTest);
+
+  schema::GeneralConfig generalConfig;
+
+  // Logs would pollute the benchmark output and measurements
+  generalConfig.log.consoleLevel = "warning";
+  generalConfig.log.fileLevel = "off";
+
+  auto &automationConfig = generalConfig.trading.automation;
+  automationConfig.deserialization.loadChunkDuration.duration = std::chrono::hours(1);
+
+  // Starting amounts in the market currencies do not require any conversion, so no external query is made
+  automationConfig.startingContext.startBaseAmountEquivalent = MonetaryAmount(1, kMarket.base());
+  automationConfig.startingContext.startQuoteAmountEquivalent = MonetaryAmount(30000, kMarket.quote());
+
+  LoggingInfo loggingInfo(LoggingInfo::WithLoggersCreation::kYes, syntheticMarketData.dataDir, generalConfig.log);
+
+  const CoincenterInfo coincenterInfo(settings::RunMode::kProd, loadConfiguration, std::move(generalConfig),
+                                      std::move(loggingInfo));
+  Coincenter coincenter(coincenterInfo, ExchangeSecretsInfo(ExchangeNames{}));
+
+  const MarketTraderFactory marketTraderFactory;
+  const ReplayOptions replayOptions(syntheticMarketData.timeWindow, algorithmName, replayMode);
+  const std::span<const ExchangeName> exchangeNames(&syntheticMarketData.exchangeName, 1);
+
+  ReplayStats totalReplayStats;
+  for ([[maybe_unused]] auto _ : state) {
+    ReplayStats replayStats;
+    benchmark::DoNotOptimize(
+        coincenter.replay(marketTraderFactory, replayOptions, kMarket, exchangeNames, &replayStats));
+    totalReplayStats += replayStats;
+  }
+
+  using benchmark::Counter;
+
+  state.counters["books/s"] = Counter(static_cast<double>(totalReplayStats.nbMarketOrderBooks), Counter::kIsRate);
+  state.counters["trades/s"] = Counter(static_cast<double>(totalReplayStats.nbPublicTrades), Counter::kIsRate);
+
+  // Times are cumulated over all threads, so they can exceed the wall time of an iteration
+  state.counters["deserialization_s"] =
+      Counter(ToSeconds(totalReplayStats.deserializationTime), Counter::kAvgIterations);
+  state.counters["validation_s"] = Counter(ToSeconds(totalReplayStats.validationTime), Counter::kAvgIterations);
+  state.counters["trading_s"] = Counter(ToSeconds(totalReplayStats.tradingTime), Counter::kAvgIterations);
+
+  state.counters["peak_rss"] = Counter(static_cast<double>(PeakResidentSetSizeInBytes()), Counter::kDefaults,
+                                       Counter::OneK::kIs1024);
+}
+
+BENCHMARK_CAPTURE(BM_Replay, ValidateOnly, "", ReplayOptions::ReplayMode::kValidateOnly)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Replay, DummyTrader, "dummy-trader", ReplayOptions::ReplayMode::kCheckedLaunchAlgorithm)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_Replay, ExampleTrader, "example-trader", ReplayOptions::ReplayMode::kCheckedLaunchAlgorithm)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace cct
+
+#endif
@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "base64.hpp"
+#include "cct_string.hpp"
+#include "json-web-token-builder.hpp"
+#include "ssl_sha.hpp"
+
+namespace cct {
+namespace {
+
+constexpr std::string_view kSecret = "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j";
+
+void SslSha512Hex(benchmark::State &state) {
+  // Data of the size of a typical query string to sign
+  const string data(static_cast<string::size_type>(state.range(0)), 'a');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ssl::Sha512Hex(data, kSecret));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SslSha512Hex)->RangeMultiplier(4)->Range(64, 4096);
+
+void SslHmacSha512SignerHex(benchmark::State &state) {
+  const string data(static_cast<string::size_type>(state.range(0)), 'a');
+  const ssl::HmacSha512Signer signer(kSecret);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(signer.signHex(data));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SslHmacSha512SignerHex)->RangeMultiplier(4)->Range(64, 4096);
+
+void SslSha256Bin(benchmark::State &state) {
+  const string data(static_cast<string::size_type>(state.range(0)), 'a');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ssl::Sha256Bin(data, kSecret));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SslSha256Bin)->RangeMultiplier(4)->Range(64, 4096);
+
+void SslHmacSha256Signer(benchmark::State &state) {
+  const string data(static_cast<string::size_type>(state.range(0)), 'a');
+  const ssl::HmacSha256Signer signer(kSecret);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(signer.sign(data));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SslHmacSha256Signer)->RangeMultiplier(4)->Range(64, 4096);
+
+// Below benchmarks compare, for each exchange, the signature of a typical private request as it was computed before
+// the introduction of the pre-keyed signers ('OneShot') with the current way ('Signer').
+// Only signature related computations are measured, data to sign is built the same way as in the exchange code.
+
+void KrakenSignature(benchmark::State &state, bool withSigner) {
+  // Kraken secret is base64 encoded
+  const string b64Secret = B64Encode(kSecret);
+  const ssl::HmacSha512Signer signer(B64Decode(b64Secret));
+  const string noncePostData = "1700000000000nonce=1700000000000&pair=XXBTZEUR&type=buy&ordertype=limit&volume=0.01";
+  static constexpr std::string_view kVersion = "/0";
+  static constexpr std::string_view kMethod = "/private/AddOrder";
+  for (auto _ : state) {
+    const auto sha256 = ssl::Sha256(noncePostData);
+    if (withSigner) {
+      const std::array<std::string_view, 3> path{kVersion, kMethod, std::string_view(sha256.data(), sha256.size())};
+      benchmark::DoNotOptimize(B64Encode(signer.sign(path)));
+    } else {
+      // The secret was decoded at each request
+      string path;
+      path.reserve(kVersion.size() + kMethod.size() + sha256.size());
+      path.append(kVersion).append(kMethod).append(sha256.data(), sha256.data() + sha256.size());
+      benchmark::DoNotOptimize(B64Encode(ssl::Sha512Bin(path, B64Decode(b64Secret))));
+    }
+  }
+}
+BENCHMARK_CAPTURE(KrakenSignature, OneShot, false);
+BENCHMARK_CAPTURE(KrakenSignature, Signer, true);
+
+void UpbitAuthToken(benchmark::State &state, bool withBuilder) {
+  static constexpr std::string_view kAccessKey = "kAN6B8JOx4B6eDdPTcCLd5CvsYXOYgDCUBsgpITw";
+  static constexpr ssl::JsonWebTokenHs256Builder::Claim kFixedClaims[] = {{"access_key", kAccessKey}};
+  const ssl::JsonWebTokenHs256Builder builder(kSecret, kFixedClaims);
+  static constexpr std::string_view kPostData = "market=KRW-BTC&side=bid&volume=0.01&price=100000&ord_type=limit";
+  for (auto _ : state) {
+    const ssl::Sha512DigestArray queryHash = ssl::Sha512Digest(kPostData);
+    const ssl::JsonWebTokenHs256Builder::Claim claims[] = {
+        {"nonce", "1700000000000"},
+        {"query_hash", std::string_view(queryHash.data(), queryHash.size())},
+        {"query_hash_alg", "SHA512"}};
+    if (withBuilder) {
+      benchmark::DoNotOptimize(builder.build(claims));
+    } else {
+      // jwt-cpp is not a dependency anymore. A builder created for each token (keying the HMAC context and encoding the
+      // header each time, as jwt-cpp did) is a lower bound of its cost, which also built a generic json object.
+      const ssl::JsonWebTokenHs256Builder oneShotBuilder(kSecret, kFixedClaims);
+      benchmark::DoNotOptimize(oneShotBuilder.build(claims));
+    }
+  }
+}
+BENCHMARK_CAPTURE(UpbitAuthToken, OneShot, false);
+BENCHMARK_CAPTURE(UpbitAuthToken, Builder, true);
+
+void BithumbSignature(benchmark::State &state, bool withSigner) {
+  const ssl::HmacSha512Signer signer(kSecret);
+  // endpoint, post data and nonce separated by a char of value 1
+  const string strData =
+      "/trade/place\1order_currency=BTC&payment_currency=KRW&units=0.01&price=50000000&type=bid\1" "1700000000000";
+  for (auto _ : state) {
+    if (withSigner) {
+      benchmark::DoNotOptimize(B64Encode(signer.signHex(strData)));
+    } else {
+      benchmark::DoNotOptimize(B64Encode(ssl::Sha512Hex(strData, kSecret)));
+    }
+  }
+}
+BENCHMARK_CAPTURE(BithumbSignature, OneShot, false);
+BENCHMARK_CAPTURE(BithumbSignature, Signer, true);
+
+void HuobiSignature(benchmark::State &state, bool withSigner) {
+  const ssl::HmacSha256Signer signer(kSecret);
+  const string paramStr =
+      "POST\napi.huobi.pro\n/v1/order/orders/place\nAccessKeyId=e2xxxxxx-99xxxxxx-84xxxxxx-7xxxx&"
+      "SignatureMethod=HmacSHA256&SignatureVersion=2&Timestamp=2023-11-14T22%3A13%3A20";
+  for (auto _ : state) {
+    if (withSigner) {
+      benchmark::DoNotOptimize(B64Encode(signer.sign(paramStr)));
+    } else {
+      benchmark::DoNotOptimize(B64Encode(ssl::Sha256Bin(paramStr, kSecret)));
+    }
+  }
+}
+BENCHMARK_CAPTURE(HuobiSignature, OneShot, false);
+BENCHMARK_CAPTURE(HuobiSignature, Signer, true);
+
+void KucoinSignature(benchmark::State &state, bool withSigner) {
+  const ssl::HmacSha256Signer signer(kSecret);
+  const string strToSign =
+      R"(1700000000000POST/api/v1/orders{"clientOid":"1700000000000","side":"buy","symbol":"BTC-USDT","size":"0.01"})";
+  static constexpr std::string_view kPassphrase = "myPassphrase";
+  // Each request signs its data and the passphrase
+  for (auto _ : state) {
+    if (withSigner) {
+      benchmark::DoNotOptimize(B64Encode(signer.sign(strToSign)));
+      benchmark::DoNotOptimize(B64Encode(signer.sign(kPassphrase)));
+    } else {
+      benchmark::DoNotOptimize(B64Encode(ssl::Sha256Bin(strToSign, kSecret)));
+      benchmark::DoNotOptimize(B64Encode(ssl::Sha256Bin(kPassphrase, kSecret)));
+    }
+  }
+}
+BENCHMARK_CAPTURE(KucoinSignature, OneShot, false);
+BENCHMARK_CAPTURE(KucoinSignature, Signer, true);
+
+}  // namespace
+}  // namespace cct
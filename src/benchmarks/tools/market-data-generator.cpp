@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "cct_invalid_argument_exception.hpp"
+#include "default-data-dir.hpp"
+#include "durationstring.hpp"
+#include "market.hpp"
+#include "monetaryamount.hpp"
+#include "stringconv.hpp"
+#include "synthetic-market-data-generator.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+
+namespace {
+
+constexpr std::string_view kUsage = R"(Generates synthetic market data for replay.
+
+Usage: coincenter_market_data_generator [--option value]...
+
+Options:
+  --data-dir <path>            data directory in which data is written (default: coincenter data directory)
+  --exchange <name>            exchange name of the data (default: binance)
+  --market <BASE-QUOTE>        market of the data (default: BTC-USDT)
+  --duration <duration>        duration of the data, ending at the start of the current hour (default: 1d)
+  --start-price <amount>       initial mid price (default: 30000)
+  --book-period <duration>     duration between two order books (default: 1s)
+  --depth <int>                number of price levels of each side of the order books (default: 20)
+  --trades-per-second <float>  mean number of public trades per second (default: 5)
+  --volatility <float>         standard deviation of the mid price relative variation between two order books
+                               (default: 0.0001)
+  --seed <int>                 seed of the random generator (default: 42)
+)";
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  using namespace cct;
+  try {
+    std::span<const char *> args(argv + 1, argc - 1);
+
+    std::string_view dataDir = kDefaultDataDir;
+    std::string_view exchangeName = "binance";
+    Duration duration = std::chrono::days(1);
+
+    SyntheticMarketDataGenerator::Config config;
+
+    for (auto argIt = args.begin(); argIt != args.end(); ++argIt) {
+      const std::string_view optName(*argIt);
+      if (optName == "-h" || optName == "--help") {
+        std::cout << kUsage;
+        return EXIT_SUCCESS;
+      }
+      if (++argIt == args.end()) {
+        throw invalid_argument("Expected a value after option '{}'", optName);
+      }
+      const std::string_view optValue(*argIt);
+
+      if (optName == "--data-dir") {
+        dataDir = optValue;
+      } else if (optName == "--exchange") {
+        exchangeName = optValue;
+      } else if (optName == "--market") {
+        config.market = Market(optValue);
+      } else if (optName == "--duration") {
+        duration = ParseDuration(optValue);
+      } else if (optName == "--start-price") {
+        config.startMidPrice = MonetaryAmount(optValue, MonetaryAmount::ParsingMode::kAmountOptional);
+      } else if (optName == "--book-period") {
+        config.marketOrderBookPeriod = ParseDuration(optValue);
+      } else if (optName == "--depth") {
+        config.depth = StringToIntegral<int32_t>(optValue);
+      } else if (optName == "--trades-per-second") {
+        config.nbTradesPerSecond = std::stod(std::string(optValue));
+      } else if (optName == "--volatility") {
+        config.volatility = std::stod(std::string(optValue));
+      } else if (optName == "--seed") {
+        config.seed = StringToIntegral<uint64_t>(optValue);
+      } else {
+        throw invalid_argument("Unknown option '{}'", optName);
+      }
+    }
+
+    const TimePoint to = std::chrono::floor<std::chrono::hours>(Clock::now());
+
+    config.timeWindow = TimeWindow(to - duration, to);
+
+    const auto stats = SyntheticMarketDataGenerator(config).generate(dataDir, exchangeName);
+
+    std::cout << "Generated " << stats.nbMarketOrderBooks << " order books and " << stats.nbPublicTrades
+              << " trades for " << config.market << " on " << exchangeName << " in " << config.timeWindow.str()
+              << " (" << dataDir << ")\n";
+  } catch (const invalid_argument &e) {
+    std::cerr << "Invalid argument: " << e.what() << '\n' << kUsage;
+    return EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
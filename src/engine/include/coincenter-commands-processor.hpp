@@ -1,7 +1,9 @@
 #pragma once
 
+#include <ostream>
 #include <span>
 
+#include "apioutputtype.hpp"
 #include "coincentercommand.hpp"
 #include "queryresultprinter.hpp"
 #include "transferablecommandresult.hpp"
@@ -16,6 +18,9 @@ class CoincenterCommandsProcessor {
  public:
   explicit CoincenterCommandsProcessor(Coincenter &coincenter);
 
+  /// Creates a CoincenterCommandsProcessor printing results in given ostream, with given output type.
+  CoincenterCommandsProcessor(Coincenter &coincenter, std::ostream &os, ApiOutputType apiOutputType);
+
   /// Launch given commands and return the number of processed commands.
   int process(const CoincenterCommands &coincenterCommands);
 
@@ -14,11 +14,13 @@
 #include "exchangesorchestrator.hpp"
 #include "fiatconverter.hpp"
 #include "market-trader-engine.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "metricsexporter.hpp"
 #include "ordersconstraints.hpp"
 #include "queryresulttypes.hpp"
 #include "replay-options.hpp"
+#include "timedef.hpp"
 #include "transferablecommandresult.hpp"
 
 namespace cct {
@@ -26,6 +28,7 @@ namespace cct {
 class AbstractMarketTraderFactory;
 class CoincenterCommand;
 class CoincenterCommands;
+struct ReplayStats;
 class TradeOptions;
 class WithdrawOptions;
 
@@ -53,9 +56,9 @@ class Coincenter {
                                                      CurrencyCode equiCurrencyCode,
                                                      std::optional<int> depth = std::nullopt);
 
-  /// Query market data (order books and last trades).
+  /// Query market data (order books and last trades) of the given markets for each public exchange position.
   /// This method is especially useful for serialization and metric exports.
-  MarketDataPerExchange queryMarketDataPerExchange(std::span<const Market> marketPerPublicExchangePos);
+  MarketDataPerExchange queryMarketDataPerExchange(std::span<const MarketVector> marketsPerPublicExchangePos);
 
   /// Retrieve the last 24h traded volume for exchanges supporting given market.
   MonetaryAmountPerExchange getLast24hTradedVolumePerExchange(Market mk, ExchangeNameSpan exchangeNames);
@@ -144,10 +147,23 @@ class Coincenter {
   MarketTimestampSetsPerExchange getMarketsAvailableForReplay(const ReplayOptions &replayOptions,
                                                               ExchangeNameSpan exchangeNames);
 
+  /// Compacts serialized market data of given market (or all markets if undefined) for exchanges selection into
+  /// read-optimized columnar files, making subsequent replays faster.
+  /// Returns the number of compacted files written.
+  int compactMarketDataForReplay(Market market, ExchangeNameSpan exchangeNames);
+
   /// Replay all markets for exchanges selection that has some data during the last
   /// 'replayDuration' time (so within the time frame [now - replayDuration, now])
+  /// If 'pReplayStats' is not null, it will be filled with the performance statistics of this replay.
   ReplayResults replay(const AbstractMarketTraderFactory &marketTraderFactory, const ReplayOptions &replayOptions,
-                       Market market, ExchangeNameSpan exchangeNames);
+                       Market market, ExchangeNameSpan exchangeNames, ReplayStats *pReplayStats = nullptr);
+
+  /// Refreshes ahead of their expiry the cached values of all exchanges configured with a refresh ahead frequency
+  /// (see 'refreshAhead' in exchange query config), so that next query, expected in 'horizon' from now, does not pay
+  /// the latency of their synchronous refresh.
+  /// Should be called during idle times only, when no other query is processed.
+  /// Returns the number of refreshed values.
+  int refreshCachesAhead(Duration horizon);
 
   /// Dumps the content of all file caches in data directory to save cURL queries.
   void updateFileCaches() const;
@@ -166,20 +182,10 @@ class Coincenter {
  private:
   using MarketTraderEngineVector = FixedCapacityVector<MarketTraderEngine, kNbSupportedExchanges>;
 
-  MarketTradingGlobalResultPerExchange replayAlgorithm(const AbstractMarketTraderFactory &marketTraderFactory,
-                                                       std::string_view algorithmName,
-                                                       const ReplayOptions &replayOptions,
-                                                       std::span<MarketTraderEngine> marketTraderEngines,
-                                                       const ExchangeNameEnumVector &exchangesWithThisMarketData);
-
   // TODO: may be moved somewhere else?
   MarketTraderEngineVector createMarketTraderEngines(const ReplayOptions &replayOptions, Market market,
                                                      ExchangeNameEnumVector &exchangesWithThisMarketData);
 
-  MarketTradeRangeStatsPerExchange tradingProcess(const ReplayOptions &replayOptions,
-                                                  std::span<MarketTraderEngine> marketTraderEngines,
-                                                  ExchangeNameEnumSpan exchangesWithThisMarketData);
-
   const CoincenterInfo &_coincenterInfo;
   api::CommonAPI _commonAPI;
   FiatConverter _fiatConverter;
@@ -45,6 +45,7 @@ class CoincenterCmdLineOptions {
   std::string_view logFile;
   std::optional<std::string_view> noSecrets;
   Duration repeatTime = CoincenterCmdLineOptionsDefinitions::kDefaultRepeatTime;
+  std::string_view daemonSocketPath;
 
   std::string_view monitoringAddress = CoincenterCmdLineOptionsDefinitions::kDefaultMonitoringIPAddress;
   std::string_view monitoringUsername;
@@ -108,9 +109,11 @@ class CoincenterCmdLineOptions {
   std::string_view algorithmNames;
   std::string_view market;
   std::optional<std::string_view> replayMarkets;
+  std::optional<std::string_view> compactMarketData;
 
   CommandLineOptionalInt32 repeats;
   int32_t monitoringPort = CoincenterCmdLineOptionsDefinitions::kDefaultMonitoringPort;
+  int32_t monitoringPullPort = 0;
   int32_t depth = kUndefinedDepth;
 
   bool forceMultiTrade = false;
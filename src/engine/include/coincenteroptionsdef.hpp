@@ -188,6 +188,14 @@ struct CoincenterAllowedOptions : private CoincenterCmdLineOptionsDefinitions {
         "This is useful for monitoring for instance. 'n' is optional, if not given, will repeat endlessly"},
        &OptValueType::repeats},
       {{{"General", 900}, "--repeat-time", "<time>", kRepeat}, &OptValueType::repeatTime},
+      {{{"General", 950},
+        "--daemon",
+        "<path/to/socket>",
+        "Keep coincenter running after given commands (if any), processing commands received on given Unix domain "
+        "socket with caches and connections kept warm.\n"
+        "Each request is a line with a json array of command line arguments (for instance [\"balance\", \"kraken\"]), "
+        "each response is a line with the json results (like with '-o json') of the commands of the request"},
+       &OptValueType::daemonSocketPath},
       {{{"General", 1000}, "version", "", "Display program version"}, &OptValueType::version},
       {{{"Public queries", 2000},
         "health-check",
@@ -463,7 +471,7 @@ struct CoincenterAllowedOptions : private CoincenterCmdLineOptionsDefinitions {
       {{{"Automation", 8003},
         "--market",
         "<cur1-cur2>",
-        "Only replay for specific market. Default will replay all stored markets."},
+        "Only replay (or compact) specific market. Default will consider all stored markets."},
        &OptValueType::market},
       {{{"Automation", 8003},
         "--validate",
@@ -478,6 +486,13 @@ struct CoincenterAllowedOptions : private CoincenterCmdLineOptionsDefinitions {
         "\nNominal replay will not validate input data to optimize performance, use this option to validate data once "
         "and for all."},
        &OptValueType::validateOnly},
+      {{{"Automation", 8004},
+        "compact-market-data",
+        "<[exch1,...]>",
+        "Compact all serialized market data of all exchanges, or only specified ones, into read-optimized files that "
+        "will speed up future replays. Use '--market' option to compact only a specific market.\n"
+        "Hourly files are kept untouched, data serialized after a compaction is still taken into account at replay."},
+       &OptValueType::compactMarketData},
       {{{"Monitoring", 9000},
         "--monitoring",
         "",
@@ -495,7 +510,13 @@ struct CoincenterAllowedOptions : private CoincenterCmdLineOptionsDefinitions {
         "--monitoring-pass",
         "<password>",
         "Specify password of metric gateway instance (default: none)"},
-       &OptValueType::monitoringPassword}};
+       &OptValueType::monitoringPassword},
+      {{{"Monitoring", 9000},
+        "--monitoring-pull-port",
+        "<port>",
+        "Expose the metrics on 'http://127.0.0.1:<port>/metrics' for a metric server to pull them, "
+        "in addition or instead of pushing them (default: disabled)"},
+       &OptValueType::monitoringPullPort}};
 
   static_assert(StaticCommandLineOptionsDuplicatesCheck(std::to_array(value)),
                 "Duplicated option names (short hand flag / long name)");
@@ -7,17 +7,16 @@
 #include "exchange-names.hpp"
 #include "exchangename.hpp"
 #include "exchangeretriever.hpp"
-#include "market-trader-engine.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "queryresulttypes.hpp"
 #include "threadpool.hpp"
 #include "time-window.hpp"
+#include "timedef.hpp"
 #include "withdrawoptions.hpp"
 
 namespace cct {
 
-class ReplayOptions;
-
 namespace schema {
 struct RequestsConfig;
 }
@@ -97,18 +96,14 @@ class ExchangesOrchestrator {
 
   MonetaryAmountPerExchange getLastPricePerExchange(Market mk, ExchangeNameSpan exchangeNames);
 
-  MarketDataPerExchange getMarketDataPerExchange(std::span<const Market> marketPerPublicExchange,
+  MarketDataPerExchange getMarketDataPerExchange(std::span<const MarketVector> marketsPerPublicExchange,
                                                  std::span<const ExchangeNameEnum> exchangeNameEnums);
 
   MarketTimestampSetsPerExchange pullAvailableMarketsForReplay(TimeWindow timeWindow, ExchangeNameSpan exchangeNames);
 
-  MarketTradeRangeStatsPerExchange traderConsumeRange(const ReplayOptions &replayOptions, TimeWindow subTimeWindow,
-                                                      std::span<MarketTraderEngine> marketTraderEngines,
-                                                      ExchangeNameEnumSpan exchangeNames);
+  int compactMarketDataForReplay(Market market, ExchangeNameSpan exchangeNames);
 
-  MarketTradingGlobalResultPerExchange getMarketTraderResultPerExchange(
-      std::span<MarketTraderEngine> marketTraderEngines, MarketTradeRangeStatsPerExchange &&tradeRangeStatsPerExchange,
-      ExchangeNameEnumSpan exchangeNames);
+  int refreshCachesAhead(Duration horizon);
 
  private:
   ExchangeRetriever _exchangeRetriever;
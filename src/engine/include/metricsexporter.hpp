@@ -1,6 +1,14 @@
 #pragma once
 
+#include <array>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
 #include "currencycode.hpp"
+#include "exchange-name-enum.hpp"
+#include "market.hpp"
+#include "metric-handles.hpp"
 #include "queryresulttypes.hpp"
 
 namespace cct {
@@ -17,13 +25,35 @@ class MetricsExporter {
 
   void exportTickerMetrics(const ExchangeTickerMaps &marketOrderBookMaps);
 
-  void exportOrderbookMetrics(const MarketOrderBookConversionRates &marketOrderBookConversionRates);
+  void exportOrderbookMetrics(std::span<const MarketOrderBookConversionRate> marketOrderBookConversionRates);
 
-  void exportLastTradesMetrics(const TradesPerExchange &lastTradesPerExchange);
+  void exportLastTradesMetrics(std::span<const ExchangeWith<PublicTradeVector>> lastTradesPerExchange);
 
  private:
-  void createSummariesAndHistograms();
+  struct BestPricesGauges {
+    MetricGauge askPrice;
+    MetricGauge bidPrice;
+    MetricGauge askVolume;
+    MetricGauge bidVolume;
+  };
+
+  struct BestPricesMetricNames {
+    std::string_view priceName;
+    std::string_view priceHelp;
+    std::string_view volumeName;
+    std::string_view volumeHelp;
+  };
+
+  // Gauges are registered once per exchange and market, so that next exports do not need to rebuild their keys
+  using BestPricesGaugesPerExchange =
+      std::array<std::unordered_map<Market, BestPricesGauges>, kNbSupportedExchanges>;
+
+  const BestPricesGauges &getBestPricesGauges(BestPricesGaugesPerExchange &bestPricesGaugesPerExchange,
+                                              const BestPricesMetricNames &metricNames,
+                                              ExchangeNameEnum exchangeNameEnum, Market market);
 
   AbstractMetricGateway *_pMetricsGateway;
+  BestPricesGaugesPerExchange _tickerGauges;
+  BestPricesGaugesPerExchange _orderbookGauges;
 };
 }  // namespace cct
\ No newline at end of file
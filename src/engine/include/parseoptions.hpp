@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <iostream>
+#include <ostream>
 #include <span>
 #include <utility>
 
@@ -11,8 +12,10 @@
 
 namespace cct {
 
+/// Parses the command line arguments, possibly made of several commands.
+/// If help or version is requested, it is written to 'os' and no command is returned.
 template <class ParserType>
-auto ParseOptions(ParserType &parser, int argc, const char *argv[]) {
+auto ParseOptions(ParserType &parser, int argc, const char *argv[], std::ostream &os = std::cout) {
   auto programName = std::filesystem::path(argv[0]).filename().string();
 
   std::span<const char *const> allArguments(argv, argc);
@@ -37,12 +40,12 @@ auto ParseOptions(ParserType &parser, int argc, const char *argv[]) {
       groupParsedOptions.help = true;
     }
     if (groupParsedOptions.help) {
-      parser.displayHelp(programName, std::cout);
+      parser.displayHelp(programName, os);
       parsedOptions.clear();
       break;
     }
     if (groupParsedOptions.version) {
-      CoincenterCmdLineOptions::PrintVersion(programName, std::cout);
+      CoincenterCmdLineOptions::PrintVersion(programName, os);
       parsedOptions.clear();
       break;
     }
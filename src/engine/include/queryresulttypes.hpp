@@ -48,8 +48,11 @@ using MonetaryAmountByCurrencySetPerExchange =
 
 using TradesPerExchange = FixedCapacityVector<ExchangeWith<PublicTradeVector>, kNbSupportedExchanges>;
 
+using MarketOrderBookAndLastTrades = std::pair<MarketOrderBook, PublicTradeVector>;
+
+// One element per queried market of the exchange
 using MarketDataPerExchange =
-    FixedCapacityVector<ExchangeWith<std::pair<MarketOrderBook, PublicTradeVector>>, kNbSupportedExchanges>;
+    FixedCapacityVector<ExchangeWith<vector<MarketOrderBookAndLastTrades>>, kNbSupportedExchanges>;
 
 using TradeResultPerExchange = SmallVector<ExchangeWith<TradeResult>, kTypicalNbPrivateAccounts>;
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "cct_fixedcapacityvector.hpp"
+#include "cct_vector.hpp"
+#include "exchange-name-enum.hpp"
+#include "exchangeretriever.hpp"
+#include "market-order-book-vector.hpp"
+#include "market-trader-engine.hpp"
+#include "market.hpp"
+#include "public-trade-vector.hpp"
+#include "queryresulttypes.hpp"
+#include "replay-options.hpp"
+#include "threadpool.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+#include "trade-range-stats.hpp"
+
+namespace cct {
+
+/// Replay of a single algorithm on a single market, for all the exchanges having data for this market.
+struct ReplayAlgorithmJob {
+  using MarketTraderEngineVector = FixedCapacityVector<MarketTraderEngine, kNbSupportedExchanges>;
+
+  std::string_view algorithmName;
+  /// Exchanges in the same order as 'marketTraderEngines'
+  ExchangeRetriever::UniquePublicSelectedExchanges exchanges;
+  MarketTraderEngineVector marketTraderEngines;
+};
+
+/// Replay of all the algorithms on a single market.
+/// Market data of each exchange is loaded only once per chunk, and shared by the engines of all the algorithms.
+struct ReplayJob {
+  Market market;
+  vector<ReplayAlgorithmJob> algorithmJobs;
+};
+
+/// Performance statistics of a replay.
+/// Durations are cumulated over all the threads, so their sum may exceed the elapsed time of the replay.
+struct ReplayStats {
+  ReplayStats &operator+=(const ReplayStats &rhs);
+
+  /// Number of market order books and public trades loaded from disk (each of them is counted once per exchange, even
+  /// if it is shared by several algorithms)
+  int64_t nbMarketOrderBooks{};
+  int64_t nbPublicTrades{};
+  /// Time spent reading and decoding market data from disk
+  Duration deserializationTime{};
+  /// Time spent in MarketTraderEngine::validateRange
+  Duration validationTime{};
+  /// Time spent by the engines (and their algorithms) to consume the validated market data
+  Duration tradingTime{};
+};
+
+/// Runs replay jobs in parallel.
+/// Jobs are independent from each other (each of them has its own MarketTraderEngines), so they are fanned out over
+/// all the available cores, each idle worker taking the next pending job. The results do not depend on the scheduling.
+/// Within a job, the next chunk of market data is loaded in the background while the current one is being traded, and
+/// the engines of the different algorithms trade the same immutable chunk in parallel.
+class ReplayScheduler {
+ public:
+  /// Results of the algorithms of a job, in the same order as its 'algorithmJobs'
+  using ReplayJobResults = vector<MarketTradingGlobalResultPerExchange>;
+
+  /// Creates a ReplayScheduler that will use at most 'nbMaxThreads' threads for the jobs.
+  /// If 'nbMaxThreads' is 0, the number of hardware threads will be used.
+  ReplayScheduler(const ReplayOptions &replayOptions, Duration loadChunkDuration, int nbMaxThreads = 0);
+
+  int nbMaxThreads() const noexcept { return _nbMaxThreads; }
+
+  /// Runs all given jobs and returns their results, in the same order as the jobs.
+  vector<ReplayJobResults> run(std::span<ReplayJob> replayJobs);
+
+  /// Get the performance statistics cumulated over all the runs of this ReplayScheduler.
+  const ReplayStats &stats() const noexcept { return _stats; }
+
+ private:
+  struct MarketData {
+    MarketOrderBookVector marketOrderBooks;
+    PublicTradeVector publicTrades;
+  };
+
+  using MarketDataPerExchange = FixedCapacityVector<MarketData, kNbSupportedExchanges>;
+
+  struct LoadedMarketData {
+    MarketDataPerExchange marketDataPerExchange;
+    Duration loadTime{};
+  };
+
+  using SharedMarketDataPerExchange = FixedCapacityVector<std::shared_ptr<const MarketData>, kNbSupportedExchanges>;
+  using TradeRangeStatsPerExchange = FixedCapacityVector<TradeRangeStats, kNbSupportedExchanges>;
+
+  static MarketDataPerExchange LoadMarketData(Market market,
+                                              const ExchangeRetriever::UniquePublicSelectedExchanges &exchanges,
+                                              TimeWindow subTimeWindow);
+
+  ReplayJobResults runJob(ReplayJob &replayJob, ThreadPool &loadingThreadPool, ThreadPool &tradingThreadPool,
+                          ReplayStats &jobStats) const;
+
+  TradeRangeStatsPerExchange consumeRange(ReplayAlgorithmJob &algorithmJob,
+                                          const ExchangeRetriever::UniquePublicSelectedExchanges &exchanges,
+                                          const SharedMarketDataPerExchange &sharedMarketDataPerExchange,
+                                          const TradeRangeStatsPerExchange &validationStatsPerExchange) const;
+
+  const ReplayOptions &_replayOptions;
+  Duration _loadChunkDuration;
+  int _nbMaxThreads;
+  ReplayStats _stats;
+};
+
+}  // namespace cct
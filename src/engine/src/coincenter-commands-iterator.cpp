@@ -1,11 +1,7 @@
 #include "coincenter-commands-iterator.hpp"
 
-#include <bitset>
-
 #include "coincentercommand.hpp"
 #include "coincentercommandtype.hpp"
-#include "exchange-name-enum.hpp"
-#include "exchangename.hpp"
 
 namespace cct {
 
@@ -13,25 +9,6 @@ CoincenterCommandsIterator::CoincenterCommandsIterator(CoincenterCommandSpan com
     : _commands(commands), _pos() {}
 
 namespace {
-using PublicExchangePresenceBitset = std::bitset<kNbSupportedExchanges>;
-
-bool UpdateBitsetAreNewExchanges(const CoincenterCommand &command,
-                                 PublicExchangePresenceBitset &publicExchangePresence) {
-  if (command.exchangeNames().empty()) {
-    // All public exchanges used
-    const auto result = publicExchangePresence.none();
-    publicExchangePresence.set();
-    return result;
-  }
-  for (const ExchangeName &exchangeName : command.exchangeNames()) {
-    const auto exchangePos = exchangeName.publicExchangePos();
-    if (publicExchangePresence[exchangePos]) {
-      return false;
-    }
-    publicExchangePresence.set(exchangePos);
-  }
-  return true;
-}
 
 bool CommandTypeCanBeGrouped(CoincenterCommandType type) {
   // Compatible command types need to be explicitly set
@@ -52,17 +29,13 @@ CoincenterCommandsIterator::CoincenterCommandSpan CoincenterCommandsIterator::ne
   CoincenterCommandSpan groupedCommands(_commands.begin() + _pos, 1U);
 
   if (CommandTypeCanBeGrouped(groupedCommands.front().type())) {
-    PublicExchangePresenceBitset publicExchangePresence;
-    UpdateBitsetAreNewExchanges(groupedCommands.front(), publicExchangePresence);
-
+    // Commands are grouped even if they target the same exchanges - several markets can be queried at once on the
+    // same exchange.
     while (_pos + groupedCommands.size() < _commands.size()) {
       const CoincenterCommand &nextCommand = _commands[_pos + groupedCommands.size()];
       if (nextCommand.type() != groupedCommands.front().type()) {
         break;
       }
-      if (!UpdateBitsetAreNewExchanges(nextCommand, publicExchangePresence)) {
-        break;
-      }
       // Add new command to group
       groupedCommands = CoincenterCommandSpan(groupedCommands.data(), groupedCommands.size() + 1);
     }
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <array>
+#include <ostream>
 #include <span>
 #include <thread>
 #include <utility>
 
+#include "apioutputtype.hpp"
 #include "balanceoptions.hpp"
 #include "cct_exception.hpp"
 #include "cct_invalid_argument_exception.hpp"
@@ -23,6 +25,7 @@
 #include "exchangename.hpp"
 #include "exchangepublicapi.hpp"
 #include "market-trader-factory.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
 #include "queryresultprinter.hpp"
@@ -57,6 +60,10 @@ CoincenterCommandsProcessor::CoincenterCommandsProcessor(Coincenter &coincenter)
     : _coincenter(coincenter),
       _queryResultPrinter(coincenter.coincenterInfo().apiOutputType(), coincenter.coincenterInfo().loggingInfo()) {}
 
+CoincenterCommandsProcessor::CoincenterCommandsProcessor(Coincenter &coincenter, std::ostream &os,
+                                                         ApiOutputType apiOutputType)
+    : _coincenter(coincenter), _queryResultPrinter(os, apiOutputType, coincenter.coincenterInfo().loggingInfo()) {}
+
 int CoincenterCommandsProcessor::process(const CoincenterCommands &coincenterCommands) {
   const auto commands = coincenterCommands.commands();
   const int nbRepeats = commands.empty() ? 0 : coincenterCommands.repeats();
@@ -70,6 +77,14 @@ int CoincenterCommandsProcessor::process(const CoincenterCommands &coincenterCom
 
     lastCommandTime = Clock::now();
 
+    if (lastCommandTime < earliestTimeNextCommand) {
+      // Idle time is used to refresh cached values before they expire, instead of paying their refresh latency in
+      // next commands
+      _coincenter.refreshCachesAhead(earliestTimeNextCommand - lastCommandTime);
+
+      lastCommandTime = Clock::now();
+    }
+
     if (lastCommandTime < earliestTimeNextCommand) {
       const auto waitingDuration = earliestTimeNextCommand - lastCommandTime;
 
@@ -303,18 +318,26 @@ TransferableCommandResultVector CoincenterCommandsProcessor::processGroupedComma
       break;
     }
     case CoincenterCommandType::MarketData: {
-      std::array<Market, kNbSupportedExchanges> marketPerPublicExchange;
+      std::array<MarketVector, kNbSupportedExchanges> marketsPerPublicExchange;
+      const auto addMarket = [](MarketVector &markets, Market market) {
+        // Several commands may ask the same market on the same exchange
+        if (std::ranges::find(markets, market) == markets.end()) {
+          markets.push_back(market);
+        }
+      };
       for (const auto &cmd : groupedCommands) {
         if (cmd.exchangeNames().empty()) {
-          std::ranges::fill(marketPerPublicExchange, cmd.market());
+          for (MarketVector &markets : marketsPerPublicExchange) {
+            addMarket(markets, cmd.market());
+          }
         } else {
           for (const auto &exchangeName : cmd.exchangeNames()) {
-            marketPerPublicExchange[exchangeName.publicExchangePos()] = cmd.market();
+            addMarket(marketsPerPublicExchange[exchangeName.publicExchangePos()], cmd.market());
           }
         }
       }
       // No return value here, this command is made only for storing purposes.
-      _coincenter.queryMarketDataPerExchange(marketPerPublicExchange);
+      _coincenter.queryMarketDataPerExchange(marketsPerPublicExchange);
       break;
     }
     case CoincenterCommandType::Replay: {
@@ -338,6 +361,11 @@ TransferableCommandResultVector CoincenterCommandsProcessor::processGroupedComma
       _queryResultPrinter.printMarketsForReplay(firstCmd.replayOptions().timeWindow(), marketTimestampSetsPerExchange);
       break;
     }
+    case CoincenterCommandType::CompactMarketData: {
+      // No return value here, this command only rewrites serialized data on disk.
+      _coincenter.compactMarketDataForReplay(firstCmd.market(), firstCmd.exchangeNames());
+      break;
+    }
     default:
       throw exception("Unknown command type");
   }
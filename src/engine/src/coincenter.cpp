@@ -11,9 +11,11 @@
 #include "algorithm-name-iterator.hpp"
 #include "balanceoptions.hpp"
 #include "cct_log.hpp"
+#include "cct_vector.hpp"
 #include "coincenterinfo.hpp"
 #include "currencycode.hpp"
 #include "depositsconstraints.hpp"
+#include "durationstring.hpp"
 #include "enum-string.hpp"
 #include "exchange-name-enum.hpp"
 #include "exchange-names.hpp"
@@ -24,12 +26,15 @@
 #include "exchangesecretsinfo.hpp"
 #include "market-timestamp-set.hpp"
 #include "market-trader-engine.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
 #include "ordersconstraints.hpp"
+#include "public-trade-vector.hpp"
 #include "query-result-type-helpers.hpp"
 #include "queryresulttypes.hpp"
 #include "replay-options.hpp"
+#include "replay-scheduler.hpp"
 #include "time-window.hpp"
 #include "timedef.hpp"
 #include "withdrawsconstraints.hpp"
@@ -73,35 +78,31 @@ MarketOrderBookConversionRates Coincenter::getMarketOrderBooks(Market mk, Exchan
   return ret;
 }
 
-MarketDataPerExchange Coincenter::queryMarketDataPerExchange(std::span<const Market> marketPerPublicExchangePos) {
+MarketDataPerExchange Coincenter::queryMarketDataPerExchange(
+    std::span<const MarketVector> marketsPerPublicExchangePos) {
   ExchangeNameEnumVector exchangeNameEnums;
 
   int exchangePos{};
-  for (Market market : marketPerPublicExchangePos) {
-    if (market.isDefined()) {
+  for (const MarketVector &markets : marketsPerPublicExchangePos) {
+    if (!markets.empty()) {
       exchangeNameEnums.emplace_back(static_cast<ExchangeNameEnum>(exchangePos));
     }
     ++exchangePos;
   }
 
   const auto marketDataPerExchange =
-      _exchangesOrchestrator.getMarketDataPerExchange(marketPerPublicExchangePos, exchangeNameEnums);
+      _exchangesOrchestrator.getMarketDataPerExchange(marketsPerPublicExchangePos, exchangeNameEnums);
 
-  // Transform data structures to export metrics input format
-  MarketOrderBookConversionRates marketOrderBookConversionRates(marketDataPerExchange.size());
-  TradesPerExchange lastTradesPerExchange(marketDataPerExchange.size());
+  // Transform data structures to export metrics input format - one element per exchange and market
+  vector<MarketOrderBookConversionRate> marketOrderBookConversionRates;
+  vector<ExchangeWith<PublicTradeVector>> lastTradesPerExchange;
 
-  std::ranges::transform(marketDataPerExchange, marketOrderBookConversionRates.begin(),
-                         [](const auto &exchangeWithPairOrderBooksAndTrades) {
-                           return std::make_tuple(exchangeWithPairOrderBooksAndTrades.first->exchangeNameEnum(),
-                                                  exchangeWithPairOrderBooksAndTrades.second.first, std::nullopt);
-                         });
-
-  std::ranges::transform(marketDataPerExchange, lastTradesPerExchange.begin(),
-                         [](const auto &exchangeWithPairOrderBooksAndTrades) {
-                           return std::make_pair(exchangeWithPairOrderBooksAndTrades.first,
-                                                 exchangeWithPairOrderBooksAndTrades.second.second);
-                         });
+  for (const auto &[exchange, marketData] : marketDataPerExchange) {
+    for (const auto &[marketOrderBook, lastTrades] : marketData) {
+      marketOrderBookConversionRates.emplace_back(exchange->exchangeNameEnum(), marketOrderBook, std::nullopt);
+      lastTradesPerExchange.emplace_back(exchange, lastTrades);
+    }
+  }
 
   _metricsExporter.exportOrderbookMetrics(marketOrderBookConversionRates);
   _metricsExporter.exportLastTradesMetrics(lastTradesPerExchange);
@@ -248,6 +249,12 @@ MarketTimestampSetsPerExchange Coincenter::getMarketsAvailableForReplay(const Re
   return _exchangesOrchestrator.pullAvailableMarketsForReplay(replayOptions.timeWindow(), exchangeNames);
 }
 
+int Coincenter::compactMarketDataForReplay(Market market, ExchangeNameSpan exchangeNames) {
+  const int nbCompactedFiles = _exchangesOrchestrator.compactMarketDataForReplay(market, exchangeNames);
+  log::info("Wrote {} compacted market data files", nbCompactedFiles);
+  return nbCompactedFiles;
+}
+
 namespace {
 auto CreateExchangeNameVector(Market market, const MarketTimestampSetsPerExchange &marketTimestampSetsPerExchange) {
   ExchangeNameEnumVector exchangesWithThisMarketData;
@@ -298,7 +305,8 @@ void Filter(Market market, MarketTimestampSetsPerExchange &marketTimestampSetsPe
 }  // namespace
 
 ReplayResults Coincenter::replay(const AbstractMarketTraderFactory &marketTraderFactory,
-                                 const ReplayOptions &replayOptions, Market market, ExchangeNameSpan exchangeNames) {
+                                 const ReplayOptions &replayOptions, Market market, ExchangeNameSpan exchangeNames,
+                                 ReplayStats *pReplayStats) {
   const TimeWindow timeWindow = replayOptions.timeWindow();
   auto marketTimestampSetsPerExchange = _exchangesOrchestrator.pullAvailableMarketsForReplay(timeWindow, exchangeNames);
 
@@ -308,48 +316,73 @@ ReplayResults Coincenter::replay(const AbstractMarketTraderFactory &marketTrader
 
   const MarketSet allMarkets = ComputeAllMarkets(marketTimestampSetsPerExchange);
 
+  const auto loadChunkDuration =
+      _coincenterInfo.generalConfig().trading.automation.deserialization.loadChunkDuration.duration;
+
   ReplayResults replayResults;
 
+  vector<std::string_view> algorithmNames;
+
   AlgorithmNameIterator replayAlgorithmNameIterator(replayOptions.algorithmNames(),
                                                     marketTraderFactory.allSupportedAlgorithms());
 
   while (replayAlgorithmNameIterator.hasNext()) {
     std::string_view algorithmName = replayAlgorithmNameIterator.next();
 
-    ReplayResults::mapped_type algorithmResults;
+    algorithmNames.push_back(algorithmName);
+    replayResults[algorithmName].reserve(allMarkets.size());
+  }
 
-    algorithmResults.reserve(allMarkets.size());
+  ExchangeRetriever exchangeRetriever(_exchangePool.exchanges());
 
-    for (const Market replayMarket : allMarkets) {
+  // One job per market, so that market data is loaded only once for all the algorithms.
+  // Jobs are created sequentially (it is cheap, and conversions may query exchanges), and run in parallel afterwards.
+  vector<ReplayJob> replayJobs;
+  replayJobs.reserve(allMarkets.size());
+
+  for (const Market replayMarket : allMarkets) {
+    auto &replayJob = replayJobs.emplace_back(replayMarket);
+
+    replayJob.algorithmJobs.reserve(algorithmNames.size());
+
+    for (std::string_view algorithmName : algorithmNames) {
       auto exchangesWithThisMarketData = CreateExchangeNameVector(replayMarket, marketTimestampSetsPerExchange);
 
       // Create the MarketTraderEngines based on this market, filtering out exchanges without available amount to
       // trade
       auto marketTraderEngines = createMarketTraderEngines(replayOptions, replayMarket, exchangesWithThisMarketData);
 
-      MarketTradingGlobalResultPerExchange marketTradingResultPerExchange = replayAlgorithm(
-          marketTraderFactory, algorithmName, replayOptions, marketTraderEngines, exchangesWithThisMarketData);
+      CreateAndRegisterTraderAlgorithms(marketTraderFactory, algorithmName, marketTraderEngines);
 
-      algorithmResults.push_back(std::move(marketTradingResultPerExchange));
+      replayJob.algorithmJobs.emplace_back(algorithmName,
+                                           exchangeRetriever.selectOneAccount(exchangesWithThisMarketData),
+                                           std::move(marketTraderEngines));
     }
-
-    replayResults.insert({algorithmName, std::move(algorithmResults)});
   }
 
-  return replayResults;
-}
+  ReplayScheduler replayScheduler(replayOptions, loadChunkDuration);
+
+  auto replayJobsResults = replayScheduler.run(replayJobs);
 
-MarketTradingGlobalResultPerExchange Coincenter::replayAlgorithm(
-    const AbstractMarketTraderFactory &marketTraderFactory, std::string_view algorithmName,
-    const ReplayOptions &replayOptions, std::span<MarketTraderEngine> marketTraderEngines,
-    const ExchangeNameEnumVector &exchangesWithThisMarketData) {
-  CreateAndRegisterTraderAlgorithms(marketTraderFactory, algorithmName, marketTraderEngines);
+  const ReplayStats &replayStats = replayScheduler.stats();
 
-  MarketTradeRangeStatsPerExchange tradeRangeStatsPerExchange =
-      tradingProcess(replayOptions, marketTraderEngines, exchangesWithThisMarketData);
+  log::info("Replayed {} order book(s) and {} trade(s) - deserialization {}, validation {}, trading {}",
+            replayStats.nbMarketOrderBooks, replayStats.nbPublicTrades,
+            DurationToString(replayStats.deserializationTime), DurationToString(replayStats.validationTime),
+            DurationToString(replayStats.tradingTime));
 
-  return _exchangesOrchestrator.getMarketTraderResultPerExchange(
-      marketTraderEngines, std::move(tradeRangeStatsPerExchange), exchangesWithThisMarketData);
+  if (pReplayStats != nullptr) {
+    *pReplayStats = replayStats;
+  }
+
+  // Results are returned in the same order as the jobs, so the final results do not depend on the scheduling
+  for (auto &replayJobResults : replayJobsResults) {
+    for (decltype(algorithmNames.size()) algorithmPos{}; algorithmPos < algorithmNames.size(); ++algorithmPos) {
+      replayResults[algorithmNames[algorithmPos]].push_back(std::move(replayJobResults[algorithmPos]));
+    }
+  }
+
+  return replayResults;
 }
 
 namespace {
@@ -406,34 +439,12 @@ Coincenter::MarketTraderEngineVector Coincenter::createMarketTraderEngines(
   return marketTraderEngines;
 }
 
-MarketTradeRangeStatsPerExchange Coincenter::tradingProcess(const ReplayOptions &replayOptions,
-                                                            std::span<MarketTraderEngine> marketTraderEngines,
-                                                            ExchangeNameEnumSpan exchangesWithThisMarketData) {
-  const auto &automationConfig = _coincenterInfo.generalConfig().trading.automation;
-  const auto loadChunkDuration = automationConfig.deserialization.loadChunkDuration.duration;
-  const auto timeWindow = replayOptions.timeWindow();
-
-  MarketTradeRangeStatsPerExchange tradeRangeResultsPerExchange;
-
-  // Main loop - parallelized by exchange, with time window chunks of loadChunkDuration
-
-  for (TimeWindow subTimeWindow(timeWindow.from(), loadChunkDuration); subTimeWindow.overlaps(timeWindow);
-       subTimeWindow += loadChunkDuration) {
-    auto subRangeResultsPerExchange = _exchangesOrchestrator.traderConsumeRange(
-        replayOptions, subTimeWindow, marketTraderEngines, exchangesWithThisMarketData);
-
-    if (tradeRangeResultsPerExchange.empty()) {
-      tradeRangeResultsPerExchange = std::move(subRangeResultsPerExchange);
-    } else {
-      int pos{};  // TODO: we can use std::views::enumerate from C++23 when available
-      for (auto &[exchange, result] : subRangeResultsPerExchange) {
-        tradeRangeResultsPerExchange[pos].second += result;
-        ++pos;
-      }
-    }
+int Coincenter::refreshCachesAhead(Duration horizon) {
+  const int nbRefreshedValues = _exchangesOrchestrator.refreshCachesAhead(horizon);
+  if (nbRefreshedValues != 0) {
+    log::debug("Refreshed ahead {} cached values", nbRefreshedValues);
   }
-
-  return tradeRangeResultsPerExchange;
+  return nbRefreshedValues;
 }
 
 void Coincenter::updateFileCaches() const {
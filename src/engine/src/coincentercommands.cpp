@@ -257,6 +257,17 @@ void CoincenterCommands::addOption(const CoincenterCmdLineOptions &cmdLineOption
         .setExchangeNames(optionParser.parseExchanges());
   }
 
+  if (cmdLineOptions.compactMarketData) {
+    optionParser = StringOptionParser(*cmdLineOptions.compactMarketData);
+
+    auto &cmd = _commands.emplace_back(CoincenterCommandType::CompactMarketData)
+                    .setExchangeNames(optionParser.parseExchanges());
+
+    if (!cmdLineOptions.market.empty()) {
+      cmd.setMarket(Market(cmdLineOptions.market));
+    }
+  }
+
   optionParser.checkEndParsing();  // No more option part should be remaining
 }
 
@@ -41,7 +41,8 @@ schema::GeneralConfig LoadGeneralConfigAndOverrideOptionsFromCLI(const Coincente
 MonitoringInfo MonitoringInfo_Create(std::string_view programName, const CoincenterCmdLineOptions &cmdLineOptions) {
   return {cmdLineOptions.useMonitoring,      programName,
           cmdLineOptions.monitoringAddress,  cmdLineOptions.monitoringPort,
-          cmdLineOptions.monitoringUsername, cmdLineOptions.monitoringPassword};
+          cmdLineOptions.monitoringUsername, cmdLineOptions.monitoringPassword,
+          cmdLineOptions.monitoringPullPort};
 }
 
 }  // namespace
@@ -63,11 +63,13 @@ void CoincenterCmdLineOptions::mergeGlobalWith(const CoincenterCmdLineOptions& r
   CCT_OPTIONS_MERGE_GLOBAL_WITH(logFile);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(noSecrets);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(repeatTime);
+  CCT_OPTIONS_MERGE_GLOBAL_WITH(daemonSocketPath);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(monitoringAddress);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(monitoringUsername);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(monitoringPassword);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(repeats);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(monitoringPort);
+  CCT_OPTIONS_MERGE_GLOBAL_WITH(monitoringPullPort);
   CCT_OPTIONS_MERGE_GLOBAL_WITH(useMonitoring);
 
 #undef CCT_OPTIONS_MERGE_GLOBAL_WITH
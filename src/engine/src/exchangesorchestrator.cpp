@@ -34,14 +34,12 @@
 #include "exchangepublicapitypes.hpp"
 #include "exchangeretriever.hpp"
 #include "market-timestamp-set.hpp"
-#include "market-trader-engine.hpp"
-#include "market-trading-global-result.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
 #include "monetaryamountbycurrencyset.hpp"
 #include "ordersconstraints.hpp"
 #include "queryresulttypes.hpp"
-#include "replay-options.hpp"
 #include "requests-config.hpp"
 #include "threadpool.hpp"
 #include "time-window.hpp"
@@ -955,32 +953,49 @@ MonetaryAmountPerExchange ExchangesOrchestrator::getLastPricePerExchange(Market
 }
 
 MarketDataPerExchange ExchangesOrchestrator::getMarketDataPerExchange(
-    std::span<const Market> marketPerPublicExchange, std::span<const ExchangeNameEnum> exchangeNameEnums) {
+    std::span<const MarketVector> marketsPerPublicExchange, std::span<const ExchangeNameEnum> exchangeNameEnums) {
   UniquePublicSelectedExchanges selectedExchanges = _exchangeRetriever.selectOneAccount(exchangeNameEnums);
 
-  std::array<bool, kNbSupportedExchanges> isMarketTradable;
+  std::array<MarketVector, kNbSupportedExchanges> tradableMarketsPerExchange;
 
-  _threadPool.parallelTransform(selectedExchanges, isMarketTradable.begin(),
-                                [&marketPerPublicExchange](Exchange *exchange) {
-                                  Market market = marketPerPublicExchange[exchange->publicExchangePos()];
-                                  return market.isDefined() && exchange->queryTradableMarkets().contains(market);
-                                });
+  _threadPool.parallelTransform(
+      selectedExchanges, tradableMarketsPerExchange.begin(), [&marketsPerPublicExchange](Exchange *exchange) {
+        MarketVector tradableMarkets;
+        const auto &markets = marketsPerPublicExchange[exchange->publicExchangePos()];
+        if (!markets.empty()) {
+          const MarketSet &exchangeMarkets = exchange->queryTradableMarkets();
+          std::ranges::copy_if(markets, std::back_inserter(tradableMarkets),
+                               [&exchangeMarkets](Market market) { return exchangeMarkets.contains(market); });
+        }
+        return tradableMarkets;
+      });
 
-  FilterVector(selectedExchanges, isMarketTradable);
+  // Tradable markets are stored by public exchange position, as exchanges without any of them are filtered out below
+  std::array<MarketVector, kNbSupportedExchanges> tradableMarketsPerPublicExchange;
+  std::array<bool, kNbSupportedExchanges> hasTradableMarkets;
+  for (decltype(selectedExchanges.size()) exchangePos = 0; exchangePos < selectedExchanges.size(); ++exchangePos) {
+    hasTradableMarkets[exchangePos] = !tradableMarketsPerExchange[exchangePos].empty();
+    tradableMarketsPerPublicExchange[selectedExchanges[exchangePos]->publicExchangePos()] =
+        std::move(tradableMarketsPerExchange[exchangePos]);
+  }
+
+  FilterVector(selectedExchanges, hasTradableMarkets);
 
   MarketDataPerExchange ret(selectedExchanges.size());
-  _threadPool.parallelTransform(selectedExchanges, ret.begin(), [&marketPerPublicExchange](Exchange *exchange) {
-    // Call order book and last trades sequentially for this exchange
-    Market market = marketPerPublicExchange[exchange->publicExchangePos()];
-
-    // Use local variables to ensure deterministic order of api calls (orderbook then last trades).
-    // The order of api calls itself is not important, but we want to keep the same order for repetitive calls.
-    // Indeed in C++, the order of parameter evaluation is undefined, and we don't want that it changes between two
-    // calls even if it's very unlikely.
-    auto orderBook = exchange->getOrderBook(market);
-    auto lastTrades = exchange->getLastTrades(market);
-
-    return std::make_pair(exchange, std::make_pair(std::move(orderBook), std::move(lastTrades)));
+  _threadPool.parallelTransform(selectedExchanges, ret.begin(), [&](Exchange *exchange) {
+    const auto &markets = tradableMarketsPerPublicExchange[exchange->publicExchangePos()];
+
+    // Order books of all markets are retrieved at once (the exchange may then send their requests concurrently),
+    // then last trades market by market, sequentially for this exchange
+    auto orderBooks = exchange->getOrderBooks(markets);
+
+    vector<MarketOrderBookAndLastTrades> marketData;
+    marketData.reserve(markets.size());
+    for (decltype(markets.size()) marketPos = 0; marketPos < markets.size(); ++marketPos) {
+      marketData.emplace_back(std::move(orderBooks[marketPos]), exchange->getLastTrades(markets[marketPos]));
+    }
+
+    return std::make_pair(exchange, std::move(marketData));
   });
   return ret;
 }
@@ -1003,71 +1018,25 @@ MarketTimestampSetsPerExchange ExchangesOrchestrator::pullAvailableMarketsForRep
   return marketTimestampSetsPerExchange;
 }
 
-MarketTradeRangeStatsPerExchange ExchangesOrchestrator::traderConsumeRange(
-    const ReplayOptions &replayOptions, TimeWindow subTimeWindow, std::span<MarketTraderEngine> marketTraderEngines,
-    ExchangeNameEnumSpan exchangeNames) {
+int ExchangesOrchestrator::compactMarketDataForReplay(Market market, ExchangeNameSpan exchangeNames) {
+  log::info("Compact {} market data for replay from {}", market.isDefined() ? market.str() : "all",
+            ConstructAccumulatedExchangeNames(exchangeNames));
   UniquePublicSelectedExchanges selectedExchanges = _exchangeRetriever.selectOneAccount(exchangeNames);
-
-  MarketTradeRangeStatsPerExchange tradeRangeResultsPerExchange(selectedExchanges.size());
-
-  _threadPool.parallelTransform(
-      selectedExchanges, marketTraderEngines, tradeRangeResultsPerExchange.begin(),
-      [subTimeWindow, &replayOptions](Exchange *exchange, MarketTraderEngine &marketTraderEngine) {
-        Market market = marketTraderEngine.market();
-        auto &apiPublic = exchange->apiPublic();
-
-        auto marketOrderBooks = apiPublic.pullMarketOrderBooksForReplay(market, subTimeWindow);
-        auto publicTrades = apiPublic.pullTradesForReplay(market, subTimeWindow);
-
-        TradeRangeStats tradeRangeStats;
-
-        switch (replayOptions.replayMode()) {
-          case ReplayOptions::ReplayMode::kValidateOnly:
-            tradeRangeStats = marketTraderEngine.validateRange(std::move(marketOrderBooks), std::move(publicTrades));
-            break;
-          case ReplayOptions::ReplayMode::kCheckedLaunchAlgorithm:
-            tradeRangeStats = marketTraderEngine.validateRange(marketOrderBooks, publicTrades);
-            marketTraderEngine.tradeRange(std::move(marketOrderBooks), std::move(publicTrades));
-            break;
-          case ReplayOptions::ReplayMode::kUncheckedLaunchAlgorithm:
-            tradeRangeStats = marketTraderEngine.tradeRange(std::move(marketOrderBooks), std::move(publicTrades));
-            break;
-          default:
-            break;
-        }
-
-        return std::make_pair(exchange, std::move(tradeRangeStats));
-      });
-
-  return tradeRangeResultsPerExchange;
+  vector<int> nbCompactedFilesPerExchange(selectedExchanges.size());
+  _threadPool.parallelTransform(selectedExchanges, nbCompactedFilesPerExchange.begin(), [market](Exchange *exchange) {
+    return exchange->apiPublic().compactMarketDataForReplay(market);
+  });
+  return std::accumulate(nbCompactedFilesPerExchange.begin(), nbCompactedFilesPerExchange.end(), 0);
 }
 
-MarketTradingGlobalResultPerExchange ExchangesOrchestrator::getMarketTraderResultPerExchange(
-    std::span<MarketTraderEngine> marketTraderEngines, MarketTradeRangeStatsPerExchange &&tradeRangeStatsPerExchange,
-    ExchangeNameEnumSpan exchangeNames) {
-  UniquePublicSelectedExchanges selectedExchanges = _exchangeRetriever.selectOneAccount(exchangeNames);
-
-  if (selectedExchanges.size() != tradeRangeStatsPerExchange.size()) {
-    throw exception("Inconsistent selected exchange sizes");
-  }
-
-  MarketTradingResultPerExchange marketTradingResultPerExchange(selectedExchanges.size());
-
-  _threadPool.parallelTransform(selectedExchanges, marketTraderEngines, marketTradingResultPerExchange.begin(),
-                                [](const Exchange *exchange, MarketTraderEngine &marketTraderEngine) {
-                                  return std::make_pair(exchange, marketTraderEngine.finalizeAndComputeResult());
-                                });
-
-  MarketTradingGlobalResultPerExchange marketTradingGlobalResultPerExchange(selectedExchanges.size());
-  std::ranges::transform(
-      marketTradingResultPerExchange, tradeRangeStatsPerExchange, marketTradingGlobalResultPerExchange.begin(),
-      [](auto &exchangeMarketTradingResult, auto &exchangeTradeRangeStats) {
-        return std::make_pair(exchangeMarketTradingResult.first,
-                              MarketTradingGlobalResult{std::move(exchangeMarketTradingResult.second),
-                                                        std::move(exchangeTradeRangeStats.second)});
-      });
-
-  return marketTradingGlobalResultPerExchange;
+int ExchangesOrchestrator::refreshCachesAhead(Duration horizon) {
+  UniquePublicSelectedExchanges selectedExchanges = _exchangeRetriever.selectOneAccount(ExchangeNameSpan{});
+  vector<int> nbRefreshedValuesPerExchange(selectedExchanges.size());
+  _threadPool.parallelTransform(selectedExchanges, nbRefreshedValuesPerExchange.begin(), [horizon](Exchange *exchange) {
+    // No need to create an exchange only to refresh its caches
+    return exchange->isApiPublicCreated() ? exchange->apiPublic().refreshCachesAhead(horizon) : 0;
+  });
+  return std::accumulate(nbRefreshedValuesPerExchange.begin(), nbRefreshedValuesPerExchange.end(), 0);
 }
 
 }  // namespace cct
@@ -1,13 +1,15 @@
 #include "metricsexporter.hpp"
 
 #include <array>
+#include <string_view>
 
 #include "abstractmetricgateway.hpp"
-#include "curlmetrics.hpp"
 #include "currencycode.hpp"
 #include "enum-string.hpp"
+#include "exchange-name-enum.hpp"
 #include "exchange.hpp"
 #include "market.hpp"
+#include "metric-handles.hpp"
 #include "metric.hpp"
 #include "monetaryamount.hpp"
 #include "publictrade.hpp"
@@ -19,11 +21,12 @@
 
 namespace cct {
 
-MetricsExporter::MetricsExporter(AbstractMetricGateway *pMetricsGateway) : _pMetricsGateway(pMetricsGateway) {
-  if (_pMetricsGateway != nullptr) {
-    createSummariesAndHistograms();
-  }
-}
+namespace {
+constexpr std::string_view kBestPricesHelp = "Best bids and asks prices";
+constexpr std::string_view kBestVolumesHelp = "Best bids and asks volumes";
+}  // namespace
+
+MetricsExporter::MetricsExporter(AbstractMetricGateway *pMetricsGateway) : _pMetricsGateway(pMetricsGateway) {}
 
 void MetricsExporter::exportHealthCheckMetrics(const ExchangeHealthCheckStatus &healthCheckPerExchange) {
   RETURN_IF_NO_MONITORING;
@@ -61,61 +64,34 @@ void MetricsExporter::exportBalanceMetrics(const BalancePerExchange &balancePerE
 
 void MetricsExporter::exportTickerMetrics(const ExchangeTickerMaps &marketOrderBookMaps) {
   RETURN_IF_NO_MONITORING;
-  MetricKey key;
+  static constexpr BestPricesMetricNames kMetricNames{"limit_price", kBestPricesHelp, "limit_volume", kBestVolumesHelp};
   for (const auto &[exchange, marketOrderBookMap] : marketOrderBookMaps) {
-    key.set(kMetricNameKey, "limit_price");
-    key.set(kMetricHelpKey, "Best bids and asks prices");
-    key.set("exchange", exchange->name());
-    for (const auto &[mk, marketOrderbook] : marketOrderBookMap) {
-      key.set("market", mk.assetsPairStrLower('-'));
-      key.set("side", "ask");
-      _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                            marketOrderbook.lowestAskPrice().toDouble());
-      key.set("side", "bid");
-      _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                            marketOrderbook.highestBidPrice().toDouble());
-    }
-    key.set(kMetricNameKey, "limit_volume");
-    key.set(kMetricHelpKey, "Best bids and asks volumes");
+    const ExchangeNameEnum exchangeNameEnum = exchange->exchangeNameEnum();
     for (const auto &[mk, marketOrderbook] : marketOrderBookMap) {
-      key.set("market", mk.assetsPairStrLower('-'));
-      key.set("side", "ask");
-      _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                            marketOrderbook.amountAtAskPrice().toDouble());
-      key.set("side", "bid");
-      _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                            marketOrderbook.amountAtBidPrice().toDouble());
+      const auto &gauges = getBestPricesGauges(_tickerGauges, kMetricNames, exchangeNameEnum, mk);
+      gauges.askPrice.set(marketOrderbook.lowestAskPrice().toDouble());
+      gauges.bidPrice.set(marketOrderbook.highestBidPrice().toDouble());
+      gauges.askVolume.set(marketOrderbook.amountAtAskPrice().toDouble());
+      gauges.bidVolume.set(marketOrderbook.amountAtBidPrice().toDouble());
     }
   }
 }
 
-void MetricsExporter::exportOrderbookMetrics(const MarketOrderBookConversionRates &marketOrderBookConversionRates) {
+void MetricsExporter::exportOrderbookMetrics(
+    std::span<const MarketOrderBookConversionRate> marketOrderBookConversionRates) {
   RETURN_IF_NO_MONITORING;
-  MetricKey key = CreateMetricKey("limit_pri", "Best bids and asks prices");
-
-  for (const auto &[exchangeNameEnum, marketOrderBook, optConversionRate] : marketOrderBookConversionRates) {
-    key.set("market", marketOrderBook.market().assetsPairStrLower('-'));
-    key.set("exchange", EnumToString(exchangeNameEnum));
-    key.set("side", "ask");
-    _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key, marketOrderBook.lowestAskPrice().toDouble());
-    key.set("side", "bid");
-    _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key, marketOrderBook.highestBidPrice().toDouble());
-  }
-  key.set(kMetricNameKey, "limit_vol");
-  key.set(kMetricHelpKey, "Best bids and asks volumes");
+  static constexpr BestPricesMetricNames kMetricNames{"limit_pri", kBestPricesHelp, "limit_vol", kBestVolumesHelp};
   for (const auto &[exchangeNameEnum, marketOrderBook, optConversionRate] : marketOrderBookConversionRates) {
-    key.set("market", marketOrderBook.market().assetsPairStrLower('-'));
-    key.set("exchange", EnumToString(exchangeNameEnum));
-    key.set("side", "ask");
-    _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                          marketOrderBook.amountAtAskPrice().toDouble());
-    key.set("side", "bid");
-    _pMetricsGateway->add(MetricType::kGauge, MetricOperation::kSet, key,
-                          marketOrderBook.amountAtBidPrice().toDouble());
+    const auto &gauges =
+        getBestPricesGauges(_orderbookGauges, kMetricNames, exchangeNameEnum, marketOrderBook.market());
+    gauges.askPrice.set(marketOrderBook.lowestAskPrice().toDouble());
+    gauges.bidPrice.set(marketOrderBook.highestBidPrice().toDouble());
+    gauges.askVolume.set(marketOrderBook.amountAtAskPrice().toDouble());
+    gauges.bidVolume.set(marketOrderBook.amountAtBidPrice().toDouble());
   }
 }
 
-void MetricsExporter::exportLastTradesMetrics(const TradesPerExchange &lastTradesPerExchange) {
+void MetricsExporter::exportLastTradesMetrics(std::span<const ExchangeWith<PublicTradeVector>> lastTradesPerExchange) {
   RETURN_IF_NO_MONITORING;
   MetricKey key = CreateMetricKey("", "All public trades that occurred on the market");
 
@@ -152,10 +128,27 @@ void MetricsExporter::exportLastTradesMetrics(const TradesPerExchange &lastTrade
   }
 }
 
-void MetricsExporter::createSummariesAndHistograms() {
-  for (const auto &[requestType, metricKey] : CurlMetrics::kRequestDurationKeys) {
-    static constexpr std::array kRequestDurationBoundariesMs = {5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0};
-    _pMetricsGateway->createHistogram(metricKey, kRequestDurationBoundariesMs);
+const MetricsExporter::BestPricesGauges &MetricsExporter::getBestPricesGauges(
+    BestPricesGaugesPerExchange &bestPricesGaugesPerExchange, const BestPricesMetricNames &metricNames,
+    ExchangeNameEnum exchangeNameEnum, Market market) {
+  auto &bestPricesGaugesPerMarket = bestPricesGaugesPerExchange[static_cast<int>(exchangeNameEnum)];
+  auto [it, inserted] = bestPricesGaugesPerMarket.try_emplace(market);
+  BestPricesGauges &gauges = it->second;
+  if (inserted) {
+    MetricKey key = CreateMetricKey(metricNames.priceName, metricNames.priceHelp);
+    key.set("exchange", EnumToString(exchangeNameEnum));
+    key.set("market", market.assetsPairStrLower('-'));
+    key.set("side", "ask");
+    gauges.askPrice = _pMetricsGateway->registerGauge(key);
+    key.set("side", "bid");
+    gauges.bidPrice = _pMetricsGateway->registerGauge(key);
+
+    key.set(kMetricNameKey, metricNames.volumeName);
+    key.set(kMetricHelpKey, metricNames.volumeHelp);
+    gauges.bidVolume = _pMetricsGateway->registerGauge(key);
+    key.set("side", "ask");
+    gauges.askVolume = _pMetricsGateway->registerGauge(key);
   }
+  return gauges;
 }
 }  // namespace cct
\ No newline at end of file
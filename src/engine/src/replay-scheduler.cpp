@@ -0,0 +1,287 @@
+#include "replay-scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include "cct_exception.hpp"
+#include "cct_fixedcapacityvector.hpp"
+#include "cct_log.hpp"
+#include "cct_vector.hpp"
+#include "exchange-name-enum.hpp"
+#include "exchange.hpp"
+#include "exchangepublicapi.hpp"
+#include "market-trader-engine.hpp"
+#include "market-trading-global-result.hpp"
+#include "market.hpp"
+#include "marketorderbook.hpp"
+#include "publictrade.hpp"
+#include "queryresulttypes.hpp"
+#include "replay-options.hpp"
+#include "threadpool.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+#include "trade-range-stats.hpp"
+
+namespace cct {
+
+namespace {
+int ComputeNbMaxThreads(int nbMaxThreads) {
+  if (nbMaxThreads > 0) {
+    return nbMaxThreads;
+  }
+  // hardware_concurrency may return 0 if the value is not computable
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+Duration ElapsedTimeSince(std::chrono::steady_clock::time_point startTime) {
+  return std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - startTime);
+}
+}  // namespace
+
+ReplayStats &ReplayStats::operator+=(const ReplayStats &rhs) {
+  nbMarketOrderBooks += rhs.nbMarketOrderBooks;
+  nbPublicTrades += rhs.nbPublicTrades;
+  deserializationTime += rhs.deserializationTime;
+  validationTime += rhs.validationTime;
+  tradingTime += rhs.tradingTime;
+  return *this;
+}
+
+ReplayScheduler::ReplayScheduler(const ReplayOptions &replayOptions, Duration loadChunkDuration, int nbMaxThreads)
+    : _replayOptions(replayOptions),
+      _loadChunkDuration(loadChunkDuration),
+      _nbMaxThreads(ComputeNbMaxThreads(nbMaxThreads)) {}
+
+vector<ReplayScheduler::ReplayJobResults> ReplayScheduler::run(std::span<ReplayJob> replayJobs) {
+  vector<ReplayJobResults> results(replayJobs.size());
+  if (replayJobs.empty()) {
+    return results;
+  }
+
+  const int nbJobThreads = std::min(_nbMaxThreads, static_cast<int>(replayJobs.size()));
+
+  log::info("Replay {} market(s) on {} thread(s)", replayJobs.size(), nbJobThreads);
+
+  // Each running job has at most one pending load at a time, and neither loading nor trading tasks wait on anything,
+  // so the job threads can wait for them without risk of deadlock.
+  // Pools are destroyed in reverse order of declaration, the replay one first, after the completion of all the jobs.
+  ThreadPool loadingThreadPool(nbJobThreads);
+  ThreadPool tradingThreadPool(_nbMaxThreads);
+  ThreadPool replayThreadPool(nbJobThreads);
+
+  vector<ReplayStats> statsPerJob(replayJobs.size());
+
+  replayThreadPool.parallelTransform(
+      replayJobs, results.begin(),
+      [this, replayJobs, &statsPerJob, &loadingThreadPool, &tradingThreadPool](ReplayJob &replayJob) {
+        const auto jobPos = &replayJob - replayJobs.data();
+        return runJob(replayJob, loadingThreadPool, tradingThreadPool, statsPerJob[jobPos]);
+      });
+
+  for (const ReplayStats &jobStats : statsPerJob) {
+    _stats += jobStats;
+  }
+
+  return results;
+}
+
+ReplayScheduler::MarketDataPerExchange ReplayScheduler::LoadMarketData(
+    Market market, const ExchangeRetriever::UniquePublicSelectedExchanges &exchanges, TimeWindow subTimeWindow) {
+  MarketDataPerExchange marketDataPerExchange;
+  for (Exchange *exchange : exchanges) {
+    auto &apiPublic = exchange->apiPublic();
+
+    auto &marketData = marketDataPerExchange.emplace_back();
+
+    marketData.marketOrderBooks = apiPublic.pullMarketOrderBooksForReplay(market, subTimeWindow);
+    marketData.publicTrades = apiPublic.pullTradesForReplay(market, subTimeWindow);
+  }
+  return marketDataPerExchange;
+}
+
+ReplayScheduler::ReplayJobResults ReplayScheduler::runJob(ReplayJob &replayJob, ThreadPool &loadingThreadPool,
+                                                          ThreadPool &tradingThreadPool, ReplayStats &jobStats) const {
+  auto &algorithmJobs = replayJob.algorithmJobs;
+
+  ReplayJobResults replayJobResults(algorithmJobs.size());
+
+  // Exchanges of all the algorithms, in order of appearance. Market data will be loaded once for each of them.
+  ExchangeRetriever::UniquePublicSelectedExchanges exchanges;
+  for (const auto &algorithmJob : algorithmJobs) {
+    if (algorithmJob.exchanges.size() != algorithmJob.marketTraderEngines.size()) {
+      throw exception("Inconsistent selected exchange sizes");
+    }
+    for (Exchange *exchange : algorithmJob.exchanges) {
+      if (std::ranges::find(exchanges, exchange) == exchanges.end()) {
+        exchanges.push_back(exchange);
+      }
+    }
+  }
+
+  if (exchanges.empty()) {
+    return replayJobResults;
+  }
+
+  // Validation only depends on the market data and on the last consumed market order book, which is the same for all
+  // the engines of a given exchange. Thus it is made only once per exchange, by the first engine of this exchange.
+  FixedCapacityVector<MarketTraderEngine *, kNbSupportedExchanges> validationEngines;
+  for (Exchange *exchange : exchanges) {
+    for (auto &algorithmJob : algorithmJobs) {
+      const auto exchangeIt = std::ranges::find(algorithmJob.exchanges, exchange);
+      if (exchangeIt != algorithmJob.exchanges.end()) {
+        validationEngines.push_back(&algorithmJob.marketTraderEngines[exchangeIt - algorithmJob.exchanges.begin()]);
+        break;
+      }
+    }
+  }
+
+  vector<TradeRangeStatsPerExchange> tradeRangeStatsPerAlgorithm;
+  tradeRangeStatsPerAlgorithm.reserve(algorithmJobs.size());
+  for (const auto &algorithmJob : algorithmJobs) {
+    tradeRangeStatsPerAlgorithm.emplace_back(algorithmJob.marketTraderEngines.size());
+  }
+
+  const Market market = replayJob.market;
+  const TimeWindow timeWindow = _replayOptions.timeWindow();
+  const bool validateRanges = _replayOptions.replayMode() != ReplayOptions::ReplayMode::kUncheckedLaunchAlgorithm;
+
+  // Loading tasks capture the exchanges by value: if this job exits with an exception while a load is pending, the
+  // abandoned task should not refer to the stack of this function.
+  const auto loadAsync = [market, &exchanges, &loadingThreadPool](TimeWindow subTimeWindow) {
+    return loadingThreadPool.enqueue([market, exchanges, subTimeWindow] {
+      const auto startTime = std::chrono::steady_clock::now();
+      LoadedMarketData loadedMarketData{LoadMarketData(market, exchanges, subTimeWindow)};
+      loadedMarketData.loadTime = ElapsedTimeSince(startTime);
+      return loadedMarketData;
+    });
+  };
+
+  // Main loop, with time window chunks of loadChunkDuration.
+  // Data of the next chunk is loaded in the background while the current one is consumed by the engines.
+  TimeWindow subTimeWindow(timeWindow.from(), _loadChunkDuration);
+  std::future<LoadedMarketData> nextMarketData;
+  if (subTimeWindow.overlaps(timeWindow)) {
+    nextMarketData = loadAsync(subTimeWindow);
+  }
+
+  vector<TradeRangeStatsPerExchange> subRangeStatsPerAlgorithm(algorithmJobs.size());
+  vector<Duration> tradingTimePerAlgorithm(algorithmJobs.size());
+
+  while (nextMarketData.valid()) {
+    LoadedMarketData loadedMarketData = nextMarketData.get();
+    MarketDataPerExchange &marketDataPerExchange = loadedMarketData.marketDataPerExchange;
+
+    jobStats.deserializationTime += loadedMarketData.loadTime;
+
+    subTimeWindow += _loadChunkDuration;
+    if (subTimeWindow.overlaps(timeWindow)) {
+      nextMarketData = loadAsync(subTimeWindow);
+    }
+
+    TradeRangeStatsPerExchange validationStatsPerExchange(exchanges.size());
+    SharedMarketDataPerExchange sharedMarketDataPerExchange;
+
+    const auto validationStartTime = std::chrono::steady_clock::now();
+
+    for (decltype(exchanges.size()) exchangePos{}; exchangePos < exchanges.size(); ++exchangePos) {
+      auto &marketData = marketDataPerExchange[exchangePos];
+      jobStats.nbMarketOrderBooks += static_cast<int64_t>(marketData.marketOrderBooks.size());
+      jobStats.nbPublicTrades += static_cast<int64_t>(marketData.publicTrades.size());
+      if (validateRanges) {
+        validationStatsPerExchange[exchangePos] =
+            validationEngines[exchangePos]->validateRange(marketData.marketOrderBooks, marketData.publicTrades);
+      }
+      // From now on, market data is immutable and shared by the engines of all the algorithms
+      sharedMarketDataPerExchange.push_back(std::make_shared<const MarketData>(std::move(marketData)));
+    }
+
+    if (validateRanges) {
+      jobStats.validationTime += ElapsedTimeSince(validationStartTime);
+    }
+
+    tradingThreadPool.parallelTransform(
+        algorithmJobs, subRangeStatsPerAlgorithm.begin(),
+        [this, &algorithmJobs, &exchanges, sharedMarketDataPerExchange, &validationStatsPerExchange,
+         &tradingTimePerAlgorithm](ReplayAlgorithmJob &algorithmJob) {
+          const auto tradingStartTime = std::chrono::steady_clock::now();
+          auto tradeRangeStatsPerExchange =
+              consumeRange(algorithmJob, exchanges, sharedMarketDataPerExchange, validationStatsPerExchange);
+          tradingTimePerAlgorithm[&algorithmJob - algorithmJobs.data()] += ElapsedTimeSince(tradingStartTime);
+          return tradeRangeStatsPerExchange;
+        });
+
+    for (decltype(algorithmJobs.size()) algorithmPos{}; algorithmPos < algorithmJobs.size(); ++algorithmPos) {
+      auto &tradeRangeStatsPerExchange = tradeRangeStatsPerAlgorithm[algorithmPos];
+      const auto &subRangeStatsPerExchange = subRangeStatsPerAlgorithm[algorithmPos];
+      for (decltype(tradeRangeStatsPerExchange.size()) exchangePos{}; exchangePos < tradeRangeStatsPerExchange.size();
+           ++exchangePos) {
+        tradeRangeStatsPerExchange[exchangePos] += subRangeStatsPerExchange[exchangePos];
+      }
+    }
+  }
+
+  for (Duration tradingTime : tradingTimePerAlgorithm) {
+    jobStats.tradingTime += tradingTime;
+  }
+
+  for (decltype(algorithmJobs.size()) algorithmPos{}; algorithmPos < algorithmJobs.size(); ++algorithmPos) {
+    auto &algorithmJob = algorithmJobs[algorithmPos];
+    auto &tradeRangeStatsPerExchange = tradeRangeStatsPerAlgorithm[algorithmPos];
+    auto &marketTradingGlobalResultPerExchange = replayJobResults[algorithmPos];
+    for (decltype(algorithmJob.marketTraderEngines.size()) exchangePos{};
+         exchangePos < algorithmJob.marketTraderEngines.size(); ++exchangePos) {
+      marketTradingGlobalResultPerExchange.emplace_back(
+          algorithmJob.exchanges[exchangePos],
+          MarketTradingGlobalResult{algorithmJob.marketTraderEngines[exchangePos].finalizeAndComputeResult(),
+                                    std::move(tradeRangeStatsPerExchange[exchangePos])});
+    }
+  }
+
+  return replayJobResults;
+}
+
+ReplayScheduler::TradeRangeStatsPerExchange ReplayScheduler::consumeRange(
+    ReplayAlgorithmJob &algorithmJob, const ExchangeRetriever::UniquePublicSelectedExchanges &exchanges,
+    const SharedMarketDataPerExchange &sharedMarketDataPerExchange,
+    const TradeRangeStatsPerExchange &validationStatsPerExchange) const {
+  TradeRangeStatsPerExchange tradeRangeStatsPerExchange;
+
+  for (decltype(algorithmJob.marketTraderEngines.size()) exchangePos{};
+       exchangePos < algorithmJob.marketTraderEngines.size(); ++exchangePos) {
+    const auto dataPos = std::ranges::find(exchanges, algorithmJob.exchanges[exchangePos]) - exchanges.begin();
+    const MarketData &marketData = *sharedMarketDataPerExchange[dataPos];
+    const TradeRangeStats &validationStats = validationStatsPerExchange[dataPos];
+
+    auto &marketTraderEngine = algorithmJob.marketTraderEngines[exchangePos];
+
+    std::span<const MarketOrderBook> marketOrderBooks(marketData.marketOrderBooks.data(),
+                                                      marketData.marketOrderBooks.size());
+    std::span<const PublicTrade> publicTrades(marketData.publicTrades.data(), marketData.publicTrades.size());
+
+    switch (_replayOptions.replayMode()) {
+      case ReplayOptions::ReplayMode::kValidateOnly:
+        marketTraderEngine.skipRange(marketOrderBooks);
+        tradeRangeStatsPerExchange.push_back(validationStats);
+        break;
+      case ReplayOptions::ReplayMode::kCheckedLaunchAlgorithm:
+        marketTraderEngine.tradeRange(marketOrderBooks, publicTrades);
+        tradeRangeStatsPerExchange.push_back(validationStats);
+        break;
+      case ReplayOptions::ReplayMode::kUncheckedLaunchAlgorithm:
+        tradeRangeStatsPerExchange.push_back(marketTraderEngine.tradeRange(marketOrderBooks, publicTrades));
+        break;
+      default:
+        tradeRangeStatsPerExchange.emplace_back();
+        break;
+    }
+  }
+
+  return tradeRangeStatsPerExchange;
+}
+
+}  // namespace cct
@@ -1,9 +1,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <optional>
 #include <span>
 
+#include "cct_vector.hpp"
 #include "currencycode.hpp"
 #include "currencyexchange.hpp"
 #include "currencyexchangeflatset.hpp"
@@ -16,7 +18,9 @@
 #include "exchangepublicapitypes.hpp"
 #include "exchangeretriever.hpp"
 #include "exchangesorchestrator.hpp"
+#include "market-vector.hpp"
 #include "market.hpp"
+#include "public-trade-vector.hpp"
 #include "queryresulttypes.hpp"
 #include "requests-config.hpp"
 
@@ -179,6 +183,29 @@ TEST_F(ExchangeOrchestratorTest, GetMarketsPerExchangeTwoCurrencies) {
   EXPECT_EQ(exchangesOrchestrator.getMarketsPerExchange(cur1, cur2, exchangeNameSpan), ret);
 }
 
+TEST_F(ExchangeOrchestratorTest, MarketDataSeveralMarketsPerExchange) {
+  std::array<MarketVector, kNbSupportedExchanges> marketsPerPublicExchange;
+  marketsPerPublicExchange[0] = MarketVector{m1, m2};
+  marketsPerPublicExchange[1] = MarketVector{m2};
+
+  const ExchangeNameEnum kTestedExchanges12[] = {static_cast<ExchangeNameEnum>(0), static_cast<ExchangeNameEnum>(1)};
+
+  EXPECT_CALL(exchangePublic1, queryTradableMarkets()).WillOnce(testing::Return(MarketSet{m1, m2}));
+  EXPECT_CALL(exchangePublic2, queryTradableMarkets()).WillOnce(testing::Return(MarketSet{m1, m3}));
+
+  EXPECT_CALL(exchangePublic1, queryOrderBook(m1, testing::_)).WillOnce(testing::Return(marketOrderBook10));
+  EXPECT_CALL(exchangePublic1, queryOrderBook(m2, testing::_)).WillOnce(testing::Return(marketOrderBook20));
+  EXPECT_CALL(exchangePublic1, queryLastTrades(m1, testing::_)).WillOnce(testing::Return(PublicTradeVector{}));
+  EXPECT_CALL(exchangePublic1, queryLastTrades(m2, testing::_)).WillOnce(testing::Return(PublicTradeVector{}));
+
+  // Second exchange does not trade BTC-EUR, it is not returned
+  const MarketDataPerExchange expectedMarketData{
+      {&exchange1, vector<MarketOrderBookAndLastTrades>{{marketOrderBook10, PublicTradeVector{}},
+                                                        {marketOrderBook20, PublicTradeVector{}}}}};
+  EXPECT_EQ(exchangesOrchestrator.getMarketDataPerExchange(marketsPerPublicExchange, kTestedExchanges12),
+            expectedMarketData);
+}
+
 TEST_F(ExchangeOrchestratorTest, GetExchangesTradingCurrency) {
   CurrencyCode currencyCode{"XRP"};
 
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+
+#include "besturlpicker.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "curloptions.hpp"
+#include "permanentcurloptions.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+class AbstractMetricGateway;
+
+/// Asynchronous HTTP requests engine based on the curl multi interface.
+///
+/// All in-flight requests are run by a single event loop thread, whatever their number and target exchanges.
+/// Requests are submitted to queues (typically one per exchange, see 'addQueue'), each of them having:
+///  - its own non-blocking rate limit, derived from the minimum duration between queries of its PermanentCurlOptions.
+///    It can be shared with a CurlHandle through its QueryIntervalLimiter, so that they are spaced together.
+///  - its own retry policy, with exponential backoff.
+/// Rate limit and retry delays are timers of the event loop - no thread is ever put to sleep waiting for them.
+///
+/// Contrary to CurlHandle, this class is thread safe: requests can be submitted from any thread.
+class CurlMultiEngine {
+ public:
+  using QueueId = int32_t;
+
+  struct Request {
+    QueueId queueId;
+    std::string_view endpoint;
+    CurlOptions opts;
+  };
+
+  /// Creates a new engine and starts its event loop thread.
+  CurlMultiEngine();
+
+  CurlMultiEngine(const CurlMultiEngine &) = delete;
+  CurlMultiEngine(CurlMultiEngine &&) = delete;
+  CurlMultiEngine &operator=(const CurlMultiEngine &) = delete;
+  CurlMultiEngine &operator=(CurlMultiEngine &&) = delete;
+
+  /// Stops the event loop. Requests not completed yet are failed with an exception.
+  ~CurlMultiEngine();
+
+  /// Registers a new queue of requests.
+  /// @param bestURLPicker object managing which URL to pick at each query based on response time stats
+  /// @param permanentCurlOptions curl options applied to all requests of this queue
+  /// @param pMetricGateway if not null, queries will export some metrics
+  QueueId addQueue(BestURLPicker bestURLPicker,
+                   const PermanentCurlOptions &permanentCurlOptions = PermanentCurlOptions(),
+                   AbstractMetricGateway *pMetricGateway = nullptr);
+
+  /// Submits a request on given queue (endpoint should start with a '/' and not contain the base URL).
+  /// The returned future will hold the response body, or an exception in case of too many errors with
+  /// TooManyErrorsPolicy::kThrow.
+  std::future<string> submit(QueueId queueId, std::string_view endpoint, const CurlOptions &opts);
+
+  /// Submits all given requests at once, and returns their futures in the same order.
+  vector<std::future<string>> submit(std::span<const Request> requests);
+
+  /// Get the number of requests submitted but not completed yet.
+  int nbPendingRequests() const;
+
+ private:
+  struct PendingRequest;
+  struct Queue;
+
+  using PendingRequestPtr = std::unique_ptr<PendingRequest>;
+
+  void wakeUp() const;
+
+  void run(std::stop_token stopToken);
+
+  void pullSubmittedRequests();
+
+  TimePoint startReadyRequests(TimePoint nowTime);
+
+  void startRequest(Queue &queue, PendingRequestPtr pendingRequest);
+
+  void processCompletedRequests();
+
+  void completeRequest(PendingRequestPtr pendingRequest, int curlCode);
+
+  void failAllRequests();
+
+  // void pointer instead of CURLM to avoid clients to pull unnecessary curl dependencies by just including the header
+  void *_multiHandle = nullptr;
+
+  // Protected by _mutex
+  mutable std::mutex _mutex;
+  vector<std::unique_ptr<Queue>> _queues;
+  std::deque<PendingRequestPtr> _submittedRequests;
+  int _nbPendingRequests{};
+
+  // Only accessed by the event loop thread
+  vector<Queue *> _loopQueues;
+  vector<PendingRequestPtr> _inFlightRequests;
+
+  // Started last, once all the other members are initialized
+  std::jthread _eventLoopThread;
+};
+
+}  // namespace cct
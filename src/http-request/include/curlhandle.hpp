@@ -1,13 +1,16 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string_view>
 #include <type_traits>
 
 #include "besturlpicker.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
+#include "curlmetrics.hpp"
 #include "permanentcurloptions.hpp"
+#include "query-interval-limiter.hpp"
 #include "runmodes.hpp"
 #include "timedef.hpp"
 
@@ -54,7 +57,16 @@ class CurlHandle {
 
   [[nodiscard]] std::string_view getNextBaseUrl() const { return _bestURLPicker.getNextBaseURL(); }
 
-  [[nodiscard]] Duration minDurationBetweenQueries() const { return _minDurationBetweenQueries; }
+  [[nodiscard]] const BestURLPicker &bestURLPicker() const { return _bestURLPicker; }
+
+  [[nodiscard]] Duration minDurationBetweenQueries() const {
+    return _pQueryIntervalLimiter == nullptr ? Duration{} : _pQueryIntervalLimiter->minDurationBetweenQueries();
+  }
+
+  /// Get the limiter spacing the queries of this CurlHandle, null if there is no minimum duration between queries.
+  /// It can be shared with a CurlMultiEngine queue (see PermanentCurlOptions::Builder::setQueryIntervalLimiter), and it
+  /// is valid as long as this CurlHandle (or the one it is moved to) is alive.
+  [[nodiscard]] QueryIntervalLimiter *queryIntervalLimiter() const { return _pQueryIntervalLimiter; }
 
   /// Instead of actually performing real calls, instructs this CurlHandle to
   /// return hardcoded responses (in values of given map) based on query endpoints with appended options (in key of
@@ -76,9 +88,10 @@ class CurlHandle {
   // void pointer instead of CURL to avoid having to forward declare (we don't know about the underlying definition)
   // and to avoid clients to pull unnecessary curl dependencies by just including the header
   void *_handle = nullptr;
-  AbstractMetricGateway *_pMetricGateway = nullptr;  // non-owning pointer
-  Duration _minDurationBetweenQueries{};
-  TimePoint _lastQueryTime;
+  CurlMetricHandles _metricHandles;
+  std::unique_ptr<QueryIntervalLimiter> _pOwnedQueryIntervalLimiter;
+  QueryIntervalLimiter *_pQueryIntervalLimiter = nullptr;
+  WeightedRateLimiter *_pWeightedRateLimiter = nullptr;
   BestURLPicker _bestURLPicker;
   string _queryData;
   LogLevel _requestCallLogLevel = LogLevel::off;
@@ -88,7 +101,7 @@ class CurlHandle {
 };
 
 // Simple RAII class managing global init and clean up of Curl library.
-// It's in the same file as CurlHandle so that only one source file has a dependency on curl sources.
+// It's in the same file as CurlHandle so that clients do not have a dependency on curl sources.
 struct CurlInitRAII {
   [[nodiscard]] CurlInitRAII();
 
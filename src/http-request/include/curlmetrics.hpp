@@ -1,17 +1,55 @@
 #pragma once
 
+#include <array>
+#include <iterator>
 #include <map>
 
 #include "httprequesttype.hpp"
+#include "metric-handles.hpp"
 #include "metric.hpp"
 
 namespace cct {
+
+class AbstractMetricGateway;
+
 using MetricKeyPerRequestType = std::map<HttpRequestType, MetricKey>;
 
 struct CurlMetrics {
   static const MetricKeyPerRequestType kNbRequestsKeys;
   static const MetricKeyPerRequestType kRequestDurationKeys;
   static const MetricKeyPerRequestType kNbRequestErrorKeys;
+
+  static constexpr double kRequestDurationBoundariesMs[] = {5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0};
+};
+
+/// Handles to the http request metrics of each request type, registered once at construction so that exporting them
+/// at each query is cheap.
+class CurlMetricHandles {
+ public:
+  /// Creates handles that do not export anything.
+  CurlMetricHandles() noexcept = default;
+
+  /// @param pMetricGateway if null, handles will not export anything
+  explicit CurlMetricHandles(AbstractMetricGateway *pMetricGateway);
+
+  void addRequest(HttpRequestType requestType, double durationMs) const {
+    const auto &handles = _handlesPerRequestType[static_cast<int>(requestType)];
+    handles.nbRequests.increment();
+    handles.requestDuration.observe(durationMs);
+  }
+
+  void addRequestError(HttpRequestType requestType) const {
+    _handlesPerRequestType[static_cast<int>(requestType)].nbRequestErrors.increment();
+  }
+
+ private:
+  struct Handles {
+    MetricCounter nbRequests;
+    MetricHistogram requestDuration;
+    MetricCounter nbRequestErrors;
+  };
+
+  std::array<Handles, std::size(kHttpRequestTypes)> _handlesPerRequestType;
 };
 
-}  // namespace cct
\ No newline at end of file
+}  // namespace cct
@@ -52,6 +52,11 @@ class CurlOptions {
 
   HttpRequestType requestType() const { return _requestType; }
 
+  /// Weight of the request, accounted by the weighted rate limiter of the handle if any.
+  int32_t weight() const { return _weight; }
+
+  void setWeight(int32_t weight) { _weight = weight; }
+
   using trivially_relocatable =
       std::bool_constant<is_trivially_relocatable_v<HttpHeaders> && is_trivially_relocatable_v<CurlPostData>>::type;
 
@@ -64,6 +69,7 @@ class CurlOptions {
   HttpHeaders _httpHeaders;
   const char *_proxyUrl = nullptr;
   CurlPostData _postdata;
+  int32_t _weight = 1;
   bool _proxyReset = false;
   bool _verbose = false;
   bool _postdataInJsonFormat = false;
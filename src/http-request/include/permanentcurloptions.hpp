@@ -9,6 +9,9 @@
 
 namespace cct {
 
+class QueryIntervalLimiter;
+class WeightedRateLimiter;
+
 class PermanentCurlOptions {
  public:
   static constexpr auto kDefaultNbMaxRetries = 5;
@@ -34,6 +37,14 @@ class PermanentCurlOptions {
 
   auto timeout() const { return _timeout; }
 
+  /// Get the rate limiter metering the weight of the requests, shared by all handles of the same exchange.
+  /// May be null if requests are not weighted.
+  WeightedRateLimiter *weightedRateLimiter() const { return _pWeightedRateLimiter; }
+
+  /// Get the limiter spacing the queries by the minimum duration between queries, when it is shared between a
+  /// CurlHandle and a CurlMultiEngine queue. If null, each of them spaces its own queries.
+  QueryIntervalLimiter *queryIntervalLimiter() const { return _pQueryIntervalLimiter; }
+
   class Builder {
    public:
     Builder() noexcept = default;
@@ -103,11 +114,26 @@ class PermanentCurlOptions {
       return *this;
     }
 
+    /// Set the rate limiter shared by all handles of the same exchange. It should outlive the built options.
+    Builder &setWeightedRateLimiter(WeightedRateLimiter *pWeightedRateLimiter) {
+      _pWeightedRateLimiter = pWeightedRateLimiter;
+      return *this;
+    }
+
+    /// Set the limiter spacing the queries, shared by a CurlHandle and a CurlMultiEngine queue. It should outlive the
+    /// built options, and its minimum duration between queries takes precedence.
+    Builder &setQueryIntervalLimiter(QueryIntervalLimiter *pQueryIntervalLimiter) {
+      _pQueryIntervalLimiter = pQueryIntervalLimiter;
+      return *this;
+    }
+
     PermanentCurlOptions build() {
       return {std::move(_userAgent),
               std::move(_acceptedEncoding),
               _minDurationBetweenQueries,
               _timeout,
+              _pWeightedRateLimiter,
+              _pQueryIntervalLimiter,
               _requestCallLogLevel,
               _requestAnswerLogLevel,
               _nbMaxRetries,
@@ -120,6 +146,8 @@ class PermanentCurlOptions {
     string _acceptedEncoding;
     Duration _minDurationBetweenQueries{};
     Duration _timeout{};
+    WeightedRateLimiter *_pWeightedRateLimiter = nullptr;
+    QueryIntervalLimiter *_pQueryIntervalLimiter = nullptr;
     LogLevel _requestCallLogLevel = LogLevel::info;
     LogLevel _requestAnswerLogLevel = LogLevel::trace;
     int _nbMaxRetries = kDefaultNbMaxRetries;
@@ -129,12 +157,15 @@ class PermanentCurlOptions {
 
  private:
   PermanentCurlOptions(string userAgent, string acceptedEncoding, Duration minDurationBetweenQueries, Duration timeout,
+                       WeightedRateLimiter *pWeightedRateLimiter, QueryIntervalLimiter *pQueryIntervalLimiter,
                        LogLevel requestCallLogLevel, LogLevel requestAnswerLogLevel, int nbMaxRetries,
                        bool followLocation, TooManyErrorsPolicy tooManyErrorsPolicy)
       : _userAgent(std::move(userAgent)),
         _acceptedEncoding(std::move(acceptedEncoding)),
         _minDurationBetweenQueries(minDurationBetweenQueries),
         _timeout(timeout),
+        _pWeightedRateLimiter(pWeightedRateLimiter),
+        _pQueryIntervalLimiter(pQueryIntervalLimiter),
         _requestCallLogLevel(requestCallLogLevel),
         _requestAnswerLogLevel(requestAnswerLogLevel),
         _nbMaxRetries(nbMaxRetries),
@@ -145,6 +176,8 @@ class PermanentCurlOptions {
   string _acceptedEncoding;
   Duration _minDurationBetweenQueries;
   Duration _timeout;
+  WeightedRateLimiter *_pWeightedRateLimiter = nullptr;
+  QueryIntervalLimiter *_pQueryIntervalLimiter = nullptr;
   LogLevel _requestCallLogLevel;
   LogLevel _requestAnswerLogLevel;
   int _nbMaxRetries;
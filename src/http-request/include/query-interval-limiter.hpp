@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mutex>
+
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Spaces the requests sent to an exchange by a minimum duration.
+///
+/// An instance can be shared by a CurlHandle and a CurlMultiEngine queue so that the spacing is respected by both
+/// their requests, whatever the thread sending them. Slots are reserved at most once per request, in their arrival
+/// order.
+///
+/// This class is thread safe.
+class QueryIntervalLimiter {
+ public:
+  /// @param minDurationBetweenQueries minimum duration between the start of two consecutive queries
+  explicit QueryIntervalLimiter(Duration minDurationBetweenQueries);
+
+  /// Reserves the slot of next query, and returns its time (at least 'nowTime').
+  /// The caller is expected to wait until this time before sending its query.
+  TimePoint reserve(TimePoint nowTime = Clock::now());
+
+  /// Reserves the slot of next query only if a query can be sent at 'nowTime'.
+  /// @return true if the slot has been reserved
+  bool tryReserve(TimePoint nowTime = Clock::now());
+
+  /// Get the earliest time at which next query can be sent, without reserving it.
+  TimePoint nextQueryTime() const;
+
+  Duration minDurationBetweenQueries() const { return _minDurationBetweenQueries; }
+
+ private:
+  mutable std::mutex _mutex;
+  TimePoint _nextQueryTime;
+  Duration _minDurationBetweenQueries;
+};
+
+}  // namespace cct
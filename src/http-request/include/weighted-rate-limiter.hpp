@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+#include "cct_string.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Token bucket metering the weight of the requests sent to an exchange.
+///
+/// A single instance is meant to be shared by all the CurlHandles (public and private) of an exchange, as exchanges
+/// usually account the weight of all requests coming from the same IP address together.
+/// The bucket holds at most 'maxWeight' tokens, and is refilled continuously at the rate of 'maxWeight' per 'window'.
+/// A request is granted immediately as long as enough tokens are left. Otherwise, its tokens are reserved in advance
+/// and the caller is told how long to wait, so that requests are served in their arrival order.
+/// When the exchange reports its used weight in a response header, the bucket is synchronized with it.
+///
+/// This class is thread safe.
+class WeightedRateLimiter {
+ public:
+  /// @param maxWeight maximum total weight of the requests in a window, should be strictly positive
+  /// @param window duration of the window, should be strictly positive
+  /// @param usedWeightHeader name of the response header reporting the used weight in the current window, if any
+  WeightedRateLimiter(int32_t maxWeight, Duration window, std::string_view usedWeightHeader = {});
+
+  /// Reserves 'weight' tokens at 'nowTime' and returns the duration to wait before sending the request, which is zero
+  /// if enough tokens were left. A weight larger than the maximum weight is capped to it.
+  Duration reserve(int32_t weight, TimePoint nowTime = Clock::now());
+
+  /// Reserves 'weight' tokens, putting the caller thread to sleep only if not enough tokens are left.
+  /// @return the waited duration
+  Duration acquire(int32_t weight);
+
+  /// Synchronizes the bucket with the weight used in the current window, as reported by the exchange.
+  /// As the exchange is the reference, it can only decrease the available weight.
+  void updateUsedWeight(int32_t usedWeight, TimePoint nowTime = Clock::now());
+
+  /// Get the weight available at 'nowTime', negative if some weight has been reserved in advance.
+  double availableWeight(TimePoint nowTime = Clock::now()) const;
+
+  int32_t maxWeight() const { return _maxWeight; }
+
+  Duration window() const { return _window; }
+
+  /// Get the name of the response header reporting the used weight, or an empty string if there is none.
+  const string &usedWeightHeader() const { return _usedWeightHeader; }
+
+ private:
+  double availableWeightNoLock(TimePoint nowTime) const;
+
+  void refill(TimePoint nowTime);
+
+  string _usedWeightHeader;
+  mutable std::mutex _mutex;
+  Duration _window;
+  TimePoint _lastRefillTime;
+  double _availableWeight;
+  int32_t _maxWeight;
+};
+
+}  // namespace cct
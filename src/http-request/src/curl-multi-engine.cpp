@@ -0,0 +1,488 @@
+#include "curl-multi-engine.hpp"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "besturlpicker.hpp"
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "curl-tools.hpp"
+#include "curlmetrics.hpp"
+#include "curloptions.hpp"
+#include "curlpostdata.hpp"
+#include "durationstring.hpp"
+#include "httprequesttype.hpp"
+#include "permanentcurloptions.hpp"
+#include "proxy.hpp"
+#include "query-interval-limiter.hpp"
+#include "timedef.hpp"
+#include "unreachable.hpp"
+#include "weighted-rate-limiter.hpp"
+
+namespace cct {
+
+namespace {
+
+constexpr Duration kInitialRetryDelay = milliseconds(100);
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+// Maximum duration of a single wait of the event loop, when it has no timer to wait for.
+// curl_multi_wakeup interrupts it as soon as a new request is submitted.
+constexpr milliseconds kMaxPollDuration(1000);
+#else
+// curl_multi_poll and curl_multi_wakeup are only available since curl 7.68.0. Before, the event loop cannot be woken
+// up when a new request is submitted, so its waits are kept short to bound the latency of new requests.
+constexpr milliseconds kMaxPollDuration(10);
+#endif
+
+}  // namespace
+
+struct CurlMultiEngine::PendingRequest {
+  PendingRequest(Queue &queue, std::string_view endpoint, const CurlOptions &opts)
+      : pQueue(&queue), endpoint(endpoint), opts(opts) {}
+
+  PendingRequest(const PendingRequest &) = delete;
+  PendingRequest(PendingRequest &&) = delete;
+  PendingRequest &operator=(const PendingRequest &) = delete;
+  PendingRequest &operator=(PendingRequest &&) = delete;
+
+  ~PendingRequest() { curl_slist_free_all(pHttpHeaders); }
+
+  Queue *pQueue;
+  string endpoint;
+  CurlOptions opts;
+  std::promise<string> promise;
+
+  // Below fields are set at each start of the request, their memory should stay valid until its completion
+  string url;
+  string postFields;
+  string response;
+  curl_slist *pHttpHeaders = nullptr;
+  CURL *curl = nullptr;
+  TimePoint startTime;
+  int8_t baseUrlPos = 0;
+
+  // Retry state
+  TimePoint notBefore;
+  Duration retryDelay = kInitialRetryDelay;
+  int nbRetries = 0;
+
+  // Whether the weight of the next start of the request has already been reserved in the weighted rate limiter
+  bool isWeightReserved = false;
+};
+
+struct CurlMultiEngine::Queue {
+  Queue(BestURLPicker bestURLPicker, const PermanentCurlOptions &permanentCurlOptions,
+        AbstractMetricGateway *pMetricGateway)
+      : bestURLPicker(std::move(bestURLPicker)),
+        permanentCurlOptions(permanentCurlOptions),
+        metricHandles(pMetricGateway),
+        pQueryIntervalLimiter(permanentCurlOptions.queryIntervalLimiter()) {
+    if (pQueryIntervalLimiter == nullptr && permanentCurlOptions.minDurationBetweenQueries() != Duration::zero()) {
+      pOwnedQueryIntervalLimiter =
+          std::make_unique<QueryIntervalLimiter>(permanentCurlOptions.minDurationBetweenQueries());
+      pQueryIntervalLimiter = pOwnedQueryIntervalLimiter.get();
+    }
+  }
+
+  Queue(const Queue &) = delete;
+  Queue(Queue &&) = delete;
+  Queue &operator=(const Queue &) = delete;
+  Queue &operator=(Queue &&) = delete;
+
+  ~Queue() {
+    for (CURL *curl : idleHandles) {
+      curl_easy_cleanup(curl);
+    }
+  }
+
+  /// Get an easy handle with the permanent options of this queue, reusing an idle one if possible so that its
+  /// connections are kept alive.
+  CURL *acquireHandle() {
+    if (!idleHandles.empty()) {
+      CURL *curl = idleHandles.back();
+      idleHandles.pop_back();
+      return curl;
+    }
+    CURL *curl = curl_easy_init();
+    if (curl == nullptr) {
+      throw std::bad_alloc();
+    }
+    CurlSetPermanentOptions(curl, permanentCurlOptions);
+    return curl;
+  }
+
+  BestURLPicker bestURLPicker;
+  PermanentCurlOptions permanentCurlOptions;
+  CurlMetricHandles metricHandles;
+  // Spacing of the queries, possibly shared with the CurlHandle of the exchange. Null if queries are not spaced.
+  std::unique_ptr<QueryIntervalLimiter> pOwnedQueryIntervalLimiter;
+  QueryIntervalLimiter *pQueryIntervalLimiter;
+  std::deque<PendingRequestPtr> waitingRequests;
+  vector<CURL *> idleHandles;
+};
+
+CurlMultiEngine::CurlMultiEngine() : _multiHandle(curl_multi_init()) {
+  if (_multiHandle == nullptr) {
+    throw std::bad_alloc();
+  }
+  _eventLoopThread = std::jthread([this](std::stop_token stopToken) { run(std::move(stopToken)); });
+}
+
+CurlMultiEngine::~CurlMultiEngine() {
+  _eventLoopThread.request_stop();
+  wakeUp();
+  _eventLoopThread.join();
+
+  failAllRequests();
+
+  curl_multi_cleanup(reinterpret_cast<CURLM *>(_multiHandle));
+}
+
+CurlMultiEngine::QueueId CurlMultiEngine::addQueue(BestURLPicker bestURLPicker,
+                                                   const PermanentCurlOptions &permanentCurlOptions,
+                                                   AbstractMetricGateway *pMetricGateway) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  _queues.push_back(std::make_unique<Queue>(std::move(bestURLPicker), permanentCurlOptions, pMetricGateway));
+  return static_cast<QueueId>(_queues.size() - 1U);
+}
+
+std::future<string> CurlMultiEngine::submit(QueueId queueId, std::string_view endpoint, const CurlOptions &opts) {
+  const Request request{queueId, endpoint, opts};
+  return std::move(submit(std::span<const Request>(&request, 1)).front());
+}
+
+vector<std::future<string>> CurlMultiEngine::submit(std::span<const Request> requests) {
+  vector<std::future<string>> futures;
+  futures.reserve(requests.size());
+
+  {
+    std::lock_guard<std::mutex> guard(_mutex);
+    for (const Request &request : requests) {
+      if (request.queueId < 0 || static_cast<decltype(_queues.size())>(request.queueId) >= _queues.size()) {
+        throw exception("Invalid queue id {}", request.queueId);
+      }
+    }
+    for (const Request &request : requests) {
+      auto &pendingRequest = _submittedRequests.emplace_back(
+          std::make_unique<PendingRequest>(*_queues[request.queueId], request.endpoint, request.opts));
+      futures.push_back(pendingRequest->promise.get_future());
+    }
+    _nbPendingRequests += static_cast<int>(requests.size());
+  }
+
+  wakeUp();
+
+  return futures;
+}
+
+int CurlMultiEngine::nbPendingRequests() const {
+  std::lock_guard<std::mutex> guard(_mutex);
+  return _nbPendingRequests;
+}
+
+void CurlMultiEngine::wakeUp() const {
+#if LIBCURL_VERSION_NUM >= 0x074400
+  curl_multi_wakeup(reinterpret_cast<CURLM *>(_multiHandle));
+#endif
+}
+
+void CurlMultiEngine::run(std::stop_token stopToken) {
+  CURLM *multiHandle = reinterpret_cast<CURLM *>(_multiHandle);
+
+  while (!stopToken.stop_requested()) {
+    pullSubmittedRequests();
+
+    int nbRunningHandles;
+    const CURLMcode performCode = curl_multi_perform(multiHandle, &nbRunningHandles);
+    if (performCode != CURLM_OK) {
+      log::error("Curl multi error {}: {}", static_cast<int>(performCode), curl_multi_strerror(performCode));
+    }
+
+    processCompletedRequests();
+
+    // Started requests are performed at next iteration, no need to wait for them
+    const auto nbInFlightRequestsBefore = _inFlightRequests.size();
+    const TimePoint nowTime = Clock::now();
+    const TimePoint nextStartTime = startReadyRequests(nowTime);
+    if (_inFlightRequests.size() != nbInFlightRequestsBefore) {
+      continue;
+    }
+
+    milliseconds pollDuration = kMaxPollDuration;
+    if (nextStartTime != TimePoint::max()) {
+      // Rounded up so that the timer is expired at wake up
+      pollDuration = std::clamp(std::chrono::ceil<milliseconds>(nextStartTime - nowTime), milliseconds(0),
+                                kMaxPollDuration);
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+    const CURLMcode pollCode =
+        curl_multi_poll(multiHandle, nullptr, 0, static_cast<int>(pollDuration.count()), nullptr);
+#else
+    int nbFds{};
+    const CURLMcode pollCode =
+        curl_multi_wait(multiHandle, nullptr, 0, static_cast<int>(pollDuration.count()), &nbFds);
+    if (pollCode == CURLM_OK && nbFds == 0) {
+      // Contrary to curl_multi_poll, curl_multi_wait returns immediately when there is nothing to wait for
+      std::this_thread::sleep_for(pollDuration);
+    }
+#endif
+    if (pollCode != CURLM_OK) {
+      log::error("Curl multi error {}: {}", static_cast<int>(pollCode), curl_multi_strerror(pollCode));
+    }
+  }
+}
+
+void CurlMultiEngine::pullSubmittedRequests() {
+  std::lock_guard<std::mutex> guard(_mutex);
+  for (auto queuePos = _loopQueues.size(); queuePos < _queues.size(); ++queuePos) {
+    _loopQueues.push_back(_queues[queuePos].get());
+  }
+  for (PendingRequestPtr &pendingRequest : _submittedRequests) {
+    pendingRequest->pQueue->waitingRequests.push_back(std::move(pendingRequest));
+  }
+  _submittedRequests.clear();
+}
+
+TimePoint CurlMultiEngine::startReadyRequests(TimePoint nowTime) {
+  TimePoint nextStartTime = TimePoint::max();
+  for (Queue *pQueue : _loopQueues) {
+    Queue &queue = *pQueue;
+    while (!queue.waitingRequests.empty()) {
+      PendingRequest &frontRequest = *queue.waitingRequests.front();
+      if (nowTime < frontRequest.notBefore) {
+        nextStartTime = std::min(nextStartTime, frontRequest.notBefore);
+        break;
+      }
+      WeightedRateLimiter *pWeightedRateLimiter = queue.permanentCurlOptions.weightedRateLimiter();
+      if (pWeightedRateLimiter != nullptr && !frontRequest.isWeightReserved) {
+        // Reserved only once, the request is started after the returned delay without blocking the event loop
+        const Duration waitingTime = pWeightedRateLimiter->reserve(frontRequest.opts.weight(), nowTime);
+        frontRequest.isWeightReserved = true;
+        if (waitingTime != Duration::zero()) {
+          log::debug("Wait {} for request weight {} to be available", DurationToString(waitingTime),
+                     frontRequest.opts.weight());
+          frontRequest.notBefore = nowTime + waitingTime;
+          nextStartTime = std::min(nextStartTime, frontRequest.notBefore);
+          break;
+        }
+      }
+      if (queue.pQueryIntervalLimiter != nullptr && !queue.pQueryIntervalLimiter->tryReserve(nowTime)) {
+        // Never blocks the event loop, even if the slot has been reserved by a synchronous query of the CurlHandle
+        nextStartTime = std::min(nextStartTime, queue.pQueryIntervalLimiter->nextQueryTime());
+        break;
+      }
+      PendingRequestPtr pendingRequest = std::move(queue.waitingRequests.front());
+      queue.waitingRequests.pop_front();
+
+      startRequest(queue, std::move(pendingRequest));
+    }
+  }
+  return nextStartTime;
+}
+
+void CurlMultiEngine::startRequest(Queue &queue, PendingRequestPtr pendingRequest) {
+  PendingRequest &request = *pendingRequest;
+  const CurlOptions &opts = request.opts;
+  const CurlPostData &postData = opts.postData();
+  const bool appendParametersInQueryStr = !postData.empty() && opts.requestType() != HttpRequestType::kPost;
+
+  request.baseUrlPos = queue.bestURLPicker.nextBaseURLPos();
+
+  request.url = queue.bestURLPicker.getBaseURL(request.baseUrlPos);
+  request.url.append(request.endpoint);
+  if (appendParametersInQueryStr) {
+    request.url.push_back('?');
+    request.url.append(postData.str());
+    request.postFields.clear();
+  } else if (opts.isPostDataInJsonFormat() && !postData.empty()) {
+    request.postFields = postData.toJsonStr();
+  } else {
+    request.postFields = postData.str();
+  }
+
+  CURL *curl = queue.acquireHandle();
+  request.curl = curl;
+
+  CurlSetLogIfError(curl, CURLOPT_URL, request.url.c_str());
+  CurlSetLogIfError(curl, CURLOPT_POSTFIELDS, request.postFields.c_str());
+  CurlSetLogIfError(curl, CURLOPT_POSTFIELDSIZE, request.postFields.size());
+
+  // Handles are reused by all the requests of the queue, so ALL the options that may change between requests are set
+  CurlSetLogIfError(curl, CURLOPT_POST, opts.requestType() == HttpRequestType::kPost);
+  CurlSetLogIfError(curl, CURLOPT_CUSTOMREQUEST, opts.requestType() == HttpRequestType::kDelete ? "DELETE" : nullptr);
+  if (opts.requestType() == HttpRequestType::kGet) {
+    CurlSetLogIfError(curl, CURLOPT_HTTPGET, 1);
+  }
+  CurlSetLogIfError(curl, CURLOPT_VERBOSE, opts.isVerbose() ? 1L : 0L);
+
+  if (request.pHttpHeaders == nullptr) {
+    request.pHttpHeaders = ComputeCurlSListPtr(opts.httpHeaders());
+  }
+  CurlSetLogIfError(curl, CURLOPT_HTTPHEADER, request.pHttpHeaders);
+
+  const char *proxyUrl = opts.proxyUrl();
+  CurlSetLogIfError(curl, CURLOPT_PROXY, proxyUrl);
+  if (proxyUrl != nullptr) {
+    CurlSetLogIfError(curl, CURLOPT_CAINFO, GetProxyCAInfo());
+  }
+  CurlSetLogIfError(curl, CURLOPT_SSL_VERIFYHOST, proxyUrl != nullptr ? 0L : 1L);
+
+  request.response.clear();
+  CurlSetLogIfError(curl, CURLOPT_WRITEDATA, &request.response);
+  CurlSetLogIfError(curl, CURLOPT_PRIVATE, pendingRequest.get());
+
+  const auto nbRequestsDone = queue.bestURLPicker.nbRequestsDone();
+  static constexpr auto kLogRequestsThreshold = 100;
+
+  if (opts.requestType() != HttpRequestType::kGet || nbRequestsDone % kLogRequestsThreshold == 0) {
+    log::log(static_cast<log::level::level_enum>(queue.permanentCurlOptions.requestCallLogLevel()), "{} {}{}{}",
+             HttpRequestTypeToString(opts.requestType()), request.url, request.postFields.empty() ? "" : "?",
+             request.postFields);
+  }
+
+  request.startTime = Clock::now();
+
+  const CURLMcode addCode = curl_multi_add_handle(reinterpret_cast<CURLM *>(_multiHandle), curl);
+  if (addCode != CURLM_OK) {
+    queue.idleHandles.push_back(curl);
+    request.curl = nullptr;
+    request.promise.set_exception(std::make_exception_ptr(
+        exception("Curl multi error {} adding handle: {}", static_cast<int>(addCode), curl_multi_strerror(addCode))));
+    std::lock_guard<std::mutex> guard(_mutex);
+    --_nbPendingRequests;
+    return;
+  }
+
+  _inFlightRequests.push_back(std::move(pendingRequest));
+}
+
+void CurlMultiEngine::processCompletedRequests() {
+  CURLM *multiHandle = reinterpret_cast<CURLM *>(_multiHandle);
+  int nbMessagesInQueue;
+  for (CURLMsg *msg = curl_multi_info_read(multiHandle, &nbMessagesInQueue); msg != nullptr;
+       msg = curl_multi_info_read(multiHandle, &nbMessagesInQueue)) {
+    if (msg->msg != CURLMSG_DONE) {
+      continue;
+    }
+
+    char *pPrivate = nullptr;
+    curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &pPrivate);
+    const auto *pRequest = reinterpret_cast<const PendingRequest *>(pPrivate);
+
+    const auto it = std::ranges::find_if(_inFlightRequests,
+                                         [pRequest](const auto &ptr) { return ptr.get() == pRequest; });
+    if (it == _inFlightRequests.end()) {
+      log::error("Unknown completed curl request");
+      continue;
+    }
+
+    PendingRequestPtr pendingRequest = std::move(*it);
+    _inFlightRequests.erase(it);
+
+    completeRequest(std::move(pendingRequest), static_cast<int>(msg->data.result));
+  }
+}
+
+void CurlMultiEngine::completeRequest(PendingRequestPtr pendingRequest, int curlCode) {
+  PendingRequest &request = *pendingRequest;
+  Queue &queue = *request.pQueue;
+  const HttpRequestType requestType = request.opts.requestType();
+
+  WeightedRateLimiter *pWeightedRateLimiter = queue.permanentCurlOptions.weightedRateLimiter();
+  if (curlCode == CURLE_OK && pWeightedRateLimiter != nullptr) {
+    CurlUpdateUsedWeight(request.curl, *pWeightedRateLimiter);
+  }
+
+  curl_multi_remove_handle(reinterpret_cast<CURLM *>(_multiHandle), request.curl);
+  queue.idleHandles.push_back(request.curl);
+  request.curl = nullptr;
+
+  // Store stats
+  const auto queryRTInMs = static_cast<uint32_t>(GetTimeFrom<milliseconds>(request.startTime).count());
+  queue.bestURLPicker.storeResponseTimePerBaseURL(request.baseUrlPos, queryRTInMs);
+
+  queue.metricHandles.addRequest(requestType, static_cast<double>(queryRTInMs));
+
+  if (curlCode == CURLE_OK) {
+    log::log(static_cast<log::level::level_enum>(queue.permanentCurlOptions.requestAnswerLogLevel()),
+             "Response of {}: {}", request.url, request.response);
+    request.promise.set_value(std::move(request.response));
+  } else if (request.nbRetries < queue.permanentCurlOptions.nbMaxRetries()) {
+    ++request.nbRetries;
+    queue.metricHandles.addRequestError(requestType);
+    log::error("Got curl error {} for {}, retry {}/{} after {}", curlCode, request.url, request.nbRetries,
+               queue.permanentCurlOptions.nbMaxRetries(), DurationToString(request.retryDelay));
+
+    // Retried first among the waiting requests of its queue, but not before the end of its backoff delay
+    request.notBefore = Clock::now() + request.retryDelay;
+    request.retryDelay *= 2;
+    request.isWeightReserved = false;
+    queue.waitingRequests.push_front(std::move(pendingRequest));
+    return;
+  } else {
+    switch (queue.permanentCurlOptions.tooManyErrorsPolicy()) {
+      case PermanentCurlOptions::TooManyErrorsPolicy::kReturnEmptyResponse:
+        log::error("Too many errors from curl for {}, return empty response", request.url);
+        request.promise.set_value(string());
+        break;
+      case PermanentCurlOptions::TooManyErrorsPolicy::kThrow:
+        request.promise.set_exception(
+            std::make_exception_ptr(exception("Too many errors from curl, last ({})", curlCode)));
+        break;
+      default:
+        unreachable();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(_mutex);
+  --_nbPendingRequests;
+}
+
+void CurlMultiEngine::failAllRequests() {
+  CURLM *multiHandle = reinterpret_cast<CURLM *>(_multiHandle);
+
+  const auto failRequest = [](PendingRequest &request) {
+    request.promise.set_exception(
+        std::make_exception_ptr(exception("CurlMultiEngine stopped before completion of the request")));
+  };
+
+  for (PendingRequestPtr &pendingRequest : _inFlightRequests) {
+    curl_multi_remove_handle(multiHandle, pendingRequest->curl);
+    pendingRequest->pQueue->idleHandles.push_back(pendingRequest->curl);
+    pendingRequest->curl = nullptr;
+    failRequest(*pendingRequest);
+  }
+  _inFlightRequests.clear();
+
+  for (Queue *pQueue : _loopQueues) {
+    for (PendingRequestPtr &pendingRequest : pQueue->waitingRequests) {
+      failRequest(*pendingRequest);
+    }
+    pQueue->waitingRequests.clear();
+  }
+
+  std::lock_guard<std::mutex> guard(_mutex);
+  for (PendingRequestPtr &pendingRequest : _submittedRequests) {
+    failRequest(*pendingRequest);
+  }
+  _submittedRequests.clear();
+  _nbPendingRequests = 0;
+}
+
+}  // namespace cct
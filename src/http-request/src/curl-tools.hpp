@@ -0,0 +1,45 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "curloptions.hpp"
+#include "permanentcurloptions.hpp"
+#include "weighted-rate-limiter.hpp"
+
+// Private helpers shared by the source files of this library having a dependency on curl.
+
+extern "C" size_t CurlWriteCallback(const char *contents, size_t size, size_t nmemb, void *userp);
+
+namespace cct {
+
+template <class T>
+void CurlSetLogIfError(CURL *curl, CURLoption curlOption, T value) {
+  static_assert(std::is_integral_v<T> || std::is_pointer_v<T>);
+  const CURLcode code = curl_easy_setopt(curl, curlOption, value);
+  if (code != CURLE_OK) {
+    if constexpr (std::is_integral_v<T> || std::is_same_v<T, const char *>) {
+      log::error("Curl error {} setting option {} to {}", static_cast<int>(code), static_cast<int>(curlOption), value);
+    } else {
+      log::error("Curl error {} setting option {}", static_cast<int>(code), static_cast<int>(curlOption));
+    }
+  }
+}
+
+/// Builds the curl list of given HTTP headers. It should be freed by the caller with curl_slist_free_all.
+curl_slist *ComputeCurlSListPtr(const CurlOptions::HttpHeaders &httpHeaders);
+
+/// Sets the options of given curl easy handle which are the same for all its requests.
+/// The write callback is set, but not the write data.
+void CurlSetPermanentOptions(CURL *curl, const PermanentCurlOptions &permanentCurlOptions);
+
+/// Synchronizes given rate limiter with the used weight reported in the last response of given curl easy handle,
+/// if the rate limiter has a used weight header and if it is present in the response.
+/// Does nothing with curl older than 7.83.0, which cannot read response headers.
+void CurlUpdateUsedWeight(CURL *curl, WeightedRateLimiter &weightedRateLimiter);
+
+}  // namespace cct
@@ -3,6 +3,11 @@
 #include <curl/curl.h>
 #include <curl/easy.h>
 
+// Response headers API is only available since curl 7.83.0
+#if LIBCURL_VERSION_NUM >= 0x075300
+#include <curl/header.h>
+#endif
+
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
@@ -16,23 +21,25 @@
 #include <thread>
 #include <utility>
 
-#include "abstractmetricgateway.hpp"
 #include "besturlpicker.hpp"
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
 #include "curlmetrics.hpp"
 #include "curloptions.hpp"
+#include "curl-tools.hpp"
 #include "curlpostdata.hpp"
 #include "durationstring.hpp"
 #include "flatkeyvaluestring.hpp"
 #include "httprequesttype.hpp"
-#include "metric.hpp"
 #include "permanentcurloptions.hpp"
 #include "proxy.hpp"
+#include "query-interval-limiter.hpp"
 #include "runmodes.hpp"
+#include "stringconv.hpp"
 #include "timedef.hpp"
 #include "unreachable.hpp"
+#include "weighted-rate-limiter.hpp"
 
 extern "C" size_t CurlWriteCallback(const char *contents, size_t size, size_t nmemb, void *userp) {
   try {
@@ -54,18 +61,7 @@ namespace {
 /// '"' cannot be used in a URI (not percent encoded), so it's a fine delimiter for our FlatQueryResponse map
 using FlatQueryResponseMap = FlatKeyValueString<'\0', '"'>;
 
-template <class T>
-void CurlSetLogIfError(CURL *curl, CURLoption curlOption, T value) {
-  static_assert(std::is_integral_v<T> || std::is_pointer_v<T>);
-  const CURLcode code = curl_easy_setopt(curl, curlOption, value);
-  if (code != CURLE_OK) {
-    if constexpr (std::is_integral_v<T> || std::is_same_v<T, const char *>) {
-      log::error("Curl error {} setting option {} to {}", static_cast<int>(code), static_cast<int>(curlOption), value);
-    } else {
-      log::error("Curl error {} setting option {}", static_cast<int>(code), static_cast<int>(curlOption));
-    }
-  }
-}
+}  // namespace
 
 curl_slist *ComputeCurlSListPtr(const CurlOptions::HttpHeaders &httpHeaders) {
   curl_slist *curlListPtr = nullptr;
@@ -86,7 +82,59 @@ curl_slist *ComputeCurlSListPtr(const CurlOptions::HttpHeaders &httpHeaders) {
   }
   return curlListPtr;
 }
-}  // namespace
+
+void CurlSetPermanentOptions(CURL *curl, const PermanentCurlOptions &permanentCurlOptions) {
+  const string &userAgent = permanentCurlOptions.getUserAgent();
+  if (userAgent.empty()) {
+    string defaultUserAgent = "coincenter ";
+    defaultUserAgent.append(CCT_VERSION);
+    defaultUserAgent.append(", ");
+    defaultUserAgent.append(GetCurlVersionInfo());
+
+    CurlSetLogIfError(curl, CURLOPT_USERAGENT, defaultUserAgent.data());
+  } else {
+    CurlSetLogIfError(curl, CURLOPT_USERAGENT, userAgent.data());
+  }
+  CurlSetLogIfError(curl, CURLOPT_WRITEFUNCTION, CurlWriteCallback);
+  const string &acceptedEncoding = permanentCurlOptions.getAcceptedEncoding();
+  if (!acceptedEncoding.empty()) {
+    CurlSetLogIfError(curl, CURLOPT_ACCEPT_ENCODING, acceptedEncoding.data());
+  }
+
+  CurlSetLogIfError(curl, CURLOPT_FOLLOWLOCATION, permanentCurlOptions.followLocation() ? 1L : 0L);
+
+  if (permanentCurlOptions.timeout() != Duration{}) {
+    CurlSetLogIfError(curl, CURLOPT_TIMEOUT_MS,
+                      std::chrono::duration_cast<milliseconds>(permanentCurlOptions.timeout()).count());
+  }
+
+#ifdef _WIN32
+  // https://stackoverflow.com/questions/37551409/configure-curl-to-use-default-system-cert-store-on-windows
+  CurlSetLogIfError(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
+#endif
+}
+
+#if LIBCURL_VERSION_NUM >= 0x075300
+void CurlUpdateUsedWeight(CURL *curl, WeightedRateLimiter &weightedRateLimiter) {
+  const string &usedWeightHeader = weightedRateLimiter.usedWeightHeader();
+  if (usedWeightHeader.empty()) {
+    return;
+  }
+  curl_header *pHeader;
+  if (curl_easy_header(curl, usedWeightHeader.c_str(), 0, CURLH_HEADER, -1, &pHeader) != CURLHE_OK) {
+    return;
+  }
+  const std::string_view usedWeightStr(pHeader->value);
+  if (usedWeightStr.empty() || !std::ranges::all_of(usedWeightStr, [](char ch) { return ch >= '0' && ch <= '9'; })) {
+    log::warn("Unexpected value '{}' for header {}", usedWeightStr, usedWeightHeader);
+    return;
+  }
+  weightedRateLimiter.updateUsedWeight(StringToIntegral<int32_t>(usedWeightStr));
+}
+#else
+// Used weight reported by the exchange cannot be read - only the local accounting of the weights is used
+void CurlUpdateUsedWeight([[maybe_unused]] CURL *curl, [[maybe_unused]] WeightedRateLimiter &weightedRateLimiter) {}
+#endif
 
 string GetCurlVersionInfo() {
   const curl_version_info_data &curlVersionInfo = *curl_version_info(CURLVERSION_NOW);
@@ -107,13 +155,19 @@ string GetCurlVersionInfo() {
 
 CurlHandle::CurlHandle(BestURLPicker bestURLPicker, AbstractMetricGateway *pMetricGateway,
                        const PermanentCurlOptions &permanentCurlOptions, settings::RunMode runMode)
-    : _pMetricGateway(pMetricGateway),
-      _minDurationBetweenQueries(permanentCurlOptions.minDurationBetweenQueries()),
+    : _metricHandles(pMetricGateway),
+      _pQueryIntervalLimiter(permanentCurlOptions.queryIntervalLimiter()),
+      _pWeightedRateLimiter(permanentCurlOptions.weightedRateLimiter()),
       _bestURLPicker(std::move(bestURLPicker)),
       _requestCallLogLevel(permanentCurlOptions.requestCallLogLevel()),
       _requestAnswerLogLevel(permanentCurlOptions.requestAnswerLogLevel()),
       _nbMaxRetries(permanentCurlOptions.nbMaxRetries()),
       _tooManyErrorsPolicy(permanentCurlOptions.tooManyErrorsPolicy()) {
+  if (_pQueryIntervalLimiter == nullptr && permanentCurlOptions.minDurationBetweenQueries() != Duration::zero()) {
+    _pOwnedQueryIntervalLimiter =
+        std::make_unique<QueryIntervalLimiter>(permanentCurlOptions.minDurationBetweenQueries());
+    _pQueryIntervalLimiter = _pOwnedQueryIntervalLimiter.get();
+  }
   if (!settings::AreQueryResponsesOverriden(runMode)) {
     CURL *curl = curl_easy_init();
     if (curl == nullptr) {
@@ -122,38 +176,11 @@ CurlHandle::CurlHandle(BestURLPicker bestURLPicker, AbstractMetricGateway *pMetr
 
     _handle = curl;
 
-    const string &userAgent = permanentCurlOptions.getUserAgent();
-    if (userAgent.empty()) {
-      string defaultUserAgent = "coincenter ";
-      defaultUserAgent.append(CCT_VERSION);
-      defaultUserAgent.append(", ");
-      defaultUserAgent.append(GetCurlVersionInfo());
-
-      CurlSetLogIfError(curl, CURLOPT_USERAGENT, defaultUserAgent.data());
-    } else {
-      CurlSetLogIfError(curl, CURLOPT_USERAGENT, userAgent.data());
-    }
-    CurlSetLogIfError(curl, CURLOPT_WRITEFUNCTION, CurlWriteCallback);
+    CurlSetPermanentOptions(curl, permanentCurlOptions);
     CurlSetLogIfError(curl, CURLOPT_WRITEDATA, &_queryData);
-    const string &acceptedEncoding = permanentCurlOptions.getAcceptedEncoding();
-    if (!acceptedEncoding.empty()) {
-      CurlSetLogIfError(curl, CURLOPT_ACCEPT_ENCODING, acceptedEncoding.data());
-    }
-
-    CurlSetLogIfError(curl, CURLOPT_FOLLOWLOCATION, permanentCurlOptions.followLocation() ? 1L : 0L);
-
-    if (permanentCurlOptions.timeout() != Duration{}) {
-      CurlSetLogIfError(curl, CURLOPT_TIMEOUT_MS,
-                        std::chrono::duration_cast<milliseconds>(permanentCurlOptions.timeout()).count());
-    }
-
-#ifdef _WIN32
-    // https://stackoverflow.com/questions/37551409/configure-curl-to-use-default-system-cert-store-on-windows
-    CurlSetLogIfError(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
-#endif
 
     log::debug("Initialize CurlHandle for {} with {} as minimum duration between queries",
-               _bestURLPicker.getNextBaseURL(), DurationToString(_minDurationBetweenQueries));
+               _bestURLPicker.getNextBaseURL(), DurationToString(minDurationBetweenQueries()));
 
     if (settings::IsProxyRequested(runMode)) {
       if (!IsProxyAvailable()) {
@@ -244,21 +271,23 @@ std::string_view CurlHandle::query(std::string_view endpoint, const CurlOptions
 
   setUpProxy(opts.proxyUrl(), opts.isProxyReset());
 
-  if (_minDurationBetweenQueries != Duration::zero()) {
-    // Check last request time
+  if (_pQueryIntervalLimiter != nullptr) {
+    // Possibly shared with the CurlMultiEngine queue of the exchange, whose requests are spaced as well
     const auto nowTime = Clock::now();
-    if (nowTime < _lastQueryTime + _minDurationBetweenQueries) {
+    const auto queryTime = _pQueryIntervalLimiter->reserve(nowTime);
+    if (nowTime < queryTime) {
       // We should sleep a bit before performing query
-      const Duration sleepingTime = _minDurationBetweenQueries - (nowTime - _lastQueryTime);
+      const Duration sleepingTime = queryTime - nowTime;
       log::trace("Wait {} before performing query", DurationToString(sleepingTime));
       std::this_thread::sleep_for(sleepingTime);
-      _lastQueryTime = nowTime + sleepingTime;
-    } else {
-      // Query can be performed immediately
-      _lastQueryTime = nowTime;
     }
   }
 
+  if (_pWeightedRateLimiter != nullptr) {
+    // Shared by all handles of the exchange, waits only if the weight of this request is not available yet
+    _pWeightedRateLimiter->acquire(opts.weight());
+  }
+
   auto nbRequestsDone = _bestURLPicker.nbRequestsDone();
   static constexpr auto kLogRequestsThreshold = 100;
 
@@ -281,10 +310,7 @@ std::string_view CurlHandle::query(std::string_view endpoint, const CurlOptions
 
   do {
     if (retryPos != 0) {
-      if (_pMetricGateway != nullptr) {
-        _pMetricGateway->add(MetricType::kCounter, MetricOperation::kIncrement,
-                             CurlMetrics::kNbRequestErrorKeys.find(opts.requestType())->second);
-      }
+      _metricHandles.addRequestError(opts.requestType());
       log::error("Got curl error {} for {}, retry {}/{} after {}", static_cast<int>(res), modifiedURL, retryPos,
                  _nbMaxRetries, DurationToString(sleepingTime));
       std::this_thread::sleep_for(sleepingTime);
@@ -300,13 +326,7 @@ std::string_view CurlHandle::query(std::string_view endpoint, const CurlOptions
     const auto queryRTInMs = static_cast<uint32_t>(GetTimeFrom<milliseconds>(t1).count());
     _bestURLPicker.storeResponseTimePerBaseURL(baseUrlPos, queryRTInMs);
 
-    if (_pMetricGateway != nullptr) {
-      _pMetricGateway->add(MetricType::kCounter, MetricOperation::kIncrement,
-                           CurlMetrics::kNbRequestsKeys.find(opts.requestType())->second);
-      _pMetricGateway->add(MetricType::kHistogram, MetricOperation::kObserve,
-                           CurlMetrics::kRequestDurationKeys.find(opts.requestType())->second,
-                           static_cast<double>(queryRTInMs));
-    }
+    _metricHandles.addRequest(opts.requestType(), static_cast<double>(queryRTInMs));
 
     // Periodic memory release to avoid memory leak for a very large number of requests
     static constexpr int kReleaseMemoryRequestsFrequency = 10000;
@@ -328,6 +348,8 @@ std::string_view CurlHandle::query(std::string_view endpoint, const CurlOptions
       default:
         unreachable();
     }
+  } else if (_pWeightedRateLimiter != nullptr) {
+    CurlUpdateUsedWeight(curl, *_pWeightedRateLimiter);
   }
 
   // Avoid polluting the logs for large response which are more likely to be HTML
@@ -369,9 +391,10 @@ void CurlHandle::swap(CurlHandle &rhs) noexcept {
   using std::swap;
 
   swap(_handle, rhs._handle);
-  swap(_pMetricGateway, rhs._pMetricGateway);
-  swap(_minDurationBetweenQueries, rhs._minDurationBetweenQueries);
-  swap(_lastQueryTime, rhs._lastQueryTime);
+  swap(_metricHandles, rhs._metricHandles);
+  swap(_pOwnedQueryIntervalLimiter, rhs._pOwnedQueryIntervalLimiter);
+  swap(_pQueryIntervalLimiter, rhs._pQueryIntervalLimiter);
+  swap(_pWeightedRateLimiter, rhs._pWeightedRateLimiter);
   swap(_bestURLPicker, rhs._bestURLPicker);
   _queryData.swap(rhs._queryData);
   swap(_requestCallLogLevel, rhs._requestCallLogLevel);
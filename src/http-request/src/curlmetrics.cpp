@@ -1,5 +1,6 @@
 #include "curlmetrics.hpp"
 
+#include "abstractmetricgateway.hpp"
 #include "httprequesttype.hpp"
 #include "metric.hpp"
 
@@ -35,4 +36,18 @@ MetricKeyPerRequestType CreateNbRequestErrorsMetricKeys() {
 const MetricKeyPerRequestType CurlMetrics::kNbRequestsKeys = CreateNbRequestsMetricKeys();
 const MetricKeyPerRequestType CurlMetrics::kRequestDurationKeys = CreateRequestDurationMetricKeys();
 const MetricKeyPerRequestType CurlMetrics::kNbRequestErrorKeys = CreateNbRequestErrorsMetricKeys();
+
+CurlMetricHandles::CurlMetricHandles(AbstractMetricGateway *pMetricGateway) {
+  if (pMetricGateway == nullptr) {
+    return;
+  }
+  for (HttpRequestType requestType : kHttpRequestTypes) {
+    auto &handles = _handlesPerRequestType[static_cast<int>(requestType)];
+    handles.nbRequests = pMetricGateway->registerCounter(CurlMetrics::kNbRequestsKeys.find(requestType)->second);
+    handles.requestDuration = pMetricGateway->registerHistogram(
+        CurlMetrics::kRequestDurationKeys.find(requestType)->second, CurlMetrics::kRequestDurationBoundariesMs);
+    handles.nbRequestErrors =
+        pMetricGateway->registerCounter(CurlMetrics::kNbRequestErrorKeys.find(requestType)->second);
+  }
+}
 }  // namespace cct
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "query-interval-limiter.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "timedef.hpp"
+
+namespace cct {
+
+QueryIntervalLimiter::QueryIntervalLimiter(Duration minDurationBetweenQueries)
+    : _minDurationBetweenQueries(minDurationBetweenQueries) {}
+
+TimePoint QueryIntervalLimiter::reserve(TimePoint nowTime) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  const TimePoint queryTime = std::max(nowTime, _nextQueryTime);
+  _nextQueryTime = queryTime + _minDurationBetweenQueries;
+  return queryTime;
+}
+
+bool QueryIntervalLimiter::tryReserve(TimePoint nowTime) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  if (nowTime < _nextQueryTime) {
+    return false;
+  }
+  _nextQueryTime = nowTime + _minDurationBetweenQueries;
+  return true;
+}
+
+TimePoint QueryIntervalLimiter::nextQueryTime() const {
+  std::lock_guard<std::mutex> guard(_mutex);
+  return _nextQueryTime;
+}
+
+}  // namespace cct
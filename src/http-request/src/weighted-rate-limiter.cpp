@@ -0,0 +1,85 @@
+#include "weighted-rate-limiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include "cct_invalid_argument_exception.hpp"
+#include "cct_log.hpp"
+#include "durationstring.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+WeightedRateLimiter::WeightedRateLimiter(int32_t maxWeight, Duration window, std::string_view usedWeightHeader)
+    : _usedWeightHeader(usedWeightHeader),
+      _window(window),
+      _lastRefillTime(Clock::now()),
+      _availableWeight(maxWeight),
+      _maxWeight(maxWeight) {
+  if (_maxWeight <= 0) {
+    throw invalid_argument("Maximum weight of rate limiter should be strictly positive");
+  }
+  if (_window <= Duration::zero()) {
+    throw invalid_argument("Window of rate limiter should be strictly positive");
+  }
+}
+
+Duration WeightedRateLimiter::reserve(int32_t weight, TimePoint nowTime) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  refill(nowTime);
+
+  _availableWeight -= std::min(weight, _maxWeight);
+  if (_availableWeight >= 0) {
+    return Duration::zero();
+  }
+
+  // Time needed to refill the missing weight
+  return Duration(static_cast<Duration::rep>(
+      std::ceil(-_availableWeight * static_cast<double>(_window.count()) / static_cast<double>(_maxWeight))));
+}
+
+Duration WeightedRateLimiter::acquire(int32_t weight) {
+  const Duration waitingTime = reserve(weight);
+  if (waitingTime != Duration::zero()) {
+    log::debug("Wait {} for request weight {} to be available", DurationToString(waitingTime), weight);
+    std::this_thread::sleep_for(waitingTime);
+  }
+  return waitingTime;
+}
+
+void WeightedRateLimiter::updateUsedWeight(int32_t usedWeight, TimePoint nowTime) {
+  std::lock_guard<std::mutex> guard(_mutex);
+  refill(nowTime);
+
+  const auto remainingWeight = static_cast<double>(_maxWeight - usedWeight);
+  if (remainingWeight < _availableWeight) {
+    log::debug("Exchange reports a used weight of {}/{}, adjusting available weight from {} to {}", usedWeight,
+               _maxWeight, _availableWeight, remainingWeight);
+    _availableWeight = remainingWeight;
+  }
+}
+
+double WeightedRateLimiter::availableWeight(TimePoint nowTime) const {
+  std::lock_guard<std::mutex> guard(_mutex);
+  return availableWeightNoLock(nowTime);
+}
+
+double WeightedRateLimiter::availableWeightNoLock(TimePoint nowTime) const {
+  if (nowTime <= _lastRefillTime) {
+    return _availableWeight;
+  }
+  const auto elapsedTime = static_cast<double>((nowTime - _lastRefillTime).count());
+  const auto refilledWeight = static_cast<double>(_maxWeight) * elapsedTime / static_cast<double>(_window.count());
+  return std::min(_availableWeight + refilledWeight, static_cast<double>(_maxWeight));
+}
+
+void WeightedRateLimiter::refill(TimePoint nowTime) {
+  _availableWeight = availableWeightNoLock(nowTime);
+  _lastRefillTime = std::max(_lastRefillTime, nowTime);
+}
+
+}  // namespace cct
@@ -0,0 +1,142 @@
+#include "curl-multi-engine.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <string_view>
+
+#include "cct_exception.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "curlhandle.hpp"
+#include "curloptions.hpp"
+#include "curlpostdata.hpp"
+#include "httprequesttype.hpp"
+#include "permanentcurloptions.hpp"
+#include "query-interval-limiter.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+class CurlMultiEngineTest : public ::testing::Test {
+ protected:
+  static constexpr std::string_view kHttpBinBase = "https://httpbin.org";
+  static constexpr std::string_view kNotExistingBase = "https://this-url-does-not-exist-12345";
+
+  static PermanentCurlOptions FastErrorsOptions(PermanentCurlOptions::TooManyErrorsPolicy tooManyErrorsPolicy) {
+    return PermanentCurlOptions::Builder()
+        .setNbMaxRetries(1)
+        .setTooManyErrorsPolicy(tooManyErrorsPolicy)
+        .setTimeout(seconds(5))
+        .build();
+  }
+
+  CurlInitRAII curlInitRAII;
+  CurlMultiEngine engine;
+  CurlOptions getOpts{HttpRequestType::kGet};
+};
+
+TEST_F(CurlMultiEngineTest, InvalidQueueId) {
+  EXPECT_THROW(engine.submit(0, "/json", getOpts), exception);
+
+  const auto queueId = engine.addQueue(kHttpBinBase);
+  EXPECT_THROW(engine.submit(queueId + 1, "/json", getOpts), exception);
+  EXPECT_EQ(engine.nbPendingRequests(), 0);
+}
+
+TEST_F(CurlMultiEngineTest, BatchQueries) {
+  const auto queueId = engine.addQueue(kHttpBinBase);
+
+  const CurlOptions getWithParamsOpts(HttpRequestType::kGet, CurlPostData{{"param1", "val1"}});
+
+  const CurlMultiEngine::Request requests[] = {
+      {queueId, "/json", getOpts}, {queueId, "/xml", getOpts}, {queueId, "/get", getWithParamsOpts}};
+
+  auto futures = engine.submit(requests);
+
+  ASSERT_EQ(futures.size(), std::size(requests));
+
+  // httpbin may randomly return errors, we only check the ones that succeeded
+  const string jsonResp = futures[0].get();
+  if (!jsonResp.empty() && jsonResp.front() == '{') {
+    EXPECT_NE(jsonResp.find("slideshow"), string::npos);
+  }
+  const string xmlResp = futures[1].get();
+  if (xmlResp.starts_with("<?xml")) {
+    EXPECT_NE(xmlResp.find("slideshow"), string::npos);
+  }
+  const string getResp = futures[2].get();
+  if (!getResp.empty() && getResp.front() == '{') {
+    EXPECT_NE(getResp.find("val1"), string::npos);
+  }
+
+  EXPECT_EQ(engine.nbPendingRequests(), 0);
+}
+
+TEST_F(CurlMultiEngineTest, MinDurationBetweenQueriesDoesNotBlockCaller) {
+  static constexpr Duration kMinDurationBetweenQueries = milliseconds(200);
+
+  const auto queueId = engine.addQueue(
+      kNotExistingBase, PermanentCurlOptions::Builder()
+                            .setMinDurationBetweenQueries(kMinDurationBetweenQueries)
+                            .setNbMaxRetries(0)
+                            .setTooManyErrorsPolicy(PermanentCurlOptions::TooManyErrorsPolicy::kReturnEmptyResponse)
+                            .build());
+
+  const CurlMultiEngine::Request requests[] = {
+      {queueId, "/1", getOpts}, {queueId, "/2", getOpts}, {queueId, "/3", getOpts}};
+
+  const TimePoint startTime = Clock::now();
+  auto futures = engine.submit(requests);
+  EXPECT_LT(Clock::now() - startTime, kMinDurationBetweenQueries);
+
+  for (auto &future : futures) {
+    EXPECT_EQ(future.get(), "");
+  }
+
+  // The last request cannot have started before two times the minimum duration between queries
+  EXPECT_GE(Clock::now() - startTime, 2 * kMinDurationBetweenQueries);
+}
+
+TEST_F(CurlMultiEngineTest, QueryIntervalLimiterSharedWithCurlHandle) {
+  static constexpr Duration kMinDurationBetweenQueries = milliseconds(200);
+
+  QueryIntervalLimiter queryIntervalLimiter(kMinDurationBetweenQueries);
+
+  const auto queueId = engine.addQueue(
+      kNotExistingBase, PermanentCurlOptions::Builder()
+                            .setMinDurationBetweenQueries(kMinDurationBetweenQueries)
+                            .setQueryIntervalLimiter(&queryIntervalLimiter)
+                            .setNbMaxRetries(0)
+                            .setTooManyErrorsPolicy(PermanentCurlOptions::TooManyErrorsPolicy::kReturnEmptyResponse)
+                            .build());
+
+  // Slot reserved by a query of the CurlHandle sharing the limiter
+  const TimePoint startTime = Clock::now();
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime), startTime);
+
+  EXPECT_EQ(engine.submit(queueId, "/1", getOpts).get(), "");
+
+  EXPECT_GE(Clock::now() - startTime, kMinDurationBetweenQueries);
+
+  // Request of the engine has reserved its own slot as well
+  EXPECT_GE(queryIntervalLimiter.nextQueryTime(), startTime + 2 * kMinDurationBetweenQueries);
+}
+
+TEST_F(CurlMultiEngineTest, TooManyErrorsThrow) {
+  const auto queueId =
+      engine.addQueue(kNotExistingBase, FastErrorsOptions(PermanentCurlOptions::TooManyErrorsPolicy::kThrow));
+
+  auto future = engine.submit(queueId, "/json", getOpts);
+  EXPECT_THROW(future.get(), exception);
+}
+
+TEST_F(CurlMultiEngineTest, TooManyErrorsReturnEmptyResponse) {
+  const auto queueId = engine.addQueue(
+      kNotExistingBase, FastErrorsOptions(PermanentCurlOptions::TooManyErrorsPolicy::kReturnEmptyResponse));
+
+  auto future = engine.submit(queueId, "/json", getOpts);
+  EXPECT_EQ(future.get(), "");
+}
+
+}  // namespace cct
@@ -15,7 +15,9 @@
 #include "httprequesttype.hpp"
 #include "permanentcurloptions.hpp"
 #include "proxy.hpp"
+#include "query-interval-limiter.hpp"
 #include "runmodes.hpp"
+#include "timedef.hpp"
 
 /* URL available to test HTTPS, cf
  * https://support.nmi.com/hc/en-gb/articles/360021544791-How-to-Check-If-the-Correct-Certificates-Are-Installed-on-Linux
@@ -140,4 +142,30 @@ TEST_F(TestOverrideQueryResponses, WithQueryResponses) {
   handle.setOverridenQueryResponses({});
   EXPECT_THROW(handle.query("/path1", emptyOpts), exception);
 }
+
+TEST_F(TestOverrideQueryResponses, QueryIntervalLimiter) {
+  EXPECT_EQ(handle.queryIntervalLimiter(), nullptr);
+  EXPECT_EQ(handle.minDurationBetweenQueries(), Duration{});
+
+  CurlHandle ownLimiterHandle(kTestUrl, pAbstractMetricGateway,
+                              PermanentCurlOptions::Builder().setMinDurationBetweenQueries(milliseconds(100)).build(),
+                              runMode);
+  QueryIntervalLimiter *pOwnQueryIntervalLimiter = ownLimiterHandle.queryIntervalLimiter();
+  ASSERT_NE(pOwnQueryIntervalLimiter, nullptr);
+  EXPECT_EQ(ownLimiterHandle.minDurationBetweenQueries(), milliseconds(100));
+
+  // Limiter is kept by the moved handle, so that it stays valid for the ones sharing it
+  CurlHandle movedHandle(std::move(ownLimiterHandle));
+  EXPECT_EQ(movedHandle.queryIntervalLimiter(), pOwnQueryIntervalLimiter);
+
+  QueryIntervalLimiter sharedQueryIntervalLimiter(milliseconds(200));
+  CurlHandle sharedLimiterHandle(kTestUrl, pAbstractMetricGateway,
+                                 PermanentCurlOptions::Builder()
+                                     .setMinDurationBetweenQueries(milliseconds(100))
+                                     .setQueryIntervalLimiter(&sharedQueryIntervalLimiter)
+                                     .build(),
+                                 runMode);
+  EXPECT_EQ(sharedLimiterHandle.queryIntervalLimiter(), &sharedQueryIntervalLimiter);
+  EXPECT_EQ(sharedLimiterHandle.minDurationBetweenQueries(), milliseconds(200));
+}
 }  // namespace cct
\ No newline at end of file
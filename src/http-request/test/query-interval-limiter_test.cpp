@@ -0,0 +1,48 @@
+#include "query-interval-limiter.hpp"
+
+#include <gtest/gtest.h>
+
+#include "timedef.hpp"
+
+namespace cct {
+
+class QueryIntervalLimiterTest : public ::testing::Test {
+ protected:
+  QueryIntervalLimiter queryIntervalLimiter{milliseconds(100)};
+  TimePoint startTime = Clock::now() + seconds(1);
+};
+
+TEST_F(QueryIntervalLimiterTest, FirstQueryIsImmediate) {
+  EXPECT_EQ(queryIntervalLimiter.minDurationBetweenQueries(), milliseconds(100));
+  EXPECT_LE(queryIntervalLimiter.nextQueryTime(), startTime);
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime), startTime);
+  EXPECT_EQ(queryIntervalLimiter.nextQueryTime(), startTime + milliseconds(100));
+}
+
+TEST_F(QueryIntervalLimiterTest, ReserveInAdvance) {
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime), startTime);
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime + milliseconds(10)), startTime + milliseconds(100));
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime + milliseconds(20)), startTime + milliseconds(200));
+
+  // Slot not reserved in advance once the minimum duration is elapsed
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime + seconds(1)), startTime + seconds(1));
+}
+
+TEST_F(QueryIntervalLimiterTest, TryReserve) {
+  EXPECT_TRUE(queryIntervalLimiter.tryReserve(startTime));
+  EXPECT_FALSE(queryIntervalLimiter.tryReserve(startTime + milliseconds(99)));
+  EXPECT_EQ(queryIntervalLimiter.nextQueryTime(), startTime + milliseconds(100));
+  EXPECT_TRUE(queryIntervalLimiter.tryReserve(startTime + milliseconds(100)));
+  EXPECT_EQ(queryIntervalLimiter.nextQueryTime(), startTime + milliseconds(200));
+}
+
+TEST_F(QueryIntervalLimiterTest, SharedBetweenReserveAndTryReserve) {
+  // A slot reserved in advance by a blocking user is respected by a non-blocking one
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime), startTime);
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime), startTime + milliseconds(100));
+  EXPECT_FALSE(queryIntervalLimiter.tryReserve(startTime + milliseconds(150)));
+  EXPECT_TRUE(queryIntervalLimiter.tryReserve(startTime + milliseconds(200)));
+  EXPECT_EQ(queryIntervalLimiter.reserve(startTime + milliseconds(200)), startTime + milliseconds(300));
+}
+
+}  // namespace cct
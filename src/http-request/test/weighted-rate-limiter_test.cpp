@@ -0,0 +1,70 @@
+#include "weighted-rate-limiter.hpp"
+
+#include <gtest/gtest.h>
+
+#include "cct_invalid_argument_exception.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+class WeightedRateLimiterTest : public ::testing::Test {
+ protected:
+  WeightedRateLimiter rateLimiter{1200, seconds(60), "X-USED-WEIGHT"};
+  TimePoint startTime = Clock::now() + seconds(1);
+};
+
+TEST_F(WeightedRateLimiterTest, InvalidConstruction) {
+  EXPECT_THROW(WeightedRateLimiter(0, seconds(60)), invalid_argument);
+  EXPECT_THROW(WeightedRateLimiter(1200, Duration::zero()), invalid_argument);
+}
+
+TEST_F(WeightedRateLimiterTest, Accessors) {
+  EXPECT_EQ(rateLimiter.maxWeight(), 1200);
+  EXPECT_EQ(rateLimiter.window(), seconds(60));
+  EXPECT_EQ(rateLimiter.usedWeightHeader(), "X-USED-WEIGHT");
+}
+
+TEST_F(WeightedRateLimiterTest, ReserveWithinBudget) {
+  EXPECT_EQ(rateLimiter.reserve(1000, startTime), Duration::zero());
+  EXPECT_EQ(rateLimiter.reserve(200, startTime), Duration::zero());
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime), 0);
+}
+
+TEST_F(WeightedRateLimiterTest, ReserveOverBudget) {
+  EXPECT_EQ(rateLimiter.reserve(1150, startTime), Duration::zero());
+
+  // 20 units per second are refilled
+  EXPECT_EQ(rateLimiter.reserve(70, startTime), seconds(1));
+  EXPECT_EQ(rateLimiter.reserve(20, startTime), seconds(2));
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime), -40);
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime + seconds(2)), 0);
+}
+
+TEST_F(WeightedRateLimiterTest, Refill) {
+  EXPECT_EQ(rateLimiter.reserve(1200, startTime), Duration::zero());
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime + seconds(30)), 600);
+  EXPECT_EQ(rateLimiter.reserve(500, startTime + seconds(30)), Duration::zero());
+
+  // Bucket cannot hold more than the maximum weight
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime + seconds(3600)), 1200);
+}
+
+TEST_F(WeightedRateLimiterTest, WeightCappedToMaxWeight) {
+  EXPECT_EQ(rateLimiter.reserve(5000, startTime), Duration::zero());
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime), 0);
+}
+
+TEST_F(WeightedRateLimiterTest, UpdateUsedWeight) {
+  EXPECT_EQ(rateLimiter.reserve(100, startTime), Duration::zero());
+
+  // Exchange has accounted more weight than us (other clients with the same IP for instance)
+  rateLimiter.updateUsedWeight(1190, startTime);
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime), 10);
+  EXPECT_EQ(rateLimiter.reserve(30, startTime), seconds(1));
+
+  // Lower used weight reported by the exchange does not give back reserved weight
+  rateLimiter.updateUsedWeight(0, startTime);
+  EXPECT_DOUBLE_EQ(rateLimiter.availableWeight(startTime), -20);
+}
+
+}  // namespace cct
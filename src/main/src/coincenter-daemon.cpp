@@ -0,0 +1,349 @@
+#include "coincenter-daemon.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+#include "apioutputtype.hpp"
+#include "cct_exception.hpp"
+#include "cct_invalid_argument_exception.hpp"
+#include "cct_log.hpp"
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "coincenter-commands-processor.hpp"
+#include "coincenter.hpp"
+#include "coincentercommands.hpp"
+#include "coincenteroptions.hpp"
+#include "coincenteroptionsdef.hpp"
+#include "parseoptions.hpp"
+#include "read-json.hpp"
+#include "signal-handler.hpp"
+#include "timedef.hpp"
+#include "write-json.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace cct {
+
+namespace {
+
+struct DaemonErrorResponse {
+  string error;
+};
+
+// Stop signals and idle cache refreshes are checked at this period
+constexpr int kPollTimeoutMs = 1000;
+
+// Protection against clients sending data without any newline
+constexpr std::size_t kMaxRequestSize = 1UL << 20;
+
+// Requests of a client are not read nor processed while it has at least this amount of unsent response data
+constexpr std::size_t kMaxOutputBufferSize = 1UL << 20;
+
+#ifndef _WIN32
+// Linux does not support SO_NOSIGPIPE, and BSD / macOS do not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// Portable equivalent of SOCK_CLOEXEC | SOCK_NONBLOCK flags (of 'socket' and 'accept4', which are Linux specific)
+void SetCloseOnExecAndNonBlocking(int fd) {
+  const int fdFlags = ::fcntl(fd, F_GETFD);
+  const int statusFlags = ::fcntl(fd, F_GETFL);
+  if (fdFlags == -1 || statusFlags == -1 || ::fcntl(fd, F_SETFD, fdFlags | FD_CLOEXEC) == -1 ||
+      ::fcntl(fd, F_SETFL, statusFlags | O_NONBLOCK) == -1) {
+    throw exception("Cannot set daemon socket flags: {}", std::strerror(errno));
+  }
+}
+
+void DisableSigPipe([[maybe_unused]] int fd) {
+#ifdef SO_NOSIGPIPE
+  static constexpr int kOne = 1;
+  if (::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &kOne, sizeof(kOne)) == -1) {
+    throw exception("Cannot disable SIGPIPE on daemon socket: {}", std::strerror(errno));
+  }
+#endif
+}
+#endif
+
+}  // namespace
+
+string CoincenterDaemon::processRequest(std::string_view requestLine) {
+  std::ostringstream resultsStream;
+  try {
+    const auto args = ReadJsonOrThrow<vector<string>>(requestLine);
+    if (args.empty()) {
+      throw invalid_argument("Request should be a non empty json array of command line arguments");
+    }
+
+    vector<const char *> argv;
+    argv.reserve(args.size() + 1U);
+    argv.push_back(_programName.c_str());
+    std::ranges::transform(args, std::back_inserter(argv), [](const string &arg) { return arg.c_str(); });
+
+    // Help and version are not printed on the standard output of the daemon
+    std::ostringstream helpStream;
+    const auto [programName, cmdLineOptionsVector] =
+        ParseOptions(_parser, static_cast<int>(argv.size()), argv.data(), helpStream);
+    if (!helpStream.view().empty()) {
+      throw invalid_argument("Help and version are not supported in daemon mode");
+    }
+
+    const CoincenterCommands coincenterCommands(cmdLineOptionsVector);
+    if (coincenterCommands.commands().empty()) {
+      throw invalid_argument("No command in request");
+    }
+    if (coincenterCommands.repeats() != 1) {
+      throw invalid_argument("Repeats are not supported in daemon mode");
+    }
+
+    CoincenterCommandsProcessor coincenterCommandsProcessor(_coincenter, resultsStream, ApiOutputType::json);
+    coincenterCommandsProcessor.process(coincenterCommands);
+  } catch (const std::exception &e) {
+    log::error("Daemon request '{}' failed: {}", requestLine, e.what());
+    return WriteJsonOrThrow(DaemonErrorResponse{string(e.what())});
+  }
+
+  // Each command result is printed as a json on its own line
+  string response("{\"results\":[");
+  std::string_view results = resultsStream.view();
+  bool isFirst = true;
+  while (!results.empty()) {
+    const auto endLinePos = std::min(results.find('\n'), results.size());
+    if (endLinePos != 0) {
+      if (!isFirst) {
+        response.push_back(',');
+      }
+      response.append(results.substr(0, endLinePos));
+      isFirst = false;
+    }
+    results.remove_prefix(std::min(endLinePos + 1U, results.size()));
+  }
+  response.append("]}");
+  return response;
+}
+
+int CoincenterDaemon::processPendingRequests(Client &client) {
+  int nbProcessedRequests{};
+  std::string_view pendingData = client.pendingData;
+  for (auto endLinePos = pendingData.find('\n');
+       endLinePos != std::string_view::npos && client.outputData.size() < kMaxOutputBufferSize;
+       endLinePos = pendingData.find('\n')) {
+    const auto requestLine = pendingData.substr(0, endLinePos);
+    pendingData.remove_prefix(endLinePos + 1U);
+    if (requestLine.find_first_not_of(" \t\r") == std::string_view::npos) {
+      continue;
+    }
+    client.outputData.append(processRequest(requestLine));
+    client.outputData.push_back('\n');
+    ++nbProcessedRequests;
+  }
+  client.pendingData.erase(0, client.pendingData.size() - pendingData.size());
+  return nbProcessedRequests;
+}
+
+#ifdef _WIN32
+CoincenterDaemon::CoincenterDaemon(Coincenter &coincenter, std::string_view programName,
+                                   std::string_view socketPath)
+    : _coincenter(coincenter),
+      _programName(programName),
+      _socketPath(socketPath),
+      _parser(CoincenterAllowedOptions<CoincenterCmdLineOptions>::value) {
+  throw exception("Daemon mode is not supported on Windows");
+}
+
+CoincenterDaemon::~CoincenterDaemon() = default;
+
+int CoincenterDaemon::run() { return 0; }
+
+bool CoincenterDaemon::readFromClient([[maybe_unused]] Client &client) { return false; }
+
+bool CoincenterDaemon::writeToClient([[maybe_unused]] Client &client) { return false; }
+#else
+CoincenterDaemon::CoincenterDaemon(Coincenter &coincenter, std::string_view programName,
+                                   std::string_view socketPath)
+    : _coincenter(coincenter),
+      _programName(programName),
+      _socketPath(socketPath),
+      _parser(CoincenterAllowedOptions<CoincenterCmdLineOptions>::value) {
+  sockaddr_un address{};
+  if (_socketPath.empty() || _socketPath.size() >= sizeof(address.sun_path)) {
+    throw invalid_argument("Invalid daemon socket path '{}'", _socketPath);
+  }
+  address.sun_family = AF_UNIX;
+  std::ranges::copy(_socketPath, address.sun_path);
+
+  _listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (_listenFd == -1) {
+    throw exception("Cannot create daemon socket: {}", std::strerror(errno));
+  }
+  try {
+    // Non blocking so that 'accept' cannot block if the client disconnected in the meantime
+    SetCloseOnExecAndNonBlocking(_listenFd);
+  } catch (const exception &) {
+    ::close(_listenFd);
+    throw;
+  }
+
+  // Remove a socket file possibly left by a previous daemon which did not terminate properly
+  ::unlink(_socketPath.c_str());
+
+  // Commands can trade and withdraw, only the owner should be able to send them
+  const auto previousMask = ::umask(S_IRWXG | S_IRWXO);
+  const int bindRet = ::bind(_listenFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+  ::umask(previousMask);
+
+  if (bindRet == -1 || ::listen(_listenFd, SOMAXCONN) == -1) {
+    const auto errorStr = std::strerror(errno);
+    ::close(_listenFd);
+    throw exception("Cannot listen on daemon socket {}: {}", _socketPath, errorStr);
+  }
+
+  log::info("Daemon listening on {}", _socketPath);
+}
+
+CoincenterDaemon::~CoincenterDaemon() {
+  for (const Client &client : _clients) {
+    ::close(client.fd);
+  }
+  ::close(_listenFd);
+  ::unlink(_socketPath.c_str());
+}
+
+int CoincenterDaemon::run() {
+  int nbProcessedRequests{};
+  vector<pollfd> pollFds;
+  while (!IsStopRequested()) {
+    pollFds.clear();
+    pollFds.push_back(pollfd{_listenFd, POLLIN, 0});
+    std::ranges::transform(_clients, std::back_inserter(pollFds), [](const Client &client) {
+      short events{};
+      if (!client.isInputClosed && client.outputData.size() < kMaxOutputBufferSize) {
+        events |= POLLIN;
+      }
+      if (!client.outputData.empty()) {
+        events |= POLLOUT;
+      }
+      return pollfd{client.fd, events, 0};
+    });
+
+    const int nbReadyFds = ::poll(pollFds.data(), pollFds.size(), kPollTimeoutMs);
+    if (nbReadyFds == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw exception("Error while polling daemon socket: {}", std::strerror(errno));
+    }
+    if (nbReadyFds == 0) {
+      // Idle time is used to refresh cached values before they expire
+      _coincenter.refreshCachesAhead(milliseconds(kPollTimeoutMs));
+      continue;
+    }
+
+    // Clients are handled in reverse order so that they can be erased without disturbing the remaining ones
+    for (auto clientPos = static_cast<int>(_clients.size()) - 1; clientPos >= 0; --clientPos) {
+      const auto revents = pollFds[clientPos + 1].revents;
+      if (revents == 0) {
+        continue;
+      }
+      auto &client = _clients[clientPos];
+      bool isConnectionOk = (revents & (POLLERR | POLLNVAL)) == 0;
+      if (isConnectionOk && (revents & (POLLIN | POLLHUP)) != 0 && !client.isInputClosed) {
+        isConnectionOk = readFromClient(client);
+      }
+
+      // Requests are processed as long as their responses can be sent right away, the remaining ones will be
+      // processed once the client has read enough response data
+      while (isConnectionOk) {
+        nbProcessedRequests += processPendingRequests(client);
+        isConnectionOk = writeToClient(client);
+        if (!client.outputData.empty() || client.pendingData.find('\n') == string::npos) {
+          break;
+        }
+      }
+
+      // Client may close its writing side once all its requests are sent, it is disconnected once served
+      const bool isServed = client.isInputClosed && client.outputData.empty();
+      const bool isRequestTooLong = client.outputData.empty() && client.pendingData.size() > kMaxRequestSize;
+      if (!isConnectionOk || isServed || isRequestTooLong) {
+        log::debug("Daemon client disconnected");
+        ::close(client.fd);
+        _clients.erase(_clients.begin() + clientPos);
+      }
+    }
+
+    if (pollFds.front().revents != 0) {
+      const int clientFd = ::accept(_listenFd, nullptr, nullptr);
+      if (clientFd == -1) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+          log::warn("Cannot accept daemon connection: {}", std::strerror(errno));
+        }
+      } else {
+        try {
+          SetCloseOnExecAndNonBlocking(clientFd);
+          DisableSigPipe(clientFd);
+          log::debug("New daemon client connected");
+          _clients.push_back(Client{clientFd, string(), string()});
+        } catch (const exception &e) {
+          log::warn("{}", e.what());
+          ::close(clientFd);
+        }
+      }
+    }
+  }
+  log::info("Daemon stopped after {} request(s) processed", nbProcessedRequests);
+  return nbProcessedRequests;
+}
+
+bool CoincenterDaemon::readFromClient(Client &client) {
+  char buffer[4096];
+  const auto nbReadBytes = ::recv(client.fd, buffer, sizeof(buffer), 0);
+  if (nbReadBytes > 0) {
+    client.pendingData.append(buffer, static_cast<std::size_t>(nbReadBytes));
+    return true;
+  }
+  if (nbReadBytes == 0) {
+    client.isInputClosed = true;
+    return true;
+  }
+  return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+bool CoincenterDaemon::writeToClient(Client &client) {
+  std::string_view outputData = client.outputData;
+  while (!outputData.empty()) {
+    const auto nbSentBytes = ::send(client.fd, outputData.data(), outputData.size(), kSendFlags);
+    if (nbSentBytes == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      log::warn("Cannot send daemon response: {}", std::strerror(errno));
+      return false;
+    }
+    outputData.remove_prefix(static_cast<std::size_t>(nbSentBytes));
+  }
+  client.outputData.erase(0, client.outputData.size() - outputData.size());
+  return true;
+}
+#endif
+
+}  // namespace cct
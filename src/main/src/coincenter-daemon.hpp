@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string_view>
+
+#include "cct_string.hpp"
+#include "cct_vector.hpp"
+#include "coincenteroptions.hpp"
+#include "commandlineoptionsparser.hpp"
+
+namespace cct {
+
+class Coincenter;
+
+/// Keeps a Coincenter instance alive and processes commands received on a Unix domain socket, so that repeated
+/// commands benefit from warm caches and kept-alive connections instead of paying the full program start.
+/// Protocol is newline-delimited json: each request is a line with a json array of command line arguments, with the
+/// same grammar as the command line (for instance ["balance", "kraken"]). Each request gets a response line, either
+/// {"results":[...]} with one json result per command, or {"error":"..."}.
+/// Clients are served sequentially, in the thread calling 'run', with non-blocking sockets so that a slow client does
+/// not block the other ones: responses are buffered per client until they can be sent.
+class CoincenterDaemon {
+ public:
+  CoincenterDaemon(Coincenter &coincenter, std::string_view programName, std::string_view socketPath);
+
+  CoincenterDaemon(const CoincenterDaemon &) = delete;
+  CoincenterDaemon(CoincenterDaemon &&) = delete;
+  CoincenterDaemon &operator=(const CoincenterDaemon &) = delete;
+  CoincenterDaemon &operator=(CoincenterDaemon &&) = delete;
+
+  ~CoincenterDaemon();
+
+  /// Listens on the socket and processes requests until a stop signal is received.
+  /// Returns the number of processed requests.
+  int run();
+
+  /// Processes a request line, and returns its response line (without the newline character).
+  string processRequest(std::string_view requestLine);
+
+ private:
+  struct Client {
+    int fd;
+    string pendingData;
+    string outputData;
+    bool isInputClosed = false;
+  };
+
+  /// Returns false in case of error on the client connection.
+  bool readFromClient(Client &client);
+
+  /// Processes complete request lines of the client, while its output buffer is not full.
+  /// Returns the number of processed requests.
+  int processPendingRequests(Client &client);
+
+  /// Sends as much buffered output data as possible without blocking.
+  /// Returns false in case of error on the client connection.
+  bool writeToClient(Client &client);
+
+  Coincenter &_coincenter;
+  string _programName;
+  string _socketPath;
+  CommandLineOptionsParser<CoincenterCmdLineOptions> _parser;
+  vector<Client> _clients;
+  int _listenFd = -1;
+};
+
+}  // namespace cct
@@ -5,6 +5,7 @@
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "coincenter-commands-processor.hpp"
+#include "coincenter-daemon.hpp"
 #include "coincenter.hpp"
 #include "coincenterinfo.hpp"
 #include "coincenterinfo_create.hpp"
@@ -25,7 +26,13 @@ void ProcessCommandsFromCLI(std::string_view programName, const CoincenterComman
     Coincenter coincenter(coincenterInfo, ExchangeSecretsInfo_Create(generalOptions));
     CoincenterCommandsProcessor coincenterCommandsProcessor(coincenter);
 
-    const auto nbCommandsProcessed = coincenterCommandsProcessor.process(coincenterCommands);
+    auto nbCommandsProcessed = coincenterCommandsProcessor.process(coincenterCommands);
+
+    if (!generalOptions.daemonSocketPath.empty()) {
+      CoincenterDaemon coincenterDaemon(coincenter, programName, generalOptions.daemonSocketPath);
+
+      nbCommandsProcessed += coincenterDaemon.run();
+    }
 
     if (nbCommandsProcessed != 0) {
       // Write potentially updated cache data on disk at end of program
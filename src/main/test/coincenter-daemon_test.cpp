@@ -0,0 +1,98 @@
+#include "coincenter-daemon.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <thread>
+
+#include "cct_string.hpp"
+#include "coincenter.hpp"
+#include "coincenterinfo.hpp"
+#include "coincenterinfo_create.hpp"
+#include "coincenteroptions.hpp"
+#include "runmodes.hpp"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace cct {
+
+class CoincenterDaemonTest : public ::testing::Test {
+ protected:
+  CoincenterCmdLineOptions cmdLineOptions;
+  CoincenterInfo coincenterInfo{CoincenterInfo_Create("coincenter", cmdLineOptions, settings::RunMode::kTestKeys)};
+  Coincenter coincenter{coincenterInfo, ExchangeSecretsInfo_Create(cmdLineOptions)};
+  std::filesystem::path socketPath = std::filesystem::temp_directory_path() / "coincenter-daemon-test.sock";
+  CoincenterDaemon coincenterDaemon{coincenter, "coincenter", socketPath.string()};
+};
+
+TEST_F(CoincenterDaemonTest, SocketFileLifetime) {
+  EXPECT_TRUE(std::filesystem::exists(socketPath));
+  {
+    CoincenterDaemon otherDaemon(coincenter, "coincenter", (socketPath.string() + "2"));
+    EXPECT_TRUE(std::filesystem::exists(socketPath.string() + "2"));
+  }
+  EXPECT_FALSE(std::filesystem::exists(socketPath.string() + "2"));
+}
+
+TEST_F(CoincenterDaemonTest, InvalidRequests) {
+  static constexpr std::string_view kErrorPrefix = "{\"error\":";
+
+  EXPECT_TRUE(coincenterDaemon.processRequest("balance kraken").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest("[]").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["unknown-command"])").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["--repeat", "health-check"])").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["--help"])").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["health-check", "--help"])").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["--version"])").starts_with(kErrorPrefix));
+  EXPECT_TRUE(coincenterDaemon.processRequest(R"(["--data", "/tmp"])").starts_with(kErrorPrefix));
+}
+
+#ifndef _WIN32
+TEST_F(CoincenterDaemonTest, RequestsRoundTrip) {
+  int nbProcessedRequests{};
+  std::thread daemonThread([this, &nbProcessedRequests] { nbProcessedRequests = coincenterDaemon.run(); });
+
+  const int clientFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_NE(clientFd, -1);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::ranges::copy(socketPath.string(), address.sun_path);
+  ASSERT_EQ(::connect(clientFd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)), 0);
+
+  // Several requests in a single write, with an empty line which should be ignored
+  static constexpr std::string_view kRequests = "[]\n\n[\"unknown-command\"]\n";
+  ASSERT_EQ(::send(clientFd, kRequests.data(), kRequests.size(), 0), static_cast<ssize_t>(kRequests.size()));
+
+  // Closing the writing side tells the daemon that all requests have been sent, it disconnects once they are served
+  ::shutdown(clientFd, SHUT_WR);
+
+  string responses;
+  char buffer[1024];
+  for (auto nbReadBytes = ::recv(clientFd, buffer, sizeof(buffer), 0); nbReadBytes > 0;
+       nbReadBytes = ::recv(clientFd, buffer, sizeof(buffer), 0)) {
+    responses.append(buffer, static_cast<std::size_t>(nbReadBytes));
+  }
+  ::close(clientFd);
+
+  std::raise(SIGTERM);
+  daemonThread.join();
+
+  EXPECT_EQ(nbProcessedRequests, 2);
+  ASSERT_EQ(std::ranges::count(responses, '\n'), 2);
+  const std::string_view firstResponse(responses.data(), responses.find('\n'));
+  const std::string_view secondResponse =
+      std::string_view(responses).substr(firstResponse.size() + 1U, responses.size() - firstResponse.size() - 2U);
+  EXPECT_EQ(firstResponse, coincenterDaemon.processRequest("[]"));
+  EXPECT_EQ(secondResponse, coincenterDaemon.processRequest(R"(["unknown-command"])"));
+}
+#endif
+
+}  // namespace cct
@@ -2,6 +2,7 @@
 
 #include <span>
 
+#include "metric-handles.hpp"
 #include "metric.hpp"
 #include "monitoringinfo.hpp"
 
@@ -22,6 +23,18 @@ class AbstractMetricGateway {
   /// Create a summary. Should be called only once
   virtual void createSummary(const MetricKey& key, const MetricSummaryInfo& metricSummaryInfo) = 0;
 
+  /// Register the counter time series of given key (creating it if needed) and get a handle to update it.
+  /// Registering the same key several times returns handles to the same time series.
+  virtual MetricCounter registerCounter(const MetricKey& key) = 0;
+
+  /// Register the gauge time series of given key (creating it if needed) and get a handle to update it.
+  /// Registering the same key several times returns handles to the same time series.
+  virtual MetricGauge registerGauge(const MetricKey& key) = 0;
+
+  /// Register the histogram time series of given key (creating it with given buckets if needed) and get a handle to
+  /// update it. Registering the same key several times returns handles to the same time series.
+  virtual MetricHistogram registerHistogram(const MetricKey& key, BucketBoundaries buckets) = 0;
+
  protected:
   explicit AbstractMetricGateway(const MonitoringInfo& monitoringInfo) : _monitoringInfo(monitoringInfo) {}
 
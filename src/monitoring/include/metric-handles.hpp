@@ -0,0 +1,106 @@
+#pragma once
+
+namespace cct {
+
+namespace details {
+
+/// Interfaces of a single time series of a metric (a metric family with a given set of labels), implemented by the
+/// metric gateways. They are owned by the gateway that created them.
+class AbstractMetric {
+ public:
+  virtual ~AbstractMetric() = default;
+};
+
+class AbstractCounterMetric : public AbstractMetric {
+ public:
+  virtual void increment(double val) = 0;
+};
+
+class AbstractGaugeMetric : public AbstractMetric {
+ public:
+  virtual void increment(double val) = 0;
+  virtual void decrement(double val) = 0;
+  virtual void set(double val) = 0;
+  virtual void setToCurrentTime() = 0;
+};
+
+class AbstractHistogramMetric : public AbstractMetric {
+ public:
+  virtual void observe(double val) = 0;
+};
+
+}  // namespace details
+
+/// Lightweight handles to a single time series of a metric, returned by the 'register' methods of
+/// AbstractMetricGateway.
+/// Contrary to AbstractMetricGateway::add, updating a metric through a handle does not require to build and hash its
+/// key, nor to take any global lock, so they should be preferred for metrics updated in hot paths.
+/// They are cheap to copy, and a default constructed handle is valid and does nothing (no monitoring).
+/// A handle should not outlive the metric gateway that created it.
+class MetricCounter {
+ public:
+  MetricCounter() noexcept = default;
+
+  explicit MetricCounter(details::AbstractCounterMetric *pMetric) noexcept : _pMetric(pMetric) {}
+
+  void increment(double val = 1) const {
+    if (_pMetric != nullptr) {
+      _pMetric->increment(val);
+    }
+  }
+
+ private:
+  details::AbstractCounterMetric *_pMetric = nullptr;
+};
+
+class MetricGauge {
+ public:
+  MetricGauge() noexcept = default;
+
+  explicit MetricGauge(details::AbstractGaugeMetric *pMetric) noexcept : _pMetric(pMetric) {}
+
+  void increment(double val = 1) const {
+    if (_pMetric != nullptr) {
+      _pMetric->increment(val);
+    }
+  }
+
+  void decrement(double val = 1) const {
+    if (_pMetric != nullptr) {
+      _pMetric->decrement(val);
+    }
+  }
+
+  void set(double val) const {
+    if (_pMetric != nullptr) {
+      _pMetric->set(val);
+    }
+  }
+
+  void setToCurrentTime() const {
+    if (_pMetric != nullptr) {
+      _pMetric->setToCurrentTime();
+    }
+  }
+
+ private:
+  details::AbstractGaugeMetric *_pMetric = nullptr;
+};
+
+class MetricHistogram {
+ public:
+  MetricHistogram() noexcept = default;
+
+  explicit MetricHistogram(details::AbstractHistogramMetric *pMetric) noexcept : _pMetric(pMetric) {}
+
+  void observe(double val) const {
+    if (_pMetric != nullptr) {
+      _pMetric->observe(val);
+    }
+  }
+
+ private:
+  details::AbstractHistogramMetric *_pMetric = nullptr;
+};
+
+}  // namespace cct
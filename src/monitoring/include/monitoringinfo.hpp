@@ -15,9 +15,11 @@ class MonitoringInfo {
 
   /// Creates a fully specified monitoring info.
   /// Port should be a valid port value (in [0-65535]). Note that port 0 is reserved and should not be attributed.
-  /// If you give 0 to port, it is equivalent to disabling monitoring.
+  /// If you give 0 to port, it is equivalent to disabling push of the metrics to the gateway.
+  /// A non-zero 'pullPort' exposes the metrics locally on 'http://127.0.0.1:<pullPort>/metrics', independently of the
+  /// push mode.
   MonitoringInfo(bool useMonitoring, std::string_view jobName, std::string_view address, int port,
-                 std::string_view username, std::string_view password);
+                 std::string_view username, std::string_view password, int pullPort = 0);
 
   std::string_view address() const { return _address; }
   std::string_view jobName() const { return _jobName; }
@@ -27,7 +29,15 @@ class MonitoringInfo {
 
   uint16_t port() const { return _port; }
 
-  bool useMonitoring() const { return _port != 0; }
+  uint16_t pullPort() const { return _pullPort; }
+
+  /// Tells whether metrics should be pushed to the metric gateway.
+  bool usePush() const { return _port != 0; }
+
+  /// Tells whether metrics should be exposed locally for a metric server to pull them.
+  bool usePull() const { return _pullPort != 0; }
+
+  bool useMonitoring() const { return usePush() || usePull(); }
 
   using trivially_relocatable = is_trivially_relocatable<string>::type;
 
@@ -37,6 +47,7 @@ class MonitoringInfo {
   string _username;
   string _password;
   uint16_t _port = 0;
+  uint16_t _pullPort = 0;
 };
 
 }  // namespace cct
@@ -5,15 +5,25 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
 #include <unordered_map>
 
 #include "abstractmetricgateway.hpp"
-#include "timedef.hpp"
+#include "metric-handles.hpp"
+
+namespace prometheus {
+class Exposer;
+}
 
 /// Registry to collect stats
 namespace cct {
 
 /// High performance Prometheus gateway implementation, caching the metrics as they come along in a HashMap.
+/// Metrics are never exported from the threads updating them:
+///  - in push mode, a dedicated background thread pushes them periodically to the push gateway, with bounded retries
+///  - in pull mode, they are exposed on a local HTTP endpoint '/metrics' served by its own threads
 class PrometheusMetricGateway : public AbstractMetricGateway {
  public:
   using Gateway = prometheus::Gateway;
@@ -34,15 +44,32 @@ class PrometheusMetricGateway : public AbstractMetricGateway {
 
   void createSummary(const MetricKey &key, const MetricSummaryInfo &metricSummaryInfo) override;
 
+  MetricCounter registerCounter(const MetricKey &key) override;
+
+  MetricGauge registerGauge(const MetricKey &key) override;
+
+  MetricHistogram registerHistogram(const MetricKey &key, BucketBoundaries buckets) override;
+
  private:
-  void flush();
-  void checkFlush();
+  // Below methods should be called with _familiesMapMutex locked
+  void *getOrCreateCounter(const MetricKey &key);
+  void *getOrCreateGauge(const MetricKey &key);
+  void *getOrCreateHistogram(const MetricKey &key, BucketBoundaries buckets);
+
+  template <class MetricImpl>
+  MetricImpl *getOrCreateHandleMetric(void *pPrometheusMetric);
+
+  void pushPeriodically(std::stop_token stopToken);
+
+  bool push();
 
-  Gateway _gateway;
   std::shared_ptr<Registry> _registry;
+  std::optional<Gateway> _gateway;
+  std::unique_ptr<prometheus::Exposer> _exposer;
   std::unordered_map<MetricKey, void *> _familiesMap;
+  // Metrics referenced by the handles, per prometheus time series object
+  std::unordered_map<void *, std::unique_ptr<details::AbstractMetric>> _handleMetricsMap;
   std::mutex _familiesMapMutex;
-  TimePoint _lastFlushedTime;
-  int _checkFlushCounter{};  // To decrease number of times flush check is done
+  std::jthread _pushThread;
 };
 }  // namespace cct
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "abstractmetricgateway.hpp"
+#include "metric-handles.hpp"
 #include "metric.hpp"
 #include "monitoringinfo.hpp"
 
@@ -14,5 +15,11 @@ class VoidMetricGateway : public AbstractMetricGateway {
   void createHistogram(const MetricKey &key, BucketBoundaries buckets) override;
 
   void createSummary(const MetricKey &key, const MetricSummaryInfo &metricSummaryInfo) override;
+
+  MetricCounter registerCounter(const MetricKey &key) override;
+
+  MetricGauge registerGauge(const MetricKey &key) override;
+
+  MetricHistogram registerHistogram(const MetricKey &key, BucketBoundaries buckets) override;
 };
 }  // namespace cct
\ No newline at end of file
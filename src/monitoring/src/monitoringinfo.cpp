@@ -11,18 +11,26 @@
 namespace cct {
 
 MonitoringInfo::MonitoringInfo(bool useMonitoring, std::string_view jobName, std::string_view address, int port,
-                               std::string_view username, std::string_view password)
+                               std::string_view username, std::string_view password, int pullPort)
     : _jobName(jobName),
       _address(address),
       _username(username),
       _password(password),
-      _port(useMonitoring ? static_cast<uint16_t>(port) : 0U) {
+      _port(useMonitoring ? static_cast<uint16_t>(port) : 0U),
+      _pullPort(static_cast<uint16_t>(pullPort)) {
   if (port < 0 || std::cmp_less(std::numeric_limits<uint16_t>::max(), port)) {
     throw invalid_argument("Invalid port value {}", port);
   }
-  if (useMonitoring) {
+  if (pullPort < 0 || std::cmp_less(std::numeric_limits<uint16_t>::max(), pullPort)) {
+    throw invalid_argument("Invalid pull port value {}", pullPort);
+  }
+  if (usePush()) {
     log::info("Monitoring config - Export to {}:{} user '{}', job name {}", address, port, username, jobName);
-  } else {
+  }
+  if (usePull()) {
+    log::info("Monitoring config - Expose metrics on local port {}", pullPort);
+  }
+  if (!useMonitoring()) {
     log::debug("Monitoring disabled");
   }
 }
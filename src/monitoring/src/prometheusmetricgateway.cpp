@@ -5,14 +5,22 @@
 #include <prometheus/histogram.h>
 #include <prometheus/summary.h>
 
+#ifdef CCT_ENABLE_PROMETHEUS_PULL
+#include <prometheus/exposer.h>
+#endif
+
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <exception>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -21,6 +29,7 @@
 #include "cct_log.hpp"
 #include "durationstring.hpp"
 #include "gethostname.hpp"
+#include "metric-handles.hpp"
 #include "metric.hpp"
 #include "monitoringinfo.hpp"
 #include "timedef.hpp"
@@ -30,28 +39,53 @@ namespace cct {
 namespace {
 constexpr auto kHTTPSuccessReturnCode = 200;
 
-// Constants to control frequency of flushes to Prometheus instance
+// Constants to control frequency of pushes to Prometheus instance
 constexpr auto kPrometheusAutoFlushPeriod = std::chrono::minutes(3);
-constexpr auto kCheckFlushCounter = 20;
+
+// Constants to control the retries of a failed push - all attempts should stay well below the push period
+constexpr auto kMaxNbPushAttempts = 3;
+constexpr auto kFirstPushRetryDelay = std::chrono::seconds(1);
+constexpr auto kMaxPushRetryDelay = std::chrono::seconds(30);
 
 }  // namespace
 
 PrometheusMetricGateway::PrometheusMetricGateway(const MonitoringInfo& monitoringInfo)
-    : AbstractMetricGateway(monitoringInfo),
-      _gateway(std::string(monitoringInfo.address()), std::to_string(monitoringInfo.port()),
-               std::string(monitoringInfo.jobName()),
-               prometheus::Gateway::GetInstanceLabel(HostNameGetter().getHostName().toStdString()),
-               std::string(monitoringInfo.username()), std::string(monitoringInfo.password())),
-      _registry(std::make_shared<Registry>()),
-      _lastFlushedTime(Clock::now()) {
-  // create a push gateway
-  _gateway.RegisterCollectable(_registry);
+    : AbstractMetricGateway(monitoringInfo), _registry(std::make_shared<Registry>()) {
+  if (monitoringInfo.usePull()) {
+#ifdef CCT_ENABLE_PROMETHEUS_PULL
+    const auto bindAddress = "127.0.0.1:" + std::to_string(monitoringInfo.pullPort());
+    try {
+      _exposer = std::make_unique<prometheus::Exposer>(bindAddress);
+    } catch (const std::exception& ex) {
+      throw exception("Unable to expose metrics on {}: {}", bindAddress, ex.what());
+    }
+    _exposer->RegisterCollectable(_registry);
+    log::info("Metrics exposed on http://{}/metrics", bindAddress);
+#else
+    log::error("coincenter has been compiled without Prometheus pull support, metrics will not be exposed");
+#endif
+  }
+  if (monitoringInfo.usePush()) {
+    _gateway.emplace(std::string(monitoringInfo.address()), std::to_string(monitoringInfo.port()),
+                     std::string(monitoringInfo.jobName()),
+                     prometheus::Gateway::GetInstanceLabel(HostNameGetter().getHostName().toStdString()),
+                     std::string(monitoringInfo.username()), std::string(monitoringInfo.password()));
+    _gateway->RegisterCollectable(_registry);
+    _pushThread = std::jthread([this](std::stop_token stopToken) { pushPeriodically(std::move(stopToken)); });
+  }
 }
 
 PrometheusMetricGateway::~PrometheusMetricGateway() {
+  if (_pushThread.joinable()) {
+    _pushThread.request_stop();
+    _pushThread.join();
+  }
+  // Last push of the metrics before exiting, without retry.
   // We should not throw in a destructor - catch any exception and do nothing, not even a log (it could throw)
   try {
-    flush();
+    if (_gateway) {
+      push();
+    }
   } catch (const std::exception&) {  // NOLINT(bugprone-empty-catch)
   }
 }
@@ -79,22 +113,101 @@ inline ExtractedDataFromMetricKey ExtractData(const MetricKey& key) {
 
 }  // namespace
 
+namespace {
+
+class CounterMetric : public details::AbstractCounterMetric {
+ public:
+  explicit CounterMetric(void* pCounter) : _counter(*reinterpret_cast<prometheus::Counter*>(pCounter)) {}
+
+  void increment(double val) override { _counter.Increment(val); }
+
+ private:
+  prometheus::Counter& _counter;
+};
+
+class GaugeMetric : public details::AbstractGaugeMetric {
+ public:
+  explicit GaugeMetric(void* pGauge) : _gauge(*reinterpret_cast<prometheus::Gauge*>(pGauge)) {}
+
+  void increment(double val) override { _gauge.Increment(val); }
+
+  void decrement(double val) override { _gauge.Decrement(val); }
+
+  void set(double val) override { _gauge.Set(val); }
+
+  void setToCurrentTime() override { _gauge.SetToCurrentTime(); }
+
+ private:
+  prometheus::Gauge& _gauge;
+};
+
+class HistogramMetric : public details::AbstractHistogramMetric {
+ public:
+  explicit HistogramMetric(void* pHistogram) : _histogram(*reinterpret_cast<prometheus::Histogram*>(pHistogram)) {}
+
+  void observe(double val) override { _histogram.Observe(val); }
+
+ private:
+  prometheus::Histogram& _histogram;
+};
+
+}  // namespace
+
+void* PrometheusMetricGateway::getOrCreateCounter(const MetricKey& key) {
+  auto foundIt = _familiesMap.find(key);
+  if (foundIt != _familiesMap.end()) {
+    return foundIt->second;
+  }
+  auto data = ExtractData(key);
+  auto& builder = prometheus::BuildCounter().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
+  void* counterPtr =
+      std::addressof(reinterpret_cast<prometheus::Family<prometheus::Counter>&>(builder).Add(std::get<0>(data)));
+  _familiesMap.insert_or_assign(key, counterPtr);
+  return counterPtr;
+}
+
+void* PrometheusMetricGateway::getOrCreateGauge(const MetricKey& key) {
+  auto foundIt = _familiesMap.find(key);
+  if (foundIt != _familiesMap.end()) {
+    return foundIt->second;
+  }
+  auto data = ExtractData(key);
+  auto& builder = prometheus::BuildGauge().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
+  void* gaugePtr =
+      std::addressof(reinterpret_cast<prometheus::Family<prometheus::Gauge>&>(builder).Add(std::get<0>(data)));
+  _familiesMap.insert_or_assign(key, gaugePtr);
+  return gaugePtr;
+}
+
+void* PrometheusMetricGateway::getOrCreateHistogram(const MetricKey& key, BucketBoundaries buckets) {
+  auto foundIt = _familiesMap.find(key);
+  if (foundIt != _familiesMap.end()) {
+    return foundIt->second;
+  }
+  auto data = ExtractData(key);
+  auto& builder = prometheus::BuildHistogram().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
+  prometheus::Histogram::BucketBoundaries prometheusBuckets(buckets.begin(), buckets.end());
+  void* histogramPtr = std::addressof(reinterpret_cast<prometheus::Family<prometheus::Histogram>&>(builder).Add(
+      std::get<0>(data), std::move(prometheusBuckets)));
+  _familiesMap.insert_or_assign(key, histogramPtr);
+  return histogramPtr;
+}
+
+template <class MetricImpl>
+MetricImpl* PrometheusMetricGateway::getOrCreateHandleMetric(void* pPrometheusMetric) {
+  auto& pMetric = _handleMetricsMap[pPrometheusMetric];
+  if (!pMetric) {
+    pMetric = std::make_unique<MetricImpl>(pPrometheusMetric);
+  }
+  return static_cast<MetricImpl*>(pMetric.get());
+}
+
 void PrometheusMetricGateway::add(MetricType type, MetricOperation op, const MetricKey& key, double val) {
   assert(key.contains(kMetricNameKey) && key.contains(kMetricHelpKey));
   std::lock_guard<std::mutex> guard(_familiesMapMutex);
-  auto foundIt = _familiesMap.find(key);
   switch (type) {
     case MetricType::kCounter: {
-      prometheus::Counter* counterPtr;
-      if (foundIt == _familiesMap.end()) {
-        auto data = ExtractData(key);
-        auto& builder = prometheus::BuildCounter().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
-        counterPtr =
-            std::addressof(reinterpret_cast<prometheus::Family<prometheus::Counter>&>(builder).Add(std::get<0>(data)));
-        _familiesMap.insert_or_assign(key, counterPtr);
-      } else {
-        counterPtr = reinterpret_cast<prometheus::Counter*>(foundIt->second);
-      }
+      auto* counterPtr = reinterpret_cast<prometheus::Counter*>(getOrCreateCounter(key));
       switch (op) {
         case MetricOperation::kIncrement:
           if (val == 0) {
@@ -109,16 +222,7 @@ void PrometheusMetricGateway::add(MetricType type, MetricOperation op, const Met
       break;
     }
     case MetricType::kGauge: {
-      prometheus::Gauge* gaugePtr;
-      if (foundIt == _familiesMap.end()) {
-        auto data = ExtractData(key);
-        auto& builder = prometheus::BuildGauge().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
-        gaugePtr =
-            std::addressof(reinterpret_cast<prometheus::Family<prometheus::Gauge>&>(builder).Add(std::get<0>(data)));
-        _familiesMap.insert_or_assign(key, gaugePtr);
-      } else {
-        gaugePtr = reinterpret_cast<prometheus::Gauge*>(foundIt->second);
-      }
+      auto* gaugePtr = reinterpret_cast<prometheus::Gauge*>(getOrCreateGauge(key));
       switch (op) {
         case MetricOperation::kIncrement:
           if (val == 0) {
@@ -146,7 +250,8 @@ void PrometheusMetricGateway::add(MetricType type, MetricOperation op, const Met
 
       break;
     }
-    case MetricType::kHistogram:
+    case MetricType::kHistogram: {
+      auto foundIt = _familiesMap.find(key);
       if (foundIt == _familiesMap.end()) {
         log::error("You should create histogram first before adding any value in it");
       } else {
@@ -160,8 +265,9 @@ void PrometheusMetricGateway::add(MetricType type, MetricOperation op, const Met
         }
       }
       break;
-
-    case MetricType::kSummary:
+    }
+    case MetricType::kSummary: {
+      auto foundIt = _familiesMap.find(key);
       if (foundIt == _familiesMap.end()) {
         log::error("You should create summary first before adding any value in it");
       } else {
@@ -174,25 +280,38 @@ void PrometheusMetricGateway::add(MetricType type, MetricOperation op, const Met
             throw exception("Unsupported metric operation");
         }
       }
+      break;
+    }
   }
-  checkFlush();
 }
 
 void PrometheusMetricGateway::createHistogram(const MetricKey& key, BucketBoundaries buckets) {
   std::lock_guard<std::mutex> guard(_familiesMapMutex);
-  if (_familiesMap.find(key) == _familiesMap.end()) {
-    auto data = ExtractData(key);
-    auto& builder = prometheus::BuildHistogram().Name(std::get<1>(data)).Help(std::get<2>(data)).Register(*_registry);
-    prometheus::Histogram::BucketBoundaries prometheusBuckets(buckets.begin(), buckets.end());
-    prometheus::Histogram* histogramPtr =
-        std::addressof(reinterpret_cast<prometheus::Family<prometheus::Histogram>&>(builder).Add(
-            std::get<0>(data), std::move(prometheusBuckets)));
-    _familiesMap.insert_or_assign(key, histogramPtr);
-  } else {
+  if (_familiesMap.contains(key)) {
     log::warn("Prometheus histogram already created");
+  } else {
+    getOrCreateHistogram(key, buckets);
   }
 }
 
+MetricCounter PrometheusMetricGateway::registerCounter(const MetricKey& key) {
+  assert(key.contains(kMetricNameKey) && key.contains(kMetricHelpKey));
+  std::lock_guard<std::mutex> guard(_familiesMapMutex);
+  return MetricCounter(getOrCreateHandleMetric<CounterMetric>(getOrCreateCounter(key)));
+}
+
+MetricGauge PrometheusMetricGateway::registerGauge(const MetricKey& key) {
+  assert(key.contains(kMetricNameKey) && key.contains(kMetricHelpKey));
+  std::lock_guard<std::mutex> guard(_familiesMapMutex);
+  return MetricGauge(getOrCreateHandleMetric<GaugeMetric>(getOrCreateGauge(key)));
+}
+
+MetricHistogram PrometheusMetricGateway::registerHistogram(const MetricKey& key, BucketBoundaries buckets) {
+  assert(key.contains(kMetricNameKey) && key.contains(kMetricHelpKey));
+  std::lock_guard<std::mutex> guard(_familiesMapMutex);
+  return MetricHistogram(getOrCreateHandleMetric<HistogramMetric>(getOrCreateHistogram(key, buckets)));
+}
+
 void PrometheusMetricGateway::createSummary(const MetricKey& key, const MetricSummaryInfo& metricSummaryInfo) {
   std::lock_guard<std::mutex> guard(_familiesMapMutex);
   if (_familiesMap.find(key) == _familiesMap.end()) {
@@ -213,22 +332,44 @@ void PrometheusMetricGateway::createSummary(const MetricKey& key, const MetricSu
   }
 }
 
-void PrometheusMetricGateway::flush() {
-  auto nowTime = Clock::now();
-  int returnCode = _gateway.Push();
+bool PrometheusMetricGateway::push() {
+  const auto nowTime = Clock::now();
+  const int returnCode = _gateway->Push();
   if (returnCode == kHTTPSuccessReturnCode) {
-    log::info("Flushed data to Prometheus in {}", DurationToString(Clock::now() - nowTime));
-  } else {
-    log::error("Unable to push metrics to Prometheus instance - Bad return code {}", returnCode);
+    log::info("Pushed metrics to Prometheus in {}", DurationToString(Clock::now() - nowTime));
+    return true;
   }
+  log::error("Unable to push metrics to Prometheus instance - Bad return code {}", returnCode);
+  return false;
 }
 
-void PrometheusMetricGateway::checkFlush() {
-  if ((++_checkFlushCounter % kCheckFlushCounter) == 0) {
-    auto nowTime = Clock::now();
-    if (_lastFlushedTime + kPrometheusAutoFlushPeriod < nowTime) {
-      flush();
-      _lastFlushedTime = Clock::now();
+void PrometheusMetricGateway::pushPeriodically(std::stop_token stopToken) {
+  // Only used to sleep until next push, or until stop is requested
+  std::mutex mutex;
+  std::condition_variable_any cond;
+  std::unique_lock<std::mutex> lock(mutex);
+
+  const auto sleepFor = [&](auto duration) {
+    return !cond.wait_for(lock, stopToken, duration, [&stopToken] { return stopToken.stop_requested(); });
+  };
+
+  while (sleepFor(kPrometheusAutoFlushPeriod)) {
+    auto retryDelay = std::chrono::duration_cast<Duration>(kFirstPushRetryDelay);
+    for (int attemptNb = 1;; ++attemptNb) {
+      bool pushed = false;
+      try {
+        pushed = push();
+      } catch (const std::exception& ex) {
+        log::error("Exception while pushing metrics to Prometheus instance: {}", ex.what());
+      }
+      if (pushed || attemptNb == kMaxNbPushAttempts) {
+        break;
+      }
+      log::warn("Retry push of metrics to Prometheus instance in {}", DurationToString(retryDelay));
+      if (!sleepFor(retryDelay)) {
+        return;
+      }
+      retryDelay = std::min<Duration>(2 * retryDelay, kMaxPushRetryDelay);
     }
   }
 }
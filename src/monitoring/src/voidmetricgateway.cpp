@@ -4,6 +4,7 @@
 
 #include "abstractmetricgateway.hpp"
 #include "cct_log.hpp"
+#include "metric-handles.hpp"
 #include "metric.hpp"
 
 namespace cct {
@@ -28,4 +29,20 @@ void VoidMetricGateway::createSummary([[maybe_unused]] const MetricKey &key,
                                       [[maybe_unused]] const MetricSummaryInfo &metricSummaryInfo) {
   LogError("create a Summary metric");
 }
+
+MetricCounter VoidMetricGateway::registerCounter([[maybe_unused]] const MetricKey &key) {
+  LogError("register a Counter metric");
+  return {};
+}
+
+MetricGauge VoidMetricGateway::registerGauge([[maybe_unused]] const MetricKey &key) {
+  LogError("register a Gauge metric");
+  return {};
+}
+
+MetricHistogram VoidMetricGateway::registerHistogram([[maybe_unused]] const MetricKey &key,
+                                                     [[maybe_unused]] BucketBoundaries buckets) {
+  LogError("register a Histogram metric");
+  return {};
+}
 }  // namespace cct
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 
 #include "amount-price.hpp"
 #include "cct_smallvector.hpp"
+#include "cct_vector.hpp"
 #include "exchange-name-enum.hpp"
 #include "market.hpp"
 #include "monetaryamount.hpp"
@@ -26,14 +28,23 @@ class MarketOrderBook {
 
   using AmountPerPriceVec = SmallVector<AmountPrice, 4>;
 
+  /// Internal layout used to answer the depth queries (cumulative amounts, matched volumes and prices...).
+  enum class Layout : int8_t {
+    kLevels,       // single array of levels walked linearly, smallest memory footprint
+    kSideColumns,  // in addition, price and volume columns per side with cumulative volume and notional prefix sums,
+                   // so that depth queries are binary searches. Faster for deep order books queried several times.
+  };
+
   /// Constructs an empty (and invalid) MarketOrderBook.
   MarketOrderBook() noexcept = default;
 
   /// Constructs a new MarketOrderBook given a market and a list of amounts and prices.
   /// The order book may be created with invalid data, in this case, 'isValid' will return false for this object.
   /// @param volAndPriNbDecimals optional to force number of decimals of amounts
+  /// @param layout internal layout used to answer depth queries, results are the same for all layouts
   explicit MarketOrderBook(TimePoint timeStamp, Market market, const MarketOrderBookLines& orderLines,
-                           VolAndPriNbDecimals volAndPriNbDecimals = VolAndPriNbDecimals());
+                           VolAndPriNbDecimals volAndPriNbDecimals = VolAndPriNbDecimals(),
+                           Layout layout = Layout::kLevels);
 
   /// Constructs a MarketOrderBook based on simple ticker information and price / amount precision
   /// The order book may be created with invalid data, in this case, no exception will be raised but 'isValid' will
@@ -56,6 +67,8 @@ class MarketOrderBook {
 
   bool isArtificiallyExtended() const { return _isArtificiallyExtended; }
 
+  Layout layout() const { return _sideColumnsPtr ? Layout::kSideColumns : Layout::kLevels; }
+
   /// Get the highest bid price that a buyer is willing to pay
   MonetaryAmount highestBidPrice() const { return priceAt(_highestBidPricePos); }
 
@@ -162,10 +175,39 @@ class MarketOrderBook {
   // Use a SmallVector with one inline slot per side to avoid memory allocation for all order book requests (ticker)
   using AmountPriceVector = SmallVector<AmountPriceInt, 2UL>;
 
+  /// Levels of one side of the order book, from the best price (lowest ask / highest bid) to the worst one.
+  struct SideColumns {
+    /// Get the number of levels whose price is at least as good as given limit price.
+    int nbLevelsAtOrBetterThan(AmountType limitPrice, bool isAsk) const;
+
+    /// Get the position of the first level at which the cumulative volume reaches given volume, among the first
+    /// 'nbLevels' ones. Returns 'nbLevels' if it is not reached.
+    int levelReachingVolume(AmountType volume, int nbLevels) const;
+
+    vector<AmountType> prices;
+    vector<AmountType> volumes;
+    // Total volume of the levels [0, pos]
+    vector<AmountType> cumulVolumes;
+    // Total amount in quote currency of the levels [0, pos], summed in the same order as the linear walk of the levels
+    // so that results are identical for both layouts
+    vector<MonetaryAmount> cumulNotionals;
+  };
+
+  struct AllSideColumns {
+    SideColumns asks;
+    SideColumns bids;
+  };
+
  public:
+  // std::shared_ptr holds no pointer to itself, so it can be relocated bitwise as well
   using trivially_relocatable = is_trivially_relocatable<AmountPriceVector>::type;
 
-  bool operator==(const MarketOrderBook&) const noexcept = default;
+  /// Compares the content of the order books, whatever their layouts.
+  bool operator==(const MarketOrderBook& rhs) const noexcept {
+    return _time == rhs._time && _market == rhs._market && _orders == rhs._orders &&
+           _highestBidPricePos == rhs._highestBidPricePos && _lowestAskPricePos == rhs._lowestAskPricePos &&
+           _isArtificiallyExtended == rhs._isArtificiallyExtended && _volAndPriNbDecimals == rhs._volAndPriNbDecimals;
+  }
 
  private:
   /// Represents a total amount of waiting orders at a given price.
@@ -196,6 +238,7 @@ class MarketOrderBook {
 
   // To allow faster MarketOrderBook constructs
   friend class MarketOrderBookConverter;
+  friend class ColumnarMarketOrderBooksView;
 
   MarketOrderBook(TimePoint timeStamp, Market market, AmountPriceVector&& orders, int32_t highestBidPricePos,
                   int32_t lowestAskPricePos, VolAndPriNbDecimals volAndPriNbDecimals);
@@ -210,6 +253,27 @@ class MarketOrderBook {
     return MonetaryAmount(_orders[pos].price, _market.quote(), _volAndPriNbDecimals.priNbDecimals);
   }
 
+  MonetaryAmount cumulAmountAt(const SideColumns& sideColumns, int nbLevels) const {
+    return {nbLevels == 0 ? 0 : sideColumns.cumulVolumes[nbLevels - 1], _market.base(),
+            _volAndPriNbDecimals.volNbDecimals};
+  }
+
+  MonetaryAmount cumulNotionalAt(const SideColumns& sideColumns, int nbLevels) const {
+    return nbLevels == 0 ? MonetaryAmount(0, _market.quote()) : sideColumns.cumulNotionals[nbLevels - 1];
+  }
+
+  /// Builds the side columns from the levels, for the kSideColumns layout.
+  void buildSideColumns();
+
+  /// Get the number of levels of given side whose price is at least as good as given limit price.
+  int nbLevelsAtOrBetterThan(const SideColumns& sideColumns, MonetaryAmount price, bool isAsk) const;
+
+  AmountPrice avgPriceAndMatchedVolumeSideColumns(const SideColumns& sideColumns, MonetaryAmount amountInBaseOrQuote,
+                                                  MonetaryAmount price, bool isAsk) const;
+
+  AmountPerPriceVec computeMatchedPartsSideColumns(const SideColumns& sideColumns, MonetaryAmount amount,
+                                                   MonetaryAmount price, bool isAsk) const;
+
   AmountPrice avgPriceAndMatchedVolumeSell(MonetaryAmount baseAmount, MonetaryAmount price) const;
 
   AmountPrice avgPriceAndMatchedVolumeBuy(MonetaryAmount amountInBaseOrQuote, MonetaryAmount price) const;
@@ -231,6 +295,8 @@ class MarketOrderBook {
   int32_t _lowestAskPricePos{};
   bool _isArtificiallyExtended = false;
   VolAndPriNbDecimals _volAndPriNbDecimals;
+  // Only for the kSideColumns layout. Immutable once built, so it's shared between copies of this order book.
+  std::shared_ptr<const AllSideColumns> _sideColumnsPtr;
 };
 
 }  // namespace cct
@@ -4,8 +4,10 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <string_view>
@@ -15,6 +17,7 @@
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "cct_string.hpp"
+#include "cct_vector.hpp"
 #include "currencycode.hpp"
 #include "enum-string.hpp"
 #include "exchange-name-enum.hpp"
@@ -33,7 +36,7 @@
 namespace cct {
 
 MarketOrderBook::MarketOrderBook(TimePoint timeStamp, Market market, const MarketOrderBookLines& orderLines,
-                                 VolAndPriNbDecimals volAndPriNbDecimals)
+                                 VolAndPriNbDecimals volAndPriNbDecimals, Layout layout)
     : _time(timeStamp), _market(market), _volAndPriNbDecimals(volAndPriNbDecimals) {
   const auto nbPrices = orderLines.size();
   if (nbPrices == 0) {
@@ -105,6 +108,10 @@ MarketOrderBook::MarketOrderBook(TimePoint timeStamp, Market market, const Marke
   _lowestAskPricePos = static_cast<PricePosT>(
       std::find_if(highestBidPriceIt, _orders.end(), [](auto amountPrice) { return amountPrice.amount < 0; }) -
       _orders.begin());
+
+  if (layout == Layout::kSideColumns) {
+    buildSideColumns();
+  }
 }
 
 MarketOrderBook::MarketOrderBook(TimePoint timeStamp, MonetaryAmount askPrice, MonetaryAmount askVolume,
@@ -248,6 +255,88 @@ MarketOrderBook::MarketOrderBook(TimePoint timeStamp, Market market, AmountPrice
       _lowestAskPricePos(lowestAskPricePos),
       _volAndPriNbDecimals(volAndPriNbDecimals) {}
 
+namespace {
+
+using AmountType = MonetaryAmount::AmountType;
+
+/// Get the integral representation of given positive amount with given number of decimals, rounded up.
+/// Saturates to the maximum integral value if it does not fit.
+AmountType IntegralAmountRoundedUp(MonetaryAmount ma, int8_t nbDecimals) {
+  const std::optional<AmountType> optIntegralAmount = ma.amount(nbDecimals);
+  if (!optIntegralAmount) {
+    return std::numeric_limits<AmountType>::max();
+  }
+  if (MonetaryAmount(*optIntegralAmount, ma.currencyCode(), nbDecimals) != ma) {
+    return *optIntegralAmount + 1;
+  }
+  return *optIntegralAmount;
+}
+
+}  // namespace
+
+int MarketOrderBook::SideColumns::nbLevelsAtOrBetterThan(AmountType limitPrice, bool isAsk) const {
+  // Asks are sorted by increasing prices, bids by decreasing prices
+  const auto it = isAsk ? std::ranges::upper_bound(prices, limitPrice)
+                        : std::ranges::upper_bound(prices, limitPrice, std::greater<>());
+  return static_cast<int>(it - prices.begin());
+}
+
+int MarketOrderBook::SideColumns::levelReachingVolume(AmountType volume, int nbLevels) const {
+  const auto first = cumulVolumes.begin();
+  return static_cast<int>(std::lower_bound(first, first + nbLevels, volume) - first);
+}
+
+void MarketOrderBook::buildSideColumns() {
+  auto sideColumnsPtr = std::make_shared<AllSideColumns>();
+  const int nbOrders = _orders.size();
+
+  const auto fillSideColumns = [this](SideColumns& sideColumns, int firstPos, int endPos, int step) {
+    const auto nbLevels = static_cast<vector<AmountType>::size_type>((endPos - firstPos) * step);
+    sideColumns.prices.reserve(nbLevels);
+    sideColumns.volumes.reserve(nbLevels);
+    sideColumns.cumulVolumes.reserve(nbLevels);
+    sideColumns.cumulNotionals.reserve(nbLevels);
+
+    AmountType cumulVolume = 0;
+    MonetaryAmount cumulNotional(0, _market.quote());
+    for (int pos = firstPos; pos != endPos; pos += step) {
+      const AmountType volume = std::abs(_orders[pos].amount);
+      if (WillSumOverflow(cumulVolume, volume)) {
+        return false;
+      }
+      cumulVolume += volume;
+      cumulNotional += MonetaryAmount(volume, _market.base(), _volAndPriNbDecimals.volNbDecimals).toNeutral() *
+                       priceAt(pos);
+
+      sideColumns.prices.push_back(_orders[pos].price);
+      sideColumns.volumes.push_back(volume);
+      sideColumns.cumulVolumes.push_back(cumulVolume);
+      sideColumns.cumulNotionals.push_back(cumulNotional);
+    }
+    return true;
+  };
+
+  // Same ranges as the linear walks of the levels, possible lines with a zero amount between bids and asks included
+  if (!fillSideColumns(sideColumnsPtr->asks, _highestBidPricePos + 1, nbOrders, 1) ||
+      !fillSideColumns(sideColumnsPtr->bids, _lowestAskPricePos - 1, -1, -1)) {
+    log::warn("Cumulative volume of order book {} is too large for its side columns, keep levels layout", _market);
+    return;
+  }
+
+  _sideColumnsPtr = std::move(sideColumnsPtr);
+}
+
+int MarketOrderBook::nbLevelsAtOrBetterThan(const SideColumns& sideColumns, MonetaryAmount price, bool isAsk) const {
+  if (price.currencyCode() != _market.quote()) {
+    throw exception("Given price {} should be in the quote currency of this market {}", price, _market);
+  }
+  const auto priNbDecimals = _volAndPriNbDecimals.priNbDecimals;
+  // Rounded so that comparisons with the integral prices of the levels are exact
+  const AmountType limitPrice = isAsk ? price.amount(priNbDecimals).value_or(std::numeric_limits<AmountType>::max())
+                                      : IntegralAmountRoundedUp(price, priNbDecimals);
+  return sideColumns.nbLevelsAtOrBetterThan(limitPrice, isAsk);
+}
+
 bool MarketOrderBook::isValid() const {
   if (_orders.size() < 2U) {
     log::error("Market order book is invalid as size is {}", _orders.size());
@@ -281,6 +370,10 @@ std::optional<MonetaryAmount> MarketOrderBook::averagePrice() const {
 }
 
 MonetaryAmount MarketOrderBook::computeCumulAmountBoughtImmediatelyAt(MonetaryAmount price) const {
+  if (_sideColumnsPtr) {
+    const SideColumns& asks = _sideColumnsPtr->asks;
+    return cumulAmountAt(asks, nbLevelsAtOrBetterThan(asks, price, true));
+  }
   AmountType integralAmountRep = 0;
   const int nbOrders = _orders.size();
   for (int pos = _lowestAskPricePos; pos < nbOrders && priceAt(pos) <= price; ++pos) {
@@ -290,6 +383,10 @@ MonetaryAmount MarketOrderBook::computeCumulAmountBoughtImmediatelyAt(MonetaryAm
 }
 
 MonetaryAmount MarketOrderBook::computeCumulAmountSoldImmediatelyAt(MonetaryAmount price) const {
+  if (_sideColumnsPtr) {
+    const SideColumns& bids = _sideColumnsPtr->bids;
+    return cumulAmountAt(bids, nbLevelsAtOrBetterThan(bids, price, false));
+  }
   AmountType integralAmountRep = 0;
   for (int pos = _highestBidPricePos; pos >= 0 && priceAt(pos) >= price; --pos) {
     integralAmountRep += _orders[pos].amount;
@@ -308,6 +405,15 @@ std::optional<MonetaryAmount> MarketOrderBook::computeMaxPriceAtWhichAmountWould
     return std::nullopt;
   }
   const AmountType integralTotalAmount = *integralTotalAmountOpt;
+  if (_sideColumnsPtr) {
+    const SideColumns& asks = _sideColumnsPtr->asks;
+    const int nbLevels = asks.prices.size();
+    const int pos = asks.levelReachingVolume(integralTotalAmount, nbLevels);
+    if (pos == nbLevels) {
+      return std::nullopt;
+    }
+    return MonetaryAmount(asks.prices[pos], _market.quote(), _volAndPriNbDecimals.priNbDecimals);
+  }
   const int nbOrders = _orders.size();
   for (int pos = _highestBidPricePos + 1; pos < nbOrders && integralAmountRep <= integralTotalAmount; ++pos) {
     integralAmountRep -= _orders[pos].amount;  // -= because amount is < 0 here
@@ -353,7 +459,46 @@ MarketOrderBook::AmountPerPriceVec MarketOrderBook::computePricesAtWhichAmountWo
   return ret;
 }
 
+AmountPrice MarketOrderBook::avgPriceAndMatchedVolumeSideColumns(const SideColumns& sideColumns,
+                                                                  MonetaryAmount amountInBaseOrQuote,
+                                                                  MonetaryAmount price, bool isAsk) const {
+  const int nbLevels = nbLevelsAtOrBetterThan(sideColumns, price, isAsk);
+  MonetaryAmount matchedAmount;
+  MonetaryAmount avgPrice;
+  if (amountInBaseOrQuote.currencyCode() == _market.quote()) {
+    // First level at which the cumulative notional reaches the amount to spend
+    const auto first = sideColumns.cumulNotionals.begin();
+    const int pos = static_cast<int>(std::lower_bound(first, first + nbLevels, amountInBaseOrQuote) - first);
+    matchedAmount = cumulAmountAt(sideColumns, pos);
+    avgPrice = cumulNotionalAt(sideColumns, pos);
+    if (pos != nbLevels) {
+      const MonetaryAmount linePrice(sideColumns.prices[pos], _market.quote(), _volAndPriNbDecimals.priNbDecimals);
+      const MonetaryAmount remainingQuoteAmount = amountInBaseOrQuote - avgPrice;
+      matchedAmount += MonetaryAmount(remainingQuoteAmount / linePrice, _market.base());
+      avgPrice += remainingQuoteAmount;
+    }
+  } else {
+    const int pos = sideColumns.levelReachingVolume(
+        IntegralAmountRoundedUp(amountInBaseOrQuote, _volAndPriNbDecimals.volNbDecimals), nbLevels);
+    matchedAmount = cumulAmountAt(sideColumns, pos);
+    avgPrice = cumulNotionalAt(sideColumns, pos);
+    if (pos != nbLevels) {
+      const MonetaryAmount linePrice(sideColumns.prices[pos], _market.quote(), _volAndPriNbDecimals.priNbDecimals);
+      const MonetaryAmount remainingBaseAmount = amountInBaseOrQuote - matchedAmount;
+      avgPrice += remainingBaseAmount.toNeutral() * linePrice;
+      matchedAmount = amountInBaseOrQuote;
+    }
+  }
+  if (matchedAmount != 0) {
+    avgPrice /= matchedAmount.toNeutral();
+  }
+  return {matchedAmount, avgPrice};
+}
+
 AmountPrice MarketOrderBook::avgPriceAndMatchedVolumeSell(MonetaryAmount baseAmount, MonetaryAmount price) const {
+  if (_sideColumnsPtr) {
+    return avgPriceAndMatchedVolumeSideColumns(_sideColumnsPtr->bids, baseAmount, price, false);
+  }
   MonetaryAmount avgPrice(0, _market.quote());
 
   MonetaryAmount remainingBaseAmount = baseAmount;
@@ -380,6 +525,9 @@ AmountPrice MarketOrderBook::avgPriceAndMatchedVolumeSell(MonetaryAmount baseAmo
 
 AmountPrice MarketOrderBook::avgPriceAndMatchedVolumeBuy(MonetaryAmount amountInBaseOrQuote,
                                                          MonetaryAmount price) const {
+  if (_sideColumnsPtr) {
+    return avgPriceAndMatchedVolumeSideColumns(_sideColumnsPtr->asks, amountInBaseOrQuote, price, true);
+  }
   MonetaryAmount remainingAmountInBaseOrQuote = amountInBaseOrQuote;
   MonetaryAmount matchedAmount(0, _market.base());
   MonetaryAmount avgPrice(0, _market.quote());
@@ -431,6 +579,15 @@ std::optional<MonetaryAmount> MarketOrderBook::computeMinPriceAtWhichAmountWould
     return std::nullopt;
   }
   const AmountType integralTotalAmount = *integralTotalAmountOpt;
+  if (_sideColumnsPtr) {
+    const SideColumns& bids = _sideColumnsPtr->bids;
+    const int nbLevels = bids.prices.size();
+    const int pos = bids.levelReachingVolume(integralTotalAmount, nbLevels);
+    if (pos == nbLevels) {
+      return std::nullopt;
+    }
+    return MonetaryAmount(bids.prices[pos], _market.quote(), _volAndPriNbDecimals.priNbDecimals);
+  }
 
   for (int pos = _lowestAskPricePos - 1; pos >= 0 && integralAmountRep <= integralTotalAmount; --pos) {
     integralAmountRep += _orders[pos].amount;
@@ -472,8 +629,45 @@ MarketOrderBook::AmountPerPriceVec MarketOrderBook::computePricesAtWhichAmountWo
   return ret;
 }
 
+MarketOrderBook::AmountPerPriceVec MarketOrderBook::computeMatchedPartsSideColumns(const SideColumns& sideColumns,
+                                                                                   MonetaryAmount amount,
+                                                                                   MonetaryAmount price,
+                                                                                   bool isAsk) const {
+  AmountPerPriceVec ret;
+  const auto volumeNbDecimals = _volAndPriNbDecimals.volNbDecimals;
+  const std::optional<AmountType> integralTotalAmountOpt = amount.amount(volumeNbDecimals);
+  if (!integralTotalAmountOpt || *integralTotalAmountOpt <= 0) {
+    return ret;
+  }
+  const AmountType integralTotalAmount = *integralTotalAmountOpt;
+  const int nbLevels = nbLevelsAtOrBetterThan(sideColumns, price, isAsk);
+  const int lastPos = sideColumns.levelReachingVolume(integralTotalAmount, nbLevels);
+  const int nbParts = std::min(lastPos + 1, nbLevels);
+
+  ret.reserve(nbParts);
+  const auto cur = amount.currencyCode();
+  for (int pos = 0; pos < nbParts; ++pos) {
+    const MonetaryAmount linePrice(sideColumns.prices[pos], _market.quote(), _volAndPriNbDecimals.priNbDecimals);
+    const AmountType previousCumulAmount = pos == 0 ? 0 : sideColumns.cumulVolumes[pos - 1];
+    const AmountType intAmount =
+        pos == lastPos ? integralTotalAmount - previousCumulAmount : sideColumns.volumes[pos];
+    ret.emplace_back(MonetaryAmount(intAmount, cur, volumeNbDecimals), linePrice);
+  }
+  return ret;
+}
+
 MarketOrderBook::AmountPerPriceVec MarketOrderBook::computeMatchedParts(TradeSide tradeSide, MonetaryAmount amount,
                                                                         MonetaryAmount price) const {
+  if (_sideColumnsPtr) {
+    switch (tradeSide) {
+      case TradeSide::buy:
+        return computeMatchedPartsSideColumns(_sideColumnsPtr->asks, amount, price, true);
+      case TradeSide::sell:
+        return computeMatchedPartsSideColumns(_sideColumnsPtr->bids, amount, price, false);
+      default:
+        unreachable();
+    }
+  }
   AmountPerPriceVec ret;
   const int nbOrders = _orders.size();
   const auto volumeNbDecimals = _volAndPriNbDecimals.volNbDecimals;
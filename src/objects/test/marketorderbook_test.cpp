@@ -12,6 +12,7 @@
 #include "order-book-line.hpp"
 #include "timedef.hpp"
 #include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
 
 namespace cct {
 namespace {
@@ -42,7 +43,27 @@ TEST(MarketOrderBookTest, DefaultConstructor) {
 
 TEST(MarketOrderBookTest, Basic) { EXPECT_TRUE(MarketOrderBook(Clock::now(), Market("ETH", "EUR"), {}).empty()); }
 
-class MarketOrderBookTestCase1 : public ::testing::Test {
+TEST(MarketOrderBookTest, LayoutNotCompared) {
+  const TimePoint time;
+  const Market market("ETH", "EUR");
+  const auto lines = CreateMarketOrderBookLines(
+      {OrderBookLine(MonetaryAmount("0.65", "ETH"), MonetaryAmount("1300.50", "EUR"), OrderBookLine::Type::kBid),
+       OrderBookLine(MonetaryAmount("1.4009", "ETH"), MonetaryAmount("1302", "EUR"), OrderBookLine::Type::kAsk)});
+
+  const MarketOrderBook levelsMarketOrderBook(time, market, lines);
+  const MarketOrderBook sideColumnsMarketOrderBook(time, market, lines, VolAndPriNbDecimals(),
+                                                   MarketOrderBook::Layout::kSideColumns);
+
+  EXPECT_EQ(levelsMarketOrderBook.layout(), MarketOrderBook::Layout::kLevels);
+  EXPECT_EQ(sideColumnsMarketOrderBook.layout(), MarketOrderBook::Layout::kSideColumns);
+  EXPECT_EQ(levelsMarketOrderBook, sideColumnsMarketOrderBook);
+
+  // Copies share the side columns
+  const MarketOrderBook copy = sideColumnsMarketOrderBook;
+  EXPECT_EQ(copy.layout(), MarketOrderBook::Layout::kSideColumns);
+}
+
+class MarketOrderBookTestCase1 : public ::testing::TestWithParam<MarketOrderBook::Layout> {
  protected:
   MarketOrderBook marketOrderBook{
       Clock::now(), Market("ETH", "EUR"),
@@ -53,30 +74,32 @@ class MarketOrderBookTestCase1 : public ::testing::Test {
            OrderBookLine(MonetaryAmount("1.4009", "ETH"), MonetaryAmount("1302", "EUR"), OrderBookLine::Type::kAsk),
            OrderBookLine(MonetaryAmount("3.78", "ETH"), MonetaryAmount("1302.50", "EUR"), OrderBookLine::Type::kAsk),
            OrderBookLine(MonetaryAmount("56.10001267", "ETH"), MonetaryAmount("1303", "EUR"),
-                         OrderBookLine::Type::kAsk)})};
+                         OrderBookLine::Type::kAsk)}), VolAndPriNbDecimals(), GetParam()};
 };
 
-TEST_F(MarketOrderBookTestCase1, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
+TEST_P(MarketOrderBookTestCase1, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
 
-TEST_F(MarketOrderBookTestCase1, NumberOfElements) {
+TEST_P(MarketOrderBookTestCase1, Layout) { EXPECT_EQ(marketOrderBook.layout(), GetParam()); }
+
+TEST_P(MarketOrderBookTestCase1, NumberOfElements) {
   EXPECT_EQ(marketOrderBook.size(), 5);
   EXPECT_EQ(marketOrderBook.nbAskPrices(), 3);
   EXPECT_EQ(marketOrderBook.nbBidPrices(), 2);
 }
 
-TEST_F(MarketOrderBookTestCase1, NbDecimals) {
+TEST_P(MarketOrderBookTestCase1, NbDecimals) {
   const auto [volNbDecimals, priNbDecimals] = marketOrderBook.volAndPriNbDecimals();
 
   EXPECT_EQ(volNbDecimals, 16);
   EXPECT_EQ(priNbDecimals, 14);
 }
 
-TEST_F(MarketOrderBookTestCase1, MiddleElements) {
+TEST_P(MarketOrderBookTestCase1, MiddleElements) {
   EXPECT_EQ(marketOrderBook.lowestAskPrice(), MonetaryAmount("1302", "EUR"));
   EXPECT_EQ(marketOrderBook.highestBidPrice(), MonetaryAmount("1301", "EUR"));
 }
 
-TEST_F(MarketOrderBookTestCase1, OperatorBrackets) {
+TEST_P(MarketOrderBookTestCase1, OperatorBrackets) {
   EXPECT_EQ(marketOrderBook[-2], AmountPrice(MonetaryAmount("0.65ETH"), MonetaryAmount("1300.5EUR")));
   EXPECT_EQ(marketOrderBook[-1], AmountPrice(MonetaryAmount("0.24ETH"), MonetaryAmount("1301EUR")));
   EXPECT_EQ(marketOrderBook[0], AmountPrice(MonetaryAmount("0.82045ETH"), MonetaryAmount("1301.5EUR")));
@@ -85,7 +108,7 @@ TEST_F(MarketOrderBookTestCase1, OperatorBrackets) {
   EXPECT_EQ(marketOrderBook[3], AmountPrice(MonetaryAmount("56.10001267ETH"), MonetaryAmount("1303EUR")));
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeCumulAmountBoughtImmediately) {
+TEST_P(MarketOrderBookTestCase1, ComputeCumulAmountBoughtImmediately) {
   EXPECT_EQ(marketOrderBook.computeCumulAmountBoughtImmediatelyAt(MonetaryAmount("1302.25", "EUR")),
             MonetaryAmount("1.4009", "ETH"));
   EXPECT_EQ(marketOrderBook.computeCumulAmountBoughtImmediatelyAt(MonetaryAmount("1302.5", "EUR")),
@@ -95,7 +118,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeCumulAmountBoughtImmediately) {
   EXPECT_THROW(marketOrderBook.computeCumulAmountBoughtImmediatelyAt(MonetaryAmount(1, "ETH")), exception);
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeCumulAmountSoldImmediately) {
+TEST_P(MarketOrderBookTestCase1, ComputeCumulAmountSoldImmediately) {
   EXPECT_EQ(marketOrderBook.computeCumulAmountSoldImmediatelyAt(MonetaryAmount("1301", "EUR")),
             MonetaryAmount("0.24", "ETH"));
   EXPECT_EQ(marketOrderBook.computeCumulAmountSoldImmediatelyAt(MonetaryAmount(1, "EUR")),
@@ -105,7 +128,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeCumulAmountSoldImmediately) {
   EXPECT_THROW(marketOrderBook.computeCumulAmountSoldImmediatelyAt(MonetaryAmount(1, "ETH")), exception);
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeMinPriceAtWhichAmountWouldBeBoughtImmediately) {
+TEST_P(MarketOrderBookTestCase1, ComputeMinPriceAtWhichAmountWouldBeBoughtImmediately) {
   EXPECT_EQ(marketOrderBook.computeMinPriceAtWhichAmountWouldBeSoldImmediately(MonetaryAmount(0, "ETH")),
             MonetaryAmount("1301", "EUR"));
   EXPECT_EQ(marketOrderBook.computeMinPriceAtWhichAmountWouldBeSoldImmediately(MonetaryAmount("0.1", "ETH")),
@@ -115,7 +138,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeMinPriceAtWhichAmountWouldBeBoughtImmedi
   EXPECT_EQ(marketOrderBook.computeMinPriceAtWhichAmountWouldBeSoldImmediately(MonetaryAmount(1, "ETH")), std::nullopt);
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeMaxPriceAtWhichAmountWouldBeBoughtImmediately) {
+TEST_P(MarketOrderBookTestCase1, ComputeMaxPriceAtWhichAmountWouldBeBoughtImmediately) {
   EXPECT_EQ(marketOrderBook.computeMaxPriceAtWhichAmountWouldBeBoughtImmediately(MonetaryAmount(0, "ETH")),
             MonetaryAmount("1302", "EUR"));
   EXPECT_EQ(marketOrderBook.computeMaxPriceAtWhichAmountWouldBeBoughtImmediately(MonetaryAmount(1, "ETH")),
@@ -126,7 +149,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeMaxPriceAtWhichAmountWouldBeBoughtImmedi
             std::nullopt);
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeAvgPriceForTakerBuy) {
+TEST_P(MarketOrderBookTestCase1, ComputeAvgPriceForTakerBuy) {
   EXPECT_EQ(marketOrderBook.avgPriceAndMatchedAmountTaker(MonetaryAmount(1000, "EUR")),
             AmountPrice(MonetaryAmount("999.99999999998784", "EUR"), MonetaryAmount("1302.00000000000001", "EUR")));
   EXPECT_EQ(marketOrderBook.avgPriceAndMatchedAmountTaker(MonetaryAmount(5000, "EUR")),
@@ -135,7 +158,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeAvgPriceForTakerBuy) {
             AmountPrice(MonetaryAmount("79845.737428463776", "EUR"), MonetaryAmount("1302.94629812356546", "EUR")));
 }
 
-TEST_F(MarketOrderBookTestCase1, ComputeAvgPriceForTakerSell) {
+TEST_P(MarketOrderBookTestCase1, ComputeAvgPriceForTakerSell) {
   EXPECT_EQ(marketOrderBook.avgPriceAndMatchedAmountTaker(MonetaryAmount(24, "ETH", 2)),
             AmountPrice(MonetaryAmount(24, "ETH", 2), MonetaryAmount(1301, "EUR")));
   EXPECT_EQ(marketOrderBook.avgPriceAndMatchedAmountTaker(MonetaryAmount(5, "ETH", 1)),
@@ -144,7 +167,7 @@ TEST_F(MarketOrderBookTestCase1, ComputeAvgPriceForTakerSell) {
             AmountPrice(MonetaryAmount(89, "ETH", 2), MonetaryAmount("1300.63483146067415", "EUR")));
 }
 
-TEST_F(MarketOrderBookTestCase1, MoreComplexListOfPricesComputations) {
+TEST_P(MarketOrderBookTestCase1, MoreComplexListOfPricesComputations) {
   EXPECT_EQ(marketOrderBook.computePricesAtWhichAmountWouldBeBoughtImmediately(MonetaryAmount(4, "ETH")),
             AmountAtPriceVec({AmountPrice(MonetaryAmount("1.4009", "ETH"), MonetaryAmount("1302", "EUR")),
                               AmountPrice(MonetaryAmount("2.5991", "ETH"), MonetaryAmount("1302.50", "EUR"))}));
@@ -152,20 +175,23 @@ TEST_F(MarketOrderBookTestCase1, MoreComplexListOfPricesComputations) {
             AmountAtPriceVec({AmountPrice(MonetaryAmount("0.24", "ETH"), MonetaryAmount("1301", "EUR"))}));
 }
 
-TEST_F(MarketOrderBookTestCase1, ConvertBaseAmountToQuote) {
+TEST_P(MarketOrderBookTestCase1, ConvertBaseAmountToQuote) {
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("0.56", "ETH")), MonetaryAmount("728.4", "EUR"));
 }
 
-TEST_F(MarketOrderBookTestCase1, ConvertQuoteAmountToBase) {
+TEST_P(MarketOrderBookTestCase1, ConvertQuoteAmountToBase) {
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("800", "EUR")), MonetaryAmount("0.61443932411674347", "ETH"));
 }
 
-TEST_F(MarketOrderBookTestCase1, Convert) {
+TEST_P(MarketOrderBookTestCase1, Convert) {
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("0.56", "ETH")), MonetaryAmount("728.4", "EUR"));
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("800", "EUR")), MonetaryAmount("0.61443932411674347", "ETH"));
 }
 
-class MarketOrderBookTestDuplicatedLines : public ::testing::Test {
+INSTANTIATE_TEST_SUITE_P(Layouts, MarketOrderBookTestCase1,
+                         ::testing::Values(MarketOrderBook::Layout::kLevels, MarketOrderBook::Layout::kSideColumns));
+
+class MarketOrderBookTestDuplicatedLines : public ::testing::TestWithParam<MarketOrderBook::Layout> {
  protected:
   MarketOrderBook marketOrderBook{
       TimePoint{}, Market("ETH", "EUR"),
@@ -178,27 +204,30 @@ class MarketOrderBookTestDuplicatedLines : public ::testing::Test {
            OrderBookLine(MonetaryAmount("3.78", "ETH"), MonetaryAmount("1302.50", "EUR"), OrderBookLine::Type::kAsk),
            OrderBookLine(MonetaryAmount("0.24", "ETH"), MonetaryAmount("1302.50", "EUR"), OrderBookLine::Type::kAsk),
            OrderBookLine(MonetaryAmount("56.10001267", "ETH"), MonetaryAmount("1303", "EUR"),
-                         OrderBookLine::Type::kAsk)})};
+                         OrderBookLine::Type::kAsk)}), VolAndPriNbDecimals(), GetParam()};
 };
 
-TEST_F(MarketOrderBookTestDuplicatedLines, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
+TEST_P(MarketOrderBookTestDuplicatedLines, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
 
-TEST_F(MarketOrderBookTestDuplicatedLines, NumberOfElements) {
+TEST_P(MarketOrderBookTestDuplicatedLines, NumberOfElements) {
   EXPECT_EQ(marketOrderBook.size(), 5);
   EXPECT_EQ(marketOrderBook.nbAskPrices(), 3);
   EXPECT_EQ(marketOrderBook.nbBidPrices(), 2);
 }
 
-TEST_F(MarketOrderBookTestDuplicatedLines, MiddleElements) {
+TEST_P(MarketOrderBookTestDuplicatedLines, MiddleElements) {
   EXPECT_EQ(marketOrderBook.lowestAskPrice(), MonetaryAmount("1302", "EUR"));
   EXPECT_EQ(marketOrderBook.highestBidPrice(), MonetaryAmount("1301", "EUR"));
 }
 
-TEST_F(MarketOrderBookTestDuplicatedLines, SummedAmountAsk) {
+TEST_P(MarketOrderBookTestDuplicatedLines, SummedAmountAsk) {
   EXPECT_EQ(marketOrderBook[2].amount, MonetaryAmount("4.02", "ETH"));
 }
 
-class MarketOrderBookTestCase2 : public ::testing::Test {
+INSTANTIATE_TEST_SUITE_P(Layouts, MarketOrderBookTestDuplicatedLines,
+                         ::testing::Values(MarketOrderBook::Layout::kLevels, MarketOrderBook::Layout::kSideColumns));
+
+class MarketOrderBookTestCase2 : public ::testing::TestWithParam<MarketOrderBook::Layout> {
  protected:
   TimePoint time;
   MarketOrderBook marketOrderBook{
@@ -215,12 +244,12 @@ class MarketOrderBookTestCase2 : public ::testing::Test {
            OrderBookLine(MonetaryAmount("14", "APM"), MonetaryAmount("57.18", "KRW"), OrderBookLine::Type::kBid),
            OrderBookLine(MonetaryAmount("14", "APM"), MonetaryAmount("57.17", "KRW"), OrderBookLine::Type::kBid),
            OrderBookLine(MonetaryAmount("3848.8453", "APM"), MonetaryAmount("57.16", "KRW"),
-                         OrderBookLine::Type::kBid)})};
+                         OrderBookLine::Type::kBid)}), VolAndPriNbDecimals(), GetParam()};
 };
 
-TEST_F(MarketOrderBookTestCase2, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
+TEST_P(MarketOrderBookTestCase2, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
 
-TEST_F(MarketOrderBookTestCase2, NbDecimals) {
+TEST_P(MarketOrderBookTestCase2, NbDecimals) {
   const auto [volNbDecimals, priNbDecimals] = marketOrderBook.volAndPriNbDecimals();
 
   EXPECT_EQ(volNbDecimals, 13);
@@ -243,19 +272,19 @@ TEST_F(MarketOrderBookTestCase2, NbDecimals) {
   }
 }
 
-TEST_F(MarketOrderBookTestCase2, SimpleQueries) {
+TEST_P(MarketOrderBookTestCase2, SimpleQueries) {
   EXPECT_EQ(marketOrderBook.size(), 9);
   EXPECT_EQ(marketOrderBook.lowestAskPrice(), MonetaryAmount("57.78", "KRW"));
   EXPECT_EQ(marketOrderBook.highestBidPrice(), MonetaryAmount("57.19", "KRW"));
 }
 
-TEST_F(MarketOrderBookTestCase2, ConvertQuoteAmountToBase) {
+TEST_P(MarketOrderBookTestCase2, ConvertQuoteAmountToBase) {
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("50000000", "KRW")), std::optional<MonetaryAmount>());
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("500", "KRW")), MonetaryAmount("8.6535133264105226", "APM"));
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("500000", "KRW")), MonetaryAmount("8649.3845211510554", "APM"));
 }
 
-TEST_F(MarketOrderBookTestCase2, ComputeMatchedPartsBuy) {
+TEST_P(MarketOrderBookTestCase2, ComputeMatchedPartsBuy) {
   EXPECT_EQ(
       marketOrderBook.computeMatchedParts(TradeSide::buy, MonetaryAmount(91000, "APM"), MonetaryAmount("57.81", "KRW")),
       AmountAtPriceVec({AmountPrice(MonetaryAmount("33.5081914157147", "APM"), MonetaryAmount("57.78", "KRW")),
@@ -266,7 +295,7 @@ TEST_F(MarketOrderBookTestCase2, ComputeMatchedPartsBuy) {
       AmountAtPriceVec());
 }
 
-TEST_F(MarketOrderBookTestCase2, ComputeMatchedPartsSell) {
+TEST_P(MarketOrderBookTestCase2, ComputeMatchedPartsSell) {
   EXPECT_EQ(
       marketOrderBook.computeMatchedParts(TradeSide::sell, MonetaryAmount(5000, "APM"), MonetaryAmount("57.19", "KRW")),
       AmountAtPriceVec({
@@ -277,7 +306,10 @@ TEST_F(MarketOrderBookTestCase2, ComputeMatchedPartsSell) {
             AmountAtPriceVec());
 }
 
-class MarketOrderBookTestCase3 : public ::testing::Test {
+INSTANTIATE_TEST_SUITE_P(Layouts, MarketOrderBookTestCase2,
+                         ::testing::Values(MarketOrderBook::Layout::kLevels, MarketOrderBook::Layout::kSideColumns));
+
+class MarketOrderBookTestCase3 : public ::testing::TestWithParam<MarketOrderBook::Layout> {
  protected:
   TimePoint time;
   MarketOrderBook marketOrderBook{
@@ -293,12 +325,13 @@ class MarketOrderBookTestCase3 : public ::testing::Test {
                                   OrderBookLine(MonetaryAmount("169165.594", "XLM"),
                                                 MonetaryAmount("0.000007090", "BTC"), OrderBookLine::Type::kBid),
                                   OrderBookLine(MonetaryAmount("204218.966", "XLM"),
-                                                MonetaryAmount("0.000007080", "BTC"), OrderBookLine::Type::kBid)})};
+                                                MonetaryAmount("0.000007080", "BTC"), OrderBookLine::Type::kBid)}),
+      VolAndPriNbDecimals(), GetParam()};
 };
 
-TEST_F(MarketOrderBookTestCase3, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
+TEST_P(MarketOrderBookTestCase3, IsValid) { EXPECT_TRUE(marketOrderBook.isValid()); }
 
-TEST_F(MarketOrderBookTestCase3, Convert) {
+TEST_P(MarketOrderBookTestCase3, Convert) {
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("600000", "XLM")), std::nullopt);
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount(3, "BTC")), std::nullopt);
   EXPECT_EQ(marketOrderBook.convert(MonetaryAmount("42050", "XLM")), MonetaryAmount("0.2985131371", "BTC"));
@@ -306,7 +339,7 @@ TEST_F(MarketOrderBookTestCase3, Convert) {
             MonetaryAmount("216266.409928471248", "XLM"));
 }
 
-TEST_F(MarketOrderBookTestCase3, AvgPriceAndMatchedVolume) {
+TEST_P(MarketOrderBookTestCase3, AvgPriceAndMatchedVolume) {
   EXPECT_EQ(marketOrderBook.avgPriceAndMatchedVolume(TradeSide::buy, MonetaryAmount(100000, "XLM"),
                                                      MonetaryAmount("0.000007121", "BTC")),
             AmountPrice(MonetaryAmount(100000, "XLM"), MonetaryAmount("0.0000071176273715", "BTC")));
@@ -322,6 +355,9 @@ TEST_F(MarketOrderBookTestCase3, AvgPriceAndMatchedVolume) {
             AmountPrice(MonetaryAmount(0, "XLM"), MonetaryAmount(0, "BTC")));
 }
 
+INSTANTIATE_TEST_SUITE_P(Layouts, MarketOrderBookTestCase3,
+                         ::testing::Values(MarketOrderBook::Layout::kLevels, MarketOrderBook::Layout::kSideColumns));
+
 class MarketOrderBookTestCaseExtended1 : public ::testing::Test {
  protected:
   TimePoint time;
@@ -17,6 +17,7 @@
 #include "monetaryamountbycurrencyset.hpp"
 #include "optional-or-type.hpp"
 #include "priceoptionsdef.hpp"
+#include "size-bytes-schema.hpp"
 #include "timedef.hpp"
 
 namespace cct::schema {
@@ -32,9 +33,21 @@ struct ExchangeQueryHttpConfig {
     if (other.timeout) {
       timeout = *other.timeout;
     }
+    if (other.weightLimit) {
+      weightLimit = *other.weightLimit;
+    }
+    if (other.weightWindow) {
+      weightWindow = *other.weightWindow;
+    }
+    if (other.usedWeightHeader) {
+      usedWeightHeader = *other.usedWeightHeader;
+    }
   }
 
   optional_or_t<Duration, Optional> timeout;
+  optional_or_t<int32_t, Optional> weightLimit{};
+  optional_or_t<Duration, Optional> weightWindow{};
+  optional_or_t<string, Optional> usedWeightHeader;
 };
 
 template <bool Optional>
@@ -105,6 +118,7 @@ struct ExchangeQueryConfig {
       trade.mergeWith(*other.trade);
     }
     MergeWith(other.updateFrequency, updateFrequency);
+    MergeWith(other.refreshAhead, refreshAhead);
     if (other.acceptEncoding) {
       acceptEncoding = *other.acceptEncoding;
     }
@@ -123,6 +137,12 @@ struct ExchangeQueryConfig {
     if (other.marketDataSerialization) {
       marketDataSerialization = *other.marketDataSerialization;
     }
+    if (other.marketDataSerializationMemoryBudget) {
+      marketDataSerializationMemoryBudget = *other.marketDataSerializationMemoryBudget;
+    }
+    if (other.marketDataSerializationQueueSize) {
+      marketDataSerializationQueueSize = *other.marketDataSerializationQueueSize;
+    }
     if (other.multiTradeAllowedByDefault) {
       multiTradeAllowedByDefault = *other.multiTradeAllowedByDefault;
     }
@@ -138,16 +158,26 @@ struct ExchangeQueryConfig {
     return updateFrequency[static_cast<int>(queryType)].second.duration;
   }
 
+  /// Get the age from which a cached value of given query type is refreshed ahead of its expiry (given by its update
+  /// frequency) during idle times, or kUndefinedDuration if refresh ahead is not enabled for this query type.
+  [[nodiscard]] ::cct::Duration getRefreshAheadFrequency(QueryType queryType) const {
+    const auto it = std::ranges::find(refreshAhead, queryType, [](const auto &pair) { return pair.first; });
+    return it == refreshAhead.end() ? ::cct::kUndefinedDuration : it->second.duration;
+  }
+
   optional_or_t<ExchangeQueryHttpConfig<Optional>, Optional> http;
   optional_or_t<ExchangeQueryLogLevelsConfig<Optional>, Optional> logLevels;
   optional_or_t<ExchangeQueryTradeConfig<Optional>, Optional> trade;
   ExchangeQueryUpdateFrequencyConfig updateFrequency;
+  ExchangeQueryUpdateFrequencyConfig refreshAhead;
   optional_or_t<string, Optional> acceptEncoding;
   optional_or_t<Duration, Optional> privateAPIRate{};
   optional_or_t<Duration, Optional> publicAPIRate{};
   MonetaryAmountByCurrencySet dustAmountsThreshold;
   optional_or_t<int32_t, Optional> dustSweeperMaxNbTrades{};
   optional_or_t<bool, Optional> marketDataSerialization{};
+  optional_or_t<SizeBytes, Optional> marketDataSerializationMemoryBudget{};
+  optional_or_t<int32_t, Optional> marketDataSerializationQueueSize{};
   optional_or_t<bool, Optional> multiTradeAllowedByDefault{};
   optional_or_t<bool, Optional> placeSimulateRealOrder{};
   optional_or_t<bool, Optional> validateApiKey{};
@@ -59,13 +59,18 @@ struct ExchangeConfigDefault {
       ],
       "dustSweeperMaxNbTrades": 7,
       "http": {
-        "timeout": "15s"
+        "timeout": "15s",
+        "usedWeightHeader": "",
+        "weightLimit": 0,
+        "weightWindow": "1min"
       },
       "logLevels": {
         "requestsCall": "info",
         "requestsAnswer": "trace"
       },
       "marketDataSerialization": true,
+      "marketDataSerializationMemoryBudget": "0",
+      "marketDataSerializationQueueSize": 0,
       "multiTradeAllowedByDefault": false,
       "placeSimulateRealOrder": false,
       "trade": {
@@ -90,8 +95,13 @@ struct ExchangeConfigDefault {
     "exchange": {
       "binance": {
         "acceptEncoding": "gzip,deflate",
+        "http": {
+          "usedWeightHeader": "X-MBX-USED-WEIGHT-1M",
+          "weightLimit": 6000,
+          "weightWindow": "1min"
+        },
         "privateAPIRate": "150ms",
-        "publicAPIRate": "55ms"
+        "publicAPIRate": "0ms"
       },
       "bithumb": {
         "privateAPIRate": "8ms",
@@ -186,7 +196,10 @@ struct ExchangeConfigDefault {
       ],
       "dustSweeperMaxNbTrades": 5,
       "http": {
-        "timeout": "10s"
+        "timeout": "10s",
+        "usedWeightHeader": "",
+        "weightLimit": 0,
+        "weightWindow": "1min"
       },
       "logLevels": {
         "requestsCall": "info",
@@ -100,6 +100,10 @@ class ExchangeConfigTest : public ::testing::Test {
     "exchange": {
       "binance": {
         "acceptEncoding": "gzip,deflate",
+        "http": {
+          "usedWeightHeader": "X-MBX-USED-WEIGHT-1M",
+          "weightLimit": 6000
+        },
         "privateAPIRate": "150ms",
         "publicAPIRate": "55ms"
       },
@@ -221,6 +225,10 @@ TEST_F(ExchangeConfigTest, ExchangeValuesShouldOverrideDefault) {
   EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::binance].query.privateAPIRate.duration,
             std::chrono::milliseconds(150));
   EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::binance].query.publicAPIRate.duration, std::chrono::milliseconds(55));
+  EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::binance].query.http.timeout.duration, std::chrono::seconds(15));
+  EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::binance].query.http.weightLimit, 6000);
+  EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::binance].query.http.usedWeightHeader, "X-MBX-USED-WEIGHT-1M");
+  EXPECT_EQ(allExchangeConfigs[ExchangeNameEnum::kraken].query.http.weightLimit, 0);
 }
 
 }  // namespace cct::schema
\ No newline at end of file
@@ -19,6 +19,11 @@ class AbstractMarketDataDeserializer {
   virtual MarketOrderBookVector pullMarketOrderBooks(Market market, TimeWindow timeWindow) = 0;
 
   virtual PublicTradeVector pullTrades(Market market, TimeWindow timeWindow) = 0;
+
+  /// Compacts all the serialized data of given market (or of all markets if undefined) into read-optimized files,
+  /// used by subsequent pulls of data of the same market.
+  /// Returns the number of compacted files written.
+  virtual int compactMarketData(Market market) = 0;
 };
 
 }  // namespace cct
\ No newline at end of file
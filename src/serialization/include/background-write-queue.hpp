@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "metric-handles.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Bounded queue of write tasks, executed in their push order by a dedicated thread.
+/// It allows the producer of data to not wait for slow operations (sorting, compressing, writing files...) as long as
+/// the writer thread keeps up. Otherwise, 'push' blocks until a slot is available in the queue (backpressure).
+/// At destruction, all the remaining tasks are executed before the writer thread is joined.
+class BackgroundWriteQueue {
+ public:
+  using Task = std::function<void()>;
+
+  struct Stats {
+    int64_t nbPushedTasks{};
+    int64_t nbExecutedTasks{};
+    int32_t queueDepth{};
+    int32_t maxQueueDepth{};
+    // Number of pushes which had to wait for a free slot in the queue, and their total waiting time
+    int64_t nbBackpressureWaits{};
+    Duration backpressureWaitDuration{};
+  };
+
+  /// Gauges updated with the statistics of the queue each time they change (default ones do nothing).
+  struct Gauges {
+    MetricGauge queueDepth;
+    MetricGauge maxQueueDepth;
+    MetricGauge nbBackpressureWaits;
+    MetricGauge backpressureWaitDurationInMs;
+  };
+
+  /// @param maxNbQueuedTasks maximum number of tasks waiting for their execution, should be strictly positive
+  /// @param gauges gauges to which the statistics of the queue are exported
+  explicit BackgroundWriteQueue(int32_t maxNbQueuedTasks, Gauges gauges = Gauges{});
+
+  BackgroundWriteQueue(const BackgroundWriteQueue &) = delete;
+  BackgroundWriteQueue(BackgroundWriteQueue &&) = delete;
+  BackgroundWriteQueue &operator=(const BackgroundWriteQueue &) = delete;
+  BackgroundWriteQueue &operator=(BackgroundWriteQueue &&) = delete;
+
+  ~BackgroundWriteQueue();
+
+  /// Pushes a new task to be executed by the writer thread, waiting for a free slot if the queue is full.
+  /// Exceptions thrown by the task are logged by the writer thread.
+  /// @param nbBytes size of the data held by the task, accounted in 'nbQueuedBytes' until the task is executed
+  void push(Task task, int64_t nbBytes = 0);
+
+  /// Blocks until all pushed tasks have been executed.
+  void waitUntilEmpty();
+
+  Stats stats() const;
+
+  /// Get the size of the data held by the tasks not executed yet.
+  int64_t nbQueuedBytes() const noexcept { return _nbQueuedBytes.load(std::memory_order_relaxed); }
+
+ private:
+  struct QueuedTask {
+    Task task;
+    int64_t nbBytes{};
+  };
+
+  void run();
+
+  std::deque<QueuedTask> _tasks;
+  mutable std::mutex _mutex;
+  std::condition_variable _taskPushedCondition;
+  std::condition_variable _taskExecutedCondition;
+  Stats _stats;
+  Gauges _gauges;
+  std::atomic<int64_t> _nbQueuedBytes{};
+  int32_t _maxNbQueuedTasks;
+  bool _stop = false;
+
+  // Should be last member, so that it is joined before the destruction of the other members
+  std::jthread _writerThread;
+};
+
+}  // namespace cct
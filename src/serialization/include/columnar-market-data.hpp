@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+#include "market-order-book-vector.hpp"
+#include "market-order-book.pb.h"
+#include "market.hpp"
+#include "memory-mapped-file.hpp"
+#include "proto-constants.hpp"
+#include "public-trade-vector.hpp"
+#include "public-trade.pb.h"
+#include "time-window.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Columnar storage of the full history of a single market, built once by compaction of the hourly protobuf files.
+/// Contrary to the gzipped, streamed protobuf files, it can be memory mapped and random accessed: loading a time window
+/// is a binary search on the timestamps followed by a copy of the matching ranges of integers, without any
+/// decompression nor message parsing.
+///
+/// File layout (integers are stored in host byte order, each array starts on a 8 bytes boundary):
+///  - ColumnarFileHeader
+///  - For market order books (levels are stored in MarketOrderBook order: bids by increasing price, then asks)
+///      int64  unixTimestampInMs[nbRecords]
+///      uint64 levelsOffsets[nbRecords + 1]   (position of the first level of each order book in levels arrays)
+///      uint32 nbBids[nbRecords]
+///      int8   volumeNbDecimals[nbRecords]
+///      int8   priceNbDecimals[nbRecords]
+///      int64  prices[nbLevels]
+///      int64  volumes[nbLevels]
+///  - For public trades
+///      int64  unixTimestampInMs[nbRecords]
+///      int64  prices[nbRecords]
+///      int64  volumes[nbRecords]
+///      int8   priceNbDecimals[nbRecords]
+///      int8   volumeNbDecimals[nbRecords]
+///      int8   tradeSides[nbRecords]
+struct ColumnarFileHeader {
+  static constexpr std::array<char, 8> kMagic{'C', 'C', 'T', 'C', 'O', 'L', 'M', 'N'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kByteOrderMark = 0x01020304U;
+
+  std::array<char, 8> magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t byteOrderMark = kByteOrderMark;
+  uint32_t objectType{};
+  uint32_t unused{};
+  uint64_t nbRecords{};
+  uint64_t nbLevels{};
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 40U);
+
+namespace details {
+
+/// Values of a single column of a columnar file being built.
+/// They are streamed to a temporary file next to the columnar file, so that the memory needed to build a columnar file
+/// does not depend on the length of the market history.
+class ColumnarFileColumn {
+ public:
+  ColumnarFileColumn(const std::filesystem::path &columnarFilePath, std::string_view columnName);
+
+  ColumnarFileColumn(const ColumnarFileColumn &) = delete;
+  ColumnarFileColumn(ColumnarFileColumn &&) = delete;
+  ColumnarFileColumn &operator=(const ColumnarFileColumn &) = delete;
+  ColumnarFileColumn &operator=(ColumnarFileColumn &&) = delete;
+
+  /// Removes the temporary file.
+  ~ColumnarFileColumn();
+
+  template <class T>
+  void append(T value) {
+    _ofs.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  /// Copies all the values of this column to given stream, and returns the number of copied bytes.
+  /// No value can be appended afterwards.
+  std::size_t copyTo(std::ostream &os);
+
+ private:
+  std::filesystem::path _tmpFilePath;
+  std::ofstream _ofs;
+};
+
+}  // namespace details
+
+/// Streams market order books messages (ordered by timestamp) in columns before writing them in a columnar file.
+class ColumnarMarketOrderBooksBuilder {
+ public:
+  /// Temporary files holding the columns are created next to given columnar file path.
+  explicit ColumnarMarketOrderBooksBuilder(const std::filesystem::path &filePath);
+
+  void append(const ::proto::MarketOrderBook &marketOrderBook);
+
+  std::size_t size() const noexcept { return _nbRecords; }
+
+  bool empty() const noexcept { return _nbRecords == 0; }
+
+  /// Atomically writes (or replaces) the columnar file.
+  void write();
+
+ private:
+  std::filesystem::path _filePath;
+  details::ColumnarFileColumn _timestamps;
+  details::ColumnarFileColumn _levelsOffsets;
+  details::ColumnarFileColumn _nbBids;
+  details::ColumnarFileColumn _volumeNbDecimals;
+  details::ColumnarFileColumn _priceNbDecimals;
+  details::ColumnarFileColumn _prices;
+  details::ColumnarFileColumn _volumes;
+  std::size_t _nbRecords{};
+  std::size_t _nbLevels{};
+  int64_t _lastTimestamp{};
+  bool _isSorted = true;
+};
+
+/// Streams public trades messages (ordered by timestamp) in columns before writing them in a columnar file.
+class ColumnarPublicTradesBuilder {
+ public:
+  /// Temporary files holding the columns are created next to given columnar file path.
+  explicit ColumnarPublicTradesBuilder(const std::filesystem::path &filePath);
+
+  void append(const ::proto::PublicTrade &publicTrade);
+
+  std::size_t size() const noexcept { return _nbRecords; }
+
+  bool empty() const noexcept { return _nbRecords == 0; }
+
+  /// Atomically writes (or replaces) the columnar file.
+  void write();
+
+ private:
+  std::filesystem::path _filePath;
+  details::ColumnarFileColumn _timestamps;
+  details::ColumnarFileColumn _prices;
+  details::ColumnarFileColumn _volumes;
+  details::ColumnarFileColumn _priceNbDecimals;
+  details::ColumnarFileColumn _volumeNbDecimals;
+  details::ColumnarFileColumn _tradeSides;
+  std::size_t _nbRecords{};
+  int64_t _lastTimestamp{};
+  bool _isSorted = true;
+};
+
+/// Read only, zero-copy view on a memory mapped columnar market order books file.
+/// If the file does not exist, the view is empty.
+class ColumnarMarketOrderBooksView {
+ public:
+  ColumnarMarketOrderBooksView(const std::filesystem::path &filePath, Market market);
+
+  bool empty() const noexcept { return _timestamps.empty(); }
+
+  std::size_t size() const noexcept { return _timestamps.size(); }
+
+  /// Timestamp of the latest compacted order book. Should not be called on an empty view.
+  TimePoint lastTimestamp() const { return TimePoint{milliseconds{_timestamps.back()}}; }
+
+  std::span<const int64_t> timestamps() const noexcept { return _timestamps; }
+
+  /// Builds all the market order books of this view whose timestamp is within given time window.
+  MarketOrderBookVector load(TimeWindow timeWindow) const;
+
+ private:
+  MemoryMappedFile _memoryMappedFile;
+  Market _market;
+  std::span<const int64_t> _timestamps;
+  std::span<const uint64_t> _levelsOffsets;
+  std::span<const uint32_t> _nbBids;
+  std::span<const int8_t> _volumeNbDecimals;
+  std::span<const int8_t> _priceNbDecimals;
+  std::span<const int64_t> _prices;
+  std::span<const int64_t> _volumes;
+};
+
+/// Read only, zero-copy view on a memory mapped columnar public trades file.
+/// If the file does not exist, the view is empty.
+class ColumnarPublicTradesView {
+ public:
+  ColumnarPublicTradesView(const std::filesystem::path &filePath, Market market);
+
+  bool empty() const noexcept { return _timestamps.empty(); }
+
+  std::size_t size() const noexcept { return _timestamps.size(); }
+
+  /// Timestamp of the latest compacted public trade. Should not be called on an empty view.
+  TimePoint lastTimestamp() const { return TimePoint{milliseconds{_timestamps.back()}}; }
+
+  std::span<const int64_t> timestamps() const noexcept { return _timestamps; }
+
+  /// Builds all the public trades of this view whose timestamp is within given time window.
+  PublicTradeVector load(TimeWindow timeWindow) const;
+
+ private:
+  MemoryMappedFile _memoryMappedFile;
+  Market _market;
+  std::span<const int64_t> _timestamps;
+  std::span<const int64_t> _prices;
+  std::span<const int64_t> _volumes;
+  std::span<const int8_t> _priceNbDecimals;
+  std::span<const int8_t> _volumeNbDecimals;
+  std::span<const int8_t> _tradeSides;
+};
+
+}  // namespace cct
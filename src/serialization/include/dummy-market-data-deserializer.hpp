@@ -24,6 +24,8 @@ class DummyMarketDataDeserializer : public AbstractMarketDataDeserializer {
                                              [[maybe_unused]] TimeWindow timeWindow) override;
 
   PublicTradeVector pullTrades([[maybe_unused]] Market market, [[maybe_unused]] TimeWindow timeWindow) override;
+
+  int compactMarketData([[maybe_unused]] Market market) override;
 };
 
 }  // namespace cct
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <span>
 #include <string_view>
 
@@ -10,6 +11,7 @@
 
 namespace cct {
 
+class AbstractMetricGateway;
 class MarketOrderBook;
 
 /// Implementation of a market data serializer that does nothing.
@@ -17,7 +19,8 @@ class MarketOrderBook;
 class DummyMarketDataSerializer : public AbstractMarketDataSerializer {
  public:
   DummyMarketDataSerializer(std::string_view dataDir, const MarketTimestampSets &lastWrittenObjectsMarketTimestamp,
-                            std::string_view exchangeName);
+                            std::string_view exchangeName, int32_t writeQueueSize = 0, int64_t memoryBudgetInBytes = 0,
+                            AbstractMetricGateway *pMetricGateway = nullptr);
 
   void push(const MarketOrderBook &marketOrderBook) override;
 
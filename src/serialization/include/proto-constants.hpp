@@ -9,6 +9,12 @@ enum class ProtobufObject : int8_t { kMarketOrderBook, kTrade };
 
 inline constexpr std::string_view kBinProtobufExtension = ".binpb";
 
+/// Extension of the sidecar index file of each hour protobuf file.
+inline constexpr std::string_view kBinIndexExtension = ".binidx";
+
+/// Name of the columnar file, stored in each market directory, containing the compacted data of all its hourly files.
+inline constexpr std::string_view kColumnarFileName = "compacted.bincol";
+
 inline constexpr std::string_view kSubPathMarketOrderBooks = "order-books";
 inline constexpr std::string_view kSubPathTrades = "trades";
 
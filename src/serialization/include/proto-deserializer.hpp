@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <istream>
+#include <iterator>
+#include <limits>
 #include <string_view>
 #include <system_error>
 #include <type_traits>
@@ -15,6 +19,7 @@
 #include "market-timestamp-set.hpp"
 #include "market-timestamp.hpp"
 #include "market.hpp"
+#include "proto-hour-file-index.hpp"
 #include "proto-multiple-messages-handler.hpp"
 #include "serialization-tools.hpp"
 #include "stringconv.hpp"
@@ -31,6 +36,9 @@ class ProtobufObjectsDeserializer {
   explicit ProtobufObjectsDeserializer(std::filesystem::path exchangeSerializedDataPath) noexcept
       : _exchangeSerializedDataPath(std::move(exchangeSerializedDataPath)) {}
 
+  /// Get the directory containing one sub directory per market of serialized data for this exchange.
+  const std::filesystem::path& exchangeSerializedDataPath() const noexcept { return _exchangeSerializedDataPath; }
+
   /// Load all markets found on disk which has some data in the given time window
   MarketTimestampSet listMarkets(TimeWindow timeWindow) {
     vector<MarketTimestamp> marketTimestamps;
@@ -143,24 +151,7 @@ class ProtobufObjectsDeserializer {
               continue;
             }
 
-            decltype(std::declval<ProtobufObjType>().unixtimestampinms()) lastTs = 0;
-
-            std::ifstream ifs(hourPath, std::ios::in | std::ios::binary);
-            for (ProtobufMessageCompressedReaderIterator protobufMessageReaderIt(ifs);
-                 protobufMessageReaderIt.hasNext();) {
-              auto msg = protobufMessageReaderIt.next<ProtobufObjType>();
-              if (!ValidateTimestamp(msg, timeWindow)) {
-                continue;
-              }
-
-              // In Check presence mode, we read all the file to retrieve the latest timestamp.
-              // There's no other way to do it.
-              lastTs = msg.unixtimestampinms();
-
-              if (actionType == ActionType::kLoad) {
-                ret.first.push_back(converter(std::move(msg)));
-              }
-            }
+            const auto lastTs = readHourFile(hourPath, timeWindow, actionType, converter, ret.first);
 
             if (lastTs != 0) {
               if (ret.second == TimePoint{}) {
@@ -177,6 +168,79 @@ class ProtobufObjectsDeserializer {
     return ret;
   }
 
+  /// Reads messages of given hour file within the time window, and returns the timestamp of the latest one (or 0 if
+  /// none). Uses the sidecar index of the hour file if available and valid, otherwise the whole file is read.
+  static int64_t readHourFile(const std::filesystem::path& hourPath, TimeWindow timeWindow, ActionType actionType,
+                              ProtoToCoincenterObjectsFunc& converter, vector<CoincenterObjectType>& objects) {
+    const ProtoHourFileIndex hourFileIndex(hourPath);
+    if (hourFileIndex.empty()) {
+      std::ifstream ifs(hourPath, std::ios::in | std::ios::binary);
+
+      // Without index, we need to read all the file, even in Check presence mode to retrieve the latest timestamp.
+      return ReadMessages(ifs, std::numeric_limits<uint64_t>::max(), timeWindow, actionType, converter, objects);
+    }
+
+    const auto fromTs = TimestampToMillisecondsSinceEpoch(timeWindow.from());
+    const auto toTs = TimestampToMillisecondsSinceEpoch(timeWindow.to());
+
+    // Blocks are ordered by timestamp, select the ones overlapping the time window
+    const auto entries = hourFileIndex.entries();
+    auto firstIt = std::ranges::find_if(entries, [fromTs](const auto& entry) {
+      return fromTs <= entry.lastUnixTimestampInMs;
+    });
+    const auto endIt = std::find_if(firstIt, entries.end(),
+                                    [toTs](const auto& entry) { return toTs <= entry.firstUnixTimestampInMs; });
+    if (firstIt == endIt) {
+      return 0;
+    }
+
+    if (actionType == ActionType::kCheckPresence) {
+      const auto lastEntryIt = std::prev(endIt);
+      if (lastEntryIt->lastUnixTimestampInMs < toTs) {
+        // the whole last block is within the time window
+        return lastEntryIt->lastUnixTimestampInMs;
+      }
+      // only the last block needs to be read to find the latest timestamp of the time window
+      firstIt = lastEntryIt;
+    }
+
+    uint64_t nbMessages = 0;
+    for (auto it = firstIt; it != endIt; ++it) {
+      nbMessages += it->nbMessages;
+    }
+
+    std::ifstream ifs(hourPath, std::ios::in | std::ios::binary);
+    ifs.seekg(static_cast<std::streamoff>(firstIt->beginOffset));
+
+    return ReadMessages(ifs, nbMessages, timeWindow, actionType, converter, objects);
+  }
+
+  static int64_t ReadMessages(std::istream& is, uint64_t maxNbMessages, TimeWindow timeWindow, ActionType actionType,
+                              ProtoToCoincenterObjectsFunc& converter, vector<CoincenterObjectType>& objects) {
+    int64_t lastTs = 0;
+    uint64_t nbReadMessages = 0;
+    for (ProtobufMessageCompressedReaderIterator protobufMessageReaderIt(is);
+         nbReadMessages < maxNbMessages && protobufMessageReaderIt.hasNext(); ++nbReadMessages) {
+      auto msg = protobufMessageReaderIt.next<ProtobufObjType>();
+      if constexpr (requires { converter.decode(msg); }) {
+        // Encoded messages depend on the previous ones, they need to be decoded even if they are out of the time window
+        if (actionType == ActionType::kLoad && !converter.decode(msg)) {
+          continue;
+        }
+      }
+      if (!ValidateTimestamp(msg, timeWindow)) {
+        continue;
+      }
+
+      lastTs = msg.unixtimestampinms();
+
+      if (actionType == ActionType::kLoad) {
+        objects.push_back(converter(std::move(msg)));
+      }
+    }
+    return lastTs;
+  }
+
   std::filesystem::path _exchangeSerializedDataPath;
 };
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "cct_vector.hpp"
+
+namespace cct {
+
+/// Describes one independently compressed block of messages of an hour file.
+/// Blocks are contiguous in the hour file, so that a reader can start decompressing directly at 'beginOffset'.
+struct ProtoHourFileIndexEntry {
+  int64_t firstUnixTimestampInMs{};
+  int64_t lastUnixTimestampInMs{};
+  uint64_t beginOffset{};
+  uint64_t endOffset{};
+  uint32_t nbMessages{};
+  uint32_t unused{};
+
+  bool operator==(const ProtoHourFileIndexEntry &) const noexcept = default;
+};
+
+static_assert(sizeof(ProtoHourFileIndexEntry) == 40U);
+
+/// Sparse index of an hour protobuf file, stored in a small sidecar file next to it.
+/// It is written by ProtobufObjectsSerializer (one entry appended per compressed block, a new block being started at
+/// most every kNbMessagesPerBlock messages) and allows readers to:
+///  - know the first / last timestamps and the number of messages of an hour file without decompressing it
+///  - seek directly to the first block containing data of a given time window
+/// An index that is not consistent with its hour file (hour file written by a version without index, or crash between
+/// the data write and the index write) is ignored, and readers should fall back to a full read of the hour file.
+class ProtoHourFileIndex {
+ public:
+  static constexpr uint32_t kNbMessagesPerBlock = 1000;
+
+  /// Loads the index of given hour file.
+  /// The index is empty if it does not exist or if it is not consistent with the hour file.
+  explicit ProtoHourFileIndex(const std::filesystem::path &hourFilePath);
+
+  /// Appends entries to the index of given hour file.
+  static void Append(const std::filesystem::path &hourFilePath, std::span<const ProtoHourFileIndexEntry> entries);
+
+  /// Get the path of the index file of given hour file.
+  static std::filesystem::path IndexFilePath(const std::filesystem::path &hourFilePath);
+
+  bool empty() const noexcept { return _entries.empty(); }
+
+  std::span<const ProtoHourFileIndexEntry> entries() const noexcept { return _entries; }
+
+  /// Timestamp of the first message of the hour file. Should not be called on an empty index.
+  int64_t firstUnixTimestampInMs() const { return _entries.front().firstUnixTimestampInMs; }
+
+  /// Timestamp of the last message of the hour file. Should not be called on an empty index.
+  int64_t lastUnixTimestampInMs() const { return _entries.back().lastUnixTimestampInMs; }
+
+  uint64_t nbMessages() const noexcept;
+
+ private:
+  vector<ProtoHourFileIndexEntry> _entries;
+};
+
+}  // namespace cct
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <filesystem>
 #include <string_view>
+#include <unordered_map>
 
 #include "abstract-market-data-deserializer.hpp"
+#include "columnar-market-data.hpp"
 #include "market-order-book-vector.hpp"
 #include "market-order-book.pb.h"
 #include "market-timestamp-set.hpp"
@@ -28,9 +31,24 @@ class ProtoMarketDataDeserializer : public AbstractMarketDataDeserializer {
 
   PublicTradeVector pullTrades(Market market, TimeWindow timeWindow) override;
 
+  int compactMarketData(Market market) override;
+
  private:
+  /// Columnar file of a market, mapped and validated once and reused for all the pulls of its time windows.
+  /// It is mapped again only if the file has been replaced (by a new compaction) since.
+  template <class ColumnarView>
+  struct CachedColumnarView {
+    ColumnarView view;
+    std::filesystem::file_time_type lastWriteTime;
+  };
+
+  template <class ColumnarView>
+  using ColumnarViewsMap = std::unordered_map<Market, CachedColumnarView<ColumnarView>>;
+
   ProtobufObjectsDeserializer<::proto::MarketOrderBook, MarketOrderBookConverter> _marketOrderBookDeserializer;
   ProtobufObjectsDeserializer<::proto::PublicTrade, PublicTradeConverter> _publicTradeDeserializer;
+  ColumnarViewsMap<ColumnarMarketOrderBooksView> _marketOrderBooksColumnarViews;
+  ColumnarViewsMap<ColumnarPublicTradesView> _publicTradesColumnarViews;
 };
 
 }  // namespace cct
\ No newline at end of file
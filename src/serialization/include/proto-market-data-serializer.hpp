@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <span>
 #include <string_view>
 
@@ -7,6 +9,7 @@
 #include "market-order-book.pb.h"
 #include "market-timestamp-set.hpp"
 #include "market.hpp"
+#include "proto-market-order-book-converter.hpp"
 #include "proto-public-trade-compare.hpp"
 #include "proto-serializer.hpp"
 #include "public-trade.pb.h"
@@ -14,21 +17,32 @@
 
 namespace cct {
 
+class AbstractMetricGateway;
 class MarketOrderBook;
 
 /// This class is responsible of managing the periodic writes to disk of timed market data, for a given exchange.
 /// This class is not thread safe
 class ProtoMarketDataSerializer : public AbstractMarketDataSerializer {
  public:
+  /// @param writeQueueSize if strictly positive, market data is written asynchronously by dedicated writer threads,
+  /// with at most this number of full buffers waiting to be written per data type.
+  /// @param memoryBudgetInBytes if strictly positive, maximum serialized size of the buffered market data, shared
+  /// equally between order books and trades.
+  /// @param pMetricGateway if not null, the size of the buffered market data and the statistics of the writer threads
+  /// are exported to it
   ProtoMarketDataSerializer(std::string_view dataDir, const MarketTimestampSets &lastWrittenObjectsMarketTimestamp,
-                            std::string_view exchangeName);
+                            std::string_view exchangeName, int32_t writeQueueSize = 0, int64_t memoryBudgetInBytes = 0,
+                            AbstractMetricGateway *pMetricGateway = nullptr);
 
   void push(const MarketOrderBook &marketOrderBook) override;
 
   void push(Market market, std::span<const PublicTrade> publicTrades) override;
 
  private:
-  ProtobufObjectsSerializer<::proto::MarketOrderBook> _marketOrderBookSerializer;
+  // Market order books are written as key frames and deltas, as consecutive order books are usually very similar
+  ProtobufObjectsSerializer<::proto::MarketOrderBook, void, void, 1000, std::chrono::days, 3,
+                            MarketOrderBookDeltaEncoder>
+      _marketOrderBookSerializer;
   ProtobufObjectsSerializer<::proto::PublicTrade, ProtoPublicTradeComp, ProtoPublicTradeEqual> _tradesSerializer;
 };
 
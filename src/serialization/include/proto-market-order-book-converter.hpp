@@ -8,13 +8,61 @@ namespace cct {
 
 ::proto::MarketOrderBook ConvertMarketOrderBookToProto(const MarketOrderBook &marketOrderBook);
 
+/// Encodes a sequence of market order books as a full key frame every 'keyFrameInterval' order books, and as price
+/// level differences with the previous order book in between.
+/// Consecutive order books usually differ by a few levels only, so this saves disk space, compression time and decoding
+/// time. A key frame is also written when the delta would not be smaller than the full order book.
+class MarketOrderBookDeltaEncoder {
+ public:
+  static constexpr int kDefaultKeyFrameInterval = 100;
+
+  explicit MarketOrderBookDeltaEncoder(int keyFrameInterval = kDefaultKeyFrameInterval)
+      : _keyFrameInterval(keyFrameInterval) {}
+
+  /// Forces next encoded order book to be a key frame.
+  /// Should be called at the start of each sequence that should be decodable independently.
+  void reset() noexcept { _pPrevious = nullptr; }
+
+  /// Returns the message to write for given full order book, which is either given order book itself (key frame) or a
+  /// delta encoded message, valid until next call.
+  /// Given order book should stay alive until the next call to 'encode' or 'reset'.
+  const ::proto::MarketOrderBook &encode(const ::proto::MarketOrderBook &marketOrderBook);
+
+ private:
+  ::proto::MarketOrderBook _delta;
+  const ::proto::MarketOrderBook *_pPrevious{};
+  int _keyFrameInterval;
+  int _nbDeltasSinceKeyFrame{};
+};
+
+/// Rebuilds full order books from messages written by a MarketOrderBookDeltaEncoder.
+/// Messages are expected to be given in the order they have been written, starting from a key frame.
+/// Messages written before the introduction of the delta encoding are all key frames.
+class MarketOrderBookDeltaDecoder {
+ public:
+  /// Transforms given message into a full order book if it is delta encoded.
+  /// Returns false if the message cannot be decoded (delta without any preceding key frame).
+  bool decode(::proto::MarketOrderBook &marketOrderBook);
+
+ private:
+  ::proto::MarketOrderBook _previous;
+  bool _hasPrevious{};
+};
+
 class MarketOrderBookConverter {
  public:
   explicit MarketOrderBookConverter(Market market) : _market(market) {}
 
+  /// Rebuilds the full order book of given message if it is delta encoded.
+  /// Should be called for all messages, in order, before the conversion.
+  bool decode(::proto::MarketOrderBook &marketOrderBookTimedData) {
+    return _deltaDecoder.decode(marketOrderBookTimedData);
+  }
+
   MarketOrderBook operator()(const ::proto::MarketOrderBook &marketOrderBookTimedData);
 
  private:
+  MarketOrderBookDeltaDecoder _deltaDecoder;
   Market _market;
 };
 
@@ -8,17 +8,22 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 
+#include "background-write-queue.hpp"
 #include "cct_exception.hpp"
 #include "cct_log.hpp"
 #include "cct_vector.hpp"
 #include "durationstring.hpp"
 #include "market-timestamp-set.hpp"
 #include "market.hpp"
+#include "metric-handles.hpp"
+#include "proto-hour-file-index.hpp"
 #include "proto-multiple-messages-handler.hpp"
 #include "serialization-tools.hpp"
 #include "stringconv.hpp"
@@ -26,25 +31,60 @@
 
 namespace cct {
 
+/// Default encoder of ProtobufObjectsSerializer, writing the objects as is.
+template <class ProtobufObjectType>
+class ProtobufObjectsIdentityEncoder {
+ public:
+  void reset() noexcept {}
+
+  const ProtobufObjectType &encode(const ProtobufObjectType &protobufObject) const noexcept { return protobufObject; }
+};
+
 /// Class responsible to accumulate protobuf objects in memory and perform regular flushes of its data to the disk.
 /// Data is accumulated by Market and will write to following files (from subPath):
 ///  'BASECUR-QUOTECUR/YYYY/MM/DD/HH:00:00_HH:59:59.binpb'
+/// Each hour file comes with a sidecar index file (see ProtoHourFileIndex) allowing fast reads.
 ///
 /// If you may push duplicated objects, you have to provide Comp and Equal types.
 /// In this case, Equal must be consistent with Comp, and the first criteria of the comparison should be the timestamp
 /// (ordered from oldest to youngest).
 ///
 /// You may not provide any Comp and Equal if by design you will not push duplicated data.
+///
+/// Encoder allows to write objects differently on disk (for instance, relatively to the previous one).
+/// It is reset at the start of each compressed block, so that each block can be decoded independently.
+///
+/// By default, writes are done synchronously in the thread pushing the objects. In asynchronous mode, full buffers are
+/// handed over to a dedicated writer thread (see BackgroundWriteQueue) which sorts, compresses and writes them, while
+/// the pushing thread continues to fill a new buffer.
+///
+/// A global memory budget can be set for all markets, based on the serialized size of the buffered objects. When it is
+/// exceeded, buffers of the least recently flushed markets are written to disk until the budget is respected again.
+/// In asynchronous mode, objects waiting to be written by the writer thread are counted in the budget as well.
 template <class ProtobufObjectType, class Comp = void, class Equal = void, int32_t RehashThreshold = 1000,
-          class DurationType = std::chrono::days, int32_t DurationValue = 3>
+          class DurationType = std::chrono::days, int32_t DurationValue = 3,
+          class Encoder = ProtobufObjectsIdentityEncoder<ProtobufObjectType>>
 class ProtobufObjectsSerializer {
  public:
   /// Creates a new ProtobufObjectsSerializer.
   /// @param marketTimestampSet the latest written timestamp for all markets to avoid writing duplicate entries between
   /// coincenter restarts.
+  /// @param maxNbQueuedBatches if strictly positive, enables asynchronous mode with at most this number of buffers
+  /// waiting to be written by the writer thread. Pushes block when this limit is reached (backpressure).
+  /// @param memoryBudgetInBytes if strictly positive, maximum serialized size of the objects buffered for all markets
+  /// @param bufferedBytesGauge gauge updated with the serialized size of the objects buffered for all markets
+  /// @param writeQueueGauges gauges updated with the statistics of the writer thread queue, in asynchronous mode
   ProtobufObjectsSerializer(std::filesystem::path subPath, const MarketTimestampSet &marketTimestampSet,
-                            int32_t nbObjectsPerMarketInMemory)
-      : _subPath(std::move(subPath)), _nbObjectsPerMarketInMemory(nbObjectsPerMarketInMemory) {
+                            int32_t nbObjectsPerMarketInMemory, int32_t maxNbQueuedBatches = 0,
+                            int64_t memoryBudgetInBytes = 0, MetricGauge bufferedBytesGauge = MetricGauge{},
+                            BackgroundWriteQueue::Gauges writeQueueGauges = BackgroundWriteQueue::Gauges{})
+      : _subPath(std::move(subPath)),
+        _bufferedBytesGauge(bufferedBytesGauge),
+        _memoryBudgetInBytes(memoryBudgetInBytes),
+        _nbObjectsPerMarketInMemory(nbObjectsPerMarketInMemory) {
+    if (maxNbQueuedBatches > 0) {
+      _pWriteQueue = std::make_unique<BackgroundWriteQueue>(maxNbQueuedBatches, writeQueueGauges);
+    }
     for (const auto &[market, timestamp] : marketTimestampSet) {
       auto &lastWrittenObjectTimestamp = _marketDataMap[market].lastWrittenObjectTimestamp;
 
@@ -76,6 +116,7 @@ class ProtobufObjectsSerializer {
   }
 
   /// At destruction of the serializer, we try to write all remaining objects in the buffer (as best effort mode).
+  /// In asynchronous mode, destruction waits for the writer thread to write all queued buffers.
   ~ProtobufObjectsSerializer() {
     try {
       for (auto &[market, marketData] : _marketDataMap) {
@@ -84,6 +125,7 @@ class ProtobufObjectsSerializer {
     } catch (const std::exception &e) {
       log::error("exception caught in writeOnDisk at ProtobufObjectsSerializer destruction: {}", e.what());
     }
+    _pWriteQueue.reset();
   }
 
   /// Pushes a new object into the serializer.
@@ -96,19 +138,48 @@ class ProtobufObjectsSerializer {
       throw exception("Attempt to push proto object without any timestamp");
     }
 
-    auto &marketData = _marketDataMap[market];
+    auto [it, inserted] = _marketDataMap.try_emplace(market);
+    auto &marketData = it->second;
+    if (inserted) {
+      // new market is considered as just flushed, to not be evicted before the ones already buffering data
+      marketData.lastFlushSequence = ++_flushSequence;
+    }
     if (TimePoint{milliseconds{protoObj.unixtimestampinms()}} < marketData.lastWrittenObjectTimestamp) {
       // do not push an object that has an older timestamp of the last written object
       return;
     }
 
+    const auto nbBytes = static_cast<int64_t>(protoObj.ByteSizeLong());
+
     marketData.dataVector.push_back(std::forward<ProtobufObjectTypeU>(protoObj));
+    marketData.nbBufferedBytes += nbBytes;
+    _nbBufferedBytes += nbBytes;
 
     checkWriteOnDisk(market, marketData);
+
+    checkMemoryBudget();
+
+    _bufferedBytesGauge.set(static_cast<double>(_nbBufferedBytes));
+  }
+
+  /// Get the serialized size of the objects currently buffered for all markets.
+  int64_t nbBufferedBytes() const { return _nbBufferedBytes; }
+
+  /// Get the serialized size of the objects handed over to the writer thread and not written yet.
+  int64_t nbQueuedBytes() const { return _pWriteQueue ? _pWriteQueue->nbQueuedBytes() : 0; }
+
+  /// Get the statistics of the writer thread queue (all zero in synchronous mode).
+  BackgroundWriteQueue::Stats writeQueueStats() const {
+    return _pWriteQueue ? _pWriteQueue->stats() : BackgroundWriteQueue::Stats{};
   }
 
   void swap(ProtobufObjectsSerializer &rhs) noexcept {
     _marketDataMap.swap(rhs._marketDataMap);
+    _pWriteQueue.swap(rhs._pWriteQueue);
+    std::swap(_bufferedBytesGauge, rhs._bufferedBytesGauge);
+    std::swap(_memoryBudgetInBytes, rhs._memoryBudgetInBytes);
+    std::swap(_nbBufferedBytes, rhs._nbBufferedBytes);
+    std::swap(_flushSequence, rhs._flushSequence);
     _subPath.swap(rhs._subPath);
     std::swap(_nbObjectsPerMarketInMemory, rhs._nbObjectsPerMarketInMemory);
     std::swap(_flushCounter, rhs._flushCounter);
@@ -120,6 +191,8 @@ class ProtobufObjectsSerializer {
   struct MarketData {
     ProtobufObjectTypeVector dataVector;
     TimePoint lastWrittenObjectTimestamp;
+    int64_t nbBufferedBytes{};
+    uint64_t lastFlushSequence{};
   };
 
   void checkWriteOnDisk(Market market, MarketData &marketData) {
@@ -127,9 +200,14 @@ class ProtobufObjectsSerializer {
     if (dataVector.size() == static_cast<ProtobufObjectTypeVector::size_type>(_nbObjectsPerMarketInMemory)) {
       writeOnDisk(market, marketData);
 
-      // shrink_to_fit as vector will never grow-up larger than its current size
-      dataVector.shrink_to_fit();
-      dataVector.clear();
+      if (_pWriteQueue) {
+        // full buffer has been handed over to the writer thread, start filling a new one
+        dataVector.reserve(_nbObjectsPerMarketInMemory);
+      } else {
+        // shrink_to_fit as vector will never grow-up larger than its current size
+        dataVector.shrink_to_fit();
+        dataVector.clear();
+      }
 
       checkPeriodicFlush();
     }
@@ -141,6 +219,34 @@ class ProtobufObjectsSerializer {
       return;
     }
 
+    const auto nbBytes = marketData.nbBufferedBytes;
+
+    _nbBufferedBytes -= nbBytes;
+    marketData.nbBufferedBytes = 0;
+    marketData.lastFlushSequence = ++_flushSequence;
+
+    if (!_pWriteQueue) {
+      marketData.lastWrittenObjectTimestamp = WriteOnDisk(_subPath, market, dataVector);
+      return;
+    }
+
+    // Objects handed over to the writer thread are considered as written, as they are guaranteed to be at the latest
+    // at destruction of this serializer
+    const auto maxTimestampIt = std::ranges::max_element(
+        dataVector, [](const auto &lhs, const auto &rhs) { return lhs.unixtimestampinms() < rhs.unixtimestampinms(); });
+    marketData.lastWrittenObjectTimestamp = TimePoint{milliseconds{maxTimestampIt->unixtimestampinms()}};
+
+    _pWriteQueue->push(
+        [subPath = _subPath, market, batch = std::move(dataVector)]() mutable { WriteOnDisk(subPath, market, batch); },
+        nbBytes);
+
+    // moved-from vector is in a valid but unspecified state
+    dataVector.clear();
+  }
+
+  /// Sorts and writes given objects in their hour files, and returns the timestamp of the last written object.
+  static TimePoint WriteOnDisk(const std::filesystem::path &subPath, Market market,
+                               ProtobufObjectTypeVector &dataVector) {
     const auto nowTime = std::chrono::steady_clock::now();
 
     SortUnique(dataVector);
@@ -151,13 +257,27 @@ class ProtobufObjectsSerializer {
 
     ProtobufMessagesCompressedWriter<std::ofstream> protobufMessagesWriter;
 
+    vector<ProtoHourFileIndexEntry> indexEntries;
+
+    Encoder encoder;
+
     for (const auto &protobufObject : dataVector) {
-      checkOpenFile(market, protobufObject, prevHourOfDay, path, protobufMessagesWriter);
+      CheckOpenFile(subPath, market, protobufObject, prevHourOfDay, path, protobufMessagesWriter, indexEntries);
 
-      protobufMessagesWriter.write(protobufObject);
+      auto &indexEntry = indexEntries.back();
+      if (indexEntry.nbMessages == 0) {
+        // new compressed block
+        encoder.reset();
+        indexEntry.firstUnixTimestampInMs = protobufObject.unixtimestampinms();
+      }
+
+      protobufMessagesWriter.write(encoder.encode(protobufObject));
+
+      indexEntry.lastUnixTimestampInMs = protobufObject.unixtimestampinms();
+      ++indexEntry.nbMessages;
     }
 
-    marketData.lastWrittenObjectTimestamp = TimePoint{milliseconds{dataVector.back().unixtimestampinms()}};
+    CloseFile(path, protobufMessagesWriter, indexEntries);
 
     const auto nbElemsWritten = dataVector.size();
 
@@ -166,6 +286,43 @@ class ProtobufObjectsSerializer {
 
     log::info("Serialized {} object(s) for {} data in {}, last in {}", nbElemsWritten, market, DurationToString(dur),
               path.string());
+
+    return TimePoint{milliseconds{dataVector.back().unixtimestampinms()}};
+  }
+
+  // Writes the buffers of the least recently flushed markets until the memory budget is respected.
+  // In asynchronous mode, objects handed over to the writer thread still use memory until they are written, so they
+  // are counted in the budget as well, and waited for when needed.
+  void checkMemoryBudget() {
+    while (_memoryBudgetInBytes > 0 && _nbBufferedBytes + nbQueuedBytes() > _memoryBudgetInBytes) {
+      if (nbQueuedBytes() > 0) {
+        log::debug("Memory budget of {} bytes exceeded ({} bytes buffered, {} bytes queued), waiting for the writer",
+                   _memoryBudgetInBytes, _nbBufferedBytes, nbQueuedBytes());
+        _pWriteQueue->waitUntilEmpty();
+        continue;
+      }
+
+      auto lruIt = _marketDataMap.end();
+      for (auto it = _marketDataMap.begin(); it != _marketDataMap.end(); ++it) {
+        if (!it->second.dataVector.empty() &&
+            (lruIt == _marketDataMap.end() || it->second.lastFlushSequence < lruIt->second.lastFlushSequence)) {
+          lruIt = it;
+        }
+      }
+      if (lruIt == _marketDataMap.end()) {
+        break;
+      }
+
+      const Market market = lruIt->first;
+      MarketData &marketData = lruIt->second;
+
+      log::debug("Memory budget of {} bytes exceeded ({} bytes), evicting {} bytes of {}", _memoryBudgetInBytes,
+                 _nbBufferedBytes, marketData.nbBufferedBytes, market);
+
+      writeOnDisk(market, marketData);
+
+      marketData.dataVector.clear();
+    }
   }
 
   // Periodic memory release to avoid possible leaks for long time running (if market data unused anymore for instance)
@@ -218,20 +375,27 @@ class ProtobufObjectsSerializer {
     }
   }
 
-  void checkOpenFile(Market market, const ProtobufObjectType &protobufObject, std::chrono::hours &prevHourOfDay,
-                     std::filesystem::path &path,
-                     ProtobufMessagesCompressedWriter<std::ofstream> &protobufMessagesWriter) {
+  static void CheckOpenFile(const std::filesystem::path &subPath, Market market,
+                            const ProtobufObjectType &protobufObject, std::chrono::hours &prevHourOfDay,
+                            std::filesystem::path &path,
+                            ProtobufMessagesCompressedWriter<std::ofstream> &protobufMessagesWriter,
+                            vector<ProtoHourFileIndexEntry> &indexEntries) {
     const TimePoint tp{milliseconds{protobufObject.unixtimestampinms()}};
     const auto hourOfDay = GetHourOfDay(tp);
 
     if (prevHourOfDay != hourOfDay) {
+      CloseFile(path, protobufMessagesWriter, indexEntries);
+
       // open new outfile
-      setDirectory(market.str(), tp, path);
+      SetDirectory(subPath, market.str(), tp, path);
 
       std::filesystem::create_directories(path);
 
       path /= ComputeProtoFileName(std::chrono::duration_cast<std::chrono::hours>(hourOfDay).count());
 
+      std::error_code ec;
+      const auto fileSize = std::filesystem::file_size(path, ec);
+
       std::ofstream ofs(path, std::ios_base::out | std::ios::binary | std::ios_base::app);
 
       if (!ofs.is_open()) {
@@ -241,7 +405,39 @@ class ProtobufObjectsSerializer {
 
       protobufMessagesWriter.open(std::move(ofs));
       prevHourOfDay = hourOfDay;
+
+      indexEntries.emplace_back().beginOffset = ec ? 0 : static_cast<uint64_t>(fileSize);
+    } else if (indexEntries.back().nbMessages == ProtoHourFileIndex::kNbMessagesPerBlock) {
+      // Start a new compressed block in the same file, so that readers can seek to it directly
+      protobufMessagesWriter.open(EndBlock(path, protobufMessagesWriter, indexEntries.back()));
+
+      const auto newBlockBeginOffset = indexEntries.back().endOffset;
+      indexEntries.emplace_back().beginOffset = newBlockBeginOffset;
+    }
+  }
+
+  /// Terminates the current compressed block and returns the file stream to allow writing of a new block.
+  static std::ofstream EndBlock(const std::filesystem::path &path,
+                                ProtobufMessagesCompressedWriter<std::ofstream> &protobufMessagesWriter,
+                                ProtoHourFileIndexEntry &indexEntry) {
+    std::ofstream ofs = protobufMessagesWriter.flush();
+    ofs.flush();
+    indexEntry.endOffset = static_cast<uint64_t>(std::filesystem::file_size(path));
+    return ofs;
+  }
+
+  static void CloseFile(const std::filesystem::path &path,
+                        ProtobufMessagesCompressedWriter<std::ofstream> &protobufMessagesWriter,
+                        vector<ProtoHourFileIndexEntry> &indexEntries) {
+    if (indexEntries.empty()) {
+      return;
     }
+
+    EndBlock(path, protobufMessagesWriter, indexEntries.back());
+
+    ProtoHourFileIndex::Append(path, indexEntries);
+
+    indexEntries.clear();
   }
 
   static std::chrono::hours GetHourOfDay(TimePoint tp) {
@@ -250,11 +446,12 @@ class ProtobufObjectsSerializer {
     return std::chrono::floor<std::chrono::hours>(tp - dp);
   }
 
-  void setDirectory(std::string_view marketStr, TimePoint tp, std::filesystem::path &path) {
+  static void SetDirectory(const std::filesystem::path &subPath, std::string_view marketStr, TimePoint tp,
+                           std::filesystem::path &path) {
     const auto dp = std::chrono::floor<std::chrono::days>(tp);
     const std::chrono::year_month_day ymd{dp};
 
-    path = _subPath / marketStr;
+    path = subPath / marketStr;
     path /= std::string_view(IntegralToCharVector(static_cast<int>(ymd.year())));
     path /= MonthStr(static_cast<unsigned int>(ymd.month()));
     path /= DayOfMonthStr(static_cast<unsigned int>(ymd.day()));
@@ -264,6 +461,11 @@ class ProtobufObjectsSerializer {
 
   MarketDataMap _marketDataMap;
   std::filesystem::path _subPath;
+  std::unique_ptr<BackgroundWriteQueue> _pWriteQueue;
+  MetricGauge _bufferedBytesGauge;
+  int64_t _memoryBudgetInBytes{};
+  int64_t _nbBufferedBytes{};
+  uint64_t _flushSequence{};
   int32_t _nbObjectsPerMarketInMemory;
   int32_t _flushCounter{};
 };
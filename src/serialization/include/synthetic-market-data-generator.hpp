@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "market.hpp"
+#include "monetaryamount.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Generates realistic synthetic market data of a market (order books and public trades) and writes it to disk with
+/// ProtoMarketDataSerializer, in the same layout as captured data ('BASE-QUOTE/YYYY/MM/DD/HH' files).
+/// It allows to replay and benchmark the replay without any captured data.
+///
+/// The mid price follows a geometric random walk, order books have a random spread and random gaps between their
+/// price levels, and public trades follow a Poisson process, matching the best price of the order book side they hit.
+/// Generation is deterministic for a given configuration.
+class SyntheticMarketDataGenerator {
+ public:
+  struct Config {
+    Market market{"BTC", "USDT"};
+    /// Initial mid price, in quote currency of the market
+    MonetaryAmount startMidPrice{30000};
+    TimeWindow timeWindow;
+    Duration marketOrderBookPeriod{std::chrono::seconds(1)};
+    /// Number of price levels of each side of the order books
+    int32_t depth{20};
+    /// Mean number of public trades per second. Capped to one trade per millisecond.
+    double nbTradesPerSecond{5};
+    /// Standard deviation of the relative variation of the mid price between two consecutive order books
+    double volatility{0.0001};
+    int8_t priceNbDecimals{2};
+    int8_t volumeNbDecimals{6};
+    uint64_t seed{42};
+  };
+
+  struct Stats {
+    int64_t nbMarketOrderBooks{};
+    int64_t nbPublicTrades{};
+  };
+
+  explicit SyntheticMarketDataGenerator(const Config &config);
+
+  /// Generates the market data of the configured time window and writes it in the serialized data directory of given
+  /// exchange, inside 'dataDir'.
+  Stats generate(std::string_view dataDir, std::string_view exchangeName) const;
+
+ private:
+  Config _config;
+};
+
+}  // namespace cct
@@ -0,0 +1,111 @@
+#include "background-write-queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "cct_invalid_argument_exception.hpp"
+#include "cct_log.hpp"
+#include "durationstring.hpp"
+#include "metric-handles.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+BackgroundWriteQueue::BackgroundWriteQueue(int32_t maxNbQueuedTasks, Gauges gauges)
+    : _gauges(gauges), _maxNbQueuedTasks(maxNbQueuedTasks) {
+  if (_maxNbQueuedTasks <= 0) {
+    throw invalid_argument("Background write queue size should be strictly positive");
+  }
+  _writerThread = std::jthread([this] { run(); });
+}
+
+BackgroundWriteQueue::~BackgroundWriteQueue() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _taskPushedCondition.notify_one();
+  _writerThread.join();
+
+  log::debug("Background write queue stopped after {} task(s), max depth {}, {} backpressure wait(s) for {}",
+             _stats.nbExecutedTasks, _stats.maxQueueDepth, _stats.nbBackpressureWaits,
+             DurationToString(_stats.backpressureWaitDuration));
+}
+
+void BackgroundWriteQueue::push(Task task, int64_t nbBytes) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  if (_stats.queueDepth == _maxNbQueuedTasks) {
+    const auto waitStartTime = Clock::now();
+    _taskExecutedCondition.wait(lock, [this] { return _stats.queueDepth < _maxNbQueuedTasks; });
+    const auto waitDuration = std::chrono::duration_cast<Duration>(Clock::now() - waitStartTime);
+
+    ++_stats.nbBackpressureWaits;
+    _stats.backpressureWaitDuration += waitDuration;
+    _gauges.nbBackpressureWaits.set(static_cast<double>(_stats.nbBackpressureWaits));
+    _gauges.backpressureWaitDurationInMs.set(
+        static_cast<double>(std::chrono::duration_cast<milliseconds>(_stats.backpressureWaitDuration).count()));
+    log::debug("Waited {} for background writes to catch up", DurationToString(waitDuration));
+  }
+
+  _tasks.push_back(QueuedTask{std::move(task), nbBytes});
+  _nbQueuedBytes += nbBytes;
+  ++_stats.nbPushedTasks;
+  ++_stats.queueDepth;
+  _stats.maxQueueDepth = std::max(_stats.maxQueueDepth, _stats.queueDepth);
+  _gauges.queueDepth.set(_stats.queueDepth);
+  _gauges.maxQueueDepth.set(_stats.maxQueueDepth);
+
+  lock.unlock();
+  _taskPushedCondition.notify_one();
+}
+
+void BackgroundWriteQueue::waitUntilEmpty() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _taskExecutedCondition.wait(lock, [this] { return _stats.queueDepth == 0; });
+}
+
+BackgroundWriteQueue::Stats BackgroundWriteQueue::stats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+void BackgroundWriteQueue::run() {
+  while (true) {
+    QueuedTask queuedTask;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _taskPushedCondition.wait(lock, [this] { return _stop || !_tasks.empty(); });
+      if (_tasks.empty()) {
+        // Stop requested and all tasks executed
+        return;
+      }
+      // Task stays accounted in the queue depth until its execution is finished, so that waiters are notified after
+      queuedTask = std::move(_tasks.front());
+      _tasks.pop_front();
+    }
+
+    try {
+      queuedTask.task();
+    } catch (const std::exception &e) {
+      log::error("Exception caught in background write task: {}", e.what());
+    }
+
+    // Releases the data held by the task before it stops being accounted in the queued bytes
+    queuedTask.task = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      --_stats.queueDepth;
+      ++_stats.nbExecutedTasks;
+      _nbQueuedBytes -= queuedTask.nbBytes;
+      _gauges.queueDepth.set(_stats.queueDepth);
+    }
+    _taskExecutedCondition.notify_all();
+  }
+}
+
+}  // namespace cct
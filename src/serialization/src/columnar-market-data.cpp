@@ -0,0 +1,408 @@
+#include "columnar-market-data.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "market-order-book-vector.hpp"
+#include "market-order-book.pb.h"
+#include "market.hpp"
+#include "marketorderbook.hpp"
+#include "memory-mapped-file.hpp"
+#include "monetaryamount.hpp"
+#include "proto-constants.hpp"
+#include "public-trade-vector.hpp"
+#include "public-trade.pb.h"
+#include "publictrade.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+#include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct {
+
+namespace {
+
+constexpr std::size_t kAlignment = 8;
+
+constexpr std::size_t Align(std::size_t pos) { return (pos + kAlignment - 1U) & ~(kAlignment - 1U); }
+
+/// Computes the successive positions of the arrays in a columnar file.
+/// Writer and reader share this logic to guarantee the same layout.
+class ColumnarLayout {
+ public:
+  template <class T>
+  std::size_t next(std::size_t nbElems) {
+    const auto pos = _pos;
+    _pos = Align(_pos + (nbElems * sizeof(T)));
+    return pos;
+  }
+
+  std::size_t totalSize() const { return _pos; }
+
+ private:
+  std::size_t _pos = Align(sizeof(ColumnarFileHeader));
+};
+
+class ColumnarFileWriter {
+ public:
+  ColumnarFileWriter(const std::filesystem::path &filePath, ProtobufObject protobufObject, uint64_t nbRecords,
+                     uint64_t nbLevels = 0)
+      : _filePath(filePath), _tmpFilePath(filePath) {
+    _tmpFilePath += ".tmp";
+
+    _ofs.open(_tmpFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!_ofs.is_open()) {
+      throw exception("Cannot open {} for writing: {} (code {})", _tmpFilePath.string(), std::strerror(errno), errno);
+    }
+
+    ColumnarFileHeader header;
+    header.objectType = static_cast<uint32_t>(protobufObject);
+    header.nbRecords = nbRecords;
+    header.nbLevels = nbLevels;
+
+    _ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    _pos = sizeof(header);
+    pad();
+  }
+
+  void write(details::ColumnarFileColumn &column) {
+    _pos += column.copyTo(_ofs);
+    pad();
+  }
+
+  /// Flushes the data and replaces the final file by the temporary one.
+  void commit() {
+    _ofs.close();
+    if (!_ofs) {
+      throw exception("Error while writing {}", _tmpFilePath.string());
+    }
+    std::filesystem::rename(_tmpFilePath, _filePath);
+  }
+
+ private:
+  void pad() {
+    static constexpr char kZeros[kAlignment]{};
+    const auto alignedPos = Align(_pos);
+    _ofs.write(kZeros, static_cast<std::streamsize>(alignedPos - _pos));
+    _pos = alignedPos;
+  }
+
+  std::filesystem::path _filePath;
+  std::filesystem::path _tmpFilePath;
+  std::ofstream _ofs;
+  std::size_t _pos{};
+};
+
+/// Checks the header of a mapped columnar file and returns it, or nullptr if the file is not usable.
+const ColumnarFileHeader *ValidateHeader(const MemoryMappedFile &memoryMappedFile,
+                                         const std::filesystem::path &filePath, ProtobufObject protobufObject) {
+  const auto data = memoryMappedFile.data();
+  if (data.size() < sizeof(ColumnarFileHeader)) {
+    log::error("Columnar file {} is too small ({} bytes), ignoring it", filePath.string(), data.size());
+    return nullptr;
+  }
+  const auto *pHeader = reinterpret_cast<const ColumnarFileHeader *>(data.data());
+  if (pHeader->magic != ColumnarFileHeader::kMagic || pHeader->byteOrderMark != ColumnarFileHeader::kByteOrderMark) {
+    log::error("Columnar file {} has an invalid header, ignoring it", filePath.string());
+    return nullptr;
+  }
+  if (pHeader->version != ColumnarFileHeader::kVersion) {
+    log::error("Columnar file {} has unsupported version {}, ignoring it", filePath.string(), pHeader->version);
+    return nullptr;
+  }
+  if (pHeader->objectType != static_cast<uint32_t>(protobufObject)) {
+    log::error("Columnar file {} has unexpected object type {}, ignoring it", filePath.string(), pHeader->objectType);
+    return nullptr;
+  }
+  return pHeader;
+}
+
+template <class T>
+std::span<const T> ArrayAt(const MemoryMappedFile &memoryMappedFile, std::size_t pos, std::size_t nbElems) {
+  return {reinterpret_cast<const T *>(memoryMappedFile.data().data() + pos), nbElems};
+}
+
+auto TimeWindowPositions(std::span<const int64_t> timestamps, TimeWindow timeWindow) {
+  const auto fromTs = TimestampToMillisecondsSinceEpoch(timeWindow.from());
+  const auto toTs = TimestampToMillisecondsSinceEpoch(timeWindow.to());
+
+  const auto firstIt = std::ranges::lower_bound(timestamps, fromTs);
+  const auto lastIt = std::ranges::lower_bound(firstIt, timestamps.end(), toTs);
+
+  return std::make_pair(static_cast<std::size_t>(firstIt - timestamps.begin()),
+                        static_cast<std::size_t>(lastIt - timestamps.begin()));
+}
+
+void CheckSortedTimestamps(bool isSorted, const std::filesystem::path &filePath) {
+  if (!isSorted) {
+    throw exception("Cannot write columnar file {} from unsorted objects", filePath.string());
+  }
+}
+
+}  // namespace
+
+namespace details {
+
+ColumnarFileColumn::ColumnarFileColumn(const std::filesystem::path &columnarFilePath, std::string_view columnName)
+    : _tmpFilePath(columnarFilePath) {
+  _tmpFilePath += '.';
+  _tmpFilePath += columnName;
+  _tmpFilePath += ".tmp";
+
+  _ofs.open(_tmpFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!_ofs.is_open()) {
+    throw exception("Cannot open {} for writing: {} (code {})", _tmpFilePath.string(), std::strerror(errno), errno);
+  }
+}
+
+ColumnarFileColumn::~ColumnarFileColumn() {
+  _ofs.close();
+  std::error_code ec;
+  std::filesystem::remove(_tmpFilePath, ec);
+}
+
+std::size_t ColumnarFileColumn::copyTo(std::ostream &os) {
+  _ofs.close();
+  if (!_ofs) {
+    throw exception("Error while writing {}", _tmpFilePath.string());
+  }
+
+  const auto nbBytes = static_cast<std::size_t>(std::filesystem::file_size(_tmpFilePath));
+  if (nbBytes != 0) {
+    // streaming an empty buffer would set the failbit of the output stream
+    std::ifstream ifs(_tmpFilePath, std::ios_base::in | std::ios_base::binary);
+    os << ifs.rdbuf();
+  }
+  return nbBytes;
+}
+
+}  // namespace details
+
+ColumnarMarketOrderBooksBuilder::ColumnarMarketOrderBooksBuilder(const std::filesystem::path &filePath)
+    : _filePath(filePath),
+      _timestamps(filePath, "timestamps"),
+      _levelsOffsets(filePath, "levelsOffsets"),
+      _nbBids(filePath, "nbBids"),
+      _volumeNbDecimals(filePath, "volumeNbDecimals"),
+      _priceNbDecimals(filePath, "priceNbDecimals"),
+      _prices(filePath, "prices"),
+      _volumes(filePath, "volumes") {
+  _levelsOffsets.append(uint64_t{});
+}
+
+void ColumnarMarketOrderBooksBuilder::append(const ::proto::MarketOrderBook &marketOrderBook) {
+  const auto &bids = marketOrderBook.orderbook().bids();
+  const auto &asks = marketOrderBook.orderbook().asks();
+  const int64_t timestamp = marketOrderBook.unixtimestampinms();
+
+  _isSorted = _isSorted && (_nbRecords == 0 || _lastTimestamp <= timestamp);
+  _lastTimestamp = timestamp;
+  ++_nbRecords;
+
+  _timestamps.append(timestamp);
+  _nbBids.append(static_cast<uint32_t>(bids.size()));
+  _volumeNbDecimals.append(static_cast<int8_t>(marketOrderBook.volumenbdecimals()));
+  _priceNbDecimals.append(static_cast<int8_t>(marketOrderBook.pricenbdecimals()));
+
+  // bids are stored from the highest price in the protobuf object
+  for (const auto &bid : std::ranges::reverse_view(bids)) {
+    _prices.append(static_cast<int64_t>(bid.price()));
+    _volumes.append(static_cast<int64_t>(bid.volume()));
+  }
+  for (const auto &ask : asks) {
+    _prices.append(static_cast<int64_t>(ask.price()));
+    _volumes.append(static_cast<int64_t>(ask.volume()));
+  }
+
+  _nbLevels += static_cast<std::size_t>(bids.size() + asks.size());
+  _levelsOffsets.append(static_cast<uint64_t>(_nbLevels));
+}
+
+void ColumnarMarketOrderBooksBuilder::write() {
+  CheckSortedTimestamps(_isSorted, _filePath);
+
+  ColumnarFileWriter writer(_filePath, ProtobufObject::kMarketOrderBook, _nbRecords, _nbLevels);
+
+  writer.write(_timestamps);
+  writer.write(_levelsOffsets);
+  writer.write(_nbBids);
+  writer.write(_volumeNbDecimals);
+  writer.write(_priceNbDecimals);
+  writer.write(_prices);
+  writer.write(_volumes);
+
+  writer.commit();
+}
+
+ColumnarPublicTradesBuilder::ColumnarPublicTradesBuilder(const std::filesystem::path &filePath)
+    : _filePath(filePath),
+      _timestamps(filePath, "timestamps"),
+      _prices(filePath, "prices"),
+      _volumes(filePath, "volumes"),
+      _priceNbDecimals(filePath, "priceNbDecimals"),
+      _volumeNbDecimals(filePath, "volumeNbDecimals"),
+      _tradeSides(filePath, "tradeSides") {}
+
+void ColumnarPublicTradesBuilder::append(const ::proto::PublicTrade &publicTrade) {
+  const int64_t timestamp = publicTrade.unixtimestampinms();
+
+  _isSorted = _isSorted && (_nbRecords == 0 || _lastTimestamp <= timestamp);
+  _lastTimestamp = timestamp;
+  ++_nbRecords;
+
+  _timestamps.append(timestamp);
+  _prices.append(static_cast<int64_t>(publicTrade.priceamount()));
+  _volumes.append(static_cast<int64_t>(publicTrade.volumeamount()));
+  _priceNbDecimals.append(static_cast<int8_t>(publicTrade.pricenbdecimals()));
+  _volumeNbDecimals.append(static_cast<int8_t>(publicTrade.volumenbdecimals()));
+  _tradeSides.append(static_cast<int8_t>(publicTrade.tradeside() == ::proto::TRADE_BUY ? TradeSide::buy
+                                                                                         : TradeSide::sell));
+}
+
+void ColumnarPublicTradesBuilder::write() {
+  CheckSortedTimestamps(_isSorted, _filePath);
+
+  ColumnarFileWriter writer(_filePath, ProtobufObject::kTrade, _nbRecords);
+
+  writer.write(_timestamps);
+  writer.write(_prices);
+  writer.write(_volumes);
+  writer.write(_priceNbDecimals);
+  writer.write(_volumeNbDecimals);
+  writer.write(_tradeSides);
+
+  writer.commit();
+}
+
+ColumnarMarketOrderBooksView::ColumnarMarketOrderBooksView(const std::filesystem::path &filePath, Market market)
+    : _market(market) {
+  if (!std::filesystem::exists(filePath)) {
+    return;
+  }
+  MemoryMappedFile memoryMappedFile(filePath);
+  const ColumnarFileHeader *pHeader = ValidateHeader(memoryMappedFile, filePath, ProtobufObject::kMarketOrderBook);
+  if (pHeader == nullptr) {
+    return;
+  }
+  const auto nbRecords = static_cast<std::size_t>(pHeader->nbRecords);
+  const auto nbLevels = static_cast<std::size_t>(pHeader->nbLevels);
+
+  ColumnarLayout layout;
+  const auto timestampsPos = layout.next<int64_t>(nbRecords);
+  const auto levelsOffsetsPos = layout.next<uint64_t>(nbRecords + 1U);
+  const auto nbBidsPos = layout.next<uint32_t>(nbRecords);
+  const auto volumeNbDecimalsPos = layout.next<int8_t>(nbRecords);
+  const auto priceNbDecimalsPos = layout.next<int8_t>(nbRecords);
+  const auto pricesPos = layout.next<int64_t>(nbLevels);
+  const auto volumesPos = layout.next<int64_t>(nbLevels);
+
+  if (layout.totalSize() > memoryMappedFile.size()) {
+    log::error("Columnar file {} is truncated, ignoring it", filePath.string());
+    return;
+  }
+
+  _memoryMappedFile = std::move(memoryMappedFile);
+
+  _timestamps = ArrayAt<int64_t>(_memoryMappedFile, timestampsPos, nbRecords);
+  _levelsOffsets = ArrayAt<uint64_t>(_memoryMappedFile, levelsOffsetsPos, nbRecords + 1U);
+  _nbBids = ArrayAt<uint32_t>(_memoryMappedFile, nbBidsPos, nbRecords);
+  _volumeNbDecimals = ArrayAt<int8_t>(_memoryMappedFile, volumeNbDecimalsPos, nbRecords);
+  _priceNbDecimals = ArrayAt<int8_t>(_memoryMappedFile, priceNbDecimalsPos, nbRecords);
+  _prices = ArrayAt<int64_t>(_memoryMappedFile, pricesPos, nbLevels);
+  _volumes = ArrayAt<int64_t>(_memoryMappedFile, volumesPos, nbLevels);
+}
+
+MarketOrderBookVector ColumnarMarketOrderBooksView::load(TimeWindow timeWindow) const {
+  const auto [firstPos, lastPos] = TimeWindowPositions(_timestamps, timeWindow);
+
+  MarketOrderBookVector marketOrderBooks;
+  marketOrderBooks.reserve(lastPos - firstPos);
+
+  for (auto pos = firstPos; pos < lastPos; ++pos) {
+    const auto levelsBeg = _levelsOffsets[pos];
+    const auto levelsEnd = _levelsOffsets[pos + 1U];
+    const auto nbBids = static_cast<int32_t>(_nbBids[pos]);
+
+    MarketOrderBook::AmountPriceVector orders;
+    orders.reserve(levelsEnd - levelsBeg);
+
+    for (auto levelPos = levelsBeg; levelPos < levelsEnd; ++levelPos) {
+      // asks are stored with negative amounts in MarketOrderBook
+      const bool isAsk = levelPos - levelsBeg >= static_cast<uint64_t>(nbBids);
+      orders.emplace_back(isAsk ? -_volumes[levelPos] : _volumes[levelPos], _prices[levelPos]);
+    }
+
+    marketOrderBooks.push_back(MarketOrderBook(TimePoint{milliseconds{_timestamps[pos]}}, _market, std::move(orders),
+                                               nbBids - 1, nbBids,
+                                               VolAndPriNbDecimals{_volumeNbDecimals[pos], _priceNbDecimals[pos]}));
+  }
+
+  return marketOrderBooks;
+}
+
+ColumnarPublicTradesView::ColumnarPublicTradesView(const std::filesystem::path &filePath, Market market)
+    : _market(market) {
+  if (!std::filesystem::exists(filePath)) {
+    return;
+  }
+  MemoryMappedFile memoryMappedFile(filePath);
+  const ColumnarFileHeader *pHeader = ValidateHeader(memoryMappedFile, filePath, ProtobufObject::kTrade);
+  if (pHeader == nullptr) {
+    return;
+  }
+  const auto nbRecords = static_cast<std::size_t>(pHeader->nbRecords);
+
+  ColumnarLayout layout;
+  const auto timestampsPos = layout.next<int64_t>(nbRecords);
+  const auto pricesPos = layout.next<int64_t>(nbRecords);
+  const auto volumesPos = layout.next<int64_t>(nbRecords);
+  const auto priceNbDecimalsPos = layout.next<int8_t>(nbRecords);
+  const auto volumeNbDecimalsPos = layout.next<int8_t>(nbRecords);
+  const auto tradeSidesPos = layout.next<int8_t>(nbRecords);
+
+  if (layout.totalSize() > memoryMappedFile.size()) {
+    log::error("Columnar file {} is truncated, ignoring it", filePath.string());
+    return;
+  }
+
+  _memoryMappedFile = std::move(memoryMappedFile);
+
+  _timestamps = ArrayAt<int64_t>(_memoryMappedFile, timestampsPos, nbRecords);
+  _prices = ArrayAt<int64_t>(_memoryMappedFile, pricesPos, nbRecords);
+  _volumes = ArrayAt<int64_t>(_memoryMappedFile, volumesPos, nbRecords);
+  _priceNbDecimals = ArrayAt<int8_t>(_memoryMappedFile, priceNbDecimalsPos, nbRecords);
+  _volumeNbDecimals = ArrayAt<int8_t>(_memoryMappedFile, volumeNbDecimalsPos, nbRecords);
+  _tradeSides = ArrayAt<int8_t>(_memoryMappedFile, tradeSidesPos, nbRecords);
+}
+
+PublicTradeVector ColumnarPublicTradesView::load(TimeWindow timeWindow) const {
+  const auto [firstPos, lastPos] = TimeWindowPositions(_timestamps, timeWindow);
+
+  PublicTradeVector publicTrades;
+  publicTrades.reserve(lastPos - firstPos);
+
+  for (auto pos = firstPos; pos < lastPos; ++pos) {
+    const MonetaryAmount amount(_volumes[pos], _market.base(), _volumeNbDecimals[pos]);
+    const MonetaryAmount price(_prices[pos], _market.quote(), _priceNbDecimals[pos]);
+
+    publicTrades.emplace_back(static_cast<TradeSide>(_tradeSides[pos]), amount, price,
+                              TimePoint{milliseconds{_timestamps[pos]}});
+  }
+
+  return publicTrades;
+}
+
+}  // namespace cct
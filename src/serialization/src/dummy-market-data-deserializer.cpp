@@ -28,4 +28,6 @@ PublicTradeVector DummyMarketDataDeserializer::pullTrades([[maybe_unused]] Marke
                                                           [[maybe_unused]] TimeWindow timeWindow) {
   return {};
 }
+
+int DummyMarketDataDeserializer::compactMarketData([[maybe_unused]] Market market) { return 0; }
 }  // namespace cct
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "dummy-market-data-serializer.hpp"
 
+#include <cstdint>
 #include <span>
 #include <string_view>
 
@@ -9,12 +10,14 @@
 
 namespace cct {
 
+class AbstractMetricGateway;
 class MarketOrderBook;
 
 DummyMarketDataSerializer::DummyMarketDataSerializer(
     [[maybe_unused]] std::string_view dataDir,
     [[maybe_unused]] const MarketTimestampSets &lastWrittenObjectsMarketTimestamp,
-    [[maybe_unused]] std::string_view exchangeName) {}
+    [[maybe_unused]] std::string_view exchangeName, [[maybe_unused]] int32_t writeQueueSize,
+    [[maybe_unused]] int64_t memoryBudgetInBytes, [[maybe_unused]] AbstractMetricGateway *pMetricGateway) {}
 
 void DummyMarketDataSerializer::push([[maybe_unused]] const MarketOrderBook &marketOrderBook) {}
 
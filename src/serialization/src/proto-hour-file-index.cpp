@@ -0,0 +1,89 @@
+#include "proto-hour-file-index.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <system_error>
+
+#include "cct_exception.hpp"
+#include "cct_log.hpp"
+#include "proto-constants.hpp"
+
+namespace cct {
+
+namespace {
+
+bool IsConsistent(std::span<const ProtoHourFileIndexEntry> entries, uint64_t hourFileSize) {
+  uint64_t expectedBeginOffset = 0;
+  for (const auto &entry : entries) {
+    if (entry.beginOffset != expectedBeginOffset || entry.endOffset < entry.beginOffset ||
+        entry.lastUnixTimestampInMs < entry.firstUnixTimestampInMs) {
+      return false;
+    }
+    expectedBeginOffset = entry.endOffset;
+  }
+  return expectedBeginOffset == hourFileSize;
+}
+
+}  // namespace
+
+std::filesystem::path ProtoHourFileIndex::IndexFilePath(const std::filesystem::path &hourFilePath) {
+  std::filesystem::path indexFilePath(hourFilePath);
+  indexFilePath.replace_extension(kBinIndexExtension);
+  return indexFilePath;
+}
+
+ProtoHourFileIndex::ProtoHourFileIndex(const std::filesystem::path &hourFilePath) {
+  const auto indexFilePath = IndexFilePath(hourFilePath);
+
+  std::error_code ec;
+  const auto indexFileSize = std::filesystem::file_size(indexFilePath, ec);
+  if (ec || indexFileSize == 0) {
+    return;
+  }
+  if (indexFileSize % sizeof(ProtoHourFileIndexEntry) != 0) {
+    log::warn("Ignoring index file {} with unexpected size {}", indexFilePath.string(), indexFileSize);
+    return;
+  }
+
+  const auto hourFileSize = std::filesystem::file_size(hourFilePath, ec);
+  if (ec) {
+    return;
+  }
+
+  _entries.resize(indexFileSize / sizeof(ProtoHourFileIndexEntry));
+
+  std::ifstream ifs(indexFilePath, std::ios_base::in | std::ios_base::binary);
+  ifs.read(reinterpret_cast<char *>(_entries.data()), static_cast<std::streamsize>(indexFileSize));
+
+  if (!ifs || !IsConsistent(_entries, hourFileSize)) {
+    log::debug("Ignoring index file {} not consistent with its data file", indexFilePath.string());
+    _entries.clear();
+  }
+}
+
+void ProtoHourFileIndex::Append(const std::filesystem::path &hourFilePath,
+                                std::span<const ProtoHourFileIndexEntry> entries) {
+  const auto indexFilePath = IndexFilePath(hourFilePath);
+
+  std::ofstream ofs(indexFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+  if (!ofs.is_open()) {
+    throw exception("Cannot open the ofstream for writing to {}: {} (code {})", indexFilePath.string(),
+                    std::strerror(errno), errno);
+  }
+
+  ofs.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size_bytes()));
+}
+
+uint64_t ProtoHourFileIndex::nbMessages() const noexcept {
+  uint64_t nbMessages = 0;
+  for (const auto &entry : _entries) {
+    nbMessages += entry.nbMessages;
+  }
+  return nbMessages;
+}
+
+}  // namespace cct
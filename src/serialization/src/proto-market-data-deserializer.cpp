@@ -1,33 +1,210 @@
 #include "proto-market-data-deserializer.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 
+#include "cct_log.hpp"
+#include "columnar-market-data.hpp"
 #include "market-order-book-vector.hpp"
+#include "market-order-book.pb.h"
 #include "market-timestamp-set.hpp"
 #include "market.hpp"
 #include "proto-constants.hpp"
+#include "proto-deserializer.hpp"
+#include "proto-market-order-book-converter.hpp"
 #include "public-trade-vector.hpp"
+#include "public-trade.pb.h"
 #include "serialization-tools.hpp"
+#include "stringconv.hpp"
 #include "time-window.hpp"
+#include "timedef.hpp"
 
 namespace cct {
+
+namespace {
+
+/// Returns the view on the columnar file of given market, from the cache if its file has not been replaced since.
+/// Non existing files are cached as well (as empty views), until they are created.
+template <class ColumnarViewsMap>
+const auto &GetColumnarView(ColumnarViewsMap &columnarViews, const std::filesystem::path &exchangeSerializedDataPath,
+                            Market market) {
+  using CachedColumnarView = ColumnarViewsMap::mapped_type;
+
+  const auto filePath = exchangeSerializedDataPath / std::string_view{market.str()} / kColumnarFileName;
+
+  std::error_code ec;
+  const auto lastWriteTime = std::filesystem::last_write_time(filePath, ec);
+
+  auto it = columnarViews.find(market);
+  if (it == columnarViews.end() || it->second.lastWriteTime != lastWriteTime) {
+    it = columnarViews
+             .insert_or_assign(market, CachedColumnarView{.view{filePath, market}, .lastWriteTime = lastWriteTime})
+             .first;
+  }
+  return it->second.view;
+}
+
+/// Loads the data of given market in the time window from the columnar file if it exists, completed by the hourly
+/// files for the data that has been serialized after the compaction.
+template <class Deserializer, class ColumnarViewsMap>
+auto LoadMarket(Deserializer &deserializer, ColumnarViewsMap &columnarViews, Market market, TimeWindow timeWindow) {
+  const auto &columnarView = GetColumnarView(columnarViews, deserializer.exchangeSerializedDataPath(), market);
+  if (columnarView.empty()) {
+    return deserializer.loadMarket(market, timeWindow);
+  }
+
+  auto ret = columnarView.load(timeWindow);
+
+  const TimePoint notCompactedFrom = columnarView.lastTimestamp() + milliseconds{1};
+  if (notCompactedFrom < timeWindow.to()) {
+    auto notCompactedObjects =
+        deserializer.loadMarket(market, TimeWindow{std::max(timeWindow.from(), notCompactedFrom), timeWindow.to()});
+    ret.insert(ret.end(), std::make_move_iterator(notCompactedObjects.begin()),
+               std::make_move_iterator(notCompactedObjects.end()));
+  }
+
+  return ret;
+}
+
+/// Used to load the raw protobuf objects from the hourly files, without any conversion.
+template <class ProtobufObjType>
+class ProtobufIdentityConverter {
+ public:
+  explicit ProtobufIdentityConverter([[maybe_unused]] Market market) noexcept {}
+
+  ProtobufObjType operator()(const ProtobufObjType &protobufObj) const { return protobufObj; }
+
+  ProtobufObjType operator()(ProtobufObjType &&protobufObj) const { return std::move(protobufObj); }
+};
+
+/// Used to load the raw full market order books from the hourly files, rebuilt from the delta encoded ones.
+class ProtobufMarketOrderBookIdentityConverter : public ProtobufIdentityConverter<::proto::MarketOrderBook> {
+ public:
+  using ProtobufIdentityConverter<::proto::MarketOrderBook>::ProtobufIdentityConverter;
+
+  bool decode(::proto::MarketOrderBook &marketOrderBook) { return _deltaDecoder.decode(marketOrderBook); }
+
+ private:
+  MarketOrderBookDeltaDecoder _deltaDecoder;
+};
+
+int FirstYear(const std::filesystem::path &marketPath) {
+  int firstYear = std::numeric_limits<int>::max();
+  for (const auto &entry : std::filesystem::directory_iterator(marketPath)) {
+    const auto fileName = entry.path().filename().string();
+    if (entry.is_directory() && !fileName.empty() &&
+        std::ranges::all_of(fileName, [](char ch) { return std::isdigit(static_cast<unsigned char>(ch)) != 0; })) {
+      firstYear = std::min(firstYear, StringToIntegral(fileName));
+    }
+  }
+  return firstYear;
+}
+
+/// Rewrites the columnar file of given market from all its hourly files.
+/// Returns true if a columnar file has been written.
+template <class ProtobufObjType, class Converter, class ColumnarBuilder>
+bool CompactMarket(const std::filesystem::path &exchangeSerializedDataPath, Market market) {
+  const auto marketPath = exchangeSerializedDataPath / std::string_view{market.str()};
+
+  std::error_code ec;
+  if (!std::filesystem::is_directory(marketPath, ec)) {
+    return false;
+  }
+
+  const int firstYear = FirstYear(marketPath);
+  if (firstYear == std::numeric_limits<int>::max()) {
+    return false;
+  }
+
+  ProtobufObjectsDeserializer<ProtobufObjType, Converter> deserializer(exchangeSerializedDataPath);
+
+  // Loading day by day bounds the memory used by the intermediate protobuf objects
+  static constexpr auto kChunkDuration = std::chrono::days{1};
+
+  const TimePoint nowTime = Clock::now();
+  const TimePoint firstTime{std::chrono::sys_days{std::chrono::year{firstYear} / 1 / 1}};
+
+  const auto columnarFilePath = marketPath / kColumnarFileName;
+
+  // Columns are streamed to temporary files, so that the whole market history is never held in memory
+  ColumnarBuilder builder(columnarFilePath);
+  for (TimeWindow timeWindow(firstTime, kChunkDuration); timeWindow.from() <= nowTime; timeWindow += kChunkDuration) {
+    for (const auto &protobufObj : deserializer.loadMarket(market, timeWindow)) {
+      builder.append(protobufObj);
+    }
+  }
+
+  if (builder.empty()) {
+    return false;
+  }
+
+  builder.write();
+
+  log::info("Compacted {} objects into {}", builder.size(), columnarFilePath.string());
+  return true;
+}
+
+template <class ProtobufObjType, class Converter, class ColumnarBuilder>
+int CompactMarkets(const std::filesystem::path &exchangeSerializedDataPath, Market market) {
+  if (market.isDefined()) {
+    return CompactMarket<ProtobufObjType, Converter, ColumnarBuilder>(exchangeSerializedDataPath, market) ? 1 : 0;
+  }
+
+  int nbCompactedFiles = 0;
+
+  std::error_code ec;
+  if (std::filesystem::is_directory(exchangeSerializedDataPath, ec)) {
+    for (const auto &marketDirectory : std::filesystem::directory_iterator(exchangeSerializedDataPath)) {
+      if (marketDirectory.is_directory() &&
+          CompactMarket<ProtobufObjType, Converter, ColumnarBuilder>(
+              exchangeSerializedDataPath, Market(marketDirectory.path().filename().string()))) {
+        ++nbCompactedFiles;
+      }
+    }
+  }
+
+  return nbCompactedFiles;
+}
+
+}  // namespace
+
 ProtoMarketDataDeserializer::ProtoMarketDataDeserializer(std::string_view dataDir, std::string_view exchangeName)
     : _marketOrderBookDeserializer(ComputeProtoSubPath(dataDir, exchangeName, kSubPathMarketOrderBooks)),
       _publicTradeDeserializer(ComputeProtoSubPath(dataDir, exchangeName, kSubPathTrades)) {}
 
 MarketTimestampSet ProtoMarketDataDeserializer::pullMarketOrderBooksMarkets(TimeWindow timeWindow) {
-  return _publicTradeDeserializer.listMarkets(timeWindow);
+  return _marketOrderBookDeserializer.listMarkets(timeWindow);
 }
 
 MarketTimestampSet ProtoMarketDataDeserializer::pullTradeMarkets(TimeWindow timeWindow) {
-  return _marketOrderBookDeserializer.listMarkets(timeWindow);
+  return _publicTradeDeserializer.listMarkets(timeWindow);
 }
 
 MarketOrderBookVector ProtoMarketDataDeserializer::pullMarketOrderBooks(Market market, TimeWindow timeWindow) {
-  return _marketOrderBookDeserializer.loadMarket(market, timeWindow);
+  return LoadMarket(_marketOrderBookDeserializer, _marketOrderBooksColumnarViews, market, timeWindow);
 }
 
 PublicTradeVector ProtoMarketDataDeserializer::pullTrades(Market market, TimeWindow timeWindow) {
-  return _publicTradeDeserializer.loadMarket(market, timeWindow);
+  return LoadMarket(_publicTradeDeserializer, _publicTradesColumnarViews, market, timeWindow);
+}
+
+int ProtoMarketDataDeserializer::compactMarketData(Market market) {
+  // Release the mapped columnar files before replacing them (not possible on Windows while they are mapped)
+  _marketOrderBooksColumnarViews.clear();
+  _publicTradesColumnarViews.clear();
+
+  return CompactMarkets<::proto::MarketOrderBook, ProtobufMarketOrderBookIdentityConverter,
+                        ColumnarMarketOrderBooksBuilder>(_marketOrderBookDeserializer.exchangeSerializedDataPath(),
+                                                         market) +
+         CompactMarkets<::proto::PublicTrade, ProtobufIdentityConverter<::proto::PublicTrade>,
+                        ColumnarPublicTradesBuilder>(_publicTradeDeserializer.exchangeSerializedDataPath(), market);
 }
-}  // namespace cct
\ No newline at end of file
+}  // namespace cct
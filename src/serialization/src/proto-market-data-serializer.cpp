@@ -1,12 +1,17 @@
 #include "proto-market-data-serializer.hpp"
 
+#include <cstdint>
 #include <span>
 #include <string_view>
 
+#include "abstractmetricgateway.hpp"
+#include "background-write-queue.hpp"
 #include "cct_log.hpp"
 #include "market-timestamp-set.hpp"
 #include "market.hpp"
 #include "marketorderbook.hpp"
+#include "metric-handles.hpp"
+#include "metric.hpp"
 #include "proto-constants.hpp"
 #include "proto-market-order-book-converter.hpp"
 #include "proto-public-trade-converter.hpp"
@@ -18,16 +23,58 @@ namespace cct {
 namespace {
 constexpr auto kNbMarketOrderBookObjectsInMemory = 1000;
 constexpr auto kNbTradeObjectsInMemory = 25000;
+
+MetricGauge RegisterGauge(AbstractMetricGateway* pMetricGateway, std::string_view name, std::string_view help,
+                          std::string_view exchangeName, std::string_view dataType) {
+  if (pMetricGateway == nullptr) {
+    return {};
+  }
+  MetricKey key = CreateMetricKey(name, help);
+  key.set("exchange", exchangeName);
+  key.set("type", dataType);
+  return pMetricGateway->registerGauge(key);
+}
+
+MetricGauge RegisterBufferedBytesGauge(AbstractMetricGateway* pMetricGateway, std::string_view exchangeName,
+                                       std::string_view dataType) {
+  return RegisterGauge(pMetricGateway, "market_data_serialization_buffered_bytes",
+                       "Serialized size of the market data buffered in memory before being written", exchangeName,
+                       dataType);
+}
+
+BackgroundWriteQueue::Gauges RegisterWriteQueueGauges(AbstractMetricGateway* pMetricGateway,
+                                                      std::string_view exchangeName, std::string_view dataType) {
+  return {.queueDepth = RegisterGauge(pMetricGateway, "market_data_serialization_queue_depth",
+                                      "Number of market data batches waiting to be written by the writer thread",
+                                      exchangeName, dataType),
+          .maxQueueDepth = RegisterGauge(pMetricGateway, "market_data_serialization_max_queue_depth",
+                                         "Maximum number of market data batches waiting to be written", exchangeName,
+                                         dataType),
+          .nbBackpressureWaits = RegisterGauge(pMetricGateway, "market_data_serialization_backpressure_wait_count",
+                                               "Number of waits for the writer thread because its queue was full",
+                                               exchangeName, dataType),
+          .backpressureWaitDurationInMs =
+              RegisterGauge(pMetricGateway, "market_data_serialization_backpressure_wait_duration_ms",
+                            "Total duration of the waits for the writer thread in milliseconds", exchangeName,
+                            dataType)};
+}
 }  // namespace
 
 ProtoMarketDataSerializer::ProtoMarketDataSerializer(std::string_view dataDir,
                                                      const MarketTimestampSets& lastWrittenObjectsMarketTimestamp,
-                                                     std::string_view exchangeName)
+                                                     std::string_view exchangeName, int32_t writeQueueSize,
+                                                     int64_t memoryBudgetInBytes,
+                                                     AbstractMetricGateway* pMetricGateway)
     : _marketOrderBookSerializer(ComputeProtoSubPath(dataDir, exchangeName, kSubPathMarketOrderBooks),
-                                 lastWrittenObjectsMarketTimestamp.orderBooksMarkets,
-                                 kNbMarketOrderBookObjectsInMemory),
+                                 lastWrittenObjectsMarketTimestamp.orderBooksMarkets, kNbMarketOrderBookObjectsInMemory,
+                                 writeQueueSize, memoryBudgetInBytes / 2,
+                                 RegisterBufferedBytesGauge(pMetricGateway, exchangeName, kSubPathMarketOrderBooks),
+                                 RegisterWriteQueueGauges(pMetricGateway, exchangeName, kSubPathMarketOrderBooks)),
       _tradesSerializer(ComputeProtoSubPath(dataDir, exchangeName, kSubPathTrades),
-                        lastWrittenObjectsMarketTimestamp.tradesMarkets, kNbTradeObjectsInMemory) {}
+                        lastWrittenObjectsMarketTimestamp.tradesMarkets, kNbTradeObjectsInMemory, writeQueueSize,
+                        memoryBudgetInBytes / 2,
+                        RegisterBufferedBytesGauge(pMetricGateway, exchangeName, kSubPathTrades),
+                        RegisterWriteQueueGauges(pMetricGateway, exchangeName, kSubPathTrades)) {}
 
 void ProtoMarketDataSerializer::push(const MarketOrderBook& marketOrderBook) {
   if (!marketOrderBook.isValid()) {
@@ -2,10 +2,12 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <ranges>
 #include <utility>
 
 #include "cct_exception.hpp"
+#include "cct_log.hpp"
 #include "market-order-book.pb.h"
 #include "marketorderbook.hpp"
 #include "monetaryamount.hpp"
@@ -58,6 +60,140 @@ namespace cct {
   return protoObj;
 }
 
+namespace {
+
+using PricedVolumes = ::google::protobuf::RepeatedPtrField<::proto::MarketOrderBook::PricedVolume>;
+using PricedVolumeDeltas = ::google::protobuf::RepeatedPtrField<::proto::MarketOrderBook::PricedVolumeDelta>;
+
+int64_t MidPrice(const ::proto::MarketOrderBook::OrderBook& orderBook) {
+  if (orderBook.bids().empty() || orderBook.asks().empty()) {
+    return 0;
+  }
+  const int64_t highestBidPrice = orderBook.bids()[0].price();
+  const int64_t lowestAskPrice = orderBook.asks()[0].price();
+
+  // Avoids overflow of the sum of both prices
+  return highestBidPrice + ((lowestAskPrice - highestBidPrice) / 2);
+}
+
+/// Computes the price level differences between two sides of order books, sorted according to 'comp'.
+template <class Comp>
+void ComputeDelta(const PricedVolumes& previousLevels, const PricedVolumes& levels, int64_t midPrice, Comp comp,
+                  PricedVolumeDeltas& deltas) {
+  const auto addDelta = [midPrice, &deltas](int64_t price, int64_t volume) {
+    auto& delta = *deltas.Add();
+    delta.set_relativeprice(price - midPrice);
+    delta.set_volume(volume);
+  };
+
+  auto previousIt = previousLevels.begin();
+  auto it = levels.begin();
+  while (previousIt != previousLevels.end() || it != levels.end()) {
+    if (it == levels.end() || (previousIt != previousLevels.end() && comp(previousIt->price(), it->price()))) {
+      // removed price level
+      addDelta(previousIt->price(), 0);
+      ++previousIt;
+    } else if (previousIt == previousLevels.end() || comp(it->price(), previousIt->price())) {
+      // new price level
+      addDelta(it->price(), it->volume());
+      ++it;
+    } else {
+      if (previousIt->volume() != it->volume()) {
+        addDelta(it->price(), it->volume());
+      }
+      ++previousIt;
+      ++it;
+    }
+  }
+}
+
+/// Applies price level differences computed by ComputeDelta to given side of order book.
+template <class Comp>
+void ApplyDelta(const PricedVolumeDeltas& deltas, int64_t midPrice, Comp comp, PricedVolumes& levels) {
+  PricedVolumes newLevels;
+  newLevels.Reserve(levels.size() + deltas.size());
+
+  auto it = levels.begin();
+  for (const auto& delta : deltas) {
+    const int64_t price = midPrice + delta.relativeprice();
+    for (; it != levels.end() && comp(it->price(), price); ++it) {
+      *newLevels.Add() = *it;
+    }
+    if (it != levels.end() && it->price() == price) {
+      // price level updated or removed
+      ++it;
+    }
+    if (delta.volume() != 0) {
+      auto& level = *newLevels.Add();
+      level.set_price(price);
+      level.set_volume(delta.volume());
+    }
+  }
+  for (; it != levels.end(); ++it) {
+    *newLevels.Add() = *it;
+  }
+
+  levels.Swap(&newLevels);
+}
+
+}  // namespace
+
+const ::proto::MarketOrderBook& MarketOrderBookDeltaEncoder::encode(const ::proto::MarketOrderBook& marketOrderBook) {
+  const ::proto::MarketOrderBook* pPrevious = _pPrevious;
+
+  _pPrevious = &marketOrderBook;
+
+  if (pPrevious != nullptr && _nbDeltasSinceKeyFrame + 1 < _keyFrameInterval &&
+      pPrevious->volumenbdecimals() == marketOrderBook.volumenbdecimals() &&
+      pPrevious->pricenbdecimals() == marketOrderBook.pricenbdecimals()) {
+    const auto& previousOrderBook = pPrevious->orderbook();
+    const auto& orderBook = marketOrderBook.orderbook();
+    const auto midPrice = MidPrice(previousOrderBook);
+
+    _delta.Clear();
+    _delta.set_unixtimestampinms(marketOrderBook.unixtimestampinms());
+
+    auto& orderBookDelta = *_delta.mutable_orderbookdelta();
+
+    ComputeDelta(previousOrderBook.asks(), orderBook.asks(), midPrice, std::less<>{}, *orderBookDelta.mutable_asks());
+    ComputeDelta(previousOrderBook.bids(), orderBook.bids(), midPrice, std::greater<>{},
+                 *orderBookDelta.mutable_bids());
+
+    if (orderBookDelta.asks_size() + orderBookDelta.bids_size() < orderBook.asks_size() + orderBook.bids_size()) {
+      ++_nbDeltasSinceKeyFrame;
+      return _delta;
+    }
+  }
+
+  _nbDeltasSinceKeyFrame = 0;
+  return marketOrderBook;
+}
+
+bool MarketOrderBookDeltaDecoder::decode(::proto::MarketOrderBook& marketOrderBook) {
+  if (!marketOrderBook.has_orderbookdelta()) {
+    // key frame
+    _previous = marketOrderBook;
+    _hasPrevious = true;
+    return true;
+  }
+  if (!_hasPrevious) {
+    log::error("Delta encoded market order book without preceding key frame");
+    return false;
+  }
+
+  auto& previousOrderBook = *_previous.mutable_orderbook();
+  const auto& orderBookDelta = marketOrderBook.orderbookdelta();
+  const auto midPrice = MidPrice(previousOrderBook);
+
+  ApplyDelta(orderBookDelta.asks(), midPrice, std::less<>{}, *previousOrderBook.mutable_asks());
+  ApplyDelta(orderBookDelta.bids(), midPrice, std::greater<>{}, *previousOrderBook.mutable_bids());
+
+  _previous.set_unixtimestampinms(marketOrderBook.unixtimestampinms());
+
+  marketOrderBook = _previous;
+  return true;
+}
+
 MarketOrderBook MarketOrderBookConverter::operator()(const ::proto::MarketOrderBook& marketOrderBookTimedData) {
   const TimePoint timeStamp(milliseconds(marketOrderBookTimedData.unixtimestampinms()));
   const VolAndPriNbDecimals volAndPriNbDecimals(marketOrderBookTimedData.volumenbdecimals(),
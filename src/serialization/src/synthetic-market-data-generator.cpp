@@ -0,0 +1,158 @@
+#include "synthetic-market-data-generator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string_view>
+
+#include "cct_exception.hpp"
+#include "market-timestamp-set.hpp"
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "order-book-line.hpp"
+#include "proto-market-data-serializer.hpp"
+#include "public-trade-vector.hpp"
+#include "publictrade.hpp"
+#include "timedef.hpp"
+#include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct {
+
+namespace {
+// Mean notional amount (in quote currency) of the first price level of the order books.
+// Deeper levels are progressively larger.
+constexpr double kMeanFirstLevelNotional = 10000;
+
+// Mean notional amount (in quote currency) of a public trade.
+constexpr double kMeanTradeNotional = 1000;
+
+// Mean relative increase of the volume of each price level compared to the previous one.
+constexpr double kLevelVolumeIncrease = 0.25;
+
+// Spread and gaps between consecutive price levels are drawn uniformly in [1, kMaxNbTicksGap] ticks.
+constexpr int kMaxNbTicksGap = 3;
+
+}  // namespace
+
+SyntheticMarketDataGenerator::SyntheticMarketDataGenerator(const Config &config) : _config(config) {
+  if (_config.depth <= 0) {
+    throw exception("Synthetic market data generator depth should be strictly positive, got {}", _config.depth);
+  }
+  if (_config.marketOrderBookPeriod < milliseconds(1)) {
+    throw exception("Synthetic market data generator order book period should be at least one millisecond");
+  }
+  if (_config.nbTradesPerSecond < 0 || _config.volatility < 0) {
+    throw exception("Synthetic market data generator trade rate and volatility should be positive");
+  }
+  if (_config.startMidPrice <= 0) {
+    throw exception("Synthetic market data generator start mid price should be strictly positive");
+  }
+}
+
+SyntheticMarketDataGenerator::Stats SyntheticMarketDataGenerator::generate(std::string_view dataDir,
+                                                                           std::string_view exchangeName) const {
+  const Market market = _config.market;
+  const CurrencyCode base = market.base();
+  const CurrencyCode quote = market.quote();
+  const int8_t priceNbDecimals = _config.priceNbDecimals;
+  const int8_t volumeNbDecimals = _config.volumeNbDecimals;
+  const double tickSize = std::pow(10.0, -priceNbDecimals);
+  const double nbVolumeUnitsPerBase = std::pow(10.0, volumeNbDecimals);
+
+  // Make sure that the lowest bid price of the order books stays strictly positive
+  const int64_t minMidNbTicks = (static_cast<int64_t>(kMaxNbTicksGap) * (_config.depth + 1)) + 1;
+
+  std::mt19937_64 rng(_config.seed);
+  std::normal_distribution<double> midRelativeVariationDistribution(0, _config.volatility);
+  std::uniform_int_distribution<int> nbTicksGapDistribution(1, kMaxNbTicksGap);
+  std::exponential_distribution<double> volumeDistribution(1);
+  std::exponential_distribution<double> tradeInterArrivalInSecondsDistribution(
+      _config.nbTradesPerSecond == 0 ? 1 : _config.nbTradesPerSecond);
+  std::bernoulli_distribution isBuyDistribution(0.5);
+
+  const auto drawVolume = [&](double meanNotional, double refPrice) {
+    const double nbVolumeUnits = volumeDistribution(rng) * (meanNotional / refPrice) * nbVolumeUnitsPerBase;
+    return MonetaryAmount(std::max<int64_t>(1, std::llround(nbVolumeUnits)), base, volumeNbDecimals);
+  };
+
+  const auto drawTradeInterArrival = [&]() {
+    const std::chrono::duration<double> interArrival(tradeInterArrivalInSecondsDistribution(rng));
+    return std::max(std::chrono::duration_cast<Duration>(milliseconds(1)),
+                    std::chrono::duration_cast<Duration>(interArrival));
+  };
+
+  Stats stats;
+
+  MarketOrderBookLines orderBookLines;
+  orderBookLines.reserve(static_cast<MarketOrderBookLines::size_type>(2 * _config.depth));
+
+  PublicTradeVector publicTrades;
+
+  const TimeWindow timeWindow = _config.timeWindow;
+
+  TimePoint nextTradeTime =
+      _config.nbTradesPerSecond == 0 ? TimePoint::max() : timeWindow.from() + drawTradeInterArrival();
+
+  double midPrice = _config.startMidPrice.toDouble();
+
+  {
+    // Serializer writes all its remaining data at destruction
+    ProtoMarketDataSerializer marketDataSerializer(dataDir, MarketTimestampSets{}, exchangeName);
+
+    for (TimePoint ts = timeWindow.from(); ts < timeWindow.to(); ts += _config.marketOrderBookPeriod) {
+      midPrice *= std::exp(midRelativeVariationDistribution(rng));
+
+      const int64_t midNbTicks = std::max<int64_t>(minMidNbTicks, std::llround(midPrice / tickSize));
+
+      midPrice = static_cast<double>(midNbTicks) * tickSize;
+
+      const int spreadNbTicks = nbTicksGapDistribution(rng);
+      const int64_t highestBidNbTicks = midNbTicks - (spreadNbTicks / 2);
+      const int64_t lowestAskNbTicks = highestBidNbTicks + spreadNbTicks;
+
+      orderBookLines.clear();
+
+      int64_t askNbTicks = lowestAskNbTicks;
+      int64_t bidNbTicks = highestBidNbTicks;
+      for (int32_t level = 0; level < _config.depth; ++level) {
+        const double meanLevelNotional = kMeanFirstLevelNotional * (1 + (kLevelVolumeIncrease * level));
+
+        orderBookLines.pushAsk(drawVolume(meanLevelNotional, midPrice),
+                               MonetaryAmount(askNbTicks, quote, priceNbDecimals));
+        orderBookLines.pushBid(drawVolume(meanLevelNotional, midPrice),
+                               MonetaryAmount(bidNbTicks, quote, priceNbDecimals));
+
+        askNbTicks += nbTicksGapDistribution(rng);
+        bidNbTicks -= nbTicksGapDistribution(rng);
+      }
+
+      marketDataSerializer.push(
+          MarketOrderBook(ts, market, orderBookLines, VolAndPriNbDecimals{volumeNbDecimals, priceNbDecimals}));
+
+      ++stats.nbMarketOrderBooks;
+
+      // Public trades until next order book hit the best price of this one
+      const TimePoint endTradesTime = std::min(ts + _config.marketOrderBookPeriod, timeWindow.to());
+
+      publicTrades.clear();
+      for (; nextTradeTime < endTradesTime; nextTradeTime += drawTradeInterArrival()) {
+        const bool isBuy = isBuyDistribution(rng);
+        const MonetaryAmount price(isBuy ? lowestAskNbTicks : highestBidNbTicks, quote, priceNbDecimals);
+
+        publicTrades.emplace_back(isBuy ? TradeSide::buy : TradeSide::sell, drawVolume(kMeanTradeNotional, midPrice),
+                                  price, nextTradeTime);
+      }
+
+      marketDataSerializer.push(market, publicTrades);
+
+      stats.nbPublicTrades += static_cast<int64_t>(publicTrades.size());
+    }
+  }
+
+  return stats;
+}
+
+}  // namespace cct
@@ -0,0 +1,159 @@
+#include "columnar-market-data.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "cct_exception.hpp"
+#include "market-order-book-vector.hpp"
+#include "market-order-book.pb.h"
+#include "market.hpp"
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "proto-market-order-book-converter.hpp"
+#include "proto-test-data.hpp"
+#include "public-trade-vector.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct {
+
+class ColumnarMarketDataTest : public ProtobufBaseDataTest {
+ protected:
+  void SetUp() override { std::filesystem::create_directories(dir); }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  static MarketOrderBook CreateMarketOrderBook(TimePoint timePoint, Market market, int askPrice) {
+    return {timePoint,
+            MonetaryAmount(askPrice, market.quote()),
+            MonetaryAmount("0.56", market.base()),
+            MonetaryAmount(askPrice - 1, market.quote()),
+            MonetaryAmount("1.34", market.base()),
+            VolAndPriNbDecimals{2, 0},
+            3};
+  }
+
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "cct-columnar-market-data-test";
+  std::filesystem::path filePath = dir / kColumnarFileName;
+
+  MarketOrderBook mob1 = CreateMarketOrderBook(tp1, mk1, 1500);
+  MarketOrderBook mob2 = CreateMarketOrderBook(tp2, mk1, 1502);
+  MarketOrderBook mob3 = CreateMarketOrderBook(tp3, mk1, 1499);
+  MarketOrderBook mob4 = CreateMarketOrderBook(tp5, mk1, 1510);
+};
+
+TEST_F(ColumnarMarketDataTest, NonExistingFileGivesEmptyView) {
+  ColumnarPublicTradesView publicTradesView(filePath, mk1);
+  ColumnarMarketOrderBooksView marketOrderBooksView(filePath, mk1);
+
+  EXPECT_TRUE(publicTradesView.empty());
+  EXPECT_TRUE(publicTradesView.load(timeWindowAll).empty());
+  EXPECT_TRUE(marketOrderBooksView.empty());
+  EXPECT_TRUE(marketOrderBooksView.load(timeWindowAll).empty());
+}
+
+TEST_F(ColumnarMarketDataTest, InvalidFileGivesEmptyView) {
+  {
+    std::ofstream ofs(filePath, std::ios::binary);
+    ofs << "this is not a columnar file, but it is long enough to contain a header";
+  }
+
+  EXPECT_TRUE(ColumnarPublicTradesView(filePath, mk1).empty());
+}
+
+TEST_F(ColumnarMarketDataTest, PublicTradesWrongObjectType) {
+  ColumnarPublicTradesBuilder builder(filePath);
+  builder.append(td1);
+  builder.write();
+
+  EXPECT_FALSE(ColumnarPublicTradesView(filePath, mk1).empty());
+  EXPECT_TRUE(ColumnarMarketOrderBooksView(filePath, mk1).empty());
+}
+
+TEST_F(ColumnarMarketDataTest, PublicTradesUnsortedShouldThrow) {
+  ColumnarPublicTradesBuilder builder(filePath);
+  builder.append(td2);
+  builder.append(td1);
+
+  EXPECT_THROW(builder.write(), exception);
+}
+
+TEST_F(ColumnarMarketDataTest, PublicTrades) {
+  ColumnarPublicTradesBuilder builder(filePath);
+  builder.append(td1);
+  builder.append(td2);
+  builder.append(td3);
+  builder.append(td9);
+
+  EXPECT_EQ(builder.size(), 4U);
+
+  builder.write();
+
+  ColumnarPublicTradesView view(filePath, mk1);
+
+  ASSERT_EQ(view.size(), 4U);
+  EXPECT_EQ(view.lastTimestamp(), tp5);
+
+  EXPECT_EQ(view.load(timeWindowAll), PublicTradeVector({pt1, pt2, pt3, pt9}));
+  EXPECT_EQ(view.load(timeWindow14), PublicTradeVector({pt1, pt2, pt3}));
+  EXPECT_EQ(view.load(TimeWindow{tp2, tp5 + milliseconds{1}}), PublicTradeVector({pt2, pt3, pt9}));
+  EXPECT_EQ(view.load(timeWindow79), PublicTradeVector());
+}
+
+TEST_F(ColumnarMarketDataTest, MarketOrderBooks) {
+  ColumnarMarketOrderBooksBuilder builder(filePath);
+  builder.append(ConvertMarketOrderBookToProto(mob1));
+  builder.append(ConvertMarketOrderBookToProto(mob2));
+  builder.append(ConvertMarketOrderBookToProto(mob3));
+  builder.append(ConvertMarketOrderBookToProto(mob4));
+
+  builder.write();
+
+  ColumnarMarketOrderBooksView view(filePath, mk1);
+
+  ASSERT_EQ(view.size(), 4U);
+  EXPECT_EQ(view.lastTimestamp(), tp5);
+
+  EXPECT_EQ(view.load(timeWindowAll), MarketOrderBookVector({mob1, mob2, mob3, mob4}));
+  EXPECT_EQ(view.load(timeWindow14), MarketOrderBookVector({mob1, mob2, mob3}));
+  EXPECT_EQ(view.load(TimeWindow{tp3, tp9}), MarketOrderBookVector({mob3, mob4}));
+  EXPECT_EQ(view.load(timeWindow79), MarketOrderBookVector());
+}
+
+TEST_F(ColumnarMarketDataTest, RewriteReplacesFile) {
+  {
+    ColumnarPublicTradesBuilder builder(filePath);
+    builder.append(td1);
+    builder.write();
+  }
+  {
+    ColumnarPublicTradesBuilder builder(filePath);
+    builder.append(td1);
+    builder.append(td2);
+    builder.write();
+  }
+
+  EXPECT_EQ(ColumnarPublicTradesView(filePath, mk1).size(), 2U);
+}
+
+TEST_F(ColumnarMarketDataTest, TemporaryColumnFilesAreRemoved) {
+  {
+    ColumnarMarketOrderBooksBuilder builder(filePath);
+    builder.append(ConvertMarketOrderBookToProto(mob1));
+    builder.write();
+  }
+  {
+    // not written
+    ColumnarPublicTradesBuilder builder(dir / "other.bincol");
+    builder.append(td1);
+  }
+
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+  EXPECT_EQ(ColumnarMarketOrderBooksView(filePath, mk1).load(timeWindowAll), MarketOrderBookVector({mob1}));
+}
+
+}  // namespace cct
@@ -2,8 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstddef>
 #include <initializer_list>
 
+#include "market-order-book.pb.h"
 #include "market.hpp"
 #include "marketorderbook.hpp"
 #include "monetaryamount.hpp"
@@ -110,4 +113,77 @@ TEST_F(ProtoMarketOrderBookTest, SerializeThenDeserializeShouldGiveSameObject) {
 
   EXPECT_EQ(marketOrderBook, marketOrderBookConvertedBack);
 }
-}  // namespace cct
\ No newline at end of file
+
+class ProtoMarketOrderBookDeltaTest : public ProtoMarketOrderBookTest {
+ protected:
+  void SetUp() override {
+    protoObjs[0] = ConvertMarketOrderBookToProto(marketOrderBook);
+
+    // one changed volume
+    protoObjs[1] = protoObjs[0];
+    protoObjs[1].set_unixtimestampinms(protoObjs[0].unixtimestampinms() + 1000);
+    protoObjs[1].mutable_orderbook()->mutable_asks(1)->set_volume(19913922000000001);
+
+    // one removed ask level, one new bid level
+    protoObjs[2] = protoObjs[1];
+    protoObjs[2].set_unixtimestampinms(protoObjs[1].unixtimestampinms() + 1000);
+    protoObjs[2].mutable_orderbook()->mutable_asks()->RemoveLast();
+    auto &newBid = *protoObjs[2].mutable_orderbook()->add_bids();
+    newBid.set_volume(140000000000000);
+    newBid.set_price(571500000000000000);
+
+    // no change
+    protoObjs[3] = protoObjs[2];
+    protoObjs[3].set_unixtimestampinms(protoObjs[2].unixtimestampinms() + 1000);
+  }
+
+  static ::proto::MarketOrderBook WriteThenRead(const ::proto::MarketOrderBook &protoObj) {
+    ::proto::MarketOrderBook ret;
+    ret.ParseFromString(protoObj.SerializeAsString());
+    return ret;
+  }
+
+  std::array<::proto::MarketOrderBook, 4> protoObjs;
+  MarketOrderBookDeltaDecoder decoder;
+};
+
+TEST_F(ProtoMarketOrderBookDeltaTest, EncodeThenDecodeShouldGiveSameObjects) {
+  MarketOrderBookDeltaEncoder encoder;
+
+  for (std::size_t pos = 0; pos < protoObjs.size(); ++pos) {
+    auto protoObj = WriteThenRead(encoder.encode(protoObjs[pos]));
+
+    // first one is a key frame, others differ from a few levels only
+    EXPECT_EQ(protoObj.has_orderbookdelta(), pos != 0);
+    EXPECT_EQ(protoObj.has_orderbook(), pos == 0);
+
+    ASSERT_TRUE(decoder.decode(protoObj));
+
+    EXPECT_EQ(protoObj.SerializeAsString(), protoObjs[pos].SerializeAsString());
+    EXPECT_EQ(marketOrderBookConverter(protoObj), marketOrderBookConverter(protoObjs[pos]));
+  }
+}
+
+TEST_F(ProtoMarketOrderBookDeltaTest, KeyFrameInterval) {
+  MarketOrderBookDeltaEncoder encoder(2);
+
+  EXPECT_FALSE(encoder.encode(protoObjs[0]).has_orderbookdelta());
+  EXPECT_TRUE(encoder.encode(protoObjs[1]).has_orderbookdelta());
+  EXPECT_FALSE(encoder.encode(protoObjs[2]).has_orderbookdelta());
+  EXPECT_TRUE(encoder.encode(protoObjs[3]).has_orderbookdelta());
+
+  encoder.reset();
+
+  EXPECT_FALSE(encoder.encode(protoObjs[0]).has_orderbookdelta());
+}
+
+TEST_F(ProtoMarketOrderBookDeltaTest, DeltaWithoutKeyFrameCannotBeDecoded) {
+  MarketOrderBookDeltaEncoder encoder;
+
+  encoder.encode(protoObjs[0]);
+  auto protoObj = WriteThenRead(encoder.encode(protoObjs[1]));
+
+  EXPECT_FALSE(decoder.decode(protoObj));
+}
+
+}  // namespace cct
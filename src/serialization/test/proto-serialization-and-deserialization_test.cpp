@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -14,8 +15,11 @@
 
 #include "market-timestamp-set.hpp"
 #include "market-timestamp.hpp"
+#include "metric-handles.hpp"
 #include "monetaryamount.hpp"
+#include "proto-constants.hpp"
 #include "proto-deserializer.hpp"
+#include "proto-hour-file-index.hpp"
 #include "proto-public-trade-compare.hpp"
 #include "proto-public-trade-converter.hpp"
 #include "proto-serializer.hpp"
@@ -154,6 +158,146 @@ TEST_F(ProtobufSerializerDeserializerTest, SerializeThenDeserializeSomeObjects)
   EXPECT_EQ(deserializer.loadMarket(mk5, timeWindowAll), vector<PublicTrade>({pt10, pt11}));
 }
 
+namespace {
+class TestGaugeMetric : public details::AbstractGaugeMetric {
+ public:
+  void increment(double val) override { _val += val; }
+  void decrement(double val) override { _val -= val; }
+  void set(double val) override { _val = val; }
+  void setToCurrentTime() override {}
+
+  double val() const { return _val; }
+
+ private:
+  std::atomic<double> _val{};
+};
+}  // namespace
+
+TEST_F(ProtobufSerializerDeserializerTest, AsynchronousSerialization) {
+  static constexpr int32_t kMaxNbQueuedBatches = 1;
+  static constexpr int kNbBatches = 5;
+  static constexpr Duration kDurationStep = std::chrono::minutes(7);
+
+  PublicTradeVector pushedPublicTrades;
+
+  TestGaugeMetric queueDepthMetric;
+  TestGaugeMetric maxQueueDepthMetric;
+  TestGaugeMetric nbBackpressureWaitsMetric;
+  TestGaugeMetric backpressureWaitDurationMetric;
+
+  {
+    Serializer serializer{subPath1,
+                          MarketTimestampSet{},
+                          nbTradesPerMarketInMemory,
+                          kMaxNbQueuedBatches,
+                          0,
+                          MetricGauge{},
+                          {.queueDepth = MetricGauge{&queueDepthMetric},
+                           .maxQueueDepth = MetricGauge{&maxQueueDepthMetric},
+                           .nbBackpressureWaits = MetricGauge{&nbBackpressureWaitsMetric},
+                           .backpressureWaitDurationInMs = MetricGauge{&backpressureWaitDurationMetric}}};
+
+    TimePoint ts = tp1;
+    for (int32_t pushPos = 0; pushPos < kNbBatches * nbTradesPerMarketInMemory + 1; ++pushPos, ts += kDurationStep) {
+      PublicTrade pt{TradeSide::buy, MonetaryAmount{"0.13", mk1.base()}, MonetaryAmount{"1500.5", mk1.quote()}, ts};
+
+      pushedPublicTrades.push_back(pt);
+      serializer.push(mk1, ConvertPublicTradeToProto(pt));
+    }
+
+    // Older objects than the ones handed over to the writer thread should be ignored
+    serializer.push(mk1, td1);
+
+    const auto stats = serializer.writeQueueStats();
+
+    EXPECT_EQ(stats.nbPushedTasks, kNbBatches);
+    EXPECT_LE(stats.queueDepth, kMaxNbQueuedBatches);
+    EXPECT_LE(stats.maxQueueDepth, kMaxNbQueuedBatches);
+
+    EXPECT_EQ(maxQueueDepthMetric.val(), kMaxNbQueuedBatches);
+    EXPECT_EQ(nbBackpressureWaitsMetric.val(), stats.nbBackpressureWaits);
+    EXPECT_EQ(backpressureWaitDurationMetric.val(),
+              std::chrono::duration_cast<milliseconds>(stats.backpressureWaitDuration).count());
+  }
+
+  // all queued batches have been written at destruction
+  EXPECT_EQ(queueDepthMetric.val(), 0);
+
+  // last object should be written at destruction, after the queued ones
+  EXPECT_EQ(createDeserializer().loadMarket(mk1, timeWindowAll), pushedPublicTrades);
+}
+
+TEST_F(ProtobufSerializerDeserializerTest, MemoryBudgetEvictsLeastRecentlyFlushedMarkets) {
+  const auto nbBytes1 = static_cast<int64_t>(td1.ByteSizeLong());
+  const auto nbBytes4 = static_cast<int64_t>(td4.ByteSizeLong());
+  const auto nbBytes5 = static_cast<int64_t>(td5.ByteSizeLong());
+
+  const auto mk1File = subPath1 / std::string_view{mk1.str()} / "1999" / "03" / "25" / ComputeProtoFileName(4);
+  const auto mk3File = subPath1 / std::string_view{mk3.str()} / "1999" / "03" / "25" / ComputeProtoFileName(4);
+  const auto mk4File = subPath1 / std::string_view{mk4.str()} / "2013" / "08" / "16" / ComputeProtoFileName(3);
+
+  {
+    Serializer serializer{subPath1, MarketTimestampSet{}, nbTradesPerMarketInMemory, 0,
+                          nbBytes1 + nbBytes4 + nbBytes5 - 1};
+
+    serializer.push(mk1, td1);
+    serializer.push(mk3, td4);
+
+    EXPECT_EQ(serializer.nbBufferedBytes(), nbBytes1 + nbBytes4);
+    EXPECT_FALSE(std::filesystem::exists(mk1File));
+
+    // Budget exceeded - mk1 is the least recently flushed market
+    serializer.push(mk4, td5);
+
+    EXPECT_EQ(serializer.nbBufferedBytes(), nbBytes4 + nbBytes5);
+    EXPECT_TRUE(std::filesystem::exists(mk1File));
+    EXPECT_FALSE(std::filesystem::exists(mk3File));
+
+    // Budget exceeded again - mk3 is now the least recently flushed market
+    serializer.push(mk4, td1);
+
+    EXPECT_EQ(serializer.nbBufferedBytes(), nbBytes5 + nbBytes1);
+    EXPECT_TRUE(std::filesystem::exists(mk3File));
+    EXPECT_FALSE(std::filesystem::exists(mk4File));
+  }
+
+  EXPECT_TRUE(std::filesystem::exists(mk4File));
+
+  auto deserializer = createDeserializer();
+
+  EXPECT_EQ(deserializer.loadMarket(mk1, timeWindowAll), vector<PublicTrade>({pt1}));
+  EXPECT_EQ(deserializer.loadMarket(mk3, timeWindowAll), vector<PublicTrade>({pt4}));
+}
+
+TEST_F(ProtobufSerializerDeserializerTest, MemoryBudgetCountsQueuedObjects) {
+  const auto nbBytes1 = static_cast<int64_t>(td1.ByteSizeLong());
+  const auto nbBytes4 = static_cast<int64_t>(td4.ByteSizeLong());
+  const auto nbBytes5 = static_cast<int64_t>(td5.ByteSizeLong());
+  const auto memoryBudget = nbBytes1 + nbBytes4 + nbBytes5 - 1;
+
+  {
+    // Each pushed object is directly handed over to the writer thread
+    static constexpr int32_t kNbObjectsPerMarketInMemory = 1;
+    static constexpr int32_t kMaxNbQueuedBatches = 5;
+
+    Serializer serializer{subPath1, MarketTimestampSet{}, kNbObjectsPerMarketInMemory, kMaxNbQueuedBatches,
+                          memoryBudget};
+
+    serializer.push(mk1, td1);
+    serializer.push(mk3, td4);
+    serializer.push(mk4, td5);
+
+    EXPECT_EQ(serializer.nbBufferedBytes(), 0);
+    EXPECT_LE(serializer.nbQueuedBytes(), memoryBudget);
+  }
+
+  auto deserializer = createDeserializer();
+
+  EXPECT_EQ(deserializer.loadMarket(mk1, timeWindowAll), vector<PublicTrade>({pt1}));
+  EXPECT_EQ(deserializer.loadMarket(mk3, timeWindowAll), vector<PublicTrade>({pt4}));
+  EXPECT_EQ(deserializer.loadMarket(mk4, timeWindowAll), vector<PublicTrade>({pt5}));
+}
+
 TEST_F(ProtobufSerializerDeserializerTest, ManySerializationsDifferentHoursOfDay) {
   static const TimePoint kTimePoints[] = {tp1, tp2};
   static const Market kMarkets[] = {mk1, mk4};
@@ -626,4 +770,65 @@ TEST_F(ProtobufSerializerDeserializerTest, ManySerializationsDifferentHoursOfDay
   }
 }
 
-}  // namespace cct
\ No newline at end of file
+TEST_F(ProtobufSerializerDeserializerTest, HourFileIndexWithSeveralBlocks) {
+  static constexpr auto kNbMessagesPerBlock = static_cast<int>(ProtoHourFileIndex::kNbMessagesPerBlock);
+  static constexpr int kNbTrades = (2 * kNbMessagesPerBlock) + 5;
+
+  nbTradesPerMarketInMemory = kNbTrades + 1;
+
+  // all trades are within the same hour
+  const TimePoint firstTp = std::chrono::ceil<std::chrono::hours>(tp1);
+
+  PublicTradeVector pushedPublicTrades;
+  {
+    auto serializer = createSerializer();
+    for (int tradePos = 0; tradePos < kNbTrades; ++tradePos) {
+      PublicTrade pt{TradeSide::buy, MonetaryAmount{tradePos + 1, mk1.base()}, MonetaryAmount{1500, mk1.quote()},
+                     firstTp + milliseconds{tradePos}};
+
+      pushedPublicTrades.push_back(pt);
+      serializer.push(mk1, ConvertPublicTradeToProto(pt));
+    }
+  }
+
+  std::filesystem::path hourFilePath;
+  for (const auto &entry : std::filesystem::recursive_directory_iterator(subPath1)) {
+    if (entry.path().extension() == kBinProtobufExtension) {
+      hourFilePath = entry.path();
+    }
+  }
+
+  const ProtoHourFileIndex hourFileIndex(hourFilePath);
+
+  ASSERT_EQ(hourFileIndex.entries().size(), 3U);
+  EXPECT_EQ(hourFileIndex.nbMessages(), static_cast<uint64_t>(kNbTrades));
+  EXPECT_EQ(hourFileIndex.firstUnixTimestampInMs(), TimestampToMillisecondsSinceEpoch(firstTp));
+  EXPECT_EQ(hourFileIndex.lastUnixTimestampInMs(), TimestampToMillisecondsSinceEpoch(pushedPublicTrades.back().time()));
+  EXPECT_EQ(hourFileIndex.entries()[1].nbMessages, ProtoHourFileIndex::kNbMessagesPerBlock);
+
+  const TimeWindow partialTimeWindow(firstTp + milliseconds{kNbMessagesPerBlock + 3},
+                                     firstTp + milliseconds{kNbMessagesPerBlock + 10});
+  const PublicTradeVector expectedPartialData(pushedPublicTrades.begin() + kNbMessagesPerBlock + 3,
+                                              pushedPublicTrades.begin() + kNbMessagesPerBlock + 10);
+  const MarketTimestampSet expectedMarketTimestampSet({MarketTimestamp(mk1, pushedPublicTrades.back().time())});
+  const MarketTimestampSet expectedPartialMarketTimestampSet(
+      {MarketTimestamp(mk1, firstTp + milliseconds{kNbMessagesPerBlock + 9})});
+
+  auto deserializer = createDeserializer();
+
+  EXPECT_EQ(deserializer.listMarkets(timeWindowAll), expectedMarketTimestampSet);
+  EXPECT_EQ(deserializer.listMarkets(partialTimeWindow), expectedPartialMarketTimestampSet);
+  EXPECT_EQ(deserializer.loadMarket(mk1, timeWindowAll), pushedPublicTrades);
+  EXPECT_EQ(deserializer.loadMarket(mk1, partialTimeWindow), expectedPartialData);
+
+  // Without index, deserializer should read the whole file and give the same results
+  std::filesystem::remove(ProtoHourFileIndex::IndexFilePath(hourFilePath));
+
+  EXPECT_TRUE(ProtoHourFileIndex(hourFilePath).empty());
+  EXPECT_EQ(deserializer.listMarkets(timeWindowAll), expectedMarketTimestampSet);
+  EXPECT_EQ(deserializer.listMarkets(partialTimeWindow), expectedPartialMarketTimestampSet);
+  EXPECT_EQ(deserializer.loadMarket(mk1, timeWindowAll), pushedPublicTrades);
+  EXPECT_EQ(deserializer.loadMarket(mk1, partialTimeWindow), expectedPartialData);
+}
+
+}  // namespace cct
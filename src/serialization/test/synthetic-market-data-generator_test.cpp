@@ -0,0 +1,120 @@
+#include "synthetic-market-data-generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <string>
+
+#include "cct_exception.hpp"
+#include "market-order-book-vector.hpp"
+#include "market.hpp"
+#include "proto-constants.hpp"
+#include "proto-market-data-deserializer.hpp"
+#include "public-trade-vector.hpp"
+#include "serialization-tools.hpp"
+#include "time-window.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+class SyntheticMarketDataGeneratorTest : public ::testing::Test {
+ protected:
+  SyntheticMarketDataGeneratorTest() {
+    config.market = market;
+    config.startMidPrice = MonetaryAmount(2500);
+    config.timeWindow = timeWindow;
+    config.depth = 5;
+    config.nbTradesPerSecond = 2;
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dataDir); }
+
+  std::string dataDir = (std::filesystem::temp_directory_path() / "cct-synthetic-market-data-test").string();
+  std::string_view exchangeName = "binance";
+  Market market{"ETH", "EUR"};
+  // Crosses an hour and a day boundary
+  TimePoint from = std::chrono::sys_days{std::chrono::year{2024} / 3 / 10} - std::chrono::minutes(5);
+  TimeWindow timeWindow{from, std::chrono::minutes(10)};
+  SyntheticMarketDataGenerator::Config config;
+};
+
+TEST_F(SyntheticMarketDataGeneratorTest, GenerateThenDeserialize) {
+  const auto stats = SyntheticMarketDataGenerator(config).generate(dataDir, exchangeName);
+
+  EXPECT_EQ(stats.nbMarketOrderBooks, 600);
+  EXPECT_GT(stats.nbPublicTrades, 0);
+
+  const auto marketSubPath =
+      ComputeProtoSubPath(dataDir, exchangeName, kSubPathMarketOrderBooks) / std::string_view{market.str()};
+  EXPECT_TRUE(std::filesystem::exists(marketSubPath / "2024" / "03" / "09" / ComputeProtoFileName(23)));
+  EXPECT_TRUE(std::filesystem::exists(marketSubPath / "2024" / "03" / "10" / ComputeProtoFileName(0)));
+
+  ProtoMarketDataDeserializer deserializer(dataDir, exchangeName);
+
+  const auto marketOrderBooks = deserializer.pullMarketOrderBooks(market, timeWindow);
+
+  ASSERT_EQ(static_cast<int64_t>(marketOrderBooks.size()), stats.nbMarketOrderBooks);
+  for (const auto &marketOrderBook : marketOrderBooks) {
+    EXPECT_TRUE(marketOrderBook.isValid());
+    EXPECT_EQ(marketOrderBook.market(), market);
+    EXPECT_EQ(marketOrderBook.nbAskPrices(), config.depth);
+    EXPECT_EQ(marketOrderBook.nbBidPrices(), config.depth);
+  }
+
+  const auto publicTrades = deserializer.pullTrades(market, timeWindow);
+
+  EXPECT_EQ(static_cast<int64_t>(publicTrades.size()), stats.nbPublicTrades);
+  for (const auto &publicTrade : publicTrades) {
+    EXPECT_TRUE(publicTrade.isValid());
+    EXPECT_TRUE(timeWindow.contains(publicTrade.time()));
+  }
+}
+
+TEST_F(SyntheticMarketDataGeneratorTest, DeterministicForGivenSeed) {
+  const auto stats1 = SyntheticMarketDataGenerator(config).generate(dataDir, "exchange1");
+  const auto stats2 = SyntheticMarketDataGenerator(config).generate(dataDir, "exchange2");
+
+  EXPECT_EQ(stats1.nbMarketOrderBooks, stats2.nbMarketOrderBooks);
+  EXPECT_EQ(stats1.nbPublicTrades, stats2.nbPublicTrades);
+
+  ProtoMarketDataDeserializer deserializer1(dataDir, "exchange1");
+  ProtoMarketDataDeserializer deserializer2(dataDir, "exchange2");
+
+  EXPECT_EQ(deserializer1.pullMarketOrderBooks(market, timeWindow),
+            deserializer2.pullMarketOrderBooks(market, timeWindow));
+  EXPECT_EQ(deserializer1.pullTrades(market, timeWindow), deserializer2.pullTrades(market, timeWindow));
+}
+
+TEST_F(SyntheticMarketDataGeneratorTest, CompactThenDeserializeByChunks) {
+  SyntheticMarketDataGenerator(config).generate(dataDir, exchangeName);
+
+  ProtoMarketDataDeserializer deserializer(dataDir, exchangeName);
+
+  const auto marketOrderBooks = deserializer.pullMarketOrderBooks(market, timeWindow);
+  const auto publicTrades = deserializer.pullTrades(market, timeWindow);
+
+  EXPECT_EQ(deserializer.compactMarketData(market), 2);
+
+  // Like a replay, pulls the data by chunks, all served by the same mapped columnar files
+  static constexpr auto kChunkDuration = std::chrono::minutes(1);
+
+  MarketOrderBookVector chunkedMarketOrderBooks;
+  PublicTradeVector chunkedPublicTrades;
+  for (TimeWindow chunk(from, kChunkDuration); chunk.from() < timeWindow.to(); chunk += kChunkDuration) {
+    std::ranges::copy(deserializer.pullMarketOrderBooks(market, chunk), std::back_inserter(chunkedMarketOrderBooks));
+    std::ranges::copy(deserializer.pullTrades(market, chunk), std::back_inserter(chunkedPublicTrades));
+  }
+
+  EXPECT_EQ(chunkedMarketOrderBooks, marketOrderBooks);
+  EXPECT_EQ(chunkedPublicTrades, publicTrades);
+}
+
+TEST_F(SyntheticMarketDataGeneratorTest, InvalidConfig) {
+  config.depth = 0;
+  EXPECT_THROW(SyntheticMarketDataGenerator{config}, exception);
+}
+
+}  // namespace cct
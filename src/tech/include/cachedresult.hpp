@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -10,6 +12,7 @@
 #include "cachedresultvault.hpp"
 #include "cct_fixedcapacityvector.hpp"
 #include "cct_hash.hpp"
+#include "cct_log.hpp"
 #include "timedef.hpp"
 
 namespace cct {
@@ -23,6 +26,26 @@ class CachedResultOptionsT {
   CachedResultOptionsT(DurationT refreshPeriod, CachedResultVaultT<DurationT> &cacheResultVault)
       : _refreshPeriod(refreshPeriod), _pCacheResultVault(std::addressof(cacheResultVault)) {}
 
+  /// Enables refresh ahead of the values accessed from the cache. When the vault is asked to refresh ahead its cached
+  /// results, the values older than 'refreshAheadPeriod' (the soft expiry) are recomputed before reaching
+  /// 'refreshPeriod' (the hard expiry), at which they would otherwise be recomputed synchronously by get().
+  /// A non-positive refresh ahead period, or a refresh ahead period not smaller than the refresh period, disables it.
+  CachedResultOptionsT(DurationT refreshPeriod, DurationT refreshAheadPeriod,
+                       CachedResultVaultT<DurationT> &cacheResultVault)
+      : _refreshPeriod(refreshPeriod),
+        _refreshAheadPeriod(refreshAheadPeriod),
+        _pCacheResultVault(std::addressof(cacheResultVault)) {}
+
+  /// Only used by ConcurrentCachedResult: the calls to the functors of all the cached results sharing 'funcMutex' are
+  /// serialized, which is needed when their functors share a resource that is not thread safe (a CurlHandle for
+  /// instance). It is recursive, as functors may get values from the other cached results sharing it.
+  CachedResultOptionsT(DurationT refreshPeriod, DurationT refreshAheadPeriod,
+                       CachedResultVaultT<DurationT> &cacheResultVault, std::recursive_mutex &funcMutex)
+      : _refreshPeriod(refreshPeriod),
+        _refreshAheadPeriod(refreshAheadPeriod),
+        _pCacheResultVault(std::addressof(cacheResultVault)),
+        _pFuncMutex(std::addressof(funcMutex)) {}
+
  private:
   template <class, class, class...>
   friend class CachedResultWithArgs;
@@ -30,8 +53,13 @@ class CachedResultOptionsT {
   template <class, class>
   friend class CachedResultWithoutArgs;
 
+  template <class, class, class...>
+  friend class ConcurrentCachedResultImpl;
+
   DurationT _refreshPeriod;
+  DurationT _refreshAheadPeriod{};
   CachedResultVaultT<DurationT> *_pCacheResultVault = nullptr;
+  std::recursive_mutex *_pFuncMutex = nullptr;
 };
 }  // namespace details
 
@@ -60,12 +88,14 @@ class CachedResultWithArgs : public CachedResultBase<typename ClockT::duration>
 
     ResultType _result;
     TimePoint _lastUpdatedTs;
+    bool _accessedSinceUpdate = false;
   };
 
  public:
   template <class... TArgs>
   explicit CachedResultWithArgs(CachedResultOptionsT<Duration> opts, TArgs &&...args)
-      : CachedResultBase<Duration>(opts._refreshPeriod), _func(std::forward<TArgs &&>(args)...) {
+      : CachedResultBase<Duration>(opts._refreshPeriod, opts._refreshAheadPeriod),
+        _func(std::forward<TArgs &&>(args)...) {
     if (opts._pCacheResultVault) {
       opts._pCacheResultVault->registerCachedResult(*this);
     }
@@ -76,7 +106,7 @@ class CachedResultWithArgs : public CachedResultBase<typename ClockT::duration>
   CachedResultWithArgs &operator=(const CachedResultWithArgs &) = delete;
   CachedResultWithArgs &operator=(CachedResultWithArgs &&) = delete;
 
-  ~CachedResultWithArgs() = default;
+  ~CachedResultWithArgs() override = default;
 
   /// Sets given value associated to the key built with given parameters,
   /// if given timestamp is more recent than the one associated to the value already present at this key (if any)
@@ -115,6 +145,7 @@ class CachedResultWithArgs : public CachedResultBase<typename ClockT::duration>
         this->_refreshPeriod <= nowTime - it->second._lastUpdatedTs) {
       it->second = Value(flattenTuple, std::move(key), nowTime);
     }
+    it->second._accessedSinceUpdate = true;
     return it->second._result;
   }
 
@@ -129,7 +160,41 @@ class CachedResultWithArgs : public CachedResultBase<typename ClockT::duration>
     return {std::addressof(it->second._result), it->second._lastUpdatedTs};
   }
 
+  /// Retrieve a pointer to the value associated to the key built with given parameters, only if a call to get() with
+  /// the same parameters would return it without recomputing it. Otherwise, returns a nullptr.
+  template <class... Args>
+  const ResultType *retrieveIfUpToDate(Args &&...funcArgs) const {
+    if (this->_state == State::kForceUniqueRefresh) {
+      return nullptr;
+    }
+    auto it = _data.find(TKey(std::forward<Args &&>(funcArgs)...));
+    if (it == _data.end() ||
+        (this->_state != State::kForceCache && this->_refreshPeriod <= ClockT::now() - it->second._lastUpdatedTs)) {
+      return nullptr;
+    }
+    return std::addressof(it->second._result);
+  }
+
  private:
+  int refreshAhead(Duration horizon) override {
+    const auto nowTime = ClockT::now();
+    const auto flattenTuple = [this](auto &&...values) { return _func(std::forward<decltype(values) &&>(values)...); };
+
+    int nbRefreshedValues = 0;
+    for (auto &[key, value] : _data) {
+      if (value._accessedSinceUpdate && this->_refreshAheadPeriod <= nowTime + horizon - value._lastUpdatedTs) {
+        try {
+          value = Value(flattenTuple, key, nowTime);
+          ++nbRefreshedValues;
+        } catch (const std::exception &ex) {
+          // Current value is kept, it will be recomputed synchronously by get() once it expires
+          log::warn("Unable to refresh ahead cached value: {}", ex.what());
+        }
+      }
+    }
+    return nbRefreshedValues;
+  }
+
   void checkPeriodicRehash() {
     static constexpr decltype(this->_flushCounter) kFlushCheckCounter = 20000;
     if (++this->_flushCounter < kFlushCheckCounter) {
@@ -167,7 +232,8 @@ class CachedResultWithoutArgs : public CachedResultBase<typename ClockT::duratio
 
   template <class... TArgs>
   explicit CachedResultWithoutArgs(CachedResultOptionsT<Duration> opts, TArgs &&...args)
-      : CachedResultBase<Duration>(opts._refreshPeriod), _func(std::forward<TArgs &&>(args)...) {
+      : CachedResultBase<Duration>(opts._refreshPeriod, opts._refreshAheadPeriod),
+        _func(std::forward<TArgs &&>(args)...) {
     if (opts._pCacheResultVault) {
       opts._pCacheResultVault->registerCachedResult(*this);
     }
@@ -178,7 +244,7 @@ class CachedResultWithoutArgs : public CachedResultBase<typename ClockT::duratio
   CachedResultWithoutArgs &operator=(const CachedResultWithoutArgs &) = delete;
   CachedResultWithoutArgs &operator=(CachedResultWithoutArgs &&) = delete;
 
-  ~CachedResultWithoutArgs() = default;
+  ~CachedResultWithoutArgs() override = default;
 
   /// Sets given value for given time stamp, if time stamp currently associated to last value is older.
   template <class ResultTypeT>
@@ -215,6 +281,7 @@ class CachedResultWithoutArgs : public CachedResultBase<typename ClockT::duratio
       _lastUpdatedTs = nowTime;
     }
 
+    _accessedSinceUpdate = true;
     return _resultStorage.front();
   }
 
@@ -229,9 +296,28 @@ class CachedResultWithoutArgs : public CachedResultBase<typename ClockT::duratio
 
   [[nodiscard]] bool isResultConstructed() const noexcept { return !_resultStorage.empty(); }
 
+  int refreshAhead(Duration horizon) override {
+    const auto nowTime = ClockT::now();
+    if (!_accessedSinceUpdate || !isResultConstructed() ||
+        nowTime + horizon - _lastUpdatedTs < this->_refreshAheadPeriod) {
+      return 0;
+    }
+    try {
+      _resultStorage.front() = _func();
+    } catch (const std::exception &ex) {
+      // Current value is kept, it will be recomputed synchronously by get() once it expires
+      log::warn("Unable to refresh ahead cached value: {}", ex.what());
+      return 0;
+    }
+    _lastUpdatedTs = nowTime;
+    _accessedSinceUpdate = false;
+    return 1;
+  }
+
   T _func;
   ResultStorage _resultStorage;
   TimePoint _lastUpdatedTs;
+  bool _accessedSinceUpdate = false;
 };
 
 template <class ClockT, class T, class... FuncTArgs>
@@ -249,6 +335,7 @@ using CachedResultImpl = std::conditional_t<sizeof...(FuncTArgs) == 0, CachedRes
 ///    invalidated by get() calls.
 /// In all cases, CachedResult is not moveable nor copyable, because it would require complex logic for
 /// CachedResultVault registers based on addresses of objects.
+/// Optionally, values can be refreshed ahead of their expiry by the CachedResultVault (see CachedResultOptions).
 template <class F, class... FuncTArgs>
 using CachedResult = details::CachedResultImpl<Clock, F, FuncTArgs...>;
 
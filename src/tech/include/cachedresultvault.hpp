@@ -17,13 +17,27 @@ class CachedResultBase {
 
   enum class State : int8_t { kStandardRefresh, kForceUniqueRefresh, kForceCache };
 
-  explicit CachedResultBase(DurationT refreshPeriod) : _refreshPeriod(refreshPeriod) {}
+  explicit CachedResultBase(DurationT refreshPeriod, DurationT refreshAheadPeriod = {})
+      : _refreshPeriod(refreshPeriod), _refreshAheadPeriod(refreshAheadPeriod) {}
+
+  virtual ~CachedResultBase() = default;
 
   void freeze() noexcept { _state = State::kForceUniqueRefresh; }
 
   void unfreeze() noexcept { _state = State::kStandardRefresh; }
 
+  [[nodiscard]] bool isRefreshAheadEnabled() const noexcept {
+    return _refreshAheadPeriod > DurationT{} && _refreshAheadPeriod < _refreshPeriod &&
+           _state == State::kStandardRefresh;
+  }
+
+  /// Recomputes the values that have been accessed since their last update, and that will be at least as old as the
+  /// refresh ahead period in 'horizon' from now.
+  /// Returns the number of recomputed values.
+  virtual int refreshAhead(DurationT horizon) = 0;
+
   DurationT _refreshPeriod;
+  DurationT _refreshAheadPeriod;
   uint32_t _flushCounter{};
   State _state = State::kStandardRefresh;
 };
@@ -51,6 +65,23 @@ class CachedResultVaultT {
     }
   }
 
+  /// Refreshes ahead of their expiry the values of the registered cached results having a refresh ahead period,
+  /// so that they can still be served from the cache at next access, expected in 'horizon' from now.
+  /// Only values that have been accessed since their last update are recomputed.
+  /// It should be called when the cached results are not used concurrently, typically during idle times.
+  /// Returns the number of recomputed values.
+  int refreshAhead(DurationT horizon) {
+    int nbRefreshedValues = 0;
+    if (!_allFrozen) {
+      for (CachedResultBase<DurationT> *p : _cachedResults) {
+        if (p->isRefreshAheadEnabled()) {
+          nbRefreshedValues += p->refreshAhead(horizon);
+        }
+      }
+    }
+    return nbRefreshedValues;
+  }
+
  private:
   using CachedResultPtrs = vector<CachedResultBase<DurationT> *>;
 
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "cachedresult.hpp"
+#include "cachedresultvault.hpp"
+#include "cct_hash.hpp"
+#include "cct_log.hpp"
+#include "cct_vector.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+namespace details {
+
+/// Thread safe version of CachedResultWithArgs, allowing concurrent readers to share cached values without any
+/// external lock:
+///  - values are stored in a fixed number of shards, each protected by its own mutex held only for the duration of
+///    the lookup (never during the computation of a value)
+///  - values are immutable and returned as shared pointers, so that a reader is never invalidated by a concurrent
+///    update of the same key (RCU-like)
+///  - calls to the underlying functor are serialized, as it usually holds a non thread safe resource (a CurlHandle
+///    for instance). This is the only lock held during the computation of a value. It can be shared with other cached
+///    results using the same resource (see CachedResultOptions).
+///  - concurrent misses for the same key trigger a single computation: other callers wait for the functor lock, and
+///    then return the value computed in the meantime.
+/// Vault operations (freeze, unfreeze, refresh ahead) should not be called concurrently with get() and set().
+template <class ClockT, class T, class... FuncTArgs>
+class ConcurrentCachedResultImpl : public CachedResultBase<typename ClockT::duration> {
+ public:
+  using ResultType = std::remove_cvref_t<decltype(std::declval<T>()(std::declval<FuncTArgs>()...))>;
+  using ResultPtr = std::shared_ptr<const ResultType>;
+  using TimePoint = ClockT::time_point;
+  using Duration = ClockT::duration;
+  using State = CachedResultBase<Duration>::State;
+
+ private:
+  using TKey = std::tuple<std::remove_cvref_t<FuncTArgs>...>;
+
+  static constexpr std::size_t kNbShards = sizeof...(FuncTArgs) == 0 ? 1 : 16;
+
+  struct Value {
+    ResultPtr _pResult;
+    TimePoint _lastUpdatedTs;
+    bool _accessedSinceUpdate = false;
+  };
+
+  // Aligned on a typical cache line size to avoid false sharing between shards' mutexes
+  struct alignas(64) Shard {
+    mutable std::mutex _mutex;
+    std::unordered_map<TKey, Value, HashTuple> _data;
+    uint32_t _flushCounter{};
+  };
+
+ public:
+  template <class... TArgs>
+  explicit ConcurrentCachedResultImpl(CachedResultOptionsT<Duration> opts, TArgs &&...args)
+      : CachedResultBase<Duration>(opts._refreshPeriod, opts._refreshAheadPeriod),
+        _func(std::forward<TArgs &&>(args)...),
+        _pFuncMutex(opts._pFuncMutex == nullptr ? std::addressof(_ownFuncMutex) : opts._pFuncMutex) {
+    if (opts._pCacheResultVault) {
+      opts._pCacheResultVault->registerCachedResult(*this);
+    }
+  }
+
+  ConcurrentCachedResultImpl(const ConcurrentCachedResultImpl &) = delete;
+  ConcurrentCachedResultImpl(ConcurrentCachedResultImpl &&) = delete;
+  ConcurrentCachedResultImpl &operator=(const ConcurrentCachedResultImpl &) = delete;
+  ConcurrentCachedResultImpl &operator=(ConcurrentCachedResultImpl &&) = delete;
+
+  ~ConcurrentCachedResultImpl() override = default;
+
+  /// Sets given value associated to the key built with given parameters, if given timestamp is more recent than the
+  /// one associated to the value already present at this key (if any).
+  template <class ResultTypeT, class... Args>
+  void set(ResultTypeT &&val, TimePoint timePoint, Args &&...funcArgs) {
+    TKey key(std::forward<Args &&>(funcArgs)...);
+    Shard &shard = getShard(key);
+
+    std::lock_guard<std::mutex> guard(shard._mutex);
+    Value &value = shard._data[std::move(key)];
+    if (!value._pResult || value._lastUpdatedTs < timePoint) {
+      value._pResult = std::make_shared<const ResultType>(std::forward<ResultTypeT>(val));
+      value._lastUpdatedTs = timePoint;
+    }
+  }
+
+  /// Get the latest value associated to the key built with given parameters.
+  /// If the value is too old according to refresh period, it will be recomputed automatically, by the first caller
+  /// only if several threads ask for the same key at the same time.
+  /// Exceptions thrown by the functor are propagated to the caller, and nothing is cached in this case.
+  template <class... Args>
+  ResultPtr get(Args &&...funcArgs) {
+    checkForceUniqueRefresh();
+
+    TKey key(std::forward<Args &&>(funcArgs)...);
+    Shard &shard = getShard(key);
+
+    {
+      std::lock_guard<std::mutex> guard(shard._mutex);
+      const auto nowTime = ClockT::now();
+      checkPeriodicRehash(shard, nowTime);
+
+      Value &value = shard._data[key];
+      value._accessedSinceUpdate = true;
+      if (isUpToDate(value, nowTime)) {
+        return value._pResult;
+      }
+    }
+
+    std::lock_guard<std::recursive_mutex> funcGuard(*_pFuncMutex);
+
+    {
+      // Another caller may have computed this value while we were waiting for the functor lock
+      std::lock_guard<std::mutex> guard(shard._mutex);
+      const Value &value = shard._data[key];
+      if (isUpToDate(value, ClockT::now())) {
+        return value._pResult;
+      }
+    }
+
+    return compute(shard, std::move(key));
+  }
+
+  /// Get the value associated to the key built with given parameters if it is still up to date, that is, if a call to
+  /// get() with the same parameters would return it without recomputing it. Otherwise, returns a nullptr.
+  template <class... Args>
+  ResultPtr retrieveIfUpToDate(Args &&...funcArgs) const {
+    if (loadState() == State::kForceUniqueRefresh) {
+      return nullptr;
+    }
+    TKey key(std::forward<Args &&>(funcArgs)...);
+    const Shard &shard = getShard(key);
+
+    std::lock_guard<std::mutex> guard(shard._mutex);
+    auto it = shard._data.find(key);
+    if (it == shard._data.end() || !isUpToDate(it->second, ClockT::now())) {
+      return nullptr;
+    }
+    return it->second._pResult;
+  }
+
+  /// Retrieve a {pointer, lastUpdateTime} to latest value associated to the key built with given parameters.
+  /// If no value has been computed for this key, returns a nullptr.
+  template <class... Args>
+  std::pair<ResultPtr, TimePoint> retrieve(Args &&...funcArgs) const {
+    TKey key(std::forward<Args &&>(funcArgs)...);
+    const Shard &shard = getShard(key);
+
+    std::lock_guard<std::mutex> guard(shard._mutex);
+    auto it = shard._data.find(key);
+    if (it == shard._data.end() || !it->second._pResult) {
+      return {};
+    }
+    return {it->second._pResult, it->second._lastUpdatedTs};
+  }
+
+ private:
+  Shard &getShard(const TKey &key) { return _shards[HashTuple{}(key) % kNbShards]; }
+  const Shard &getShard(const TKey &key) const { return _shards[HashTuple{}(key) % kNbShards]; }
+
+  State loadState() const { return std::atomic_ref<State>(const_cast<State &>(this->_state)).load(); }
+
+  void checkForceUniqueRefresh() {
+    State expectedState = State::kForceUniqueRefresh;
+    if (std::atomic_ref<State>(this->_state).compare_exchange_strong(expectedState, State::kForceCache)) {
+      for (Shard &shard : _shards) {
+        std::lock_guard<std::mutex> guard(shard._mutex);
+        shard._data.clear();
+      }
+    }
+  }
+
+  bool isUpToDate(const Value &value, TimePoint nowTime) const {
+    return value._pResult &&
+           (loadState() == State::kForceCache || nowTime - value._lastUpdatedTs < this->_refreshPeriod);
+  }
+
+  /// Computes the value of given key and stores it in its shard.
+  /// Caller should hold the functor mutex, but not the shard mutex.
+  ResultPtr compute(Shard &shard, TKey key) {
+    const auto computeTime = ClockT::now();
+    auto pResult = std::make_shared<const ResultType>(std::apply(_func, key));
+
+    std::lock_guard<std::mutex> guard(shard._mutex);
+    Value &value = shard._data[std::move(key)];
+    if (!value._pResult || value._lastUpdatedTs <= computeTime) {
+      value._pResult = pResult;
+      value._lastUpdatedTs = computeTime;
+    }
+    return pResult;
+  }
+
+  int refreshAhead(Duration horizon) override {
+    const auto nowTime = ClockT::now();
+
+    int nbRefreshedValues = 0;
+    for (Shard &shard : _shards) {
+      vector<TKey> keysToRefresh;
+      {
+        std::lock_guard<std::mutex> guard(shard._mutex);
+        for (auto &[key, value] : shard._data) {
+          if (value._accessedSinceUpdate && value._pResult &&
+              this->_refreshAheadPeriod <= nowTime + horizon - value._lastUpdatedTs) {
+            value._accessedSinceUpdate = false;
+            keysToRefresh.push_back(key);
+          }
+        }
+      }
+
+      for (TKey &key : keysToRefresh) {
+        try {
+          std::lock_guard<std::recursive_mutex> funcGuard(*_pFuncMutex);
+          compute(shard, std::move(key));
+          ++nbRefreshedValues;
+        } catch (const std::exception &ex) {
+          // Current value is kept, it will be recomputed synchronously by get() once it expires
+          log::warn("Unable to refresh ahead cached value: {}", ex.what());
+        }
+      }
+    }
+    return nbRefreshedValues;
+  }
+
+  void checkPeriodicRehash(Shard &shard, TimePoint nowTime) {
+    static constexpr decltype(shard._flushCounter) kFlushCheckCounter = 20000;
+    if (++shard._flushCounter < kFlushCheckCounter) {
+      return;
+    }
+    shard._flushCounter = 0;
+
+    std::erase_if(shard._data, [this, nowTime](const auto &keyValue) {
+      return this->_refreshPeriod < nowTime - keyValue.second._lastUpdatedTs;
+    });
+
+    shard._data.rehash(shard._data.size());
+  }
+
+  T _func;
+  std::recursive_mutex _ownFuncMutex;
+  std::recursive_mutex *_pFuncMutex;
+  std::array<Shard, kNbShards> _shards;
+};
+
+}  // namespace details
+
+/// Thread safe version of CachedResult, which can be shared by several threads without external synchronization.
+/// Contrary to CachedResult, values are returned as shared pointers to const values, that stay valid even if the
+/// cached value is updated in the meantime.
+/// The underlying functor is never called concurrently, nor concurrently with the functors of the other cached results
+/// sharing its functor mutex, if any.
+/// As CachedResult, it is not moveable nor copyable.
+template <class F, class... FuncTArgs>
+using ConcurrentCachedResult = details::ConcurrentCachedResultImpl<Clock, F, FuncTArgs...>;
+
+}  // namespace cct
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace cct {
+
+/// Read-only RAII view of a whole file mapped in memory.
+/// Mapping is lazy by nature (pages are loaded by the OS on first access), which makes it a good fit for large,
+/// immutable files from which only small parts are read at once.
+/// A default constructed (or moved from) object maps nothing and exposes an empty span.
+class MemoryMappedFile {
+ public:
+  MemoryMappedFile() noexcept = default;
+
+  /// Maps the whole file at given path in read only mode.
+  /// Throws an exception if the file cannot be opened or mapped.
+  explicit MemoryMappedFile(const std::filesystem::path &filePath);
+
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  MemoryMappedFile(MemoryMappedFile &&rhs) noexcept { swap(rhs); }
+
+  MemoryMappedFile &operator=(MemoryMappedFile &&rhs) noexcept {
+    if (this != &rhs) {
+      MemoryMappedFile(std::move(rhs)).swap(*this);
+    }
+    return *this;
+  }
+
+  ~MemoryMappedFile();
+
+  /// Get a view on the whole mapped content. Memory is valid as long as this object is alive.
+  std::span<const std::byte> data() const noexcept { return {_pData, _size}; }
+
+  std::size_t size() const noexcept { return _size; }
+
+  bool empty() const noexcept { return _size == 0; }
+
+  void swap(MemoryMappedFile &rhs) noexcept {
+    std::swap(_pData, rhs._pData);
+    std::swap(_size, rhs._size);
+#ifdef _WIN32
+    std::swap(_fileHandle, rhs._fileHandle);
+    std::swap(_mappingHandle, rhs._mappingHandle);
+#endif
+  }
+
+ private:
+  const std::byte *_pData{};
+  std::size_t _size{};
+#ifdef _WIN32
+  void *_fileHandle{};
+  void *_mappingHandle{};
+#endif
+};
+
+}  // namespace cct
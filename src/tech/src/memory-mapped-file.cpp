@@ -0,0 +1,106 @@
+#include "memory-mapped-file.hpp"
+
+#include <cstddef>
+#include <filesystem>
+
+#include "cct_exception.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace cct {
+
+#ifdef _WIN32
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path &filePath) {
+  HANDLE fileHandle = ::CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE) {
+    throw exception("Cannot open {} for memory mapping (error {})", filePath.string(), ::GetLastError());
+  }
+  _fileHandle = fileHandle;
+
+  LARGE_INTEGER fileSize;
+  if (::GetFileSizeEx(fileHandle, &fileSize) == 0) {
+    ::CloseHandle(fileHandle);
+    throw exception("Cannot get size of {} (error {})", filePath.string(), ::GetLastError());
+  }
+  if (fileSize.QuadPart == 0) {
+    // Empty files cannot be mapped - this object will simply expose an empty span
+    return;
+  }
+
+  HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mappingHandle == nullptr) {
+    ::CloseHandle(fileHandle);
+    throw exception("Cannot create file mapping of {} (error {})", filePath.string(), ::GetLastError());
+  }
+  _mappingHandle = mappingHandle;
+
+  void *pData = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+  if (pData == nullptr) {
+    ::CloseHandle(mappingHandle);
+    ::CloseHandle(fileHandle);
+    throw exception("Cannot map view of {} (error {})", filePath.string(), ::GetLastError());
+  }
+
+  _pData = static_cast<const std::byte *>(pData);
+  _size = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (_pData != nullptr) {
+    ::UnmapViewOfFile(_pData);
+  }
+  if (_mappingHandle != nullptr) {
+    ::CloseHandle(_mappingHandle);
+  }
+  if (_fileHandle != nullptr) {
+    ::CloseHandle(_fileHandle);
+  }
+}
+#else
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path &filePath) {
+  const int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw exception("Cannot open {} for memory mapping: {}", filePath.string(), std::strerror(errno));
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) == -1) {
+    ::close(fd);
+    throw exception("Cannot stat {}: {}", filePath.string(), std::strerror(errno));
+  }
+
+  if (fileStat.st_size != 0) {
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    void *pData = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (pData == MAP_FAILED) {
+      ::close(fd);
+      throw exception("Cannot memory map {}: {}", filePath.string(), std::strerror(errno));
+    }
+    _pData = static_cast<const std::byte *>(pData);
+    _size = size;
+  }
+
+  // The mapping stays valid after closing the file descriptor
+  ::close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (_pData != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    ::munmap(const_cast<std::byte *>(_pData), _size);
+  }
+}
+#endif
+
+}  // namespace cct
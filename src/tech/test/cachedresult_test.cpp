@@ -124,6 +124,19 @@ TEST_F(CachedResultTest, RetrieveFromCache) {
   EXPECT_EQ(ts, SteadyClock::time_point{});
 }
 
+TEST_F(CachedResultTest, RetrieveIfUpToDate) {
+  EXPECT_EQ(cachedResult.retrieveIfUpToDate(3, 4), nullptr);
+
+  cachedResult.set(42, SteadyClock::now(), 3, 4);
+  const int *ptr = cachedResult.retrieveIfUpToDate(3, 4);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(*ptr, 42);
+
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(cachedResult.retrieveIfUpToDate(3, 4), nullptr);
+  EXPECT_EQ(cachedResult.get(3, 4), 7);
+}
+
 class CachedResultTestZeroRefreshTime : public ::testing::Test {
  protected:
   using CachedResType = CachedResultSteadyClock<Incr, int, int>;
@@ -156,4 +169,51 @@ TEST_F(CachedResultTestMaxRefreshTime, GetCache) {
   EXPECT_EQ(cachedResult.get(3, 4), 7);
 }
 
+class CachedResultTestRefreshAhead : public ::testing::Test {
+ protected:
+  static constexpr SteadyClock::duration kRefreshAheadTime = kCacheTime / 2;
+
+  CachedResultVaultSteadyClock vault;
+  CachedResultSteadyClock<Incr> cachedResult{CachedResultOptionsSteadyClock(kCacheTime, kRefreshAheadTime, vault)};
+  CachedResultSteadyClock<Incr, int> cachedResultWithArgs{
+      CachedResultOptionsSteadyClock(kCacheTime, kRefreshAheadTime, vault)};
+};
+
+TEST_F(CachedResultTestRefreshAhead, RefreshAheadOnlyAccessedValues) {
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 0);
+
+  EXPECT_EQ(cachedResult.get(), 1);
+  EXPECT_EQ(cachedResultWithArgs.get(3), 3);
+
+  // Values will be older than the refresh ahead time in the given horizon
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 2);
+  EXPECT_EQ(*cachedResult.retrieve().first, 2);
+  EXPECT_EQ(*cachedResultWithArgs.retrieve(3).first, 6);
+
+  // Values have not been accessed since their last refresh
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 0);
+
+  EXPECT_EQ(cachedResult.get(), 2);
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 1);
+  EXPECT_EQ(cachedResult.get(), 3);
+}
+
+TEST_F(CachedResultTestRefreshAhead, ValueServedUntilHardExpiry) {
+  EXPECT_EQ(cachedResult.get(), 1);
+  std::this_thread::sleep_for(kRefreshAheadTime);
+
+  // Refresh ahead is only made by the vault, value is still valid
+  EXPECT_EQ(cachedResult.get(), 1);
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(cachedResult.get(), 2);
+}
+
+TEST_F(CachedResultTestRefreshAhead, NoRefreshAheadWhenFrozen) {
+  EXPECT_EQ(cachedResult.get(), 1);
+  vault.freezeAll();
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 0);
+  vault.unfreezeAll();
+  EXPECT_EQ(vault.refreshAhead(kCacheTime), 1);
+}
+
 }  // namespace cct
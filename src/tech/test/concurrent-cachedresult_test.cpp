@@ -0,0 +1,192 @@
+#include "concurrent-cachedresult.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "cachedresultvault.hpp"
+#include "cct_vector.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+namespace {
+class SlowIncr {
+ public:
+  explicit SlowIncr(std::atomic<int> &nbCalls) : _nbCalls(nbCalls) {}
+
+  int operator()() {
+    std::this_thread::sleep_for(milliseconds(5));
+    return ++_nbCalls;
+  }
+
+  int operator()(int val) {
+    std::this_thread::sleep_for(milliseconds(5));
+    if (val < 0) {
+      throw std::invalid_argument("negative value");
+    }
+    return val + ++_nbCalls;
+  }
+
+ private:
+  std::atomic<int> &_nbCalls;
+};
+
+using SteadyClock = std::chrono::steady_clock;
+
+template <class CachedResultT>
+class NestedIncr {
+ public:
+  NestedIncr(CachedResultT &cachedResult, int &nbCalls) : _cachedResult(cachedResult), _nbCalls(nbCalls) {}
+
+  // Not atomic on purpose: calls are serialized by the shared functor mutex
+  int operator()(int val) { return *_cachedResult.get(val) + ++_nbCalls; }
+
+ private:
+  CachedResultT &_cachedResult;
+  int &_nbCalls;
+};
+
+constexpr SteadyClock::duration kCacheTime = milliseconds(50);
+constexpr auto kCacheExpireTime = kCacheTime + milliseconds(5);
+
+template <class T, class... FuncTArgs>
+using ConcurrentCachedResultSteadyClock = details::ConcurrentCachedResultImpl<SteadyClock, T, FuncTArgs...>;
+
+using CachedResultOptionsSteadyClock = details::CachedResultOptionsT<SteadyClock::duration>;
+
+using CachedResultVaultSteadyClock = CachedResultVaultT<SteadyClock::duration>;
+
+constexpr int kNbThreads = 8;
+
+}  // namespace
+
+class ConcurrentCachedResultTest : public ::testing::Test {
+ protected:
+  CachedResultVaultSteadyClock vault;
+  std::atomic<int> nbCalls{};
+  ConcurrentCachedResultSteadyClock<SlowIncr> cachedResultNoArgs{CachedResultOptionsSteadyClock(kCacheTime, vault),
+                                                                 nbCalls};
+  ConcurrentCachedResultSteadyClock<SlowIncr, int> cachedResult{CachedResultOptionsSteadyClock(kCacheTime, vault),
+                                                                nbCalls};
+};
+
+TEST_F(ConcurrentCachedResultTest, GetCache) {
+  EXPECT_EQ(*cachedResultNoArgs.get(), 1);
+  EXPECT_EQ(*cachedResultNoArgs.get(), 1);
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(*cachedResultNoArgs.get(), 2);
+}
+
+TEST_F(ConcurrentCachedResultTest, ConcurrentMissesSameKeyComputeOnce) {
+  vector<std::jthread> threads;
+  vector<int> results(kNbThreads);
+  for (int threadPos = 0; threadPos < kNbThreads; ++threadPos) {
+    threads.emplace_back([this, &results, threadPos] { results[threadPos] = *cachedResult.get(10); });
+  }
+  threads.clear();
+
+  EXPECT_EQ(nbCalls, 1);
+  for (int result : results) {
+    EXPECT_EQ(result, 11);
+  }
+}
+
+TEST_F(ConcurrentCachedResultTest, ConcurrentMissesDifferentKeys) {
+  vector<std::jthread> threads;
+  for (int threadPos = 0; threadPos < kNbThreads; ++threadPos) {
+    threads.emplace_back([this, threadPos] {
+      cachedResult.get(threadPos);
+      cachedResult.get(threadPos);
+    });
+  }
+  threads.clear();
+
+  EXPECT_EQ(nbCalls, kNbThreads);
+}
+
+TEST_F(ConcurrentCachedResultTest, ValueStaysValidAfterUpdate) {
+  auto pResult = cachedResult.get(3);
+  EXPECT_EQ(*pResult, 4);
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(*cachedResult.get(3), 5);
+  EXPECT_EQ(*pResult, 4);
+}
+
+TEST_F(ConcurrentCachedResultTest, ExceptionIsNotCached) {
+  EXPECT_THROW(cachedResult.get(-1), std::invalid_argument);
+  EXPECT_THROW(cachedResult.get(-1), std::invalid_argument);
+  EXPECT_EQ(nbCalls, 0);
+  EXPECT_EQ(*cachedResult.get(1), 2);
+}
+
+TEST_F(ConcurrentCachedResultTest, SetAndRetrieve) {
+  auto [pNoValue, noValueTime] = cachedResult.retrieve(42);
+  EXPECT_EQ(pNoValue, nullptr);
+
+  const auto nowTime = SteadyClock::now();
+  cachedResult.set(100, nowTime, 42);
+
+  auto [pValue, valueTime] = cachedResult.retrieve(42);
+  ASSERT_NE(pValue, nullptr);
+  EXPECT_EQ(*pValue, 100);
+  EXPECT_EQ(valueTime, nowTime);
+
+  // Older values are ignored
+  cachedResult.set(200, nowTime - milliseconds(1), 42);
+  EXPECT_EQ(*cachedResult.get(42), 100);
+  EXPECT_EQ(nbCalls, 0);
+}
+
+TEST_F(ConcurrentCachedResultTest, RetrieveIfUpToDate) {
+  EXPECT_EQ(cachedResult.retrieveIfUpToDate(1), nullptr);
+  EXPECT_EQ(*cachedResult.get(1), 2);
+
+  auto pValue = cachedResult.retrieveIfUpToDate(1);
+  ASSERT_NE(pValue, nullptr);
+  EXPECT_EQ(*pValue, 2);
+
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(cachedResult.retrieveIfUpToDate(1), nullptr);
+  EXPECT_EQ(nbCalls, 1);
+}
+
+TEST_F(ConcurrentCachedResultTest, SharedFuncMutexWithNestedGet) {
+  using InnerCachedResult = ConcurrentCachedResultSteadyClock<SlowIncr, int>;
+
+  std::recursive_mutex funcMutex;
+  int nbOuterCalls = 0;
+  InnerCachedResult innerCachedResult(CachedResultOptionsSteadyClock(kCacheTime, {}, vault, funcMutex), nbCalls);
+  ConcurrentCachedResultSteadyClock<NestedIncr<InnerCachedResult>, int> outerCachedResult(
+      CachedResultOptionsSteadyClock(kCacheTime, {}, vault, funcMutex), innerCachedResult, nbOuterCalls);
+
+  vector<std::jthread> threads;
+  for (int threadPos = 0; threadPos < kNbThreads; ++threadPos) {
+    threads.emplace_back([&, threadPos] {
+      if (threadPos % 2 == 0) {
+        outerCachedResult.get(threadPos % 4);
+      } else {
+        innerCachedResult.get(threadPos % 4);
+      }
+    });
+  }
+  threads.clear();
+
+  EXPECT_EQ(nbOuterCalls, 2);
+  EXPECT_EQ(nbCalls, 4);
+}
+
+TEST_F(ConcurrentCachedResultTest, Freeze) {
+  EXPECT_EQ(*cachedResult.get(1), 2);
+  vault.freezeAll();
+  EXPECT_EQ(*cachedResult.get(1), 3);
+  std::this_thread::sleep_for(kCacheExpireTime);
+  EXPECT_EQ(*cachedResult.get(1), 3);
+  vault.unfreezeAll();
+  EXPECT_EQ(*cachedResult.get(1), 4);
+}
+
+}  // namespace cct
@@ -0,0 +1,75 @@
+#include "memory-mapped-file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <utility>
+
+#include "cct_exception.hpp"
+
+namespace cct {
+
+class MemoryMappedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::filesystem::create_directories(dir); }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  std::filesystem::path writeFile(std::string_view fileName, std::string_view content) const {
+    auto filePath = dir / fileName;
+    std::ofstream ofs(filePath, std::ios::binary);
+    ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return filePath;
+  }
+
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "cct-memory-mapped-file-test";
+};
+
+TEST_F(MemoryMappedFileTest, DefaultConstructed) {
+  MemoryMappedFile memoryMappedFile;
+
+  EXPECT_TRUE(memoryMappedFile.empty());
+  EXPECT_TRUE(memoryMappedFile.data().empty());
+}
+
+TEST_F(MemoryMappedFileTest, NonExistingFile) {
+  EXPECT_THROW(MemoryMappedFile(dir / "this-file-does-not-exist"), exception);
+}
+
+TEST_F(MemoryMappedFileTest, EmptyFile) {
+  MemoryMappedFile memoryMappedFile(writeFile("empty", ""));
+
+  EXPECT_TRUE(memoryMappedFile.empty());
+}
+
+TEST_F(MemoryMappedFileTest, ReadContent) {
+  using namespace std::string_view_literals;
+  static constexpr std::string_view kContent = "some binary\0content"sv;
+
+  MemoryMappedFile memoryMappedFile(writeFile("content", kContent));
+
+  ASSERT_EQ(memoryMappedFile.size(), kContent.size());
+
+  const auto data = memoryMappedFile.data();
+  EXPECT_TRUE(std::ranges::equal(data, kContent, [](std::byte lhs, char rhs) { return lhs == std::byte(rhs); }));
+}
+
+TEST_F(MemoryMappedFileTest, Move) {
+  static constexpr std::string_view kContent = "abc";
+
+  MemoryMappedFile memoryMappedFile(writeFile("content", kContent));
+  MemoryMappedFile other(std::move(memoryMappedFile));
+
+  EXPECT_EQ(other.size(), kContent.size());
+  EXPECT_EQ(memoryMappedFile.size(), 0U);  // NOLINT(bugprone-use-after-move)
+
+  memoryMappedFile = std::move(other);
+
+  EXPECT_EQ(memoryMappedFile.size(), kContent.size());
+}
+
+}  // namespace cct
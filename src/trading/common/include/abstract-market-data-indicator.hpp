@@ -0,0 +1,23 @@
+#pragma once
+
+#include <span>
+
+namespace cct {
+
+class MarketOrderBook;
+class PublicTrade;
+
+/// Base class for stateful indicators computed incrementally from the market data.
+/// A market trader subscribes to the indicators it needs, they are then updated by the MarketDataView each time it
+/// advances to a new market order book, with only the new data. Their cost thus does not depend on the length of the
+/// history, contrary to indicators scanning all the past market data at each turn.
+class AbstractMarketDataIndicator {
+ public:
+  virtual ~AbstractMarketDataIndicator() = default;
+
+  /// Called once per market order book, with the public trades that occurred since the previous market order book.
+  /// Market order books and public trades are given in chronological order.
+  virtual void update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) = 0;
+};
+
+}  // namespace cct
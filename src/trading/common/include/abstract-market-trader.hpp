@@ -1,7 +1,10 @@
 #pragma once
 
+#include <span>
 #include <string_view>
 
+#include "abstract-market-data-indicator.hpp"
+#include "cct_vector.hpp"
 #include "trader-command.hpp"
 
 namespace cct {
@@ -23,12 +26,20 @@ class AbstractMarketTrader {
 
   const MarketTraderEngineState &marketTraderEngineState() const { return _marketTraderEngineState; }
 
+  /// Get the indicators subscribed by this market trader, in subscription order.
+  std::span<AbstractMarketDataIndicator *const> indicators() const { return _indicators; }
+
  protected:
   /// Constructs a new AbstractMarketTrader.
   /// @param name should be a view to a constant string as only a std::string_view will be stored in this object.
   AbstractMarketTrader(std::string_view name, const MarketTraderEngineState &marketTraderEngineState) noexcept;
 
+  /// Subscribes given indicator so that it is updated with each new market data before each call to 'trade'.
+  /// Indicator is not owned and should outlive this object (typically, it is a member of the derived class).
+  void subscribe(AbstractMarketDataIndicator &indicator) { _indicators.push_back(&indicator); }
+
  private:
+  vector<AbstractMarketDataIndicator *> _indicators;
   std::string_view _name;
   const MarketTraderEngineState &_marketTraderEngineState;
 };
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <span>
 
+#include "abstract-market-data-indicator.hpp"
 #include "marketorderbook.hpp"
 #include "publictrade.hpp"
 #include "timedef.hpp"
@@ -10,6 +11,7 @@
 namespace cct {
 
 /// A class providing a view to current and historical market data for the market trader.
+/// It also keeps the indicators subscribed by the market trader up to date.
 class MarketDataView {
  public:
   /// Get a reference to last (current for this turn) market order book
@@ -30,8 +32,10 @@ class MarketDataView {
   friend class MarketTraderEngine;
 
   MarketDataView(const MarketOrderBook *pOrderBooks, const PublicTrade *pPublicTradesBeg,
-                 const PublicTrade *pPublicTradesEnd) noexcept;
+                 const PublicTrade *pPublicTradesEnd,
+                 std::span<AbstractMarketDataIndicator *const> indicators = {}) noexcept;
 
+  /// Advances to next market order book, whose time is given, and updates the indicators with the new data.
   void advanceUntil(TimePoint marketOrderBookTs);
 
   const MarketOrderBook *_pOrderBooks;
@@ -40,6 +44,7 @@ class MarketDataView {
 
   const PublicTrade *_pCurrentTradesBeg;
   const PublicTrade *_pCurrentTradesEnd;
+  std::span<AbstractMarketDataIndicator *const> _indicators;
   std::size_t _currentOrderBookEndPos{};
 };
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <type_traits>
 
 #include "abstract-market-trader.hpp"
@@ -15,6 +16,7 @@
 #include "marketorderbook.hpp"
 #include "monetaryamount.hpp"
 #include "public-trade-vector.hpp"
+#include "publictrade.hpp"
 #include "trade-range-stats.hpp"
 #include "trader-command.hpp"
 
@@ -35,6 +37,14 @@ class MarketTraderEngine {
 
   TradeRangeStats tradeRange(MarketOrderBookVector &&marketOrderBooks, PublicTradeVector &&publicTrades);
 
+  /// Trade on an already validated range of market data, that is not modified so that it can be shared with other
+  /// engines of the same market (typically, engines of other algorithms during a replay).
+  TradeRangeStats tradeRange(std::span<const MarketOrderBook> marketOrderBooks,
+                             std::span<const PublicTrade> publicTrades);
+
+  /// Updates the state of the engine as if given already validated range had been consumed, without trading.
+  void skipRange(std::span<const MarketOrderBook> marketOrderBooks);
+
   const MarketTraderEngineState &marketTraderEngineState() const { return _marketTraderEngineState; }
 
   MarketTradingResult finalizeAndComputeResult();
@@ -1,7 +1,9 @@
 #include "market-data-view.hpp"
 
 #include <algorithm>
+#include <span>
 
+#include "abstract-market-data-indicator.hpp"
 #include "marketorderbook.hpp"
 #include "publictrade.hpp"
 #include "timedef.hpp"
@@ -9,12 +11,14 @@
 namespace cct {
 
 MarketDataView::MarketDataView(const MarketOrderBook *pOrderBooks, const PublicTrade *pPublicTradesBeg,
-                               const PublicTrade *pPublicTradesEnd) noexcept
+                               const PublicTrade *pPublicTradesEnd,
+                               std::span<AbstractMarketDataIndicator *const> indicators) noexcept
     : _pOrderBooks(pOrderBooks),
       _pPublicTradesBeg(pPublicTradesBeg),
       _pPublicTradesEnd(pPublicTradesEnd),
       _pCurrentTradesBeg(pPublicTradesBeg),
-      _pCurrentTradesEnd(pPublicTradesEnd) {}
+      _pCurrentTradesEnd(pPublicTradesBeg),
+      _indicators(indicators) {}
 
 void MarketDataView::advanceUntil(TimePoint marketOrderBookTs) {
   // Advance the public trades iterator until we reach one that occurred after our current market order book
@@ -24,6 +28,14 @@ void MarketDataView::advanceUntil(TimePoint marketOrderBookTs) {
       [marketOrderBookTs](const auto &publicTrade) { return publicTrade.time() < marketOrderBookTs; });
 
   ++_currentOrderBookEndPos;
+
+  if (!_indicators.empty()) {
+    const MarketOrderBook &marketOrderBook = currentMarketOrderBook();
+    const auto newPublicTrades = currentPublicTrades();
+    for (AbstractMarketDataIndicator *pIndicator : _indicators) {
+      pIndicator->update(marketOrderBook, newPublicTrades);
+    }
+  }
 }
 
 }  // namespace cct
\ No newline at end of file
@@ -120,6 +120,12 @@ TradeRangeStats MarketTraderEngine::validateRange(MarketOrderBookVector &&market
 
 TradeRangeStats MarketTraderEngine::tradeRange(MarketOrderBookVector &&marketOrderBooks,
                                                PublicTradeVector &&publicTrades) {
+  return tradeRange(std::span<const MarketOrderBook>(marketOrderBooks.data(), marketOrderBooks.size()),
+                    std::span<const PublicTrade>(publicTrades.data(), publicTrades.size()));
+}
+
+TradeRangeStats MarketTraderEngine::tradeRange(std::span<const MarketOrderBook> marketOrderBooks,
+                                               std::span<const PublicTrade> publicTrades) {
   // errors set to 0 here as it is for unchecked launch
   TradeRangeStats tradeRangeStats{
       {TradeRangeResultsStats{TimeWindow{}, static_cast<int32_t>(marketOrderBooks.size()), 0}},
@@ -142,8 +148,8 @@ TradeRangeStats MarketTraderEngine::tradeRange(MarketOrderBookVector &&marketOrd
             TimeToString(fromOrderBooksTime), _market, marketOrderBooks.size(), publicTrades.size());
 
   // Rolling window of data provided to underlying market trader with data up to latest market order book.
-  MarketDataView marketDataView(marketOrderBooks.data(), publicTrades.data(),
-                                publicTrades.data() + publicTrades.size());
+  MarketDataView marketDataView(marketOrderBooks.data(), publicTrades.data(), publicTrades.data() + publicTrades.size(),
+                                _marketTrader->indicators());
 
   for (const MarketOrderBook &marketOrderBook : marketOrderBooks) {
     // First check opened orders status with new market order book data that may match some
@@ -188,11 +194,17 @@ TradeRangeStats MarketTraderEngine::tradeRange(MarketOrderBookVector &&marketOrd
     }
   }
 
-  _lastMarketOrderBook = std::move(marketOrderBooks.back());
+  _lastMarketOrderBook = marketOrderBooks.back();
 
   return tradeRangeStats;
 }
 
+void MarketTraderEngine::skipRange(std::span<const MarketOrderBook> marketOrderBooks) {
+  if (!marketOrderBooks.empty()) {
+    _lastMarketOrderBook = marketOrderBooks.back();
+  }
+}
+
 MarketTradingResult MarketTraderEngine::finalizeAndComputeResult() {
   _marketTraderEngineState.cancelAllOpenedOrders();
 
@@ -7,6 +7,9 @@ namespace cct {
 
 class MarketDataView;
 
+/// Statistics computed by scanning the past market data of the MarketDataView at each call, in O(history).
+/// Algorithms needing them at each turn should rather subscribe to the equivalent incremental indicators
+/// (RollingPriceStats, RollingVwap, ExponentialMovingAverage, OhlcBars), updated in amortized O(1).
 class BasicStats {
  public:
   explicit BasicStats(const MarketDataView &marketDataView) : _marketDataView(marketDataView) {}
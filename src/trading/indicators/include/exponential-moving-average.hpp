@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "abstract-market-data-indicator.hpp"
+#include "currencycode.hpp"
+#include "monetaryamount.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Exponential moving average of the average prices of the market order books, updated in O(1).
+/// The smoothing factor is 2 / (nbPeriods + 1), one period being one point.
+class ExponentialMovingAverage : public AbstractMarketDataIndicator {
+ public:
+  /// @param minDurationBetweenTwoPoints market order books arriving sooner than this duration after the last point
+  ///                                    taken into account are ignored
+  explicit ExponentialMovingAverage(int32_t nbPeriods, Duration minDurationBetweenTwoPoints = Duration{});
+
+  void update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) override;
+
+  /// Get the number of points taken into account since the start.
+  int64_t nbPoints() const { return _nbPoints; }
+
+  /// Get the current exponential moving average, or a zero amount if there is no point yet.
+  MonetaryAmount value() const { return MonetaryAmount{_value, _priceCur}; }
+
+ private:
+  double _alpha;
+  double _value{};
+  Duration _minDurationBetweenTwoPoints;
+  TimePoint _nextPointMinTime{TimePoint::min()};
+  int64_t _nbPoints{};
+  CurrencyCode _priceCur;
+};
+
+}  // namespace cct
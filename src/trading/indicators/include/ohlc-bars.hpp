@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "abstract-market-data-indicator.hpp"
+#include "monetaryamount.hpp"
+#include "rolling-window-queue.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+struct OhlcBar {
+  bool operator==(const OhlcBar &) const noexcept = default;
+
+  TimePoint openTime;
+  MonetaryAmount open;
+  MonetaryAmount high;
+  MonetaryAmount low;
+  MonetaryAmount close;
+  MonetaryAmount volume;
+};
+
+/// Builds incrementally the open / high / low / close bars of the public trades, for bars of fixed duration aligned
+/// on multiples of this duration since epoch. Bars without any public trade are not created.
+/// Only the last 'nbMaxBars' completed bars are kept. Each update is in amortized O(1) per public trade.
+class OhlcBars : public AbstractMarketDataIndicator {
+ public:
+  OhlcBars(Duration barDuration, int32_t nbMaxBars);
+
+  void update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) override;
+
+  /// Get the last completed bars, from the oldest to the newest.
+  /// The returned span is invalidated by the next update.
+  std::span<const OhlcBar> completedBars() const { return _completedBars.elements(); }
+
+  /// Get the bar currently being built, if any.
+  const std::optional<OhlcBar> &currentBar() const { return _currentBar; }
+
+ private:
+  void completeCurrentBar();
+
+  RollingWindowQueue<OhlcBar> _completedBars;
+  std::optional<OhlcBar> _currentBar;
+  Duration _barDuration;
+  int32_t _nbMaxBars;
+};
+
+}  // namespace cct
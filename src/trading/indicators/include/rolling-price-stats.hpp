@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "abstract-market-data-indicator.hpp"
+#include "currencycode.hpp"
+#include "monetaryamount.hpp"
+#include "rolling-window-queue.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Incremental statistics (average, variance, min and max) of the average prices of the market order books over a
+/// sliding time window, which contains the points whose time is in [now - windowDuration, now], 'now' being the time
+/// of the current market order book.
+/// Each update is in amortized O(1), whatever the window duration.
+class RollingPriceStats : public AbstractMarketDataIndicator {
+ public:
+  /// @param minDurationBetweenTwoPoints market order books arriving sooner than this duration after the last point
+  ///                                    taken into account are ignored
+  explicit RollingPriceStats(Duration windowDuration, Duration minDurationBetweenTwoPoints = Duration{});
+
+  void update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) override;
+
+  int32_t nbPoints() const { return static_cast<int32_t>(_points.size()); }
+
+  /// Get the average price of the points of the window, or a zero amount if there is none.
+  MonetaryAmount average() const;
+
+  /// Get the (population) variance of the prices of the points of the window, in squared price unit.
+  double variance() const;
+
+  /// Get the (population) standard deviation of the prices of the points of the window.
+  MonetaryAmount standardDeviation() const;
+
+  /// Get the minimum price of the points of the window, or a zero amount if there is none.
+  MonetaryAmount min() const { return _minPoints.empty() ? MonetaryAmount{0, _priceCur} : _minPoints.front().price; }
+
+  /// Get the maximum price of the points of the window, or a zero amount if there is none.
+  MonetaryAmount max() const { return _maxPoints.empty() ? MonetaryAmount{0, _priceCur} : _maxPoints.front().price; }
+
+ private:
+  struct Point {
+    TimePoint time;
+    MonetaryAmount price;
+  };
+
+  void evictPointsOlderThan(TimePoint oldestTime);
+
+  RollingWindowQueue<Point> _points;
+  // Monotonic queues whose front is the min (resp. max) price of the window
+  RollingWindowQueue<Point> _minPoints;
+  RollingWindowQueue<Point> _maxPoints;
+  Duration _windowDuration;
+  Duration _minDurationBetweenTwoPoints;
+  TimePoint _nextPointMinTime{TimePoint::min()};
+  // Sums are computed on prices shifted by a value close to them, to limit the precision loss of the variance
+  double _shift{};
+  double _sum{};
+  double _sumSquares{};
+  CurrencyCode _priceCur;
+};
+
+}  // namespace cct
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <span>
+
+#include "abstract-market-data-indicator.hpp"
+#include "currencycode.hpp"
+#include "monetaryamount.hpp"
+#include "rolling-window-queue.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+/// Incremental volume weighted average price of the public trades over a sliding time window, which contains the
+/// trades whose time is in [now - windowDuration, now], 'now' being the time of the current market order book.
+/// Each update is in amortized O(1) per public trade, whatever the window duration.
+class RollingVwap : public AbstractMarketDataIndicator {
+ public:
+  explicit RollingVwap(Duration windowDuration) : _windowDuration(windowDuration) {}
+
+  void update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) override;
+
+  /// Get the volume weighted average price of the public trades of the window, or a zero amount if there is none.
+  MonetaryAmount vwap() const;
+
+  /// Get the total traded volume of the public trades of the window.
+  MonetaryAmount volume() const { return MonetaryAmount{_sumVolumes, _volumeCur}; }
+
+ private:
+  struct Trade {
+    TimePoint time;
+    double price;
+    double volume;
+  };
+
+  RollingWindowQueue<Trade> _trades;
+  Duration _windowDuration;
+  double _sumWeightedPrices{};
+  double _sumVolumes{};
+  CurrencyCode _priceCur;
+  CurrencyCode _volumeCur;
+};
+
+}  // namespace cct
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <span>
+
+#include "cct_vector.hpp"
+
+namespace cct {
+
+/// FIFO queue storing the elements of a sliding window contiguously, with amortized O(1) insertion at the back and
+/// removal from both ends (removal from the back allows its usage as a monotonic queue).
+/// Storage of the elements removed from the front is reclaimed once they represent at least half of it.
+template <class T>
+class RollingWindowQueue {
+ public:
+  using size_type = typename vector<T>::size_type;
+
+  bool empty() const noexcept { return _frontPos == _elems.size(); }
+
+  size_type size() const noexcept { return _elems.size() - _frontPos; }
+
+  const T &front() const { return _elems[_frontPos]; }
+  const T &back() const { return _elems.back(); }
+
+  /// Get a view on the elements of the queue, from the oldest to the newest.
+  /// It is invalidated by any modification of the queue.
+  std::span<const T> elements() const noexcept { return {_elems.data() + _frontPos, size()}; }
+
+  void push_back(const T &elem) { _elems.push_back(elem); }
+
+  void pop_back() {
+    _elems.pop_back();
+    if (empty()) {
+      clear();
+    }
+  }
+
+  void pop_front() {
+    ++_frontPos;
+    if (empty()) {
+      clear();
+    } else if (_frontPos >= kMinNbPoppedElemsBeforeCompaction && 2U * _frontPos >= _elems.size()) {
+      _elems.erase(_elems.begin(), _elems.begin() + _frontPos);
+      _frontPos = 0;
+    }
+  }
+
+  void clear() noexcept {
+    _elems.clear();
+    _frontPos = 0;
+  }
+
+ private:
+  static constexpr size_type kMinNbPoppedElemsBeforeCompaction = 64;
+
+  vector<T> _elems;
+  size_type _frontPos{};
+};
+
+}  // namespace cct
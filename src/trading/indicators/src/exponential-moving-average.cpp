@@ -0,0 +1,46 @@
+#include "exponential-moving-average.hpp"
+
+#include <cstdint>
+#include <span>
+
+#include "cct_exception.hpp"
+#include "marketorderbook.hpp"
+#include "publictrade.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+ExponentialMovingAverage::ExponentialMovingAverage(int32_t nbPeriods, Duration minDurationBetweenTwoPoints)
+    : _alpha(2.0 / (nbPeriods + 1)), _minDurationBetweenTwoPoints(minDurationBetweenTwoPoints) {
+  if (nbPeriods <= 0) {
+    throw exception("Exponential moving average number of periods should be strictly positive, got {}", nbPeriods);
+  }
+}
+
+void ExponentialMovingAverage::update(const MarketOrderBook &marketOrderBook,
+                                      [[maybe_unused]] std::span<const PublicTrade> newPublicTrades) {
+  const TimePoint ts = marketOrderBook.time();
+  if (ts < _nextPointMinTime) {
+    return;
+  }
+
+  const auto optPrice = marketOrderBook.averagePrice();
+  if (!optPrice) {
+    return;
+  }
+
+  const double price = optPrice->toDouble();
+
+  _nextPointMinTime = ts + _minDurationBetweenTwoPoints;
+  _priceCur = optPrice->currencyCode();
+
+  if (_nbPoints == 0) {
+    _value = price;
+  } else {
+    _value += _alpha * (price - _value);
+  }
+
+  ++_nbPoints;
+}
+
+}  // namespace cct
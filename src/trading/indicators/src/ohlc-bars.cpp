@@ -0,0 +1,58 @@
+#include "ohlc-bars.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+#include "cct_exception.hpp"
+#include "marketorderbook.hpp"
+#include "publictrade.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+OhlcBars::OhlcBars(Duration barDuration, int32_t nbMaxBars) : _barDuration(barDuration), _nbMaxBars(nbMaxBars) {
+  if (_barDuration <= Duration{}) {
+    throw exception("OHLC bar duration should be strictly positive");
+  }
+  if (_nbMaxBars <= 0) {
+    throw exception("OHLC bars number of bars should be strictly positive, got {}", _nbMaxBars);
+  }
+}
+
+void OhlcBars::update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) {
+  for (const PublicTrade &publicTrade : newPublicTrades) {
+    const TimePoint tradeTime = publicTrade.time();
+
+    if (_currentBar && _currentBar->openTime + _barDuration <= tradeTime) {
+      completeCurrentBar();
+    }
+
+    const MonetaryAmount price = publicTrade.price();
+
+    if (_currentBar) {
+      _currentBar->high = std::max(_currentBar->high, price);
+      _currentBar->low = std::min(_currentBar->low, price);
+      _currentBar->close = price;
+      _currentBar->volume += publicTrade.amount();
+    } else {
+      const TimePoint openTime = tradeTime - (tradeTime.time_since_epoch() % _barDuration);
+      _currentBar = OhlcBar{openTime, price, price, price, price, publicTrade.amount()};
+    }
+  }
+
+  // No more public trade can be added to current bar if its period is over at the time of the market order book
+  if (_currentBar && _currentBar->openTime + _barDuration <= marketOrderBook.time()) {
+    completeCurrentBar();
+  }
+}
+
+void OhlcBars::completeCurrentBar() {
+  if (static_cast<int32_t>(_completedBars.size()) == _nbMaxBars) {
+    _completedBars.pop_front();
+  }
+  _completedBars.push_back(*_currentBar);
+  _currentBar.reset();
+}
+
+}  // namespace cct
@@ -0,0 +1,104 @@
+#include "rolling-price-stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "publictrade.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+RollingPriceStats::RollingPriceStats(Duration windowDuration, Duration minDurationBetweenTwoPoints)
+    : _windowDuration(windowDuration), _minDurationBetweenTwoPoints(minDurationBetweenTwoPoints) {}
+
+void RollingPriceStats::update(const MarketOrderBook &marketOrderBook,
+                               [[maybe_unused]] std::span<const PublicTrade> newPublicTrades) {
+  const TimePoint ts = marketOrderBook.time();
+
+  evictPointsOlderThan(ts - _windowDuration);
+
+  if (ts < _nextPointMinTime) {
+    return;
+  }
+
+  const auto optPrice = marketOrderBook.averagePrice();
+  if (!optPrice) {
+    return;
+  }
+
+  const MonetaryAmount price = *optPrice;
+  const double priceValue = price.toDouble();
+
+  _nextPointMinTime = ts + _minDurationBetweenTwoPoints;
+  _priceCur = price.currencyCode();
+
+  if (_points.empty()) {
+    _shift = priceValue;
+  }
+
+  const double shiftedPrice = priceValue - _shift;
+
+  _sum += shiftedPrice;
+  _sumSquares += shiftedPrice * shiftedPrice;
+
+  const Point point{ts, price};
+
+  _points.push_back(point);
+
+  while (!_minPoints.empty() && price <= _minPoints.back().price) {
+    _minPoints.pop_back();
+  }
+  _minPoints.push_back(point);
+
+  while (!_maxPoints.empty() && _maxPoints.back().price <= price) {
+    _maxPoints.pop_back();
+  }
+  _maxPoints.push_back(point);
+}
+
+void RollingPriceStats::evictPointsOlderThan(TimePoint oldestTime) {
+  while (!_points.empty() && _points.front().time < oldestTime) {
+    const double shiftedPrice = _points.front().price.toDouble() - _shift;
+
+    _sum -= shiftedPrice;
+    _sumSquares -= shiftedPrice * shiftedPrice;
+
+    _points.pop_front();
+  }
+
+  if (_points.empty()) {
+    // Start again from exact values to avoid accumulating rounding errors
+    _sum = 0;
+    _sumSquares = 0;
+  }
+
+  while (!_minPoints.empty() && _minPoints.front().time < oldestTime) {
+    _minPoints.pop_front();
+  }
+  while (!_maxPoints.empty() && _maxPoints.front().time < oldestTime) {
+    _maxPoints.pop_front();
+  }
+}
+
+MonetaryAmount RollingPriceStats::average() const {
+  if (_points.empty()) {
+    return MonetaryAmount{0, _priceCur};
+  }
+  return MonetaryAmount{_shift + (_sum / static_cast<double>(_points.size())), _priceCur};
+}
+
+double RollingPriceStats::variance() const {
+  if (_points.empty()) {
+    return 0;
+  }
+  const auto nbPoints = static_cast<double>(_points.size());
+  const double shiftedAverage = _sum / nbPoints;
+  return std::max(0.0, (_sumSquares / nbPoints) - (shiftedAverage * shiftedAverage));
+}
+
+MonetaryAmount RollingPriceStats::standardDeviation() const { return MonetaryAmount{std::sqrt(variance()), _priceCur}; }
+
+}  // namespace cct
@@ -0,0 +1,54 @@
+#include "rolling-vwap.hpp"
+
+#include <span>
+
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "publictrade.hpp"
+#include "timedef.hpp"
+
+namespace cct {
+
+void RollingVwap::update(const MarketOrderBook &marketOrderBook, std::span<const PublicTrade> newPublicTrades) {
+  const TimePoint oldestTime = marketOrderBook.time() - _windowDuration;
+
+  for (const PublicTrade &publicTrade : newPublicTrades) {
+    if (publicTrade.time() < oldestTime) {
+      continue;
+    }
+    const double price = publicTrade.price().toDouble();
+    const double volume = publicTrade.amount().toDouble();
+
+    _sumWeightedPrices += price * volume;
+    _sumVolumes += volume;
+
+    _trades.push_back(Trade{publicTrade.time(), price, volume});
+
+    _priceCur = publicTrade.price().currencyCode();
+    _volumeCur = publicTrade.amount().currencyCode();
+  }
+
+  while (!_trades.empty() && _trades.front().time < oldestTime) {
+    const Trade &trade = _trades.front();
+
+    _sumWeightedPrices -= trade.price * trade.volume;
+    _sumVolumes -= trade.volume;
+
+    _trades.pop_front();
+  }
+
+  if (_trades.empty()) {
+    // Start again from exact values to avoid accumulating rounding errors
+    _sumWeightedPrices = 0;
+    _sumVolumes = 0;
+  }
+}
+
+MonetaryAmount RollingVwap::vwap() const {
+  if (_sumVolumes <= 0) {
+    return MonetaryAmount{0, _priceCur};
+  }
+  return MonetaryAmount{_sumWeightedPrices / _sumVolumes, _priceCur};
+}
+
+}  // namespace cct
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+#include "cct_exception.hpp"
+#include "exponential-moving-average.hpp"
+#include "marketorderbook.hpp"
+#include "monetaryamount.hpp"
+#include "ohlc-bars.hpp"
+#include "publictrade.hpp"
+#include "rolling-price-stats.hpp"
+#include "rolling-vwap.hpp"
+#include "rolling-window-queue.hpp"
+#include "timedef.hpp"
+#include "tradeside.hpp"
+#include "volumeandpricenbdecimals.hpp"
+
+namespace cct {
+
+class IncrementalIndicatorsTest : public ::testing::Test {
+ protected:
+  MarketOrderBook createMarketOrderBook(int64_t nbSeconds, int64_t averagePrice) const {
+    return {ts(nbSeconds),
+            MonetaryAmount(averagePrice + 1, "USDT"),
+            MonetaryAmount(1, "BTC"),
+            MonetaryAmount(averagePrice - 1, "USDT"),
+            MonetaryAmount(1, "BTC"),
+            VolAndPriNbDecimals{2, 2},
+            1};
+  }
+
+  PublicTrade createPublicTrade(int64_t nbSeconds, int64_t price, int64_t volume) const {
+    return {TradeSide::buy, MonetaryAmount(volume, "BTC"), MonetaryAmount(price, "USDT"), ts(nbSeconds)};
+  }
+
+  TimePoint ts(int64_t nbSeconds) const { return startTime + std::chrono::seconds(nbSeconds); }
+
+  TimePoint startTime{std::chrono::sys_days{std::chrono::year{2024} / 5 / 1}};
+};
+
+TEST_F(IncrementalIndicatorsTest, RollingWindowQueue) {
+  RollingWindowQueue<int> queue;
+
+  EXPECT_TRUE(queue.empty());
+
+  for (int elem = 0; elem < 1000; ++elem) {
+    queue.push_back(elem);
+    if (elem % 2 == 1) {
+      queue.pop_front();
+    }
+  }
+
+  ASSERT_EQ(queue.size(), 500U);
+  EXPECT_EQ(queue.front(), 500);
+  EXPECT_EQ(queue.back(), 999);
+  EXPECT_EQ(queue.elements().front(), 500);
+  EXPECT_EQ(queue.elements().back(), 999);
+
+  queue.pop_back();
+  EXPECT_EQ(queue.back(), 998);
+}
+
+TEST_F(IncrementalIndicatorsTest, RollingPriceStats) {
+  RollingPriceStats rollingPriceStats(std::chrono::seconds(2));
+
+  EXPECT_EQ(rollingPriceStats.nbPoints(), 0);
+  EXPECT_EQ(rollingPriceStats.average(), MonetaryAmount(0));
+
+  rollingPriceStats.update(createMarketOrderBook(0, 100), {});
+  rollingPriceStats.update(createMarketOrderBook(1, 104), {});
+  rollingPriceStats.update(createMarketOrderBook(2, 96), {});
+
+  EXPECT_EQ(rollingPriceStats.nbPoints(), 3);
+  EXPECT_EQ(rollingPriceStats.average(), MonetaryAmount(100, "USDT"));
+  EXPECT_DOUBLE_EQ(rollingPriceStats.variance(), 32.0 / 3);
+  EXPECT_EQ(rollingPriceStats.min(), MonetaryAmount(96, "USDT"));
+  EXPECT_EQ(rollingPriceStats.max(), MonetaryAmount(104, "USDT"));
+
+  // First point goes out of the window
+  rollingPriceStats.update(createMarketOrderBook(3, 100), {});
+
+  EXPECT_EQ(rollingPriceStats.nbPoints(), 3);
+  EXPECT_EQ(rollingPriceStats.average(), MonetaryAmount(100, "USDT"));
+  EXPECT_EQ(rollingPriceStats.min(), MonetaryAmount(96, "USDT"));
+  EXPECT_EQ(rollingPriceStats.max(), MonetaryAmount(104, "USDT"));
+
+  rollingPriceStats.update(createMarketOrderBook(4, 97), {});
+
+  EXPECT_EQ(rollingPriceStats.min(), MonetaryAmount(96, "USDT"));
+  EXPECT_EQ(rollingPriceStats.max(), MonetaryAmount(100, "USDT"));
+
+  // All points go out of the window
+  rollingPriceStats.update(createMarketOrderBook(10, 200), {});
+
+  EXPECT_EQ(rollingPriceStats.nbPoints(), 1);
+  EXPECT_EQ(rollingPriceStats.average(), MonetaryAmount(200, "USDT"));
+  EXPECT_EQ(rollingPriceStats.standardDeviation(), MonetaryAmount(0, "USDT"));
+  EXPECT_EQ(rollingPriceStats.min(), MonetaryAmount(200, "USDT"));
+  EXPECT_EQ(rollingPriceStats.max(), MonetaryAmount(200, "USDT"));
+}
+
+TEST_F(IncrementalIndicatorsTest, RollingPriceStatsMinDurationBetweenTwoPoints) {
+  RollingPriceStats rollingPriceStats(std::chrono::minutes(1), std::chrono::seconds(2));
+
+  for (int64_t nbSeconds = 0; nbSeconds < 10; ++nbSeconds) {
+    rollingPriceStats.update(createMarketOrderBook(nbSeconds, 100 + nbSeconds), {});
+  }
+
+  EXPECT_EQ(rollingPriceStats.nbPoints(), 5);
+  EXPECT_EQ(rollingPriceStats.average(), MonetaryAmount(104, "USDT"));
+}
+
+TEST_F(IncrementalIndicatorsTest, RollingVwap) {
+  RollingVwap rollingVwap(std::chrono::seconds(10));
+
+  EXPECT_EQ(rollingVwap.vwap(), MonetaryAmount(0));
+
+  const PublicTrade publicTrades1[] = {createPublicTrade(0, 100, 1), createPublicTrade(1, 110, 3)};
+  rollingVwap.update(createMarketOrderBook(2, 105), publicTrades1);
+
+  EXPECT_EQ(rollingVwap.vwap(), MonetaryAmount("107.5", "USDT"));
+  EXPECT_EQ(rollingVwap.volume(), MonetaryAmount(4, "BTC"));
+
+  const PublicTrade publicTrades2[] = {createPublicTrade(9, 120, 1)};
+  rollingVwap.update(createMarketOrderBook(10, 115), publicTrades2);
+
+  EXPECT_EQ(rollingVwap.vwap(), MonetaryAmount(110, "USDT"));
+
+  // First trade goes out of the window
+  rollingVwap.update(createMarketOrderBook(11, 115), {});
+
+  EXPECT_EQ(rollingVwap.vwap(), MonetaryAmount("112.5", "USDT"));
+  EXPECT_EQ(rollingVwap.volume(), MonetaryAmount(4, "BTC"));
+}
+
+TEST_F(IncrementalIndicatorsTest, ExponentialMovingAverage) {
+  EXPECT_THROW(ExponentialMovingAverage(0), exception);
+
+  ExponentialMovingAverage ema(3);
+
+  ema.update(createMarketOrderBook(0, 100), {});
+  EXPECT_EQ(ema.value(), MonetaryAmount(100, "USDT"));
+
+  ema.update(createMarketOrderBook(1, 110), {});
+  EXPECT_EQ(ema.value(), MonetaryAmount(105, "USDT"));
+
+  ema.update(createMarketOrderBook(2, 95), {});
+  EXPECT_EQ(ema.value(), MonetaryAmount(100, "USDT"));
+  EXPECT_EQ(ema.nbPoints(), 3);
+}
+
+TEST_F(IncrementalIndicatorsTest, OhlcBars) {
+  OhlcBars ohlcBars(std::chrono::minutes(1), 2);
+
+  const PublicTrade publicTrades1[] = {createPublicTrade(10, 100, 1), createPublicTrade(20, 105, 2),
+                                       createPublicTrade(30, 98, 1)};
+  ohlcBars.update(createMarketOrderBook(40, 100), publicTrades1);
+
+  EXPECT_TRUE(ohlcBars.completedBars().empty());
+  ASSERT_TRUE(ohlcBars.currentBar());
+  EXPECT_EQ(ohlcBars.currentBar()->openTime, ts(0));
+
+  const PublicTrade publicTrades2[] = {createPublicTrade(50, 101, 1), createPublicTrade(70, 102, 1)};
+  ohlcBars.update(createMarketOrderBook(80, 100), publicTrades2);
+
+  ASSERT_EQ(ohlcBars.completedBars().size(), 1U);
+  EXPECT_EQ(ohlcBars.completedBars().front(),
+            OhlcBar(ts(0), MonetaryAmount(100, "USDT"), MonetaryAmount(105, "USDT"), MonetaryAmount(98, "USDT"),
+                    MonetaryAmount(101, "USDT"), MonetaryAmount(5, "BTC")));
+  ASSERT_TRUE(ohlcBars.currentBar());
+  EXPECT_EQ(ohlcBars.currentBar()->openTime, ts(60));
+
+  // Current bar is completed by the market order book time, even without new trades
+  ohlcBars.update(createMarketOrderBook(125, 100), {});
+
+  ASSERT_EQ(ohlcBars.completedBars().size(), 2U);
+  EXPECT_FALSE(ohlcBars.currentBar());
+
+  const PublicTrade publicTrades3[] = {createPublicTrade(200, 90, 1)};
+  ohlcBars.update(createMarketOrderBook(250, 100), publicTrades3);
+
+  // Only the 2 last completed bars are kept
+  ASSERT_EQ(ohlcBars.completedBars().size(), 2U);
+  EXPECT_EQ(ohlcBars.completedBars().front().openTime, ts(60));
+  EXPECT_EQ(ohlcBars.completedBars().back().openTime, ts(180));
+}
+
+}  // namespace cct